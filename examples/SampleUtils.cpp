@@ -261,7 +261,8 @@ bool InitSample(int argc, const char** argv) {
 
 void DoFlush() {
     if (cmdBufType == CmdBufType::Terrible) {
-        bool c2sSuccess = c2sBuf->Flush();
+        // Flush through the client so batched destructions are serialized first.
+        bool c2sSuccess = wireClient->Flush();
         bool s2cSuccess = s2cBuf->Flush();
 
         ASSERT(c2sSuccess && s2cSuccess);
@@ -597,12 +597,29 @@ class MultiGeneratorFromDawnJSON(Generator):
             renders.append(FileRender('mock_webgpu.cpp', 'src/dawn/mock_webgpu.cpp', mock_params))
 
         if 'dawn_native_utils' in targets:
+            # Hot entry points that do no validation of their own: they also get a direct-call
+            # extern "C" export so clients linking dawn_native directly can skip the proc table
+            # indirection. Declared in the generated dawn_native/ProcsInline.h.
+            inline_proc_names = {
+                ('compute pass encoder', 'set bind group'),
+                ('compute pass encoder', 'dispatch'),
+                ('compute pass encoder', 'dispatch indirect'),
+                ('render pass encoder', 'set bind group'),
+                ('render pass encoder', 'draw'),
+                ('render pass encoder', 'draw indexed'),
+                ('render pass encoder', 'draw indirect'),
+                ('render pass encoder', 'draw indexed indirect'),
+                ('ray tracing pass encoder', 'set bind group'),
+                ('ray tracing pass encoder', 'trace rays'),
+            }
+
             frontend_params = [
                 base_params,
                 api_params,
                 {
                     'as_frontendType': lambda typ: as_frontendType(typ), # TODO as_frontendType and friends take a Type and not a Name :(
-                    'as_annotated_frontendType': lambda arg: annotated(as_frontendType(arg.type), arg)
+                    'as_annotated_frontendType': lambda arg: annotated(as_frontendType(arg.type), arg),
+                    'is_inline_proc': lambda type_, method: (type_.name.canonical_case(), method.name.canonical_case()) in inline_proc_names
                 }
             ]
 
@@ -611,6 +628,7 @@ class MultiGeneratorFromDawnJSON(Generator):
             renders.append(FileRender('dawn_native/wgpu_structs.h', 'src/dawn_native/wgpu_structs_autogen.h', frontend_params))
             renders.append(FileRender('dawn_native/wgpu_structs.cpp', 'src/dawn_native/wgpu_structs_autogen.cpp', frontend_params))
             renders.append(FileRender('dawn_native/ProcTable.cpp', 'src/dawn_native/ProcTable.cpp', frontend_params))
+            renders.append(FileRender('dawn_native/ProcsInline.h', 'src/include/dawn_native/ProcsInline.h', frontend_params))
 
         if 'dawn_wire' in targets:
             additional_params = compute_wire_params(api_params, wire_json)
@@ -636,6 +654,7 @@ class MultiGeneratorFromDawnJSON(Generator):
             renders.append(FileRender('dawn_wire/server/ServerDoers.cpp', 'src/dawn_wire/server/ServerDoers_autogen.cpp', wire_params))
             renders.append(FileRender('dawn_wire/server/ServerHandlers.cpp', 'src/dawn_wire/server/ServerHandlers_autogen.cpp', wire_params))
             renders.append(FileRender('dawn_wire/server/ServerPrototypes.inc', 'src/dawn_wire/server/ServerPrototypes_autogen.inc', wire_params))
+            renders.append(FileRender('dawn_wire/server/WireFunneledProcs.cpp', 'src/dawn_wire/server/WireFunneledProcs_autogen.cpp', wire_params))
 
         return renders
 
@@ -33,6 +33,7 @@ namespace dawn_native {
     using RayTracingPassEncoderBase = RayTracingPassEncoder;
     using FenceBase = Fence;
     using RenderPassEncoderBase = RenderPassEncoder;
+    using RayTracingBundleEncoderBase = RayTracingBundleEncoder;
     using RenderBundleEncoderBase = RenderBundleEncoder;
     using SurfaceBase = Surface;
 
@@ -94,6 +95,31 @@ namespace dawn_native {
         static constexpr size_t sProcMapSize = sizeof(sProcMap) / sizeof(sProcMap[0]);
     }
 
+    //* Direct-call entry points for the hot, non-validating methods. These forward to the
+    //* same functions the proc table points at; clients that link dawn_native directly can
+    //* call them through dawn_native/ProcsInline.h and skip the proc table indirection.
+    {% for type in by_category["object"] %}
+        {% for method in c_methods(type) if is_inline_proc(type, method) %}
+            {% set suffix = as_MethodSuffix(type.name, method.name) %}
+
+            extern "C" DAWN_NATIVE_EXPORT {{as_cType(method.return_type.name)}} dawnNative{{suffix}}(
+                {{-as_cType(type.name)}} cSelf
+                {%- for arg in method.arguments -%}
+                    , {{as_annotated_cType(arg)}}
+                {%- endfor -%}
+            ) {
+                {% if method.return_type.name.canonical_case() != "void" %}
+                    return
+                {%- endif %}
+                Native{{suffix}}(cSelf
+                    {%- for arg in method.arguments -%}
+                        , {{as_varName(arg.name)}}
+                    {%- endfor -%}
+                );
+            }
+        {% endfor %}
+    {% endfor %}
+
     WGPUInstance NativeCreateInstance(WGPUInstanceDescriptor const* cDescriptor) {
         const dawn_native::InstanceDescriptor* descriptor =
             reinterpret_cast<const dawn_native::InstanceDescriptor*>(cDescriptor);
@@ -0,0 +1,44 @@
+//* Copyright 2020 The Dawn Authors
+//*
+//* Licensed under the Apache License, Version 2.0 (the "License");
+//* you may not use this file except in compliance with the License.
+//* You may obtain a copy of the License at
+//*
+//*     http://www.apache.org/licenses/LICENSE-2.0
+//*
+//* Unless required by applicable law or agreed to in writing, software
+//* distributed under the License is distributed on an "AS IS" BASIS,
+//* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//* See the License for the specific language governing permissions and
+//* limitations under the License.
+
+#ifndef DAWNNATIVE_PROCSINLINE_H_
+#define DAWNNATIVE_PROCSINLINE_H_
+
+#include <dawn/webgpu.h>
+#include <dawn_native/dawn_native_export.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//* These are the hot, non-validating entry points of the API (recording commands inside a
+//* pass). They are the exact functions the proc table returned by dawn_native::GetProcs()
+//* points at, exported under a dawnNative prefix so that applications linking dawn_native
+//* directly can call them without going through the proc table's pointer indirection.
+{% for type in by_category["object"] %}
+    {% for method in c_methods(type) if is_inline_proc(type, method) %}
+        DAWN_NATIVE_EXPORT {{as_cType(method.return_type.name)}} dawnNative{{as_MethodSuffix(type.name, method.name)}}(
+            {{-as_cType(type.name)}} self
+            {%- for arg in method.arguments -%}
+                , {{as_annotated_cType(arg)}}
+            {%- endfor -%}
+        );
+    {% endfor %}
+{% endfor %}
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // DAWNNATIVE_PROCSINLINE_H_
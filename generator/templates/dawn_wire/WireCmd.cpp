@@ -259,9 +259,17 @@ namespace {
                 auto memberBuffer = reinterpret_cast<{{member_transfer_type(member)}}*>(*buffer);
                 *buffer += memberLength * {{member_transfer_sizeof(member)}};
 
-                for (size_t i = 0; i < memberLength; ++i) {
-                    {{serialize_member(member, "record." + memberName + "[i]", "memberBuffer[i]" )}}
-                }
+                {% if member.annotation == "const*" and member.type.category not in ["object", "structure"] %}
+                    //* POD spans have the same representation in the API and on the wire, so
+                    //* they are copied in bulk instead of element by element. memcpy also
+                    //* handles the buffer position not being aligned for the element type.
+                    static_assert(sizeof({{member_transfer_type(member)}}) == sizeof({{as_cType(member.type.name)}}), "");
+                    memcpy(memberBuffer, record.{{memberName}}, memberLength * {{member_transfer_sizeof(member)}});
+                {% else %}
+                    for (size_t i = 0; i < memberLength; ++i) {
+                        {{serialize_member(member, "record." + memberName + "[i]", "memberBuffer[i]" )}}
+                    }
+                {% endif %}
             }
         {% endfor %}
     }
@@ -222,13 +222,9 @@ namespace dawn_wire { namespace client {
                     return;
                 }
 
-                DestroyObjectCmd cmd;
-                cmd.objectType = ObjectType::{{type.name.CamelCase()}};
-                cmd.objectId = obj->id;
-
-                size_t requiredSize = cmd.GetRequiredSize();
-                char* allocatedBuffer = static_cast<char*>(obj->device->GetClient()->GetCmdSpace(requiredSize));
-                cmd.Serialize(allocatedBuffer);
+                //* Destructions are batched into a single command sent before the next
+                //* regular command so scene teardowns don't emit one message per object.
+                obj->device->GetClient()->DestroyObject(ObjectType::{{type.name.CamelCase()}}, obj->id);
 
                 obj->device->GetClient()->{{type.name.CamelCase()}}Allocator().Free(obj);
             }
@@ -29,6 +29,13 @@ namespace dawn_wire { namespace client {
         virtual ~ClientBase() {
         }
 
+        //* Pre-size every per-type allocator, see ObjectAllocator::Reserve.
+        void ReserveAllObjects(size_t capacity) {
+            {% for type in by_category["object"] %}
+                m{{type.name.CamelCase()}}Allocator.Reserve(capacity);
+            {% endfor %}
+        }
+
         {% for type in by_category["object"] %}
             const ObjectAllocator<{{type.name.CamelCase()}}>& {{type.name.CamelCase()}}Allocator() const {
                 return m{{type.name.CamelCase()}}Allocator;
@@ -41,6 +41,13 @@ namespace dawn_wire { namespace server {
             {% endfor %}
         }
 
+        //* Pre-size every per-type ID table, see KnownObjects::Reserve.
+        void ReserveAllObjects(size_t capacity) {
+            {% for type in by_category["object"] %}
+                mKnown{{type.name.CamelCase()}}.Reserve(capacity);
+            {% endfor %}
+        }
+
         {% for type in by_category["object"] %}
             const KnownObjects<{{as_cType(type.name)}}>& {{type.name.CamelCase()}}Objects() const {
                 return mKnown{{type.name.CamelCase()}};
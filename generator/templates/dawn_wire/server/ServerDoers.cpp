@@ -99,4 +99,17 @@ namespace dawn_wire { namespace server {
         return true;
     }
 
+    bool Server::DoDestroyObjects(uint32_t count,
+                                  const ObjectType* objectTypes,
+                                  const ObjectId* objectIds) {
+        //* The client batches destructions so teardown doesn't send one command per
+        //* object; each entry has the same semantics as a DestroyObject command.
+        for (uint32_t i = 0; i < count; ++i) {
+            if (!DoDestroyObject(objectTypes[i], objectIds[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
 }}  // namespace dawn_wire::server
@@ -116,6 +116,10 @@ namespace dawn_wire { namespace server {
             return nullptr;
         }
 
+        //* Piggyback fence completions observed during this batch on the same return
+        //* flush as the batch's other return traffic (map acknowledgements, errors).
+        SerializeDeferredFenceUpdates();
+
         return commands;
     }
 
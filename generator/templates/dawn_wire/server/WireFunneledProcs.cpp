@@ -0,0 +1,74 @@
+//* Copyright 2020 The Dawn Authors
+//*
+//* Licensed under the Apache License, Version 2.0 (the "License");
+//* you may not use this file except in compliance with the License.
+//* You may obtain a copy of the License at
+//*
+//*     http://www.apache.org/licenses/LICENSE-2.0
+//*
+//* Unless required by applicable law or agreed to in writing, software
+//* distributed under the License is distributed on an "AS IS" BASIS,
+//* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//* See the License for the specific language governing permissions and
+//* limitations under the License.
+
+#include "dawn_wire/WireFunneledProcs.h"
+
+#include <mutex>
+
+namespace dawn_wire {
+
+    namespace {
+
+        //* Like dawn_proc, the wrapped table is process-global: proc entries carry no
+        //* context so there can only be one funnel per process.
+        DawnProcTable gFunneledProcs;
+        std::mutex gFunnelMutex;
+
+        WGPUInstance FunneledCreateInstance(WGPUInstanceDescriptor const * descriptor) {
+            std::lock_guard<std::mutex> lock(gFunnelMutex);
+            return gFunneledProcs.createInstance(descriptor);
+        }
+
+        WGPUProc FunneledGetProcAddress(WGPUDevice device, const char* procName) {
+            std::lock_guard<std::mutex> lock(gFunnelMutex);
+            return gFunneledProcs.getProcAddress(device, procName);
+        }
+
+        {% for type in by_category["object"] %}
+            {% for method in c_methods(type) %}
+                {{as_cType(method.return_type.name)}} Funneled{{as_MethodSuffix(type.name, method.name)}}(
+                    {{-as_cType(type.name)}} {{as_varName(type.name)}}
+                    {%- for arg in method.arguments -%}
+                        , {{as_annotated_cType(arg)}}
+                    {%- endfor -%}
+                ) {
+                    std::lock_guard<std::mutex> lock(gFunnelMutex);
+                    {% if method.return_type.name.canonical_case() != "void" %}return {% endif %}
+                    gFunneledProcs.{{as_varName(type.name, method.name)}}({{as_varName(type.name)}}
+                        {%- for arg in method.arguments -%}
+                            , {{as_varName(arg.name)}}
+                        {%- endfor -%}
+                    );
+                }
+            {% endfor %}
+
+        {% endfor %}
+
+    }  // anonymous namespace
+
+    DawnProcTable FunnelProcs(const DawnProcTable& procs) {
+        gFunneledProcs = procs;
+
+        DawnProcTable funneled = {};
+        funneled.createInstance = FunneledCreateInstance;
+        funneled.getProcAddress = FunneledGetProcAddress;
+        {% for type in by_category["object"] %}
+            {% for method in c_methods(type) %}
+                funneled.{{as_varName(type.name, method.name)}} = Funneled{{as_MethodSuffix(type.name, method.name)}};
+            {% endfor %}
+        {% endfor %}
+        return funneled;
+    }
+
+}  // namespace dawn_wire
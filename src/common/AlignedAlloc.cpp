@@ -0,0 +1,76 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/AlignedAlloc.h"
+
+#include "common/Assert.h"
+#include "common/Math.h"
+#include "common/Platform.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(DAWN_PLATFORM_WINDOWS)
+#    include <malloc.h>
+#endif
+
+#if defined(DAWN_PLATFORM_LINUX)
+#    include <sys/mman.h>
+#endif
+
+void* AlignedAlloc(size_t size, size_t alignment, bool requestLargePages) {
+    ASSERT(size != 0);
+    ASSERT(IsPowerOfTwo(alignment));
+
+    // posix_memalign and _aligned_malloc both require the alignment to be at least
+    // pointer-sized.
+    alignment = std::max(alignment, sizeof(void*));
+
+    bool useLargePages = requestLargePages && size >= kLargePageSize;
+    if (useLargePages) {
+        // Large pages only map whole, aligned page ranges, so round the block up to
+        // cover the memory the kernel would back anyway.
+        alignment = std::max(alignment, kLargePageSize);
+        size = static_cast<size_t>(RoundUp(size, kLargePageSize));
+    }
+
+#if defined(DAWN_PLATFORM_WINDOWS)
+    // Large pages require SeLockMemoryPrivilege on Windows, so only the alignment part
+    // of the request is honored there.
+    void* ptr = _aligned_malloc(size, alignment);
+#else
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, alignment, size) != 0) {
+        return nullptr;
+    }
+#endif
+
+#if defined(DAWN_PLATFORM_LINUX) && defined(MADV_HUGEPAGE)
+    if (useLargePages && ptr != nullptr) {
+        // Best effort: the block is still usable with regular pages when transparent
+        // huge pages are unavailable or the madvise fails.
+        madvise(ptr, size, MADV_HUGEPAGE);
+    }
+#endif
+
+    return ptr;
+}
+
+void AlignedFree(void* ptr) {
+#if defined(DAWN_PLATFORM_WINDOWS)
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
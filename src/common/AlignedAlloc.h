@@ -0,0 +1,34 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMON_ALIGNEDALLOC_H_
+#define COMMON_ALIGNEDALLOC_H_
+
+#include <cstddef>
+
+// The size of a large (huge) page on the platforms that support requesting them.
+static constexpr size_t kLargePageSize = 2 * 1024 * 1024;
+
+// Allocates |size| bytes aligned to |alignment|, which must be a power of two. When
+// |requestLargePages| is true and the allocation is at least kLargePageSize, the block is
+// aligned and padded to a large page boundary and the kernel is asked to back it with large
+// pages where the platform supports it (transparent huge pages on Linux). The request is
+// only a hint: allocation succeeds with regular pages when it cannot be honored.
+// Returns nullptr on allocation failure.
+void* AlignedAlloc(size_t size, size_t alignment, bool requestLargePages = false);
+
+// Frees a block returned by AlignedAlloc. Safe to call with nullptr.
+void AlignedFree(void* ptr);
+
+#endif  // COMMON_ALIGNEDALLOC_H_
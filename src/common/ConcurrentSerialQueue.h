@@ -0,0 +1,102 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMON_CONCURRENTSERIALQUEUE_H_
+#define COMMON_CONCURRENTSERIALQUEUE_H_
+
+#include "common/SerialQueue.h"
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// ConcurrentSerialQueue is a SerialQueue whose Enqueue may be called from any number of
+// producer threads concurrently, for a single consumer thread that iterates and clears.
+// Producers append to an unordered pending list under a mutex; the consumer moves the
+// pending values into a regular SerialQueue before iterating, so iteration itself never
+// holds the lock and stays as cheap as SerialQueue's.
+//
+// Because producers don't synchronize with each other, a value can arrive after a value
+// with a greater serial was already queued. Such a late value is promoted to the greater
+// serial: for the intended deferred-destruction use this only delays it, which is always
+// safe.
+template <typename T>
+class ConcurrentSerialQueue {
+  public:
+    // Producer API: may be called from any thread.
+    void Enqueue(const T& value, Serial serial) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending.emplace_back(serial, value);
+    }
+
+    void Enqueue(T&& value, Serial serial) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending.emplace_back(serial, std::move(value));
+    }
+
+    // Consumer API: must only be called from the single consumer thread. Iterators are
+    // invalidated by any other call into the queue, like for SerialQueue.
+    bool Empty() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mPending.empty() && mQueue.Empty();
+    }
+
+    typename SerialQueue<T>::BeginEnd IterateAll() {
+        FlushPending();
+        return mQueue.IterateAll();
+    }
+
+    typename SerialQueue<T>::BeginEnd IterateUpTo(Serial serial) {
+        FlushPending();
+        return mQueue.IterateUpTo(serial);
+    }
+
+    void Clear() {
+        FlushPending();
+        mQueue.Clear();
+    }
+
+    void ClearUpTo(Serial serial) {
+        mQueue.ClearUpTo(serial);
+    }
+
+  private:
+    void FlushPending() {
+        std::vector<std::pair<Serial, T>> pending;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            pending.swap(mPending);
+        }
+
+        std::stable_sort(pending.begin(), pending.end(),
+                         [](const std::pair<Serial, T>& a, const std::pair<Serial, T>& b) {
+                             return a.first < b.first;
+                         });
+
+        for (std::pair<Serial, T>& value : pending) {
+            Serial serial = value.first;
+            if (!mQueue.Empty()) {
+                serial = std::max(serial, mQueue.LastSerial());
+            }
+            mQueue.Enqueue(std::move(value.second), serial);
+        }
+    }
+
+    std::mutex mMutex;
+    std::vector<std::pair<Serial, T>> mPending;
+    SerialQueue<T> mQueue;
+};
+
+#endif  // COMMON_CONCURRENTSERIALQUEUE_H_
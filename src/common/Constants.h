@@ -33,6 +33,8 @@ static constexpr uint32_t kMaxVertexBufferStride = 2048u;
 static constexpr uint32_t kNumStages = 8;
 static constexpr uint32_t kMaxColorAttachments = 4u;
 static constexpr uint32_t kTextureBytesPerRowAlignment = 256u;
+// Buffer-to-texture copies on D3D12 use placed footprints whose offset must be 512-aligned.
+static constexpr uint32_t kTextureCopyPlacementAlignment = 512u;
 // Dynamic buffer offsets require offset to be divisible by 256
 static constexpr uint64_t kMinDynamicBufferOffsetAlignment = 256u;
 // Max numbers of dynamic uniform buffers
@@ -42,10 +44,19 @@ static constexpr uint32_t kMaxDynamicStorageBufferCount = 4u;
 // Max numbers of dynamic buffers
 static constexpr uint32_t kMaxDynamicBufferCount =
     kMaxDynamicUniformBufferCount + kMaxDynamicStorageBufferCount;
+// Maximum size of the immediate data that can be set on a pass encoder. It maps to push
+// constants on Vulkan and root constants on D3D12 whose guaranteed minimum sizes are 128
+// and 256 bytes respectively.
+static constexpr uint32_t kMaxImmediateDataBytes = 64u;
 // Indirect command sizes
 static constexpr uint64_t kDispatchIndirectSize = 3 * sizeof(uint32_t);
 static constexpr uint64_t kDrawIndirectSize = 4 * sizeof(uint32_t);
 static constexpr uint64_t kDrawIndexedIndirectSize = 5 * sizeof(uint32_t);
+static constexpr uint64_t kTraceRaysIndirectSize = 3 * sizeof(uint32_t);
+
+// Size of one instance entry in acceleration container instance memory. Both
+// VkAccelerationStructureInstanceKHR and D3D12_RAYTRACING_INSTANCE_DESC are 64 bytes.
+static constexpr uint64_t kRayTracingInstanceSize = 64u;
 
 // Non spec defined constants.
 static constexpr float kLodMin = 0.0;
@@ -0,0 +1,94 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMON_COUNTERS_H_
+#define COMMON_COUNTERS_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Lightweight counters for hot paths. Unlike trace events these have no per-event
+// allocation or timestamping; increments are single relaxed atomic adds so they can stay
+// enabled in production builds. Use the DAWN_COUNTER_* macros below so the increments
+// compile away entirely when DAWN_ENABLE_INTERNAL_COUNTERS is not defined.
+
+enum class Counter : uint32_t {
+    // Queue::Submit calls.
+    Submits,
+    // Pipeline barrier commands recorded by the backend.
+    PipelineBarriers,
+    // Descriptor sets handed out by the backend descriptor allocators.
+    DescriptorSetsAllocated,
+    // Bytes allocated from the DynamicUploader's staging memory.
+    StagingBytesAllocated,
+    // Commands consumed from submitted command buffers by the null backend's throughput mode.
+    CommandsConsumed,
+    // D3D12 command allocators created because the pool had no free allocator; sustained
+    // growth means submissions outpace recycling.
+    CommandAllocatorsCreated,
+    // D3D12 command allocators released after sitting idle in the pool.
+    CommandAllocatorsTrimmed,
+    // Bind group layout creations served from the device's deduplication cache.
+    BindGroupLayoutCacheHits,
+    // Bind group layout creations that had to create a new backend layout.
+    BindGroupLayoutCacheMisses,
+};
+
+static constexpr uint32_t kCounterCount = 9u;
+
+struct CounterSnapshot {
+    std::array<uint64_t, kCounterCount> values = {};
+
+    uint64_t Get(Counter counter) const {
+        return values[static_cast<uint32_t>(counter)];
+    }
+};
+
+class CounterRegistry {
+  public:
+    void Add(Counter counter, uint64_t value) {
+        mCounters[static_cast<uint32_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+    }
+
+    // Reads all counters and resets them to zero, so callers sampling once per frame get
+    // per-frame values. Counts from other threads that race with the snapshot land in the
+    // next one.
+    CounterSnapshot AcquireSnapshot() {
+        CounterSnapshot snapshot;
+        for (uint32_t i = 0; i < kCounterCount; ++i) {
+            snapshot.values[i] = mCounters[i].exchange(0, std::memory_order_relaxed);
+        }
+        return snapshot;
+    }
+
+  private:
+    std::array<std::atomic<uint64_t>, kCounterCount> mCounters = {};
+};
+
+#if defined(DAWN_ENABLE_INTERNAL_COUNTERS)
+
+#    define DAWN_COUNTER_ADD(registry, counter, value) (registry)->Add(Counter::counter, value)
+
+#else
+
+#    define DAWN_COUNTER_ADD(registry, counter, value) \
+        do {                                           \
+        } while (0)
+
+#endif
+
+#define DAWN_COUNTER_INCREMENT(registry, counter) DAWN_COUNTER_ADD(registry, counter, 1)
+
+#endif  // COMMON_COUNTERS_H_
@@ -25,6 +25,14 @@
 #    include <intrin.h>
 #endif
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#    define DAWN_MATH_USE_SSE 1
+#    include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    define DAWN_MATH_USE_NEON 1
+#    include <arm_neon.h>
+#endif
+
 uint32_t ScanForward(uint32_t bits) {
     ASSERT(bits != 0);
 #if defined(DAWN_COMPILER_MSVC)
@@ -161,6 +169,46 @@ uint64_t RoundUp(uint64_t n, uint64_t m) {
     return ((n + m - 1) / m) * m;
 }
 
+// The conversion is a 4x4 transpose with the last row dropped: row r of the result is
+// [src[r], src[4 + r], src[8 + r], src[12 + r]].
+void ConvertColumnMajor4x4ToRowMajor4x3(void* dst,
+                                        size_t dstStride,
+                                        const float* src,
+                                        size_t count) {
+    ASSERT(dstStride >= 12 * sizeof(float));
+    unsigned char* out = static_cast<unsigned char*>(dst);
+
+    for (size_t ii = 0; ii < count; ++ii) {
+        float* row = reinterpret_cast<float*>(out);
+#if defined(DAWN_MATH_USE_SSE)
+        __m128 c0 = _mm_loadu_ps(src + 0);
+        __m128 c1 = _mm_loadu_ps(src + 4);
+        __m128 c2 = _mm_loadu_ps(src + 8);
+        __m128 c3 = _mm_loadu_ps(src + 12);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        _mm_storeu_ps(row + 0, c0);
+        _mm_storeu_ps(row + 4, c1);
+        _mm_storeu_ps(row + 8, c2);
+#elif defined(DAWN_MATH_USE_NEON)
+        // The de-interleaving load gathers every fourth float, which is exactly one row
+        // of the transposed matrix.
+        float32x4x4_t rows = vld4q_f32(src);
+        vst1q_f32(row + 0, rows.val[0]);
+        vst1q_f32(row + 4, rows.val[1]);
+        vst1q_f32(row + 8, rows.val[2]);
+#else
+        for (size_t r = 0; r < 3; ++r) {
+            row[r * 4 + 0] = src[0 + r];
+            row[r * 4 + 1] = src[4 + r];
+            row[r * 4 + 2] = src[8 + r];
+            row[r * 4 + 3] = src[12 + r];
+        }
+#endif
+        src += 16;
+        out += dstStride;
+    }
+}
+
 // generates a 4x3 transform matrix in row-major order
 void Fill4x3TransformMatrix(float* out,
                             float tx,
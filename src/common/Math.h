@@ -66,6 +66,15 @@ bool IsFloat16NaN(uint16_t fp16);
 
 float SRGBToLinear(float srgb);
 
+// Converts `count` column-major 4x4 matrices to the row-major 4x3 layout used by
+// acceleration structure instance transforms. The results are written `dstStride` bytes
+// apart so they can go directly into an array of backend instance structs, whose
+// transform lies at offset 0. `dstStride` must hold at least 12 floats.
+void ConvertColumnMajor4x4ToRowMajor4x3(void* dst,
+                                        size_t dstStride,
+                                        const float* src,
+                                        size_t count);
+
 // generates a 4x3 transform matrix in row-major order
 void Fill4x3TransformMatrix(float* out,
                             float tx,
@@ -69,10 +69,16 @@ void RefCounted::Release() {
         // memory barrier, when an acquire load on mRefCount (using the `ldar` instruction)
         // should be enough and could end up being faster.
         std::atomic_thread_fence(std::memory_order_acquire);
-        DeleteThis();
+        if (!DeferDeleteThis()) {
+            DeleteThis();
+        }
     }
 }
 
 void RefCounted::DeleteThis() {
     delete this;
+}
+
+bool RefCounted::DeferDeleteThis() {
+    return false;
 }
\ No newline at end of file
@@ -34,6 +34,11 @@ class RefCounted {
     // A Derived class may override this if they require a custom deleter.
     virtual void DeleteThis();
 
+    // Called on the thread that removed the last reference, before DeleteThis(). An override
+    // may take ownership of the object for deferred destruction by returning true, in which
+    // case it must arrange for DeleteThis() to be called exactly once later.
+    virtual bool DeferDeleteThis();
+
   private:
     std::atomic_uint64_t mRefCount;
 };
@@ -35,16 +35,39 @@ struct SerialStorageTraits<SerialQueue<T>> {
 // It enforces that the Serials enqueued are strictly non-decreasing.
 // This makes it very efficient iterate or clear all items added up
 // to some Serial value because they are stored contiguously in memory.
+// Cleared entries are retained and their vectors recycled, so the
+// per-frame enqueue/clear cycle stops allocating once the queue has
+// reached its steady-state size.
 template <typename T>
 class SerialQueue : public SerialStorage<SerialQueue<T>> {
   public:
     using SerialPair = typename SerialStorageTraits<SerialQueue<T>>::SerialPair;
+    using StorageIterator = typename SerialStorageTraits<SerialQueue<T>>::StorageIterator;
+    using ConstStorageIterator = typename SerialStorageTraits<SerialQueue<T>>::ConstStorageIterator;
 
     // The serial must be given in (not strictly) increasing order.
     void Enqueue(const T& value, Serial serial);
     void Enqueue(T&& value, Serial serial);
     void Enqueue(const std::vector<T>& values, Serial serial);
     void Enqueue(std::vector<T>&& values, Serial serial);
+
+    // Shadow the base versions: instead of erasing entries these advance the queue's
+    // head and keep the cleared vectors for reuse, so clearing is index arithmetic
+    // and doesn't free the elements' storage.
+    void Clear();
+    void ClearUpTo(Serial serial);
+
+    // Start of the live range; entries before it have been cleared and only wait to be
+    // reused. Shadows the base version through the CRTP.
+    StorageIterator StorageBegin();
+    ConstStorageIterator StorageBegin() const;
+
+  private:
+    std::vector<T> AcquireVector();
+    void RecycleVector(std::vector<T>&& vector);
+
+    size_t mHead = 0;
+    std::vector<std::vector<T>> mRecycledVectors;
 };
 
 // SerialQueue
@@ -54,7 +77,7 @@ void SerialQueue<T>::Enqueue(const T& value, Serial serial) {
     DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
 
     if (this->Empty() || this->mStorage.back().first < serial) {
-        this->mStorage.emplace_back(serial, std::vector<T>{});
+        this->mStorage.emplace_back(serial, AcquireVector());
     }
     this->mStorage.back().second.push_back(value);
 }
@@ -64,7 +87,7 @@ void SerialQueue<T>::Enqueue(T&& value, Serial serial) {
     DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
 
     if (this->Empty() || this->mStorage.back().first < serial) {
-        this->mStorage.emplace_back(serial, std::vector<T>{});
+        this->mStorage.emplace_back(serial, AcquireVector());
     }
     this->mStorage.back().second.push_back(std::move(value));
 }
@@ -80,7 +103,56 @@ template <typename T>
 void SerialQueue<T>::Enqueue(std::vector<T>&& values, Serial serial) {
     DAWN_ASSERT(values.size() > 0);
     DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
-    this->mStorage.emplace_back(serial, values);
+    this->mStorage.emplace_back(serial, std::move(values));
+}
+
+template <typename T>
+void SerialQueue<T>::Clear() {
+    for (size_t ii = mHead; ii < this->mStorage.size(); ++ii) {
+        RecycleVector(std::move(this->mStorage[ii].second));
+    }
+    this->mStorage.clear();
+    mHead = 0;
+}
+
+template <typename T>
+void SerialQueue<T>::ClearUpTo(Serial serial) {
+    while (mHead < this->mStorage.size() && this->mStorage[mHead].first <= serial) {
+        RecycleVector(std::move(this->mStorage[mHead].second));
+        mHead++;
+    }
+    if (mHead == this->mStorage.size()) {
+        // Everything was consumed; restart from the front of the storage. The pairs are
+        // destroyed but their vectors were already recycled, so no capacity is lost.
+        this->mStorage.clear();
+        mHead = 0;
+    }
+}
+
+template <typename T>
+typename SerialQueue<T>::StorageIterator SerialQueue<T>::StorageBegin() {
+    return this->mStorage.begin() + mHead;
+}
+
+template <typename T>
+typename SerialQueue<T>::ConstStorageIterator SerialQueue<T>::StorageBegin() const {
+    return this->mStorage.begin() + mHead;
+}
+
+template <typename T>
+std::vector<T> SerialQueue<T>::AcquireVector() {
+    if (mRecycledVectors.empty()) {
+        return {};
+    }
+    std::vector<T> vector = std::move(mRecycledVectors.back());
+    mRecycledVectors.pop_back();
+    return vector;
+}
+
+template <typename T>
+void SerialQueue<T>::RecycleVector(std::vector<T>&& vector) {
+    vector.clear();
+    mRecycledVectors.push_back(std::move(vector));
 }
 
 #endif  // COMMON_SERIALQUEUE_H_
@@ -116,35 +116,50 @@ class SerialStorage {
     // Returns the first StorageIterator that a serial bigger than serial.
     ConstStorageIterator FindUpTo(Serial serial) const;
     StorageIterator FindUpTo(Serial serial);
+
+    // Where iteration and searches start. Derived classes that retain cleared entries
+    // to reuse their allocations (SerialQueue) shadow this to point past them; the
+    // shadowed version is picked up through the CRTP.
+    StorageIterator StorageBegin();
+    ConstStorageIterator StorageBegin() const;
+
     Storage mStorage;
+
+  private:
+    Derived* GetDerived() {
+        return static_cast<Derived*>(this);
+    }
+    const Derived* GetDerived() const {
+        return static_cast<const Derived*>(this);
+    }
 };
 
 // SerialStorage
 
 template <typename Derived>
 bool SerialStorage<Derived>::Empty() const {
-    return mStorage.empty();
+    return GetDerived()->StorageBegin() == mStorage.end();
 }
 
 template <typename Derived>
 typename SerialStorage<Derived>::ConstBeginEnd SerialStorage<Derived>::IterateAll() const {
-    return {mStorage.begin(), mStorage.end()};
+    return {GetDerived()->StorageBegin(), mStorage.end()};
 }
 
 template <typename Derived>
 typename SerialStorage<Derived>::ConstBeginEnd SerialStorage<Derived>::IterateUpTo(
     Serial serial) const {
-    return {mStorage.begin(), FindUpTo(serial)};
+    return {GetDerived()->StorageBegin(), FindUpTo(serial)};
 }
 
 template <typename Derived>
 typename SerialStorage<Derived>::BeginEnd SerialStorage<Derived>::IterateAll() {
-    return {mStorage.begin(), mStorage.end()};
+    return {GetDerived()->StorageBegin(), mStorage.end()};
 }
 
 template <typename Derived>
 typename SerialStorage<Derived>::BeginEnd SerialStorage<Derived>::IterateUpTo(Serial serial) {
-    return {mStorage.begin(), FindUpTo(serial)};
+    return {GetDerived()->StorageBegin(), FindUpTo(serial)};
 }
 
 template <typename Derived>
@@ -154,13 +169,13 @@ void SerialStorage<Derived>::Clear() {
 
 template <typename Derived>
 void SerialStorage<Derived>::ClearUpTo(Serial serial) {
-    mStorage.erase(mStorage.begin(), FindUpTo(serial));
+    mStorage.erase(GetDerived()->StorageBegin(), FindUpTo(serial));
 }
 
 template <typename Derived>
 Serial SerialStorage<Derived>::FirstSerial() const {
     DAWN_ASSERT(!Empty());
-    return mStorage.begin()->first;
+    return GetDerived()->StorageBegin()->first;
 }
 
 template <typename Derived>
@@ -172,7 +187,7 @@ Serial SerialStorage<Derived>::LastSerial() const {
 template <typename Derived>
 typename SerialStorage<Derived>::ConstStorageIterator SerialStorage<Derived>::FindUpTo(
     Serial serial) const {
-    auto it = mStorage.begin();
+    auto it = GetDerived()->StorageBegin();
     while (it != mStorage.end() && it->first <= serial) {
         it++;
     }
@@ -181,13 +196,23 @@ typename SerialStorage<Derived>::ConstStorageIterator SerialStorage<Derived>::Fi
 
 template <typename Derived>
 typename SerialStorage<Derived>::StorageIterator SerialStorage<Derived>::FindUpTo(Serial serial) {
-    auto it = mStorage.begin();
+    auto it = GetDerived()->StorageBegin();
     while (it != mStorage.end() && it->first <= serial) {
         it++;
     }
     return it;
 }
 
+template <typename Derived>
+typename SerialStorage<Derived>::StorageIterator SerialStorage<Derived>::StorageBegin() {
+    return mStorage.begin();
+}
+
+template <typename Derived>
+typename SerialStorage<Derived>::ConstStorageIterator SerialStorage<Derived>::StorageBegin() const {
+    return mStorage.begin();
+}
+
 // SerialStorage::BeginEnd
 
 template <typename Derived>
@@ -14,6 +14,7 @@
 
 #include "common/SlabAllocator.h"
 
+#include "common/AlignedAlloc.h"
 #include "common/Assert.h"
 #include "common/Math.h"
 
@@ -30,15 +31,23 @@ SlabAllocatorImpl::IndexLinkNode::IndexLinkNode(Index index, Index nextIndex)
 
 // Slab
 
-SlabAllocatorImpl::Slab::Slab(std::unique_ptr<char[]> allocation, IndexLinkNode* head)
-    : allocation(std::move(allocation)),
-      freeList(head),
-      prev(nullptr),
-      next(nullptr),
-      blocksInUse(0) {
+SlabAllocatorImpl::Slab::Slab(char* allocation, IndexLinkNode* head)
+    : allocation(allocation), freeList(head), prev(nullptr), next(nullptr), blocksInUse(0) {
 }
 
-SlabAllocatorImpl::Slab::Slab(Slab&& rhs) = default;
+SlabAllocatorImpl::Slab::~Slab() {
+    // The Slab lives inside |allocation|, so nothing may touch |this| after the free.
+    AlignedFree(allocation);
+}
+
+SlabAllocatorImpl::Slab::Slab(Slab&& rhs)
+    : allocation(rhs.allocation),
+      freeList(rhs.freeList),
+      prev(rhs.prev),
+      next(rhs.next),
+      blocksInUse(rhs.blocksInUse) {
+    rhs.allocation = nullptr;
+}
 
 SlabAllocatorImpl::SentinelSlab::SentinelSlab() : Slab(nullptr, nullptr) {
 }
@@ -68,12 +77,8 @@ SlabAllocatorImpl::SlabAllocatorImpl(Index blocksPerSlab,
       mIndexLinkNodeOffset(Align(objectSize, alignof(IndexLinkNode))),
       mBlockStride(Align(mIndexLinkNodeOffset + sizeof(IndexLinkNode), objectAlignment)),
       mBlocksPerSlab(blocksPerSlab),
-      mTotalAllocationSize(
-          // required allocation size
-          static_cast<size_t>(mSlabBlocksOffset) + mBlocksPerSlab * mBlockStride +
-          // Pad the allocation size by mAllocationAlignment so that the aligned allocation still
-          // fulfills the required size.
-          mAllocationAlignment) {
+      mTotalAllocationSize(static_cast<size_t>(mSlabBlocksOffset) +
+                           mBlocksPerSlab * mBlockStride) {
     ASSERT(IsPowerOfTwo(mAllocationAlignment));
 }
 
@@ -231,11 +236,10 @@ void SlabAllocatorImpl::GetNewSlab() {
         return;
     }
 
-    // TODO(enga): Use aligned_alloc with C++17.
-    auto allocation = std::unique_ptr<char[]>(new char[mTotalAllocationSize]);
-    char* alignedPtr = AlignPtr(allocation.get(), mAllocationAlignment);
+    char* allocation = static_cast<char*>(AlignedAlloc(mTotalAllocationSize, mAllocationAlignment));
+    ASSERT(allocation != nullptr);
 
-    char* dataStart = alignedPtr + mSlabBlocksOffset;
+    char* dataStart = allocation + mSlabBlocksOffset;
 
     IndexLinkNode* node = NodeFromObject(dataStart);
     for (uint32_t i = 0; i < mBlocksPerSlab; ++i) {
@@ -245,5 +249,5 @@ void SlabAllocatorImpl::GetNewSlab() {
     IndexLinkNode* lastNode = OffsetFrom(node, mBlocksPerSlab - 1);
     lastNode->nextIndex = kInvalidIndex;
 
-    mAvailableSlabs.Prepend(new (alignedPtr) Slab(std::move(allocation), node));
+    mAvailableSlabs.Prepend(new (allocation) Slab(allocation, node));
 }
@@ -18,7 +18,6 @@
 #include "common/PlacementAllocated.h"
 
 #include <cstdint>
-#include <memory>
 #include <type_traits>
 
 // The SlabAllocator allocates objects out of one or more fixed-size contiguous "slabs" of memory.
@@ -73,16 +72,17 @@ class SlabAllocatorImpl {
     };
 
     struct Slab : PlacementAllocated {
-        // A slab is placement-allocated into an aligned pointer from a separate allocation.
-        // Ownership of the allocation is transferred to the slab on creation.
+        // A slab is placement-allocated at the start of an aligned allocation it owns.
+        // Destroying the slab frees the allocation, so it must be the last member torn down.
         // | ---------- allocation --------- |
-        // | pad | Slab | data ------------> |
-        Slab(std::unique_ptr<char[]> allocation, IndexLinkNode* head);
+        // | Slab | data ------------------> |
+        Slab(char* allocation, IndexLinkNode* head);
         Slab(Slab&& rhs);
+        ~Slab();
 
         void Splice();
 
-        std::unique_ptr<char[]> allocation;
+        char* allocation;
         IndexLinkNode* freeList;
         Slab* prev;
         Slab* next;
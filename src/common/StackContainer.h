@@ -0,0 +1,130 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMON_STACKCONTAINER_H_
+#define COMMON_STACKCONTAINER_H_
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// An allocator that hands out a fixed inline buffer before falling back to the heap. It is
+// meant to be used through StackVector below: short-lived containers that usually stay small
+// (per-pass barrier batches, temporary handle lists) get their storage on the stack and only
+// allocate when they outgrow the inline capacity.
+template <typename T, size_t StackCapacity>
+class StackAllocator : public std::allocator<T> {
+  public:
+    using pointer = typename std::allocator<T>::pointer;
+    using size_type = typename std::allocator<T>::size_type;
+
+    // The inline storage handed out first. It lives outside the allocator because containers
+    // may copy their allocator; all copies share the same source.
+    struct Source {
+        T* Buffer() {
+            return reinterpret_cast<T*>(&mBuffer);
+        }
+
+        typename std::aligned_storage<sizeof(T[StackCapacity]), alignof(T[StackCapacity])>::type
+            mBuffer;
+        bool mUsedStackBuffer = false;
+    };
+
+    template <typename U>
+    struct rebind {
+        using other = StackAllocator<U, StackCapacity>;
+    };
+
+    explicit StackAllocator(Source* source) : mSource(source) {
+    }
+
+    StackAllocator(const StackAllocator& other)
+        : std::allocator<T>(), mSource(other.mSource) {
+    }
+
+    // Rebinding to another type cannot share the inline storage.
+    template <typename U, size_t OtherCapacity>
+    StackAllocator(const StackAllocator<U, OtherCapacity>&) : mSource(nullptr) {
+    }
+
+    pointer allocate(size_type n, void* hint = nullptr) {
+        if (mSource != nullptr && !mSource->mUsedStackBuffer && n <= StackCapacity) {
+            mSource->mUsedStackBuffer = true;
+            return mSource->Buffer();
+        }
+        return std::allocator<T>::allocate(n, hint);
+    }
+
+    void deallocate(pointer p, size_type n) {
+        if (mSource != nullptr && p == mSource->Buffer()) {
+            mSource->mUsedStackBuffer = false;
+        } else {
+            std::allocator<T>::deallocate(p, n);
+        }
+    }
+
+  private:
+    template <typename U, size_t OtherCapacity>
+    friend class StackAllocator;
+
+    Source* mSource;
+};
+
+// A vector with inline storage for its first StackCapacity elements. Access the underlying
+// std::vector through operator-> (or container() to pass it to functions taking the
+// ContainerType). The wrapper is not copyable because the inline storage cannot be shared.
+template <typename T, size_t StackCapacity>
+class StackVector {
+  public:
+    using Allocator = StackAllocator<T, StackCapacity>;
+    using ContainerType = std::vector<T, Allocator>;
+
+    StackVector() : mAllocator(&mStackSource), mContainer(mAllocator) {
+        // Reserve the inline capacity up front so the first push_back doesn't reallocate.
+        mContainer.reserve(StackCapacity);
+    }
+
+    StackVector(const StackVector&) = delete;
+    StackVector& operator=(const StackVector&) = delete;
+
+    ContainerType& container() {
+        return mContainer;
+    }
+    const ContainerType& container() const {
+        return mContainer;
+    }
+
+    ContainerType* operator->() {
+        return &mContainer;
+    }
+    const ContainerType* operator->() const {
+        return &mContainer;
+    }
+
+    T& operator[](size_t index) {
+        return mContainer[index];
+    }
+    const T& operator[](size_t index) const {
+        return mContainer[index];
+    }
+
+  private:
+    // Order matters: the source must outlive the allocator which must outlive the container.
+    typename Allocator::Source mStackSource;
+    Allocator mAllocator;
+    ContainerType mContainer;
+};
+
+#endif  // COMMON_STACKCONTAINER_H_
@@ -14,6 +14,7 @@
 
 #include "dawn_native/Adapter.h"
 
+#include "dawn_native/Format.h"
 #include "dawn_native/Instance.h"
 
 namespace dawn_native {
@@ -38,6 +39,10 @@ namespace dawn_native {
         return mInstance;
     }
 
+    std::vector<uint8_t> AdapterBase::GetAccelerationContainerCompatibilityId() const {
+        return {};
+    }
+
     ExtensionsSet AdapterBase::GetSupportedExtensions() const {
         return mSupportedExtensions;
     }
@@ -56,6 +61,39 @@ namespace dawn_native {
         return true;
     }
 
+    std::vector<FormatCapabilities> AdapterBase::GetFormatCapabilities() const {
+        // The frontend validation rules in ValidateTextureDescriptor are what ultimately
+        // decide whether a texture creation succeeds, so the capability matrix is derived
+        // from the same format table a device would build with every supported extension
+        // enabled.
+        FormatTable table = BuildFormatTable(mSupportedExtensions);
+
+        std::vector<FormatCapabilities> capabilities;
+        capabilities.reserve(table.size());
+        for (const Format& format : table) {
+            FormatCapabilities caps;
+            caps.format = static_cast<WGPUTextureFormat>(format.format);
+            caps.supported = format.isSupported;
+
+            if (format.isSupported) {
+                caps.supportedUsages =
+                    WGPUTextureUsage_CopySrc | WGPUTextureUsage_CopyDst | WGPUTextureUsage_Sampled;
+                if (!format.isCompressed) {
+                    if (format.isRenderable) {
+                        caps.supportedUsages |=
+                            WGPUTextureUsage_OutputAttachment | WGPUTextureUsage_Transient;
+                    }
+                    if (format.supportsStorageUsage) {
+                        caps.supportedUsages |= WGPUTextureUsage_Storage;
+                    }
+                }
+            }
+
+            capabilities.push_back(caps);
+        }
+        return capabilities;
+    }
+
     WGPUDeviceProperties AdapterBase::GetAdapterProperties() const {
         WGPUDeviceProperties adapterProperties = {};
 
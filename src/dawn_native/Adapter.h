@@ -22,6 +22,7 @@
 #include "dawn_native/dawn_platform.h"
 
 #include <string>
+#include <vector>
 
 namespace dawn_native {
 
@@ -39,11 +40,21 @@ namespace dawn_native {
 
         DeviceBase* CreateDevice(const DeviceDescriptor* descriptor = nullptr);
 
+        // Returns an opaque identifier that changes whenever serialized acceleration
+        // container blobs produced on this adapter stop being deserializable, typically
+        // on a driver or hardware change. An empty identifier means the backend has no
+        // stable identifier and blobs must always be rebuilt.
+        virtual std::vector<uint8_t> GetAccelerationContainerCompatibilityId() const;
+
         ExtensionsSet GetSupportedExtensions() const;
         bool SupportsAllRequestedExtensions(
             const std::vector<const char*>& requestedExtensions) const;
         WGPUDeviceProperties GetAdapterProperties() const;
 
+        // The supported-usage matrix for all known formats, derived from the frontend's
+        // format table with every extension this adapter supports enabled.
+        std::vector<FormatCapabilities> GetFormatCapabilities() const;
+
       protected:
         PCIInfo mPCIInfo = {};
         wgpu::AdapterType mAdapterType = wgpu::AdapterType::Unknown;
@@ -16,7 +16,9 @@
 
 #include "common/BitSetIterator.h"
 #include "common/HashUtils.h"
+#include "dawn_native/Adapter.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/Instance.h"
 #include "dawn_native/Texture.h"
 
 namespace dawn_native {
@@ -116,11 +118,13 @@ namespace dawn_native {
     }
 
     AttachmentState::AttachmentState(DeviceBase* device, const AttachmentStateBlueprint& blueprint)
-        : AttachmentStateBlueprint(blueprint), CachedObject(device) {
+        : AttachmentStateBlueprint(blueprint),
+          CachedObject(device),
+          mInstance(device->GetAdapter()->GetInstance()) {
     }
 
     AttachmentState::~AttachmentState() {
-        GetDevice()->UncacheAttachmentState(this);
+        mInstance->UncacheAttachmentState(this);
     }
 
     std::bitset<kMaxColorAttachments> AttachmentState::GetColorAttachmentsMask() const {
@@ -26,6 +26,7 @@
 namespace dawn_native {
 
     class DeviceBase;
+    class InstanceBase;
 
     // AttachmentStateBlueprint and AttachmentState are separated so the AttachmentState
     // can be constructed by copying the blueprint state instead of traversing descriptors.
@@ -68,6 +69,10 @@ namespace dawn_native {
 
       private:
         ~AttachmentState() override;
+
+        // AttachmentStates are cached on (and shared through) the instance, and may outlive
+        // the device that first created them, so the instance is kept for uncaching.
+        InstanceBase* mInstance;
     };
 
 }  // namespace dawn_native
@@ -23,6 +23,9 @@
 #include "dawn_native/Texture.h"
 #include "dawn_native/RayTracingAccelerationContainer.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace dawn_native {
 
     namespace {
@@ -175,29 +178,43 @@ namespace dawn_native {
         }
 
         DAWN_TRY(device->ValidateObject(descriptor->layout));
-        if (descriptor->entryCount != descriptor->layout->GetBindingCount()) {
+
+        const BindGroupLayoutBase* layout = descriptor->layout;
+
+        // Static sampler bindings are provided by the layout, not the bind group. Binding
+        // arrays use update-after-bind semantics so the bind group doesn't provide them
+        // either.
+        if (descriptor->entryCount != layout->GetBindingCount() - layout->GetStaticSamplerCount() -
+                                          layout->GetBindingArrayCount()) {
             return DAWN_VALIDATION_ERROR("numBindings mismatch");
         }
 
-        const BindGroupLayoutBase::BindingMap& bindingMap = descriptor->layout->GetBindingMap();
-
         std::bitset<kMaxBindingsPerGroup> bindingsSet;
         for (uint32_t i = 0; i < descriptor->entryCount; ++i) {
             const BindGroupEntry& entry = descriptor->entries[i];
 
-            const auto& it = bindingMap.find(BindingNumber(entry.binding));
-            if (it == bindingMap.end()) {
+            BindingIndex bindingIndex = 0;
+            if (!layout->TryGetBindingIndex(BindingNumber(entry.binding), &bindingIndex)) {
                 return DAWN_VALIDATION_ERROR("setting non-existent binding");
             }
-            BindingIndex bindingIndex = it->second;
-            ASSERT(bindingIndex < descriptor->layout->GetBindingCount());
+            ASSERT(bindingIndex < layout->GetBindingCount());
 
             if (bindingsSet[bindingIndex]) {
                 return DAWN_VALIDATION_ERROR("binding set twice");
             }
             bindingsSet.set(bindingIndex);
 
-            const BindingInfo& bindingInfo = descriptor->layout->GetBindingInfo(bindingIndex);
+            // Fetch the binding's layout information once; every check below reads it.
+            const BindingInfo& bindingInfo = layout->GetBindingInfo(bindingIndex);
+
+            if (layout->GetStaticSampler(bindingIndex) != nullptr) {
+                return DAWN_VALIDATION_ERROR("static sampler bindings may not be set");
+            }
+            if (bindingInfo.bindingArraySize > 1) {
+                return DAWN_VALIDATION_ERROR(
+                    "binding arrays use update-after-bind semantics and may not be set at "
+                    "creation");
+            }
 
             // Perform binding-type specific validation.
             switch (bindingInfo.type) {
@@ -233,11 +250,14 @@ namespace dawn_native {
         }
 
         // This should always be true because
-        //  - numBindings has to match between the bind group and its layout.
+        //  - numBindings has to match between the bind group and its layout, minus the
+        //    static sampler and binding array bindings which the bind group doesn't provide.
         //  - Each binding must be set at most once
         //
         // We don't validate the equality because it wouldn't be possible to cover it with a test.
-        ASSERT(bindingsSet.count() == bindingMap.size());
+        ASSERT(bindingsSet.count() == layout->GetBindingMap().size() -
+                                          layout->GetStaticSamplerCount() -
+                                          layout->GetBindingArrayCount());
 
         return {};
     }  // anonymous namespace
@@ -249,7 +269,8 @@ namespace dawn_native {
                                  void* bindingDataStart)
         : ObjectBase(device),
           mLayout(descriptor->layout),
-          mBindingData(mLayout->ComputeBindingDataPointers(bindingDataStart)) {
+          mBindingData(mLayout->ComputeBindingDataPointers(bindingDataStart)),
+          mLayoutCompatibilityToken(mLayout->GetCompatibilityToken()) {
         for (BindingIndex i = 0; i < mLayout->GetBindingCount(); ++i) {
             // TODO(enga): Shouldn't be needed when bindings are tightly packed.
             // This is to fill Ref<ObjectBase> holes with nullptrs.
@@ -295,6 +316,29 @@ namespace dawn_native {
                 continue;
             }
         }
+
+        // Fill static sampler bindings from the layout so that backends can keep using
+        // GetBindingAsSampler without knowing which bindings are static.
+        for (BindingIndex i = 0; i < mLayout->GetBindingCount(); ++i) {
+            SamplerBase* staticSampler = mLayout->GetStaticSampler(i);
+            if (staticSampler != nullptr) {
+                ASSERT(mBindingData.bindings[i].Get() == nullptr);
+                mBindingData.bindings[i] = staticSampler;
+            }
+        }
+
+        // Precompute the offset limits for dynamic buffer bindings, which BGL creation packs
+        // at the front. Descriptor validation guarantees binding offset + binding size fits in
+        // the buffer so the subtraction cannot underflow. Dynamic offsets are uint32_t so
+        // larger limits are clamped.
+        for (BindingIndex i = 0; i < mLayout->GetDynamicBufferCount(); ++i) {
+            ASSERT(mLayout->GetBindingInfo(i).hasDynamicOffset);
+            BufferBase* buffer = static_cast<BufferBase*>(mBindingData.bindings[i].Get());
+            uint64_t maxOffset = buffer->GetSize() - mBindingData.bufferData[i].offset -
+                                 mBindingData.bufferData[i].size;
+            mMaxDynamicOffsets[i] = static_cast<uint32_t>(
+                std::min(maxOffset, uint64_t(std::numeric_limits<uint32_t>::max())));
+        }
     }
 
     BindGroupBase::~BindGroupBase() {
@@ -333,6 +377,16 @@ namespace dawn_native {
         return mLayout.Get();
     }
 
+    uint64_t BindGroupBase::GetLayoutCompatibilityToken() const {
+        ASSERT(!IsError());
+        return mLayoutCompatibilityToken;
+    }
+
+    const uint32_t* BindGroupBase::GetMaxDynamicOffsets() const {
+        ASSERT(!IsError());
+        return mMaxDynamicOffsets.data();
+    }
+
     BufferBinding BindGroupBase::GetBindingAsBufferBinding(BindingIndex bindingIndex) {
         ASSERT(!IsError());
         ASSERT(bindingIndex < mLayout->GetBindingCount());
@@ -45,6 +45,15 @@ namespace dawn_native {
 
         BindGroupLayoutBase* GetLayout();
         const BindGroupLayoutBase* GetLayout() const;
+        // The layout's compatibility token, cached at creation so per-draw validation
+        // doesn't have to chase the layout pointer; see
+        // BindGroupLayoutBase::GetCompatibilityToken.
+        uint64_t GetLayoutCompatibilityToken() const;
+        // The maximum valid dynamic offset for each dynamic buffer binding, precomputed at
+        // creation so SetBindGroup validation is a flat compare over uint32s instead of
+        // walking the layout's binding info and the buffer bindings. Indexed by
+        // |BindingIndex| because dynamic buffers are packed at the front of the layout.
+        const uint32_t* GetMaxDynamicOffsets() const;
         BufferBinding GetBindingAsBufferBinding(BindingIndex bindingIndex);
         SamplerBase* GetBindingAsSampler(BindingIndex bindingIndex) const;
         TextureViewBase* GetBindingAsTextureView(BindingIndex bindingIndex);
@@ -79,6 +88,8 @@ namespace dawn_native {
 
         Ref<BindGroupLayoutBase> mLayout;
         BindGroupLayoutBase::BindingDataPointers mBindingData;
+        uint64_t mLayoutCompatibilityToken = 0;
+        std::array<uint32_t, kMaxDynamicBufferCount> mMaxDynamicOffsets = {};
     };
 
 }  // namespace dawn_native
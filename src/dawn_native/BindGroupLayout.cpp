@@ -15,8 +15,10 @@
 #include "dawn_native/BindGroupLayout.h"
 
 #include "common/BitSetIterator.h"
+#include "common/Compiler.h"
 #include "common/HashUtils.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/Sampler.h"
 #include "dawn_native/ValidationUtils_autogen.h"
 
 #include <algorithm>
@@ -26,6 +28,7 @@
 namespace dawn_native {
 
     MaybeError ValidateBindingTypeWithShaderStageVisibility(
+        DeviceBase* device,
         wgpu::BindingType bindingType,
         wgpu::ShaderStage shaderStageVisibility) {
         // TODO(jiawei.shao@intel.com): support read-write storage textures.
@@ -61,11 +64,17 @@ namespace dawn_native {
                 // TODO: spec says acceleration container is NOT available in any-hit shader?
                 if ((shaderStageVisibility & wgpu::ShaderStage::Vertex) != 0 ||
                     (shaderStageVisibility & wgpu::ShaderStage::Fragment) != 0 ||
-                    (shaderStageVisibility & wgpu::ShaderStage::Compute) != 0 ||
                     (shaderStageVisibility & wgpu::ShaderStage::RayIntersection) != 0) {
                     return DAWN_VALIDATION_ERROR(
                         "acceleration container binding is not supported in this shader");
                 }
+                // compute shaders may traverse containers with inline ray queries
+                if ((shaderStageVisibility & wgpu::ShaderStage::Compute) != 0 &&
+                    !device->IsExtensionEnabled(Extension::RayQuery)) {
+                    return DAWN_VALIDATION_ERROR(
+                        "acceleration container binding in compute shaders requires the Ray "
+                        "Query extension");
+                }
                 break;
         }
 
@@ -130,7 +139,8 @@ namespace dawn_native {
                 return DAWN_VALIDATION_ERROR("some binding index was specified more than once");
             }
 
-            DAWN_TRY(ValidateBindingTypeWithShaderStageVisibility(entry.type, entry.visibility));
+            DAWN_TRY(
+                ValidateBindingTypeWithShaderStageVisibility(device, entry.type, entry.visibility));
 
             DAWN_TRY(ValidateStorageTextureFormat(device, entry.type, entry.storageTextureFormat));
 
@@ -169,6 +179,23 @@ namespace dawn_native {
                     "BindGroupLayoutEntry::multisampled must be false (for now)");
             }
 
+            if (entry.staticSampler != nullptr) {
+                DAWN_TRY(device->ValidateObject(entry.staticSampler));
+                if (entry.type != wgpu::BindingType::Sampler &&
+                    entry.type != wgpu::BindingType::ComparisonSampler) {
+                    return DAWN_VALIDATION_ERROR(
+                        "static samplers are only allowed on sampler bindings");
+                }
+            }
+
+            if (entry.bindingArraySize == 0) {
+                return DAWN_VALIDATION_ERROR("bindingArraySize must be at least 1");
+            }
+            if (entry.bindingArraySize > 1 && entry.type != wgpu::BindingType::SampledTexture) {
+                return DAWN_VALIDATION_ERROR(
+                    "binding arrays are only supported on sampled texture bindings");
+            }
+
             bindingsSet.insert(bindingNumber);
         }
 
@@ -193,7 +220,8 @@ namespace dawn_native {
 
         void HashCombineBindingInfo(size_t* hash, const BindingInfo& info) {
             HashCombine(hash, info.hasDynamicOffset, info.multisampled, info.visibility, info.type,
-                        info.textureComponentType, info.viewDimension, info.storageTextureFormat);
+                        info.textureComponentType, info.viewDimension, info.storageTextureFormat,
+                        info.bindingArraySize);
         }
 
         bool operator!=(const BindingInfo& a, const BindingInfo& b) {
@@ -203,7 +231,8 @@ namespace dawn_native {
                    a.type != b.type ||                                  //
                    a.textureComponentType != b.textureComponentType ||  //
                    a.viewDimension != b.viewDimension ||                //
-                   a.storageTextureFormat != b.storageTextureFormat;
+                   a.storageTextureFormat != b.storageTextureFormat ||  //
+                   a.bindingArraySize != b.bindingArraySize;
         }
 
         bool SortBindingsCompare(const BindGroupLayoutEntry& a, const BindGroupLayoutEntry& b) {
@@ -238,9 +267,16 @@ namespace dawn_native {
             if (a.storageTextureFormat != b.storageTextureFormat) {
                 return a.storageTextureFormat < b.storageTextureFormat;
             }
+            if (a.bindingArraySize != b.bindingArraySize) {
+                return a.bindingArraySize < b.bindingArraySize;
+            }
             return false;
         }
 
+        // Marks empty slots of the binding number lookup table. Binding indices are
+        // always smaller than kMaxBindingsPerGroup so this can never be a real index.
+        constexpr BindingIndex kInvalidBindingIndex = std::numeric_limits<BindingIndex>::max();
+
         // This is a utility function to help ASSERT that the BGL-binding comparator places buffers
         // first.
         bool CheckBufferBindingsFirst(const BindingInfo* bindings, BindingIndex count) {
@@ -281,7 +317,9 @@ namespace dawn_native {
 
     BindGroupLayoutBase::BindGroupLayoutBase(DeviceBase* device,
                                              const BindGroupLayoutDescriptor* descriptor)
-        : CachedObject(device), mBindingCount(descriptor->entryCount) {
+        : CachedObject(device),
+          mBindingCount(descriptor->entryCount),
+          mCompatibilityToken(device->GetNextBindGroupLayoutCompatibilityToken()) {
         std::vector<BindGroupLayoutEntry> sortedBindings(
             descriptor->entries, descriptor->entries + descriptor->entryCount);
 
@@ -336,10 +374,55 @@ namespace dawn_native {
                 }
             }
 
+            if (binding.staticSampler != nullptr) {
+                mStaticSamplers[i] = binding.staticSampler;
+                ++mStaticSamplerCount;
+            }
+
+            mBindingInfo[i].bindingArraySize = binding.bindingArraySize;
+            if (binding.bindingArraySize > 1) {
+                ++mBindingArrayCount;
+            }
+
             const auto& it = mBindingMap.emplace(BindingNumber(binding.binding), i);
             ASSERT(it.second);
         }
         ASSERT(CheckBufferBindingsFirst(mBindingInfo.data(), mBindingCount));
+
+        // Compile the binding number lookup table. Binding numbers in real layouts are
+        // almost always small and dense, in which case the table is indexed by the
+        // binding number directly; sparse numbers fall back to a small open-addressed
+        // hash. Either way a lookup is one or two array accesses instead of a std::map
+        // walk.
+        BindingNumber maxBindingNumber = 0;
+        for (const auto& it : mBindingMap) {
+            maxBindingNumber = std::max(maxBindingNumber, it.first);
+        }
+        mDirectLookup =
+            mBindingCount == 0 || maxBindingNumber < 4 * uint32_t(mBindingCount) + 16;
+        if (mDirectLookup) {
+            mLookupTable.resize(mBindingCount == 0 ? 0 : maxBindingNumber + 1,
+                                {0, kInvalidBindingIndex});
+            for (const auto& it : mBindingMap) {
+                mLookupTable[it.first] = {it.first, it.second};
+            }
+        } else {
+            uint32_t tableSize = 1;
+            while (tableSize < 2 * uint32_t(mBindingCount)) {
+                tableSize <<= 1;
+            }
+            mLookupMask = tableSize - 1;
+            mLookupTable.resize(tableSize, {0, kInvalidBindingIndex});
+            for (const auto& it : mBindingMap) {
+                uint32_t slot = (it.first * 0x9E3779B9u) & mLookupMask;
+                while (mLookupTable[slot].index != kInvalidBindingIndex) {
+                    slot = (slot + 1) & mLookupMask;
+                }
+                mLookupTable[slot] = {it.first, it.second};
+            }
+        }
+
+        mContentHash = ComputeContentHash();
     }
 
     BindGroupLayoutBase::BindGroupLayoutBase(DeviceBase* device, ObjectBase::ErrorTag tag)
@@ -363,26 +446,64 @@ namespace dawn_native {
         return mBindingMap;
     }
 
+    uint64_t BindGroupLayoutBase::GetCompatibilityToken() const {
+        return mCompatibilityToken;
+    }
+
     BindingIndex BindGroupLayoutBase::GetBindingIndex(BindingNumber bindingNumber) const {
+        BindingIndex bindingIndex = 0;
+        bool found = TryGetBindingIndex(bindingNumber, &bindingIndex);
+        ASSERT(found);
+        DAWN_UNUSED(found);
+        return bindingIndex;
+    }
+
+    bool BindGroupLayoutBase::TryGetBindingIndex(BindingNumber bindingNumber,
+                                                 BindingIndex* bindingIndex) const {
         ASSERT(!IsError());
-        const auto& it = mBindingMap.find(bindingNumber);
-        ASSERT(it != mBindingMap.end());
-        return it->second;
+        if (mDirectLookup) {
+            if (bindingNumber >= mLookupTable.size() ||
+                mLookupTable[bindingNumber].index == kInvalidBindingIndex) {
+                return false;
+            }
+            *bindingIndex = mLookupTable[bindingNumber].index;
+            return true;
+        }
+
+        uint32_t slot = (bindingNumber * 0x9E3779B9u) & mLookupMask;
+        while (mLookupTable[slot].index != kInvalidBindingIndex) {
+            if (mLookupTable[slot].number == bindingNumber) {
+                *bindingIndex = mLookupTable[slot].index;
+                return true;
+            }
+            slot = (slot + 1) & mLookupMask;
+        }
+        return false;
     }
 
-    size_t BindGroupLayoutBase::HashFunc::operator()(const BindGroupLayoutBase* bgl) const {
+    size_t BindGroupLayoutBase::ComputeContentHash() const {
         size_t hash = 0;
         // std::map is sorted by key, so two BGLs constructed in different orders
         // will still hash the same.
-        for (const auto& it : bgl->mBindingMap) {
+        for (const auto& it : mBindingMap) {
             HashCombine(&hash, it.first, it.second);
-            HashCombineBindingInfo(&hash, bgl->mBindingInfo[it.second]);
+            HashCombineBindingInfo(&hash, mBindingInfo[it.second]);
+            // Samplers are deduplicated by the device cache, so hashing the pointer is
+            // equivalent to hashing the sampler descriptor.
+            HashCombine(&hash, mStaticSamplers[it.second].Get());
         }
         return hash;
     }
 
+    size_t BindGroupLayoutBase::HashFunc::operator()(const BindGroupLayoutBase* bgl) const {
+        return bgl->mContentHash;
+    }
+
     bool BindGroupLayoutBase::EqualityFunc::operator()(const BindGroupLayoutBase* a,
                                                        const BindGroupLayoutBase* b) const {
+        if (a->mContentHash != b->mContentHash) {
+            return false;
+        }
         if (a->GetBindingCount() != b->GetBindingCount()) {
             return false;
         }
@@ -390,10 +511,21 @@ namespace dawn_native {
             if (a->mBindingInfo[i] != b->mBindingInfo[i]) {
                 return false;
             }
+            if (a->mStaticSamplers[i].Get() != b->mStaticSamplers[i].Get()) {
+                return false;
+            }
         }
         return a->mBindingMap == b->mBindingMap;
     }
 
+    BindingIndex BindGroupLayoutBase::GetStaticSamplerCount() const {
+        return mStaticSamplerCount;
+    }
+
+    BindingIndex BindGroupLayoutBase::GetBindingArrayCount() const {
+        return mBindingArrayCount;
+    }
+
     BindingIndex BindGroupLayoutBase::GetBindingCount() const {
         return mBindingCount;
     }
@@ -28,6 +28,7 @@
 #include <array>
 #include <bitset>
 #include <map>
+#include <vector>
 
 namespace dawn_native {
 
@@ -35,6 +36,7 @@ namespace dawn_native {
                                                  const BindGroupLayoutDescriptor* descriptor);
 
     MaybeError ValidateBindingTypeWithShaderStageVisibility(
+        DeviceBase* device,
         wgpu::BindingType bindingType,
         wgpu::ShaderStage shaderStageVisibility);
 
@@ -62,6 +64,15 @@ namespace dawn_native {
         }
         const BindingMap& GetBindingMap() const;
         BindingIndex GetBindingIndex(BindingNumber bindingNumber) const;
+        // Returns false when |bindingNumber| doesn't exist in the layout. A single table
+        // lookup, for per-entry hot paths like bind group creation.
+        bool TryGetBindingIndex(BindingNumber bindingNumber, BindingIndex* bindingIndex) const;
+
+        // A device-unique ID for this layout. Because layouts are deduplicated by the
+        // device cache, two layouts are compatible exactly when their tokens are equal,
+        // which lets per-draw validation compare integers instead of walking binding
+        // maps. Error layouts have a token of 0, which never matches.
+        uint64_t GetCompatibilityToken() const;
 
         // Functors necessary for the unordered_set<BGLBase*>-based cache.
         struct HashFunc {
@@ -71,6 +82,22 @@ namespace dawn_native {
             bool operator()(const BindGroupLayoutBase* a, const BindGroupLayoutBase* b) const;
         };
 
+        // A static sampler is owned by the layout: bind groups must not (and cannot)
+        // provide the binding, and backends may embed the sampler into their native
+        // layout so hot paths skip the sampler descriptor entirely. Defined inline
+        // because bind group creation queries it per entry.
+        SamplerBase* GetStaticSampler(BindingIndex bindingIndex) const {
+            ASSERT(!IsError());
+            ASSERT(bindingIndex < mBindingCount);
+            return mStaticSamplers[bindingIndex].Get();
+        }
+        BindingIndex GetStaticSamplerCount() const;
+
+        // The number of bindings with a bindingArraySize larger than 1. Array bindings use
+        // update-after-bind semantics: bind groups must not provide resources for them and
+        // backends leave their descriptors to be written later.
+        BindingIndex GetBindingArrayCount() const;
+
         BindingIndex GetBindingCount() const;
         // Returns |BindingIndex| because dynamic buffers are packed at the front.
         BindingIndex GetDynamicBufferCount() const;
@@ -116,9 +143,34 @@ namespace dawn_native {
         uint32_t mDynamicStorageBufferCount = 0;
 
         std::array<BindingInfo, kMaxBindingsPerGroup> mBindingInfo;
+        std::array<Ref<SamplerBase>, kMaxBindingsPerGroup> mStaticSamplers;
+        BindingIndex mStaticSamplerCount = 0;
+        BindingIndex mBindingArrayCount = 0;
 
         // Map from BindGroupLayoutEntry.binding to packed indices.
         BindingMap mBindingMap;
+
+        // Lookup table compiled at creation so binding number lookups are one array
+        // access instead of a std::map walk. When binding numbers are dense the table is
+        // indexed by the binding number directly; sparse numbers fall back to an
+        // open-addressed power-of-two hash probed linearly. Empty slots have an invalid
+        // |index|. Layouts are deduplicated by the device cache so the compile cost
+        // amortizes across every bind group created with the layout.
+        struct BindingSlot {
+            BindingNumber number;
+            BindingIndex index;
+        };
+        bool mDirectLookup = true;
+        uint32_t mLookupMask = 0;
+        std::vector<BindingSlot> mLookupTable;
+
+        // The content hash over the binding map, binding infos and static samplers,
+        // computed once at construction so cache lookups don't rehash the full binding
+        // arrays. Both the blueprint and the cached layout pay the walk exactly once.
+        size_t ComputeContentHash() const;
+        size_t mContentHash = 0;
+
+        uint64_t mCompatibilityToken = 0;
     };
 
 }  // namespace dawn_native
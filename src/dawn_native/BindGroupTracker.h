@@ -46,9 +46,14 @@ namespace dawn_native {
                 if (mBindGroups[index] != bindGroup) {
                     mDirtyBindGroups.set(index);
                     mDirtyBindGroupsObjectChangedOrIsDynamic.set(index);
-                }
-
-                if (dynamicOffsetCount > 0) {
+                } else if (dynamicOffsetCount > 0 &&
+                           !DynamicOffsetsEqual(mDynamicOffsets[index].data(),
+                                                mDynamicOffsetCounts[index], dynamicOffsetCount,
+                                                dynamicOffsets)) {
+                    // Re-binding the same bind group with identical dynamic offsets would be a
+                    // no-op, so only dirty dynamic bind groups when the offsets actually changed.
+                    // This lets backends skip re-recording descriptor set binds for state that is
+                    // identical to what was last applied.
                     mDirtyBindGroupsObjectChangedOrIsDynamic.set(index);
                 }
             }
@@ -128,6 +133,29 @@ namespace dawn_native {
                                       uint32_t* dynamicOffsets) {
             memcpy(data, dynamicOffsets, sizeof(uint32_t) * dynamicOffsetCount);
         }
+
+        static bool DynamicOffsetsEqual(const uint64_t* data,
+                                        uint32_t count,
+                                        uint32_t dynamicOffsetCount,
+                                        const uint32_t* dynamicOffsets) {
+            if (count != dynamicOffsetCount) {
+                return false;
+            }
+            for (uint32_t i = 0; i < dynamicOffsetCount; ++i) {
+                if (data[i] != static_cast<uint64_t>(dynamicOffsets[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static bool DynamicOffsetsEqual(const uint32_t* data,
+                                        uint32_t count,
+                                        uint32_t dynamicOffsetCount,
+                                        const uint32_t* dynamicOffsets) {
+            return count == dynamicOffsetCount &&
+                   memcmp(data, dynamicOffsets, sizeof(uint32_t) * dynamicOffsetCount) == 0;
+        }
     };
 
 }  // namespace dawn_native
@@ -39,6 +39,11 @@ namespace dawn_native {
         wgpu::TextureFormat storageTextureFormat = wgpu::TextureFormat::Undefined;
         bool hasDynamicOffset = false;
         bool multisampled = false;
+        // A size larger than 1 makes the binding an array of descriptors indexed in the
+        // shader. Array bindings use update-after-bind semantics: the bind group provides
+        // no resources for them at creation and backends leave their descriptors to be
+        // written later.
+        uint32_t bindingArraySize = 1;
     };
 
 }  // namespace dawn_native
@@ -24,9 +24,12 @@ namespace dawn_native {
 
         mFreeLists.resize(Log2(mMaxBlockSize) + 1);
 
+        // The level occupancy mask has one bit per level.
+        ASSERT(mFreeLists.size() <= 64);
+
         // Insert the level0 free block.
         mRoot = new BuddyBlock(maxSize, /*offset*/ 0);
-        mFreeLists[0] = {mRoot};
+        InsertFreeBlock(mRoot, 0);
     }
 
     BuddyAllocator::~BuddyAllocator() {
@@ -39,6 +42,20 @@ namespace dawn_native {
         return ComputeNumOfFreeBlocks(mRoot);
     }
 
+    BuddyAllocator::Statistics BuddyAllocator::GetStatistics() const {
+        Statistics statistics;
+        statistics.freeSize = mFreeSize;
+        statistics.allocatedSize = mAllocatedSize;
+        statistics.freeBlockCount = mFreeBlockCount;
+        statistics.largestFreeBlockSize = 0;
+        if (mLevelOccupancy != 0) {
+            // The largest free block lives at the lowest-indexed occupied level.
+            const uint32_t lowestLevel = Log2(mLevelOccupancy & ~(mLevelOccupancy - 1));
+            statistics.largestFreeBlockSize = mMaxBlockSize >> lowestLevel;
+        }
+        return statistics;
+    }
+
     uint64_t BuddyAllocator::ComputeNumOfFreeBlocks(BuddyBlock* block) const {
         if (block->mState == BlockState::Free) {
             return 1;
@@ -81,12 +98,20 @@ namespace dawn_native {
         //  Allocate(size=8, alignment=4) will be satified by using F1.
         //  Allocate(size=8, alignment=16) will be satisified by using F2.
         //
-        for (size_t ii = 0; ii <= allocationBlockLevel; ++ii) {
-            size_t currLevel = allocationBlockLevel - ii;
+        // Candidate levels are the occupied levels holding blocks of at least the allocation
+        // size (bits 0 to allocationBlockLevel). Scanning the occupancy mask visits only them
+        // instead of walking every level.
+        uint64_t candidateLevels =
+            mLevelOccupancy & ((uint64_t(2) << allocationBlockLevel) - 1);
+        while (candidateLevels != 0) {
+            // Prefer the smallest usable block, which lives at the highest-indexed level.
+            const size_t currLevel = Log2(candidateLevels);
             BuddyBlock* freeBlock = mFreeLists[currLevel].head;
-            if (freeBlock && (freeBlock->mOffset % alignment == 0)) {
+            ASSERT(freeBlock != nullptr);
+            if (freeBlock->mOffset % alignment == 0) {
                 return currLevel;
             }
+            candidateLevels &= ~(uint64_t(1) << currLevel);
         }
         return kInvalidOffset;  // No free block exists at any level.
     }
@@ -111,6 +136,10 @@ namespace dawn_native {
         }
 
         mFreeLists[level].head = block;
+
+        mLevelOccupancy |= uint64_t(1) << level;
+        mFreeSize += block->mSize;
+        mFreeBlockCount++;
     }
 
     void BuddyAllocator::RemoveFreeBlock(BuddyBlock* block, size_t level) {
@@ -134,6 +163,12 @@ namespace dawn_native {
                 pNext->free.pPrev = pPrev;
             }
         }
+
+        if (mFreeLists[level].head == nullptr) {
+            mLevelOccupancy &= ~(uint64_t(1) << level);
+        }
+        mFreeSize -= block->mSize;
+        mFreeBlockCount--;
     }
 
     uint64_t BuddyAllocator::Allocate(uint64_t allocationSize, uint64_t alignment) {
@@ -196,6 +231,8 @@ namespace dawn_native {
         RemoveFreeBlock(currBlock, currBlockLevel);
         currBlock->mState = BlockState::Allocated;
 
+        mAllocatedSize += currBlock->mSize;
+
         return currBlock->mOffset;
     }
 
@@ -223,6 +260,8 @@ namespace dawn_native {
         // Ensure the block is at the correct level
         ASSERT(currBlockLevel == ComputeLevelFromBlockSize(curr->mSize));
 
+        mAllocatedSize -= curr->mSize;
+
         // Mark curr free so we can merge.
         curr->mState = BlockState::Free;
 
@@ -42,6 +42,17 @@ namespace dawn_native {
         uint64_t Allocate(uint64_t allocationSize, uint64_t alignment = 1);
         void Deallocate(uint64_t offset);
 
+        // Counters maintained incrementally by Allocate/Deallocate. Used to measure occupancy
+        // and fragmentation (ex. 1 - largestFreeBlockSize / freeSize) when tuning heap sizes
+        // per platform.
+        struct Statistics {
+            uint64_t freeSize;              // Total bytes held in free blocks.
+            uint64_t allocatedSize;         // Total bytes of allocated blocks (after rounding).
+            uint64_t freeBlockCount;        // Number of free blocks in the tree.
+            uint64_t largestFreeBlockSize;  // Size of the largest free block, 0 if full.
+        };
+        Statistics GetStatistics() const;
+
         // For testing purposes only.
         uint64_t ComputeTotalNumOfFreeBlocksForTesting() const;
 
@@ -110,6 +121,15 @@ namespace dawn_native {
         // List of linked-lists of free blocks where the index is a level that
         // corresponds to a power-of-two sized block.
         std::vector<BlockList> mFreeLists;
+
+        // Bit N is set iff mFreeLists[N] is non-empty, so the first-fit level for an
+        // allocation can be found with a single bit scan instead of walking every level.
+        uint64_t mLevelOccupancy = 0;
+
+        // Incrementally tracked statistics, see GetStatistics().
+        uint64_t mFreeSize = 0;
+        uint64_t mAllocatedSize = 0;
+        uint64_t mFreeBlockCount = 0;
     };
 
 }  // namespace dawn_native
@@ -21,6 +21,7 @@
 #include "dawn_native/MapRequestTracker.h"
 #include "dawn_native/ValidationUtils_autogen.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <utility>
@@ -95,17 +96,40 @@ namespace dawn_native {
         }
 
         DAWN_TRY(ValidateBufferUsage(descriptor->usage));
+        DAWN_TRY(ValidateMemoryAllocationHint(descriptor->allocationHint));
 
         wgpu::BufferUsage usage = descriptor->usage;
 
-        const wgpu::BufferUsage kMapWriteAllowedUsages =
-            wgpu::BufferUsage::MapWrite | wgpu::BufferUsage::CopySrc;
-        if (usage & wgpu::BufferUsage::MapWrite && (usage & kMapWriteAllowedUsages) != usage) {
-            return DAWN_VALIDATION_ERROR("Only CopySrc is allowed with MapWrite");
+        // Persistent mapping keeps the buffer mapped for its entire lifetime, which requires
+        // the backend to place it in host-visible memory like the other mappable usages do.
+        if (usage & wgpu::BufferUsage::MapPersistent &&
+            !(usage & (wgpu::BufferUsage::MapRead | wgpu::BufferUsage::MapWrite))) {
+            return DAWN_VALIDATION_ERROR("MapPersistent requires MapRead or MapWrite");
         }
 
-        const wgpu::BufferUsage kMapReadAllowedUsages =
-            wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst;
+        // Discard mapping hands the application fresh upload memory and never exposes the
+        // buffer's own storage, so it is exempt from the host-visibility restriction on
+        // MapWrite below and can be combined with any GPU usage.
+        if (usage & wgpu::BufferUsage::MapWriteDiscard) {
+            if (!(usage & wgpu::BufferUsage::MapWrite)) {
+                return DAWN_VALIDATION_ERROR("MapWriteDiscard requires MapWrite");
+            }
+            if (usage & (wgpu::BufferUsage::MapRead | wgpu::BufferUsage::MapPersistent)) {
+                return DAWN_VALIDATION_ERROR(
+                    "MapWriteDiscard is incompatible with MapRead and MapPersistent");
+            }
+        } else {
+            const wgpu::BufferUsage kMapWriteAllowedUsages = wgpu::BufferUsage::MapWrite |
+                                                             wgpu::BufferUsage::MapPersistent |
+                                                             wgpu::BufferUsage::CopySrc;
+            if (usage & wgpu::BufferUsage::MapWrite && (usage & kMapWriteAllowedUsages) != usage) {
+                return DAWN_VALIDATION_ERROR("Only CopySrc is allowed with MapWrite");
+            }
+        }
+
+        const wgpu::BufferUsage kMapReadAllowedUsages = wgpu::BufferUsage::MapRead |
+                                                        wgpu::BufferUsage::MapPersistent |
+                                                        wgpu::BufferUsage::CopyDst;
         if (usage & wgpu::BufferUsage::MapRead && (usage & kMapReadAllowedUsages) != usage) {
             return DAWN_VALIDATION_ERROR("Only CopyDst is allowed with MapRead");
         }
@@ -119,6 +143,7 @@ namespace dawn_native {
         : ObjectBase(device),
           mSize(descriptor->size),
           mUsage(descriptor->usage),
+          mAllocationHint(descriptor->allocationHint),
           mState(BufferState::Unmapped) {
         // Add readonly storage usage if the buffer has a storage usage. The validation rules in
         // ValidatePassResourceUsage will make sure we don't use both at the same
@@ -162,11 +187,49 @@ namespace dawn_native {
         return mUsage;
     }
 
+    wgpu::MemoryAllocationHint BufferBase::GetAllocationHint() const {
+        ASSERT(!IsError());
+        return mAllocationHint;
+    }
+
+    bool BufferBase::IsDataInitialized() const {
+        ASSERT(!IsError());
+        return mInitializedSize >= mSize;
+    }
+
+    uint64_t BufferBase::GetInitializedSize() const {
+        ASSERT(!IsError());
+        return mInitializedSize;
+    }
+
+    void BufferBase::MarkRangeInitialized(uint64_t offset, uint64_t size) {
+        ASSERT(!IsError());
+        // The write must connect to the watermark to extend it; a write further into the
+        // buffer leaves a gap of unwritten bytes behind it, so it is conservatively
+        // dropped. Note that no overflow can happen because writes are validated to fit
+        // in the buffer.
+        if (offset <= mInitializedSize) {
+            mInitializedSize = std::max(mInitializedSize, offset + size);
+        }
+    }
+
+    void BufferBase::MarkDataInitialized() {
+        ASSERT(!IsError());
+        mInitializedSize = mSize;
+    }
+
     MaybeError BufferBase::MapAtCreation(uint8_t** mappedPointer) {
         ASSERT(!IsError());
         ASSERT(mappedPointer != nullptr);
 
-        mState = BufferState::Mapped;
+        // The application gets a pointer to the whole buffer, so its contents count as
+        // whatever the application wrote there.
+        MarkDataInitialized();
+
+        // Persistently mapped buffers have a mappable usage, so they always take the
+        // MapAtCreationImpl path below and get a pointer that stays stable for their lifetime.
+        mState = (mUsage & wgpu::BufferUsage::MapPersistent) ? BufferState::PersistentlyMapped
+                                                             : BufferState::Mapped;
 
         if (IsMapWritable()) {
             DAWN_TRY(MapAtCreationImpl(mappedPointer));
@@ -186,6 +249,25 @@ namespace dawn_native {
         return {};
     }
 
+    MaybeError BufferBase::FreezeUsage(wgpu::BufferUsage usage) {
+        DAWN_TRY(ValidateFreezeUsage(usage));
+        ASSERT(!IsError());
+
+        DAWN_TRY(FreezeUsageImpl(usage));
+        mFrozenUsage = usage;
+        return {};
+    }
+
+    wgpu::BufferUsage BufferBase::GetFrozenUsage() const {
+        ASSERT(!IsError());
+        return mFrozenUsage;
+    }
+
+    bool BufferBase::IsFrozenForUsage(wgpu::BufferUsage usage) const {
+        ASSERT(!IsError());
+        return mFrozenUsage != wgpu::BufferUsage::None && (usage & ~mFrozenUsage) == 0;
+    }
+
     MaybeError BufferBase::ValidateCanUseInSubmitNow() const {
         ASSERT(!IsError());
 
@@ -194,6 +276,7 @@ namespace dawn_native {
                 return DAWN_VALIDATION_ERROR("Destroyed buffer used in a submit");
             case BufferState::Mapped:
                 return DAWN_VALIDATION_ERROR("Buffer used in a submit while mapped");
+            case BufferState::PersistentlyMapped:
             case BufferState::Unmapped:
                 return {};
             default:
@@ -252,6 +335,8 @@ namespace dawn_native {
         if (GetDevice()->ConsumedError(SetSubDataImpl(start, count, data))) {
             return;
         }
+
+        MarkRangeInitialized(start, count);
     }
 
     void BufferBase::MapReadAsync(WGPUBufferMapReadCallback callback, void* userdata) {
@@ -268,6 +353,23 @@ namespace dawn_native {
         mMapSerial++;
         mMapReadCallback = callback;
         mMapUserdata = userdata;
+
+        // Persistently mapped buffers stay mapped for their remaining lifetime and their
+        // pointer is coherently visible, so the request doesn't need to wait on the queue
+        // serial through the map request tracker.
+        if (mUsage & wgpu::BufferUsage::MapPersistent) {
+            mState = BufferState::PersistentlyMapped;
+
+            if (GetDevice()->ConsumedError(MapReadAsyncImpl(mMapSerial))) {
+                CallMapReadCallback(mMapSerial, WGPUBufferMapAsyncStatus_DeviceLost, nullptr, 0);
+                return;
+            }
+
+            CallMapReadCallback(mMapSerial, WGPUBufferMapAsyncStatus_Success,
+                                GetMappedPointerImpl(), GetSize());
+            return;
+        }
+
         mState = BufferState::Mapped;
 
         if (GetDevice()->ConsumedError(MapReadAsyncImpl(mMapSerial))) {
@@ -279,6 +381,10 @@ namespace dawn_native {
         tracker->Track(this, mMapSerial, false);
     }
 
+    MaybeError BufferBase::FreezeUsageImpl(wgpu::BufferUsage) {
+        return {};
+    }
+
     MaybeError BufferBase::SetSubDataImpl(uint32_t start, uint32_t count, const void* data) {
         DynamicUploader* uploader = GetDevice()->GetDynamicUploader();
 
@@ -287,7 +393,7 @@ namespace dawn_native {
                         uploader->Allocate(count, GetDevice()->GetPendingCommandSerial()));
         ASSERT(uploadHandle.mappedBuffer != nullptr);
 
-        memcpy(uploadHandle.mappedBuffer, data, count);
+        StagingBufferBase::StreamingCopy(uploadHandle.mappedBuffer, data, count);
 
         DAWN_TRY(GetDevice()->CopyFromStagingToBuffer(
             uploadHandle.stagingBuffer, uploadHandle.startOffset, this, start, count));
@@ -309,6 +415,44 @@ namespace dawn_native {
         mMapSerial++;
         mMapWriteCallback = callback;
         mMapUserdata = userdata;
+
+        // As for MapAtCreation, the application gets a pointer to the whole buffer.
+        MarkDataInitialized();
+
+        // Discard semantics: instead of waiting for the GPU to be done with the buffer,
+        // hand the application a fresh upload allocation right away; Unmap() then replaces
+        // the buffer's contents with a GPU copy and the old contents are orphaned. This
+        // lets per-frame streaming buffers be remapped without ever blocking on the queue.
+        if (mUsage & wgpu::BufferUsage::MapWriteDiscard) {
+            mState = BufferState::Mapped;
+
+            if (GetDevice()->ConsumedError(CreateDiscardStagingBuffer())) {
+                CallMapWriteCallback(mMapSerial, WGPUBufferMapAsyncStatus_DeviceLost, nullptr, 0);
+                return;
+            }
+
+            ASSERT(mStagingBuffer->GetMappedPointer() != nullptr);
+            CallMapWriteCallback(mMapSerial, WGPUBufferMapAsyncStatus_Success,
+                                 mStagingBuffer->GetMappedPointer(), GetSize());
+            return;
+        }
+
+        // Persistently mapped buffers stay mapped for their remaining lifetime and their
+        // pointer is coherently visible, so the request doesn't need to wait on the queue
+        // serial through the map request tracker.
+        if (mUsage & wgpu::BufferUsage::MapPersistent) {
+            mState = BufferState::PersistentlyMapped;
+
+            if (GetDevice()->ConsumedError(MapWriteAsyncImpl(mMapSerial))) {
+                CallMapWriteCallback(mMapSerial, WGPUBufferMapAsyncStatus_DeviceLost, nullptr, 0);
+                return;
+            }
+
+            CallMapWriteCallback(mMapSerial, WGPUBufferMapAsyncStatus_Success,
+                                 GetMappedPointerImpl(), GetSize());
+            return;
+        }
+
         mState = BufferState::Mapped;
 
         if (GetDevice()->ConsumedError(MapWriteAsyncImpl(mMapSerial))) {
@@ -340,6 +484,14 @@ namespace dawn_native {
         DestroyInternal();
     }
 
+    MaybeError BufferBase::CreateDiscardStagingBuffer() {
+        // The staging buffer is released through the DynamicUploader on Unmap(), so each
+        // map gets a new backing allocation while the previous ones are reclaimed once the
+        // GPU is done copying out of them.
+        DAWN_TRY_ASSIGN(mStagingBuffer, GetDevice()->CreateStagingBuffer(GetSize()));
+        return {};
+    }
+
     MaybeError BufferBase::CopyFromStagingBuffer() {
         ASSERT(mStagingBuffer);
         DAWN_TRY(GetDevice()->CopyFromStagingToBuffer(mStagingBuffer.get(), 0, this, 0, GetSize()));
@@ -387,6 +539,7 @@ namespace dawn_native {
                 return DAWN_VALIDATION_ERROR("Buffer is mapped");
             case BufferState::Destroyed:
                 return DAWN_VALIDATION_ERROR("Buffer is destroyed");
+            case BufferState::PersistentlyMapped:
             case BufferState::Unmapped:
                 break;
         }
@@ -414,6 +567,49 @@ namespace dawn_native {
             return DAWN_VALIDATION_ERROR("Buffer needs the CopyDst usage bit");
         }
 
+        if (mFrozenUsage != wgpu::BufferUsage::None) {
+            return DAWN_VALIDATION_ERROR("Buffer with frozen usage cannot be written");
+        }
+
+        return {};
+    }
+
+    MaybeError BufferBase::ValidateFreezeUsage(wgpu::BufferUsage usage) const {
+        DAWN_TRY(GetDevice()->ValidateIsAlive());
+        DAWN_TRY(GetDevice()->ValidateObject(this));
+
+        switch (mState) {
+            case BufferState::Mapped:
+            case BufferState::PersistentlyMapped:
+                return DAWN_VALIDATION_ERROR("Buffer cannot be frozen while mapped");
+            case BufferState::Destroyed:
+                return DAWN_VALIDATION_ERROR("Buffer is destroyed");
+            case BufferState::Unmapped:
+                break;
+        }
+
+        if (usage == wgpu::BufferUsage::None) {
+            return DAWN_VALIDATION_ERROR("Frozen usage cannot be empty");
+        }
+
+        if (usage & ~mUsage) {
+            return DAWN_VALIDATION_ERROR("Buffer missing usage to freeze to");
+        }
+
+        if ((usage & kReadOnlyBufferUsages) != usage) {
+            return DAWN_VALIDATION_ERROR("Frozen usage must be read-only");
+        }
+
+        // Mapping would need to transition the buffer out of its frozen state, so mappable
+        // buffers cannot be frozen at all.
+        if (mUsage & (wgpu::BufferUsage::MapRead | wgpu::BufferUsage::MapWrite)) {
+            return DAWN_VALIDATION_ERROR("Mappable buffers cannot be frozen");
+        }
+
+        if (mFrozenUsage != wgpu::BufferUsage::None) {
+            return DAWN_VALIDATION_ERROR("Buffer usage is already frozen");
+        }
+
         return {};
     }
 
@@ -427,6 +623,7 @@ namespace dawn_native {
 
         switch (mState) {
             case BufferState::Mapped:
+            case BufferState::PersistentlyMapped:
                 return DAWN_VALIDATION_ERROR("Buffer already mapped");
             case BufferState::Destroyed:
                 return DAWN_VALIDATION_ERROR("Buffer is destroyed");
@@ -451,6 +648,8 @@ namespace dawn_native {
                 // A buffer may be in the Mapped state if it was created with CreateBufferMapped
                 // even if it did not have a mappable usage.
                 return {};
+            case BufferState::PersistentlyMapped:
+                return DAWN_VALIDATION_ERROR("Persistently mapped buffer cannot be unmapped");
             case BufferState::Unmapped:
                 if ((mUsage & (wgpu::BufferUsage::MapRead | wgpu::BufferUsage::MapWrite)) == 0) {
                     return DAWN_VALIDATION_ERROR("Buffer does not have map usage");
@@ -465,6 +664,14 @@ namespace dawn_native {
 
     MaybeError BufferBase::ValidateDestroy() const {
         DAWN_TRY(GetDevice()->ValidateObject(this));
+
+        // Frozen buffers skip the per-pass tracking that backs the submit-time destroyed
+        // check, so destroying one would go undetected by later submits that still use it.
+        // The backing memory is reclaimed when the last reference is released instead.
+        if (mFrozenUsage != wgpu::BufferUsage::None) {
+            return DAWN_VALIDATION_ERROR("Buffer with frozen usage cannot be destroyed");
+        }
+
         return {};
     }
 
@@ -476,7 +683,7 @@ namespace dawn_native {
     }
 
     bool BufferBase::IsMapped() const {
-        return mState == BufferState::Mapped;
+        return mState == BufferState::Mapped || mState == BufferState::PersistentlyMapped;
     }
 
     void BufferBase::OnMapCommandSerialFinished(uint32_t mapSerial, bool isWrite) {
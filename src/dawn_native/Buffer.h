@@ -35,6 +35,9 @@ namespace dawn_native {
         enum class BufferState {
             Unmapped,
             Mapped,
+            // The buffer was created with MapPersistent and stays mapped for its remaining
+            // lifetime. Unlike Mapped, the buffer may be used in submits while in this state.
+            PersistentlyMapped,
             Destroyed,
         };
 
@@ -48,12 +51,36 @@ namespace dawn_native {
 
         uint64_t GetSize() const;
         wgpu::BufferUsage GetUsage() const;
+        // Placement preferences for the backing memory; backends treat these as advisory.
+        wgpu::MemoryAllocationHint GetAllocationHint() const;
+
+        // Tracking of which bytes have been written since creation, kept as a single
+        // contiguous watermark from the start of the buffer. Streaming buffers are written
+        // front to back so the watermark covers them exactly; writes that would leave a
+        // gap behind them don't extend it. Backends use this to restrict their lazy
+        // zero-clears to the bytes past the watermark, so a buffer whose first use fully
+        // overwrites it is never cleared at all.
+        bool IsDataInitialized() const;
+        uint64_t GetInitializedSize() const;
+        void MarkRangeInitialized(uint64_t offset, uint64_t size);
+        void MarkDataInitialized();
 
         MaybeError MapAtCreation(uint8_t** mappedPointer);
         void OnMapCommandSerialFinished(uint32_t mapSerial, bool isWrite);
 
         MaybeError ValidateCanUseInSubmitNow() const;
 
+        // Permanently restricts the buffer to a read-only subset of its usages. Frozen
+        // buffers are transitioned to that state once and then skip per-pass usage tracking
+        // (and with it per-pass barriers and submit-time checks) entirely, which is the
+        // common case for static vertex/index pools that are written once and read forever.
+        // Exposed through dawn_native::FreezeBufferUsage.
+        MaybeError FreezeUsage(wgpu::BufferUsage usage);
+        // None when the buffer isn't frozen.
+        wgpu::BufferUsage GetFrozenUsage() const;
+        // True when the buffer is frozen and the frozen usage covers |usage|.
+        bool IsFrozenForUsage(wgpu::BufferUsage usage) const;
+
         // Dawn API
         void SetSubData(uint32_t start, uint32_t count, const void* data);
         void MapReadAsync(WGPUBufferMapReadCallback callback, void* userdata);
@@ -81,6 +108,9 @@ namespace dawn_native {
       private:
         virtual MaybeError MapAtCreationImpl(uint8_t** mappedPointer) = 0;
         virtual MaybeError SetSubDataImpl(uint32_t start, uint32_t count, const void* data);
+        // Transitions the buffer to its frozen usage. Only overridden by backends that
+        // track per-buffer states, since no more transitions happen after freezing.
+        virtual MaybeError FreezeUsageImpl(wgpu::BufferUsage usage);
         virtual MaybeError MapReadAsyncImpl(uint32_t serial) = 0;
         virtual MaybeError MapWriteAsyncImpl(uint32_t serial) = 0;
         virtual void UnmapImpl() = 0;
@@ -88,16 +118,22 @@ namespace dawn_native {
         virtual void* GetMappedPointerImpl() = 0;
 
         virtual bool IsMapWritable() const = 0;
+        MaybeError CreateDiscardStagingBuffer();
         MaybeError CopyFromStagingBuffer();
 
         MaybeError ValidateSetSubData(uint32_t start, uint32_t count) const;
+        MaybeError ValidateFreezeUsage(wgpu::BufferUsage usage) const;
         MaybeError ValidateMap(wgpu::BufferUsage requiredUsage,
                                WGPUBufferMapAsyncStatus* status) const;
         MaybeError ValidateUnmap() const;
         MaybeError ValidateDestroy() const;
 
         uint64_t mSize = 0;
+        // See IsDataInitialized; bytes in [0, mInitializedSize) have been written.
+        uint64_t mInitializedSize = 0;
         wgpu::BufferUsage mUsage = wgpu::BufferUsage::None;
+        wgpu::BufferUsage mFrozenUsage = wgpu::BufferUsage::None;
+        wgpu::MemoryAllocationHint mAllocationHint = wgpu::MemoryAllocationHint::None;
 
         WGPUBufferMapReadCallback mMapReadCallback = nullptr;
         WGPUBufferMapWriteCallback mMapWriteCallback = nullptr;
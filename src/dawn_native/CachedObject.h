@@ -31,6 +31,7 @@ namespace dawn_native {
 
       private:
         friend class DeviceBase;
+        friend class InstanceBase;
         void SetIsCachedReference();
 
         bool mIsCachedReference = false;
@@ -14,9 +14,12 @@
 
 #include "dawn_native/CommandAllocator.h"
 
+#include "common/AlignedAlloc.h"
 #include "common/Assert.h"
 #include "common/Math.h"
 
+#include "dawn_platform/DawnPlatform.h"
+
 #include <algorithm>
 #include <climits>
 #include <cstdlib>
@@ -25,76 +28,108 @@ namespace dawn_native {
 
     // TODO(cwallez@chromium.org): figure out a way to have more type safety for the iterator
 
-    CommandIterator::CommandIterator() {
-        Reset();
+    CommandBlockPool::~CommandBlockPool() {
+        for (uint8_t* block : mPool) {
+            ReportFree(kPooledBlockSize);
+            AlignedFree(block);
+        }
+    }
+
+    uint8_t* CommandBlockPool::Acquire() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mPool.empty()) {
+            return nullptr;
+        }
+        uint8_t* block = mPool.back();
+        mPool.pop_back();
+        return block;
+    }
+
+    void CommandBlockPool::Recycle(CommandBlocks* blocks) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (BlockDef& block : *blocks) {
+            if (block.size == kPooledBlockSize && mPool.size() < kMaxPooledBlocks) {
+                mPool.push_back(block.block);
+            } else {
+                ReportFree(block.size);
+                AlignedFree(block.block);
+            }
+        }
+        blocks->clear();
     }
 
+    void CommandBlockPool::SetPlatform(dawn_platform::Platform* platform) {
+        mPlatform = platform;
+    }
+
+    void CommandBlockPool::ReportAllocation(size_t size) const {
+        if (mPlatform != nullptr) {
+            mPlatform->OnMemoryAllocated(dawn_platform::MemoryCategory::CommandBlocks, size);
+        }
+    }
+
+    void CommandBlockPool::ReportFree(size_t size) const {
+        if (mPlatform != nullptr) {
+            mPlatform->OnMemoryFreed(dawn_platform::MemoryCategory::CommandBlocks, size);
+        }
+    }
+
+    CommandIterator::CommandIterator() = default;
+
     CommandIterator::~CommandIterator() {
         ASSERT(mDataWasDestroyed);
 
         if (!IsEmpty()) {
-            for (auto& block : mBlocks) {
-                free(block.block);
+            if (mBlockPool != nullptr) {
+                mBlockPool->Recycle(&mBlocks);
+            } else {
+                for (auto& block : mBlocks) {
+                    AlignedFree(block.block);
+                }
             }
         }
     }
 
     CommandIterator::CommandIterator(CommandIterator&& other) {
-        if (!other.IsEmpty()) {
-            mBlocks = std::move(other.mBlocks);
-            other.Reset();
-        }
+        mBlocks = std::move(other.mBlocks);
+        mHeaders = std::move(other.mHeaders);
+        mBlockPool = other.mBlockPool;
+        other.mBlocks.clear();
+        other.mHeaders.clear();
+        other.Reset();
         other.DataWasDestroyed();
         Reset();
     }
 
     CommandIterator& CommandIterator::operator=(CommandIterator&& other) {
-        if (!other.IsEmpty()) {
-            mBlocks = std::move(other.mBlocks);
-            other.Reset();
-        } else {
-            mBlocks.clear();
-        }
+        mBlocks = std::move(other.mBlocks);
+        mHeaders = std::move(other.mHeaders);
+        mBlockPool = other.mBlockPool;
+        other.mBlocks.clear();
+        other.mHeaders.clear();
+        other.Reset();
         other.DataWasDestroyed();
         Reset();
         return *this;
     }
 
     CommandIterator::CommandIterator(CommandAllocator&& allocator)
-        : mBlocks(allocator.AcquireBlocks()) {
+        : mBlocks(allocator.AcquireBlocks()),
+          mHeaders(allocator.AcquireHeaders()),
+          mBlockPool(allocator.mBlockPool) {
         Reset();
     }
 
     CommandIterator& CommandIterator::operator=(CommandAllocator&& allocator) {
         mBlocks = allocator.AcquireBlocks();
+        mHeaders = allocator.AcquireHeaders();
+        mBlockPool = allocator.mBlockPool;
         Reset();
         return *this;
     }
 
-    bool CommandIterator::NextCommandIdInNewBlock(uint32_t* commandId) {
-        mCurrentBlock++;
-        if (mCurrentBlock >= mBlocks.size()) {
-            Reset();
-            *commandId = detail::kEndOfBlock;
-            return false;
-        }
-        mCurrentPtr = AlignPtr(mBlocks[mCurrentBlock].block, alignof(uint32_t));
-        return NextCommandId(commandId);
-    }
-
     void CommandIterator::Reset() {
-        mCurrentBlock = 0;
-
-        if (mBlocks.empty()) {
-            // This will case the first NextCommandId call to try to move to the next block and stop
-            // the iteration immediately, without special casing the initialization.
-            mCurrentPtr = reinterpret_cast<uint8_t*>(&mEndOfBlock);
-            mBlocks.emplace_back();
-            mBlocks[0].size = sizeof(mEndOfBlock);
-            mBlocks[0].block = mCurrentPtr;
-        } else {
-            mCurrentPtr = AlignPtr(mBlocks[0].block, alignof(uint32_t));
-        }
+        mCurrentHeader = 0;
     }
 
     void CommandIterator::DataWasDestroyed() {
@@ -102,7 +137,7 @@ namespace dawn_native {
     }
 
     bool CommandIterator::IsEmpty() const {
-        return mBlocks[0].block == reinterpret_cast<const uint8_t*>(&mEndOfBlock);
+        return mBlocks.empty();
     }
 
     // Potential TODO(cwallez@chromium.org):
@@ -124,27 +159,38 @@ namespace dawn_native {
         ASSERT(mBlocks.empty());
     }
 
+    void CommandAllocator::SetBlockPool(CommandBlockPool* pool) {
+        ASSERT(mBlocks.empty());
+        mBlockPool = pool;
+    }
+
+    void CommandAllocator::SetUseLargePages(bool useLargePages) {
+        ASSERT(mBlocks.empty());
+        mUseLargePages = useLargePages;
+    }
+
+    void CommandAllocator::Reserve(size_t size) {
+        if (!mBlocks.empty()) {
+            return;
+        }
+        GetNewBlock(size);
+    }
+
     CommandBlocks&& CommandAllocator::AcquireBlocks() {
         ASSERT(mCurrentPtr != nullptr && mEndPtr != nullptr);
-        ASSERT(IsPtrAligned(mCurrentPtr, alignof(uint32_t)));
-        ASSERT(mCurrentPtr + sizeof(uint32_t) <= mEndPtr);
-        *reinterpret_cast<uint32_t*>(mCurrentPtr) = detail::kEndOfBlock;
-
         mCurrentPtr = nullptr;
         mEndPtr = nullptr;
         return std::move(mBlocks);
     }
 
+    CommandHeaders&& CommandAllocator::AcquireHeaders() {
+        return std::move(mHeaders);
+    }
+
     uint8_t* CommandAllocator::AllocateInNewBlock(uint32_t commandId,
                                                   size_t commandSize,
                                                   size_t commandAlignment) {
-        // When there is not enough space, we signal the kEndOfBlock, so that the iterator knows
-        // to move to the next one. kEndOfBlock on the last block means the end of the commands.
-        uint32_t* idAlloc = reinterpret_cast<uint32_t*>(mCurrentPtr);
-        *idAlloc = detail::kEndOfBlock;
-
-        // We'll request a block that can contain at least the command ID, the command and an
-        // additional ID to contain the kEndOfBlock tag.
+        // We'll request a block that can contain at least the aligned command.
         size_t requestedBlockSize = commandSize + kWorstCaseAdditionalSize;
 
         // The computation of the request could overflow.
@@ -159,17 +205,34 @@ namespace dawn_native {
     }
 
     bool CommandAllocator::GetNewBlock(size_t minimumSize) {
-        // Allocate blocks doubling sizes each time, to a maximum of 16k (or at least minimumSize).
+        // Allocate blocks doubling sizes each time, to a maximum of kPooledBlockSize (or at
+        // least minimumSize). With large pages enabled the doubling continues to the large
+        // page size instead, so a long command tape ends up on a few large-page-backed
+        // blocks rather than many pooled ones.
+        size_t maxBlockSize =
+            mUseLargePages ? kLargePageSize : size_t(CommandBlockPool::kPooledBlockSize);
         mLastAllocationSize =
-            std::max(minimumSize, std::min(mLastAllocationSize * 2, size_t(16384)));
+            std::max(minimumSize, std::min(mLastAllocationSize * 2, maxBlockSize));
+
+        // Steady-state blocks all have kPooledBlockSize, try to recycle one.
+        uint8_t* block = nullptr;
+        if (mBlockPool != nullptr && mLastAllocationSize == CommandBlockPool::kPooledBlockSize) {
+            block = mBlockPool->Acquire();
+        }
 
-        uint8_t* block = static_cast<uint8_t*>(malloc(mLastAllocationSize));
-        if (DAWN_UNLIKELY(block == nullptr)) {
-            return false;
+        if (block == nullptr) {
+            block = static_cast<uint8_t*>(
+                AlignedAlloc(mLastAllocationSize, kBlockAlignment, mUseLargePages));
+            if (DAWN_UNLIKELY(block == nullptr)) {
+                return false;
+            }
+            if (mBlockPool != nullptr) {
+                mBlockPool->ReportAllocation(mLastAllocationSize);
+            }
         }
 
         mBlocks.push_back({mLastAllocationSize, block});
-        mCurrentPtr = AlignPtr(block, alignof(uint32_t));
+        mCurrentPtr = block;
         mEndPtr = block + mLastAllocationSize;
         return true;
     }
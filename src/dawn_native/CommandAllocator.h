@@ -20,14 +20,20 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <mutex>
 #include <vector>
 
+namespace dawn_platform {
+    class Platform;
+}  // namespace dawn_platform
+
 namespace dawn_native {
 
     // Allocation for command buffers should be fast. To avoid doing an allocation per command
     // or to avoid copying commands when reallocing, we use a linear allocator in a growing set
-    // of large memory blocks. We also use this to have the format to be (u32 commandId, command),
-    // so that iteration over the commands is easy.
+    // of large memory blocks. The command ids live in a separate dense header stream (one
+    // {payload pointer, id} entry per command) so replay loops iterate a contiguous array
+    // instead of taking a data-dependent stride through the payload tape for every command.
 
     // Usage of the allocator and iterator:
     //     CommandAllocator allocator;
@@ -59,13 +65,58 @@ namespace dawn_native {
     };
     using CommandBlocks = std::vector<BlockDef>;
 
+    // One header per command (or additional data), in allocation order. The payloads stay
+    // in the command blocks; the header records where each one starts since the alignment
+    // padding in the tape depends on the command type and can't be recomputed at replay.
+    struct CommandHeader {
+        uint8_t* command;
+        uint32_t id;
+    };
+    using CommandHeaders = std::vector<CommandHeader>;
+
     namespace detail {
-        constexpr uint32_t kEndOfBlock = std::numeric_limits<uint32_t>::max();
         constexpr uint32_t kAdditionalData = std::numeric_limits<uint32_t>::max() - 1;
     }  // namespace detail
 
     class CommandAllocator;
 
+    // Recycles command blocks between encoders so steady-state encoding doesn't touch the
+    // heap. CommandAllocator caps its doubling block sizes at kPooledBlockSize so after the
+    // first few allocations every block has that exact size; only those are pooled, other
+    // sizes are freed normally. The pool is owned by DeviceBase and shared between encoders
+    // which may record on different threads, so it is lock protected; the lock is taken once
+    // per kPooledBlockSize of commands so contention is negligible.
+    class CommandBlockPool {
+      public:
+        ~CommandBlockPool();
+
+        // Returns a block of kPooledBlockSize bytes, or nullptr when the pool is empty.
+        uint8_t* Acquire();
+        // Pools or frees all of |blocks| and clears the vector.
+        void Recycle(CommandBlocks* blocks);
+
+        // Reports command block allocations and frees to |platform| under
+        // MemoryCategory::CommandBlocks so embedders can attribute Dawn's host memory.
+        // Blocks retained by the pool count as allocated until the pool is destroyed.
+        // May be null to disable reporting.
+        void SetPlatform(dawn_platform::Platform* platform);
+
+        static constexpr size_t kPooledBlockSize = 16384;
+
+      private:
+        friend CommandAllocator;
+
+        void ReportAllocation(size_t size) const;
+        void ReportFree(size_t size) const;
+
+        // Caps the memory retained by the pool to kMaxPooledBlocks * kPooledBlockSize.
+        static constexpr size_t kMaxPooledBlocks = 32;
+
+        dawn_platform::Platform* mPlatform = nullptr;
+        std::mutex mMutex;
+        std::vector<uint8_t*> mPool;
+    };
+
     // TODO(cwallez@chromium.org): prevent copy for both iterator and allocator
     class CommandIterator {
       public:
@@ -94,34 +145,41 @@ namespace dawn_native {
         // Needs to be called if iteration was stopped early.
         void Reset();
 
+        // Saving and restoring the read position lets a backend walk the same stretch of
+        // commands several times, for example to measure a pass before deciding how to
+        // replay it. A position is only meaningful on the iterator it was taken from.
+        size_t GetPosition() const {
+            return mCurrentHeader;
+        }
+        void SeekTo(size_t position) {
+            ASSERT(position <= mHeaders.size());
+            mCurrentHeader = position;
+        }
+
         void DataWasDestroyed();
 
       private:
         bool IsEmpty() const;
 
+        // The header stream is a dense array so the loads prefetch linearly and the end
+        // check branch-predicts perfectly; replaying tens of thousands of commands never
+        // chases a block boundary.
         DAWN_FORCE_INLINE bool NextCommandId(uint32_t* commandId) {
-            uint8_t* idPtr = AlignPtr(mCurrentPtr, alignof(uint32_t));
-            ASSERT(idPtr + sizeof(uint32_t) <=
-                   mBlocks[mCurrentBlock].block + mBlocks[mCurrentBlock].size);
-
-            uint32_t id = *reinterpret_cast<uint32_t*>(idPtr);
-
-            if (id != detail::kEndOfBlock) {
-                mCurrentPtr = idPtr + sizeof(uint32_t);
-                *commandId = id;
+            if (DAWN_LIKELY(mCurrentHeader < mHeaders.size())) {
+                *commandId = mHeaders[mCurrentHeader].id;
+                mCurrentHeader++;
                 return true;
             }
-            return NextCommandIdInNewBlock(commandId);
+            Reset();
+            return false;
         }
 
-        bool NextCommandIdInNewBlock(uint32_t* commandId);
-
         DAWN_FORCE_INLINE void* NextCommand(size_t commandSize, size_t commandAlignment) {
-            uint8_t* commandPtr = AlignPtr(mCurrentPtr, commandAlignment);
-            ASSERT(commandPtr + sizeof(commandSize) <=
-                   mBlocks[mCurrentBlock].block + mBlocks[mCurrentBlock].size);
-
-            mCurrentPtr = commandPtr + commandSize;
+            DAWN_UNUSED(commandSize);
+            // The payload of the header consumed by the last NextCommandId.
+            ASSERT(mCurrentHeader > 0);
+            uint8_t* commandPtr = mHeaders[mCurrentHeader - 1].command;
+            ASSERT(IsPtrAligned(commandPtr, commandAlignment));
             return commandPtr;
         }
 
@@ -135,10 +193,10 @@ namespace dawn_native {
         }
 
         CommandBlocks mBlocks;
-        uint8_t* mCurrentPtr = nullptr;
-        size_t mCurrentBlock = 0;
-        // Used to avoid a special case for empty iterators.
-        uint32_t mEndOfBlock = detail::kEndOfBlock;
+        CommandHeaders mHeaders;
+        // Pool the blocks came from, if any, so they are recycled instead of freed.
+        CommandBlockPool* mBlockPool = nullptr;
+        size_t mCurrentHeader = 0;
         bool mDataWasDestroyed = false;
     };
 
@@ -147,6 +205,24 @@ namespace dawn_native {
         CommandAllocator();
         ~CommandAllocator();
 
+        // Takes steady-state blocks from |pool| instead of the heap. Must be called before
+        // the first allocation. The pool pointer travels with the blocks into the
+        // CommandIterator so they are recycled when the commands are destroyed.
+        void SetBlockPool(CommandBlockPool* pool);
+
+        // Lets blocks grow to the large page size and requests large page backing for
+        // them, instead of capping blocks at the pooled size. Blocks bigger than
+        // kPooledBlockSize bypass the pool, so this trades block recycling for fewer TLB
+        // misses while encoding and replaying long command tapes. Must be called before
+        // the first allocation.
+        void SetUseLargePages(bool useLargePages);
+
+        // Pre-allocates a single block of |size| bytes so encoders that know approximately
+        // how much command memory they will record take one allocation instead of a
+        // doubling series. Only meaningful before the first command; a failed allocation is
+        // not an error, the allocation path will retry on demand.
+        void Reserve(size_t size);
+
         template <typename T, typename E>
         T* Allocate(E commandId) {
             static_assert(sizeof(E) == sizeof(uint32_t), "");
@@ -180,46 +256,40 @@ namespace dawn_native {
         static constexpr size_t kMaxSupportedAlignment = 8;
 
         // To avoid checking for overflows at every step of the computations we compute an upper
-        // bound of the space that will be needed in addition to the command data.
-        static constexpr size_t kWorstCaseAdditionalSize =
-            sizeof(uint32_t) + kMaxSupportedAlignment + alignof(uint32_t) + sizeof(uint32_t);
+        // bound of the space that will be needed in addition to the command data. The tape only
+        // holds payloads (the ids live in the header stream), so the bound is the worst-case
+        // alignment padding.
+        static constexpr size_t kWorstCaseAdditionalSize = kMaxSupportedAlignment;
+
+        // Blocks start on a cache line so commands never straddle one more line than their
+        // size requires.
+        static constexpr size_t kBlockAlignment = 64;
 
         friend CommandIterator;
         CommandBlocks&& AcquireBlocks();
+        CommandHeaders&& AcquireHeaders();
 
         DAWN_FORCE_INLINE uint8_t* Allocate(uint32_t commandId,
                                             size_t commandSize,
                                             size_t commandAlignment) {
             ASSERT(mCurrentPtr != nullptr);
             ASSERT(mEndPtr != nullptr);
-            ASSERT(commandId != detail::kEndOfBlock);
-
-            // It should always be possible to allocate one id, for kEndOfBlock tagging,
-            ASSERT(IsPtrAligned(mCurrentPtr, alignof(uint32_t)));
             ASSERT(mEndPtr >= mCurrentPtr);
-            ASSERT(static_cast<size_t>(mEndPtr - mCurrentPtr) >= sizeof(uint32_t));
 
-            // The memory after the ID will contain the following:
-            //   - the current ID
+            // The memory at mCurrentPtr will contain the following:
             //   - padding to align the command, maximum kMaxSupportedAlignment
             //   - the command of size commandSize
-            //   - padding to align the next ID, maximum alignof(uint32_t)
-            //   - the next ID of size sizeof(uint32_t)
 
-            // This can't overflow because by construction mCurrentPtr always has space for the next
-            // ID.
             size_t remainingSize = static_cast<size_t>(mEndPtr - mCurrentPtr);
 
             // The good case were we have enough space for the command data and upper bound of the
             // extra required space.
-            if ((remainingSize >= kWorstCaseAdditionalSize) &&
-                (remainingSize - kWorstCaseAdditionalSize >= commandSize)) {
-                uint32_t* idAlloc = reinterpret_cast<uint32_t*>(mCurrentPtr);
-                *idAlloc = commandId;
-
-                uint8_t* commandAlloc = AlignPtr(mCurrentPtr + sizeof(uint32_t), commandAlignment);
-                mCurrentPtr = AlignPtr(commandAlloc + commandSize, alignof(uint32_t));
+            if (DAWN_LIKELY((remainingSize >= kWorstCaseAdditionalSize) &&
+                            (remainingSize - kWorstCaseAdditionalSize >= commandSize))) {
+                uint8_t* commandAlloc = AlignPtr(mCurrentPtr, commandAlignment);
+                mCurrentPtr = commandAlloc + commandSize;
 
+                mHeaders.push_back({commandAlloc, commandId});
                 return commandAlloc;
             }
             return AllocateInNewBlock(commandId, commandSize, commandAlignment);
@@ -236,11 +306,13 @@ namespace dawn_native {
         bool GetNewBlock(size_t minimumSize);
 
         CommandBlocks mBlocks;
+        CommandHeaders mHeaders;
+        CommandBlockPool* mBlockPool = nullptr;
+        bool mUseLargePages = false;
         size_t mLastAllocationSize = 2048;
 
-        // Pointers to the current range of allocation in the block. Guaranteed to allow for at
-        // least one uint32_t if not nullptr, so that the special kEndOfBlock command id can always
-        // be written. Nullptr iff the blocks were moved out.
+        // Pointers to the current range of allocation in the block. Nullptr iff the blocks
+        // were moved out.
         uint8_t* mCurrentPtr = nullptr;
         uint8_t* mEndPtr = nullptr;
 
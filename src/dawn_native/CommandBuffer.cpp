@@ -23,7 +23,9 @@
 namespace dawn_native {
 
     CommandBufferBase::CommandBufferBase(CommandEncoder* encoder, const CommandBufferDescriptor*)
-        : ObjectBase(encoder->GetDevice()), mResourceUsages(encoder->AcquireResourceUsages()) {
+        : ObjectBase(encoder->GetDevice()),
+          mResourceUsages(encoder->AcquireResourceUsages()),
+          mReusable(encoder->IsReusable()) {
     }
 
     CommandBufferBase::CommandBufferBase(DeviceBase* device, ObjectBase::ErrorTag tag)
@@ -39,6 +41,10 @@ namespace dawn_native {
         return mResourceUsages;
     }
 
+    bool CommandBufferBase::IsReusable() const {
+        return mReusable;
+    }
+
     bool IsCompleteSubresourceCopiedTo(const TextureBase* texture,
                                        const Extent3D copySize,
                                        const uint32_t mipLevel) {
@@ -32,10 +32,15 @@ namespace dawn_native {
 
         const CommandBufferResourceUsage& GetResourceUsages() const;
 
+        // True when the command buffer was produced by a reusable encoder and may be
+        // submitted more than once. Backends use this to cache their recorded commands.
+        bool IsReusable() const;
+
       private:
         CommandBufferBase(DeviceBase* device, ObjectBase::ErrorTag tag);
 
         CommandBufferResourceUsage mResourceUsages;
+        bool mReusable = false;
     };
     bool IsCompleteSubresourceCopiedTo(const TextureBase* texture,
                                        const Extent3D copySize,
@@ -93,9 +93,13 @@ namespace dawn_native {
         if (aspects[VALIDATION_ASPECT_BIND_GROUPS]) {
             bool matches = true;
 
+            // Bind group layouts are deduplicated by the device, so comparing the cached
+            // compatibility tokens is equivalent to comparing the layouts themselves.
+            // Unset slots hold a token of 0, which never matches a layout.
+            const std::array<uint64_t, kMaxBindGroups>& requiredTokens =
+                mLastPipelineLayout->GetBindGroupCompatibilityTokens();
             for (uint32_t i : IterateBitSet(mLastPipelineLayout->GetBindGroupLayoutsMask())) {
-                if (mBindgroups[i] == nullptr ||
-                    mLastPipelineLayout->GetBindGroupLayout(i) != mBindgroups[i]->GetLayout()) {
+                if (mBindgroupTokens[i] != requiredTokens[i]) {
                     matches = false;
                     break;
                 }
@@ -107,11 +111,8 @@ namespace dawn_native {
         }
 
         if (aspects[VALIDATION_ASPECT_VERTEX_BUFFERS]) {
-            ASSERT(mLastRenderPipeline != nullptr);
-
-            const std::bitset<kMaxVertexBuffers>& requiredVertexBuffers =
-                mLastRenderPipeline->GetVertexBufferSlotsUsed();
-            if ((mVertexBufferSlotsUsed & requiredVertexBuffers) == requiredVertexBuffers) {
+            if ((mVertexBufferSlotsUsed & mRequiredVertexBufferSlots) ==
+                mRequiredVertexBufferSlots) {
                 mAspects.set(VALIDATION_ASPECT_VERTEX_BUFFERS);
             }
         }
@@ -150,12 +151,14 @@ namespace dawn_native {
     }
 
     void CommandBufferStateTracker::SetRenderPipeline(RenderPipelineBase* pipeline) {
-        mLastRenderPipeline = pipeline;
+        // The slots-used mask is precomputed at pipeline creation, so snapshotting it here
+        // keeps the vertex buffer aspect a compare between two cached masks.
+        mRequiredVertexBufferSlots = pipeline->GetVertexBufferSlotsUsed();
         SetPipelineCommon(pipeline);
     }
 
     void CommandBufferStateTracker::SetBindGroup(uint32_t index, BindGroupBase* bindgroup) {
-        mBindgroups[index] = bindgroup;
+        mBindgroupTokens[index] = bindgroup->GetLayoutCompatibilityToken();
     }
 
     void CommandBufferStateTracker::SetIndexBuffer() {
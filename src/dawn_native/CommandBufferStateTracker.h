@@ -54,11 +54,18 @@ namespace dawn_native {
 
         ValidationAspects mAspects;
 
-        std::array<BindGroupBase*, kMaxBindGroups> mBindgroups = {};
+        // The compatibility tokens of the layouts of the currently bound groups, so the
+        // bind group aspect reduces to integer compares; see
+        // BindGroupLayoutBase::GetCompatibilityToken. 0 for slots that are unset.
+        std::array<uint64_t, kMaxBindGroups> mBindgroupTokens = {};
         std::bitset<kMaxVertexBuffers> mVertexBufferSlotsUsed;
 
+        // The vertex buffer slots the current render pipeline requires, cached at
+        // SetRenderPipeline so the vertex buffer aspect reduces to a mask compare against
+        // mVertexBufferSlotsUsed without reaching back into the pipeline.
+        std::bitset<kMaxVertexBuffers> mRequiredVertexBufferSlots;
+
         PipelineLayoutBase* mLastPipelineLayout = nullptr;
-        RenderPipelineBase* mLastRenderPipeline = nullptr;
     };
 
 }  // namespace dawn_native
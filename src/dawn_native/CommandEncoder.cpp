@@ -14,8 +14,11 @@
 
 #include "dawn_native/CommandEncoder.h"
 
+#include <algorithm>
 #include <cmath>
 #include <map>
+#include <utility>
+#include <vector>
 
 #include "common/BitSetIterator.h"
 #include "dawn_native/BindGroup.h"
@@ -23,13 +26,17 @@
 #include "dawn_native/CommandBuffer.h"
 #include "dawn_native/CommandBufferStateTracker.h"
 #include "dawn_native/CommandValidation.h"
+#include "dawn_native/CommandStream.h"
 #include "dawn_native/Commands.h"
 #include "dawn_native/ComputePassEncoder.h"
 #include "dawn_native/Device.h"
 #include "dawn_native/ErrorData.h"
+#include "dawn_native/QuerySet.h"
 #include "dawn_native/RayTracingAccelerationContainer.h"
 #include "dawn_native/RayTracingPassEncoder.h"
 #include "dawn_native/RenderPassEncoder.h"
+#include "dawn_native/RenderPassMerger.h"
+#include "dawn_native/RenderPassReorder.h"
 #include "dawn_native/RenderPipeline.h"
 #include "dawn_native/ValidationUtils_autogen.h"
 #include "dawn_platform/DawnPlatform.h"
@@ -106,7 +113,7 @@ namespace dawn_native {
 
         MaybeError ValidateTexelBufferOffset(const BufferCopyView& bufferCopy,
                                              const Format& format) {
-            if (bufferCopy.offset % format.blockByteSize != 0) {
+            if (bufferCopy.offset % GetTexelBlockInfo(format.format).byteSize != 0) {
                 return DAWN_VALIDATION_ERROR(
                     "Buffer offset must be a multiple of the texel or block size");
             }
@@ -121,7 +128,7 @@ namespace dawn_native {
                 return DAWN_VALIDATION_ERROR("rowsPerImage must not be less than the copy height.");
             }
 
-            if (rowsPerImage % format.blockHeight != 0) {
+            if (rowsPerImage % GetTexelBlockInfo(format.format).height != 0) {
                 return DAWN_VALIDATION_ERROR(
                     "rowsPerImage must be a multiple of compressed texture format block height");
             }
@@ -188,9 +195,10 @@ namespace dawn_native {
                                                 uint32_t rowsPerImage,
                                                 uint32_t* bufferSize) {
             ASSERT(rowsPerImage >= copySize.height);
-            uint32_t blockByteSize = textureFormat.blockByteSize;
-            uint32_t blockWidth = textureFormat.blockWidth;
-            uint32_t blockHeight = textureFormat.blockHeight;
+            const TexelBlockInfo blockInfo = GetTexelBlockInfo(textureFormat.format);
+            uint32_t blockByteSize = blockInfo.byteSize;
+            uint32_t blockWidth = blockInfo.width;
+            uint32_t blockHeight = blockInfo.height;
 
             // TODO(cwallez@chromium.org): check for overflows
             uint32_t slicePitch = bytesPerRow * rowsPerImage / blockWidth;
@@ -202,7 +210,8 @@ namespace dawn_native {
         }
 
         uint32_t ComputeDefaultBytesPerRow(const Format& format, uint32_t width) {
-            return width / format.blockWidth * format.blockByteSize;
+            const TexelBlockInfo blockInfo = GetTexelBlockInfo(format.format);
+            return width / blockInfo.width * blockInfo.byteSize;
         }
 
         MaybeError ValidateBytesPerRow(const Format& format,
@@ -212,7 +221,8 @@ namespace dawn_native {
                 return DAWN_VALIDATION_ERROR("bytesPerRow must be a multiple of 256");
             }
 
-            if (bytesPerRow < copySize.width / format.blockWidth * format.blockByteSize) {
+            const TexelBlockInfo blockInfo = GetTexelBlockInfo(format.format);
+            if (bytesPerRow < copySize.width / blockInfo.width * blockInfo.byteSize) {
                 return DAWN_VALIDATION_ERROR(
                     "bytesPerRow must not be less than the number of bytes per row");
             }
@@ -221,12 +231,13 @@ namespace dawn_native {
         }
 
         MaybeError ValidateImageOrigin(const Format& format, const Origin3D& offset) {
-            if (offset.x % format.blockWidth != 0) {
+            const TexelBlockInfo blockInfo = GetTexelBlockInfo(format.format);
+            if (offset.x % blockInfo.width != 0) {
                 return DAWN_VALIDATION_ERROR(
                     "Offset.x must be a multiple of compressed texture format block width");
             }
 
-            if (offset.y % format.blockHeight != 0) {
+            if (offset.y % blockInfo.height != 0) {
                 return DAWN_VALIDATION_ERROR(
                     "Offset.y must be a multiple of compressed texture format block height");
             }
@@ -235,12 +246,13 @@ namespace dawn_native {
         }
 
         MaybeError ValidateImageCopySize(const Format& format, const Extent3D& extent) {
-            if (extent.width % format.blockWidth != 0) {
+            const TexelBlockInfo blockInfo = GetTexelBlockInfo(format.format);
+            if (extent.width % blockInfo.width != 0) {
                 return DAWN_VALIDATION_ERROR(
                     "Extent.width must be a multiple of compressed texture format block width");
             }
 
-            if (extent.height % format.blockHeight != 0) {
+            if (extent.height % blockInfo.height != 0) {
                 return DAWN_VALIDATION_ERROR(
                     "Extent.height must be a multiple of compressed texture format block height");
             }
@@ -275,6 +287,92 @@ namespace dawn_native {
             return {};
         }
 
+        MaybeError ValidateRayTracingAccelerationContainerCanCompact(
+            const RayTracingAccelerationContainerBase* srcContainer,
+            const RayTracingAccelerationContainerBase* dstContainer) {
+            if (!srcContainer->IsBuilt()) {
+                return DAWN_VALIDATION_ERROR(
+                    "Source Acceleration Container must be built before compacting");
+            }
+            if (srcContainer->IsDestroyed()) {
+                return DAWN_VALIDATION_ERROR(
+                    "Source Acceleration Container is destroyed and cannot be used for "
+                    "compacting");
+            }
+            if ((srcContainer->GetUsage() &
+                 wgpu::RayTracingAccelerationContainerUsage::AllowCompaction) == 0) {
+                return DAWN_VALIDATION_ERROR(
+                    "Source Acceleration Container does not support compaction");
+            }
+            if (dstContainer->IsDestroyed()) {
+                return DAWN_VALIDATION_ERROR(
+                    "Destination Acceleration Container is destroyed and cannot be used for "
+                    "compacting");
+            }
+            if (srcContainer->GetLevel() != dstContainer->GetLevel()) {
+                return DAWN_VALIDATION_ERROR(
+                    "Acceleration Containers must be of the same level for compacting");
+            }
+            return {};
+        }
+
+        MaybeError ValidateRayTracingAccelerationContainerCanWriteCompactedSize(
+            const RayTracingAccelerationContainerBase* container) {
+            if (!container->IsBuilt()) {
+                return DAWN_VALIDATION_ERROR(
+                    "Acceleration Container must be built before querying its compacted size");
+            }
+            if (container->IsDestroyed()) {
+                return DAWN_VALIDATION_ERROR(
+                    "Cannot query the compacted size of a destroyed Acceleration Container");
+            }
+            if ((container->GetUsage() &
+                 wgpu::RayTracingAccelerationContainerUsage::AllowCompaction) == 0) {
+                return DAWN_VALIDATION_ERROR(
+                    "Acceleration Container does not support compaction");
+            }
+            return {};
+        }
+
+        MaybeError ValidateRayTracingAccelerationContainerCanWriteSerializationSize(
+            const RayTracingAccelerationContainerBase* container) {
+            if (!container->IsBuilt()) {
+                return DAWN_VALIDATION_ERROR(
+                    "Acceleration Container must be built before querying its serialization size");
+            }
+            if (container->IsDestroyed()) {
+                return DAWN_VALIDATION_ERROR(
+                    "Cannot query the serialization size of a destroyed Acceleration Container");
+            }
+            return {};
+        }
+
+        MaybeError ValidateRayTracingAccelerationContainerCanSerialize(
+            const RayTracingAccelerationContainerBase* container) {
+            if (!container->IsBuilt()) {
+                return DAWN_VALIDATION_ERROR(
+                    "Acceleration Container must be built before serializing");
+            }
+            if (container->IsDestroyed()) {
+                return DAWN_VALIDATION_ERROR(
+                    "Cannot serialize a destroyed Acceleration Container");
+            }
+            return {};
+        }
+
+        MaybeError ValidateRayTracingAccelerationContainerCanDeserialize(
+            const RayTracingAccelerationContainerBase* container) {
+            if (container->IsBuilt()) {
+                return DAWN_VALIDATION_ERROR(
+                    "Cannot deserialize into an already built Acceleration Container");
+            }
+            if (container->IsDestroyed()) {
+                return DAWN_VALIDATION_ERROR(
+                    "Cannot deserialize into a destroyed Acceleration Container");
+            }
+            return {};
+        }
+
         MaybeError ValidateRayTracingAccelerationContainerCanCopy(
             const RayTracingAccelerationContainerBase* srcContainer,
             const RayTracingAccelerationContainerBase* dstContainer) {
@@ -304,6 +402,11 @@ namespace dawn_native {
                 return DAWN_VALIDATION_ERROR("buffer doesn't have the required usage.");
             }
 
+            if (buffer->GetFrozenUsage() != wgpu::BufferUsage::None &&
+                !(buffer->GetFrozenUsage() & usage)) {
+                return DAWN_VALIDATION_ERROR("buffer usage is frozen without the required usage.");
+            }
+
             return {};
         }
 
@@ -544,8 +647,17 @@ namespace dawn_native {
 
     }  // namespace
 
-    CommandEncoder::CommandEncoder(DeviceBase* device, const CommandEncoderDescriptor*)
-        : ObjectBase(device), mEncodingContext(device, this) {
+    CommandEncoder::CommandEncoder(DeviceBase* device, const CommandEncoderDescriptor* descriptor)
+        : ObjectBase(device),
+          mEncodingContext(device, this),
+          mReusable(descriptor != nullptr && descriptor->reusable) {
+        if (descriptor != nullptr && descriptor->sizeHint > 0) {
+            mEncodingContext.ReserveCommandSpace(static_cast<size_t>(descriptor->sizeHint));
+        }
+    }
+
+    bool CommandEncoder::IsReusable() const {
+        return mReusable;
     }
 
     CommandBufferResourceUsage CommandEncoder::AcquireResourceUsages() {
@@ -608,7 +720,7 @@ namespace dawn_native {
     RenderPassEncoder* CommandEncoder::BeginRenderPass(const RenderPassDescriptor* descriptor) {
         DeviceBase* device = GetDevice();
 
-        PassResourceUsageTracker usageTracker(PassType::Render);
+        PassResourceUsageTracker usageTracker(PassType::Render, &mEncodingContext);
         bool success =
             mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
                 uint32_t width = 0;
@@ -685,6 +797,14 @@ namespace dawn_native {
         mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
             DAWN_TRY(GetDevice()->ValidateObject((ObjectBase*)container));
 
+            // Builds of high and background priority containers are handed to the
+            // device's deferred build scheduler instead of being recorded.
+            if (container->GetPriority() !=
+                wgpu::RayTracingAccelerationContainerPriority::Immediate) {
+                GetDevice()->EnqueueDeferredContainerBuild(container);
+                return {};
+            }
+
             BuildRayTracingAccelerationContainerCmd* build =
                 allocator->Allocate<BuildRayTracingAccelerationContainerCmd>(
                     Command::BuildRayTracingAccelerationContainer);
@@ -698,6 +818,71 @@ namespace dawn_native {
         });
     }
 
+    void CommandEncoder::BuildRayTracingAccelerationContainers(
+        uint32_t containerCount,
+        RayTracingAccelerationContainerBase* const* containers) {
+        mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            for (uint32_t i = 0; i < containerCount; ++i) {
+                DAWN_TRY(GetDevice()->ValidateObject((ObjectBase*)containers[i]));
+            }
+
+            // Builds of high and background priority containers are handed to the
+            // device's deferred build scheduler; only immediate builds are recorded.
+            std::vector<RayTracingAccelerationContainerBase*> immediateContainers;
+            immediateContainers.reserve(containerCount);
+            for (uint32_t i = 0; i < containerCount; ++i) {
+                if (containers[i]->GetPriority() !=
+                    wgpu::RayTracingAccelerationContainerPriority::Immediate) {
+                    GetDevice()->EnqueueDeferredContainerBuild(containers[i]);
+                } else {
+                    immediateContainers.push_back(containers[i]);
+                }
+            }
+            if (immediateContainers.empty()) {
+                return {};
+            }
+
+            BuildRayTracingAccelerationContainersCmd* build =
+                allocator->Allocate<BuildRayTracingAccelerationContainersCmd>(
+                    Command::BuildRayTracingAccelerationContainers);
+            build->count = static_cast<uint32_t>(immediateContainers.size());
+
+            Ref<RayTracingAccelerationContainerBase>* builtContainers =
+                allocator->AllocateData<Ref<RayTracingAccelerationContainerBase>>(build->count);
+            for (uint32_t i = 0; i < build->count; ++i) {
+                builtContainers[i] = immediateContainers[i];
+
+                if (GetDevice()->IsValidationEnabled()) {
+                    mTopLevelAccelerationContainers.insert(immediateContainers[i]);
+                }
+            }
+
+            return {};
+        });
+    }
+
+    void CommandEncoder::CompactRayTracingAccelerationContainer(
+        RayTracingAccelerationContainerBase* srcContainer,
+        RayTracingAccelerationContainerBase* dstContainer) {
+        mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            DAWN_TRY(GetDevice()->ValidateObject((ObjectBase*)srcContainer));
+            DAWN_TRY(GetDevice()->ValidateObject((ObjectBase*)dstContainer));
+
+            CompactRayTracingAccelerationContainerCmd* compact =
+                allocator->Allocate<CompactRayTracingAccelerationContainerCmd>(
+                    Command::CompactRayTracingAccelerationContainer);
+            compact->srcContainer = srcContainer;
+            compact->dstContainer = dstContainer;
+
+            if (GetDevice()->IsValidationEnabled()) {
+                mTopLevelAccelerationContainers.insert(srcContainer);
+                mTopLevelAccelerationContainers.insert(dstContainer);
+            }
+
+            return {};
+        });
+    }
+
     void CommandEncoder::CopyRayTracingAccelerationContainer(
         RayTracingAccelerationContainerBase* srcContainer,
         RayTracingAccelerationContainerBase* dstContainer) {
@@ -738,6 +923,133 @@ namespace dawn_native {
         });
     }
 
+    void CommandEncoder::WriteRayTracingAccelerationContainerCompactedSize(
+        RayTracingAccelerationContainerBase* container,
+        BufferBase* destination,
+        uint64_t destinationOffset) {
+        mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            DAWN_TRY(GetDevice()->ValidateObject((ObjectBase*)container));
+            DAWN_TRY(GetDevice()->ValidateObject(destination));
+
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(ValidateCopySizeFitsInBuffer(destination, destinationOffset,
+                                                      sizeof(uint64_t)));
+                if (destinationOffset % sizeof(uint64_t) != 0) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Destination offset must be a multiple of 8 bytes");
+                }
+                DAWN_TRY(ValidateCanUseAs(destination, wgpu::BufferUsage::CopyDst));
+
+                mTopLevelBuffers.insert(destination);
+                mTopLevelAccelerationContainers.insert(container);
+            }
+
+            WriteRayTracingAccelerationContainerCompactedSizeCmd* write =
+                allocator->Allocate<WriteRayTracingAccelerationContainerCompactedSizeCmd>(
+                    Command::WriteRayTracingAccelerationContainerCompactedSize);
+            write->container = container;
+            write->destination = destination;
+            write->destinationOffset = destinationOffset;
+
+            return {};
+        });
+    }
+
+    void CommandEncoder::WriteRayTracingAccelerationContainerSerializationSize(
+        RayTracingAccelerationContainerBase* container,
+        BufferBase* destination,
+        uint64_t destinationOffset) {
+        mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            DAWN_TRY(GetDevice()->ValidateObject((ObjectBase*)container));
+            DAWN_TRY(GetDevice()->ValidateObject(destination));
+
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(ValidateCopySizeFitsInBuffer(destination, destinationOffset,
+                                                      sizeof(uint64_t)));
+                if (destinationOffset % sizeof(uint64_t) != 0) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Destination offset must be a multiple of 8 bytes");
+                }
+                DAWN_TRY(ValidateCanUseAs(destination, wgpu::BufferUsage::CopyDst));
+
+                mTopLevelBuffers.insert(destination);
+                mTopLevelAccelerationContainers.insert(container);
+            }
+
+            WriteRayTracingAccelerationContainerSerializationSizeCmd* write =
+                allocator->Allocate<WriteRayTracingAccelerationContainerSerializationSizeCmd>(
+                    Command::WriteRayTracingAccelerationContainerSerializationSize);
+            write->container = container;
+            write->destination = destination;
+            write->destinationOffset = destinationOffset;
+
+            return {};
+        });
+    }
+
+    void CommandEncoder::SerializeRayTracingAccelerationContainer(
+        RayTracingAccelerationContainerBase* container,
+        BufferBase* destination,
+        uint64_t destinationOffset) {
+        mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            DAWN_TRY(GetDevice()->ValidateObject((ObjectBase*)container));
+            DAWN_TRY(GetDevice()->ValidateObject(destination));
+
+            if (GetDevice()->IsValidationEnabled()) {
+                // The blob size is only known on the GPU timeline (see
+                // WriteRayTracingAccelerationContainerSerializationSize), so only the
+                // offset can be validated here. Backends address the blob buffer
+                // directly, hence the RayTracing usage requirement.
+                if (destinationOffset % 256 != 0) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Destination offset must be a multiple of 256 bytes");
+                }
+                DAWN_TRY(ValidateCanUseAs(destination, wgpu::BufferUsage::RayTracing));
+
+                mTopLevelBuffers.insert(destination);
+                mTopLevelAccelerationContainers.insert(container);
+            }
+
+            SerializeRayTracingAccelerationContainerCmd* serialize =
+                allocator->Allocate<SerializeRayTracingAccelerationContainerCmd>(
+                    Command::SerializeRayTracingAccelerationContainer);
+            serialize->container = container;
+            serialize->destination = destination;
+            serialize->destinationOffset = destinationOffset;
+
+            return {};
+        });
+    }
+
+    void CommandEncoder::DeserializeRayTracingAccelerationContainer(
+        RayTracingAccelerationContainerBase* container,
+        BufferBase* source,
+        uint64_t sourceOffset) {
+        mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            DAWN_TRY(GetDevice()->ValidateObject((ObjectBase*)container));
+            DAWN_TRY(GetDevice()->ValidateObject(source));
+
+            if (GetDevice()->IsValidationEnabled()) {
+                if (sourceOffset % 256 != 0) {
+                    return DAWN_VALIDATION_ERROR("Source offset must be a multiple of 256 bytes");
+                }
+                DAWN_TRY(ValidateCanUseAs(source, wgpu::BufferUsage::RayTracing));
+
+                mTopLevelBuffers.insert(source);
+                mTopLevelAccelerationContainers.insert(container);
+            }
+
+            DeserializeRayTracingAccelerationContainerCmd* deserialize =
+                allocator->Allocate<DeserializeRayTracingAccelerationContainerCmd>(
+                    Command::DeserializeRayTracingAccelerationContainer);
+            deserialize->container = container;
+            deserialize->source = source;
+            deserialize->sourceOffset = sourceOffset;
+
+            return {};
+        });
+    }
+
     void CommandEncoder::CopyBufferToBuffer(BufferBase* source,
                                             uint64_t sourceOffset,
                                             BufferBase* destination,
@@ -776,6 +1088,123 @@ namespace dawn_native {
         });
     }
 
+    void CommandEncoder::CopyBufferToBufferBatch(BufferBase* source,
+                                                 BufferBase* destination,
+                                                 uint32_t regionCount,
+                                                 const BufferCopyRegion* regions) {
+        mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(source));
+                DAWN_TRY(GetDevice()->ValidateObject(destination));
+
+                if (source == destination) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Source and destination cannot be the same buffer.");
+                }
+                if (regionCount == 0) {
+                    return DAWN_VALIDATION_ERROR("Batched copy requires at least one region");
+                }
+
+                // The buffer-wide checks are done once for the whole batch; only the
+                // offsets and sizes are per-region.
+                DAWN_TRY(ValidateCanUseAs(source, wgpu::BufferUsage::CopySrc));
+                DAWN_TRY(ValidateCanUseAs(destination, wgpu::BufferUsage::CopyDst));
+
+                for (uint32_t i = 0; i < regionCount; ++i) {
+                    const BufferCopyRegion& region = regions[i];
+                    DAWN_TRY(ValidateCopySizeFitsInBuffer(source, region.sourceOffset,
+                                                          region.size));
+                    DAWN_TRY(ValidateCopySizeFitsInBuffer(destination, region.destinationOffset,
+                                                          region.size));
+                    DAWN_TRY(ValidateB2BCopyAlignment(region.size, region.sourceOffset,
+                                                      region.destinationOffset));
+                }
+
+                // Backends may replay the batch as one multi-region copy where overlapping
+                // destination ranges are undefined, so reject them.
+                std::vector<std::pair<uint64_t, uint64_t>> destinationRanges;
+                destinationRanges.reserve(regionCount);
+                for (uint32_t i = 0; i < regionCount; ++i) {
+                    destinationRanges.emplace_back(regions[i].destinationOffset,
+                                                   regions[i].size);
+                }
+                std::sort(destinationRanges.begin(), destinationRanges.end());
+                for (uint32_t i = 1; i < regionCount; ++i) {
+                    if (destinationRanges[i - 1].first + destinationRanges[i - 1].second >
+                        destinationRanges[i].first) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Batched copy regions overlap in the destination buffer");
+                    }
+                }
+
+                mTopLevelBuffers.insert(source);
+                mTopLevelBuffers.insert(destination);
+            }
+
+            CopyBufferToBufferBatchCmd* copy = allocator->Allocate<CopyBufferToBufferBatchCmd>(
+                Command::CopyBufferToBufferBatch);
+            copy->source = source;
+            copy->destination = destination;
+            copy->regionCount = regionCount;
+
+            BufferCopyRegion* cmdRegions = allocator->AllocateData<BufferCopyRegion>(regionCount);
+            for (uint32_t i = 0; i < regionCount; ++i) {
+                cmdRegions[i] = regions[i];
+            }
+
+            return {};
+        });
+    }
+
+    void CommandEncoder::CopyBufferToRayTracingInstances(
+        BufferBase* source,
+        uint64_t sourceOffset,
+        RayTracingAccelerationContainerBase* container,
+        uint32_t firstInstance,
+        uint32_t instanceCount) {
+        mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(source));
+                DAWN_TRY(GetDevice()->ValidateObject((ObjectBase*)container));
+
+                if (container->GetLevel() !=
+                    wgpu::RayTracingAccelerationContainerLevel::Top) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Instances can only be copied into a top-level container");
+                }
+                if (instanceCount == 0) {
+                    return DAWN_VALIDATION_ERROR("Instance count must not be zero");
+                }
+                if (firstInstance > container->GetInstanceCount() ||
+                    instanceCount > container->GetInstanceCount() - firstInstance) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Instance range exceeds the container's instance count");
+                }
+
+                DAWN_TRY(ValidateCopySizeFitsInBuffer(source, sourceOffset,
+                                                      instanceCount * kRayTracingInstanceSize));
+                if (sourceOffset % 4 != 0) {
+                    return DAWN_VALIDATION_ERROR("Source offset must be a multiple of 4 bytes");
+                }
+                DAWN_TRY(ValidateCanUseAs(source, wgpu::BufferUsage::CopySrc));
+
+                mTopLevelBuffers.insert(source);
+                mTopLevelAccelerationContainers.insert(container);
+            }
+
+            CopyBufferToRayTracingInstancesCmd* copy =
+                allocator->Allocate<CopyBufferToRayTracingInstancesCmd>(
+                    Command::CopyBufferToRayTracingInstances);
+            copy->source = source;
+            copy->sourceOffset = sourceOffset;
+            copy->container = container;
+            copy->firstInstance = firstInstance;
+            copy->instanceCount = instanceCount;
+
+            return {};
+        });
+    }
+
     void CommandEncoder::CopyBufferToTexture(const BufferCopyView* source,
                                              const TextureCopyView* destination,
                                              const Extent3D* copySize) {
@@ -987,22 +1416,111 @@ namespace dawn_native {
         });
     }
 
+    void CommandEncoder::ResolveQuerySet(QuerySetBase* querySet,
+                                         uint32_t firstQuery,
+                                         uint32_t queryCount,
+                                         BufferBase* destination,
+                                         uint64_t destinationOffset) {
+        mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(querySet));
+                DAWN_TRY(GetDevice()->ValidateObject(destination));
+
+                if (querySet->IsDestroyed()) {
+                    return DAWN_VALIDATION_ERROR("Query set must not be destroyed");
+                }
+                if (firstQuery >= querySet->GetQueryCount()) {
+                    return DAWN_VALIDATION_ERROR("First query out of bounds");
+                }
+                if (queryCount > querySet->GetQueryCount() - firstQuery) {
+                    return DAWN_VALIDATION_ERROR("Resolved query range out of bounds");
+                }
+                if (destinationOffset % sizeof(uint64_t) != 0) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Destination offset must be a multiple of 8 bytes");
+                }
+                DAWN_TRY(ValidateCopySizeFitsInBuffer(destination, destinationOffset,
+                                                      queryCount * querySet->GetQueryDataSize()));
+                DAWN_TRY(ValidateCanUseAs(destination, wgpu::BufferUsage::QueryResolve));
+
+                mTopLevelBuffers.insert(destination);
+            }
+
+            ResolveQuerySetCmd* cmd =
+                allocator->Allocate<ResolveQuerySetCmd>(Command::ResolveQuerySet);
+            cmd->querySet = querySet;
+            cmd->firstQuery = firstQuery;
+            cmd->queryCount = queryCount;
+            cmd->destination = destination;
+            cmd->destinationOffset = destinationOffset;
+
+            return {};
+        });
+    }
+
+    void CommandEncoder::WriteTimestamp(QuerySetBase* querySet, uint32_t queryIndex) {
+        mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(querySet));
+
+                if (querySet->GetQueryType() != wgpu::QueryType::Timestamp) {
+                    return DAWN_VALIDATION_ERROR("The query set type must be Timestamp");
+                }
+                if (querySet->IsDestroyed()) {
+                    return DAWN_VALIDATION_ERROR("Query set must not be destroyed");
+                }
+                if (queryIndex >= querySet->GetQueryCount()) {
+                    return DAWN_VALIDATION_ERROR("Query index out of bounds");
+                }
+            }
+
+            WriteTimestampCmd* cmd =
+                allocator->Allocate<WriteTimestampCmd>(Command::WriteTimestamp);
+            cmd->querySet = querySet;
+            cmd->queryIndex = queryIndex;
+
+            return {};
+        });
+    }
+
     CommandBufferBase* CommandEncoder::Finish(const CommandBufferDescriptor* descriptor) {
         DeviceBase* device = GetDevice();
         // Even if mEncodingContext.Finish() validation fails, calling it will mutate the internal
         // state of the encoding context. The internal state is set to finished, and subsequent
         // calls to encode commands will generate errors.
         if (device->ConsumedError(mEncodingContext.Finish()) ||
-            device->ConsumedError(device->ValidateIsAlive()) ||
-            (device->IsValidationEnabled() &&
-             device->ConsumedError(ValidateFinish(mEncodingContext.GetIterator(),
-                                                  mEncodingContext.GetPassUsages())))) {
+            device->ConsumedError(device->ValidateIsAlive())) {
+            return CommandBufferBase::MakeError(device);
+        }
+        if (device->IsToggleEnabled(Toggle::ReorderRenderPassDraws)) {
+            // Rewrite the tape before validation so the reordered commands are what gets
+            // validated and replayed.
+            mEncodingContext.ReplaceCommands(ReorderRenderPassDraws(
+                mEncodingContext.AcquireCommands(), device->GetCommandBlockPool()));
+        }
+        if (device->IsValidationEnabled() &&
+            device->ConsumedError(ValidateFinish(mEncodingContext.GetIterator(),
+                                                 mEncodingContext.GetPassUsages()))) {
             return CommandBufferBase::MakeError(device);
         }
+        // Merging runs after validation so every pass is still validated with the state
+        // resets a pass boundary implies. The tape is only rewritten when a mergeable
+        // boundary actually exists.
+        if (!device->IsToggleEnabled(Toggle::DisableRenderPassMerging)) {
+            mEncodingContext.ReplaceCommands(
+                MergeCompatibleRenderPasses(mEncodingContext.AcquireCommands(),
+                                            device->GetCommandBlockPool(),
+                                            mEncodingContext.GetMutablePassUsages()));
+        }
         ASSERT(!IsError());
         return device->CreateCommandBuffer(this, descriptor);
     }
 
+    MaybeError CommandEncoder::WriteCommandStream(CommandStreamObjectTable* table,
+                                                  std::ostream& out) {
+        return SerializeCommandStream(mEncodingContext.GetIterator(), table, out);
+    }
+
     // Implementation of the command buffer validation that can be precomputed before submit
     MaybeError CommandEncoder::ValidateFinish(CommandIterator* commands,
                                               const PerPassUsages& perPassUsages) const {
@@ -1044,6 +1562,23 @@ namespace dawn_native {
                         ValidateRayTracingAccelerationContainerCanBuild(build->container.Get()));
                 } break;
 
+                case Command::BuildRayTracingAccelerationContainers: {
+                    const BuildRayTracingAccelerationContainersCmd* build =
+                        commands->NextCommand<BuildRayTracingAccelerationContainersCmd>();
+                    auto containers =
+                        commands->NextData<Ref<RayTracingAccelerationContainerBase>>(build->count);
+
+                    for (uint32_t i = 0; i < build->count; ++i) {
+                        DAWN_TRY(
+                            ValidateRayTracingAccelerationContainerCanBuild(containers[i].Get()));
+                        if (containers[i]->GetLevel() != containers[0]->GetLevel()) {
+                            return DAWN_VALIDATION_ERROR(
+                                "Acceleration containers of different levels must be built in "
+                                "separate batches");
+                        }
+                    }
+                } break;
+
                 case Command::UpdateRayTracingAccelerationContainer: {
                     const UpdateRayTracingAccelerationContainerCmd* build =
                         commands->NextCommand<UpdateRayTracingAccelerationContainerCmd>();
@@ -1052,6 +1587,14 @@ namespace dawn_native {
                         ValidateRayTracingAccelerationContainerCanUpdate(build->container.Get()));
                 } break;
 
+                case Command::CompactRayTracingAccelerationContainer: {
+                    const CompactRayTracingAccelerationContainerCmd* compact =
+                        commands->NextCommand<CompactRayTracingAccelerationContainerCmd>();
+
+                    DAWN_TRY(ValidateRayTracingAccelerationContainerCanCompact(
+                        compact->srcContainer.Get(), compact->dstContainer.Get()));
+                } break;
+
                 case Command::CopyRayTracingAccelerationContainer: {
                     const CopyRayTracingAccelerationContainerCmd* copy =
                         commands->NextCommand<CopyRayTracingAccelerationContainerCmd>();
@@ -1060,11 +1603,57 @@ namespace dawn_native {
                         copy->srcContainer.Get(), copy->dstContainer.Get()));
                 } break;
 
+                case Command::WriteRayTracingAccelerationContainerCompactedSize: {
+                    const WriteRayTracingAccelerationContainerCompactedSizeCmd* write =
+                        commands
+                            ->NextCommand<WriteRayTracingAccelerationContainerCompactedSizeCmd>();
+
+                    DAWN_TRY(ValidateRayTracingAccelerationContainerCanWriteCompactedSize(
+                        write->container.Get()));
+                } break;
+
+                case Command::WriteRayTracingAccelerationContainerSerializationSize: {
+                    const WriteRayTracingAccelerationContainerSerializationSizeCmd* write =
+                        commands
+                            ->NextCommand<WriteRayTracingAccelerationContainerSerializationSizeCmd>();
+
+                    DAWN_TRY(ValidateRayTracingAccelerationContainerCanWriteSerializationSize(
+                        write->container.Get()));
+                } break;
+
+                case Command::SerializeRayTracingAccelerationContainer: {
+                    const SerializeRayTracingAccelerationContainerCmd* serialize =
+                        commands->NextCommand<SerializeRayTracingAccelerationContainerCmd>();
+
+                    DAWN_TRY(ValidateRayTracingAccelerationContainerCanSerialize(
+                        serialize->container.Get()));
+                } break;
+
+                case Command::DeserializeRayTracingAccelerationContainer: {
+                    const DeserializeRayTracingAccelerationContainerCmd* deserialize =
+                        commands->NextCommand<DeserializeRayTracingAccelerationContainerCmd>();
+
+                    DAWN_TRY(ValidateRayTracingAccelerationContainerCanDeserialize(
+                        deserialize->container.Get()));
+                } break;
+
                 case Command::CopyBufferToBuffer: {
                     commands->NextCommand<CopyBufferToBufferCmd>();
                     break;
                 }
 
+                case Command::CopyBufferToBufferBatch: {
+                    const CopyBufferToBufferBatchCmd* copy =
+                        commands->NextCommand<CopyBufferToBufferBatchCmd>();
+                    commands->NextData<BufferCopyRegion>(copy->regionCount);
+                    break;
+                }
+
+                case Command::CopyBufferToRayTracingInstances: {
+                    commands->NextCommand<CopyBufferToRayTracingInstancesCmd>();
+                    break;
+                }
+
                 case Command::CopyBufferToTexture: {
                     commands->NextCommand<CopyBufferToTextureCmd>();
                     break;
@@ -1099,6 +1688,17 @@ namespace dawn_native {
                     debugGroupStackSize++;
                     break;
                 }
+
+                case Command::ResolveQuerySet: {
+                    commands->NextCommand<ResolveQuerySetCmd>();
+                    break;
+                }
+
+                case Command::WriteTimestamp: {
+                    commands->NextCommand<WriteTimestampCmd>();
+                    break;
+                }
+
                 default:
                     return DAWN_VALIDATION_ERROR("Command disallowed outside of a pass");
             }
@@ -22,12 +22,15 @@
 #include "dawn_native/ObjectBase.h"
 #include "dawn_native/PassResourceUsage.h"
 
+#include <ostream>
 #include <string>
 
 namespace dawn_native {
 
     struct BeginRenderPassCmd;
 
+    class CommandStreamObjectTable;
+
     class CommandEncoder final : public ObjectBase {
       public:
         CommandEncoder(DeviceBase* device, const CommandEncoderDescriptor* descriptor);
@@ -42,9 +45,37 @@ namespace dawn_native {
 
         void BuildRayTracingAccelerationContainer(RayTracingAccelerationContainerBase* container);
 
+        void BuildRayTracingAccelerationContainers(
+            uint32_t containerCount,
+            RayTracingAccelerationContainerBase* const* containers);
+
+        void CompactRayTracingAccelerationContainer(
+            RayTracingAccelerationContainerBase* srcContainer,
+            RayTracingAccelerationContainerBase* dstContainer);
+
         void CopyRayTracingAccelerationContainer(RayTracingAccelerationContainerBase* srcContainer,
                                                  RayTracingAccelerationContainerBase* dstContainer);
 
+        void WriteRayTracingAccelerationContainerCompactedSize(
+            RayTracingAccelerationContainerBase* container,
+            BufferBase* destination,
+            uint64_t destinationOffset);
+
+        void WriteRayTracingAccelerationContainerSerializationSize(
+            RayTracingAccelerationContainerBase* container,
+            BufferBase* destination,
+            uint64_t destinationOffset);
+
+        void SerializeRayTracingAccelerationContainer(
+            RayTracingAccelerationContainerBase* container,
+            BufferBase* destination,
+            uint64_t destinationOffset);
+
+        void DeserializeRayTracingAccelerationContainer(
+            RayTracingAccelerationContainerBase* container,
+            BufferBase* source,
+            uint64_t sourceOffset);
+
         void UpdateRayTracingAccelerationContainer(RayTracingAccelerationContainerBase* container);
 
         void CopyBufferToBuffer(BufferBase* source,
@@ -52,6 +83,15 @@ namespace dawn_native {
                                 BufferBase* destination,
                                 uint64_t destinationOffset,
                                 uint64_t size);
+        void CopyBufferToBufferBatch(BufferBase* source,
+                                     BufferBase* destination,
+                                     uint32_t regionCount,
+                                     const BufferCopyRegion* regions);
+        void CopyBufferToRayTracingInstances(BufferBase* source,
+                                             uint64_t sourceOffset,
+                                             RayTracingAccelerationContainerBase* container,
+                                             uint32_t firstInstance,
+                                             uint32_t instanceCount);
         void CopyBufferToTexture(const BufferCopyView* source,
                                  const TextureCopyView* destination,
                                  const Extent3D* copySize);
@@ -66,13 +106,31 @@ namespace dawn_native {
         void PopDebugGroup();
         void PushDebugGroup(const char* groupLabel);
 
+        void ResolveQuerySet(QuerySetBase* querySet,
+                             uint32_t firstQuery,
+                             uint32_t queryCount,
+                             BufferBase* destination,
+                             uint64_t destinationOffset);
+        void WriteTimestamp(QuerySetBase* querySet, uint32_t queryIndex);
+
         CommandBufferBase* Finish(const CommandBufferDescriptor* descriptor);
 
+        // Serializes the recorded commands to |out| in the binary format understood by
+        // ReplayCommandStream, registering referenced objects in |table|. Must be called
+        // after all passes have ended; the commands are left in place so Finish() can
+        // still be called afterwards.
+        MaybeError WriteCommandStream(CommandStreamObjectTable* table, std::ostream& out);
+
+        // True when the encoder was created with the reusable flag, in which case the
+        // command buffer produced by Finish() may be submitted more than once.
+        bool IsReusable() const;
+
       private:
         MaybeError ValidateFinish(CommandIterator* commands,
                                   const PerPassUsages& perPassUsages) const;
 
         EncodingContext mEncodingContext;
+        bool mReusable = false;
         std::set<BufferBase*> mTopLevelBuffers;
         std::set<TextureBase*> mTopLevelTextures;
         std::set<RayTracingAccelerationContainerBase*> mTopLevelAccelerationContainers;
@@ -0,0 +1,841 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/CommandStream.h"
+
+#include "common/Assert.h"
+#include "common/BitSetIterator.h"
+#include "common/Constants.h"
+#include "dawn_native/BindGroup.h"
+#include "dawn_native/Buffer.h"
+#include "dawn_native/CommandEncoder.h"
+#include "dawn_native/Commands.h"
+#include "dawn_native/ComputePassEncoder.h"
+#include "dawn_native/ComputePipeline.h"
+#include "dawn_native/ProgrammablePassEncoder.h"
+#include "dawn_native/RenderPassEncoder.h"
+#include "dawn_native/RenderPipeline.h"
+
+#include <array>
+#include <type_traits>
+
+namespace dawn_native {
+
+    namespace {
+
+        // Bump kCommandStreamVersion whenever the encoding of any command changes so that
+        // stale streams are rejected instead of misinterpreted.
+        constexpr uint32_t kCommandStreamMagic = 0x4D434E44;  // "DNCM" in little-endian
+        // Version 2: DispatchBatch was inserted into the Command enum, renumbering the
+        // command ids of everything after it.
+        // Version 3: CopyBufferToBufferBatch was inserted into the Command enum,
+        // renumbering the command ids of everything after it.
+        // Version 4: the acceleration container serialization commands were inserted
+        // into the Command enum, renumbering the command ids of everything after them.
+        constexpr uint32_t kCommandStreamVersion = 4;
+        constexpr uint32_t kEndOfStream = 0xFFFFFFFF;
+        constexpr uint32_t kInvalidObjectIndex = 0xFFFFFFFF;
+
+        template <typename T>
+        void WriteValue(std::ostream* out, const T& value) {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "Serialized values must be trivially copyable");
+            out->write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        MaybeError ReadValue(std::istream* in, T* value) {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "Serialized values must be trivially copyable");
+            in->read(reinterpret_cast<char*>(value), sizeof(T));
+            if (!(*in)) {
+                return DAWN_VALIDATION_ERROR("Unexpected end of command stream");
+            }
+            return {};
+        }
+
+        void WriteCommandId(std::ostream* out, Command commandId) {
+            WriteValue(out, static_cast<uint32_t>(commandId));
+        }
+
+        MaybeError SerializeCommands(CommandIterator* commands,
+                                     CommandStreamObjectTable* table,
+                                     std::ostream* out) {
+            Command type;
+            while (commands->NextCommandId(&type)) {
+                switch (type) {
+                    case Command::BeginComputePass: {
+                        commands->NextCommand<BeginComputePassCmd>();
+                        WriteCommandId(out, type);
+                        break;
+                    }
+
+                    case Command::BeginRenderPass: {
+                        BeginRenderPassCmd* cmd = commands->NextCommand<BeginRenderPassCmd>();
+                        WriteCommandId(out, type);
+
+                        const std::bitset<kMaxColorAttachments> attachmentsMask =
+                            cmd->attachmentState->GetColorAttachmentsMask();
+                        WriteValue(out, static_cast<uint32_t>(attachmentsMask.count()));
+                        for (uint32_t i : IterateBitSet(attachmentsMask)) {
+                            const RenderPassColorAttachmentInfo& attachment =
+                                cmd->colorAttachments[i];
+                            WriteValue(out, table->AddTextureView(attachment.view.Get()));
+                            WriteValue(out, attachment.resolveTarget.Get() != nullptr
+                                                ? table->AddTextureView(
+                                                      attachment.resolveTarget.Get())
+                                                : kInvalidObjectIndex);
+                            WriteValue(out, attachment.loadOp);
+                            WriteValue(out, attachment.storeOp);
+                            WriteValue(out, attachment.clearColor);
+                        }
+
+                        const uint32_t hasDepthStencil =
+                            cmd->attachmentState->HasDepthStencilAttachment() ? 1 : 0;
+                        WriteValue(out, hasDepthStencil);
+                        if (hasDepthStencil != 0) {
+                            const RenderPassDepthStencilAttachmentInfo& attachment =
+                                cmd->depthStencilAttachment;
+                            WriteValue(out, table->AddTextureView(attachment.view.Get()));
+                            WriteValue(out, attachment.depthLoadOp);
+                            WriteValue(out, attachment.depthStoreOp);
+                            WriteValue(out, attachment.clearDepth);
+                            WriteValue(out, attachment.stencilLoadOp);
+                            WriteValue(out, attachment.stencilStoreOp);
+                            WriteValue(out, attachment.clearStencil);
+                        }
+                        break;
+                    }
+
+                    case Command::CopyBufferToBuffer: {
+                        CopyBufferToBufferCmd* cmd =
+                            commands->NextCommand<CopyBufferToBufferCmd>();
+                        WriteCommandId(out, type);
+                        WriteValue(out, table->AddBuffer(cmd->source.Get()));
+                        WriteValue(out, cmd->sourceOffset);
+                        WriteValue(out, table->AddBuffer(cmd->destination.Get()));
+                        WriteValue(out, cmd->destinationOffset);
+                        WriteValue(out, cmd->size);
+                        break;
+                    }
+
+                    case Command::CopyBufferToBufferBatch: {
+                        CopyBufferToBufferBatchCmd* cmd =
+                            commands->NextCommand<CopyBufferToBufferBatchCmd>();
+                        const BufferCopyRegion* regions =
+                            commands->NextData<BufferCopyRegion>(cmd->regionCount);
+                        WriteCommandId(out, type);
+                        WriteValue(out, table->AddBuffer(cmd->source.Get()));
+                        WriteValue(out, table->AddBuffer(cmd->destination.Get()));
+                        WriteValue(out, cmd->regionCount);
+                        for (uint32_t i = 0; i < cmd->regionCount; ++i) {
+                            WriteValue(out, regions[i]);
+                        }
+                        break;
+                    }
+
+                    case Command::Dispatch: {
+                        DispatchCmd* cmd = commands->NextCommand<DispatchCmd>();
+                        WriteCommandId(out, type);
+                        WriteValue(out, *cmd);
+                        break;
+                    }
+
+                    case Command::DispatchBatch: {
+                        DispatchBatchCmd* cmd = commands->NextCommand<DispatchBatchCmd>();
+                        DispatchBatchEntry* entries =
+                            commands->NextData<DispatchBatchEntry>(cmd->entryCount);
+                        WriteCommandId(out, type);
+                        WriteValue(out, cmd->groupIndex);
+                        WriteValue(out, table->AddBindGroup(cmd->group.Get()));
+                        WriteValue(out, cmd->entryCount);
+                        for (uint32_t i = 0; i < cmd->entryCount; ++i) {
+                            WriteValue(out, entries[i]);
+                        }
+                        break;
+                    }
+
+                    case Command::DispatchIndirect: {
+                        DispatchIndirectCmd* cmd = commands->NextCommand<DispatchIndirectCmd>();
+                        WriteCommandId(out, type);
+                        WriteValue(out, table->AddBuffer(cmd->indirectBuffer.Get()));
+                        WriteValue(out, cmd->indirectOffset);
+                        break;
+                    }
+
+                    case Command::Draw: {
+                        DrawCmd* cmd = commands->NextCommand<DrawCmd>();
+                        WriteCommandId(out, type);
+                        WriteValue(out, *cmd);
+                        break;
+                    }
+
+                    case Command::DrawIndexed: {
+                        DrawIndexedCmd* cmd = commands->NextCommand<DrawIndexedCmd>();
+                        WriteCommandId(out, type);
+                        WriteValue(out, *cmd);
+                        break;
+                    }
+
+                    case Command::DrawIndirect: {
+                        DrawIndirectCmd* cmd = commands->NextCommand<DrawIndirectCmd>();
+                        WriteCommandId(out, type);
+                        WriteValue(out, table->AddBuffer(cmd->indirectBuffer.Get()));
+                        WriteValue(out, cmd->indirectOffset);
+                        break;
+                    }
+
+                    case Command::DrawIndexedIndirect: {
+                        DrawIndexedIndirectCmd* cmd =
+                            commands->NextCommand<DrawIndexedIndirectCmd>();
+                        WriteCommandId(out, type);
+                        WriteValue(out, table->AddBuffer(cmd->indirectBuffer.Get()));
+                        WriteValue(out, cmd->indirectOffset);
+                        break;
+                    }
+
+                    case Command::MultiDrawIndexedIndirect: {
+                        MultiDrawIndexedIndirectCmd* cmd =
+                            commands->NextCommand<MultiDrawIndexedIndirectCmd>();
+                        WriteCommandId(out, type);
+                        WriteValue(out, table->AddBuffer(cmd->indirectBuffer.Get()));
+                        WriteValue(out, cmd->indirectOffset);
+                        WriteValue(out, cmd->maxDrawCount);
+                        WriteValue(out, cmd->countBuffer != nullptr
+                                            ? table->AddBuffer(cmd->countBuffer.Get())
+                                            : kInvalidObjectIndex);
+                        WriteValue(out, cmd->countBufferOffset);
+                        break;
+                    }
+
+                    case Command::EndComputePass: {
+                        commands->NextCommand<EndComputePassCmd>();
+                        WriteCommandId(out, type);
+                        break;
+                    }
+
+                    case Command::EndRenderPass: {
+                        commands->NextCommand<EndRenderPassCmd>();
+                        WriteCommandId(out, type);
+                        break;
+                    }
+
+                    case Command::SetComputePipeline: {
+                        SetComputePipelineCmd* cmd =
+                            commands->NextCommand<SetComputePipelineCmd>();
+                        WriteCommandId(out, type);
+                        WriteValue(out, table->AddComputePipeline(cmd->pipeline.Get()));
+                        break;
+                    }
+
+                    case Command::SetRenderPipeline: {
+                        SetRenderPipelineCmd* cmd = commands->NextCommand<SetRenderPipelineCmd>();
+                        WriteCommandId(out, type);
+                        WriteValue(out, table->AddRenderPipeline(cmd->pipeline.Get()));
+                        break;
+                    }
+
+                    case Command::SetStencilReference: {
+                        SetStencilReferenceCmd* cmd =
+                            commands->NextCommand<SetStencilReferenceCmd>();
+                        WriteCommandId(out, type);
+                        WriteValue(out, *cmd);
+                        break;
+                    }
+
+                    case Command::SetViewport: {
+                        SetViewportCmd* cmd = commands->NextCommand<SetViewportCmd>();
+                        WriteCommandId(out, type);
+                        WriteValue(out, *cmd);
+                        break;
+                    }
+
+                    case Command::SetScissorRect: {
+                        SetScissorRectCmd* cmd = commands->NextCommand<SetScissorRectCmd>();
+                        WriteCommandId(out, type);
+                        WriteValue(out, *cmd);
+                        break;
+                    }
+
+                    case Command::SetBlendColor: {
+                        SetBlendColorCmd* cmd = commands->NextCommand<SetBlendColorCmd>();
+                        WriteCommandId(out, type);
+                        WriteValue(out, cmd->color);
+                        break;
+                    }
+
+                    case Command::SetBindGroup: {
+                        SetBindGroupCmd* cmd = commands->NextCommand<SetBindGroupCmd>();
+                        uint32_t* dynamicOffsets = nullptr;
+                        if (cmd->dynamicOffsetCount > 0) {
+                            dynamicOffsets = commands->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                        }
+                        WriteCommandId(out, type);
+                        WriteValue(out, cmd->index);
+                        WriteValue(out, table->AddBindGroup(cmd->group.Get()));
+                        WriteValue(out, cmd->dynamicOffsetCount);
+                        for (uint32_t i = 0; i < cmd->dynamicOffsetCount; ++i) {
+                            WriteValue(out, dynamicOffsets[i]);
+                        }
+                        break;
+                    }
+
+                    case Command::SetIndexBuffer: {
+                        SetIndexBufferCmd* cmd = commands->NextCommand<SetIndexBufferCmd>();
+                        WriteCommandId(out, type);
+                        WriteValue(out, table->AddBuffer(cmd->buffer.Get()));
+                        WriteValue(out, cmd->offset);
+                        WriteValue(out, cmd->size);
+                        break;
+                    }
+
+                    case Command::SetVertexBuffer: {
+                        SetVertexBufferCmd* cmd = commands->NextCommand<SetVertexBufferCmd>();
+                        WriteCommandId(out, type);
+                        WriteValue(out, cmd->slot);
+                        WriteValue(out, table->AddBuffer(cmd->buffer.Get()));
+                        WriteValue(out, cmd->offset);
+                        WriteValue(out, cmd->size);
+                        break;
+                    }
+
+                    default:
+                        return DAWN_VALIDATION_ERROR(
+                            "Command cannot be serialized to a command stream");
+                }
+            }
+
+            WriteValue(out, kEndOfStream);
+            return {};
+        }
+
+    }  // anonymous namespace
+
+    // CommandStreamObjectTable
+
+    template <typename T>
+    uint32_t CommandStreamObjectTable::AddObject(ObjectList<T>* list, T* object) {
+        const auto& iter = list->indices.find(object);
+        if (iter != list->indices.end()) {
+            return iter->second;
+        }
+
+        const uint32_t index = static_cast<uint32_t>(list->objects.size());
+        list->objects.emplace_back(object);
+        list->indices[object] = index;
+        return index;
+    }
+
+    template <typename T>
+    ResultOrError<T*> CommandStreamObjectTable::GetObject(const ObjectList<T>& list,
+                                                          uint32_t index) {
+        if (index >= list.objects.size()) {
+            return DAWN_VALIDATION_ERROR("Object index out of bounds in command stream");
+        }
+        return list.objects[index].Get();
+    }
+
+    uint32_t CommandStreamObjectTable::AddBuffer(BufferBase* buffer) {
+        return AddObject(&mBuffers, buffer);
+    }
+
+    uint32_t CommandStreamObjectTable::AddTextureView(TextureViewBase* view) {
+        return AddObject(&mTextureViews, view);
+    }
+
+    uint32_t CommandStreamObjectTable::AddBindGroup(BindGroupBase* group) {
+        return AddObject(&mBindGroups, group);
+    }
+
+    uint32_t CommandStreamObjectTable::AddComputePipeline(ComputePipelineBase* pipeline) {
+        return AddObject(&mComputePipelines, pipeline);
+    }
+
+    uint32_t CommandStreamObjectTable::AddRenderPipeline(RenderPipelineBase* pipeline) {
+        return AddObject(&mRenderPipelines, pipeline);
+    }
+
+    ResultOrError<BufferBase*> CommandStreamObjectTable::GetBuffer(uint32_t index) const {
+        return GetObject(mBuffers, index);
+    }
+
+    ResultOrError<TextureViewBase*> CommandStreamObjectTable::GetTextureView(
+        uint32_t index) const {
+        return GetObject(mTextureViews, index);
+    }
+
+    ResultOrError<BindGroupBase*> CommandStreamObjectTable::GetBindGroup(uint32_t index) const {
+        return GetObject(mBindGroups, index);
+    }
+
+    ResultOrError<ComputePipelineBase*> CommandStreamObjectTable::GetComputePipeline(
+        uint32_t index) const {
+        return GetObject(mComputePipelines, index);
+    }
+
+    ResultOrError<RenderPipelineBase*> CommandStreamObjectTable::GetRenderPipeline(
+        uint32_t index) const {
+        return GetObject(mRenderPipelines, index);
+    }
+
+    // Serialization
+
+    MaybeError SerializeCommandStream(CommandIterator* commands,
+                                      CommandStreamObjectTable* table,
+                                      std::ostream& out) {
+        WriteValue(&out, kCommandStreamMagic);
+        WriteValue(&out, kCommandStreamVersion);
+
+        MaybeError result = SerializeCommands(commands, table, &out);
+
+        // Leave the commands in place so that Finish() can still hand them to a backend
+        // command buffer, whether or not serialization succeeded.
+        commands->Reset();
+        return result;
+    }
+
+    // Replay
+
+    MaybeError ReplayCommandStream(const CommandStreamObjectTable& table,
+                                   std::istream& in,
+                                   CommandEncoder* encoder) {
+        uint32_t magic;
+        DAWN_TRY(ReadValue(&in, &magic));
+        if (magic != kCommandStreamMagic) {
+            return DAWN_VALIDATION_ERROR("Invalid command stream header");
+        }
+
+        uint32_t version;
+        DAWN_TRY(ReadValue(&in, &version));
+        if (version != kCommandStreamVersion) {
+            return DAWN_VALIDATION_ERROR("Unsupported command stream version");
+        }
+
+        Ref<ComputePassEncoder> computePass;
+        Ref<RenderPassEncoder> renderPass;
+
+        uint32_t commandId;
+        DAWN_TRY(ReadValue(&in, &commandId));
+        while (commandId != kEndOfStream) {
+            switch (static_cast<Command>(commandId)) {
+                case Command::BeginComputePass: {
+                    if (computePass != nullptr || renderPass != nullptr) {
+                        return DAWN_VALIDATION_ERROR("Command stream began a pass inside a pass");
+                    }
+                    ComputePassDescriptor descriptor = {};
+                    computePass = AcquireRef(encoder->BeginComputePass(&descriptor));
+                    break;
+                }
+
+                case Command::BeginRenderPass: {
+                    if (computePass != nullptr || renderPass != nullptr) {
+                        return DAWN_VALIDATION_ERROR("Command stream began a pass inside a pass");
+                    }
+
+                    uint32_t colorAttachmentCount;
+                    DAWN_TRY(ReadValue(&in, &colorAttachmentCount));
+                    if (colorAttachmentCount > kMaxColorAttachments) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Color attachment count out of bounds in command stream");
+                    }
+
+                    std::array<RenderPassColorAttachmentDescriptor, kMaxColorAttachments>
+                        colorAttachments = {};
+                    for (uint32_t i = 0; i < colorAttachmentCount; ++i) {
+                        uint32_t viewIndex;
+                        uint32_t resolveTargetIndex;
+                        DAWN_TRY(ReadValue(&in, &viewIndex));
+                        DAWN_TRY(ReadValue(&in, &resolveTargetIndex));
+                        DAWN_TRY_ASSIGN(colorAttachments[i].attachment,
+                                        table.GetTextureView(viewIndex));
+                        if (resolveTargetIndex != kInvalidObjectIndex) {
+                            DAWN_TRY_ASSIGN(colorAttachments[i].resolveTarget,
+                                            table.GetTextureView(resolveTargetIndex));
+                        }
+                        DAWN_TRY(ReadValue(&in, &colorAttachments[i].loadOp));
+                        DAWN_TRY(ReadValue(&in, &colorAttachments[i].storeOp));
+                        DAWN_TRY(ReadValue(&in, &colorAttachments[i].clearColor));
+                    }
+
+                    uint32_t hasDepthStencil;
+                    DAWN_TRY(ReadValue(&in, &hasDepthStencil));
+                    RenderPassDepthStencilAttachmentDescriptor depthStencilAttachment = {};
+                    if (hasDepthStencil != 0) {
+                        uint32_t viewIndex;
+                        DAWN_TRY(ReadValue(&in, &viewIndex));
+                        DAWN_TRY_ASSIGN(depthStencilAttachment.attachment,
+                                        table.GetTextureView(viewIndex));
+                        DAWN_TRY(ReadValue(&in, &depthStencilAttachment.depthLoadOp));
+                        DAWN_TRY(ReadValue(&in, &depthStencilAttachment.depthStoreOp));
+                        DAWN_TRY(ReadValue(&in, &depthStencilAttachment.clearDepth));
+                        DAWN_TRY(ReadValue(&in, &depthStencilAttachment.stencilLoadOp));
+                        DAWN_TRY(ReadValue(&in, &depthStencilAttachment.stencilStoreOp));
+                        DAWN_TRY(ReadValue(&in, &depthStencilAttachment.clearStencil));
+                    }
+
+                    RenderPassDescriptor descriptor = {};
+                    descriptor.colorAttachmentCount = colorAttachmentCount;
+                    descriptor.colorAttachments = colorAttachments.data();
+                    descriptor.depthStencilAttachment =
+                        hasDepthStencil != 0 ? &depthStencilAttachment : nullptr;
+
+                    renderPass = AcquireRef(encoder->BeginRenderPass(&descriptor));
+                    break;
+                }
+
+                case Command::CopyBufferToBuffer: {
+                    if (computePass != nullptr || renderPass != nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Command stream copied buffers inside a pass");
+                    }
+                    uint32_t sourceIndex;
+                    uint64_t sourceOffset;
+                    uint32_t destinationIndex;
+                    uint64_t destinationOffset;
+                    uint64_t size;
+                    DAWN_TRY(ReadValue(&in, &sourceIndex));
+                    DAWN_TRY(ReadValue(&in, &sourceOffset));
+                    DAWN_TRY(ReadValue(&in, &destinationIndex));
+                    DAWN_TRY(ReadValue(&in, &destinationOffset));
+                    DAWN_TRY(ReadValue(&in, &size));
+
+                    BufferBase* source;
+                    BufferBase* destination;
+                    DAWN_TRY_ASSIGN(source, table.GetBuffer(sourceIndex));
+                    DAWN_TRY_ASSIGN(destination, table.GetBuffer(destinationIndex));
+                    encoder->CopyBufferToBuffer(source, sourceOffset, destination,
+                                                destinationOffset, size);
+                    break;
+                }
+
+                case Command::CopyBufferToBufferBatch: {
+                    if (computePass != nullptr || renderPass != nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Command stream copied buffers inside a pass");
+                    }
+                    uint32_t sourceIndex;
+                    uint32_t destinationIndex;
+                    uint32_t regionCount;
+                    DAWN_TRY(ReadValue(&in, &sourceIndex));
+                    DAWN_TRY(ReadValue(&in, &destinationIndex));
+                    DAWN_TRY(ReadValue(&in, &regionCount));
+
+                    std::vector<BufferCopyRegion> regions(regionCount);
+                    for (uint32_t i = 0; i < regionCount; ++i) {
+                        DAWN_TRY(ReadValue(&in, &regions[i]));
+                    }
+
+                    BufferBase* source;
+                    BufferBase* destination;
+                    DAWN_TRY_ASSIGN(source, table.GetBuffer(sourceIndex));
+                    DAWN_TRY_ASSIGN(destination, table.GetBuffer(destinationIndex));
+                    encoder->CopyBufferToBufferBatch(source, destination, regionCount,
+                                                     regions.data());
+                    break;
+                }
+
+                case Command::Dispatch: {
+                    if (computePass == nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Command stream dispatched outside a compute pass");
+                    }
+                    DispatchCmd dispatch;
+                    DAWN_TRY(ReadValue(&in, &dispatch));
+                    computePass->Dispatch(dispatch.x, dispatch.y, dispatch.z);
+                    break;
+                }
+
+                case Command::DispatchBatch: {
+                    if (computePass == nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Command stream dispatched outside a compute pass");
+                    }
+                    uint32_t groupIndex;
+                    uint32_t bindGroupIndex;
+                    uint32_t entryCount;
+                    DAWN_TRY(ReadValue(&in, &groupIndex));
+                    DAWN_TRY(ReadValue(&in, &bindGroupIndex));
+                    DAWN_TRY(ReadValue(&in, &entryCount));
+
+                    std::vector<DispatchBatchEntry> entries(entryCount);
+                    for (uint32_t i = 0; i < entryCount; ++i) {
+                        DAWN_TRY(ReadValue(&in, &entries[i]));
+                    }
+
+                    BindGroupBase* group;
+                    DAWN_TRY_ASSIGN(group, table.GetBindGroup(bindGroupIndex));
+                    computePass->DispatchBatch(groupIndex, group, entryCount, entries.data());
+                    break;
+                }
+
+                case Command::DispatchIndirect: {
+                    if (computePass == nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Command stream dispatched outside a compute pass");
+                    }
+                    uint32_t bufferIndex;
+                    uint64_t indirectOffset;
+                    DAWN_TRY(ReadValue(&in, &bufferIndex));
+                    DAWN_TRY(ReadValue(&in, &indirectOffset));
+
+                    BufferBase* indirectBuffer;
+                    DAWN_TRY_ASSIGN(indirectBuffer, table.GetBuffer(bufferIndex));
+                    computePass->DispatchIndirect(indirectBuffer, indirectOffset);
+                    break;
+                }
+
+                case Command::Draw: {
+                    if (renderPass == nullptr) {
+                        return DAWN_VALIDATION_ERROR("Command stream drew outside a render pass");
+                    }
+                    DrawCmd draw;
+                    DAWN_TRY(ReadValue(&in, &draw));
+                    renderPass->Draw(draw.vertexCount, draw.instanceCount, draw.firstVertex,
+                                     draw.firstInstance);
+                    break;
+                }
+
+                case Command::DrawIndexed: {
+                    if (renderPass == nullptr) {
+                        return DAWN_VALIDATION_ERROR("Command stream drew outside a render pass");
+                    }
+                    DrawIndexedCmd draw;
+                    DAWN_TRY(ReadValue(&in, &draw));
+                    renderPass->DrawIndexed(draw.indexCount, draw.instanceCount, draw.firstIndex,
+                                            draw.baseVertex, draw.firstInstance);
+                    break;
+                }
+
+                case Command::DrawIndirect:
+                case Command::DrawIndexedIndirect: {
+                    if (renderPass == nullptr) {
+                        return DAWN_VALIDATION_ERROR("Command stream drew outside a render pass");
+                    }
+                    uint32_t bufferIndex;
+                    uint64_t indirectOffset;
+                    DAWN_TRY(ReadValue(&in, &bufferIndex));
+                    DAWN_TRY(ReadValue(&in, &indirectOffset));
+
+                    BufferBase* indirectBuffer;
+                    DAWN_TRY_ASSIGN(indirectBuffer, table.GetBuffer(bufferIndex));
+                    if (static_cast<Command>(commandId) == Command::DrawIndirect) {
+                        renderPass->DrawIndirect(indirectBuffer, indirectOffset);
+                    } else {
+                        renderPass->DrawIndexedIndirect(indirectBuffer, indirectOffset);
+                    }
+                    break;
+                }
+
+                case Command::MultiDrawIndexedIndirect: {
+                    if (renderPass == nullptr) {
+                        return DAWN_VALIDATION_ERROR("Command stream drew outside a render pass");
+                    }
+                    uint32_t bufferIndex;
+                    uint64_t indirectOffset;
+                    uint32_t maxDrawCount;
+                    uint32_t countBufferIndex;
+                    uint64_t countBufferOffset;
+                    DAWN_TRY(ReadValue(&in, &bufferIndex));
+                    DAWN_TRY(ReadValue(&in, &indirectOffset));
+                    DAWN_TRY(ReadValue(&in, &maxDrawCount));
+                    DAWN_TRY(ReadValue(&in, &countBufferIndex));
+                    DAWN_TRY(ReadValue(&in, &countBufferOffset));
+
+                    BufferBase* indirectBuffer;
+                    DAWN_TRY_ASSIGN(indirectBuffer, table.GetBuffer(bufferIndex));
+                    BufferBase* countBuffer = nullptr;
+                    if (countBufferIndex != kInvalidObjectIndex) {
+                        DAWN_TRY_ASSIGN(countBuffer, table.GetBuffer(countBufferIndex));
+                    }
+                    renderPass->MultiDrawIndexedIndirect(indirectBuffer, indirectOffset,
+                                                         maxDrawCount, countBuffer,
+                                                         countBufferOffset);
+                    break;
+                }
+
+                case Command::EndComputePass: {
+                    if (computePass == nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Command stream ended a compute pass that was not begun");
+                    }
+                    computePass->EndPass();
+                    computePass = nullptr;
+                    break;
+                }
+
+                case Command::EndRenderPass: {
+                    if (renderPass == nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Command stream ended a render pass that was not begun");
+                    }
+                    renderPass->EndPass();
+                    renderPass = nullptr;
+                    break;
+                }
+
+                case Command::SetComputePipeline: {
+                    if (computePass == nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Command stream set a compute pipeline outside a compute pass");
+                    }
+                    uint32_t pipelineIndex;
+                    DAWN_TRY(ReadValue(&in, &pipelineIndex));
+
+                    ComputePipelineBase* pipeline;
+                    DAWN_TRY_ASSIGN(pipeline, table.GetComputePipeline(pipelineIndex));
+                    computePass->SetPipeline(pipeline);
+                    break;
+                }
+
+                case Command::SetRenderPipeline: {
+                    if (renderPass == nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Command stream set a render pipeline outside a render pass");
+                    }
+                    uint32_t pipelineIndex;
+                    DAWN_TRY(ReadValue(&in, &pipelineIndex));
+
+                    RenderPipelineBase* pipeline;
+                    DAWN_TRY_ASSIGN(pipeline, table.GetRenderPipeline(pipelineIndex));
+                    renderPass->SetPipeline(pipeline);
+                    break;
+                }
+
+                case Command::SetStencilReference: {
+                    if (renderPass == nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Command stream set render state outside a render pass");
+                    }
+                    SetStencilReferenceCmd cmd;
+                    DAWN_TRY(ReadValue(&in, &cmd));
+                    renderPass->SetStencilReference(cmd.reference);
+                    break;
+                }
+
+                case Command::SetViewport: {
+                    if (renderPass == nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Command stream set render state outside a render pass");
+                    }
+                    SetViewportCmd cmd;
+                    DAWN_TRY(ReadValue(&in, &cmd));
+                    renderPass->SetViewport(cmd.x, cmd.y, cmd.width, cmd.height, cmd.minDepth,
+                                            cmd.maxDepth);
+                    break;
+                }
+
+                case Command::SetScissorRect: {
+                    if (renderPass == nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Command stream set render state outside a render pass");
+                    }
+                    SetScissorRectCmd cmd;
+                    DAWN_TRY(ReadValue(&in, &cmd));
+                    renderPass->SetScissorRect(cmd.x, cmd.y, cmd.width, cmd.height);
+                    break;
+                }
+
+                case Command::SetBlendColor: {
+                    if (renderPass == nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Command stream set render state outside a render pass");
+                    }
+                    Color color;
+                    DAWN_TRY(ReadValue(&in, &color));
+                    renderPass->SetBlendColor(&color);
+                    break;
+                }
+
+                case Command::SetBindGroup: {
+                    ProgrammablePassEncoder* pass =
+                        computePass != nullptr
+                            ? static_cast<ProgrammablePassEncoder*>(computePass.Get())
+                            : static_cast<ProgrammablePassEncoder*>(renderPass.Get());
+                    if (pass == nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Command stream set a bind group outside a pass");
+                    }
+
+                    uint32_t groupIndex;
+                    uint32_t bindGroupIndex;
+                    uint32_t dynamicOffsetCount;
+                    DAWN_TRY(ReadValue(&in, &groupIndex));
+                    DAWN_TRY(ReadValue(&in, &bindGroupIndex));
+                    DAWN_TRY(ReadValue(&in, &dynamicOffsetCount));
+
+                    std::vector<uint32_t> dynamicOffsets(dynamicOffsetCount);
+                    for (uint32_t i = 0; i < dynamicOffsetCount; ++i) {
+                        DAWN_TRY(ReadValue(&in, &dynamicOffsets[i]));
+                    }
+
+                    BindGroupBase* group;
+                    DAWN_TRY_ASSIGN(group, table.GetBindGroup(bindGroupIndex));
+                    pass->SetBindGroup(groupIndex, group, dynamicOffsetCount,
+                                       dynamicOffsets.data());
+                    break;
+                }
+
+                case Command::SetIndexBuffer: {
+                    if (renderPass == nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Command stream set an index buffer outside a render pass");
+                    }
+                    uint32_t bufferIndex;
+                    uint64_t offset;
+                    uint64_t size;
+                    DAWN_TRY(ReadValue(&in, &bufferIndex));
+                    DAWN_TRY(ReadValue(&in, &offset));
+                    DAWN_TRY(ReadValue(&in, &size));
+
+                    BufferBase* buffer;
+                    DAWN_TRY_ASSIGN(buffer, table.GetBuffer(bufferIndex));
+                    renderPass->SetIndexBuffer(buffer, offset, size);
+                    break;
+                }
+
+                case Command::SetVertexBuffer: {
+                    if (renderPass == nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Command stream set a vertex buffer outside a render pass");
+                    }
+                    uint32_t slot;
+                    uint32_t bufferIndex;
+                    uint64_t offset;
+                    uint64_t size;
+                    DAWN_TRY(ReadValue(&in, &slot));
+                    DAWN_TRY(ReadValue(&in, &bufferIndex));
+                    DAWN_TRY(ReadValue(&in, &offset));
+                    DAWN_TRY(ReadValue(&in, &size));
+
+                    BufferBase* buffer;
+                    DAWN_TRY_ASSIGN(buffer, table.GetBuffer(bufferIndex));
+                    renderPass->SetVertexBuffer(slot, buffer, offset, size);
+                    break;
+                }
+
+                default:
+                    return DAWN_VALIDATION_ERROR("Unknown command in command stream");
+            }
+
+            DAWN_TRY(ReadValue(&in, &commandId));
+        }
+
+        if (computePass != nullptr || renderPass != nullptr) {
+            return DAWN_VALIDATION_ERROR("Command stream ended inside a pass");
+        }
+
+        return {};
+    }
+
+}  // namespace dawn_native
@@ -0,0 +1,90 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_COMMANDSTREAM_H_
+#define DAWNNATIVE_COMMANDSTREAM_H_
+
+#include "common/RefCounted.h"
+#include "dawn_native/Error.h"
+#include "dawn_native/Forward.h"
+
+#include <istream>
+#include <map>
+#include <ostream>
+#include <vector>
+
+namespace dawn_native {
+
+    class CommandEncoder;
+    class CommandIterator;
+
+    // Assigns stable indices to the API objects a serialized command stream refers to.
+    // Commands in the CommandAllocator tape hold pointers to live objects, which cannot be
+    // persisted, so serialization replaces each object with its table index. The table
+    // itself is not written to disk: before replaying a stream the application must
+    // recreate the objects and register them with Add*() in the same order as when the
+    // stream was recorded.
+    class CommandStreamObjectTable {
+      public:
+        uint32_t AddBuffer(BufferBase* buffer);
+        uint32_t AddTextureView(TextureViewBase* view);
+        uint32_t AddBindGroup(BindGroupBase* group);
+        uint32_t AddComputePipeline(ComputePipelineBase* pipeline);
+        uint32_t AddRenderPipeline(RenderPipelineBase* pipeline);
+
+        ResultOrError<BufferBase*> GetBuffer(uint32_t index) const;
+        ResultOrError<TextureViewBase*> GetTextureView(uint32_t index) const;
+        ResultOrError<BindGroupBase*> GetBindGroup(uint32_t index) const;
+        ResultOrError<ComputePipelineBase*> GetComputePipeline(uint32_t index) const;
+        ResultOrError<RenderPipelineBase*> GetRenderPipeline(uint32_t index) const;
+
+      private:
+        template <typename T>
+        struct ObjectList {
+            std::vector<Ref<T>> objects;
+            std::map<T*, uint32_t> indices;
+        };
+
+        template <typename T>
+        static uint32_t AddObject(ObjectList<T>* list, T* object);
+        template <typename T>
+        static ResultOrError<T*> GetObject(const ObjectList<T>& list, uint32_t index);
+
+        ObjectList<BufferBase> mBuffers;
+        ObjectList<TextureViewBase> mTextureViews;
+        ObjectList<BindGroupBase> mBindGroups;
+        ObjectList<ComputePipelineBase> mComputePipelines;
+        ObjectList<RenderPipelineBase> mRenderPipelines;
+    };
+
+    // Writes the commands in |commands| to |out| as a versioned binary stream, registering
+    // referenced objects in |table|. The iterator is reset afterwards so the commands can
+    // still be acquired by a backend command buffer. Only pass, draw, dispatch, state and
+    // buffer-to-buffer copy commands can be serialized; any other command produces an
+    // error. Prefer CommandEncoder::WriteCommandStream over calling this directly.
+    MaybeError SerializeCommandStream(CommandIterator* commands,
+                                      CommandStreamObjectTable* table,
+                                      std::ostream& out);
+
+    // Reads a stream previously written by SerializeCommandStream and re-encodes it on
+    // |encoder|, resolving object indices through |table|. The stream was validated when it
+    // was recorded, so replaying on a device with the skip_validation toggle skips the
+    // per-command validation and only pays for encoding and resource usage tracking.
+    MaybeError ReplayCommandStream(const CommandStreamObjectTable& table,
+                                   std::istream& in,
+                                   CommandEncoder* encoder);
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_COMMANDSTREAM_H_
@@ -20,6 +20,7 @@
 #include "dawn_native/CommandBufferStateTracker.h"
 #include "dawn_native/Commands.h"
 #include "dawn_native/PassResourceUsage.h"
+#include "dawn_native/RayTracingBundle.h"
 #include "dawn_native/RenderBundle.h"
 #include "dawn_native/RenderPipeline.h"
 
@@ -58,6 +59,12 @@ namespace dawn_native {
                     break;
                 }
 
+                case Command::MultiDrawIndexedIndirect: {
+                    commands->NextCommand<MultiDrawIndexedIndirectCmd>();
+                    DAWN_TRY(commandBufferState->ValidateCanDrawIndexed());
+                    break;
+                }
+
                 case Command::InsertDebugMarker: {
                     InsertDebugMarkerCmd* cmd = commands->NextCommand<InsertDebugMarkerCmd>();
                     commands->NextData<char>(cmd->length + 1);
@@ -118,6 +125,69 @@ namespace dawn_native {
             return {};
         }
 
+        inline MaybeError ValidateRayTracingBundleCommand(
+            CommandIterator* commands,
+            Command type,
+            CommandBufferStateTracker* commandBufferState,
+            uint64_t* debugGroupStackSize,
+            const char* disallowedMessage) {
+            switch (type) {
+                case Command::TraceRays: {
+                    commands->NextCommand<TraceRaysCmd>();
+                    DAWN_TRY(commandBufferState->ValidateCanTraceRays());
+                    break;
+                }
+
+                case Command::TraceRaysIndirect: {
+                    commands->NextCommand<TraceRaysIndirectCmd>();
+                    DAWN_TRY(commandBufferState->ValidateCanTraceRays());
+                    break;
+                }
+
+                case Command::InsertDebugMarker: {
+                    InsertDebugMarkerCmd* cmd = commands->NextCommand<InsertDebugMarkerCmd>();
+                    commands->NextData<char>(cmd->length + 1);
+                    break;
+                }
+
+                case Command::PopDebugGroup: {
+                    commands->NextCommand<PopDebugGroupCmd>();
+                    DAWN_TRY(ValidateCanPopDebugGroup(*debugGroupStackSize));
+                    *debugGroupStackSize -= 1;
+                    break;
+                }
+
+                case Command::PushDebugGroup: {
+                    PushDebugGroupCmd* cmd = commands->NextCommand<PushDebugGroupCmd>();
+                    commands->NextData<char>(cmd->length + 1);
+                    *debugGroupStackSize += 1;
+                    break;
+                }
+
+                case Command::SetRayTracingPipeline: {
+                    SetRayTracingPipelineCmd* cmd =
+                        commands->NextCommand<SetRayTracingPipelineCmd>();
+                    commandBufferState->SetRayTracingPipeline(cmd->pipeline.Get());
+                    break;
+                }
+
+                case Command::SetBindGroup: {
+                    SetBindGroupCmd* cmd = commands->NextCommand<SetBindGroupCmd>();
+                    if (cmd->dynamicOffsetCount > 0) {
+                        commands->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                    }
+
+                    commandBufferState->SetBindGroup(cmd->index, cmd->group.Get());
+                    break;
+                }
+
+                default:
+                    return DAWN_VALIDATION_ERROR(disallowedMessage);
+            }
+
+            return {};
+        }
+
     }  // namespace
 
     MaybeError ValidateCanPopDebugGroup(uint64_t debugGroupStackSize) {
@@ -150,6 +220,21 @@ namespace dawn_native {
         return {};
     }
 
+    MaybeError ValidateRayTracingBundle(CommandIterator* commands) {
+        CommandBufferStateTracker commandBufferState;
+        uint64_t debugGroupStackSize = 0;
+
+        Command type;
+        while (commands->NextCommandId(&type)) {
+            DAWN_TRY(ValidateRayTracingBundleCommand(
+                commands, type, &commandBufferState, &debugGroupStackSize,
+                "Command disallowed inside a ray tracing bundle"));
+        }
+
+        DAWN_TRY(ValidateFinalDebugGroupStackSize(debugGroupStackSize));
+        return {};
+    }
+
     MaybeError ValidateRenderPass(CommandIterator* commands, const BeginRenderPassCmd* renderPass) {
         CommandBufferStateTracker commandBufferState;
         uint64_t debugGroupStackSize = 0;
@@ -167,6 +252,10 @@ namespace dawn_native {
                     ExecuteBundlesCmd* cmd = commands->NextCommand<ExecuteBundlesCmd>();
                     auto bundles = commands->NextData<Ref<RenderBundleBase>>(cmd->count);
                     for (uint32_t i = 0; i < cmd->count; ++i) {
+                        // AttachmentStates are deduplicated on the device, so the
+                        // bundle/pass compatibility verdict is this single pointer
+                        // comparison; the bundle's contents were validated against its
+                        // attachment state when the bundle was finished.
                         if (DAWN_UNLIKELY(renderPass->attachmentState.Get() !=
                                           bundles[i]->GetAttachmentState())) {
                             return DAWN_VALIDATION_ERROR(
@@ -226,12 +315,32 @@ namespace dawn_native {
                     return {};
                 }
 
+                case Command::BeginPipelineStatisticsQuery: {
+                    commands->NextCommand<BeginPipelineStatisticsQueryCmd>();
+                    break;
+                }
+
+                case Command::EndPipelineStatisticsQuery: {
+                    commands->NextCommand<EndPipelineStatisticsQueryCmd>();
+                    break;
+                }
+
                 case Command::Dispatch: {
                     commands->NextCommand<DispatchCmd>();
                     DAWN_TRY(commandBufferState.ValidateCanDispatch());
                     break;
                 }
 
+                case Command::DispatchBatch: {
+                    DispatchBatchCmd* cmd = commands->NextCommand<DispatchBatchCmd>();
+                    commands->NextData<DispatchBatchEntry>(cmd->entryCount);
+                    // The batch binds its group before every dispatch, so the pipeline
+                    // compatibility check sees the batch's group at that index.
+                    commandBufferState.SetBindGroup(cmd->groupIndex, cmd->group.Get());
+                    DAWN_TRY(commandBufferState.ValidateCanDispatch());
+                    break;
+                }
+
                 case Command::DispatchIndirect: {
                     commands->NextCommand<DispatchIndirectCmd>();
                     DAWN_TRY(commandBufferState.ValidateCanDispatch());
@@ -296,45 +405,29 @@ namespace dawn_native {
                     return {};
                 } break;
 
-                case Command::TraceRays: {
-                    commands->NextCommand<TraceRaysCmd>();
-                    DAWN_TRY(commandBufferState.ValidateCanTraceRays());
+                case Command::BeginPipelineStatisticsQuery: {
+                    commands->NextCommand<BeginPipelineStatisticsQueryCmd>();
                 } break;
 
-                case Command::InsertDebugMarker: {
-                    InsertDebugMarkerCmd* cmd = commands->NextCommand<InsertDebugMarkerCmd>();
-                    commands->NextData<char>(cmd->length + 1);
-                } break;
-
-                case Command::PopDebugGroup: {
-                    commands->NextCommand<PopDebugGroupCmd>();
-                    DAWN_TRY(ValidateCanPopDebugGroup(debugGroupStackSize));
-                    debugGroupStackSize--;
-                } break;
-
-                case Command::PushDebugGroup: {
-                    PushDebugGroupCmd* cmd = commands->NextCommand<PushDebugGroupCmd>();
-                    commands->NextData<char>(cmd->length + 1);
-                    debugGroupStackSize++;
+                case Command::EndPipelineStatisticsQuery: {
+                    commands->NextCommand<EndPipelineStatisticsQueryCmd>();
                 } break;
 
-                case Command::SetRayTracingPipeline: {
-                    SetRayTracingPipelineCmd* cmd =
-                        commands->NextCommand<SetRayTracingPipelineCmd>();
-                    RayTracingPipelineBase* pipeline = cmd->pipeline.Get();
-                    commandBufferState.SetRayTracingPipeline(pipeline);
-                } break;
+                case Command::ExecuteRayTracingBundles: {
+                    ExecuteRayTracingBundlesCmd* cmd =
+                        commands->NextCommand<ExecuteRayTracingBundlesCmd>();
+                    commands->NextData<Ref<RayTracingBundleBase>>(cmd->count);
 
-                case Command::SetBindGroup: {
-                    SetBindGroupCmd* cmd = commands->NextCommand<SetBindGroupCmd>();
-                    if (cmd->dynamicOffsetCount > 0) {
-                        commands->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                    if (cmd->count > 0) {
+                        // Reset state. It is invalidated after ray tracing bundle execution.
+                        commandBufferState = CommandBufferStateTracker{};
                     }
-                    commandBufferState.SetBindGroup(cmd->index, cmd->group.Get());
                 } break;
 
                 default:
-                    return DAWN_VALIDATION_ERROR("Command disallowed inside a ray tracing pass");
+                    DAWN_TRY(ValidateRayTracingBundleCommand(
+                        commands, type, &commandBufferState, &debugGroupStackSize,
+                        "Command disallowed inside a ray tracing pass"));
             }
         }
 
@@ -355,6 +448,12 @@ namespace dawn_native {
                 return DAWN_VALIDATION_ERROR("Buffer missing usage for the pass");
             }
 
+            // Usages covered by a frozen state never reach the tracked list, so a frozen
+            // buffer showing up here was used outside its frozen usage.
+            if (buffer->GetFrozenUsage() != wgpu::BufferUsage::None) {
+                return DAWN_VALIDATION_ERROR("Buffer used outside of its frozen usage");
+            }
+
             bool readOnly = (usage & kReadOnlyBufferUsages) == usage;
             bool singleUse = wgpu::HasZeroOrOneBits(usage);
 
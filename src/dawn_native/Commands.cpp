@@ -18,7 +18,9 @@
 #include "dawn_native/Buffer.h"
 #include "dawn_native/CommandAllocator.h"
 #include "dawn_native/ComputePipeline.h"
+#include "dawn_native/QuerySet.h"
 #include "dawn_native/RayTracingAccelerationContainer.h"
+#include "dawn_native/RayTracingBundle.h"
 #include "dawn_native/RayTracingPipeline.h"
 #include "dawn_native/RenderBundle.h"
 #include "dawn_native/RenderPipeline.h"
@@ -38,6 +40,12 @@ namespace dawn_native {
                     begin->~BeginComputePassCmd();
                     break;
                 }
+                case Command::BeginPipelineStatisticsQuery: {
+                    BeginPipelineStatisticsQueryCmd* cmd =
+                        commands->NextCommand<BeginPipelineStatisticsQueryCmd>();
+                    cmd->~BeginPipelineStatisticsQueryCmd();
+                    break;
+                }
                 case Command::BeginRayTracingPass: {
                     BeginRayTracingPassCmd* begin = commands->NextCommand<BeginRayTracingPassCmd>();
                     begin->~BeginRayTracingPassCmd();
@@ -54,12 +62,55 @@ namespace dawn_native {
                     build->~BuildRayTracingAccelerationContainerCmd();
                     break;
                 }
+                case Command::BuildRayTracingAccelerationContainers: {
+                    BuildRayTracingAccelerationContainersCmd* build =
+                        commands->NextCommand<BuildRayTracingAccelerationContainersCmd>();
+                    auto containers =
+                        commands->NextData<Ref<RayTracingAccelerationContainerBase>>(build->count);
+                    for (size_t i = 0; i < build->count; ++i) {
+                        (&containers[i])->~Ref<RayTracingAccelerationContainerBase>();
+                    }
+                    build->~BuildRayTracingAccelerationContainersCmd();
+                    break;
+                }
+                case Command::CompactRayTracingAccelerationContainer: {
+                    CompactRayTracingAccelerationContainerCmd* compact =
+                        commands->NextCommand<CompactRayTracingAccelerationContainerCmd>();
+                    compact->~CompactRayTracingAccelerationContainerCmd();
+                    break;
+                }
                 case Command::CopyRayTracingAccelerationContainer: {
                     CopyRayTracingAccelerationContainerCmd* build =
                         commands->NextCommand<CopyRayTracingAccelerationContainerCmd>();
                     build->~CopyRayTracingAccelerationContainerCmd();
                     break;
                 }
+                case Command::WriteRayTracingAccelerationContainerCompactedSize: {
+                    WriteRayTracingAccelerationContainerCompactedSizeCmd* write =
+                        commands
+                            ->NextCommand<WriteRayTracingAccelerationContainerCompactedSizeCmd>();
+                    write->~WriteRayTracingAccelerationContainerCompactedSizeCmd();
+                    break;
+                }
+                case Command::WriteRayTracingAccelerationContainerSerializationSize: {
+                    WriteRayTracingAccelerationContainerSerializationSizeCmd* write =
+                        commands
+                            ->NextCommand<WriteRayTracingAccelerationContainerSerializationSizeCmd>();
+                    write->~WriteRayTracingAccelerationContainerSerializationSizeCmd();
+                    break;
+                }
+                case Command::SerializeRayTracingAccelerationContainer: {
+                    SerializeRayTracingAccelerationContainerCmd* serialize =
+                        commands->NextCommand<SerializeRayTracingAccelerationContainerCmd>();
+                    serialize->~SerializeRayTracingAccelerationContainerCmd();
+                    break;
+                }
+                case Command::DeserializeRayTracingAccelerationContainer: {
+                    DeserializeRayTracingAccelerationContainerCmd* deserialize =
+                        commands->NextCommand<DeserializeRayTracingAccelerationContainerCmd>();
+                    deserialize->~DeserializeRayTracingAccelerationContainerCmd();
+                    break;
+                }
                 case Command::UpdateRayTracingAccelerationContainer: {
                     UpdateRayTracingAccelerationContainerCmd* update =
                         commands->NextCommand<UpdateRayTracingAccelerationContainerCmd>();
@@ -71,6 +122,19 @@ namespace dawn_native {
                     copy->~CopyBufferToBufferCmd();
                     break;
                 }
+                case Command::CopyBufferToBufferBatch: {
+                    CopyBufferToBufferBatchCmd* copy =
+                        commands->NextCommand<CopyBufferToBufferBatchCmd>();
+                    commands->NextData<BufferCopyRegion>(copy->regionCount);
+                    copy->~CopyBufferToBufferBatchCmd();
+                    break;
+                }
+                case Command::CopyBufferToRayTracingInstances: {
+                    CopyBufferToRayTracingInstancesCmd* copy =
+                        commands->NextCommand<CopyBufferToRayTracingInstancesCmd>();
+                    copy->~CopyBufferToRayTracingInstancesCmd();
+                    break;
+                }
                 case Command::CopyBufferToTexture: {
                     CopyBufferToTextureCmd* copy = commands->NextCommand<CopyBufferToTextureCmd>();
                     copy->~CopyBufferToTextureCmd();
@@ -92,6 +156,14 @@ namespace dawn_native {
                     dispatch->~DispatchCmd();
                     break;
                 }
+                case Command::DispatchBatch: {
+                    DispatchBatchCmd* dispatch = commands->NextCommand<DispatchBatchCmd>();
+                    if (dispatch->entryCount > 0) {
+                        commands->NextData<DispatchBatchEntry>(dispatch->entryCount);
+                    }
+                    dispatch->~DispatchBatchCmd();
+                    break;
+                }
                 case Command::DispatchIndirect: {
                     DispatchIndirectCmd* dispatch = commands->NextCommand<DispatchIndirectCmd>();
                     dispatch->~DispatchIndirectCmd();
@@ -117,11 +189,23 @@ namespace dawn_native {
                     draw->~DrawIndexedIndirectCmd();
                     break;
                 }
+                case Command::MultiDrawIndexedIndirect: {
+                    MultiDrawIndexedIndirectCmd* draw =
+                        commands->NextCommand<MultiDrawIndexedIndirectCmd>();
+                    draw->~MultiDrawIndexedIndirectCmd();
+                    break;
+                }
                 case Command::EndComputePass: {
                     EndComputePassCmd* cmd = commands->NextCommand<EndComputePassCmd>();
                     cmd->~EndComputePassCmd();
                     break;
                 }
+                case Command::EndPipelineStatisticsQuery: {
+                    EndPipelineStatisticsQueryCmd* cmd =
+                        commands->NextCommand<EndPipelineStatisticsQueryCmd>();
+                    cmd->~EndPipelineStatisticsQueryCmd();
+                    break;
+                }
                 case Command::EndRayTracingPass: {
                     EndRayTracingPassCmd* cmd = commands->NextCommand<EndRayTracingPassCmd>();
                     cmd->~EndRayTracingPassCmd();
@@ -141,6 +225,16 @@ namespace dawn_native {
                     cmd->~ExecuteBundlesCmd();
                     break;
                 }
+                case Command::ExecuteRayTracingBundles: {
+                    ExecuteRayTracingBundlesCmd* cmd =
+                        commands->NextCommand<ExecuteRayTracingBundlesCmd>();
+                    auto bundles = commands->NextData<Ref<RayTracingBundleBase>>(cmd->count);
+                    for (size_t i = 0; i < cmd->count; ++i) {
+                        (&bundles[i])->~Ref<RayTracingBundleBase>();
+                    }
+                    cmd->~ExecuteRayTracingBundlesCmd();
+                    break;
+                }
                 case Command::InsertDebugMarker: {
                     InsertDebugMarkerCmd* cmd = commands->NextCommand<InsertDebugMarkerCmd>();
                     commands->NextData<char>(cmd->length + 1);
@@ -158,6 +252,11 @@ namespace dawn_native {
                     cmd->~PushDebugGroupCmd();
                     break;
                 }
+                case Command::ResolveQuerySet: {
+                    ResolveQuerySetCmd* cmd = commands->NextCommand<ResolveQuerySetCmd>();
+                    cmd->~ResolveQuerySetCmd();
+                    break;
+                }
                 case Command::SetComputePipeline: {
                     SetComputePipelineCmd* cmd = commands->NextCommand<SetComputePipelineCmd>();
                     cmd->~SetComputePipelineCmd();
@@ -202,6 +301,12 @@ namespace dawn_native {
                     cmd->~SetBindGroupCmd();
                     break;
                 }
+                case Command::SetImmediateData: {
+                    SetImmediateDataCmd* cmd = commands->NextCommand<SetImmediateDataCmd>();
+                    commands->NextData<uint8_t>(cmd->size);
+                    cmd->~SetImmediateDataCmd();
+                    break;
+                }
                 case Command::SetIndexBuffer: {
                     SetIndexBufferCmd* cmd = commands->NextCommand<SetIndexBufferCmd>();
                     cmd->~SetIndexBufferCmd();
@@ -217,6 +322,16 @@ namespace dawn_native {
                     cmd->~TraceRaysCmd();
                     break;
                 }
+                case Command::TraceRaysIndirect: {
+                    TraceRaysIndirectCmd* cmd = commands->NextCommand<TraceRaysIndirectCmd>();
+                    cmd->~TraceRaysIndirectCmd();
+                    break;
+                }
+                case Command::WriteTimestamp: {
+                    WriteTimestampCmd* cmd = commands->NextCommand<WriteTimestampCmd>();
+                    cmd->~WriteTimestampCmd();
+                    break;
+                }
             }
         }
         commands->DataWasDestroyed();
@@ -228,6 +343,10 @@ namespace dawn_native {
                 commands->NextCommand<BeginComputePassCmd>();
                 break;
 
+            case Command::BeginPipelineStatisticsQuery:
+                commands->NextCommand<BeginPipelineStatisticsQueryCmd>();
+                break;
+
             case Command::BeginRayTracingPass:
                 commands->NextCommand<BeginRayTracingPassCmd>();
                 break;
@@ -240,10 +359,37 @@ namespace dawn_native {
                 commands->NextCommand<BuildRayTracingAccelerationContainerCmd>();
                 break;
 
+            case Command::BuildRayTracingAccelerationContainers: {
+                BuildRayTracingAccelerationContainersCmd* build =
+                    commands->NextCommand<BuildRayTracingAccelerationContainersCmd>();
+                commands->NextData<Ref<RayTracingAccelerationContainerBase>>(build->count);
+                break;
+            }
+
+            case Command::CompactRayTracingAccelerationContainer:
+                commands->NextCommand<CompactRayTracingAccelerationContainerCmd>();
+                break;
+
             case Command::CopyRayTracingAccelerationContainer:
                 commands->NextCommand<CopyRayTracingAccelerationContainerCmd>();
                 break;
 
+            case Command::WriteRayTracingAccelerationContainerCompactedSize:
+                commands->NextCommand<WriteRayTracingAccelerationContainerCompactedSizeCmd>();
+                break;
+
+            case Command::WriteRayTracingAccelerationContainerSerializationSize:
+                commands->NextCommand<WriteRayTracingAccelerationContainerSerializationSizeCmd>();
+                break;
+
+            case Command::SerializeRayTracingAccelerationContainer:
+                commands->NextCommand<SerializeRayTracingAccelerationContainerCmd>();
+                break;
+
+            case Command::DeserializeRayTracingAccelerationContainer:
+                commands->NextCommand<DeserializeRayTracingAccelerationContainerCmd>();
+                break;
+
             case Command::UpdateRayTracingAccelerationContainer:
                 commands->NextCommand<UpdateRayTracingAccelerationContainerCmd>();
                 break;
@@ -252,6 +398,17 @@ namespace dawn_native {
                 commands->NextCommand<CopyBufferToBufferCmd>();
                 break;
 
+            case Command::CopyBufferToBufferBatch: {
+                const CopyBufferToBufferBatchCmd* copy =
+                    commands->NextCommand<CopyBufferToBufferBatchCmd>();
+                commands->NextData<BufferCopyRegion>(copy->regionCount);
+                break;
+            }
+
+            case Command::CopyBufferToRayTracingInstances:
+                commands->NextCommand<CopyBufferToRayTracingInstancesCmd>();
+                break;
+
             case Command::CopyBufferToTexture:
                 commands->NextCommand<CopyBufferToTextureCmd>();
                 break;
@@ -268,6 +425,14 @@ namespace dawn_native {
                 commands->NextCommand<DispatchCmd>();
                 break;
 
+            case Command::DispatchBatch: {
+                DispatchBatchCmd* dispatch = commands->NextCommand<DispatchBatchCmd>();
+                if (dispatch->entryCount > 0) {
+                    commands->NextData<DispatchBatchEntry>(dispatch->entryCount);
+                }
+                break;
+            }
+
             case Command::DispatchIndirect:
                 commands->NextCommand<DispatchIndirectCmd>();
                 break;
@@ -288,10 +453,18 @@ namespace dawn_native {
                 commands->NextCommand<DrawIndexedIndirectCmd>();
                 break;
 
+            case Command::MultiDrawIndexedIndirect:
+                commands->NextCommand<MultiDrawIndexedIndirectCmd>();
+                break;
+
             case Command::EndComputePass:
                 commands->NextCommand<EndComputePassCmd>();
                 break;
 
+            case Command::EndPipelineStatisticsQuery:
+                commands->NextCommand<EndPipelineStatisticsQueryCmd>();
+                break;
+
             case Command::EndRayTracingPass:
                 commands->NextCommand<EndRayTracingPassCmd>();
                 break;
@@ -306,6 +479,12 @@ namespace dawn_native {
                 break;
             }
 
+            case Command::ExecuteRayTracingBundles: {
+                auto* cmd = commands->NextCommand<ExecuteRayTracingBundlesCmd>();
+                commands->NextData<Ref<RayTracingBundleBase>>(cmd->count);
+                break;
+            }
+
             case Command::InsertDebugMarker: {
                 InsertDebugMarkerCmd* cmd = commands->NextCommand<InsertDebugMarkerCmd>();
                 commands->NextData<char>(cmd->length + 1);
@@ -322,6 +501,10 @@ namespace dawn_native {
                 break;
             }
 
+            case Command::ResolveQuerySet:
+                commands->NextCommand<ResolveQuerySetCmd>();
+                break;
+
             case Command::SetComputePipeline:
                 commands->NextCommand<SetComputePipelineCmd>();
                 break;
@@ -358,6 +541,12 @@ namespace dawn_native {
                 break;
             }
 
+            case Command::SetImmediateData: {
+                SetImmediateDataCmd* cmd = commands->NextCommand<SetImmediateDataCmd>();
+                commands->NextData<uint8_t>(cmd->size);
+                break;
+            }
+
             case Command::SetIndexBuffer:
                 commands->NextCommand<SetIndexBufferCmd>();
                 break;
@@ -369,6 +558,265 @@ namespace dawn_native {
             case Command::TraceRays:
                 commands->NextCommand<TraceRaysCmd>();
                 break;
+
+            case Command::TraceRaysIndirect:
+                commands->NextCommand<TraceRaysIndirectCmd>();
+                break;
+
+            case Command::WriteTimestamp:
+                commands->NextCommand<WriteTimestampCmd>();
+                break;
+        }
+    }
+
+    namespace {
+
+        template <typename T>
+        void CopyCmd(CommandIterator* in, CommandAllocator* out, Command type) {
+            *out->Allocate<T>(type) = *in->NextCommand<T>();
+        }
+
+    }  // anonymous namespace
+
+    void CopyCommand(CommandIterator* in, CommandAllocator* out, Command type) {
+        switch (type) {
+            case Command::BeginComputePass:
+                CopyCmd<BeginComputePassCmd>(in, out, type);
+                break;
+
+            case Command::BeginPipelineStatisticsQuery:
+                CopyCmd<BeginPipelineStatisticsQueryCmd>(in, out, type);
+                break;
+
+            case Command::BeginRayTracingPass:
+                CopyCmd<BeginRayTracingPassCmd>(in, out, type);
+                break;
+
+            case Command::BeginRenderPass:
+                CopyCmd<BeginRenderPassCmd>(in, out, type);
+                break;
+
+            case Command::BuildRayTracingAccelerationContainer:
+                CopyCmd<BuildRayTracingAccelerationContainerCmd>(in, out, type);
+                break;
+
+            case Command::BuildRayTracingAccelerationContainers: {
+                const BuildRayTracingAccelerationContainersCmd* cmd =
+                    in->NextCommand<BuildRayTracingAccelerationContainersCmd>();
+                *out->Allocate<BuildRayTracingAccelerationContainersCmd>(type) = *cmd;
+                CopyDataArray<Ref<RayTracingAccelerationContainerBase>>(in, out, cmd->count);
+                break;
+            }
+
+            case Command::CompactRayTracingAccelerationContainer:
+                CopyCmd<CompactRayTracingAccelerationContainerCmd>(in, out, type);
+                break;
+
+            case Command::CopyRayTracingAccelerationContainer:
+                CopyCmd<CopyRayTracingAccelerationContainerCmd>(in, out, type);
+                break;
+
+            case Command::WriteRayTracingAccelerationContainerCompactedSize:
+                CopyCmd<WriteRayTracingAccelerationContainerCompactedSizeCmd>(in, out, type);
+                break;
+
+            case Command::WriteRayTracingAccelerationContainerSerializationSize:
+                CopyCmd<WriteRayTracingAccelerationContainerSerializationSizeCmd>(in, out, type);
+                break;
+
+            case Command::SerializeRayTracingAccelerationContainer:
+                CopyCmd<SerializeRayTracingAccelerationContainerCmd>(in, out, type);
+                break;
+
+            case Command::DeserializeRayTracingAccelerationContainer:
+                CopyCmd<DeserializeRayTracingAccelerationContainerCmd>(in, out, type);
+                break;
+
+            case Command::UpdateRayTracingAccelerationContainer:
+                CopyCmd<UpdateRayTracingAccelerationContainerCmd>(in, out, type);
+                break;
+
+            case Command::CopyBufferToBuffer:
+                CopyCmd<CopyBufferToBufferCmd>(in, out, type);
+                break;
+
+            case Command::CopyBufferToBufferBatch: {
+                const CopyBufferToBufferBatchCmd* cmd =
+                    in->NextCommand<CopyBufferToBufferBatchCmd>();
+                *out->Allocate<CopyBufferToBufferBatchCmd>(type) = *cmd;
+                CopyDataArray<BufferCopyRegion>(in, out, cmd->regionCount);
+                break;
+            }
+
+            case Command::CopyBufferToRayTracingInstances:
+                CopyCmd<CopyBufferToRayTracingInstancesCmd>(in, out, type);
+                break;
+
+            case Command::CopyBufferToTexture:
+                CopyCmd<CopyBufferToTextureCmd>(in, out, type);
+                break;
+
+            case Command::CopyTextureToBuffer:
+                CopyCmd<CopyTextureToBufferCmd>(in, out, type);
+                break;
+
+            case Command::CopyTextureToTexture:
+                CopyCmd<CopyTextureToTextureCmd>(in, out, type);
+                break;
+
+            case Command::Dispatch:
+                CopyCmd<DispatchCmd>(in, out, type);
+                break;
+
+            case Command::DispatchBatch: {
+                const DispatchBatchCmd* cmd = in->NextCommand<DispatchBatchCmd>();
+                *out->Allocate<DispatchBatchCmd>(type) = *cmd;
+                if (cmd->entryCount > 0) {
+                    CopyDataArray<DispatchBatchEntry>(in, out, cmd->entryCount);
+                }
+                break;
+            }
+
+            case Command::DispatchIndirect:
+                CopyCmd<DispatchIndirectCmd>(in, out, type);
+                break;
+
+            case Command::Draw:
+                CopyCmd<DrawCmd>(in, out, type);
+                break;
+
+            case Command::DrawIndexed:
+                CopyCmd<DrawIndexedCmd>(in, out, type);
+                break;
+
+            case Command::DrawIndirect:
+                CopyCmd<DrawIndirectCmd>(in, out, type);
+                break;
+
+            case Command::DrawIndexedIndirect:
+                CopyCmd<DrawIndexedIndirectCmd>(in, out, type);
+                break;
+
+            case Command::MultiDrawIndexedIndirect:
+                CopyCmd<MultiDrawIndexedIndirectCmd>(in, out, type);
+                break;
+
+            case Command::EndComputePass:
+                CopyCmd<EndComputePassCmd>(in, out, type);
+                break;
+
+            case Command::EndPipelineStatisticsQuery:
+                CopyCmd<EndPipelineStatisticsQueryCmd>(in, out, type);
+                break;
+
+            case Command::EndRayTracingPass:
+                CopyCmd<EndRayTracingPassCmd>(in, out, type);
+                break;
+
+            case Command::EndRenderPass:
+                CopyCmd<EndRenderPassCmd>(in, out, type);
+                break;
+
+            case Command::ExecuteBundles: {
+                const ExecuteBundlesCmd* cmd = in->NextCommand<ExecuteBundlesCmd>();
+                *out->Allocate<ExecuteBundlesCmd>(type) = *cmd;
+                CopyDataArray<Ref<RenderBundleBase>>(in, out, cmd->count);
+                break;
+            }
+
+            case Command::ExecuteRayTracingBundles: {
+                const ExecuteRayTracingBundlesCmd* cmd =
+                    in->NextCommand<ExecuteRayTracingBundlesCmd>();
+                *out->Allocate<ExecuteRayTracingBundlesCmd>(type) = *cmd;
+                CopyDataArray<Ref<RayTracingBundleBase>>(in, out, cmd->count);
+                break;
+            }
+
+            case Command::InsertDebugMarker: {
+                const InsertDebugMarkerCmd* cmd = in->NextCommand<InsertDebugMarkerCmd>();
+                *out->Allocate<InsertDebugMarkerCmd>(type) = *cmd;
+                CopyDataArray<char>(in, out, cmd->length + 1);
+                break;
+            }
+
+            case Command::PopDebugGroup:
+                CopyCmd<PopDebugGroupCmd>(in, out, type);
+                break;
+
+            case Command::PushDebugGroup: {
+                const PushDebugGroupCmd* cmd = in->NextCommand<PushDebugGroupCmd>();
+                *out->Allocate<PushDebugGroupCmd>(type) = *cmd;
+                CopyDataArray<char>(in, out, cmd->length + 1);
+                break;
+            }
+
+            case Command::ResolveQuerySet:
+                CopyCmd<ResolveQuerySetCmd>(in, out, type);
+                break;
+
+            case Command::SetComputePipeline:
+                CopyCmd<SetComputePipelineCmd>(in, out, type);
+                break;
+
+            case Command::SetRayTracingPipeline:
+                CopyCmd<SetRayTracingPipelineCmd>(in, out, type);
+                break;
+
+            case Command::SetRenderPipeline:
+                CopyCmd<SetRenderPipelineCmd>(in, out, type);
+                break;
+
+            case Command::SetStencilReference:
+                CopyCmd<SetStencilReferenceCmd>(in, out, type);
+                break;
+
+            case Command::SetViewport:
+                CopyCmd<SetViewportCmd>(in, out, type);
+                break;
+
+            case Command::SetScissorRect:
+                CopyCmd<SetScissorRectCmd>(in, out, type);
+                break;
+
+            case Command::SetBlendColor:
+                CopyCmd<SetBlendColorCmd>(in, out, type);
+                break;
+
+            case Command::SetBindGroup: {
+                const SetBindGroupCmd* cmd = in->NextCommand<SetBindGroupCmd>();
+                *out->Allocate<SetBindGroupCmd>(type) = *cmd;
+                if (cmd->dynamicOffsetCount > 0) {
+                    CopyDataArray<uint32_t>(in, out, cmd->dynamicOffsetCount);
+                }
+                break;
+            }
+
+            case Command::SetImmediateData: {
+                const SetImmediateDataCmd* cmd = in->NextCommand<SetImmediateDataCmd>();
+                *out->Allocate<SetImmediateDataCmd>(type) = *cmd;
+                CopyDataArray<uint8_t>(in, out, cmd->size);
+                break;
+            }
+
+            case Command::SetIndexBuffer:
+                CopyCmd<SetIndexBufferCmd>(in, out, type);
+                break;
+
+            case Command::SetVertexBuffer:
+                CopyCmd<SetVertexBufferCmd>(in, out, type);
+                break;
+
+            case Command::TraceRays:
+                CopyCmd<TraceRaysCmd>(in, out, type);
+                break;
+
+            case Command::TraceRaysIndirect:
+                CopyCmd<TraceRaysIndirectCmd>(in, out, type);
+                break;
+
+            case Command::WriteTimestamp:
+                CopyCmd<WriteTimestampCmd>(in, out, type);
+                break;
         }
     }
 
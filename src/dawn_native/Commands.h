@@ -18,6 +18,7 @@
 #include "common/Constants.h"
 
 #include "dawn_native/AttachmentState.h"
+#include "dawn_native/CommandAllocator.h"
 #include "dawn_native/Texture.h"
 
 #include "dawn_native/dawn_platform.h"
@@ -33,28 +34,42 @@ namespace dawn_native {
 
     enum class Command {
         BeginComputePass,
+        BeginPipelineStatisticsQuery,
         BeginRayTracingPass,
         BeginRenderPass,
         BuildRayTracingAccelerationContainer,
+        BuildRayTracingAccelerationContainers,
+        CompactRayTracingAccelerationContainer,
         CopyRayTracingAccelerationContainer,
+        WriteRayTracingAccelerationContainerCompactedSize,
+        WriteRayTracingAccelerationContainerSerializationSize,
+        SerializeRayTracingAccelerationContainer,
+        DeserializeRayTracingAccelerationContainer,
         UpdateRayTracingAccelerationContainer,
         CopyBufferToBuffer,
+        CopyBufferToBufferBatch,
+        CopyBufferToRayTracingInstances,
         CopyBufferToTexture,
         CopyTextureToBuffer,
         CopyTextureToTexture,
         Dispatch,
+        DispatchBatch,
         DispatchIndirect,
         Draw,
         DrawIndexed,
         DrawIndirect,
         DrawIndexedIndirect,
+        MultiDrawIndexedIndirect,
         EndComputePass,
+        EndPipelineStatisticsQuery,
         EndRayTracingPass,
         EndRenderPass,
         ExecuteBundles,
+        ExecuteRayTracingBundles,
         InsertDebugMarker,
         PopDebugGroup,
         PushDebugGroup,
+        ResolveQuerySet,
         SetComputePipeline,
         SetRayTracingPipeline,
         SetRenderPipeline,
@@ -63,14 +78,27 @@ namespace dawn_native {
         SetScissorRect,
         SetBlendColor,
         SetBindGroup,
+        SetImmediateData,
         SetIndexBuffer,
         SetVertexBuffer,
-        TraceRays
+        TraceRays,
+        TraceRaysIndirect,
+        WriteTimestamp
     };
 
     struct BeginComputePassCmd {};
     struct BeginRayTracingPassCmd {};
 
+    struct BeginPipelineStatisticsQueryCmd {
+        Ref<QuerySetBase> querySet;
+        uint32_t queryIndex;
+    };
+
+    struct EndPipelineStatisticsQueryCmd {
+        Ref<QuerySetBase> querySet;
+        uint32_t queryIndex;
+    };
+
     struct RenderPassColorAttachmentInfo {
         Ref<TextureViewBase> view;
         Ref<TextureViewBase> resolveTarget;
@@ -103,11 +131,44 @@ namespace dawn_native {
         Ref<RayTracingAccelerationContainerBase> container;
     };
 
+    struct BuildRayTracingAccelerationContainersCmd {
+        uint32_t count;
+    };
+
+    struct CompactRayTracingAccelerationContainerCmd {
+        Ref<RayTracingAccelerationContainerBase> srcContainer;
+        Ref<RayTracingAccelerationContainerBase> dstContainer;
+    };
+
     struct CopyRayTracingAccelerationContainerCmd {
         Ref<RayTracingAccelerationContainerBase> srcContainer;
         Ref<RayTracingAccelerationContainerBase> dstContainer;
     };
 
+    struct WriteRayTracingAccelerationContainerCompactedSizeCmd {
+        Ref<RayTracingAccelerationContainerBase> container;
+        Ref<BufferBase> destination;
+        uint64_t destinationOffset;
+    };
+
+    struct WriteRayTracingAccelerationContainerSerializationSizeCmd {
+        Ref<RayTracingAccelerationContainerBase> container;
+        Ref<BufferBase> destination;
+        uint64_t destinationOffset;
+    };
+
+    struct SerializeRayTracingAccelerationContainerCmd {
+        Ref<RayTracingAccelerationContainerBase> container;
+        Ref<BufferBase> destination;
+        uint64_t destinationOffset;
+    };
+
+    struct DeserializeRayTracingAccelerationContainerCmd {
+        Ref<RayTracingAccelerationContainerBase> container;
+        Ref<BufferBase> source;
+        uint64_t sourceOffset;
+    };
+
     struct UpdateRayTracingAccelerationContainerCmd {
         Ref<RayTracingAccelerationContainerBase> container;
     };
@@ -134,6 +195,23 @@ namespace dawn_native {
         uint64_t size;
     };
 
+    // Followed by regionCount BufferCopyRegion in the command stream. The whole batch is
+    // validated once at encode time and replays as a single multi-region copy on backends
+    // that support one.
+    struct CopyBufferToBufferBatchCmd {
+        Ref<BufferBase> source;
+        Ref<BufferBase> destination;
+        uint32_t regionCount;
+    };
+
+    struct CopyBufferToRayTracingInstancesCmd {
+        Ref<BufferBase> source;
+        uint64_t sourceOffset;
+        Ref<RayTracingAccelerationContainerBase> container;
+        uint32_t firstInstance;
+        uint32_t instanceCount;
+    };
+
     struct CopyBufferToTextureCmd {
         BufferCopy source;
         TextureCopy destination;
@@ -158,6 +236,16 @@ namespace dawn_native {
         uint32_t z;
     };
 
+    // Followed by DispatchBatchEntry[entryCount] in the command tape. Each entry rebinds
+    // |group| at |groupIndex| with the entry's dynamic offset before dispatching, so a run
+    // of small dispatches records a single command instead of a SetBindGroup/Dispatch pair
+    // per dispatch.
+    struct DispatchBatchCmd {
+        uint32_t groupIndex;
+        Ref<BindGroupBase> group;
+        uint32_t entryCount;
+    };
+
     struct DispatchIndirectCmd {
         Ref<BufferBase> indirectBuffer;
         uint64_t indirectOffset;
@@ -188,6 +276,15 @@ namespace dawn_native {
         uint64_t indirectOffset;
     };
 
+    struct MultiDrawIndexedIndirectCmd {
+        Ref<BufferBase> indirectBuffer;
+        uint64_t indirectOffset;
+        uint32_t maxDrawCount;
+        // Optional: when null, maxDrawCount draws are issued unconditionally.
+        Ref<BufferBase> countBuffer;
+        uint64_t countBufferOffset;
+    };
+
     struct EndComputePassCmd {};
 
     struct EndRayTracingPassCmd {};
@@ -198,6 +295,10 @@ namespace dawn_native {
         uint32_t count;
     };
 
+    struct ExecuteRayTracingBundlesCmd {
+        uint32_t count;
+    };
+
     struct InsertDebugMarkerCmd {
         uint32_t length;
     };
@@ -208,6 +309,14 @@ namespace dawn_native {
         uint32_t length;
     };
 
+    struct ResolveQuerySetCmd {
+        Ref<QuerySetBase> querySet;
+        uint32_t firstQuery;
+        uint32_t queryCount;
+        Ref<BufferBase> destination;
+        uint64_t destinationOffset;
+    };
+
     struct SetComputePipelineCmd {
         Ref<ComputePipelineBase> pipeline;
     };
@@ -242,6 +351,11 @@ namespace dawn_native {
         uint32_t dynamicOffsetCount;
     };
 
+    struct SetImmediateDataCmd {
+        uint32_t offset;
+        uint32_t size;
+    };
+
     struct SetIndexBufferCmd {
         Ref<BufferBase> buffer;
         uint64_t offset;
@@ -264,15 +378,42 @@ namespace dawn_native {
         uint32_t depth;
     };
 
+    struct TraceRaysIndirectCmd {
+        uint32_t rayGenerationOffset;
+        uint32_t rayHitOffset;
+        uint32_t rayMissOffset;
+        Ref<BufferBase> indirectBuffer;
+        uint64_t indirectOffset;
+    };
+
+    struct WriteTimestampCmd {
+        Ref<QuerySetBase> querySet;
+        uint32_t queryIndex;
+    };
+
     // This needs to be called before the CommandIterator is freed so that the Ref<> present in
     // the commands have a chance to run their destructor and remove internal references.
-    class CommandIterator;
     void FreeCommands(CommandIterator* commands);
 
     // Helper function to allow skipping over a command when it is unimplemented, while still
     // consuming the correct amount of data from the command iterator.
     void SkipCommand(CommandIterator* commands, Command type);
 
+    // Copies |count| trailing data elements of the last command read from |in|. Ref<>
+    // elements are copied through assignment so the references are duplicated properly.
+    template <typename T>
+    void CopyDataArray(CommandIterator* in, CommandAllocator* out, size_t count) {
+        const T* src = in->NextData<T>(count);
+        T* dst = out->AllocateData<T>(count);
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = src[i];
+        }
+    }
+
+    // Copies one command and its additional data from |commands| to |out|, duplicating any
+    // Ref<> it holds. Used by the finish-time tape rewrites. Kept in sync with SkipCommand.
+    void CopyCommand(CommandIterator* commands, CommandAllocator* out, Command type);
+
 }  // namespace dawn_native
 
 #endif  // DAWNNATIVE_COMMANDS_H_
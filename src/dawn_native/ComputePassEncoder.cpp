@@ -14,11 +14,17 @@
 
 #include "dawn_native/ComputePassEncoder.h"
 
+#include "common/Assert.h"
+#include "dawn_native/BindGroup.h"
+#include "dawn_native/BindGroupLayout.h"
 #include "dawn_native/Buffer.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/Commands.h"
 #include "dawn_native/ComputePipeline.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/QuerySet.h"
+
+#include <cstring>
 
 namespace dawn_native {
 
@@ -45,6 +51,11 @@ namespace dawn_native {
 
     void ComputePassEncoder::EndPass() {
         if (mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+                if (mActiveQuerySet != nullptr) {
+                    return DAWN_VALIDATION_ERROR(
+                        "The pipeline statistics query must be ended before the pass");
+                }
+
                 allocator->Allocate<EndComputePassCmd>(Command::EndComputePass);
 
                 return {};
@@ -53,6 +64,54 @@ namespace dawn_native {
         }
     }
 
+    void ComputePassEncoder::BeginPipelineStatisticsQuery(QuerySetBase* querySet,
+                                                          uint32_t queryIndex) {
+        mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            DAWN_TRY(GetDevice()->ValidateObject(querySet));
+
+            if (querySet->GetQueryType() != wgpu::QueryType::PipelineStatistics) {
+                return DAWN_VALIDATION_ERROR("The query set type must be PipelineStatistics");
+            }
+            if (querySet->IsDestroyed()) {
+                return DAWN_VALIDATION_ERROR("Query set must not be destroyed");
+            }
+            if (queryIndex >= querySet->GetQueryCount()) {
+                return DAWN_VALIDATION_ERROR("Query index out of bounds");
+            }
+            if (mActiveQuerySet != nullptr) {
+                return DAWN_VALIDATION_ERROR("A pipeline statistics query is already active");
+            }
+
+            BeginPipelineStatisticsQueryCmd* cmd =
+                allocator->Allocate<BeginPipelineStatisticsQueryCmd>(
+                    Command::BeginPipelineStatisticsQuery);
+            cmd->querySet = querySet;
+            cmd->queryIndex = queryIndex;
+
+            mActiveQuerySet = querySet;
+            mActiveQueryIndex = queryIndex;
+
+            return {};
+        });
+    }
+
+    void ComputePassEncoder::EndPipelineStatisticsQuery() {
+        mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (mActiveQuerySet == nullptr) {
+                return DAWN_VALIDATION_ERROR("No pipeline statistics query is active");
+            }
+
+            EndPipelineStatisticsQueryCmd* cmd = allocator->Allocate<EndPipelineStatisticsQueryCmd>(
+                Command::EndPipelineStatisticsQuery);
+            cmd->querySet = mActiveQuerySet;
+            cmd->queryIndex = mActiveQueryIndex;
+
+            mActiveQuerySet = nullptr;
+
+            return {};
+        });
+    }
+
     void ComputePassEncoder::Dispatch(uint32_t x, uint32_t y, uint32_t z) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
             DispatchCmd* dispatch = allocator->Allocate<DispatchCmd>(Command::Dispatch);
@@ -64,14 +123,73 @@ namespace dawn_native {
         });
     }
 
+    void ComputePassEncoder::DispatchBatch(uint32_t groupIndex,
+                                           BindGroupBase* group,
+                                           uint32_t entryCount,
+                                           const DispatchBatchEntry* entries) {
+        mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(group));
+
+                if (groupIndex >= kMaxBindGroups) {
+                    return DAWN_VALIDATION_ERROR("Setting bind group over the max");
+                }
+
+                // Each entry supplies the one dynamic offset that changes between the
+                // dispatches; layouts with more (or fewer) dynamic buffers can't be
+                // expressed by the entries.
+                if (group->GetLayout()->GetDynamicBufferCount() != 1) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Dispatch batch requires a bind group with exactly one dynamic buffer");
+                }
+
+                const uint32_t* maxDynamicOffsets = group->GetMaxDynamicOffsets();
+                for (uint32_t i = 0; i < entryCount; ++i) {
+                    if (entries[i].dynamicOffset % kMinDynamicBufferOffsetAlignment != 0) {
+                        return DAWN_VALIDATION_ERROR("Dynamic Buffer Offset need to be aligned");
+                    }
+
+                    if (entries[i].dynamicOffset > maxDynamicOffsets[0]) {
+                        return DAWN_VALIDATION_ERROR("dynamic offset out of bounds");
+                    }
+                }
+            }
+
+            if (entryCount == 0) {
+                return {};
+            }
+
+            DispatchBatchCmd* cmd = allocator->Allocate<DispatchBatchCmd>(Command::DispatchBatch);
+            cmd->groupIndex = groupIndex;
+            cmd->group = group;
+            cmd->entryCount = entryCount;
+
+            DispatchBatchEntry* storedEntries =
+                allocator->AllocateData<DispatchBatchEntry>(entryCount);
+            memcpy(storedEntries, entries, entryCount * sizeof(DispatchBatchEntry));
+
+            // The batch leaves |group| bound at |groupIndex| with the last entry's offset,
+            // so drop the redundant-set cache lest a following SetBindGroup be skipped
+            // against stale state.
+            ForgetLastSetState();
+
+            TrackBindGroupUsage(group);
+
+            return {};
+        });
+    }
+
     void ComputePassEncoder::DispatchIndirect(BufferBase* indirectBuffer, uint64_t indirectOffset) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
-            DAWN_TRY(GetDevice()->ValidateObject(indirectBuffer));
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(indirectBuffer));
 
-            if (indirectOffset >= indirectBuffer->GetSize() ||
-                indirectOffset + kDispatchIndirectSize > indirectBuffer->GetSize()) {
-                return DAWN_VALIDATION_ERROR("Indirect offset out of bounds");
+                if (indirectOffset >= indirectBuffer->GetSize() ||
+                    indirectOffset + kDispatchIndirectSize > indirectBuffer->GetSize()) {
+                    return DAWN_VALIDATION_ERROR("Indirect offset out of bounds");
+                }
             }
+            ASSERT(indirectOffset + kDispatchIndirectSize <= indirectBuffer->GetSize());
 
             DispatchIndirectCmd* dispatch =
                 allocator->Allocate<DispatchIndirectCmd>(Command::DispatchIndirect);
@@ -86,11 +204,21 @@ namespace dawn_native {
 
     void ComputePassEncoder::SetPipeline(ComputePipelineBase* pipeline) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
-            DAWN_TRY(GetDevice()->ValidateObject(pipeline));
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(pipeline));
+            }
+            ASSERT(!pipeline->IsError());
+
+            // Re-setting the current pipeline is a no-op; skip recording it. The previously
+            // recorded command keeps the pipeline referenced.
+            if (pipeline == mLastPipeline) {
+                return {};
+            }
 
             SetComputePipelineCmd* cmd =
                 allocator->Allocate<SetComputePipelineCmd>(Command::SetComputePipeline);
             cmd->pipeline = pipeline;
+            mLastPipeline = pipeline;
 
             return {};
         });
@@ -32,7 +32,13 @@ namespace dawn_native {
 
         void EndPass();
 
+        void BeginPipelineStatisticsQuery(QuerySetBase* querySet, uint32_t queryIndex);
+        void EndPipelineStatisticsQuery();
         void Dispatch(uint32_t x, uint32_t y, uint32_t z);
+        void DispatchBatch(uint32_t groupIndex,
+                           BindGroupBase* group,
+                           uint32_t entryCount,
+                           const DispatchBatchEntry* entries);
         void DispatchIndirect(BufferBase* indirectBuffer, uint64_t indirectOffset);
         void SetPipeline(ComputePipelineBase* pipeline);
 
@@ -46,6 +52,14 @@ namespace dawn_native {
         // For render and compute passes, the encoding context is borrowed from the command encoder.
         // Keep a reference to the encoder to make sure the context isn't freed.
         Ref<CommandEncoder> mCommandEncoder;
+
+        // The pipeline statistics query that is currently open, if any.
+        Ref<QuerySetBase> mActiveQuerySet;
+        uint32_t mActiveQueryIndex = 0;
+
+        // Used to skip recording redundant SetPipeline calls; kept alive by the recorded
+        // command that set it.
+        ComputePipelineBase* mLastPipeline = nullptr;
     };
 
 }  // namespace dawn_native
@@ -0,0 +1,115 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/CreateReadyPipelineTracker.h"
+
+#include "dawn_native/Device.h"
+#include "dawn_native/RayTracingPipeline.h"
+#include "dawn_native/RenderPipeline.h"
+
+namespace dawn_native {
+
+    CreateReadyPipelineTaskBase::CreateReadyPipelineTaskBase(std::string errorMessage,
+                                                             void* userdata)
+        : mErrorMessage(errorMessage), mUserData(userdata) {
+    }
+
+    CreateReadyPipelineTaskBase::~CreateReadyPipelineTaskBase() {
+    }
+
+    CreateReadyRenderPipelineTask::CreateReadyRenderPipelineTask(
+        RenderPipelineBase* pipeline,
+        std::string errorMessage,
+        wgpu::CreateReadyRenderPipelineCallback callback,
+        void* userdata)
+        : CreateReadyPipelineTaskBase(errorMessage, userdata),
+          mPipeline(pipeline),
+          mCallback(callback) {
+    }
+
+    void CreateReadyRenderPipelineTask::Finish() {
+        if (mPipeline != nullptr) {
+            mCallback(WGPUCreateReadyPipelineStatus_Success,
+                      reinterpret_cast<WGPURenderPipeline>(mPipeline), "", mUserData);
+        } else {
+            mCallback(WGPUCreateReadyPipelineStatus_Error, nullptr, mErrorMessage.c_str(),
+                      mUserData);
+        }
+    }
+
+    void CreateReadyRenderPipelineTask::HandleShutDown() {
+        if (mPipeline != nullptr) {
+            mPipeline->Release();
+            mPipeline = nullptr;
+        }
+        mCallback(WGPUCreateReadyPipelineStatus_DeviceDestroyed, nullptr,
+                  "Device destroyed before callback", mUserData);
+    }
+
+    CreateReadyRayTracingPipelineTask::CreateReadyRayTracingPipelineTask(
+        RayTracingPipelineBase* pipeline,
+        std::string errorMessage,
+        wgpu::CreateReadyRayTracingPipelineCallback callback,
+        void* userdata)
+        : CreateReadyPipelineTaskBase(errorMessage, userdata),
+          mPipeline(pipeline),
+          mCallback(callback) {
+    }
+
+    void CreateReadyRayTracingPipelineTask::Finish() {
+        if (mPipeline != nullptr) {
+            mCallback(WGPUCreateReadyPipelineStatus_Success,
+                      reinterpret_cast<WGPURayTracingPipeline>(mPipeline), "", mUserData);
+        } else {
+            mCallback(WGPUCreateReadyPipelineStatus_Error, nullptr, mErrorMessage.c_str(),
+                      mUserData);
+        }
+    }
+
+    void CreateReadyRayTracingPipelineTask::HandleShutDown() {
+        if (mPipeline != nullptr) {
+            mPipeline->Release();
+            mPipeline = nullptr;
+        }
+        mCallback(WGPUCreateReadyPipelineStatus_DeviceDestroyed, nullptr,
+                  "Device destroyed before callback", mUserData);
+    }
+
+    CreateReadyPipelineTracker::CreateReadyPipelineTracker(DeviceBase* device) : mDevice(device) {
+    }
+
+    CreateReadyPipelineTracker::~CreateReadyPipelineTracker() {
+        ASSERT(mCreateReadyPipelineTasksInFlight.Empty());
+    }
+
+    void CreateReadyPipelineTracker::TrackTask(std::unique_ptr<CreateReadyPipelineTaskBase> task,
+                                               Serial serial) {
+        mCreateReadyPipelineTasksInFlight.Enqueue(std::move(task), serial);
+    }
+
+    void CreateReadyPipelineTracker::Tick(Serial finishedSerial) {
+        for (auto& task : mCreateReadyPipelineTasksInFlight.IterateUpTo(finishedSerial)) {
+            task->Finish();
+        }
+        mCreateReadyPipelineTasksInFlight.ClearUpTo(finishedSerial);
+    }
+
+    void CreateReadyPipelineTracker::ClearForShutDown() {
+        for (auto& task : mCreateReadyPipelineTasksInFlight.IterateAll()) {
+            task->HandleShutDown();
+        }
+        mCreateReadyPipelineTasksInFlight.Clear();
+    }
+
+}  // namespace dawn_native
@@ -0,0 +1,88 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_CREATEREADYPIPELINETRACKER_H_
+#define DAWNNATIVE_CREATEREADYPIPELINETRACKER_H_
+
+#include "common/SerialQueue.h"
+#include "dawn_native/dawn_platform.h"
+
+#include <memory>
+#include <string>
+
+namespace dawn_native {
+
+    class DeviceBase;
+    class RayTracingPipelineBase;
+    class RenderPipelineBase;
+
+    struct CreateReadyPipelineTaskBase {
+        CreateReadyPipelineTaskBase(std::string errorMessage, void* userdata);
+        virtual ~CreateReadyPipelineTaskBase();
+
+        // Invokes the callback, passing ownership of the pipeline to it.
+        virtual void Finish() = 0;
+
+        // Invokes the callback with DeviceDestroyed when the device is shut down before
+        // the task's serial completed.
+        virtual void HandleShutDown() = 0;
+
+      protected:
+        std::string mErrorMessage;
+        void* mUserData;
+    };
+
+    struct CreateReadyRenderPipelineTask : CreateReadyPipelineTaskBase {
+        CreateReadyRenderPipelineTask(RenderPipelineBase* pipeline,
+                                      std::string errorMessage,
+                                      wgpu::CreateReadyRenderPipelineCallback callback,
+                                      void* userdata);
+        void Finish() override;
+        void HandleShutDown() override;
+
+      private:
+        RenderPipelineBase* mPipeline;
+        wgpu::CreateReadyRenderPipelineCallback mCallback;
+    };
+
+    struct CreateReadyRayTracingPipelineTask : CreateReadyPipelineTaskBase {
+        CreateReadyRayTracingPipelineTask(RayTracingPipelineBase* pipeline,
+                                          std::string errorMessage,
+                                          wgpu::CreateReadyRayTracingPipelineCallback callback,
+                                          void* userdata);
+        void Finish() override;
+        void HandleShutDown() override;
+
+      private:
+        RayTracingPipelineBase* mPipeline;
+        wgpu::CreateReadyRayTracingPipelineCallback mCallback;
+    };
+
+    class CreateReadyPipelineTracker {
+      public:
+        CreateReadyPipelineTracker(DeviceBase* device);
+        ~CreateReadyPipelineTracker();
+
+        void TrackTask(std::unique_ptr<CreateReadyPipelineTaskBase> task, Serial serial);
+        void Tick(Serial finishedSerial);
+        void ClearForShutDown();
+
+      private:
+        DeviceBase* mDevice;
+        SerialQueue<std::unique_ptr<CreateReadyPipelineTaskBase>> mCreateReadyPipelineTasksInFlight;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_CREATEREADYPIPELINETRACKER_H_
@@ -13,8 +13,13 @@
 // limitations under the License.
 
 #include "dawn_native/DawnNative.h"
+#include "dawn_native/Buffer.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/Format.h"
 #include "dawn_native/Instance.h"
+#include "dawn_native/RayTracingAccelerationContainer.h"
+#include "dawn_native/RayTracingShaderBindingTable.h"
+#include "dawn_native/ReadbackRing.h"
 #include "dawn_native/Texture.h"
 #include "dawn_platform/DawnPlatform.h"
 
@@ -34,6 +39,117 @@ namespace dawn_native {
         return deviceBase->GetTogglesUsed();
     }
 
+    bool LoadPipelineCacheData(WGPUDevice device, const void* data, size_t size) {
+        dawn_native::DeviceBase* deviceBase =
+            reinterpret_cast<dawn_native::DeviceBase*>(device);
+        return !deviceBase->ConsumedError(deviceBase->LoadPipelineCacheData(data, size));
+    }
+
+    std::vector<uint8_t> GetPipelineCacheData(WGPUDevice device) {
+        dawn_native::DeviceBase* deviceBase =
+            reinterpret_cast<dawn_native::DeviceBase*>(device);
+        std::vector<uint8_t> result;
+        if (deviceBase->ConsumedError(deviceBase->GetPipelineCacheData(), &result)) {
+            return {};
+        }
+        return result;
+    }
+
+    MemoryBudgetInfo QueryMemoryBudget(WGPUDevice device) {
+        dawn_native::DeviceBase* deviceBase =
+            reinterpret_cast<dawn_native::DeviceBase*>(device);
+        return deviceBase->QueryMemoryBudget();
+    }
+
+    bool WaitForCompletedWork(WGPUDevice device, uint64_t timeoutNanoseconds) {
+        dawn_native::DeviceBase* deviceBase =
+            reinterpret_cast<dawn_native::DeviceBase*>(device);
+        return deviceBase->WaitForCompletedWork(timeoutNanoseconds);
+    }
+
+    void SetMemoryBudgetCallback(WGPUDevice device, MemoryBudgetCallback callback, void* userdata) {
+        dawn_native::DeviceBase* deviceBase =
+            reinterpret_cast<dawn_native::DeviceBase*>(device);
+        deviceBase->SetMemoryBudgetCallback(callback, userdata);
+    }
+
+    bool ReadBufferAsync(WGPUDevice device,
+                         WGPUBuffer buffer,
+                         uint64_t offset,
+                         uint64_t size,
+                         ReadbackCallback callback,
+                         void* userdata) {
+        dawn_native::DeviceBase* deviceBase =
+            reinterpret_cast<dawn_native::DeviceBase*>(device);
+        dawn_native::BufferBase* bufferBase = reinterpret_cast<dawn_native::BufferBase*>(buffer);
+        return !deviceBase->ConsumedError(deviceBase->GetReadbackRing()->ReadBufferAsync(
+            bufferBase, offset, size, callback, userdata));
+    }
+
+    bool FreezeBufferUsage(WGPUDevice device, WGPUBuffer buffer, WGPUBufferUsageFlags usage) {
+        dawn_native::DeviceBase* deviceBase =
+            reinterpret_cast<dawn_native::DeviceBase*>(device);
+        dawn_native::BufferBase* bufferBase = reinterpret_cast<dawn_native::BufferBase*>(buffer);
+        return !deviceBase->ConsumedError(
+            bufferBase->FreezeUsage(static_cast<wgpu::BufferUsage>(usage)));
+    }
+
+    void SetAccelerationContainerBuildBudget(WGPUDevice device, uint64_t maxPrimitivesPerTick) {
+        dawn_native::DeviceBase* deviceBase =
+            reinterpret_cast<dawn_native::DeviceBase*>(device);
+        deviceBase->SetDeferredBuildBudget(maxPrimitivesPerTick);
+    }
+
+    RayTracingMemoryUsage GetRayTracingAccelerationContainerMemoryUsage(
+        WGPURayTracingAccelerationContainer container) {
+        dawn_native::RayTracingAccelerationContainerBase* containerBase =
+            reinterpret_cast<dawn_native::RayTracingAccelerationContainerBase*>(container);
+        return containerBase->GetMemoryUsage();
+    }
+
+    RayTracingMemoryUsage QueryRayTracingMemoryUsage(WGPUDevice device) {
+        dawn_native::DeviceBase* deviceBase =
+            reinterpret_cast<dawn_native::DeviceBase*>(device);
+        return deviceBase->GetRayTracingMemoryUsage();
+    }
+
+    uint32_t GetShaderBindingTableGroupStride(
+        WGPURayTracingShaderBindingTable shaderBindingTable) {
+        dawn_native::RayTracingShaderBindingTableBase* sbt =
+            reinterpret_cast<dawn_native::RayTracingShaderBindingTableBase*>(shaderBindingTable);
+        return sbt->GetGroupStride();
+    }
+
+    uint64_t GetShaderBindingTableGroupOffset(WGPURayTracingShaderBindingTable shaderBindingTable,
+                                              uint32_t groupIndex) {
+        dawn_native::RayTracingShaderBindingTableBase* sbt =
+            reinterpret_cast<dawn_native::RayTracingShaderBindingTableBase*>(shaderBindingTable);
+        return sbt->GetGroupOffset(groupIndex);
+    }
+
+    void CreateShaderModules(WGPUDevice device,
+                             uint32_t count,
+                             const WGPUShaderModuleDescriptor* const* descriptors,
+                             WGPUShaderModule* modules) {
+        dawn_native::DeviceBase* deviceBase =
+            reinterpret_cast<dawn_native::DeviceBase*>(device);
+        deviceBase->CreateShaderModules(
+            count,
+            reinterpret_cast<const dawn_native::ShaderModuleDescriptor* const*>(descriptors),
+            reinterpret_cast<dawn_native::ShaderModuleBase**>(modules));
+    }
+
+    void CreateBindGroups(WGPUDevice device,
+                          uint32_t count,
+                          const WGPUBindGroupDescriptor* const* descriptors,
+                          WGPUBindGroup* bindGroups) {
+        dawn_native::DeviceBase* deviceBase =
+            reinterpret_cast<dawn_native::DeviceBase*>(device);
+        deviceBase->CreateBindGroups(
+            count, reinterpret_cast<const dawn_native::BindGroupDescriptor* const*>(descriptors),
+            reinterpret_cast<dawn_native::BindGroupBase**>(bindGroups));
+    }
+
     // Adapter
 
     Adapter::Adapter() = default;
@@ -98,6 +214,14 @@ namespace dawn_native {
         return mImpl->GetAdapterProperties();
     }
 
+    std::vector<uint8_t> Adapter::GetAccelerationContainerCompatibilityId() const {
+        return mImpl->GetAccelerationContainerCompatibilityId();
+    }
+
+    std::vector<FormatCapabilities> Adapter::GetFormatCapabilities() const {
+        return mImpl->GetFormatCapabilities();
+    }
+
     Adapter::operator bool() const {
         return mImpl != nullptr;
     }
@@ -128,6 +252,10 @@ namespace dawn_native {
         mImpl->DiscoverDefaultAdapters();
     }
 
+    void Instance::DiscoverDefaultAdapters(WGPUBackendType backendType) {
+        mImpl->DiscoverDefaultAdapters(static_cast<wgpu::BackendType>(backendType));
+    }
+
     bool Instance::DiscoverAdapters(const AdapterDiscoveryOptionsBase* options) {
         return mImpl->DiscoverAdapters(options);
     }
@@ -161,6 +289,24 @@ namespace dawn_native {
         return reinterpret_cast<WGPUInstance>(mImpl);
     }
 
+    WGPUTextureFormat GetTextureFormatUploadFallback(WGPUDevice device, WGPUTextureFormat format) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+
+        dawn_native::ResultOrError<const dawn_native::Format*> result =
+            deviceBase->GetInternalFormat(static_cast<wgpu::TextureFormat>(format));
+        if (result.IsError()) {
+            // The format isn't a known format; drop the error instead of losing the device.
+            result.AcquireError();
+            return WGPUTextureFormat_Undefined;
+        }
+
+        const dawn_native::Format* internalFormat = result.AcquireSuccess();
+        if (internalFormat->isSupported) {
+            return format;
+        }
+        return static_cast<WGPUTextureFormat>(internalFormat->fallbackFormat);
+    }
+
     size_t GetLazyClearCountForTesting(WGPUDevice device) {
         dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
         return deviceBase->GetLazyClearCountForTesting();
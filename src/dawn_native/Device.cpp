@@ -14,6 +14,7 @@
 
 #include "dawn_native/Device.h"
 
+#include "common/HashUtils.h"
 #include "common/Log.h"
 #include "dawn_native/Adapter.h"
 #include "dawn_native/AttachmentState.h"
@@ -23,6 +24,7 @@
 #include "dawn_native/CommandBuffer.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/ComputePipeline.h"
+#include "dawn_native/CreateReadyPipelineTracker.h"
 #include "dawn_native/DynamicUploader.h"
 #include "dawn_native/ErrorData.h"
 #include "dawn_native/ErrorScope.h"
@@ -31,9 +33,14 @@
 #include "dawn_native/FenceSignalTracker.h"
 #include "dawn_native/Instance.h"
 #include "dawn_native/MapRequestTracker.h"
+#include "dawn_native/PersistentCache.h"
 #include "dawn_native/PipelineLayout.h"
+#include "dawn_native/QuerySet.h"
 #include "dawn_native/Queue.h"
+#include "dawn_native/QueueWorkDoneTracker.h"
 #include "dawn_native/RayTracingAccelerationContainer.h"
+#include "dawn_native/ReadbackRing.h"
+#include "dawn_native/RayTracingBundleEncoder.h"
 #include "dawn_native/RayTracingPipeline.h"
 #include "dawn_native/RayTracingShaderBindingTable.h"
 #include "dawn_native/RenderBundleEncoder.h"
@@ -44,7 +51,13 @@
 #include "dawn_native/SwapChain.h"
 #include "dawn_native/Texture.h"
 #include "dawn_native/ValidationUtils_autogen.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace dawn_native {
@@ -59,22 +72,55 @@ namespace dawn_native {
 
     struct DeviceBase::Caches {
         ~Caches() {
-            ASSERT(attachmentStates.empty());
             ASSERT(bindGroupLayouts.empty());
             ASSERT(computePipelines.empty());
             ASSERT(pipelineLayouts.empty());
+            ASSERT(defaultPipelineLayouts.empty());
             ASSERT(renderPipelines.empty());
             ASSERT(samplers.empty());
             ASSERT(shaderModules.empty());
         }
 
-        ContentLessObjectCache<AttachmentStateBlueprint> attachmentStates;
         ContentLessObjectCache<BindGroupLayoutBase> bindGroupLayouts;
         ContentLessObjectCache<ComputePipelineBase> computePipelines;
         ContentLessObjectCache<PipelineLayoutBase> pipelineLayouts;
         ContentLessObjectCache<RenderPipelineBase> renderPipelines;
         ContentLessObjectCache<SamplerBase> samplers;
         ContentLessObjectCache<ShaderModuleBase> shaderModules;
+
+        struct SpirvHashFunc {
+            size_t operator()(const std::vector<uint32_t>& spirv) const {
+                size_t hash = 0;
+                for (uint32_t word : spirv) {
+                    HashCombine(&hash, word);
+                }
+                return hash;
+            }
+        };
+        // Keyed by the full SPIR-V code so hash collisions cannot return the wrong
+        // reflection. Entries are plain values and simply dropped with the device.
+        std::unordered_map<std::vector<uint32_t>, ShaderModuleReflection, SpirvHashFunc>
+            spirvReflections;
+
+        struct ModuleListHashFunc {
+            size_t operator()(const std::vector<const ShaderModuleBase*>& modules) const {
+                size_t hash = 0;
+                for (const ShaderModuleBase* module : modules) {
+                    HashCombine(&hash, module);
+                }
+                return hash;
+            }
+        };
+        // Default pipeline layouts derived for pipelines created with layout == nullptr,
+        // keyed by the modules the derivation ran on. Modules are themselves deduplicated
+        // by content, so same-shaped pipelines hit the same entry and skip the
+        // reflection walk. The layout pointers are weak: entries are dropped when the
+        // layout is uncached, and when a module is uncached so a later module reusing its
+        // address cannot alias a stale key.
+        std::unordered_map<std::vector<const ShaderModuleBase*>,
+                           PipelineLayoutBase*,
+                           ModuleListHashFunc>
+            defaultPipelineLayouts;
     };
 
     struct DeviceBase::DeprecationWarnings {
@@ -93,6 +139,10 @@ namespace dawn_native {
 
         mFormatTable = BuildFormatTable(this);
         SetDefaultToggles();
+
+        // The platform must be set on the instance before devices are created for
+        // command block memory to be reported.
+        mCommandBlockPool.SetPlatform(GetPlatform());
     }
 
     DeviceBase::~DeviceBase() {
@@ -100,14 +150,16 @@ namespace dawn_native {
 
     MaybeError DeviceBase::Initialize(QueueBase* defaultQueue) {
         mDefaultQueue = AcquireRef(defaultQueue);
-        mRootErrorScope = AcquireRef(new ErrorScope());
-        mCurrentErrorScope = mRootErrorScope.Get();
 
         mCaches = std::make_unique<DeviceBase::Caches>();
+        mCreateReadyPipelineTracker = std::make_unique<CreateReadyPipelineTracker>(this);
         mErrorScopeTracker = std::make_unique<ErrorScopeTracker>(this);
         mFenceSignalTracker = std::make_unique<FenceSignalTracker>(this);
         mMapRequestTracker = std::make_unique<MapRequestTracker>(this);
+        mPersistentCache = std::make_unique<PersistentCache>(this);
+        mQueueWorkDoneTracker = std::make_unique<QueueWorkDoneTracker>(this);
         mDynamicUploader = std::make_unique<DynamicUploader>(this);
+        mReadbackRing = std::make_unique<ReadbackRing>(this);
         mDeprecationWarnings = std::make_unique<DeprecationWarnings>();
 
         // Starting from now the backend can start doing reentrant calls so the device is marked as
@@ -117,6 +169,115 @@ namespace dawn_native {
         return {};
     }
 
+    bool DeviceBase::DeferDeleteObject(ObjectBase* object) {
+        if (!IsToggleEnabled(Toggle::DeferObjectDestruction) || mState != State::Alive) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mDeferredDeletionMutex);
+        mDeferredDeletions.push_back(object);
+        return true;
+    }
+
+    void DeviceBase::DrainDeferredDeletions() {
+        // Deleting an object can drop the last reference on further objects, which re-enters
+        // DeferDeleteObject, so the list is swapped out before running the deletions.
+        std::vector<ObjectBase*> deletions;
+        {
+            std::lock_guard<std::mutex> lock(mDeferredDeletionMutex);
+            deletions.swap(mDeferredDeletions);
+        }
+        for (ObjectBase* object : deletions) {
+            object->RunDeferredDeletion();
+        }
+    }
+
+    void DeviceBase::EnqueueDeferredContainerBuild(
+        RayTracingAccelerationContainerBase* container) {
+        if (container->IsDeferredBuildPending()) {
+            return;
+        }
+        container->SetDeferredBuildPending(true);
+        if (container->GetPriority() == wgpu::RayTracingAccelerationContainerPriority::High) {
+            mHighPriorityContainerBuilds.emplace_back(container);
+        } else {
+            ASSERT(container->GetPriority() ==
+                   wgpu::RayTracingAccelerationContainerPriority::Background);
+            mBackgroundContainerBuilds.emplace_back(container);
+        }
+    }
+
+    void DeviceBase::SetDeferredBuildBudget(uint64_t maxPrimitivesPerTick) {
+        mDeferredBuildBudget = maxPrimitivesPerTick;
+    }
+
+    void DeviceBase::FlushDeferredContainerBuilds() {
+        if (mHighPriorityContainerBuilds.empty() && mBackgroundContainerBuilds.empty()) {
+            return;
+        }
+
+        // High priority builds always run on the next tick.
+        std::vector<Ref<RayTracingAccelerationContainerBase>> selected;
+        while (!mHighPriorityContainerBuilds.empty()) {
+            selected.push_back(std::move(mHighPriorityContainerBuilds.front()));
+            mHighPriorityContainerBuilds.pop_front();
+        }
+
+        // Background builds are taken in request order until the budget runs out. At
+        // least one is taken per tick so a container larger than the whole budget still
+        // makes progress.
+        uint64_t budget = mDeferredBuildBudget;
+        bool tookBackgroundBuild = false;
+        while (!mBackgroundContainerBuilds.empty()) {
+            uint64_t cost = mBackgroundContainerBuilds.front()->GetBuildCostEstimate();
+            if (tookBackgroundBuild && cost > budget) {
+                break;
+            }
+            budget = cost > budget ? 0 : budget - cost;
+            tookBackgroundBuild = true;
+            selected.push_back(std::move(mBackgroundContainerBuilds.front()));
+            mBackgroundContainerBuilds.pop_front();
+        }
+
+        // Batched builds must not mix levels, and bottom-level containers are built
+        // first so a top-level build deferred together with the bottom-level containers
+        // it references works within one flush.
+        std::vector<RayTracingAccelerationContainerBase*> bottomLevelBuilds;
+        std::vector<RayTracingAccelerationContainerBase*> topLevelBuilds;
+        for (const Ref<RayTracingAccelerationContainerBase>& container : selected) {
+            container->SetDeferredBuildPending(false);
+            if (container->IsBuilt() || container->IsDestroyed()) {
+                continue;
+            }
+            if (container->GetLevel() == wgpu::RayTracingAccelerationContainerLevel::Bottom) {
+                bottomLevelBuilds.push_back(container.Get());
+            } else {
+                topLevelBuilds.push_back(container.Get());
+            }
+        }
+        if (bottomLevelBuilds.empty() && topLevelBuilds.empty()) {
+            return;
+        }
+
+        CommandEncoderDescriptor encoderDescriptor = {};
+        CommandEncoder* encoder = CreateCommandEncoder(&encoderDescriptor);
+        if (!bottomLevelBuilds.empty()) {
+            encoder->BuildRayTracingAccelerationContainers(
+                static_cast<uint32_t>(bottomLevelBuilds.size()), bottomLevelBuilds.data());
+        }
+        if (!topLevelBuilds.empty()) {
+            encoder->BuildRayTracingAccelerationContainers(
+                static_cast<uint32_t>(topLevelBuilds.size()), topLevelBuilds.data());
+        }
+
+        CommandBufferDescriptor commandBufferDescriptor = {};
+        CommandBufferBase* commands = encoder->Finish(&commandBufferDescriptor);
+        encoder->Release();
+
+        GetDefaultQueue()->Submit(1, &commands);
+        commands->Release();
+    }
+
     void DeviceBase::ShutDownBase() {
         // Disconnect the device, depending on which state we are currently in.
         switch (mState) {
@@ -143,25 +304,42 @@ namespace dawn_native {
                 break;
         }
 
+        // Delete objects still queued for deferred destruction, repeating in case a deletion
+        // drops the last reference on further objects.
+        while (!mDeferredDeletions.empty()) {
+            DrainDeferredDeletions();
+        }
+
+        // Deferred container builds that never ran are dropped; the GPU timeline is done.
+        mHighPriorityContainerBuilds.clear();
+        mBackgroundContainerBuilds.clear();
+
         // Skip handling device facilities if they haven't even been created (or failed doing so)
         if (mState != State::BeingCreated) {
             // The GPU timeline is finished so all services can be freed immediately. They need to
             // be freed before ShutDownImpl() because they might relinquish resources that will be
             // freed by backends in the ShutDownImpl() call. Still tick the ones that might have
             // pending callbacks.
+            mCreateReadyPipelineTracker->Tick(GetCompletedCommandSerial());
+            // Callbacks whose serial never completed are invoked with DeviceDestroyed.
+            mCreateReadyPipelineTracker->ClearForShutDown();
             mErrorScopeTracker->Tick(GetCompletedCommandSerial());
             mFenceSignalTracker->Tick(GetCompletedCommandSerial());
             mMapRequestTracker->Tick(GetCompletedCommandSerial());
+            mQueueWorkDoneTracker->Tick(GetCompletedCommandSerial());
+            mReadbackRing->Tick(GetCompletedCommandSerial());
         }
 
         // At this point GPU operations are always finished, so we are in the disconnected state.
         mState = State::Disconnected;
 
+        mCreateReadyPipelineTracker = nullptr;
         mErrorScopeTracker = nullptr;
-        mCurrentErrorScope->UnlinkForShutdown();
         mFenceSignalTracker = nullptr;
         mDynamicUploader = nullptr;
+        mReadbackRing = nullptr;
         mMapRequestTracker = nullptr;
+        mQueueWorkDoneTracker = nullptr;
 
         // Tell the backend that it can free all the objects now that the GPU timeline is empty.
         ShutDownImpl();
@@ -196,7 +374,13 @@ namespace dawn_native {
         }
 
         // Still forward device loss and internal errors to the error scopes so they all reject.
-        mCurrentErrorScope->HandleError(ToWGPUErrorType(type), message);
+        if (!mErrorScopeStack.HandleError(ToWGPUErrorType(type), message)) {
+            // No scope captured the error so it reaches the uncaptured error callback.
+            if (mUncapturedErrorCallback != nullptr) {
+                mUncapturedErrorCallback(static_cast<WGPUErrorType>(ToWGPUErrorType(type)), message,
+                                         mUncapturedErrorUserdata);
+            }
+        }
     }
 
     void DeviceBase::InjectError(wgpu::ErrorType type, const char* message) {
@@ -227,7 +411,8 @@ namespace dawn_native {
     }
 
     void DeviceBase::SetUncapturedErrorCallback(wgpu::ErrorCallback callback, void* userdata) {
-        mRootErrorScope->SetCallback(callback, userdata);
+        mUncapturedErrorCallback = callback;
+        mUncapturedErrorUserdata = userdata;
     }
 
     void DeviceBase::SetDeviceLostCallback(wgpu::DeviceLostCallback callback, void* userdata) {
@@ -239,22 +424,31 @@ namespace dawn_native {
         if (ConsumedError(ValidateErrorFilter(filter))) {
             return;
         }
-        mCurrentErrorScope = AcquireRef(new ErrorScope(filter, mCurrentErrorScope.Get()));
+        mErrorScopeStack.Push(filter);
     }
 
     bool DeviceBase::PopErrorScope(wgpu::ErrorCallback callback, void* userdata) {
-        if (DAWN_UNLIKELY(mCurrentErrorScope.Get() == mRootErrorScope.Get())) {
+        ErrorScopeFrame frame;
+        if (DAWN_UNLIKELY(!mErrorScopeStack.Pop(&frame))) {
             return false;
         }
-        mCurrentErrorScope->SetCallback(callback, userdata);
-        mCurrentErrorScope = Ref<ErrorScope>(mCurrentErrorScope->GetParent());
+        if (frame.lastSubmitSerial <= GetCompletedCommandSerial()) {
+            // Common path: no commands submitted while the scope was open are still in
+            // flight, so the result is delivered right away without touching the heap.
+            callback(static_cast<WGPUErrorType>(frame.errorType), frame.errorMessage.c_str(),
+                     userdata);
+        } else {
+            // Defer delivery until the last submit made while the scope was open completes.
+            Ref<ErrorScope> scope = AcquireRef(new ErrorScope(
+                callback, userdata, frame.errorType, std::move(frame.errorMessage)));
+            mErrorScopeTracker->TrackUntilSerialComplete(scope.Get(), frame.lastSubmitSerial);
+        }
 
         return true;
     }
 
-    ErrorScope* DeviceBase::GetCurrentErrorScope() {
-        ASSERT(mCurrentErrorScope.Get() != nullptr);
-        return mCurrentErrorScope.Get();
+    void DeviceBase::MarkErrorScopesUsedInSubmit() {
+        mErrorScopeStack.OnSubmit(GetLastSubmittedCommandSerial());
     }
 
     MaybeError DeviceBase::ValidateObject(const ObjectBase* object) const {
@@ -312,6 +506,10 @@ namespace dawn_native {
         return mMapRequestTracker.get();
     }
 
+    QueueWorkDoneTracker* DeviceBase::GetQueueWorkDoneTracker() const {
+        return mQueueWorkDoneTracker.get();
+    }
+
     Serial DeviceBase::GetCompletedCommandSerial() const {
         return mCompletedSerial;
     }
@@ -322,6 +520,11 @@ namespace dawn_native {
 
     void DeviceBase::IncrementLastSubmittedCommandSerial() {
         mLastSubmittedSerial++;
+        // Open a GPU work span for this serial; CheckPassedSerials closes it when the
+        // backend reports the commands finished. The timestamps are CPU-observed, so the
+        // span covers submission to observed completion rather than raw GPU execution.
+        TRACE_EVENT_ASYNC_BEGIN0(GetPlatform(), GPUWork, "DeviceBase::GPUWork",
+                                 mLastSubmittedSerial);
     }
 
     void DeviceBase::ArtificiallyIncrementSerials() {
@@ -347,6 +550,9 @@ namespace dawn_native {
         ASSERT(completedSerial >= mCompletedSerial || completedSerial == 0);
 
         if (completedSerial > mCompletedSerial) {
+            for (Serial serial = mCompletedSerial + 1; serial <= completedSerial; ++serial) {
+                TRACE_EVENT_ASYNC_END0(GetPlatform(), GPUWork, "DeviceBase::GPUWork", serial);
+            }
             mCompletedSerial = completedSerial;
         }
     }
@@ -376,12 +582,16 @@ namespace dawn_native {
         const BindGroupLayoutDescriptor* descriptor) {
         BindGroupLayoutBase blueprint(this, descriptor);
 
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+
         auto iter = mCaches->bindGroupLayouts.find(&blueprint);
         if (iter != mCaches->bindGroupLayouts.end()) {
+            DAWN_COUNTER_INCREMENT(GetCounters(), BindGroupLayoutCacheHits);
             (*iter)->Reference();
             return *iter;
         }
 
+        DAWN_COUNTER_INCREMENT(GetCounters(), BindGroupLayoutCacheMisses);
         BindGroupLayoutBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateBindGroupLayoutImpl(descriptor));
         backendObj->SetIsCachedReference();
@@ -389,7 +599,12 @@ namespace dawn_native {
         return backendObj;
     }
 
+    uint64_t DeviceBase::GetNextBindGroupLayoutCompatibilityToken() {
+        return mNextBindGroupLayoutCompatibilityToken.fetch_add(1);
+    }
+
     void DeviceBase::UncacheBindGroupLayout(BindGroupLayoutBase* obj) {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
         ASSERT(obj->IsCachedReference());
         size_t removedCount = mCaches->bindGroupLayouts.erase(obj);
         ASSERT(removedCount == 1);
@@ -399,6 +614,8 @@ namespace dawn_native {
         const ComputePipelineDescriptor* descriptor) {
         ComputePipelineBase blueprint(this, descriptor);
 
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+
         auto iter = mCaches->computePipelines.find(&blueprint);
         if (iter != mCaches->computePipelines.end()) {
             (*iter)->Reference();
@@ -413,6 +630,7 @@ namespace dawn_native {
     }
 
     void DeviceBase::UncacheComputePipeline(ComputePipelineBase* obj) {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
         ASSERT(obj->IsCachedReference());
         size_t removedCount = mCaches->computePipelines.erase(obj);
         ASSERT(removedCount == 1);
@@ -422,6 +640,8 @@ namespace dawn_native {
         const PipelineLayoutDescriptor* descriptor) {
         PipelineLayoutBase blueprint(this, descriptor);
 
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+
         auto iter = mCaches->pipelineLayouts.find(&blueprint);
         if (iter != mCaches->pipelineLayouts.end()) {
             (*iter)->Reference();
@@ -436,15 +656,54 @@ namespace dawn_native {
     }
 
     void DeviceBase::UncachePipelineLayout(PipelineLayoutBase* obj) {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
         ASSERT(obj->IsCachedReference());
         size_t removedCount = mCaches->pipelineLayouts.erase(obj);
         ASSERT(removedCount == 1);
+
+        // Drop any default layout derivations that resolved to this layout.
+        for (auto iter = mCaches->defaultPipelineLayouts.begin();
+             iter != mCaches->defaultPipelineLayouts.end();) {
+            if (iter->second == obj) {
+                iter = mCaches->defaultPipelineLayouts.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+
+    ResultOrError<PipelineLayoutBase*> DeviceBase::GetOrCreateDefaultPipelineLayout(
+        const ShaderModuleBase* const* modules,
+        uint32_t count) {
+        std::vector<const ShaderModuleBase*> key(modules, modules + count);
+
+        {
+            std::lock_guard<std::mutex> lock(mCacheMutex);
+            auto iter = mCaches->defaultPipelineLayouts.find(key);
+            if (iter != mCaches->defaultPipelineLayouts.end()) {
+                iter->second->Reference();
+                return iter->second;
+            }
+        }
+
+        // The derivation runs outside the lock: it takes it again through
+        // GetOrCreateBindGroupLayout and GetOrCreatePipelineLayout.
+        PipelineLayoutBase* layout;
+        DAWN_TRY_ASSIGN(layout, PipelineLayoutBase::CreateDefault(this, modules, count));
+
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        // Losing a race only means both derivations resolved to the same cached layout.
+        auto insertion = mCaches->defaultPipelineLayouts.emplace(std::move(key), layout);
+        ASSERT(insertion.second || insertion.first->second == layout);
+        return layout;
     }
 
     ResultOrError<RenderPipelineBase*> DeviceBase::GetOrCreateRenderPipeline(
         const RenderPipelineDescriptor* descriptor) {
         RenderPipelineBase blueprint(this, descriptor);
 
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+
         auto iter = mCaches->renderPipelines.find(&blueprint);
         if (iter != mCaches->renderPipelines.end()) {
             (*iter)->Reference();
@@ -459,6 +718,7 @@ namespace dawn_native {
     }
 
     void DeviceBase::UncacheRenderPipeline(RenderPipelineBase* obj) {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
         ASSERT(obj->IsCachedReference());
         size_t removedCount = mCaches->renderPipelines.erase(obj);
         ASSERT(removedCount == 1);
@@ -468,6 +728,8 @@ namespace dawn_native {
         const SamplerDescriptor* descriptor) {
         SamplerBase blueprint(this, descriptor);
 
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+
         auto iter = mCaches->samplers.find(&blueprint);
         if (iter != mCaches->samplers.end()) {
             (*iter)->Reference();
@@ -482,6 +744,7 @@ namespace dawn_native {
     }
 
     void DeviceBase::UncacheSampler(SamplerBase* obj) {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
         ASSERT(obj->IsCachedReference());
         size_t removedCount = mCaches->samplers.erase(obj);
         ASSERT(removedCount == 1);
@@ -491,36 +754,75 @@ namespace dawn_native {
         const ShaderModuleDescriptor* descriptor) {
         ShaderModuleBase blueprint(this, descriptor);
 
+        {
+            std::lock_guard<std::mutex> lock(mCacheMutex);
+            auto iter = mCaches->shaderModules.find(&blueprint);
+            if (iter != mCaches->shaderModules.end()) {
+                (*iter)->Reference();
+                return *iter;
+            }
+        }
+
+        // Compile without holding the cache lock so that several shader modules can be
+        // created concurrently, see CreateShaderModules.
+        ShaderModuleBase* backendObj;
+        DAWN_TRY_ASSIGN(backendObj, CreateShaderModuleImpl(descriptor));
+
+        std::lock_guard<std::mutex> lock(mCacheMutex);
         auto iter = mCaches->shaderModules.find(&blueprint);
         if (iter != mCaches->shaderModules.end()) {
+            // Another thread cached an equal module while this one compiled; discard ours.
             (*iter)->Reference();
+            backendObj->Release();
             return *iter;
         }
-
-        ShaderModuleBase* backendObj;
-        DAWN_TRY_ASSIGN(backendObj, CreateShaderModuleImpl(descriptor));
         backendObj->SetIsCachedReference();
         mCaches->shaderModules.insert(backendObj);
         return backendObj;
     }
 
     void DeviceBase::UncacheShaderModule(ShaderModuleBase* obj) {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
         ASSERT(obj->IsCachedReference());
         size_t removedCount = mCaches->shaderModules.erase(obj);
         ASSERT(removedCount == 1);
+
+        // Default layout derivations are keyed by module pointers; drop the ones that
+        // mention this module so a later module at the same address cannot match them.
+        for (auto iter = mCaches->defaultPipelineLayouts.begin();
+             iter != mCaches->defaultPipelineLayouts.end();) {
+            if (std::find(iter->first.begin(), iter->first.end(), obj) != iter->first.end()) {
+                iter = mCaches->defaultPipelineLayouts.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
     }
 
-    Ref<AttachmentState> DeviceBase::GetOrCreateAttachmentState(
-        AttachmentStateBlueprint* blueprint) {
-        auto iter = mCaches->attachmentStates.find(blueprint);
-        if (iter != mCaches->attachmentStates.end()) {
-            return static_cast<AttachmentState*>(*iter);
+    const ShaderModuleReflection* DeviceBase::FindCachedSpirvReflection(
+        const std::vector<uint32_t>& spirv) const {
+        // The returned pointer stays valid across later insertions because unordered_map
+        // never moves its values.
+        std::lock_guard<std::mutex> lock(mSpirvReflectionCacheMutex);
+        auto iter = mCaches->spirvReflections.find(spirv);
+        if (iter == mCaches->spirvReflections.end()) {
+            return nullptr;
         }
+        return &iter->second;
+    }
 
-        Ref<AttachmentState> attachmentState = AcquireRef(new AttachmentState(this, *blueprint));
-        attachmentState->SetIsCachedReference();
-        mCaches->attachmentStates.insert(attachmentState.Get());
-        return attachmentState;
+    void DeviceBase::CacheSpirvReflection(const std::vector<uint32_t>& spirv,
+                                          const ShaderModuleReflection& reflection) {
+        // emplace is a no-op when two threads extracted the same SPIR-V concurrently.
+        std::lock_guard<std::mutex> lock(mSpirvReflectionCacheMutex);
+        mCaches->spirvReflections.emplace(spirv, reflection);
+    }
+
+    Ref<AttachmentState> DeviceBase::GetOrCreateAttachmentState(
+        AttachmentStateBlueprint* blueprint) {
+        // AttachmentStates are pure frontend state so they are deduplicated on the instance,
+        // letting sibling devices share a single cache. See InstanceBase.
+        return GetAdapter()->GetInstance()->GetOrCreateAttachmentState(blueprint, this);
     }
 
     Ref<AttachmentState> DeviceBase::GetOrCreateAttachmentState(
@@ -541,12 +843,6 @@ namespace dawn_native {
         return GetOrCreateAttachmentState(&blueprint);
     }
 
-    void DeviceBase::UncacheAttachmentState(AttachmentState* obj) {
-        ASSERT(obj->IsCachedReference());
-        size_t removedCount = mCaches->attachmentStates.erase(obj);
-        ASSERT(removedCount == 1);
-    }
-
     // Object creation API methods
     RayTracingAccelerationContainerBase* DeviceBase::CreateRayTracingAccelerationContainer(
         const RayTracingAccelerationContainerDescriptor* descriptor) {
@@ -580,6 +876,57 @@ namespace dawn_native {
 
         return result;
     }
+    RayTracingBundleEncoder* DeviceBase::CreateRayTracingBundleEncoder(
+        const RayTracingBundleEncoderDescriptor* descriptor) {
+        RayTracingBundleEncoder* result = nullptr;
+
+        if (ConsumedError(CreateRayTracingBundleEncoderInternal(&result, descriptor))) {
+            return RayTracingBundleEncoder::MakeError(this);
+        }
+
+        return result;
+    }
+
+    void DeviceBase::CreateReadyRayTracingPipeline(
+        const RayTracingPipelineDescriptor* descriptor,
+        wgpu::CreateReadyRayTracingPipelineCallback callback,
+        void* userdata) {
+        // The pipeline is still created on the calling thread; deferring the callback to
+        // the next Tick keeps the callback asynchronous so callers never re-enter Dawn
+        // from inside a create call. Moving the compile itself to worker threads needs
+        // thread-safe backends and can happen behind this API without changing it.
+        RayTracingPipelineBase* result = nullptr;
+        std::string errorMessage;
+
+        MaybeError maybeError = CreateRayTracingPipelineInternal(&result, descriptor);
+        if (maybeError.IsError()) {
+            std::unique_ptr<ErrorData> error = maybeError.AcquireError();
+            errorMessage = error->GetMessage();
+        }
+
+        std::unique_ptr<CreateReadyRayTracingPipelineTask> task =
+            std::make_unique<CreateReadyRayTracingPipelineTask>(result, errorMessage, callback,
+                                                                userdata);
+        mCreateReadyPipelineTracker->TrackTask(std::move(task), GetPendingCommandSerial());
+    }
+
+    void DeviceBase::CreateReadyRenderPipeline(const RenderPipelineDescriptor* descriptor,
+                                               wgpu::CreateReadyRenderPipelineCallback callback,
+                                               void* userdata) {
+        RenderPipelineBase* result = nullptr;
+        std::string errorMessage;
+
+        MaybeError maybeError = CreateRenderPipelineInternal(&result, descriptor);
+        if (maybeError.IsError()) {
+            std::unique_ptr<ErrorData> error = maybeError.AcquireError();
+            errorMessage = error->GetMessage();
+        }
+
+        std::unique_ptr<CreateReadyRenderPipelineTask> task =
+            std::make_unique<CreateReadyRenderPipelineTask>(result, errorMessage, callback,
+                                                            userdata);
+        mCreateReadyPipelineTracker->TrackTask(std::move(task), GetPendingCommandSerial());
+    }
 
     BindGroupBase* DeviceBase::CreateBindGroup(const BindGroupDescriptor* descriptor) {
         BindGroupBase* result = nullptr;
@@ -590,6 +937,33 @@ namespace dawn_native {
 
         return result;
     }
+    void DeviceBase::CreateBindGroups(uint32_t count,
+                                      const BindGroupDescriptor* const* descriptors,
+                                      BindGroupBase** bindGroups) {
+        // One liveness check covers the batch. Descriptor validation still runs per
+        // element because each bind group binds different resources. Creation stays on
+        // the API thread: unlike shader module compilation, backend descriptor
+        // allocation is cheap and not thread-safe on every backend.
+        if (ConsumedError(ValidateIsAlive())) {
+            for (uint32_t i = 0; i < count; ++i) {
+                bindGroups[i] = BindGroupBase::MakeError(this);
+            }
+            return;
+        }
+
+        for (uint32_t i = 0; i < count; ++i) {
+            if (IsValidationEnabled() &&
+                ConsumedError(ValidateBindGroupDescriptor(this, descriptors[i]))) {
+                bindGroups[i] = BindGroupBase::MakeError(this);
+                continue;
+            }
+            BindGroupBase* bindGroup = nullptr;
+            if (ConsumedError(CreateBindGroupImpl(descriptors[i]), &bindGroup)) {
+                bindGroup = BindGroupBase::MakeError(this);
+            }
+            bindGroups[i] = bindGroup;
+        }
+    }
     BindGroupLayoutBase* DeviceBase::CreateBindGroupLayout(
         const BindGroupLayoutDescriptor* descriptor) {
         BindGroupLayoutBase* result = nullptr;
@@ -664,11 +1038,23 @@ namespace dawn_native {
 
         return result;
     }
-    QueueBase* DeviceBase::CreateQueue() {
-        // TODO(dawn:22): Remove this once users use GetDefaultQueue
-        EmitDeprecationWarning(
-            "Device::CreateQueue is deprecated, use Device::GetDefaultQueue instead");
-        return GetDefaultQueue();
+    QuerySetBase* DeviceBase::CreateQuerySet(const QuerySetDescriptor* descriptor) {
+        QuerySetBase* result = nullptr;
+
+        if (ConsumedError(CreateQuerySetInternal(&result, descriptor))) {
+            return QuerySetBase::MakeError(this);
+        }
+
+        return result;
+    }
+    QueueBase* DeviceBase::CreateQueue(const QueueDescriptor* descriptor) {
+        QueueBase* result = nullptr;
+
+        if (ConsumedError(CreateQueueInternal(&result, descriptor))) {
+            return QueueBase::MakeError(this);
+        }
+
+        return result;
     }
     SamplerBase* DeviceBase::CreateSampler(const SamplerDescriptor* descriptor) {
         SamplerBase* result = nullptr;
@@ -708,6 +1094,51 @@ namespace dawn_native {
 
         return result;
     }
+    void DeviceBase::CreateShaderModules(uint32_t count,
+                                         const ShaderModuleDescriptor* const* descriptors,
+                                         ShaderModuleBase** modules) {
+        uint32_t threadCount = std::min(count, std::thread::hardware_concurrency());
+        if (threadCount <= 1) {
+            for (uint32_t i = 0; i < count; ++i) {
+                modules[i] = CreateShaderModule(descriptors[i]);
+            }
+            return;
+        }
+
+        // Validation and compilation run on the workers; error handling must stay on the
+        // API thread so errors are collected per module and consumed after the join.
+        std::vector<MaybeError> errors(count);
+        std::atomic<uint32_t> nextIndex(0);
+        auto work = [&] {
+            uint32_t i;
+            while ((i = nextIndex.fetch_add(1)) < count) {
+                ShaderModuleBase* module = nullptr;
+                MaybeError result = CreateShaderModuleInternal(&module, descriptors[i]);
+                if (result.IsError()) {
+                    errors[i] = std::move(result);
+                    module = nullptr;
+                }
+                modules[i] = module;
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount - 1);
+        for (uint32_t i = 0; i < threadCount - 1; ++i) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        for (uint32_t i = 0; i < count; ++i) {
+            if (errors[i].IsError()) {
+                ConsumedError(std::move(errors[i]));
+                modules[i] = ShaderModuleBase::MakeError(this);
+            }
+        }
+    }
     SwapChainBase* DeviceBase::CreateSwapChain(Surface* surface,
                                                const SwapChainDescriptor* descriptor) {
         SwapChainBase* result = nullptr;
@@ -744,6 +1175,15 @@ namespace dawn_native {
         if (ConsumedError(ValidateIsAlive())) {
             return;
         }
+
+        // Run deferred object destruction before ticking the backend so that backend
+        // resources released by the deleted objects are reclaimed in the same tick.
+        DrainDeferredDeletions();
+
+        // Submit this tick's share of deferred acceleration container builds before
+        // ticking the backend so the build work is in flight as early as possible.
+        FlushDeferredContainerBuilds();
+
         if (ConsumedError(TickImpl())) {
             return;
         }
@@ -752,9 +1192,12 @@ namespace dawn_native {
         // tick the dynamic uploader before the backend resource allocators. This would allow
         // reclaiming resources one tick earlier.
         mDynamicUploader->Deallocate(GetCompletedCommandSerial());
+        mCreateReadyPipelineTracker->Tick(GetCompletedCommandSerial());
         mErrorScopeTracker->Tick(GetCompletedCommandSerial());
         mFenceSignalTracker->Tick(GetCompletedCommandSerial());
         mMapRequestTracker->Tick(GetCompletedCommandSerial());
+        mQueueWorkDoneTracker->Tick(GetCompletedCommandSerial());
+        mReadbackRing->Tick(GetCompletedCommandSerial());
     }
 
     void DeviceBase::Reference() {
@@ -785,18 +1228,15 @@ namespace dawn_native {
 
         mEnabledExtensions = GetAdapter()->GetInstance()->ExtensionNamesToExtensionsSet(
             deviceDescriptor->requiredExtensions);
+        UpdateCapabilitySnapshot();
     }
 
     std::vector<const char*> DeviceBase::GetEnabledExtensions() const {
         return mEnabledExtensions.GetEnabledExtensionNames();
     }
 
-    bool DeviceBase::IsExtensionEnabled(Extension extension) const {
-        return mEnabledExtensions.IsEnabled(extension);
-    }
-
-    bool DeviceBase::IsValidationEnabled() const {
-        return !IsToggleEnabled(Toggle::SkipValidation);
+    const ExtensionsSet& DeviceBase::GetEnabledExtensionsSet() const {
+        return mEnabledExtensions;
     }
 
     size_t DeviceBase::GetLazyClearCountForTesting() {
@@ -818,6 +1258,29 @@ namespace dawn_native {
         }
     }
 
+    void DeviceBase::TrackMemoryAllocation(AllocationClass allocationClass, uint64_t size) {
+        MemoryClassStats& stats = mMemoryStats.classStats[static_cast<uint32_t>(allocationClass)];
+        stats.liveSize += size;
+        stats.liveAllocationCount++;
+        stats.peakSize = std::max(stats.peakSize, stats.liveSize);
+    }
+
+    void DeviceBase::TrackMemoryDeallocation(AllocationClass allocationClass, uint64_t size) {
+        MemoryClassStats& stats = mMemoryStats.classStats[static_cast<uint32_t>(allocationClass)];
+        ASSERT(stats.liveSize >= size);
+        ASSERT(stats.liveAllocationCount > 0);
+        stats.liveSize -= size;
+        stats.liveAllocationCount--;
+    }
+
+    const MemoryStats& DeviceBase::GetMemoryStats() const {
+        return mMemoryStats;
+    }
+
+    CounterRegistry* DeviceBase::GetCounters() {
+        return &mCounters;
+    }
+
     // Implementation details of object creation
     MaybeError DeviceBase::CreateBindGroupInternal(BindGroupBase** result,
                                                    const BindGroupDescriptor* descriptor) {
@@ -862,7 +1325,7 @@ namespace dawn_native {
 
             DAWN_TRY_ASSIGN(
                 descriptorWithDefaultLayout.layout,
-                PipelineLayoutBase::CreateDefault(this, &descriptor->computeStage.module, 1));
+                GetOrCreateDefaultPipelineLayout(&descriptor->computeStage.module, 1));
             // Ref will keep the pipeline layout alive until the end of the function where
             // the pipeline will take another reference.
             Ref<PipelineLayoutBase> layoutRef = AcquireRef(descriptorWithDefaultLayout.layout);
@@ -874,6 +1337,16 @@ namespace dawn_native {
         return {};
     }
 
+    MaybeError DeviceBase::CreateQuerySetInternal(QuerySetBase** result,
+                                                  const QuerySetDescriptor* descriptor) {
+        DAWN_TRY(ValidateIsAlive());
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateQuerySetDescriptor(this, descriptor));
+        }
+        DAWN_TRY_ASSIGN(*result, CreateQuerySetImpl(descriptor));
+        return {};
+    }
+
     MaybeError DeviceBase::CreatePipelineLayoutInternal(
         PipelineLayoutBase** result,
         const PipelineLayoutDescriptor* descriptor) {
@@ -915,6 +1388,17 @@ namespace dawn_native {
         return {};
     }
 
+    MaybeError DeviceBase::CreateRayTracingBundleEncoderInternal(
+        RayTracingBundleEncoder** result,
+        const RayTracingBundleEncoderDescriptor* descriptor) {
+        DAWN_TRY(ValidateIsAlive());
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateRayTracingBundleEncoderDescriptor(this, descriptor));
+        }
+        *result = new RayTracingBundleEncoder(this, descriptor);
+        return {};
+    }
+
     MaybeError DeviceBase::CreateRenderBundleEncoderInternal(
         RenderBundleEncoder** result,
         const RenderBundleEncoderDescriptor* descriptor) {
@@ -948,7 +1432,7 @@ namespace dawn_native {
             }
 
             DAWN_TRY_ASSIGN(descriptorWithDefaultLayout.layout,
-                            PipelineLayoutBase::CreateDefault(this, modules, count));
+                            GetOrCreateDefaultPipelineLayout(modules, count));
             // Ref will keep the pipeline layout alive until the end of the function where
             // the pipeline will take another reference.
             Ref<PipelineLayoutBase> layoutRef = AcquireRef(descriptorWithDefaultLayout.layout);
@@ -960,6 +1444,23 @@ namespace dawn_native {
         return {};
     }
 
+    MaybeError DeviceBase::CreateQueueInternal(QueueBase** result,
+                                               const QueueDescriptor* descriptor) {
+        DAWN_TRY(ValidateIsAlive());
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateQueueDescriptor(this, descriptor));
+        }
+        DAWN_TRY_ASSIGN(*result, CreateQueueImpl(descriptor));
+        return {};
+    }
+
+    ResultOrError<QueueBase*> DeviceBase::CreateQueueImpl(const QueueDescriptor*) {
+        // Backends without additional hardware queues hand out the default queue; the queue
+        // type is a scheduling hint so sharing the general queue is always correct.
+        mDefaultQueue->Reference();
+        return mDefaultQueue.Get();
+    }
+
     MaybeError DeviceBase::CreateSamplerInternal(SamplerBase** result,
                                                  const SamplerDescriptor* descriptor) {
         DAWN_TRY(ValidateIsAlive());
@@ -995,8 +1496,14 @@ namespace dawn_native {
 
             NewSwapChainBase* previousSwapChain = surface->GetAttachedSwapChain();
             NewSwapChainBase* newSwapChain;
-            DAWN_TRY_ASSIGN(newSwapChain,
-                            CreateSwapChainImpl(surface, previousSwapChain, descriptor));
+            if (surface->GetType() == Surface::Type::Headless) {
+                // Headless surfaces aren't backed by any windowing system; the frontend
+                // provides their swapchain so every backend supports them.
+                newSwapChain = new HeadlessSwapChain(this, surface, previousSwapChain, descriptor);
+            } else {
+                DAWN_TRY_ASSIGN(newSwapChain,
+                                CreateSwapChainImpl(surface, previousSwapChain, descriptor));
+            }
 
             if (previousSwapChain != nullptr) {
                 ASSERT(!previousSwapChain->IsAttached());
@@ -1027,29 +1534,167 @@ namespace dawn_native {
         if (IsValidationEnabled()) {
             DAWN_TRY(ValidateTextureViewDescriptor(texture, &desc));
         }
+        // Identical descriptors alias the same subresources, so hand out a reference to the
+        // existing view instead of multiplying backend view objects.
+        TextureViewBase* cachedView = texture->GetCachedView(&desc);
+        if (cachedView != nullptr) {
+            cachedView->Reference();
+            *result = cachedView;
+            return {};
+        }
         DAWN_TRY_ASSIGN(*result, CreateTextureViewImpl(texture, &desc));
+        texture->CacheView(*result, &desc);
         return {};
     }
 
     // Other implementation details
 
+    MaybeError DeviceBase::CopyFromStagingToTexture(StagingBufferBase* source,
+                                                    uint64_t sourceOffset,
+                                                    uint32_t bytesPerRow,
+                                                    uint32_t rowsPerImage,
+                                                    const TextureCopy& dst,
+                                                    const Extent3D& copySizePixels) {
+        return DAWN_UNIMPLEMENTED_ERROR("Device unable to copy from staging buffer to texture.");
+    }
+
     DynamicUploader* DeviceBase::GetDynamicUploader() const {
         return mDynamicUploader.get();
     }
 
+    ReadbackRing* DeviceBase::GetReadbackRing() const {
+        return mReadbackRing.get();
+    }
+
+    CommandBlockPool* DeviceBase::GetCommandBlockPool() {
+        return &mCommandBlockPool;
+    }
+
     // The Toggle device facility
 
+    MaybeError DeviceBase::LoadPipelineCacheData(const void* data, size_t size) {
+        DAWN_TRY(ValidateIsAlive());
+        if (data == nullptr || size == 0) {
+            return DAWN_VALIDATION_ERROR("Pipeline cache data cannot be empty");
+        }
+        return LoadPipelineCacheDataImpl(data, size);
+    }
+
+    ResultOrError<std::vector<uint8_t>> DeviceBase::GetPipelineCacheData() {
+        DAWN_TRY(ValidateIsAlive());
+        return GetPipelineCacheDataImpl();
+    }
+
+    MaybeError DeviceBase::LoadPipelineCacheDataImpl(const void* data, size_t size) {
+        return {};
+    }
+
+    ResultOrError<std::vector<uint8_t>> DeviceBase::GetPipelineCacheDataImpl() {
+        return std::vector<uint8_t>();
+    }
+
+    PersistentCache* DeviceBase::GetPersistentCache() {
+        ASSERT(mPersistentCache != nullptr);
+        return mPersistentCache.get();
+    }
+
+    MemoryBudgetInfo DeviceBase::QueryMemoryBudget() {
+        return QueryMemoryBudgetImpl();
+    }
+
+    void DeviceBase::SetMemoryBudgetCallback(MemoryBudgetCallback callback, void* userdata) {
+        mMemoryBudgetCallback = callback;
+        mMemoryBudgetUserdata = userdata;
+        mMemoryBudgetWarningActive = false;
+    }
+
+    void DeviceBase::CheckMemoryBudgetPressure() {
+        if (mMemoryBudgetCallback == nullptr) {
+            return;
+        }
+
+        MemoryBudgetInfo info = QueryMemoryBudgetImpl();
+        if (info.budget == 0) {
+            return;
+        }
+
+        // Warn when usage approaches the budget, but only on the crossing so a streaming
+        // system under sustained pressure isn't called back on every allocation.
+        static constexpr float kMemoryBudgetWarningRatio = 0.9f;
+        bool aboveWarningThreshold = info.usage >= info.budget * kMemoryBudgetWarningRatio;
+        if (aboveWarningThreshold && !mMemoryBudgetWarningActive) {
+            mMemoryBudgetCallback(info, mMemoryBudgetUserdata);
+        }
+        mMemoryBudgetWarningActive = aboveWarningThreshold;
+    }
+
+    MemoryBudgetInfo DeviceBase::QueryMemoryBudgetImpl() {
+        return {};
+    }
+
+    void DeviceBase::IncreaseRayTracingMemoryUsage(const RayTracingMemoryUsage& usage) {
+        mRayTracingMemoryUsage.resultSize += usage.resultSize;
+        mRayTracingMemoryUsage.buildScratchSize += usage.buildScratchSize;
+        mRayTracingMemoryUsage.updateScratchSize += usage.updateScratchSize;
+    }
+
+    void DeviceBase::DecreaseRayTracingMemoryUsage(const RayTracingMemoryUsage& usage) {
+        ASSERT(mRayTracingMemoryUsage.resultSize >= usage.resultSize);
+        ASSERT(mRayTracingMemoryUsage.buildScratchSize >= usage.buildScratchSize);
+        ASSERT(mRayTracingMemoryUsage.updateScratchSize >= usage.updateScratchSize);
+        mRayTracingMemoryUsage.resultSize -= usage.resultSize;
+        mRayTracingMemoryUsage.buildScratchSize -= usage.buildScratchSize;
+        mRayTracingMemoryUsage.updateScratchSize -= usage.updateScratchSize;
+    }
+
+    RayTracingMemoryUsage DeviceBase::GetRayTracingMemoryUsage() const {
+        return mRayTracingMemoryUsage;
+    }
+
+    bool DeviceBase::WaitForCompletedWork(uint64_t timeoutNanoseconds) {
+        if (ConsumedError(ValidateIsAlive())) {
+            return false;
+        }
+        // Nothing in flight: no completion to wait for, the caller shouldn't Tick.
+        if (mCompletedSerial >= mLastSubmittedSerial) {
+            return false;
+        }
+        return WaitForCompletedWorkImpl(timeoutNanoseconds);
+    }
+
+    bool DeviceBase::WaitForCompletedWorkImpl(uint64_t) {
+        return true;
+    }
+
     std::vector<const char*> DeviceBase::GetTogglesUsed() const {
         return mEnabledToggles.GetContainedToggleNames();
     }
 
-    bool DeviceBase::IsToggleEnabled(Toggle toggle) const {
-        return mEnabledToggles.Has(toggle);
+    void DeviceBase::UpdateCapabilitySnapshot() {
+        static_assert(static_cast<size_t>(Toggle::EnumCount) <= 64,
+                      "Toggles no longer fit in the capability snapshot");
+        static_assert(static_cast<size_t>(Extension::EnumCount) <= 64,
+                      "Extensions no longer fit in the capability snapshot");
+
+        mCapabilities.toggleBits = 0;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(Toggle::EnumCount); ++i) {
+            if (mEnabledToggles.Has(static_cast<Toggle>(i))) {
+                mCapabilities.toggleBits |= uint64_t(1) << i;
+            }
+        }
+        mCapabilities.extensionBits = 0;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(Extension::EnumCount); ++i) {
+            if (mEnabledExtensions.IsEnabled(static_cast<Extension>(i))) {
+                mCapabilities.extensionBits |= uint64_t(1) << i;
+            }
+        }
+        mCapabilities.validationEnabled = !mEnabledToggles.Has(Toggle::SkipValidation);
     }
 
     void DeviceBase::SetToggle(Toggle toggle, bool isEnabled) {
         if (!mOverridenToggles.Has(toggle)) {
             mEnabledToggles.Set(toggle, isEnabled);
+            UpdateCapabilitySnapshot();
         }
     }
 
@@ -1059,6 +1704,7 @@ namespace dawn_native {
                                << isEnabled << "when it was overriden to be " << !isEnabled;
         }
         mEnabledToggles.Set(toggle, isEnabled);
+        UpdateCapabilitySnapshot();
     }
 
     void DeviceBase::SetDefaultToggles() {
@@ -1083,6 +1729,7 @@ namespace dawn_native {
                 mOverridenToggles.Set(toggle, true);
             }
         }
+        UpdateCapabilitySnapshot();
     }
 
 }  // namespace dawn_native
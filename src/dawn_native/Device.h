@@ -15,30 +15,43 @@
 #ifndef DAWNNATIVE_DEVICE_H_
 #define DAWNNATIVE_DEVICE_H_
 
+#include "common/Counters.h"
 #include "common/Serial.h"
+#include "dawn_native/CommandAllocator.h"
 #include "dawn_native/Error.h"
+#include "dawn_native/ErrorScope.h"
 #include "dawn_native/Extensions.h"
 #include "dawn_native/Format.h"
 #include "dawn_native/Forward.h"
+#include "dawn_native/MemoryStats.h"
 #include "dawn_native/ObjectBase.h"
 #include "dawn_native/Toggles.h"
 
 #include "dawn_native/DawnNative.h"
 #include "dawn_native/dawn_platform.h"
 
+#include <atomic>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace dawn_native {
     class AdapterBase;
     class AttachmentState;
     class AttachmentStateBlueprint;
     class BindGroupLayoutBase;
+    class CreateReadyPipelineTracker;
     class DynamicUploader;
-    class ErrorScope;
     class ErrorScopeTracker;
     class FenceSignalTracker;
     class MapRequestTracker;
+    class PersistentCache;
+    class QueueWorkDoneTracker;
+    class ReadbackRing;
     class StagingBufferBase;
+    struct ShaderModuleReflection;
+    struct TextureCopy;
 
     class DeviceBase {
       public:
@@ -73,6 +86,7 @@ namespace dawn_native {
         ErrorScopeTracker* GetErrorScopeTracker() const;
         FenceSignalTracker* GetFenceSignalTracker() const;
         MapRequestTracker* GetMapRequestTracker() const;
+        QueueWorkDoneTracker* GetQueueWorkDoneTracker() const;
 
         // Returns the Format corresponding to the wgpu::TextureFormat or an error if the format
         // isn't a valid wgpu::TextureFormat or isn't supported by this device.
@@ -107,10 +121,20 @@ namespace dawn_native {
         // the created object will be, the "blueprint". The blueprint is just a FooBase object
         // instead of a backend Foo object. If the blueprint doesn't match an object in the
         // cache, then the descriptor is used to make a new object.
+        //
+        // The caches are guarded by a mutex so that objects may be created from multiple
+        // threads. Command encoders each own their CommandAllocator and buffer errors until
+        // Finish(), so independent encoders can record concurrently as long as the error
+        // callbacks are externally synchronized.
         ResultOrError<BindGroupLayoutBase*> GetOrCreateBindGroupLayout(
             const BindGroupLayoutDescriptor* descriptor);
         void UncacheBindGroupLayout(BindGroupLayoutBase* obj);
 
+        // Hands out the compatibility tokens carried by bind group layouts; see
+        // BindGroupLayoutBase::GetCompatibilityToken. Atomic because layouts may be
+        // created from multiple threads.
+        uint64_t GetNextBindGroupLayoutCompatibilityToken();
+
         ResultOrError<ComputePipelineBase*> GetOrCreateComputePipeline(
             const ComputePipelineDescriptor* descriptor);
         void UncacheComputePipeline(ComputePipelineBase* obj);
@@ -119,6 +143,13 @@ namespace dawn_native {
             const PipelineLayoutDescriptor* descriptor);
         void UncachePipelineLayout(PipelineLayoutBase* obj);
 
+        // Returns the default pipeline layout derived from |modules|, reusing a previous
+        // derivation when the same modules were already seen; see
+        // PipelineLayoutBase::CreateDefault.
+        ResultOrError<PipelineLayoutBase*> GetOrCreateDefaultPipelineLayout(
+            const ShaderModuleBase* const* modules,
+            uint32_t count);
+
         ResultOrError<RenderPipelineBase*> GetOrCreateRenderPipeline(
             const RenderPipelineDescriptor* descriptor);
         void UncacheRenderPipeline(RenderPipelineBase* obj);
@@ -130,12 +161,21 @@ namespace dawn_native {
             const ShaderModuleDescriptor* descriptor);
         void UncacheShaderModule(ShaderModuleBase* obj);
 
+        // SPIR-V reflection cache, keyed by the SPIR-V code. Unlike the shader module cache
+        // above, entries survive the modules they were extracted from so reloading a
+        // byte-identical module skips the spirv-cross parse. The cache has its own lock so
+        // shader modules can be compiled concurrently; returned pointers stay valid because
+        // entries are node-allocated and never erased.
+        const ShaderModuleReflection* FindCachedSpirvReflection(
+            const std::vector<uint32_t>& spirv) const;
+        void CacheSpirvReflection(const std::vector<uint32_t>& spirv,
+                                  const ShaderModuleReflection& reflection);
+
         Ref<AttachmentState> GetOrCreateAttachmentState(AttachmentStateBlueprint* blueprint);
         Ref<AttachmentState> GetOrCreateAttachmentState(
             const RenderBundleEncoderDescriptor* descriptor);
         Ref<AttachmentState> GetOrCreateAttachmentState(const RenderPipelineDescriptor* descriptor);
         Ref<AttachmentState> GetOrCreateAttachmentState(const RenderPassDescriptor* descriptor);
-        void UncacheAttachmentState(AttachmentState* obj);
 
         // Dawn API
         RayTracingAccelerationContainerBase* CreateRayTracingAccelerationContainer(
@@ -144,19 +184,40 @@ namespace dawn_native {
             const RayTracingShaderBindingTableDescriptor* descriptor);
         RayTracingPipelineBase* CreateRayTracingPipeline(
             const RayTracingPipelineDescriptor* descriptor);
+        RayTracingBundleEncoder* CreateRayTracingBundleEncoder(
+            const RayTracingBundleEncoderDescriptor* descriptor);
+        void CreateReadyRayTracingPipeline(const RayTracingPipelineDescriptor* descriptor,
+                                           wgpu::CreateReadyRayTracingPipelineCallback callback,
+                                           void* userdata);
+        void CreateReadyRenderPipeline(const RenderPipelineDescriptor* descriptor,
+                                       wgpu::CreateReadyRenderPipelineCallback callback,
+                                       void* userdata);
         BindGroupBase* CreateBindGroup(const BindGroupDescriptor* descriptor);
+        // Batch version of CreateBindGroup that amortizes the per-call overhead over the
+        // whole array. Failed entries come back as error bind groups and their errors are
+        // reported in index order.
+        void CreateBindGroups(uint32_t count,
+                              const BindGroupDescriptor* const* descriptors,
+                              BindGroupBase** bindGroups);
         BindGroupLayoutBase* CreateBindGroupLayout(const BindGroupLayoutDescriptor* descriptor);
         BufferBase* CreateBuffer(const BufferDescriptor* descriptor);
         WGPUCreateBufferMappedResult CreateBufferMapped(const BufferDescriptor* descriptor);
         CommandEncoder* CreateCommandEncoder(const CommandEncoderDescriptor* descriptor);
         ComputePipelineBase* CreateComputePipeline(const ComputePipelineDescriptor* descriptor);
         PipelineLayoutBase* CreatePipelineLayout(const PipelineLayoutDescriptor* descriptor);
-        QueueBase* CreateQueue();
+        QuerySetBase* CreateQuerySet(const QuerySetDescriptor* descriptor);
+        QueueBase* CreateQueue(const QueueDescriptor* descriptor);
         RenderBundleEncoder* CreateRenderBundleEncoder(
             const RenderBundleEncoderDescriptor* descriptor);
         RenderPipelineBase* CreateRenderPipeline(const RenderPipelineDescriptor* descriptor);
         SamplerBase* CreateSampler(const SamplerDescriptor* descriptor);
         ShaderModuleBase* CreateShaderModule(const ShaderModuleDescriptor* descriptor);
+        // Batch version of CreateShaderModule that spreads validation and backend
+        // compilation over worker threads. Failed entries come back as error shader
+        // modules and their errors are reported in index order once all workers finish.
+        void CreateShaderModules(uint32_t count,
+                                 const ShaderModuleDescriptor* const* descriptors,
+                                 ShaderModuleBase** modules);
         SwapChainBase* CreateSwapChain(Surface* surface, const SwapChainDescriptor* descriptor);
         TextureBase* CreateTexture(const TextureDescriptor* descriptor);
         TextureViewBase* CreateTextureView(TextureBase* texture,
@@ -174,7 +235,9 @@ namespace dawn_native {
 
         MaybeError ValidateIsAlive() const;
 
-        ErrorScope* GetCurrentErrorScope();
+        // Called by the queue after work is submitted so the open error scopes don't
+        // resolve before that work completes.
+        void MarkErrorScopesUsedInSubmit();
 
         void Reference();
         void Release();
@@ -186,8 +249,40 @@ namespace dawn_native {
                                                    BufferBase* destination,
                                                    uint64_t destinationOffset,
                                                    uint64_t size) = 0;
+        // Records a copy of staged texel data into a texture on the pending command context.
+        // The data at |sourceOffset| must already be in the row-pitch-aligned layout the
+        // backend requires. Backends without staging support keep the default unimplemented
+        // error.
+        virtual MaybeError CopyFromStagingToTexture(StagingBufferBase* source,
+                                                    uint64_t sourceOffset,
+                                                    uint32_t bytesPerRow,
+                                                    uint32_t rowsPerImage,
+                                                    const TextureCopy& dst,
+                                                    const Extent3D& copySizePixels);
+
+        // Mirrors of the staging upload path in the readback direction: mapped staging
+        // memory the GPU copies results into and the CPU then reads back, used by the
+        // ReadbackRing. Backends without staging support keep these unimplemented.
+        virtual ResultOrError<std::unique_ptr<StagingBufferBase>> CreateReadbackStagingBuffer(
+            size_t size) = 0;
+        virtual MaybeError CopyFromBufferToStaging(BufferBase* source,
+                                                   uint64_t sourceOffset,
+                                                   StagingBufferBase* destination,
+                                                   uint64_t destinationOffset,
+                                                   uint64_t size) = 0;
 
         DynamicUploader* GetDynamicUploader() const;
+        ReadbackRing* GetReadbackRing() const;
+
+        // Pool of recycled CommandAllocator blocks shared by all the encoders of this
+        // device, so steady-state command encoding performs no heap allocations.
+        CommandBlockPool* GetCommandBlockPool();
+
+        // Takes ownership of |object| for deferred destruction when the
+        // defer_object_destruction toggle is enabled. The object is deleted on the next Tick
+        // instead of inline on the releasing thread. Returns false when the caller must
+        // delete the object inline.
+        bool DeferDeleteObject(ObjectBase* object);
 
         // The device state which is a combination of creation state and loss state.
         //
@@ -211,16 +306,80 @@ namespace dawn_native {
         bool IsLost() const;
 
         std::vector<const char*> GetEnabledExtensions() const;
+        const ExtensionsSet& GetEnabledExtensionsSet() const;
         std::vector<const char*> GetTogglesUsed() const;
-        bool IsExtensionEnabled(Extension extension) const;
-        bool IsToggleEnabled(Toggle toggle) const;
-        bool IsValidationEnabled() const;
+
+        // Capability checks are inlined mask tests on the cached snapshot because they sit
+        // on per-draw validation paths where an out-of-line bitset lookup shows up in
+        // profiles.
+        bool IsExtensionEnabled(Extension extension) const {
+            return (mCapabilities.extensionBits &
+                    (uint64_t(1) << static_cast<uint32_t>(extension))) != 0;
+        }
+        bool IsToggleEnabled(Toggle toggle) const {
+            return (mCapabilities.toggleBits & (uint64_t(1) << static_cast<uint32_t>(toggle))) != 0;
+        }
+        bool IsValidationEnabled() const {
+            return mCapabilities.validationEnabled;
+        }
         size_t GetLazyClearCountForTesting();
         void IncrementLazyClearCountForTesting();
         size_t GetDeprecationWarningCountForTesting();
         void EmitDeprecationWarning(const char* warning);
         void LoseForTesting();
 
+        // Memory accounting. Backend allocators report every allocation they hand out and
+        // every one they take back; GetMemoryStats returns the rolled-up live/peak counters
+        // per allocation class for telemetry.
+        void TrackMemoryAllocation(AllocationClass allocationClass, uint64_t size);
+        void TrackMemoryDeallocation(AllocationClass allocationClass, uint64_t size);
+        const MemoryStats& GetMemoryStats() const;
+
+        // Hot-path counters. Increment sites use the DAWN_COUNTER_* macros; dashboards
+        // sample them per frame with GetCounters()->AcquireSnapshot().
+        CounterRegistry* GetCounters();
+
+        // Persistent pipeline cache. Embedders can retrieve the backend's pipeline cache
+        // blob with GetPipelineCacheData, persist it, and load it again on a later device
+        // so that compute, render and ray tracing pipeline creation hits the driver cache.
+        // Backends without a native cache ignore both calls.
+        MaybeError LoadPipelineCacheData(const void* data, size_t size);
+        ResultOrError<std::vector<uint8_t>> GetPipelineCacheData();
+
+        // Content-addressed store over the platform's CachingInterface, used by the
+        // backends to reuse compiled shader blobs across device and process lifetimes.
+        PersistentCache* GetPersistentCache();
+
+        // Memory budget surfacing. QueryMemoryBudget reports the backend's view of the
+        // budget and usage of the memory segment resources are allocated from; the callback
+        // is fired from the allocation path each time usage crosses the warning fraction of
+        // the budget so embedders can throttle streaming before allocations start failing.
+        MemoryBudgetInfo QueryMemoryBudget();
+        void SetMemoryBudgetCallback(MemoryBudgetCallback callback, void* userdata);
+        // Called by backend allocators after usage grows.
+        void CheckMemoryBudgetPressure();
+
+        // Running totals of the driver-reported memory of live acceleration containers,
+        // maintained by RayTracingAccelerationContainerBase.
+        void IncreaseRayTracingMemoryUsage(const RayTracingMemoryUsage& usage);
+        void DecreaseRayTracingMemoryUsage(const RayTracingMemoryUsage& usage);
+        RayTracingMemoryUsage GetRayTracingMemoryUsage() const;
+
+        // Deferred acceleration container build scheduling. Builds of containers created
+        // with high or background priority are not recorded into the user's command
+        // buffer; they are queued here and submitted on Tick. High priority builds are
+        // all submitted on the next tick, background builds only up to the per-tick
+        // budget so a burst of streaming builds is spread across frames.
+        void EnqueueDeferredContainerBuild(RayTracingAccelerationContainerBase* container);
+        // The budget is expressed in primitives, the quantity build time scales with.
+        void SetDeferredBuildBudget(uint64_t maxPrimitivesPerTick);
+
+        // Blocks on the backend's completion primitive until GPU work that Tick has not yet
+        // observed completes, so an application loop can sleep instead of polling Tick for
+        // map/fence/error-scope callbacks. Returns true when a Tick would make progress and
+        // false on timeout or when no work is in flight.
+        bool WaitForCompletedWork(uint64_t timeoutNanoseconds);
+
       protected:
         void SetToggle(Toggle toggle, bool isEnabled);
         void ForceSetToggle(Toggle toggle, bool isEnabled);
@@ -254,6 +413,12 @@ namespace dawn_native {
         virtual ResultOrError<BufferBase*> CreateBufferImpl(const BufferDescriptor* descriptor) = 0;
         virtual ResultOrError<ComputePipelineBase*> CreateComputePipelineImpl(
             const ComputePipelineDescriptor* descriptor) = 0;
+        virtual ResultOrError<QuerySetBase*> CreateQuerySetImpl(
+            const QuerySetDescriptor* descriptor) = 0;
+        // The queue type is a scheduling hint: the default implementation hands out the default
+        // queue, and backends with additional hardware queues override this to route matching
+        // queue types to them.
+        virtual ResultOrError<QueueBase*> CreateQueueImpl(const QueueDescriptor* descriptor);
         virtual ResultOrError<PipelineLayoutBase*> CreatePipelineLayoutImpl(
             const PipelineLayoutDescriptor* descriptor) = 0;
         virtual ResultOrError<RenderPipelineBase*> CreateRenderPipelineImpl(
@@ -281,6 +446,9 @@ namespace dawn_native {
                                            const RayTracingShaderBindingTableDescriptor* descriptor);
         MaybeError CreateRayTracingPipelineInternal(RayTracingPipelineBase** result,
                                                     const RayTracingPipelineDescriptor* descriptor);
+        MaybeError CreateRayTracingBundleEncoderInternal(
+            RayTracingBundleEncoder** result,
+            const RayTracingBundleEncoderDescriptor* descriptor);
         MaybeError CreateBindGroupInternal(BindGroupBase** result,
                                            const BindGroupDescriptor* descriptor);
         MaybeError CreateBindGroupLayoutInternal(BindGroupLayoutBase** result,
@@ -288,6 +456,9 @@ namespace dawn_native {
         ResultOrError<BufferBase*> CreateBufferInternal(const BufferDescriptor* descriptor);
         MaybeError CreateComputePipelineInternal(ComputePipelineBase** result,
                                                  const ComputePipelineDescriptor* descriptor);
+        MaybeError CreateQuerySetInternal(QuerySetBase** result,
+                                          const QuerySetDescriptor* descriptor);
+        MaybeError CreateQueueInternal(QueueBase** result, const QueueDescriptor* descriptor);
         MaybeError CreatePipelineLayoutInternal(PipelineLayoutBase** result,
                                                 const PipelineLayoutDescriptor* descriptor);
         MaybeError CreateRenderBundleEncoderInternal(
@@ -313,6 +484,20 @@ namespace dawn_native {
 
         void ConsumeError(std::unique_ptr<ErrorData> error);
 
+        // Persistent pipeline cache hooks. The default implementations do nothing so that
+        // backends without a native pipeline cache don't have to override them.
+        virtual MaybeError LoadPipelineCacheDataImpl(const void* data, size_t size);
+        virtual ResultOrError<std::vector<uint8_t>> GetPipelineCacheDataImpl();
+
+        // Memory budget hook. The default implementation reports no budget so that backends
+        // without a budget query don't have to override it.
+        virtual MemoryBudgetInfo QueryMemoryBudgetImpl();
+
+        // Completion wait hook for WaitForCompletedWork. The default implementation returns
+        // true immediately so backends without a waitable completion primitive degrade to
+        // polling.
+        virtual bool WaitForCompletedWorkImpl(uint64_t timeoutNanoseconds);
+
         // Each backend should implement to check their passed fences if there are any and return a
         // completed serial. Return 0 should indicate no fences to check.
         virtual Serial CheckAndUpdateCompletedSerials() = 0;
@@ -340,23 +525,75 @@ namespace dawn_native {
 
         AdapterBase* mAdapter = nullptr;
 
-        Ref<ErrorScope> mRootErrorScope;
-        Ref<ErrorScope> mCurrentErrorScope;
+        // Enabled-extension and toggle state compiled into one POD snapshot when the device
+        // is configured (and refreshed on the rare runtime toggle change) so the inline
+        // capability getters above read a cached word.
+        struct CapabilitySnapshot {
+            uint64_t toggleBits = 0;
+            uint64_t extensionBits = 0;
+            bool validationEnabled = true;
+        };
+
+        void UpdateCapabilitySnapshot();
+
+        CapabilitySnapshot mCapabilities;
+
+        ErrorScopeStack mErrorScopeStack;
+        wgpu::ErrorCallback mUncapturedErrorCallback = nullptr;
+        void* mUncapturedErrorUserdata = nullptr;
 
         // The object caches aren't exposed in the header as they would require a lot of
         // additional includes.
         struct Caches;
         std::unique_ptr<Caches> mCaches;
+        // Guards mCaches so objects may be created from multiple threads.
+        std::mutex mCacheMutex;
+        // Guards the SPIR-V reflection cache separately: it is accessed from
+        // CreateShaderModuleImpl, which runs outside of mCacheMutex.
+        mutable std::mutex mSpirvReflectionCacheMutex;
+        std::atomic<uint64_t> mNextBindGroupLayoutCompatibilityToken{1};
+
+        CommandBlockPool mCommandBlockPool;
 
         std::unique_ptr<DynamicUploader> mDynamicUploader;
+        std::unique_ptr<ReadbackRing> mReadbackRing;
+        std::unique_ptr<CreateReadyPipelineTracker> mCreateReadyPipelineTracker;
         std::unique_ptr<ErrorScopeTracker> mErrorScopeTracker;
         std::unique_ptr<FenceSignalTracker> mFenceSignalTracker;
         std::unique_ptr<MapRequestTracker> mMapRequestTracker;
+        std::unique_ptr<PersistentCache> mPersistentCache;
+        std::unique_ptr<QueueWorkDoneTracker> mQueueWorkDoneTracker;
         Ref<QueueBase> mDefaultQueue;
 
         struct DeprecationWarnings;
         std::unique_ptr<DeprecationWarnings> mDeprecationWarnings;
 
+        void DrainDeferredDeletions();
+
+        // Encodes and submits the queued deferred container builds for this tick.
+        void FlushDeferredContainerBuilds();
+
+        // Containers waiting for a deferred build, in request order per priority class.
+        std::deque<Ref<RayTracingAccelerationContainerBase>> mHighPriorityContainerBuilds;
+        std::deque<Ref<RayTracingAccelerationContainerBase>> mBackgroundContainerBuilds;
+        // Per-tick budget for background builds in primitives. The default corresponds to
+        // roughly a millisecond of build time on current hardware.
+        uint64_t mDeferredBuildBudget = 1000000;
+
+        // Objects whose last reference was dropped while deferred destruction is enabled.
+        // The list is drained on Tick so backend destructors run there instead of on
+        // whichever thread happened to drop the last reference.
+        std::mutex mDeferredDeletionMutex;
+        std::vector<ObjectBase*> mDeferredDeletions;
+
+        MemoryBudgetCallback mMemoryBudgetCallback = nullptr;
+        void* mMemoryBudgetUserdata = nullptr;
+        // True while usage is above the warning fraction, so the callback only fires on the
+        // crossing instead of on every allocation under pressure.
+        bool mMemoryBudgetWarningActive = false;
+
+        RayTracingMemoryUsage mRayTracingMemoryUsage = {};
+
         uint32_t mRefCount = 1;
         State mState = State::BeingCreated;
 
@@ -365,6 +602,8 @@ namespace dawn_native {
         TogglesSet mEnabledToggles;
         TogglesSet mOverridenToggles;
         size_t mLazyClearCountForTesting = 0;
+        MemoryStats mMemoryStats;
+        CounterRegistry mCounters;
 
         ExtensionsSet mEnabledExtensions;
     };
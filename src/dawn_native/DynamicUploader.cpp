@@ -13,8 +13,13 @@
 // limitations under the License.
 
 #include "dawn_native/DynamicUploader.h"
+#include "common/Counters.h"
 #include "common/Math.h"
 #include "dawn_native/Device.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
+
+#include <algorithm>
 
 namespace dawn_native {
 
@@ -28,18 +33,70 @@ namespace dawn_native {
                                         mDevice->GetPendingCommandSerial());
     }
 
-    ResultOrError<UploadHandle> DynamicUploader::Allocate(uint64_t allocationSize, Serial serial) {
-        // Disable further sub-allocation should the request be too large.
-        if (allocationSize > kRingBufferSize) {
-            std::unique_ptr<StagingBufferBase> stagingBuffer;
-            DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateStagingBuffer(allocationSize));
+    ResultOrError<UploadHandle> DynamicUploader::AllocateFromLargeBufferPool(
+        uint64_t allocationSize,
+        Serial serial) {
+        mLargeAllocationCount++;
+
+        // Classes are sorted by size, so the first class that fits and has a free buffer
+        // is the smallest one. Take the most recently recycled buffer so idle ones sink
+        // to the front of the class where Deallocate trims them.
+        std::unique_ptr<StagingBufferBase> stagingBuffer;
+        for (LargeBufferSizeClass& sizeClass : mLargeBufferSizeClasses) {
+            if (sizeClass.size >= allocationSize && !sizeClass.freeBuffers.empty()) {
+                stagingBuffer = std::move(sizeClass.freeBuffers.back().stagingBuffer);
+                sizeClass.freeBuffers.pop_back();
+                break;
+            }
+        }
+
+        if (stagingBuffer == nullptr) {
+            // Round the size up to a power-of-two so later large allocations are more likely to
+            // be able to reuse the buffer.
+            mLargeBufferPoolMissCount++;
+            DAWN_TRY_ASSIGN(stagingBuffer,
+                            mDevice->CreateStagingBuffer(NextPowerOfTwo(allocationSize)));
+        }
+
+        UploadHandle uploadHandle;
+        uploadHandle.mappedBuffer = static_cast<uint8_t*>(stagingBuffer->GetMappedPointer());
+        uploadHandle.stagingBuffer = stagingBuffer.get();
+
+        mInFlightLargeBuffers.Enqueue(std::move(stagingBuffer), serial);
+        return uploadHandle;
+    }
+
+    void DynamicUploader::RecycleLargeBuffer(std::unique_ptr<StagingBufferBase> stagingBuffer,
+                                             Serial lastCompletedSerial) {
+        const uint64_t size = stagingBuffer->GetSize();
 
-            UploadHandle uploadHandle;
-            uploadHandle.mappedBuffer = static_cast<uint8_t*>(stagingBuffer->GetMappedPointer());
-            uploadHandle.stagingBuffer = stagingBuffer.get();
+        // Find the buffer's size class, inserting it if the class doesn't exist yet. The
+        // class list stays sorted and is at most a handful of entries since buffer sizes
+        // are rounded to powers of two.
+        auto it = mLargeBufferSizeClasses.begin();
+        while (it != mLargeBufferSizeClasses.end() && it->size < size) {
+            ++it;
+        }
+        if (it == mLargeBufferSizeClasses.end() || it->size != size) {
+            it = mLargeBufferSizeClasses.insert(it, {size, {}});
+        }
+
+        // Replace the oldest free buffer instead of growing past the class limit; the
+        // incoming buffer is the warmer one.
+        if (it->freeBuffers.size() >= kMaxFreeLargeBuffersPerClass) {
+            it->freeBuffers.erase(it->freeBuffers.begin());
+        }
+        it->freeBuffers.push_back({std::move(stagingBuffer), lastCompletedSerial});
+    }
+
+    ResultOrError<UploadHandle> DynamicUploader::Allocate(uint64_t allocationSize, Serial serial) {
+        mBytesAllocated += allocationSize;
+        DAWN_COUNTER_ADD(mDevice->GetCounters(), StagingBytesAllocated, allocationSize);
 
-            ReleaseStagingBuffer(std::move(stagingBuffer));
-            return uploadHandle;
+        // Requests that cannot fit in the largest possible ring buffer go through the large
+        // buffer pool instead of defeating pooling with one-off staging buffers.
+        if (allocationSize > kMaxRingBufferSize) {
+            return AllocateFromLargeBufferPool(allocationSize, serial);
         }
 
         // Note: Validation ensures size is already aligned.
@@ -63,10 +120,17 @@ namespace dawn_native {
         }
 
         // Upon failure, append a newly created ring buffer to fulfill the
-        // request.
+        // request. The new ring doubles the size of the previous largest one (the last buffer
+        // is the largest) up to kMaxRingBufferSize so the uploader grows into upload-heavy
+        // workloads.
         if (startOffset == RingBufferAllocator::kInvalidOffset) {
+            const uint64_t nextRingBufferSize =
+                std::min(std::max(mRingBuffers.back()->mAllocator.GetSize() * 2,
+                                  NextPowerOfTwo(allocationSize)),
+                         kMaxRingBufferSize);
+            ASSERT(nextRingBufferSize >= allocationSize);
             mRingBuffers.emplace_back(std::unique_ptr<RingBuffer>(
-                new RingBuffer{nullptr, RingBufferAllocator(kRingBufferSize)}));
+                new RingBuffer{nullptr, RingBufferAllocator(nextRingBufferSize)}));
 
             targetRingBuffer = mRingBuffers.back().get();
             startOffset = targetRingBuffer->mAllocator.Allocate(allocationSize, serial);
@@ -107,5 +171,42 @@ namespace dawn_native {
             }
         }
         mReleasedStagingBuffers.ClearUpTo(lastCompletedSerial);
+
+        // Return completed large staging buffers to their size class instead of destroying
+        // them.
+        for (std::unique_ptr<StagingBufferBase>& stagingBuffer :
+             mInFlightLargeBuffers.IterateUpTo(lastCompletedSerial)) {
+            RecycleLargeBuffer(std::move(stagingBuffer), lastCompletedSerial);
+        }
+        mInFlightLargeBuffers.ClearUpTo(lastCompletedSerial);
+
+        // Destroy free large buffers that stayed unused for long enough. Entries are
+        // ordered by recycle serial, so each class only needs its front trimmed.
+        for (size_t i = 0; i < mLargeBufferSizeClasses.size();) {
+            std::vector<FreeLargeBuffer>& freeBuffers = mLargeBufferSizeClasses[i].freeBuffers;
+            size_t trimCount = 0;
+            while (trimCount < freeBuffers.size() &&
+                   freeBuffers[trimCount].lastUsedSerial + kLargeBufferIdleSerialsBeforeTrim <=
+                       lastCompletedSerial) {
+                trimCount++;
+            }
+            if (trimCount > 0) {
+                freeBuffers.erase(freeBuffers.begin(), freeBuffers.begin() + trimCount);
+            }
+            if (freeBuffers.empty()) {
+                mLargeBufferSizeClasses.erase(mLargeBufferSizeClasses.begin() + i);
+            } else {
+                ++i;
+            }
+        }
+
+        if (mBytesAllocated > 0 || mLargeAllocationCount > 0) {
+            TRACE_EVENT2(mDevice->GetPlatform(), General, "DynamicUploader::Deallocate",
+                         "bytesAllocated", mBytesAllocated, "largeBufferPoolMisses",
+                         mLargeBufferPoolMissCount);
+            mBytesAllocated = 0;
+            mLargeAllocationCount = 0;
+            mLargeBufferPoolMissCount = 0;
+        }
     }
 }  // namespace dawn_native
\ No newline at end of file
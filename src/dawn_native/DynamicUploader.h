@@ -46,6 +46,25 @@ namespace dawn_native {
       private:
         static constexpr uint64_t kRingBufferSize = 4 * 1024 * 1024;
 
+        // New ring buffers double the size of the previous one up to this cap, so upload-heavy
+        // scenes converge on a ring large enough for a whole frame instead of accumulating many
+        // small rings.
+        static constexpr uint64_t kMaxRingBufferSize = 32 * 1024 * 1024;
+
+        // Allocations too large for any ring buffer are served from a pool of reusable
+        // staging buffers instead of one-off allocations. The pool is bucketed by
+        // power-of-two size class so a burst of same-sized streaming uploads reuses warm
+        // buffers instead of querying the driver for new ones.
+        static constexpr size_t kMaxFreeLargeBuffersPerClass = 2;
+        // A free large buffer that stayed unused for this many completed serials is
+        // destroyed so the pool doesn't pin tens of megabytes after streaming settles.
+        static constexpr uint64_t kLargeBufferIdleSerialsBeforeTrim = 64;
+
+        ResultOrError<UploadHandle> AllocateFromLargeBufferPool(uint64_t allocationSize,
+                                                                Serial serial);
+        void RecycleLargeBuffer(std::unique_ptr<StagingBufferBase> stagingBuffer,
+                                Serial lastCompletedSerial);
+
         struct RingBuffer {
             std::unique_ptr<StagingBufferBase> mStagingBuffer;
             RingBufferAllocator mAllocator;
@@ -53,6 +72,30 @@ namespace dawn_native {
 
         std::vector<std::unique_ptr<RingBuffer>> mRingBuffers;
         SerialQueue<std::unique_ptr<StagingBufferBase>> mReleasedStagingBuffers;
+
+        struct FreeLargeBuffer {
+            std::unique_ptr<StagingBufferBase> stagingBuffer;
+            // The completed serial at which the buffer was returned to the pool.
+            Serial lastUsedSerial;
+        };
+
+        // Free buffers of one power-of-two size. The list is used as a LIFO so bursts
+        // reuse warm buffers and idle ones age out at the front.
+        struct LargeBufferSizeClass {
+            uint64_t size;
+            std::vector<FreeLargeBuffer> freeBuffers;
+        };
+
+        // Completed large staging buffers are recycled through these classes, kept sorted
+        // by size so allocation takes the smallest class that fits.
+        std::vector<LargeBufferSizeClass> mLargeBufferSizeClasses;
+        SerialQueue<std::unique_ptr<StagingBufferBase>> mInFlightLargeBuffers;
+
+        // Telemetry accumulated between Deallocate() ticks, reported via platform tracing.
+        uint64_t mBytesAllocated = 0;
+        uint64_t mLargeAllocationCount = 0;
+        uint64_t mLargeBufferPoolMissCount = 0;
+
         DeviceBase* mDevice;
     };
 }  // namespace dawn_native
@@ -25,6 +25,8 @@ namespace dawn_native {
 
     EncodingContext::EncodingContext(DeviceBase* device, const ObjectBase* initialEncoder)
         : mDevice(device), mTopLevelEncoder(initialEncoder), mCurrentEncoder(initialEncoder) {
+        mAllocator.SetBlockPool(device->GetCommandBlockPool());
+        mAllocator.SetUseLargePages(device->IsToggleEnabled(Toggle::UseLargePageCommandBlocks));
     }
 
     EncodingContext::~EncodingContext() {
@@ -46,6 +48,13 @@ namespace dawn_native {
         return &mIterator;
     }
 
+    void EncodingContext::ReplaceCommands(CommandIterator commands) {
+        ASSERT(mWasMovedToIterator);
+        ASSERT(mWereCommandsAcquired);
+        mIterator = std::move(commands);
+        mWereCommandsAcquired = false;
+    }
+
     void EncodingContext::MoveToIterator() {
         if (!mWasMovedToIterator) {
             mIterator = std::move(mAllocator);
@@ -95,6 +104,15 @@ namespace dawn_native {
         return std::move(mPassUsages);
     }
 
+    PerPassUsages* EncodingContext::GetMutablePassUsages() {
+        ASSERT(!mWerePassUsagesAcquired);
+        return &mPassUsages;
+    }
+
+    PassResourceUsageStoragePool* EncodingContext::GetUsageTrackerStoragePool() {
+        return &mUsageTrackerStoragePool;
+    }
+
     MaybeError EncodingContext::Finish() {
         if (IsFinished()) {
             return DAWN_VALIDATION_ERROR("Command encoding already finished");
@@ -30,6 +30,11 @@ namespace dawn_native {
 
     // Base class for allocating/iterating commands.
     // It performs error tracking as well as encoding state for render/compute passes.
+    //
+    // Each encoder owns its own EncodingContext (and thus its own CommandAllocator), and
+    // errors are buffered here until Finish(), so independent encoders may record on
+    // different threads concurrently. Only Finish() and object creation touch device-wide
+    // state, and the latter is synchronized by DeviceBase's cache mutex.
     class EncodingContext {
       public:
         EncodingContext(DeviceBase* device, const ObjectBase* initialEncoder);
@@ -38,6 +43,10 @@ namespace dawn_native {
         CommandIterator AcquireCommands();
         CommandIterator* GetIterator();
 
+        // Puts back a tape after AcquireCommands, replacing the previous one. Used when a
+        // finish-time optimization rewrites the commands before validation.
+        void ReplaceCommands(CommandIterator commands);
+
         // Functions to handle encoder errors
         void HandleError(InternalErrorType type, const char* message);
 
@@ -77,6 +86,18 @@ namespace dawn_native {
 
         const PerPassUsages& GetPassUsages() const;
         PerPassUsages AcquirePassUsages();
+        // Mutable access for finish-time rewrites that change pass boundaries and must keep
+        // the per-pass usages aligned with the tape.
+        PerPassUsages* GetMutablePassUsages();
+
+        // Storage recycled between the passes of this encoder by their usage trackers.
+        PassResourceUsageStoragePool* GetUsageTrackerStoragePool();
+
+        // Pre-sizes the command allocator for encoders that know approximately how much
+        // command memory they will record (CommandEncoderDescriptor::sizeHint).
+        void ReserveCommandSpace(size_t size) {
+            mAllocator.Reserve(size);
+        }
 
       private:
         bool IsFinished() const;
@@ -97,6 +118,8 @@ namespace dawn_native {
         PerPassUsages mPassUsages;
         bool mWerePassUsagesAcquired = false;
 
+        PassResourceUsageStoragePool mUsageTrackerStoragePool;
+
         CommandAllocator mAllocator;
         CommandIterator mIterator;
         bool mWasMovedToIterator = false;
@@ -14,16 +14,50 @@
 
 #include "dawn_native/ErrorData.h"
 
+#include "common/Assert.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/dawn_platform.h"
 
+#include <mutex>
+#include <new>
+#include <type_traits>
+
 namespace dawn_native {
 
+    namespace {
+
+        // Preallocated storage for ErrorData so that raising an error (even one an error scope
+        // later suppresses) doesn't hit the system allocator. The slab is deliberately small:
+        // more live errors than this means something is deeply wrong and falling back to the
+        // heap is acceptable.
+        constexpr size_t kErrorDataSlabCount = 64;
+
+        using ErrorDataStorage =
+            std::aligned_storage<sizeof(ErrorData), alignof(ErrorData)>::type;
+
+        std::mutex sSlabMutex;
+        ErrorDataStorage sSlab[kErrorDataSlabCount];
+        uint32_t sSlabFreeList[kErrorDataSlabCount];
+        uint32_t sSlabFreeCount = 0;
+        bool sSlabInitialized = false;
+
+    }  // anonymous namespace
+
     std::unique_ptr<ErrorData> ErrorData::Create(InternalErrorType type,
                                                  std::string message,
                                                  const char* file,
                                                  const char* function,
                                                  int line) {
+        std::unique_ptr<ErrorData> error = std::make_unique<ErrorData>(type, std::move(message));
+        error->AppendBacktrace(file, function, line);
+        return error;
+    }
+
+    std::unique_ptr<ErrorData> ErrorData::Create(InternalErrorType type,
+                                                 const char* message,
+                                                 const char* file,
+                                                 const char* function,
+                                                 int line) {
         std::unique_ptr<ErrorData> error = std::make_unique<ErrorData>(type, message);
         error->AppendBacktrace(file, function, line);
         return error;
@@ -33,13 +67,65 @@ namespace dawn_native {
         : mType(type), mMessage(std::move(message)) {
     }
 
+    ErrorData::ErrorData(InternalErrorType type, const char* message)
+        : mType(type), mLiteralMessage(message) {
+    }
+
+    void* ErrorData::operator new(size_t size) {
+        ASSERT(size == sizeof(ErrorData));
+
+        std::lock_guard<std::mutex> lock(sSlabMutex);
+        if (!sSlabInitialized) {
+            for (uint32_t i = 0; i < kErrorDataSlabCount; ++i) {
+                sSlabFreeList[i] = i;
+            }
+            sSlabFreeCount = kErrorDataSlabCount;
+            sSlabInitialized = true;
+        }
+
+        if (sSlabFreeCount > 0) {
+            return &sSlab[sSlabFreeList[--sSlabFreeCount]];
+        }
+        return ::operator new(size);
+    }
+
+    void ErrorData::operator delete(void* ptr) {
+        ErrorDataStorage* storage = static_cast<ErrorDataStorage*>(ptr);
+        if (storage >= &sSlab[0] && storage < &sSlab[kErrorDataSlabCount]) {
+            std::lock_guard<std::mutex> lock(sSlabMutex);
+            sSlabFreeList[sSlabFreeCount++] = static_cast<uint32_t>(storage - &sSlab[0]);
+            return;
+        }
+        ::operator delete(ptr);
+    }
+
     void ErrorData::AppendBacktrace(const char* file, const char* function, int line) {
+        if (mBacktraceCount >= kMaxBacktraceRecords) {
+            return;
+        }
+
         BacktraceRecord record;
         record.file = file;
         record.function = function;
         record.line = line;
 
-        mBacktrace.push_back(std::move(record));
+        mBacktrace[mBacktraceCount++] = record;
+    }
+
+    ErrorData::BacktraceView::BacktraceView(const BacktraceRecord* records, size_t count)
+        : mRecords(records), mCount(count) {
+    }
+
+    const ErrorData::BacktraceRecord* ErrorData::BacktraceView::begin() const {
+        return mRecords;
+    }
+
+    const ErrorData::BacktraceRecord* ErrorData::BacktraceView::end() const {
+        return mRecords + mCount;
+    }
+
+    size_t ErrorData::BacktraceView::size() const {
+        return mCount;
     }
 
     InternalErrorType ErrorData::GetType() const {
@@ -47,11 +133,16 @@ namespace dawn_native {
     }
 
     const std::string& ErrorData::GetMessage() const {
+        // Errors created from a string literal only render their message when it is actually
+        // consumed.
+        if (mMessage.empty() && mLiteralMessage != nullptr) {
+            mMessage = mLiteralMessage;
+        }
         return mMessage;
     }
 
-    const std::vector<ErrorData::BacktraceRecord>& ErrorData::GetBacktrace() const {
-        return mBacktrace;
+    ErrorData::BacktraceView ErrorData::GetBacktrace() const {
+        return BacktraceView(mBacktrace.data(), mBacktraceCount);
     }
 
 }  // namespace dawn_native
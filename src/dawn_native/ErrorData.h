@@ -17,11 +17,10 @@
 
 #include "common/Compiler.h"
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <string>
-#include <vector>
-#include <memory>
 
 namespace wgpu {
     enum class ErrorType : uint32_t;
@@ -41,7 +40,22 @@ namespace dawn_native {
                                                                  const char* file,
                                                                  const char* function,
                                                                  int line);
+        // Overload for string literals, which are the vast majority of error messages. The
+        // pointer is stored as-is and only rendered into a std::string if the error is
+        // surfaced, so errors suppressed by error scopes never touch the allocator for their
+        // message.
+        static DAWN_NO_DISCARD std::unique_ptr<ErrorData> Create(InternalErrorType type,
+                                                                 const char* message,
+                                                                 const char* file,
+                                                                 const char* function,
+                                                                 int line);
         ErrorData(InternalErrorType type, std::string message);
+        ErrorData(InternalErrorType type, const char* message);
+
+        // ErrorData is allocated from a preallocated slab so that raising an error doesn't call
+        // malloc, falling back to the heap only if an unreasonable number of errors is live.
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr);
 
         struct BacktraceRecord {
             const char* file;
@@ -50,14 +64,35 @@ namespace dawn_native {
         };
         void AppendBacktrace(const char* file, const char* function, int line);
 
+        // Iterable, sized view over the backtrace records stored inline in the ErrorData.
+        class BacktraceView {
+          public:
+            BacktraceView(const BacktraceRecord* records, size_t count);
+
+            const BacktraceRecord* begin() const;
+            const BacktraceRecord* end() const;
+            size_t size() const;
+
+          private:
+            const BacktraceRecord* mRecords;
+            size_t mCount;
+        };
+
         InternalErrorType GetType() const;
         const std::string& GetMessage() const;
-        const std::vector<BacktraceRecord>& GetBacktrace() const;
+        BacktraceView GetBacktrace() const;
 
       private:
+        // DAWN_TRY appends one record per frame the error propagates through so this bound is
+        // generous; further records are dropped.
+        static constexpr size_t kMaxBacktraceRecords = 32;
+
         InternalErrorType mType;
-        std::string mMessage;
-        std::vector<BacktraceRecord> mBacktrace;
+        const char* mLiteralMessage = nullptr;
+        // Lazily rendered from mLiteralMessage in GetMessage() when needed.
+        mutable std::string mMessage;
+        std::array<BacktraceRecord, kMaxBacktraceRecords> mBacktrace;
+        size_t mBacktraceCount = 0;
     };
 
 }  // namespace dawn_native
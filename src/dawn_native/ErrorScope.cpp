@@ -16,63 +16,39 @@
 
 #include "common/Assert.h"
 
-namespace dawn_native {
+#include <utility>
 
-    ErrorScope::ErrorScope() : mIsRoot(true) {
-    }
+namespace dawn_native {
 
-    ErrorScope::ErrorScope(wgpu::ErrorFilter errorFilter, ErrorScope* parent)
-        : RefCounted(), mErrorFilter(errorFilter), mParent(parent), mIsRoot(false) {
-        ASSERT(mParent.Get() != nullptr);
+    void ErrorScopeStack::Push(wgpu::ErrorFilter errorFilter) {
+        ErrorScopeFrame frame;
+        frame.errorFilter = errorFilter;
+        mFrames->push_back(std::move(frame));
     }
 
-    ErrorScope::~ErrorScope() {
-        if (!IsRoot()) {
-            RunNonRootCallback();
+    bool ErrorScopeStack::Pop(ErrorScopeFrame* frame) {
+        if (DAWN_UNLIKELY(mFrames->empty())) {
+            return false;
         }
+        *frame = std::move(mFrames->back());
+        mFrames->pop_back();
+        return true;
     }
 
-    void ErrorScope::SetCallback(wgpu::ErrorCallback callback, void* userdata) {
-        mCallback = callback;
-        mUserdata = userdata;
-    }
-
-    ErrorScope* ErrorScope::GetParent() {
-        return mParent.Get();
-    }
-
-    bool ErrorScope::IsRoot() const {
-        return mIsRoot;
-    }
-
-    void ErrorScope::RunNonRootCallback() {
-        ASSERT(!IsRoot());
-
-        if (mCallback != nullptr) {
-            // For non-root error scopes, the callback can run at most once.
-            mCallback(static_cast<WGPUErrorType>(mErrorType), mErrorMessage.c_str(), mUserdata);
-            mCallback = nullptr;
+    void ErrorScopeStack::OnSubmit(Serial lastSubmitSerial) {
+        for (ErrorScopeFrame& frame : mFrames.container()) {
+            frame.lastSubmitSerial = lastSubmitSerial;
         }
     }
 
-    void ErrorScope::HandleError(wgpu::ErrorType type, const char* message) {
-        HandleErrorImpl(this, type, message);
-    }
-
-    void ErrorScope::UnlinkForShutdown() {
-        UnlinkForShutdownImpl(this);
-    }
-
-    // static
-    void ErrorScope::HandleErrorImpl(ErrorScope* scope, wgpu::ErrorType type, const char* message) {
-        ErrorScope* currentScope = scope;
-        for (; !currentScope->IsRoot(); currentScope = currentScope->GetParent()) {
-            ASSERT(currentScope != nullptr);
+    bool ErrorScopeStack::HandleError(wgpu::ErrorType type, const char* message) {
+        for (size_t i = mFrames->size(); i > 0; --i) {
+            ErrorScopeFrame& frame = mFrames[i - 1];
 
             bool consumed = false;
             switch (type) {
                 case wgpu::ErrorType::Validation:
-                    if (currentScope->mErrorFilter != wgpu::ErrorFilter::Validation) {
+                    if (frame.errorFilter != wgpu::ErrorFilter::Validation) {
                         // Error filter does not match. Move on to the next scope.
                         continue;
                     }
@@ -80,7 +56,7 @@ namespace dawn_native {
                     break;
 
                 case wgpu::ErrorType::OutOfMemory:
-                    if (currentScope->mErrorFilter != wgpu::ErrorFilter::OutOfMemory) {
+                    if (frame.errorFilter != wgpu::ErrorFilter::OutOfMemory) {
                         // Error filter does not match. Move on to the next scope.
                         continue;
                     }
@@ -97,47 +73,53 @@ namespace dawn_native {
                 case wgpu::ErrorType::NoError:
                 default:
                     UNREACHABLE();
-                    return;
+                    return false;
             }
 
             // Record the error if the scope doesn't have one yet.
-            if (currentScope->mErrorType == wgpu::ErrorType::NoError) {
-                currentScope->mErrorType = type;
-                currentScope->mErrorMessage = message;
+            if (frame.errorType == wgpu::ErrorType::NoError) {
+                frame.errorType = type;
+                frame.errorMessage = message;
             }
 
             if (consumed) {
-                return;
+                return true;
             }
         }
+        return false;
+    }
 
-        // The root error scope captures all uncaptured errors.
-        ASSERT(currentScope->IsRoot());
-        if (currentScope->mCallback) {
-            currentScope->mCallback(static_cast<WGPUErrorType>(type), message,
-                                    currentScope->mUserdata);
-        }
+    ErrorScope::ErrorScope(wgpu::ErrorCallback callback,
+                           void* userdata,
+                           wgpu::ErrorType errorType,
+                           std::string errorMessage)
+        : mCallback(callback),
+          mUserdata(userdata),
+          mErrorType(errorType),
+          mErrorMessage(std::move(errorMessage)) {
     }
 
-    // static
-    void ErrorScope::UnlinkForShutdownImpl(ErrorScope* scope) {
-        Ref<ErrorScope> currentScope = scope;
-        Ref<ErrorScope> parentScope = nullptr;
-        for (; !currentScope->IsRoot(); currentScope = parentScope.Get()) {
-            ASSERT(!currentScope->IsRoot());
-            ASSERT(currentScope.Get() != nullptr);
-            parentScope = std::move(currentScope->mParent);
-            ASSERT(parentScope.Get() != nullptr);
-
-            // On shutdown, error scopes that have yet to have a status get Unknown.
-            if (currentScope->mErrorType == wgpu::ErrorType::NoError) {
-                currentScope->mErrorType = wgpu::ErrorType::Unknown;
-                currentScope->mErrorMessage = "Error scope destroyed";
-            }
+    ErrorScope::~ErrorScope() {
+        RunCallback();
+    }
 
-            // Run the callback if it hasn't run already.
-            currentScope->RunNonRootCallback();
+    void ErrorScope::RunCallback() {
+        if (mCallback != nullptr) {
+            // The callback can run at most once.
+            mCallback(static_cast<WGPUErrorType>(mErrorType), mErrorMessage.c_str(), mUserdata);
+            mCallback = nullptr;
+        }
+    }
+
+    void ErrorScope::UnlinkForShutdown() {
+        // On shutdown, error scopes that have yet to have a status get Unknown.
+        if (mErrorType == wgpu::ErrorType::NoError) {
+            mErrorType = wgpu::ErrorType::Unknown;
+            mErrorMessage = "Error scope destroyed";
         }
+
+        // Run the callback if it hasn't run already.
+        RunCallback();
     }
 
 }  // namespace dawn_native
@@ -18,51 +18,71 @@
 #include "dawn_native/dawn_platform.h"
 
 #include "common/RefCounted.h"
+#include "common/Serial.h"
+#include "common/StackContainer.h"
 
 #include <string>
 
 namespace dawn_native {
 
-    // Errors can be recorded into an ErrorScope by calling |HandleError|.
-    // Because an error scope should not resolve until contained
-    // commands are complete, calling the callback is deferred until it is destructed.
-    // In-flight commands or asynchronous events should hold a reference to the
-    // ErrorScope for their duration.
-    //
-    // Because parent ErrorScopes should not resolve before child ErrorScopes,
-    // ErrorScopes hold a reference to their parent.
-    //
-    // To simplify ErrorHandling, there is a sentinel root error scope which has
-    // no parent. All uncaptured errors are handled by the root error scope. Its
-    // callback is called immediately once it encounters an error.
-    class ErrorScope final : public RefCounted {
+    // One entry of the device's error scope stack. Frames are plain values held inline on
+    // the stack below so pushing and popping an error-free scope never touches the heap:
+    // the message string only allocates once an error is actually captured.
+    struct ErrorScopeFrame {
+        wgpu::ErrorFilter errorFilter = wgpu::ErrorFilter::None;
+        // Serial of the last submit made while this frame was open. The callback of a
+        // popped frame may only run once this serial completes, because an error scope
+        // should not resolve until contained commands are complete.
+        Serial lastSubmitSerial = 0;
+        wgpu::ErrorType errorType = wgpu::ErrorType::NoError;
+        std::string errorMessage;
+    };
+
+    // The stack of open error scopes, walked on every error to find the innermost scope
+    // whose filter matches. Errors that no scope captures are reported to the caller so
+    // they can reach the uncaptured error callback.
+    class ErrorScopeStack {
       public:
-        ErrorScope();  // Constructor for the root error scope.
-        ErrorScope(wgpu::ErrorFilter errorFilter, ErrorScope* parent);
+        void Push(wgpu::ErrorFilter errorFilter);
+        // Moves the innermost frame into |frame|. Returns false when the stack is empty.
+        bool Pop(ErrorScopeFrame* frame);
 
-        void SetCallback(wgpu::ErrorCallback callback, void* userdata);
-        ErrorScope* GetParent();
+        // Stamps every open scope with the serial of a submit made while it was open.
+        void OnSubmit(Serial lastSubmitSerial);
 
-        void HandleError(wgpu::ErrorType type, const char* message);
-        void UnlinkForShutdown();
+        // Records the error in the innermost scope with a matching filter. Returns true
+        // when a scope consumed the error, false when it should bubble to the uncaptured
+        // error callback. Unknown and DeviceLost are fatal: all scopes capture them and
+        // they always bubble.
+        bool HandleError(wgpu::ErrorType type, const char* message);
 
       private:
-        ~ErrorScope() override;
-        bool IsRoot() const;
-        void RunNonRootCallback();
+        // Inline storage covers typical scope nesting depths.
+        StackVector<ErrorScopeFrame, 4> mFrames;
+    };
 
-        static void HandleErrorImpl(ErrorScope* scope, wgpu::ErrorType type, const char* message);
-        static void UnlinkForShutdownImpl(ErrorScope* scope);
+    // Deferred delivery of a popped error scope's result, only materialized when a frame
+    // is popped before the commands submitted during its lifetime have completed. The
+    // ErrorScopeTracker holds a reference until then and the callback runs when the last
+    // reference goes away.
+    class ErrorScope final : public RefCounted {
+      public:
+        ErrorScope(wgpu::ErrorCallback callback,
+                   void* userdata,
+                   wgpu::ErrorType errorType,
+                   std::string errorMessage);
+
+        void UnlinkForShutdown();
 
-        wgpu::ErrorFilter mErrorFilter = wgpu::ErrorFilter::None;
-        Ref<ErrorScope> mParent = nullptr;
-        bool mIsRoot;
+      private:
+        ~ErrorScope() override;
+        void RunCallback();
 
         wgpu::ErrorCallback mCallback = nullptr;
         void* mUserdata = nullptr;
 
-        wgpu::ErrorType mErrorType = wgpu::ErrorType::NoError;
-        std::string mErrorMessage = "";
+        wgpu::ErrorType mErrorType;
+        std::string mErrorMessage;
     };
 
 }  // namespace dawn_native
@@ -35,8 +35,8 @@ namespace dawn_native {
         Tick(maxSerial);
     }
 
-    void ErrorScopeTracker::TrackUntilLastSubmitComplete(ErrorScope* scope) {
-        mScopesInFlight.Enqueue(scope, mDevice->GetLastSubmittedCommandSerial());
+    void ErrorScopeTracker::TrackUntilSerialComplete(ErrorScope* scope, Serial serial) {
+        mScopesInFlight.Enqueue(scope, serial);
     }
 
     void ErrorScopeTracker::Tick(Serial completedSerial) {
@@ -28,7 +28,7 @@ namespace dawn_native {
         ErrorScopeTracker(DeviceBase* device);
         ~ErrorScopeTracker();
 
-        void TrackUntilLastSubmitComplete(ErrorScope* scope);
+        void TrackUntilSerialComplete(ErrorScope* scope, Serial serial);
 
         void Tick(Serial completedSerial);
 
@@ -51,7 +51,22 @@ namespace dawn_native {
              {Extension::TimestampQuery,
               {"timestamp_query", "Support Timestamp Query",
                "https://bugs.chromium.org/p/dawn/issues/detail?id=434"},
-              &WGPUDeviceProperties::timestampQuery}}};
+              &WGPUDeviceProperties::timestampQuery},
+             {Extension::RayQuery,
+              {"ray_query", "Support inline ray tracing from compute shaders",
+               "https://github.com/maierfelix/dawn-ray-tracing"},
+              &WGPUDeviceProperties::rayQuery},
+             {Extension::ImmediateData,
+              {"immediate_data",
+               "Support setting small amounts of per-draw constant data on pass encoders",
+               "https://github.com/maierfelix/dawn-ray-tracing"},
+              &WGPUDeviceProperties::immediateData},
+             {Extension::SpecializationConstants,
+              {"specialization_constants",
+               "Support specializing pipeline constants at pipeline creation, so one shader "
+               "module serves every constant variant",
+               "https://github.com/maierfelix/dawn-ray-tracing"},
+              &WGPUDeviceProperties::specializationConstants}}};
 
     }  // anonymous namespace
 
@@ -29,6 +29,9 @@ namespace dawn_native {
         ShaderFloat16,
         PipelineStatisticsQuery,
         TimestampQuery,
+        RayQuery,
+        ImmediateData,
+        SpecializationConstants,
 
         EnumCount,
         InvalidEnum = EnumCount,
@@ -83,17 +83,11 @@ namespace dawn_native {
 
     // Implementation details of the format table of the DeviceBase
 
-    // For the enum for formats are packed but this might change when we have a broader extension
-    // mechanism for webgpu.h. Formats start at 1 because 0 is the undefined format.
-    size_t ComputeFormatIndex(wgpu::TextureFormat format) {
-        // This takes advantage of overflows to make the index of TextureFormat::Undefined outside
-        // of the range of the FormatTable.
-        static_assert(static_cast<uint32_t>(wgpu::TextureFormat::Undefined) - 1 > kKnownFormatCount,
-                      "");
-        return static_cast<size_t>(static_cast<uint32_t>(format) - 1);
+    FormatTable BuildFormatTable(const DeviceBase* device) {
+        return BuildFormatTable(device->GetEnabledExtensionsSet());
     }
 
-    FormatTable BuildFormatTable(const DeviceBase* device) {
+    FormatTable BuildFormatTable(const ExtensionsSet& enabledExtensions) {
         FormatTable table;
         std::bitset<kKnownFormatCount> formatsSet;
 
@@ -108,6 +102,12 @@ namespace dawn_native {
             // formats are set exactly once.
             ASSERT(!formatsSet[index]);
 
+            // Check that the compile-time texel block table stays in sync with the full
+            // format information.
+            ASSERT(kTexelBlockInfo[index].byteSize == format.blockByteSize);
+            ASSERT(kTexelBlockInfo[index].width == format.blockWidth);
+            ASSERT(kTexelBlockInfo[index].height == format.blockHeight);
+
             table[index] = format;
             formatsSet.set(index);
         };
@@ -162,7 +162,8 @@ namespace dawn_native {
         };
 
         auto AddCompressedFormat = [&AddFormat](wgpu::TextureFormat format, uint32_t byteSize,
-                                                uint32_t width, uint32_t height, bool isSupported) {
+                                                uint32_t width, uint32_t height, bool isSupported,
+                                                wgpu::TextureFormat fallbackFormat) {
             Format internalFormat;
             internalFormat.format = format;
             internalFormat.isRenderable = false;
@@ -174,6 +175,7 @@ namespace dawn_native {
             internalFormat.blockByteSize = byteSize;
             internalFormat.blockWidth = width;
             internalFormat.blockHeight = height;
+            internalFormat.fallbackFormat = fallbackFormat;
             AddFormat(internalFormat);
         };
 
@@ -235,21 +237,21 @@ namespace dawn_native {
         AddDepthStencilFormat(wgpu::TextureFormat::Depth24PlusStencil8, Aspect::DepthStencil, 4);
 
         // BC compressed formats
-        bool isBCFormatSupported = device->IsExtensionEnabled(Extension::TextureCompressionBC);
-        AddCompressedFormat(wgpu::TextureFormat::BC1RGBAUnorm, 8, 4, 4, isBCFormatSupported);
-        AddCompressedFormat(wgpu::TextureFormat::BC1RGBAUnormSrgb, 8, 4, 4, isBCFormatSupported);
-        AddCompressedFormat(wgpu::TextureFormat::BC4RSnorm, 8, 4, 4, isBCFormatSupported);
-        AddCompressedFormat(wgpu::TextureFormat::BC4RUnorm, 8, 4, 4, isBCFormatSupported);
-        AddCompressedFormat(wgpu::TextureFormat::BC2RGBAUnorm, 16, 4, 4, isBCFormatSupported);
-        AddCompressedFormat(wgpu::TextureFormat::BC2RGBAUnormSrgb, 16, 4, 4, isBCFormatSupported);
-        AddCompressedFormat(wgpu::TextureFormat::BC3RGBAUnorm, 16, 4, 4, isBCFormatSupported);
-        AddCompressedFormat(wgpu::TextureFormat::BC3RGBAUnormSrgb, 16, 4, 4, isBCFormatSupported);
-        AddCompressedFormat(wgpu::TextureFormat::BC5RGSnorm, 16, 4, 4, isBCFormatSupported);
-        AddCompressedFormat(wgpu::TextureFormat::BC5RGUnorm, 16, 4, 4, isBCFormatSupported);
-        AddCompressedFormat(wgpu::TextureFormat::BC6HRGBSfloat, 16, 4, 4, isBCFormatSupported);
-        AddCompressedFormat(wgpu::TextureFormat::BC6HRGBUfloat, 16, 4, 4, isBCFormatSupported);
-        AddCompressedFormat(wgpu::TextureFormat::BC7RGBAUnorm, 16, 4, 4, isBCFormatSupported);
-        AddCompressedFormat(wgpu::TextureFormat::BC7RGBAUnormSrgb, 16, 4, 4, isBCFormatSupported);
+        bool isBCFormatSupported = enabledExtensions.IsEnabled(Extension::TextureCompressionBC);
+        AddCompressedFormat(wgpu::TextureFormat::BC1RGBAUnorm, 8, 4, 4, isBCFormatSupported, wgpu::TextureFormat::RGBA8Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::BC1RGBAUnormSrgb, 8, 4, 4, isBCFormatSupported, wgpu::TextureFormat::RGBA8UnormSrgb);
+        AddCompressedFormat(wgpu::TextureFormat::BC4RSnorm, 8, 4, 4, isBCFormatSupported, wgpu::TextureFormat::R8Snorm);
+        AddCompressedFormat(wgpu::TextureFormat::BC4RUnorm, 8, 4, 4, isBCFormatSupported, wgpu::TextureFormat::R8Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::BC2RGBAUnorm, 16, 4, 4, isBCFormatSupported, wgpu::TextureFormat::RGBA8Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::BC2RGBAUnormSrgb, 16, 4, 4, isBCFormatSupported, wgpu::TextureFormat::RGBA8UnormSrgb);
+        AddCompressedFormat(wgpu::TextureFormat::BC3RGBAUnorm, 16, 4, 4, isBCFormatSupported, wgpu::TextureFormat::RGBA8Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::BC3RGBAUnormSrgb, 16, 4, 4, isBCFormatSupported, wgpu::TextureFormat::RGBA8UnormSrgb);
+        AddCompressedFormat(wgpu::TextureFormat::BC5RGSnorm, 16, 4, 4, isBCFormatSupported, wgpu::TextureFormat::RG8Snorm);
+        AddCompressedFormat(wgpu::TextureFormat::BC5RGUnorm, 16, 4, 4, isBCFormatSupported, wgpu::TextureFormat::RG8Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::BC6HRGBSfloat, 16, 4, 4, isBCFormatSupported, wgpu::TextureFormat::RGBA16Float);
+        AddCompressedFormat(wgpu::TextureFormat::BC6HRGBUfloat, 16, 4, 4, isBCFormatSupported, wgpu::TextureFormat::RGBA16Float);
+        AddCompressedFormat(wgpu::TextureFormat::BC7RGBAUnorm, 16, 4, 4, isBCFormatSupported, wgpu::TextureFormat::RGBA8Unorm);
+        AddCompressedFormat(wgpu::TextureFormat::BC7RGBAUnormSrgb, 16, 4, 4, isBCFormatSupported, wgpu::TextureFormat::RGBA8UnormSrgb);
 
         // clang-format on
 
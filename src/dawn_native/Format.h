@@ -24,6 +24,7 @@
 namespace dawn_native {
 
     class DeviceBase;
+    struct ExtensionsSet;
 
     // The number of formats Dawn knows about. Asserts in BuildFormatTable ensure that this is the
     // exact number of known format.
@@ -58,6 +59,10 @@ namespace dawn_native {
         uint32_t blockWidth;
         uint32_t blockHeight;
 
+        // The uncompressed format a CPU transcode should target when this format is known but
+        // not supported by the adapter. Undefined for formats that have no fallback.
+        wgpu::TextureFormat fallbackFormat = wgpu::TextureFormat::Undefined;
+
         static Type TextureComponentTypeToFormatType(wgpu::TextureComponentType componentType);
         static wgpu::TextureComponentType FormatTypeToTextureComponentType(Type type);
 
@@ -77,10 +82,95 @@ namespace dawn_native {
     using FormatTable = std::array<Format, kKnownFormatCount>;
 
     // Returns the index of a format in the FormatTable.
-    size_t ComputeFormatIndex(wgpu::TextureFormat format);
+    // The format enum is packed, and formats start at 1 because 0 is the undefined format.
+    // This takes advantage of overflows to make the index of TextureFormat::Undefined outside
+    // of the range of the FormatTable.
+    constexpr size_t ComputeFormatIndex(wgpu::TextureFormat format) {
+        return static_cast<size_t>(static_cast<uint32_t>(format) - 1);
+    }
+    static_assert(static_cast<uint32_t>(wgpu::TextureFormat::Undefined) - 1 > kKnownFormatCount,
+                  "");
+
+    // The per-texel-block properties of a format, which are independent of the device.
+    struct TexelBlockInfo {
+        uint32_t byteSize;
+        uint32_t width;
+        uint32_t height;
+    };
+
+    // Compile-time table of the texel block properties of each known format, indexed by
+    // ComputeFormatIndex. Hot copy-validation paths use this instead of the device's format
+    // table so block arithmetic inlines without a device lookup; BuildFormatTable asserts
+    // that it stays in sync with the full Format information.
+    constexpr TexelBlockInfo kTexelBlockInfo[kKnownFormatCount] = {
+        // clang-format off
+        {1, 1, 1},    // R8Unorm
+        {1, 1, 1},    // R8Snorm
+        {1, 1, 1},    // R8Uint
+        {1, 1, 1},    // R8Sint
+        {2, 1, 1},    // R16Uint
+        {2, 1, 1},    // R16Sint
+        {2, 1, 1},    // R16Float
+        {2, 1, 1},    // RG8Unorm
+        {2, 1, 1},    // RG8Snorm
+        {2, 1, 1},    // RG8Uint
+        {2, 1, 1},    // RG8Sint
+        {4, 1, 1},    // R32Float
+        {4, 1, 1},    // R32Uint
+        {4, 1, 1},    // R32Sint
+        {4, 1, 1},    // RG16Uint
+        {4, 1, 1},    // RG16Sint
+        {4, 1, 1},    // RG16Float
+        {4, 1, 1},    // RGBA8Unorm
+        {4, 1, 1},    // RGBA8UnormSrgb
+        {4, 1, 1},    // RGBA8Snorm
+        {4, 1, 1},    // RGBA8Uint
+        {4, 1, 1},    // RGBA8Sint
+        {4, 1, 1},    // BGRA8Unorm
+        {4, 1, 1},    // BGRA8UnormSrgb
+        {4, 1, 1},    // RGB10A2Unorm
+        {4, 1, 1},    // RG11B10Float
+        {8, 1, 1},    // RG32Float
+        {8, 1, 1},    // RG32Uint
+        {8, 1, 1},    // RG32Sint
+        {8, 1, 1},    // RGBA16Uint
+        {8, 1, 1},    // RGBA16Sint
+        {8, 1, 1},    // RGBA16Float
+        {16, 1, 1},   // RGBA32Float
+        {16, 1, 1},   // RGBA32Uint
+        {16, 1, 1},   // RGBA32Sint
+        {4, 1, 1},    // Depth32Float
+        {4, 1, 1},    // Depth24Plus
+        {4, 1, 1},    // Depth24PlusStencil8
+        {8, 4, 4},    // BC1RGBAUnorm
+        {8, 4, 4},    // BC1RGBAUnormSrgb
+        {16, 4, 4},   // BC2RGBAUnorm
+        {16, 4, 4},   // BC2RGBAUnormSrgb
+        {16, 4, 4},   // BC3RGBAUnorm
+        {16, 4, 4},   // BC3RGBAUnormSrgb
+        {8, 4, 4},    // BC4RUnorm
+        {8, 4, 4},    // BC4RSnorm
+        {16, 4, 4},   // BC5RGUnorm
+        {16, 4, 4},   // BC5RGSnorm
+        {16, 4, 4},   // BC6HRGBUfloat
+        {16, 4, 4},   // BC6HRGBSfloat
+        {16, 4, 4},   // BC7RGBAUnorm
+        {16, 4, 4},   // BC7RGBAUnormSrgb
+        // clang-format on
+    };
+
+    constexpr TexelBlockInfo GetTexelBlockInfo(wgpu::TextureFormat format) {
+        return kTexelBlockInfo[ComputeFormatIndex(format)];
+    }
+
     // Builds the format table with the extensions enabled on the device.
     FormatTable BuildFormatTable(const DeviceBase* device);
 
+    // Builds the format table for a given set of enabled extensions, without needing a
+    // device. Used by the adapter to answer format capability queries before any device
+    // exists.
+    FormatTable BuildFormatTable(const ExtensionsSet& enabledExtensions);
+
 }  // namespace dawn_native
 
 #endif  // DAWNNATIVE_FORMAT_H_
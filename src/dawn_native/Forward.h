@@ -34,8 +34,11 @@ namespace dawn_native {
     class InstanceBase;
     class PipelineBase;
     class PipelineLayoutBase;
+    class QuerySetBase;
     class QueueBase;
     class RayTracingAccelerationContainerBase;
+    class RayTracingBundleBase;
+    class RayTracingBundleEncoder;
     class RayTracingPassEncoder;
     class RayTracingPipelineBase;
     class RayTracingShaderBindingTableBase;
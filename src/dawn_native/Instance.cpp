@@ -60,10 +60,48 @@ namespace dawn_native {
         return instance.Detach();
     }
 
+    InstanceBase::~InstanceBase() {
+        // All devices keep their cached AttachmentStates referenced so the cache must have
+        // drained before the last device (and thus the instance) goes away.
+        ASSERT(mAttachmentStateCache.empty());
+    }
+
     bool InstanceBase::Initialize(const InstanceDescriptor*) {
         return true;
     }
 
+    Ref<AttachmentState> InstanceBase::GetOrCreateAttachmentState(
+        AttachmentStateBlueprint* blueprint,
+        DeviceBase* device) {
+        std::lock_guard<std::mutex> lock(mAttachmentStateCacheMutex);
+        auto iter = mAttachmentStateCache.find(blueprint);
+        if (iter != mAttachmentStateCache.end()) {
+            return static_cast<AttachmentState*>(*iter);
+        }
+
+        Ref<AttachmentState> attachmentState = AcquireRef(new AttachmentState(device, *blueprint));
+        attachmentState->SetIsCachedReference();
+        mAttachmentStateCache.insert(attachmentState.Get());
+        return attachmentState;
+    }
+
+    void InstanceBase::UncacheAttachmentState(AttachmentState* obj) {
+        std::lock_guard<std::mutex> lock(mAttachmentStateCacheMutex);
+        ASSERT(obj->IsCachedReference());
+        size_t removedCount = mAttachmentStateCache.erase(obj);
+        ASSERT(removedCount == 1);
+    }
+
+    bool InstanceBase::IsSpirvValidated(size_t blobHash) const {
+        std::lock_guard<std::mutex> lock(mValidatedSpirvMutex);
+        return mValidatedSpirvHashes.count(blobHash) != 0;
+    }
+
+    void InstanceBase::MarkSpirvValidated(size_t blobHash) {
+        std::lock_guard<std::mutex> lock(mValidatedSpirvMutex);
+        mValidatedSpirvHashes.insert(blobHash);
+    }
+
     void InstanceBase::DiscoverDefaultAdapters() {
         EnsureBackendConnections();
 
@@ -71,21 +109,45 @@ namespace dawn_native {
             return;
         }
 
-        // Query and merge all default adapters for all backends
+        // Query and merge all default adapters for all backends, skipping backends whose
+        // defaults were already gathered by a filtered discovery.
         for (std::unique_ptr<BackendConnection>& backend : mBackends) {
-            std::vector<std::unique_ptr<AdapterBase>> backendAdapters =
-                backend->DiscoverDefaultAdapters();
-
-            for (std::unique_ptr<AdapterBase>& adapter : backendAdapters) {
-                ASSERT(adapter->GetBackendType() == backend->GetType());
-                ASSERT(adapter->GetInstance() == this);
-                mAdapters.push_back(std::move(adapter));
+            if (mDefaultAdaptersDiscovered[static_cast<uint32_t>(backend->GetType())]) {
+                continue;
             }
+            DiscoverDefaultAdaptersForBackend(backend.get());
         }
+        mDefaultAdaptersDiscovered.set();
 
         mDiscoveredDefaultAdapters = true;
     }
 
+    void InstanceBase::DiscoverDefaultAdapters(wgpu::BackendType backendType) {
+        EnsureBackendConnection(backendType);
+
+        if (mDefaultAdaptersDiscovered[static_cast<uint32_t>(backendType)]) {
+            return;
+        }
+
+        for (std::unique_ptr<BackendConnection>& backend : mBackends) {
+            if (backend->GetType() == backendType) {
+                DiscoverDefaultAdaptersForBackend(backend.get());
+            }
+        }
+        mDefaultAdaptersDiscovered.set(static_cast<uint32_t>(backendType));
+    }
+
+    void InstanceBase::DiscoverDefaultAdaptersForBackend(BackendConnection* backend) {
+        std::vector<std::unique_ptr<AdapterBase>> backendAdapters =
+            backend->DiscoverDefaultAdapters();
+
+        for (std::unique_ptr<AdapterBase>& adapter : backendAdapters) {
+            ASSERT(adapter->GetBackendType() == backend->GetType());
+            ASSERT(adapter->GetInstance() == this);
+            mAdapters.push_back(std::move(adapter));
+        }
+    }
+
     // This is just a wrapper around the real logic that uses Error.h error handling.
     bool InstanceBase::DiscoverAdapters(const AdapterDiscoveryOptionsBase* options) {
         return !ConsumedError(DiscoverAdaptersInternal(options));
@@ -121,6 +183,20 @@ namespace dawn_native {
             return;
         }
 
+        EnsureBackendConnection(wgpu::BackendType::D3D12);
+        EnsureBackendConnection(wgpu::BackendType::Metal);
+        EnsureBackendConnection(wgpu::BackendType::Vulkan);
+        EnsureBackendConnection(wgpu::BackendType::OpenGL);
+        EnsureBackendConnection(wgpu::BackendType::Null);
+
+        mBackendsConnected = true;
+    }
+
+    void InstanceBase::EnsureBackendConnection(wgpu::BackendType backendType) {
+        if (mConnectedBackends[static_cast<uint32_t>(backendType)]) {
+            return;
+        }
+
         auto Register = [this](BackendConnection* connection, wgpu::BackendType expectedType) {
             if (connection != nullptr) {
                 ASSERT(connection->GetType() == expectedType);
@@ -129,35 +205,53 @@ namespace dawn_native {
             }
         };
 
+        switch (backendType) {
 #if defined(DAWN_ENABLE_BACKEND_D3D12)
-        Register(d3d12::Connect(this), wgpu::BackendType::D3D12);
+            case wgpu::BackendType::D3D12:
+                Register(d3d12::Connect(this), wgpu::BackendType::D3D12);
+                break;
 #endif  // defined(DAWN_ENABLE_BACKEND_D3D12)
 #if defined(DAWN_ENABLE_BACKEND_METAL)
-        Register(metal::Connect(this), wgpu::BackendType::Metal);
+            case wgpu::BackendType::Metal:
+                Register(metal::Connect(this), wgpu::BackendType::Metal);
+                break;
 #endif  // defined(DAWN_ENABLE_BACKEND_METAL)
 #if defined(DAWN_ENABLE_BACKEND_VULKAN)
-        // TODO(https://github.com/KhronosGroup/Vulkan-Loader/issues/287):
-        // When we can load SwiftShader in parallel with the system driver, we should create the
-        // backend only once and expose SwiftShader as an additional adapter. For now, we create two
-        // VkInstances, one from SwiftShader, and one from the system. Note: If the Vulkan driver
-        // *is* SwiftShader, then this would load SwiftShader twice.
-        Register(vulkan::Connect(this, false), wgpu::BackendType::Vulkan);
+            case wgpu::BackendType::Vulkan:
+                // TODO(https://github.com/KhronosGroup/Vulkan-Loader/issues/287):
+                // When we can load SwiftShader in parallel with the system driver, we should
+                // create the backend only once and expose SwiftShader as an additional adapter.
+                // For now, we create two VkInstances, one from SwiftShader, and one from the
+                // system. Note: If the Vulkan driver *is* SwiftShader, then this would load
+                // SwiftShader twice.
+                Register(vulkan::Connect(this, false), wgpu::BackendType::Vulkan);
 #    if defined(DAWN_ENABLE_SWIFTSHADER)
-        Register(vulkan::Connect(this, true), wgpu::BackendType::Vulkan);
+                Register(vulkan::Connect(this, true), wgpu::BackendType::Vulkan);
 #    endif  // defined(DAWN_ENABLE_SWIFTSHADER)
+                break;
 #endif  // defined(DAWN_ENABLE_BACKEND_VULKAN)
 #if defined(DAWN_ENABLE_BACKEND_OPENGL)
-        Register(opengl::Connect(this), wgpu::BackendType::OpenGL);
+            case wgpu::BackendType::OpenGL:
+                Register(opengl::Connect(this), wgpu::BackendType::OpenGL);
+                break;
 #endif  // defined(DAWN_ENABLE_BACKEND_OPENGL)
 #if defined(DAWN_ENABLE_BACKEND_NULL)
-        Register(null::Connect(this), wgpu::BackendType::Null);
+            case wgpu::BackendType::Null:
+                Register(null::Connect(this), wgpu::BackendType::Null);
+                break;
 #endif  // defined(DAWN_ENABLE_BACKEND_NULL)
+            default:
+                // The backend isn't compiled in; discovery will report it isn't present.
+                break;
+        }
 
-        mBackendsConnected = true;
+        mConnectedBackends.set(static_cast<uint32_t>(backendType));
     }
 
     MaybeError InstanceBase::DiscoverAdaptersInternal(const AdapterDiscoveryOptionsBase* options) {
-        EnsureBackendConnections();
+        // Only the requested backend needs to be connected; the other compiled backends
+        // stay unloaded.
+        EnsureBackendConnection(static_cast<wgpu::BackendType>(options->backendType));
 
         bool foundBackend = false;
         for (std::unique_ptr<BackendConnection>& backend : mBackends) {
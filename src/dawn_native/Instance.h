@@ -17,14 +17,18 @@
 
 #include "common/RefCounted.h"
 #include "dawn_native/Adapter.h"
+#include "dawn_native/AttachmentState.h"
 #include "dawn_native/BackendConnection.h"
 #include "dawn_native/Extensions.h"
 #include "dawn_native/Toggles.h"
 #include "dawn_native/dawn_platform.h"
 
 #include <array>
+#include <bitset>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace dawn_native {
@@ -38,6 +42,9 @@ namespace dawn_native {
         static InstanceBase* Create(const InstanceDescriptor* descriptor = nullptr);
 
         void DiscoverDefaultAdapters();
+        // Same as DiscoverDefaultAdapters but only connects and queries |backendType|, so
+        // the other compiled backends don't load their drivers or bootstrap a context.
+        void DiscoverDefaultAdapters(wgpu::BackendType backendType);
         bool DiscoverAdapters(const AdapterDiscoveryOptionsBase* options);
 
         const std::vector<std::unique_ptr<AdapterBase>>& GetAdapters() const;
@@ -66,12 +73,27 @@ namespace dawn_native {
         void SetPlatform(dawn_platform::Platform* platform);
         dawn_platform::Platform* GetPlatform() const;
 
+        // AttachmentStates are entirely frontend state so they are deduplicated here rather
+        // than per-device: in a multi-device setup every device reuses the same objects
+        // instead of rebuilding an identical cache. Guarded by a mutex because sibling
+        // devices may create and release states concurrently.
+        Ref<AttachmentState> GetOrCreateAttachmentState(AttachmentStateBlueprint* blueprint,
+                                                        DeviceBase* device);
+        void UncacheAttachmentState(AttachmentState* obj);
+
+        // Memo of SPIR-V blobs that already passed spirv-val, keyed by their hash. Devices
+        // recreated after a loss share the instance, so a warm restart only revalidates
+        // shaders it has never seen. Guarded by a mutex like the attachment state cache
+        // since sibling devices create modules concurrently.
+        bool IsSpirvValidated(size_t blobHash) const;
+        void MarkSpirvValidated(size_t blobHash);
+
         // Dawn API
         Surface* CreateSurface(const SurfaceDescriptor* descriptor);
 
       private:
         InstanceBase() = default;
-        ~InstanceBase() = default;
+        ~InstanceBase();
 
         InstanceBase(const InstanceBase& other) = delete;
         InstanceBase& operator=(const InstanceBase& other) = delete;
@@ -80,11 +102,22 @@ namespace dawn_native {
 
         // Lazily creates connections to all backends that have been compiled.
         void EnsureBackendConnections();
+        // Lazily creates the connection(s) to a single backend. Used by the filtered
+        // discovery paths so asking for one backend doesn't pay the library load and
+        // context bootstrap cost of the others.
+        void EnsureBackendConnection(wgpu::BackendType backendType);
+
+        void DiscoverDefaultAdaptersForBackend(BackendConnection* backend);
 
         MaybeError DiscoverAdaptersInternal(const AdapterDiscoveryOptionsBase* options);
 
+        // One entry per wgpu::BackendType value.
+        static constexpr uint32_t kBackendTypeCount = 7;
+
         bool mBackendsConnected = false;
         bool mDiscoveredDefaultAdapters = false;
+        std::bitset<kBackendTypeCount> mConnectedBackends;
+        std::bitset<kBackendTypeCount> mDefaultAdaptersDiscovered;
 
         bool mEnableBackendValidation = false;
         bool mBeginCaptureOnStartup = false;
@@ -96,6 +129,15 @@ namespace dawn_native {
 
         ExtensionsInfo mExtensionsInfo;
         TogglesInfo mTogglesInfo;
+
+        mutable std::mutex mValidatedSpirvMutex;
+        std::unordered_set<size_t> mValidatedSpirvHashes;
+
+        std::mutex mAttachmentStateCacheMutex;
+        std::unordered_set<AttachmentStateBlueprint*,
+                           AttachmentStateBlueprint::HashFunc,
+                           AttachmentStateBlueprint::EqualityFunc>
+            mAttachmentStateCache;
     };
 
 }  // namespace dawn_native
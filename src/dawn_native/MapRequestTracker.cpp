@@ -16,6 +16,8 @@
 #include "dawn_native/Buffer.h"
 #include "dawn_native/Device.h"
 
+#include <vector>
+
 namespace dawn_native {
     struct Request;
     class DeviceBase;
@@ -37,9 +39,20 @@ namespace dawn_native {
     }
 
     void MapRequestTracker::Tick(Serial finishedSerial) {
+        // Move the completed requests out of the queue before dispatching anything: a
+        // callback can map a buffer again and re-enter Track, which must not mutate the
+        // queue while it is iterated. This also dispatches the whole batch in one pass,
+        // so the callbacks of a tick (and the wire return commands they serialize) are
+        // emitted back to back instead of interleaved with tracker bookkeeping, and a
+        // wire transport sends them as one message on the next flush.
+        std::vector<Request> completedRequests;
         for (auto& request : mInflightRequests.IterateUpTo(finishedSerial)) {
-            request.buffer->OnMapCommandSerialFinished(request.mapSerial, request.isWrite);
+            completedRequests.push_back(std::move(request));
         }
         mInflightRequests.ClearUpTo(finishedSerial);
+
+        for (Request& request : completedRequests) {
+            request.buffer->OnMapCommandSerialFinished(request.mapSerial, request.isWrite);
+        }
     }
 }  // namespace dawn_native
\ No newline at end of file
@@ -0,0 +1,65 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_MEMORYSTATS_H_
+#define DAWNNATIVE_MEMORYSTATS_H_
+
+#include <array>
+#include <cstdint>
+
+namespace dawn_native {
+
+    // The coarse classes device memory allocations are accounted under. Backends tag every
+    // allocation they request with the class of the resource it backs.
+    enum class AllocationClass : uint32_t {
+        Texture,
+        Buffer,
+        // The memory holding built acceleration containers.
+        AccelerationContainerResult,
+        // The transient memory acceleration container builds and updates scribble in.
+        AccelerationContainerScratch,
+        Staging,
+    };
+
+    static constexpr uint32_t kAllocationClassCount = 5u;
+
+    // Counters for a single allocation class. Sizes are the sizes the allocators reserved,
+    // which may be larger than what the resources requested because of alignment.
+    struct MemoryClassStats {
+        uint64_t liveSize = 0;
+        uint64_t peakSize = 0;
+        uint64_t liveAllocationCount = 0;
+    };
+
+    // A snapshot of the device's memory usage with per-class breakdown, returned by
+    // DeviceBase::GetMemoryStats.
+    struct MemoryStats {
+        std::array<MemoryClassStats, kAllocationClassCount> classStats;
+
+        const MemoryClassStats& Get(AllocationClass allocationClass) const {
+            return classStats[static_cast<uint32_t>(allocationClass)];
+        }
+
+        uint64_t TotalLiveSize() const {
+            uint64_t total = 0;
+            for (const MemoryClassStats& stats : classStats) {
+                total += stats.liveSize;
+            }
+            return total;
+        }
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_MEMORYSTATS_H_
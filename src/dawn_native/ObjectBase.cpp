@@ -14,6 +14,8 @@
 
 #include "dawn_native/ObjectBase.h"
 
+#include "dawn_native/Device.h"
+
 namespace dawn_native {
 
     static constexpr uint64_t kErrorPayload = 0;
@@ -34,4 +36,12 @@ namespace dawn_native {
         return GetRefCountPayload() == kErrorPayload;
     }
 
+    void ObjectBase::RunDeferredDeletion() {
+        DeleteThis();
+    }
+
+    bool ObjectBase::DeferDeleteThis() {
+        return mDevice->DeferDeleteObject(this);
+    }
+
 }  // namespace dawn_native
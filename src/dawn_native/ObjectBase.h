@@ -32,9 +32,16 @@ namespace dawn_native {
         DeviceBase* GetDevice() const;
         bool IsError() const;
 
+        // Runs the deletion of an object previously enqueued on the device's deferred
+        // deletion list by DeferDeleteThis(). Only called by DeviceBase when draining the
+        // list on Tick.
+        void RunDeferredDeletion();
+
       protected:
         ~ObjectBase() override = default;
 
+        bool DeferDeleteThis() override;
+
       private:
         DeviceBase* mDevice;
     };
@@ -15,29 +15,74 @@
 #include "dawn_native/PassResourceUsageTracker.h"
 
 #include "dawn_native/Buffer.h"
+#include "dawn_native/EncodingContext.h"
 #include "dawn_native/Texture.h"
 
+#include <utility>
+
 namespace dawn_native {
-    PassResourceUsageTracker::PassResourceUsageTracker(PassType passType) : mPassType(passType) {
+
+    void PassResourceUsageStoragePool::SetPassCapacityHint(size_t resourceCount) {
+        if (resourceCount > mPassCapacityHint) {
+            mPassCapacityHint = resourceCount;
+        }
+    }
+
+    size_t PassResourceUsageStoragePool::GetPassCapacityHint() const {
+        return mPassCapacityHint;
+    }
+
+    PassResourceUsageTracker::PassResourceUsageTracker(PassType passType,
+                                                       EncodingContext* encodingContext)
+        : mPassType(passType), mEncodingContext(encodingContext) {
+    }
+
+    // Takes the recycled slot storage out of the pool on the first insertion. Done lazily so
+    // trackers that are created and immediately replaced (RenderPassEncoder is constructed
+    // with a tracker that BeginRenderPass already filled) don't take or size any storage.
+    void PassResourceUsageTracker::EnsureStorage() {
+        if (mEncodingContext == nullptr || mStorageAcquired) {
+            return;
+        }
+        mStorageAcquired = true;
+        mStoragePool = mEncodingContext->GetUsageTrackerStoragePool();
+        if (!mStoragePool->mBufferSlots.empty()) {
+            mBufferUsages.RecycleSlots(std::move(mStoragePool->mBufferSlots));
+        }
+        if (!mStoragePool->mTextureSlots.empty()) {
+            mTextureUsages.RecycleSlots(std::move(mStoragePool->mTextureSlots));
+        }
+        mBufferUsages.Reserve(mStoragePool->GetPassCapacityHint());
+        mTextureUsages.Reserve(mStoragePool->GetPassCapacityHint());
     }
 
     void PassResourceUsageTracker::BufferUsedAs(BufferBase* buffer, wgpu::BufferUsage usage) {
-        // std::map's operator[] will create the key and return 0 if the key didn't exist
+        // Buffers frozen into a read-only state covering this usage were transitioned once
+        // at freeze time and need no further barriers, so they skip per-pass tracking
+        // entirely. Usages not covered by the frozen state fall through and are rejected
+        // by ValidatePassResourceUsage.
+        if (buffer->IsFrozenForUsage(usage)) {
+            return;
+        }
+
+        EnsureStorage();
+        // operator[] will create the key and return a zero usage if the key didn't exist
         // before.
         mBufferUsages[buffer] |= usage;
     }
 
     void PassResourceUsageTracker::TextureViewUsedAs(TextureViewBase* view,
                                                      wgpu::TextureUsage usage) {
+        EnsureStorage();
+
         TextureBase* texture = view->GetTexture();
         uint32_t baseMipLevel = view->GetBaseMipLevel();
         uint32_t levelCount = view->GetLevelCount();
         uint32_t baseArrayLayer = view->GetBaseArrayLayer();
         uint32_t layerCount = view->GetLayerCount();
 
-        // std::map's operator[] will create the key and return a PassTextureUsage with usage = 0
+        // operator[] will create the key and return a PassTextureUsage with usage = 0
         // and an empty vector for subresourceUsages.
-        // TODO (yunchao.he@intel.com): optimize this
         PassTextureUsage& textureUsage = mTextureUsages[texture];
 
         // Set usage for the whole texture
@@ -61,6 +106,8 @@ namespace dawn_native {
 
     void PassResourceUsageTracker::AddTextureUsage(TextureBase* texture,
                                                    const PassTextureUsage& textureUsage) {
+        EnsureStorage();
+
         PassTextureUsage& passTextureUsage = mTextureUsages[texture];
         passTextureUsage.usage |= textureUsage.usage;
 
@@ -84,19 +131,27 @@ namespace dawn_native {
         result.textures.reserve(mTextureUsages.size());
         result.textureUsages.reserve(mTextureUsages.size());
 
-        for (auto& it : mBufferUsages) {
-            result.buffers.push_back(it.first);
-            result.bufferUsages.push_back(it.second);
+        size_t resourceCount = mBufferUsages.size() + mTextureUsages.size();
+
+        mBufferUsages.Iterate([&](BufferBase* buffer, wgpu::BufferUsage& usage) {
+            result.buffers.push_back(buffer);
+            result.bufferUsages.push_back(usage);
+        });
+
+        mTextureUsages.Iterate([&](TextureBase* texture, PassTextureUsage& usage) {
+            result.textures.push_back(texture);
+            result.textureUsages.push_back(std::move(usage));
+        });
+
+        // Return the slot storage to the pool so the next pass of the encoder can reuse it
+        // instead of growing its own tables from scratch.
+        if (mStoragePool != nullptr && mStorageAcquired) {
+            mStorageAcquired = false;
+            mStoragePool->SetPassCapacityHint(resourceCount);
+            mStoragePool->mBufferSlots = mBufferUsages.AcquireSlots();
+            mStoragePool->mTextureSlots = mTextureUsages.AcquireSlots();
         }
 
-        for (auto& it : mTextureUsages) {
-            result.textures.push_back(it.first);
-            result.textureUsages.push_back(std::move(it.second));
-        }
-
-        mBufferUsages.clear();
-        mTextureUsages.clear();
-
         return result;
     }
 
@@ -17,33 +17,166 @@
 
 #include "dawn_native/PassResourceUsage.h"
 
+#include "common/Assert.h"
+#include "common/HashUtils.h"
+#include "common/Math.h"
 #include "dawn_native/dawn_platform.h"
 
-#include <map>
+#include <vector>
 
 namespace dawn_native {
 
     class BufferBase;
+    class EncodingContext;
     class TextureBase;
 
+    // Open-addressing hash table keyed by resource pointer, used instead of std::map for
+    // per-pass usage tracking: linear probing over a flat power-of-two slot array stays cache
+    // friendly for passes that use hundreds of resources, and the slot storage can be recycled
+    // across passes through PassResourceUsageStoragePool below so tracking is allocation-free
+    // at steady state.
+    template <typename Key, typename Value>
+    class ResourceUsageMap {
+      public:
+        struct Slot {
+            Key key = nullptr;
+            Value value = {};
+        };
+        using SlotVector = std::vector<Slot>;
+
+        // Inserts `key` if it wasn't present and returns its value, default-constructed on
+        // insertion so usages can be ORed in like with std::map::operator[].
+        Value& operator[](Key key) {
+            ASSERT(key != nullptr);
+            if (3 * mSize >= 2 * mSlots.size()) {
+                Rehash(mSlots.empty() ? kMinSlotCount : 2 * mSlots.size());
+            }
+            Slot* slot = FindSlot(key);
+            if (slot->key == nullptr) {
+                slot->key = key;
+                mSize++;
+            }
+            return slot->value;
+        }
+
+        size_t size() const {
+            return mSize;
+        }
+
+        // Calls f(key, value&) for each entry, in unspecified order.
+        template <typename F>
+        void Iterate(F f) {
+            for (Slot& slot : mSlots) {
+                if (slot.key != nullptr) {
+                    f(slot.key, slot.value);
+                }
+            }
+        }
+
+        // Pre-sizes the table so `capacity` entries can be inserted without rehashing.
+        void Reserve(size_t capacity) {
+            size_t slotCount = NextPowerOfTwo(2 * capacity);
+            if (slotCount < kMinSlotCount) {
+                slotCount = kMinSlotCount;
+            }
+            if (slotCount > mSlots.size()) {
+                Rehash(slotCount);
+            }
+        }
+
+        // Gives up the slot storage so it can be recycled, leaving the map empty.
+        SlotVector AcquireSlots() {
+            mSize = 0;
+            return std::move(mSlots);
+        }
+
+        // Adopts recycled slot storage. Must only be called on an empty map.
+        void RecycleSlots(SlotVector slots) {
+            ASSERT(mSize == 0);
+            for (Slot& slot : slots) {
+                slot = Slot();
+            }
+            mSlots = std::move(slots);
+        }
+
+      private:
+        // Slot count for the first insertion, chosen so small passes get a single tiny
+        // allocation (or none at all once the storage is recycled).
+        static constexpr size_t kMinSlotCount = 16;
+
+        Slot* FindSlot(Key key) {
+            ASSERT(IsPowerOfTwo(mSlots.size()));
+            // HashCombine mixes the low bits so the pointer's alignment zeroes don't cluster
+            // consecutive slots.
+            size_t hash = 0;
+            HashCombine(&hash, key);
+            size_t mask = mSlots.size() - 1;
+            size_t index = hash & mask;
+            while (mSlots[index].key != key && mSlots[index].key != nullptr) {
+                index = (index + 1) & mask;
+            }
+            return &mSlots[index];
+        }
+
+        void Rehash(size_t slotCount) {
+            SlotVector oldSlots = std::move(mSlots);
+            mSlots = SlotVector(slotCount);
+            for (Slot& slot : oldSlots) {
+                if (slot.key != nullptr) {
+                    *FindSlot(slot.key) = std::move(slot);
+                }
+            }
+        }
+
+        SlotVector mSlots;
+        size_t mSize = 0;
+    };
+
+    // Recycles the slot storage of PassResourceUsageTrackers between the passes of an encoder
+    // so steady-state usage tracking doesn't allocate. Owned by the encoder's EncodingContext.
+    class PassResourceUsageStoragePool {
+      public:
+        // Hints the number of resources a pass is expected to use so trackers pre-size their
+        // tables instead of growing them incrementally. The pool raises the hint to the
+        // largest pass it has seen, so recycled storage reaches a steady state on its own.
+        void SetPassCapacityHint(size_t resourceCount);
+        size_t GetPassCapacityHint() const;
+
+      private:
+        friend class PassResourceUsageTracker;
+
+        ResourceUsageMap<BufferBase*, wgpu::BufferUsage>::SlotVector mBufferSlots;
+        ResourceUsageMap<TextureBase*, PassTextureUsage>::SlotVector mTextureSlots;
+        size_t mPassCapacityHint = 0;
+    };
+
     // Helper class to encapsulate the logic of tracking per-resource usage during the
     // validation of command buffer passes. It is used both to know if there are validation
     // errors, and to get a list of resources used per pass for backends that need the
     // information.
     class PassResourceUsageTracker {
       public:
-        PassResourceUsageTracker(PassType passType);
+        // The encoding context is used to recycle tracking storage across passes. It is only
+        // dereferenced on the first tracked usage: pass encoders hand their context to the
+        // base class constructor before it is fully constructed.
+        PassResourceUsageTracker(PassType passType, EncodingContext* encodingContext = nullptr);
         void BufferUsedAs(BufferBase* buffer, wgpu::BufferUsage usage);
         void TextureViewUsedAs(TextureViewBase* texture, wgpu::TextureUsage usage);
         void AddTextureUsage(TextureBase* texture, const PassTextureUsage& textureUsage);
 
-        // Returns the per-pass usage for use by backends for APIs with explicit barriers.
+        // Returns the per-pass usage for use by backends for APIs with explicit barriers, and
+        // returns the tracking storage to the pool for the next pass.
         PassResourceUsage AcquireResourceUsage();
 
       private:
+        void EnsureStorage();
+
         PassType mPassType;
-        std::map<BufferBase*, wgpu::BufferUsage> mBufferUsages;
-        std::map<TextureBase*, PassTextureUsage> mTextureUsages;
+        EncodingContext* mEncodingContext;
+        PassResourceUsageStoragePool* mStoragePool = nullptr;
+        bool mStorageAcquired = false;
+        ResourceUsageMap<BufferBase*, wgpu::BufferUsage> mBufferUsages;
+        ResourceUsageMap<TextureBase*, PassTextureUsage> mTextureUsages;
     };
 
 }  // namespace dawn_native
@@ -0,0 +1,69 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/PersistentCache.h"
+
+#include "dawn_native/Device.h"
+#include "dawn_platform/DawnPlatform.h"
+
+namespace dawn_native {
+
+    namespace {
+
+        // Owns the copies handed to the worker; deleted by the task after the store.
+        struct StoreTask {
+            dawn_platform::CachingInterface* cache;
+            PersistentCacheKey key;
+            std::vector<uint8_t> value;
+        };
+
+        void RunStoreTask(void* userdata) {
+            StoreTask* task = static_cast<StoreTask*>(userdata);
+            task->cache->StoreData(task->key.data(), task->key.size(), task->value.data(),
+                                   task->value.size());
+            delete task;
+        }
+
+    }  // anonymous namespace
+
+    PersistentCache::PersistentCache(DeviceBase* device)
+        : mDevice(device), mCache(device->GetPlatform()->GetCachingInterface()) {
+    }
+
+    std::vector<uint8_t> PersistentCache::LoadData(const PersistentCacheKey& key) {
+        if (mCache == nullptr) {
+            return {};
+        }
+        size_t entrySize = mCache->LoadData(key.data(), key.size(), nullptr, 0);
+        if (entrySize == 0) {
+            return {};
+        }
+        std::vector<uint8_t> entry(entrySize);
+        mCache->LoadData(key.data(), key.size(), entry.data(), entry.size());
+        return entry;
+    }
+
+    void PersistentCache::StoreData(const PersistentCacheKey& key, const void* value, size_t size) {
+        if (mCache == nullptr || size == 0) {
+            return;
+        }
+        StoreTask* task = new StoreTask;
+        task->cache = mCache;
+        task->key = key;
+        task->value.assign(static_cast<const uint8_t*>(value),
+                           static_cast<const uint8_t*>(value) + size);
+        mDevice->GetPlatform()->GetWorkerTaskPool()->PostWorkerTask(RunStoreTask, task);
+    }
+
+}  // namespace dawn_native
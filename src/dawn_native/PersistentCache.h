@@ -0,0 +1,58 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_PERSISTENTCACHE_H_
+#define DAWNNATIVE_PERSISTENTCACHE_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace dawn_platform {
+    class CachingInterface;
+}  // namespace dawn_platform
+
+namespace dawn_native {
+
+    class DeviceBase;
+
+    // A key is an arbitrary byte string. Producers serialize everything the cached value
+    // depends on into it - the shader content itself, the backend, the compiler identity
+    // and flags - so that equal keys always denote equal values and a hit can never
+    // return another shader's artifact.
+    using PersistentCacheKey = std::vector<uint8_t>;
+
+    // Thin frontend over the platform's CachingInterface used by the backends to reuse
+    // compiled shader blobs across device (and process) lifetimes. Loads are synchronous
+    // because the caller needs the value to proceed; stores are queued to a worker so
+    // creation paths never block on the embedder's storage.
+    class PersistentCache {
+      public:
+        explicit PersistentCache(DeviceBase* device);
+
+        // Returns the cached entry for |key|, or an empty vector when the platform
+        // provides no cache or the key is absent.
+        std::vector<uint8_t> LoadData(const PersistentCacheKey& key);
+
+        // Copies |value| and queues it to be handed to the platform cache on a worker.
+        // A no-op when the platform provides no cache.
+        void StoreData(const PersistentCacheKey& key, const void* value, size_t size);
+
+      private:
+        DeviceBase* mDevice = nullptr;
+        dawn_platform::CachingInterface* mCache = nullptr;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_PERSISTENTCACHE_H_
@@ -36,6 +36,34 @@ namespace dawn_native {
         if (layout != nullptr && !descriptor->module->IsCompatibleWithPipelineLayout(layout)) {
             return DAWN_VALIDATION_ERROR("Stage not compatible with layout");
         }
+        DAWN_TRY(
+            ValidatePipelineConstants(device, descriptor->constantCount, descriptor->constants));
+        return {};
+    }
+
+    MaybeError ValidatePipelineConstants(const DeviceBase* device,
+                                         uint32_t constantCount,
+                                         const PipelineConstantEntry* constants) {
+        if (constantCount == 0) {
+            return {};
+        }
+        if (!device->IsExtensionEnabled(Extension::SpecializationConstants)) {
+            return DAWN_VALIDATION_ERROR(
+                "The specialization_constants extension is not enabled");
+        }
+        if (constants == nullptr) {
+            return DAWN_VALIDATION_ERROR("Pipeline constants must not be null");
+        }
+        // Each entry provides the raw 32-bit value of one specialization constant;
+        // duplicate ids would make the specialization ambiguous. Constant counts are
+        // small so the quadratic check is fine.
+        for (uint32_t i = 0; i < constantCount; ++i) {
+            for (uint32_t j = i + 1; j < constantCount; ++j) {
+                if (constants[i].constantId == constants[j].constantId) {
+                    return DAWN_VALIDATION_ERROR("Duplicate pipeline constant id");
+                }
+            }
+        }
         return {};
     }
 
@@ -33,6 +33,12 @@ namespace dawn_native {
                                                    const PipelineLayoutBase* layout,
                                                    SingleShaderStage stage);
 
+    // Validates the specialization constants of a pipeline stage. Shared with the ray
+    // tracing shader binding table, whose stages carry the same constant entries.
+    MaybeError ValidatePipelineConstants(const DeviceBase* device,
+                                         uint32_t constantCount,
+                                         const PipelineConstantEntry* constants);
+
     class PipelineBase : public CachedObject {
       public:
         wgpu::ShaderStage GetStageMask() const;
@@ -53,8 +53,10 @@ namespace dawn_native {
                            wgpu::ShaderStage::Compute;
 
                 case wgpu::BindingType::AccelerationContainer:
+                    // compute is included for inline ray queries
                     return wgpu::ShaderStage::RayGeneration | wgpu::ShaderStage::RayAnyHit |
-                           wgpu::ShaderStage::RayClosestHit | wgpu::ShaderStage::RayMiss;
+                           wgpu::ShaderStage::RayClosestHit | wgpu::ShaderStage::RayMiss |
+                           wgpu::ShaderStage::Compute;
             }
 
             return {};
@@ -102,6 +104,7 @@ namespace dawn_native {
         for (uint32_t group = 0; group < descriptor->bindGroupLayoutCount; ++group) {
             mBindGroupLayouts[group] = descriptor->bindGroupLayouts[group];
             mMask.set(group);
+            mCompatibilityTokens[group] = mBindGroupLayouts[group]->GetCompatibilityToken();
         }
     }
 
@@ -156,7 +159,7 @@ namespace dawn_native {
                     bindingSlot.binding = bindingNumber;
 
                     DAWN_TRY(ValidateBindingTypeWithShaderStageVisibility(
-                        bindingInfo.type, StageBit(module->GetExecutionModel())));
+                        device, bindingInfo.type, StageBit(module->GetExecutionModel())));
                     DAWN_TRY(ValidateStorageTextureFormat(device, bindingInfo.type,
                                                           bindingInfo.storageTextureFormat));
 
@@ -252,6 +255,12 @@ namespace dawn_native {
         return mMask;
     }
 
+    const std::array<uint64_t, kMaxBindGroups>& PipelineLayoutBase::GetBindGroupCompatibilityTokens()
+        const {
+        ASSERT(!IsError());
+        return mCompatibilityTokens;
+    }
+
     std::bitset<kMaxBindGroups> PipelineLayoutBase::InheritedGroupsMask(
         const PipelineLayoutBase* other) const {
         ASSERT(!IsError());
@@ -45,6 +45,10 @@ namespace dawn_native {
         BindGroupLayoutBase* GetBindGroupLayout(uint32_t group);
         const std::bitset<kMaxBindGroups> GetBindGroupLayoutsMask() const;
 
+        // The compatibility tokens of the bind group layouts, 0 for unused slots; see
+        // BindGroupLayoutBase::GetCompatibilityToken.
+        const std::array<uint64_t, kMaxBindGroups>& GetBindGroupCompatibilityTokens() const;
+
         // Utility functions to compute inherited bind groups.
         // Returns the inherited bind groups as a mask.
         std::bitset<kMaxBindGroups> InheritedGroupsMask(const PipelineLayoutBase* other) const;
@@ -66,6 +70,7 @@ namespace dawn_native {
 
         BindGroupLayoutArray mBindGroupLayouts;
         std::bitset<kMaxBindGroups> mMask;
+        std::array<uint64_t, kMaxBindGroups> mCompatibilityTokens = {};
     };
 
 }  // namespace dawn_native
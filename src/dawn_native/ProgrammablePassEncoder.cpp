@@ -14,6 +14,7 @@
 
 #include "dawn_native/ProgrammablePassEncoder.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "common/BitSetIterator.h"
@@ -88,14 +89,26 @@ namespace dawn_native {
     ProgrammablePassEncoder::ProgrammablePassEncoder(DeviceBase* device,
                                                      EncodingContext* encodingContext,
                                                      PassType passType)
-        : ObjectBase(device), mEncodingContext(encodingContext), mUsageTracker(passType) {
+        : ObjectBase(device),
+          mEncodingContext(encodingContext),
+          mUsageTracker(passType, encodingContext) {
     }
 
     ProgrammablePassEncoder::ProgrammablePassEncoder(DeviceBase* device,
                                                      EncodingContext* encodingContext,
                                                      ErrorTag errorTag,
                                                      PassType passType)
-        : ObjectBase(device, errorTag), mEncodingContext(encodingContext), mUsageTracker(passType) {
+        : ObjectBase(device, errorTag),
+          mEncodingContext(encodingContext),
+          mUsageTracker(passType, encodingContext) {
+    }
+
+    void ProgrammablePassEncoder::ForgetLastSetState() {
+        mLastBindGroups.fill(nullptr);
+    }
+
+    void ProgrammablePassEncoder::TrackBindGroupUsage(BindGroupBase* group) {
+        TrackBindGroupResourceUsage(&mUsageTracker, group);
     }
 
     void ProgrammablePassEncoder::InsertDebugMarker(const char* groupLabel) {
@@ -150,41 +163,32 @@ namespace dawn_native {
                     return DAWN_VALIDATION_ERROR("dynamicOffset count mismatch");
                 }
 
-                for (BindingIndex i = 0; i < dynamicOffsetCount; ++i) {
-                    const BindingInfo& bindingInfo = layout->GetBindingInfo(i);
-
-                    // BGL creation sorts bindings such that the dynamic buffer bindings are first.
-                    // ASSERT that this true.
-                    ASSERT(bindingInfo.hasDynamicOffset);
-                    switch (bindingInfo.type) {
-                        case wgpu::BindingType::UniformBuffer:
-                        case wgpu::BindingType::StorageBuffer:
-                        case wgpu::BindingType::ReadonlyStorageBuffer:
-                            break;
-                        default:
-                            UNREACHABLE();
-                            break;
-                    }
-
+                // Offsets are compared against the limits precomputed at bind group creation,
+                // which keeps this hot loop a flat compare over uint32s with no pointer
+                // chasing through the layout's binding info or the buffer bindings.
+                const uint32_t* maxDynamicOffsets = group->GetMaxDynamicOffsets();
+                for (uint32_t i = 0; i < dynamicOffsetCount; ++i) {
                     if (dynamicOffsets[i] % kMinDynamicBufferOffsetAlignment != 0) {
                         return DAWN_VALIDATION_ERROR("Dynamic Buffer Offset need to be aligned");
                     }
 
-                    BufferBinding bufferBinding = group->GetBindingAsBufferBinding(i);
-
-                    // During BindGroup creation, validation ensures binding offset + binding size
-                    // <= buffer size.
-                    ASSERT(bufferBinding.buffer->GetSize() >= bufferBinding.size);
-                    ASSERT(bufferBinding.buffer->GetSize() - bufferBinding.size >=
-                           bufferBinding.offset);
-
-                    if ((dynamicOffsets[i] > bufferBinding.buffer->GetSize() -
-                                                 bufferBinding.offset - bufferBinding.size)) {
+                    if (dynamicOffsets[i] > maxDynamicOffsets[i]) {
                         return DAWN_VALIDATION_ERROR("dynamic offset out of bounds");
                     }
                 }
             }
 
+            // Middleware frequently re-sets identical bind groups between draws. Skip
+            // recording when nothing changed so the command tape and the backend replay
+            // only see real state transitions. The group's resource usages were already
+            // tracked when it was first set.
+            if (groupIndex < kMaxBindGroups && group == mLastBindGroups[groupIndex] &&
+                dynamicOffsetCount <= kMaxDynamicBufferCount &&
+                std::equal(dynamicOffsets, dynamicOffsets + dynamicOffsetCount,
+                           mLastDynamicOffsets[groupIndex].begin())) {
+                return {};
+            }
+
             SetBindGroupCmd* cmd = allocator->Allocate<SetBindGroupCmd>(Command::SetBindGroup);
             cmd->index = groupIndex;
             cmd->group = group;
@@ -194,10 +198,50 @@ namespace dawn_native {
                 memcpy(offsets, dynamicOffsets, dynamicOffsetCount * sizeof(uint32_t));
             }
 
+            if (groupIndex < kMaxBindGroups && dynamicOffsetCount <= kMaxDynamicBufferCount) {
+                mLastBindGroups[groupIndex] = group;
+                std::copy(dynamicOffsets, dynamicOffsets + dynamicOffsetCount,
+                          mLastDynamicOffsets[groupIndex].begin());
+            }
+
             TrackBindGroupResourceUsage(&mUsageTracker, group);
 
             return {};
         });
     }
 
+    void ProgrammablePassEncoder::SetImmediateData(uint32_t offset, uint32_t size,
+                                                   const void* data) {
+        mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (GetDevice()->IsValidationEnabled()) {
+                if (!GetDevice()->IsExtensionEnabled(Extension::ImmediateData)) {
+                    return DAWN_VALIDATION_ERROR("The immediate_data extension is not enabled");
+                }
+
+                if (size == 0) {
+                    return DAWN_VALIDATION_ERROR("Immediate data size must be greater than 0");
+                }
+
+                if (offset % 4 != 0 || size % 4 != 0) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Immediate data offset and size must be a multiple of 4 bytes");
+                }
+
+                if (uint64_t(offset) + size > kMaxImmediateDataBytes) {
+                    return DAWN_VALIDATION_ERROR("Immediate data out of bounds");
+                }
+            }
+
+            SetImmediateDataCmd* cmd =
+                allocator->Allocate<SetImmediateDataCmd>(Command::SetImmediateData);
+            cmd->offset = offset;
+            cmd->size = size;
+
+            uint8_t* storedData = allocator->AllocateData<uint8_t>(size);
+            memcpy(storedData, data, size);
+
+            return {};
+        });
+    }
+
 }  // namespace dawn_native
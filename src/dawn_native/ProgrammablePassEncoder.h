@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_PROGRAMMABLEPASSENCODER_H_
 #define DAWNNATIVE_PROGRAMMABLEPASSENCODER_H_
 
+#include "common/Constants.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/ObjectBase.h"
@@ -22,6 +23,8 @@
 
 #include "dawn_native/dawn_platform.h"
 
+#include <array>
+
 namespace dawn_native {
 
     class CommandAllocator;
@@ -43,6 +46,8 @@ namespace dawn_native {
                           uint32_t dynamicOffsetCount,
                           const uint32_t* dynamicOffsets);
 
+        void SetImmediateData(uint32_t offset, uint32_t size, const void* data);
+
       protected:
         // Construct an "error" programmable pass encoder.
         ProgrammablePassEncoder(DeviceBase* device,
@@ -52,6 +57,23 @@ namespace dawn_native {
 
         EncodingContext* mEncodingContext = nullptr;
         PassResourceUsageTracker mUsageTracker;
+
+        // Forgets the last-set bind groups used for redundant set elimination, so following
+        // sets are recorded even when they repeat earlier ones. Called when the recorded
+        // state is clobbered out-of-band, e.g. by ExecuteBundles resetting pass state.
+        void ForgetLastSetState();
+
+        // Records |group|'s resource usages in the pass usage tracker, as SetBindGroup
+        // does. For commands that bind a group as a side effect.
+        void TrackBindGroupUsage(BindGroupBase* group);
+
+      private:
+        // Last-set bind group state used to skip recording redundant SetBindGroup calls.
+        // The previously recorded command holds a reference to the group, so the raw
+        // pointer cannot be reused for a different object while this encoder is alive.
+        std::array<BindGroupBase*, kMaxBindGroups> mLastBindGroups = {};
+        std::array<std::array<uint32_t, kMaxDynamicBufferCount>, kMaxBindGroups>
+            mLastDynamicOffsets = {};
     };
 
 }  // namespace dawn_native
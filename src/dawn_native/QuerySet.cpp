@@ -0,0 +1,152 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/QuerySet.h"
+
+#include "common/Assert.h"
+#include "dawn_native/Device.h"
+#include "dawn_native/Extensions.h"
+#include "dawn_native/ValidationUtils_autogen.h"
+
+namespace dawn_native {
+
+    namespace {
+
+        class ErrorQuerySet : public QuerySetBase {
+          public:
+            ErrorQuerySet(DeviceBase* device) : QuerySetBase(device, ObjectBase::kError) {
+            }
+
+          private:
+            void DestroyImpl() override {
+                UNREACHABLE();
+            }
+        };
+
+    }  // anonymous namespace
+
+    MaybeError ValidateQuerySetDescriptor(DeviceBase* device,
+                                          const QuerySetDescriptor* descriptor) {
+        DAWN_TRY(ValidateQueryType(descriptor->type));
+
+        if (descriptor->count == 0) {
+            return DAWN_VALIDATION_ERROR("Query set must contain at least one query");
+        }
+
+        switch (descriptor->type) {
+            case wgpu::QueryType::Occlusion:
+                return DAWN_VALIDATION_ERROR("Occlusion queries are not supported");
+            case wgpu::QueryType::PipelineStatistics:
+                if (!device->IsExtensionEnabled(Extension::PipelineStatisticsQuery)) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Pipeline Statistics Query extension is not enabled");
+                }
+                if (descriptor->pipelineStatisticsCount == 0) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Pipeline statistics query set must request at least one statistic");
+                }
+                for (uint32_t i = 0; i < descriptor->pipelineStatisticsCount; ++i) {
+                    DAWN_TRY(ValidatePipelineStatisticName(descriptor->pipelineStatistics[i]));
+                    // Requiring ascending order keeps the resolved layout well-defined: it is
+                    // the order the Vulkan backend packs the statistics of a query in.
+                    if (i > 0 && descriptor->pipelineStatistics[i] <=
+                                     descriptor->pipelineStatistics[i - 1]) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Pipeline statistics must be unique and listed in ascending order");
+                    }
+                }
+                break;
+            case wgpu::QueryType::Timestamp:
+                if (!device->IsExtensionEnabled(Extension::TimestampQuery)) {
+                    return DAWN_VALIDATION_ERROR("Timestamp Query extension is not enabled");
+                }
+                break;
+            default:
+                UNREACHABLE();
+        }
+
+        if (descriptor->type != wgpu::QueryType::PipelineStatistics &&
+            descriptor->pipelineStatisticsCount > 0) {
+            return DAWN_VALIDATION_ERROR(
+                "Pipeline statistics may only be set on pipeline statistics query sets");
+        }
+
+        return {};
+    }
+
+    // QuerySetBase
+
+    QuerySetBase::QuerySetBase(DeviceBase* device, const QuerySetDescriptor* descriptor)
+        : ObjectBase(device), mQueryType(descriptor->type), mQueryCount(descriptor->count) {
+        for (uint32_t i = 0; i < descriptor->pipelineStatisticsCount; ++i) {
+            mPipelineStatistics.push_back(descriptor->pipelineStatistics[i]);
+        }
+    }
+
+    QuerySetBase::QuerySetBase(DeviceBase* device, ObjectBase::ErrorTag tag)
+        : ObjectBase(device, tag) {
+    }
+
+    QuerySetBase::~QuerySetBase() {
+    }
+
+    // static
+    QuerySetBase* QuerySetBase::MakeError(DeviceBase* device) {
+        return new ErrorQuerySet(device);
+    }
+
+    wgpu::QueryType QuerySetBase::GetQueryType() const {
+        return mQueryType;
+    }
+
+    uint32_t QuerySetBase::GetQueryCount() const {
+        return mQueryCount;
+    }
+
+    const std::vector<wgpu::PipelineStatisticName>& QuerySetBase::GetPipelineStatistics() const {
+        return mPipelineStatistics;
+    }
+
+    uint64_t QuerySetBase::GetQueryDataSize() const {
+        if (mQueryType == wgpu::QueryType::PipelineStatistics) {
+            return mPipelineStatistics.size() * sizeof(uint64_t);
+        }
+        return sizeof(uint64_t);
+    }
+
+    bool QuerySetBase::IsDestroyed() const {
+        return mIsDestroyed;
+    }
+
+    void QuerySetBase::Destroy() {
+        if (GetDevice()->ConsumedError(ValidateDestroy())) {
+            return;
+        }
+        ASSERT(!IsError());
+        DestroyInternal();
+    }
+
+    MaybeError QuerySetBase::ValidateDestroy() const {
+        DAWN_TRY(GetDevice()->ValidateObject(this));
+        return {};
+    }
+
+    void QuerySetBase::DestroyInternal() {
+        if (!mIsDestroyed) {
+            DestroyImpl();
+        }
+        mIsDestroyed = true;
+    }
+
+}  // namespace dawn_native
@@ -14,25 +14,46 @@
 
 #include "dawn_native/Queue.h"
 
+#include "common/Constants.h"
+#include "common/Counters.h"
+#include "common/Math.h"
 #include "dawn_native/Buffer.h"
 #include "dawn_native/CommandBuffer.h"
+#include "dawn_native/Commands.h"
 #include "dawn_native/Device.h"
-#include "dawn_native/ErrorScope.h"
-#include "dawn_native/ErrorScopeTracker.h"
+#include "dawn_native/DynamicUploader.h"
 #include "dawn_native/Fence.h"
 #include "dawn_native/FenceSignalTracker.h"
+#include "dawn_native/QueueWorkDoneTracker.h"
 #include "dawn_native/RayTracingAccelerationContainer.h"
 #include "dawn_native/Texture.h"
+#include "dawn_native/ValidationUtils_autogen.h"
 #include "dawn_platform/DawnPlatform.h"
 #include "dawn_platform/tracing/TraceEvent.h"
 
+#include <cstring>
+
 namespace dawn_native {
 
+    MaybeError ValidateQueueDescriptor(DeviceBase* device, const QueueDescriptor* descriptor) {
+        if (descriptor->nextInChain != nullptr) {
+            return DAWN_VALIDATION_ERROR("nextInChain must be nullptr");
+        }
+
+        DAWN_TRY(ValidateQueueType(descriptor->type));
+
+        return {};
+    }
+
     // QueueBase
 
     QueueBase::QueueBase(DeviceBase* device) : ObjectBase(device) {
     }
 
+    QueueBase::QueueBase(DeviceBase* device, const QueueDescriptor* descriptor)
+        : ObjectBase(device), mType(descriptor->type) {
+    }
+
     QueueBase::QueueBase(DeviceBase* device, ObjectBase::ErrorTag tag) : ObjectBase(device, tag) {
     }
 
@@ -41,6 +62,10 @@ namespace dawn_native {
         return new QueueBase(device, ObjectBase::kError);
     }
 
+    wgpu::QueueType QueueBase::GetQueueType() const {
+        return mType;
+    }
+
     MaybeError QueueBase::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) {
         UNREACHABLE();
         return {};
@@ -54,6 +79,7 @@ namespace dawn_native {
         }
 
         TRACE_EVENT0(device->GetPlatform(), General, "Queue::Submit");
+        DAWN_COUNTER_INCREMENT(device->GetCounters(), Submits);
         if (device->IsValidationEnabled() &&
             device->ConsumedError(ValidateSubmit(commandCount, commands))) {
             return;
@@ -63,8 +89,23 @@ namespace dawn_native {
         if (device->ConsumedError(SubmitImpl(commandCount, commands))) {
             return;
         }
-        device->GetErrorScopeTracker()->TrackUntilLastSubmitComplete(
-            device->GetCurrentErrorScope());
+        device->MarkErrorScopesUsedInSubmit();
+    }
+
+    void QueueBase::OnSubmittedWorkDone(wgpu::QueueWorkDoneCallback callback, void* userdata) {
+        DeviceBase* device = GetDevice();
+        if (device->ConsumedError(device->ValidateIsAlive())) {
+            callback(WGPUQueueWorkDoneStatus_DeviceLost, userdata);
+            return;
+        }
+        if (device->IsValidationEnabled() &&
+            device->ConsumedError(device->ValidateObject(this))) {
+            callback(WGPUQueueWorkDoneStatus_Error, userdata);
+            return;
+        }
+        ASSERT(!IsError());
+
+        device->GetQueueWorkDoneTracker()->TrackSubmittedWorkDone(callback, userdata);
     }
 
     void QueueBase::Signal(Fence* fence, uint64_t signalValue) {
@@ -76,8 +117,7 @@ namespace dawn_native {
 
         fence->SetSignaledValue(signalValue);
         device->GetFenceSignalTracker()->UpdateFenceOnComplete(fence, signalValue);
-        device->GetErrorScopeTracker()->TrackUntilLastSubmitComplete(
-            device->GetCurrentErrorScope());
+        device->MarkErrorScopesUsedInSubmit();
     }
 
     Fence* QueueBase::CreateFence(const FenceDescriptor* descriptor) {
@@ -92,6 +132,119 @@ namespace dawn_native {
         return new Fence(this, descriptor);
     }
 
+    void QueueBase::WriteBuffer(BufferBase* buffer,
+                                uint64_t bufferOffset,
+                                const void* data,
+                                size_t size) {
+        DeviceBase* device = GetDevice();
+        if (device->ConsumedError(ValidateWriteBuffer(buffer, bufferOffset, size))) {
+            return;
+        }
+        ASSERT(!IsError());
+
+        if (device->ConsumedError(WriteBufferImpl(buffer, bufferOffset, data, size))) {
+            return;
+        }
+    }
+
+    MaybeError QueueBase::WriteBufferImpl(BufferBase* buffer,
+                                          uint64_t bufferOffset,
+                                          const void* data,
+                                          size_t size) {
+        if (size == 0) {
+            return {};
+        }
+
+        DeviceBase* device = GetDevice();
+
+        // The data is staged in the persistently mapped upload ring and the copy is recorded
+        // into the pending command context, so it rides along with the next submit instead of
+        // requiring a command encoder and a submit of its own.
+        UploadHandle uploadHandle;
+        DAWN_TRY_ASSIGN(uploadHandle, device->GetDynamicUploader()->Allocate(
+                                          size, device->GetPendingCommandSerial()));
+        ASSERT(uploadHandle.mappedBuffer != nullptr);
+
+        StagingBufferBase::StreamingCopy(uploadHandle.mappedBuffer, data, size);
+
+        DAWN_TRY(device->CopyFromStagingToBuffer(uploadHandle.stagingBuffer,
+                                                 uploadHandle.startOffset, buffer, bufferOffset,
+                                                 size));
+
+        return {};
+    }
+
+    void QueueBase::WriteTexture(const TextureCopyView* destination,
+                                 const void* data,
+                                 uint64_t dataSize,
+                                 const TextureDataLayout* dataLayout,
+                                 const Extent3D* writeSize) {
+        DeviceBase* device = GetDevice();
+        if (device->ConsumedError(
+                ValidateWriteTexture(destination, dataSize, dataLayout, writeSize))) {
+            return;
+        }
+        ASSERT(!IsError());
+
+        if (device->ConsumedError(WriteTextureImpl(destination, data, dataLayout, writeSize))) {
+            return;
+        }
+    }
+
+    MaybeError QueueBase::WriteTextureImpl(const TextureCopyView* destination,
+                                           const void* data,
+                                           const TextureDataLayout* dataLayout,
+                                           const Extent3D* writeSize) {
+        if (writeSize->width == 0 || writeSize->height == 0 || writeSize->depth == 0) {
+            return {};
+        }
+
+        DeviceBase* device = GetDevice();
+        const Format& format = destination->texture->GetFormat();
+
+        const TexelBlockInfo blockInfo = GetTexelBlockInfo(format.format);
+        const uint32_t heightInBlocks = writeSize->height / blockInfo.height;
+        const uint32_t rowSize = writeSize->width / blockInfo.width * blockInfo.byteSize;
+
+        uint32_t srcBytesPerRow = dataLayout->bytesPerRow;
+        if (srcBytesPerRow == 0) {
+            srcBytesPerRow = rowSize;
+        }
+
+        // Repack the rows directly into the persistently mapped upload ring in the layout
+        // backends require for buffer-to-texture copies: bytesPerRow aligned for row pitch and
+        // the copy start aligned for placed copies. The data is staged exactly once; the
+        // application doesn't need to pre-pad its rows.
+        const uint32_t alignedBytesPerRow = Align(rowSize, kTextureBytesPerRowAlignment);
+        const uint64_t uploadSize = uint64_t(alignedBytesPerRow) * heightInBlocks;
+
+        UploadHandle uploadHandle;
+        DAWN_TRY_ASSIGN(uploadHandle, device->GetDynamicUploader()->Allocate(
+                                          uploadSize + kTextureCopyPlacementAlignment,
+                                          device->GetPendingCommandSerial()));
+        ASSERT(uploadHandle.mappedBuffer != nullptr);
+
+        const uint64_t alignedOffset =
+            RoundUp(uploadHandle.startOffset, kTextureCopyPlacementAlignment);
+        uint8_t* dstRows = uploadHandle.mappedBuffer + (alignedOffset - uploadHandle.startOffset);
+        const uint8_t* srcRows = static_cast<const uint8_t*>(data) + dataLayout->offset;
+
+        for (uint32_t row = 0; row < heightInBlocks; ++row) {
+            StagingBufferBase::StreamingCopy(dstRows + uint64_t(row) * alignedBytesPerRow,
+                                             srcRows + uint64_t(row) * srcBytesPerRow, rowSize);
+        }
+
+        TextureCopy textureCopy;
+        textureCopy.texture = destination->texture;
+        textureCopy.mipLevel = destination->mipLevel;
+        textureCopy.arrayLayer = destination->arrayLayer;
+        textureCopy.origin = destination->origin;
+
+        return device->CopyFromStagingToTexture(uploadHandle.stagingBuffer, alignedOffset,
+                                                alignedBytesPerRow, writeSize->height, textureCopy,
+                                                *writeSize);
+    }
+
     MaybeError QueueBase::ValidateSubmit(uint32_t commandCount,
                                          CommandBufferBase* const* commands) {
         TRACE_EVENT0(GetDevice()->GetPlatform(), Validation, "Queue::ValidateSubmit");
@@ -154,4 +307,107 @@ namespace dawn_native {
         return {};
     }
 
+    MaybeError QueueBase::ValidateWriteBuffer(const BufferBase* buffer,
+                                              uint64_t bufferOffset,
+                                              size_t size) const {
+        DAWN_TRY(GetDevice()->ValidateIsAlive());
+        DAWN_TRY(GetDevice()->ValidateObject(this));
+        DAWN_TRY(GetDevice()->ValidateObject(buffer));
+
+        if (bufferOffset % 4 != 0) {
+            return DAWN_VALIDATION_ERROR("Queue::WriteBuffer bufferOffset must be a multiple of 4");
+        }
+        if (size % 4 != 0) {
+            return DAWN_VALIDATION_ERROR("Queue::WriteBuffer size must be a multiple of 4");
+        }
+
+        uint64_t bufferSize = buffer->GetSize();
+        if (bufferOffset > bufferSize || size > (bufferSize - bufferOffset)) {
+            return DAWN_VALIDATION_ERROR("Queue::WriteBuffer out of range");
+        }
+
+        DAWN_TRY(buffer->ValidateCanUseInSubmitNow());
+
+        return {};
+    }
+
+    MaybeError QueueBase::ValidateWriteTexture(const TextureCopyView* destination,
+                                               uint64_t dataSize,
+                                               const TextureDataLayout* dataLayout,
+                                               const Extent3D* writeSize) const {
+        DAWN_TRY(GetDevice()->ValidateIsAlive());
+        DAWN_TRY(GetDevice()->ValidateObject(this));
+        DAWN_TRY(GetDevice()->ValidateObject(destination->texture));
+
+        TextureBase* texture = destination->texture;
+        const Format& format = texture->GetFormat();
+
+        if (!(texture->GetUsage() & wgpu::TextureUsage::CopyDst)) {
+            return DAWN_VALIDATION_ERROR("Texture needs the CopyDst usage bit");
+        }
+        if (texture->GetSampleCount() > 1) {
+            return DAWN_VALIDATION_ERROR("The sample count of textures must be 1");
+        }
+
+        if (destination->mipLevel >= texture->GetNumMipLevels()) {
+            return DAWN_VALIDATION_ERROR("Write mipLevel out of range");
+        }
+        if (destination->arrayLayer >= texture->GetArrayLayers()) {
+            return DAWN_VALIDATION_ERROR("Write arrayLayer out of range");
+        }
+
+        // Same restriction as buffer-to-texture copies for now.
+        if (destination->origin.z != 0 || writeSize->depth > 1) {
+            return DAWN_VALIDATION_ERROR("No support for z != 0 and depth > 1 for now");
+        }
+
+        if (destination->origin.x % format.blockWidth != 0 ||
+            destination->origin.y % format.blockHeight != 0) {
+            return DAWN_VALIDATION_ERROR(
+                "Origin must be a multiple of the texture format block size");
+        }
+        if (writeSize->width % format.blockWidth != 0 ||
+            writeSize->height % format.blockHeight != 0) {
+            return DAWN_VALIDATION_ERROR(
+                "Write size must be a multiple of the texture format block size");
+        }
+
+        Extent3D extent = texture->GetMipLevelPhysicalSize(destination->mipLevel);
+
+        // All texture dimensions are in uint32_t so by doing checks in uint64_t we avoid
+        // overflows.
+        if (uint64_t(destination->origin.x) + uint64_t(writeSize->width) >
+                static_cast<uint64_t>(extent.width) ||
+            uint64_t(destination->origin.y) + uint64_t(writeSize->height) >
+                static_cast<uint64_t>(extent.height)) {
+            return DAWN_VALIDATION_ERROR("Write would touch outside of the texture");
+        }
+
+        // Unlike buffer-to-texture copies, bytesPerRow only needs to cover a full row of
+        // blocks since the rows are repacked into the required layout while staging.
+        const TexelBlockInfo blockInfo = GetTexelBlockInfo(format.format);
+        const uint32_t heightInBlocks = writeSize->height / blockInfo.height;
+        const uint64_t rowSize = uint64_t(writeSize->width) / blockInfo.width * blockInfo.byteSize;
+
+        uint64_t bytesPerRow = dataLayout->bytesPerRow;
+        if (bytesPerRow == 0) {
+            bytesPerRow = rowSize;
+        } else if (bytesPerRow < rowSize) {
+            return DAWN_VALIDATION_ERROR(
+                "bytesPerRow must not be less than the number of bytes per row");
+        }
+
+        uint64_t requiredSize = 0;
+        if (heightInBlocks > 0) {
+            requiredSize = (uint64_t(heightInBlocks) - 1) * bytesPerRow + rowSize;
+        }
+        if (dataLayout->offset > dataSize || requiredSize > dataSize - dataLayout->offset) {
+            return DAWN_VALIDATION_ERROR("Data is too small to hold the write");
+        }
+
+        DAWN_TRY(texture->ValidateCanUseInSubmitNow());
+
+        return {};
+    }
+
 }  // namespace dawn_native
@@ -23,25 +23,59 @@
 
 namespace dawn_native {
 
+    MaybeError ValidateQueueDescriptor(DeviceBase* device, const QueueDescriptor* descriptor);
+
     class QueueBase : public ObjectBase {
       public:
         QueueBase(DeviceBase* device);
+        QueueBase(DeviceBase* device, const QueueDescriptor* descriptor);
 
         static QueueBase* MakeError(DeviceBase* device);
 
+        // The queue type is a scheduling hint: backends route submissions to a matching
+        // hardware queue when one is available and fall back to the general queue otherwise.
+        wgpu::QueueType GetQueueType() const;
+
         // Dawn API
         void Submit(uint32_t commandCount, CommandBufferBase* const* commands);
         void Signal(Fence* fence, uint64_t signalValue);
+        // Fires |callback| once all work submitted to this queue so far has completed
+        // on the GPU. Backed by the device's completed-serial tracking, so unlike a
+        // fence no object is allocated per dependency.
+        void OnSubmittedWorkDone(wgpu::QueueWorkDoneCallback callback, void* userdata);
         Fence* CreateFence(const FenceDescriptor* descriptor);
+        void WriteBuffer(BufferBase* buffer, uint64_t bufferOffset, const void* data, size_t size);
+        void WriteTexture(const TextureCopyView* destination,
+                          const void* data,
+                          uint64_t dataSize,
+                          const TextureDataLayout* dataLayout,
+                          const Extent3D* writeSize);
 
       private:
         QueueBase(DeviceBase* device, ObjectBase::ErrorTag tag);
 
         virtual MaybeError SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands);
+        MaybeError WriteBufferImpl(BufferBase* buffer,
+                                   uint64_t bufferOffset,
+                                   const void* data,
+                                   size_t size);
+        MaybeError WriteTextureImpl(const TextureCopyView* destination,
+                                    const void* data,
+                                    const TextureDataLayout* dataLayout,
+                                    const Extent3D* writeSize);
 
         MaybeError ValidateSubmit(uint32_t commandCount, CommandBufferBase* const* commands);
         MaybeError ValidateSignal(const Fence* fence, uint64_t signalValue);
         MaybeError ValidateCreateFence(const FenceDescriptor* descriptor);
+        MaybeError ValidateWriteBuffer(const BufferBase* buffer,
+                                       uint64_t bufferOffset,
+                                       size_t size) const;
+        MaybeError ValidateWriteTexture(const TextureCopyView* destination,
+                                        uint64_t dataSize,
+                                        const TextureDataLayout* dataLayout,
+                                        const Extent3D* writeSize) const;
+
+        wgpu::QueueType mType = wgpu::QueueType::General;
     };
 
 }  // namespace dawn_native
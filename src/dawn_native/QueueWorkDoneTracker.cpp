@@ -0,0 +1,43 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/QueueWorkDoneTracker.h"
+
+#include "dawn_native/Device.h"
+
+namespace dawn_native {
+
+    QueueWorkDoneTracker::QueueWorkDoneTracker(DeviceBase* device) : mDevice(device) {
+    }
+
+    QueueWorkDoneTracker::~QueueWorkDoneTracker() {
+        ASSERT(mCallbacksInFlight.Empty());
+    }
+
+    void QueueWorkDoneTracker::TrackSubmittedWorkDone(wgpu::QueueWorkDoneCallback callback,
+                                                      void* userdata) {
+        // Because we currently only have a single queue, all work submitted so far has
+        // completed once the last submitted serial passes.
+        mCallbacksInFlight.Enqueue(WorkDoneCallback{callback, userdata},
+                                   mDevice->GetLastSubmittedCommandSerial());
+    }
+
+    void QueueWorkDoneTracker::Tick(Serial finishedSerial) {
+        for (auto& workDone : mCallbacksInFlight.IterateUpTo(finishedSerial)) {
+            workDone.callback(WGPUQueueWorkDoneStatus_Success, workDone.userdata);
+        }
+        mCallbacksInFlight.ClearUpTo(finishedSerial);
+    }
+
+}  // namespace dawn_native
@@ -0,0 +1,50 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_QUEUEWORKDONETRACKER_H_
+#define DAWNNATIVE_QUEUEWORKDONETRACKER_H_
+
+#include "common/SerialQueue.h"
+#include "dawn_native/dawn_platform.h"
+
+namespace dawn_native {
+
+    class DeviceBase;
+
+    // Fires OnSubmittedWorkDone callbacks once the serial they were registered against
+    // completes. This rides directly on the device's completed-serial tracking so a
+    // GPU-completion dependency costs one queue entry instead of a fence object.
+    class QueueWorkDoneTracker {
+        struct WorkDoneCallback {
+            wgpu::QueueWorkDoneCallback callback;
+            void* userdata;
+        };
+
+      public:
+        QueueWorkDoneTracker(DeviceBase* device);
+        ~QueueWorkDoneTracker();
+
+        // Registers |callback| to fire once all work submitted so far has completed.
+        void TrackSubmittedWorkDone(wgpu::QueueWorkDoneCallback callback, void* userdata);
+
+        void Tick(Serial finishedSerial);
+
+      private:
+        DeviceBase* mDevice;
+        SerialQueue<WorkDoneCallback> mCallbacksInFlight;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_QUEUEWORKDONETRACKER_H_
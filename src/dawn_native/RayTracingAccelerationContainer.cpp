@@ -14,10 +14,14 @@
 
 #include "dawn_native/RayTracingAccelerationContainer.h"
 
+#include <algorithm>
+
 #include "common/Assert.h"
+#include "common/Constants.h"
 #include "common/Math.h"
 #include "dawn_native/Buffer.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/ValidationUtils_autogen.h"
 
 namespace dawn_native {
 
@@ -45,9 +49,21 @@ namespace dawn_native {
             void DestroyImpl() override {
                 UNREACHABLE();
             }
-            MaybeError UpdateInstanceImpl(
-                uint32_t instanceIndex,
-                const RayTracingAccelerationInstanceDescriptor* descriptor) override {
+            MaybeError UpdateInstancesImpl(
+                uint32_t startInstance,
+                uint32_t instanceCount,
+                const RayTracingAccelerationInstanceDescriptor* descriptors) override {
+                UNREACHABLE();
+                return {};
+            }
+            MaybeError UpdateInstanceTransformsImpl(uint32_t startInstance,
+                                                    uint32_t instanceCount,
+                                                    const float* transforms) override {
+                UNREACHABLE();
+                return {};
+            }
+            MaybeError NeutralizeInstancesImpl(uint32_t startInstance,
+                                               uint32_t instanceCount) override {
                 UNREACHABLE();
                 return {};
             }
@@ -58,11 +74,26 @@ namespace dawn_native {
     MaybeError ValidateRayTracingAccelerationContainerDescriptor(
         DeviceBase* device,
         const RayTracingAccelerationContainerDescriptor* descriptor) {
+        DAWN_TRY(ValidateRayTracingAccelerationContainerUsage(descriptor->usage));
+        // The build quality preferences translate to mutually exclusive backend build
+        // flags: dynamic containers want PreferFastBuild, static ones PreferFastTrace.
+        if ((descriptor->usage & wgpu::RayTracingAccelerationContainerUsage::PreferFastBuild) !=
+                0 &&
+            (descriptor->usage & wgpu::RayTracingAccelerationContainerUsage::PreferFastTrace) !=
+                0) {
+            return DAWN_VALIDATION_ERROR(
+                "Acceleration container usage cannot prefer both fast build and fast trace");
+        }
         if (descriptor->level != wgpu::RayTracingAccelerationContainerLevel::Top &&
             descriptor->level != wgpu::RayTracingAccelerationContainerLevel::Bottom) {
             return DAWN_VALIDATION_ERROR(
                 "Invalid acceleration container level. Must be top-level or bottom-level");
         }
+        if (descriptor->priority != wgpu::RayTracingAccelerationContainerPriority::Immediate &&
+            descriptor->priority != wgpu::RayTracingAccelerationContainerPriority::High &&
+            descriptor->priority != wgpu::RayTracingAccelerationContainerPriority::Background) {
+            return DAWN_VALIDATION_ERROR("Invalid acceleration container build priority");
+        }
         if (descriptor->level == wgpu::RayTracingAccelerationContainerLevel::Top) {
             if (descriptor->geometryCount > 0) {
                 return DAWN_VALIDATION_ERROR(
@@ -72,16 +103,37 @@ namespace dawn_native {
                 return DAWN_VALIDATION_ERROR(
                     "No data provided for top-level Acceleration Container");
             }
-            for (unsigned int ii = 0; ii < descriptor->instanceCount; ++ii) {
-                const RayTracingAccelerationInstanceDescriptor& instance =
-                    descriptor->instances[ii];
-                if (instance.geometryContainer == nullptr) {
+            if ((descriptor->instances != nullptr) == (descriptor->instanceBuffer != nullptr)) {
+                return DAWN_VALIDATION_ERROR(
+                    "Instance data requires either CPU-side instances or an instance buffer");
+            }
+            if (descriptor->instanceBuffer != nullptr) {
+                BufferBase* instanceBuffer = descriptor->instanceBuffer;
+                if ((instanceBuffer->GetUsage() & wgpu::BufferUsage::RayTracing) == 0) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Instance buffer must have RAY_TRACING usage flag");
+                }
+                if (instanceBuffer->GetSize() <
+                    uint64_t(descriptor->instanceCount) * kRayTracingInstanceSize) {
                     return DAWN_VALIDATION_ERROR(
-                        "Acceleration container instance requires a geometry container");
+                        "Instance buffer is too small for the instance count");
                 }
-                // linked geometry container must not be destroyed
-                if (instance.geometryContainer->IsDestroyed()) {
-                    return DAWN_VALIDATION_ERROR("Linked geometry container must not be destroyed");
+            }
+            // instance buffers are filled by the GPU, so their geometry containers can only
+            // be validated once the container is used in a submit
+            if (descriptor->instances != nullptr) {
+                for (unsigned int ii = 0; ii < descriptor->instanceCount; ++ii) {
+                    const RayTracingAccelerationInstanceDescriptor& instance =
+                        descriptor->instances[ii];
+                    if (instance.geometryContainer == nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Acceleration container instance requires a geometry container");
+                    }
+                    // linked geometry container must not be destroyed
+                    if (instance.geometryContainer->IsDestroyed()) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Linked geometry container must not be destroyed");
+                    }
                 }
             }
         }
@@ -107,34 +159,51 @@ namespace dawn_native {
                 }
                 // validate vertex input
                 if (geometry.vertex != nullptr) {
-                    if (geometry.vertex->buffer->GetSize() == 0) {
-                        return DAWN_VALIDATION_ERROR("Invalid buffer for vertex data");
+                    if ((geometry.vertex->buffer != nullptr) ==
+                        (geometry.vertex->data != nullptr)) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Vertex data requires either a buffer or staged data");
+                    }
+                    if (geometry.vertex->buffer != nullptr) {
+                        if (geometry.vertex->buffer->GetSize() == 0) {
+                            return DAWN_VALIDATION_ERROR("Invalid buffer for vertex data");
+                        }
+                        if ((geometry.vertex->buffer->GetUsage() &
+                             wgpu::BufferUsage::RayTracing) == 0) {
+                            return DAWN_VALIDATION_ERROR(
+                                "Vertex buffer must have RAY_TRACING usage flag");
+                        }
+                    } else if (geometry.vertex->dataSize == 0) {
+                        return DAWN_VALIDATION_ERROR("Staged vertex data size must not be zero");
                     }
                     if (geometry.vertex->count == 0) {
                         return DAWN_VALIDATION_ERROR("Vertex count must not be zero");
                     }
-                    if ((geometry.vertex->buffer->GetUsage() & wgpu::BufferUsage::RayTracing) ==
-                        0) {
-                        return DAWN_VALIDATION_ERROR(
-                            "Vertex buffer must have RAY_TRACING usage flag");
-                    }
                 }
                 // validate index input
                 if (geometry.index != nullptr) {
                     if (geometry.index == nullptr) {
                         return DAWN_VALIDATION_ERROR("Index data requires vertex data");
                     }
-                    if (geometry.index->buffer->GetSize() == 0) {
-                        return DAWN_VALIDATION_ERROR("Invalid buffer for Index data");
+                    if ((geometry.index->buffer != nullptr) == (geometry.index->data != nullptr)) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Index data requires either a buffer or staged data");
+                    }
+                    if (geometry.index->buffer != nullptr) {
+                        if (geometry.index->buffer->GetSize() == 0) {
+                            return DAWN_VALIDATION_ERROR("Invalid buffer for Index data");
+                        }
+                        if ((geometry.index->buffer->GetUsage() & wgpu::BufferUsage::RayTracing) ==
+                            0) {
+                            return DAWN_VALIDATION_ERROR(
+                                "Index buffer must have RAY_TRACING usage flag");
+                        }
+                    } else if (geometry.index->dataSize == 0) {
+                        return DAWN_VALIDATION_ERROR("Staged index data size must not be zero");
                     }
                     if (geometry.index->count == 0) {
                         return DAWN_VALIDATION_ERROR("Index count must not be zero");
                     }
-                    if ((geometry.index->buffer->GetUsage() & wgpu::BufferUsage::RayTracing) ==
-                        0) {
-                        return DAWN_VALIDATION_ERROR(
-                            "Index buffer must have RAY_TRACING usage flag");
-                    }
                 }
                 // validate aabb input
                 if (geometry.aabb != nullptr) {
@@ -146,16 +215,25 @@ namespace dawn_native {
                         return DAWN_VALIDATION_ERROR(
                             "AABB is not allowed to be combined with index data");
                     }
-                    if (geometry.aabb->buffer->GetSize() == 0) {
-                        return DAWN_VALIDATION_ERROR("Invalid buffer for AABB data");
+                    if ((geometry.aabb->buffer != nullptr) == (geometry.aabb->data != nullptr)) {
+                        return DAWN_VALIDATION_ERROR(
+                            "AABB data requires either a buffer or staged data");
+                    }
+                    if (geometry.aabb->buffer != nullptr) {
+                        if (geometry.aabb->buffer->GetSize() == 0) {
+                            return DAWN_VALIDATION_ERROR("Invalid buffer for AABB data");
+                        }
+                        if ((geometry.aabb->buffer->GetUsage() & wgpu::BufferUsage::RayTracing) ==
+                            0) {
+                            return DAWN_VALIDATION_ERROR(
+                                "AABB buffer must have RAY_TRACING usage flag");
+                        }
+                    } else if (geometry.aabb->dataSize == 0) {
+                        return DAWN_VALIDATION_ERROR("Staged AABB data size must not be zero");
                     }
                     if (geometry.aabb->count == 0) {
                         return DAWN_VALIDATION_ERROR("AABB count must not be zero");
                     }
-                    if ((geometry.aabb->buffer->GetUsage() & wgpu::BufferUsage::RayTracing) == 0) {
-                        return DAWN_VALIDATION_ERROR(
-                            "AABB buffer must have RAY_TRACING usage flag");
-                    }
                 }
                 if (geometry.vertex == nullptr && geometry.index == nullptr &&
                     geometry.aabb == nullptr) {
@@ -177,35 +255,54 @@ namespace dawn_native {
         }
         mUsage = descriptor->usage;
         mLevel = descriptor->level;
+        mPriority = descriptor->priority;
         if (descriptor->level == wgpu::RayTracingAccelerationContainerLevel::Bottom) {
             // save unique references to used vertex and index buffers
             for (unsigned int ii = 0; ii < descriptor->geometryCount; ++ii) {
                 const RayTracingAccelerationGeometryDescriptor& geometry =
                     descriptor->geometries[ii];
 
-                if (geometry.vertex != nullptr &&
+                // staged geometry data has no external buffer to reference
+                if (geometry.vertex != nullptr && geometry.vertex->buffer != nullptr &&
                     !VectorReferenceAlreadyExists(mVertexBuffers, geometry.vertex->buffer)) {
                     mVertexBuffers.push_back(geometry.vertex->buffer);
                 }
-                if (geometry.index != nullptr &&
+                if (geometry.index != nullptr && geometry.index->buffer != nullptr &&
                     !VectorReferenceAlreadyExists(mIndexBuffers, geometry.index->buffer)) {
                     mIndexBuffers.push_back(geometry.index->buffer);
                 }
-                if (geometry.aabb != nullptr &&
+                if (geometry.aabb != nullptr && geometry.aabb->buffer != nullptr &&
                     !VectorReferenceAlreadyExists(mAABBBuffers, geometry.aabb->buffer)) {
                     mAABBBuffers.push_back(geometry.aabb->buffer);
                 }
+
+                // accumulate the build cost estimate in primitives
+                if (geometry.index != nullptr) {
+                    mBuildCostEstimate += geometry.index->count / 3;
+                } else if (geometry.vertex != nullptr) {
+                    mBuildCostEstimate += geometry.vertex->count / 3;
+                } else if (geometry.aabb != nullptr) {
+                    mBuildCostEstimate += geometry.aabb->count;
+                }
             }
         }
         if (descriptor->level == wgpu::RayTracingAccelerationContainerLevel::Top) {
-            // save unique references to used geometry containers
-            for (unsigned int ii = 0; ii < descriptor->instanceCount; ++ii) {
-                const RayTracingAccelerationInstanceDescriptor& instance =
-                    descriptor->instances[ii];
-                RayTracingAccelerationContainerBase* container = instance.geometryContainer;
-
-                if (!VectorReferenceAlreadyExists(mGeometryContainers, container)) {
-                    mGeometryContainers.push_back(container);
+            mInstanceCount = descriptor->instanceCount;
+            mBuildCostEstimate = descriptor->instanceCount;
+            mDirtyInstanceBlocks.resize(
+                (descriptor->instanceCount + kInstanceUpdateBlockSize - 1) /
+                    kInstanceUpdateBlockSize,
+                false);
+            mExternalInstanceBuffer = descriptor->instanceBuffer;
+            // save references to the used geometry containers, both per instance slot and
+            // as a unique set carrying the destruction back-links
+            if (descriptor->instances != nullptr) {
+                mInstanceSlots.resize(descriptor->instanceCount);
+                for (unsigned int ii = 0; ii < descriptor->instanceCount; ++ii) {
+                    RayTracingAccelerationContainerBase* container =
+                        descriptor->instances[ii].geometryContainer;
+                    mInstanceSlots[ii] = container;
+                    RegisterGeometryContainer(container);
                 }
             }
         }
@@ -217,6 +314,12 @@ namespace dawn_native {
         : ObjectBase(device, tag) {
     }
 
+    RayTracingAccelerationContainerBase::~RayTracingAccelerationContainerBase() {
+        // Remove the destruction back-links so bottom-level containers outliving this
+        // one don't notify a dangling pointer.
+        UnlinkFromGeometryContainers();
+    }
+
     // static
     RayTracingAccelerationContainerBase* RayTracingAccelerationContainerBase::MakeError(
         DeviceBase* device) {
@@ -229,22 +332,140 @@ namespace dawn_native {
 
     void RayTracingAccelerationContainerBase::DestroyInternal() {
         if (!IsDestroyed()) {
+            // Swap any live top-level instances pointing at this container to degenerate
+            // ones before the backend frees the structure their handles refer to.
+            for (RayTracingAccelerationContainerBase* container : mReferencingContainers) {
+                container->OnGeometryContainerDestroyed(this);
+            }
+            mReferencingContainers.clear();
+            UnlinkFromGeometryContainers();
+            mInstanceSlots.clear();
             DestroyImpl();
+            GetDevice()->DecreaseRayTracingMemoryUsage(mMemoryUsage);
+            mMemoryUsage = {};
         }
         SetDestroyState(true);
     }
 
+    void RayTracingAccelerationContainerBase::RegisterGeometryContainer(
+        RayTracingAccelerationContainerBase* geometryContainer) {
+        if (VectorReferenceAlreadyExists(mGeometryContainers, geometryContainer)) {
+            return;
+        }
+        mGeometryContainers.push_back(geometryContainer);
+        geometryContainer->mReferencingContainers.push_back(this);
+    }
+
+    void RayTracingAccelerationContainerBase::UnlinkFromGeometryContainers() {
+        for (const Ref<RayTracingAccelerationContainerBase>& geometryContainer :
+             mGeometryContainers) {
+            std::vector<RayTracingAccelerationContainerBase*>& backLinks =
+                geometryContainer->mReferencingContainers;
+            backLinks.erase(std::remove(backLinks.begin(), backLinks.end(), this),
+                            backLinks.end());
+        }
+        mGeometryContainers.clear();
+    }
+
+    void RayTracingAccelerationContainerBase::OnGeometryContainerDestroyed(
+        RayTracingAccelerationContainerBase* geometryContainer) {
+        ASSERT(GetLevel() == wgpu::RayTracingAccelerationContainerLevel::Top);
+        if (IsDestroyed()) {
+            return;
+        }
+
+        for (uint32_t ii = 0; ii < mInstanceSlots.size(); ++ii) {
+            if (mInstanceSlots[ii].Get() != geometryContainer) {
+                continue;
+            }
+            mInstanceSlots[ii] = nullptr;
+            if (GetDevice()->ConsumedError(NeutralizeInstancesImpl(ii, 1))) {
+                return;
+            }
+            // The degenerate instance reaches the GPU copy with the next scheduled
+            // build or update, like any other instance update.
+            MarkInstancesDirty(ii, 1);
+        }
+
+        // Release the lifetime reference; the back-link is removed wholesale by the
+        // destroyed container.
+        for (size_t ii = 0; ii < mGeometryContainers.size(); ++ii) {
+            if (mGeometryContainers[ii].Get() == geometryContainer) {
+                mGeometryContainers.erase(mGeometryContainers.begin() + ii);
+                break;
+            }
+        }
+    }
+
+    void RayTracingAccelerationContainerBase::SetMemoryUsage(uint64_t resultSize,
+                                                             uint64_t buildScratchSize,
+                                                             uint64_t updateScratchSize) {
+        // The requirements are queried once during creation.
+        ASSERT(mMemoryUsage.resultSize == 0);
+        mMemoryUsage.resultSize = resultSize;
+        mMemoryUsage.buildScratchSize = buildScratchSize;
+        mMemoryUsage.updateScratchSize = updateScratchSize;
+        GetDevice()->IncreaseRayTracingMemoryUsage(mMemoryUsage);
+    }
+
     void RayTracingAccelerationContainerBase::UpdateInstance(
         uint32_t instanceIndex,
         const RayTracingAccelerationInstanceDescriptor* descriptor) {
-        if (GetDevice()->ConsumedError(ValidateUpdateInstance(instanceIndex, descriptor))) {
+        UpdateInstances(instanceIndex, 1, descriptor);
+    }
+
+    void RayTracingAccelerationContainerBase::UpdateInstances(
+        uint32_t startInstance,
+        uint32_t instanceCount,
+        const RayTracingAccelerationInstanceDescriptor* descriptors) {
+        for (uint32_t ii = 0; ii < instanceCount; ++ii) {
+            if (GetDevice()->ConsumedError(
+                    ValidateUpdateInstance(startInstance + ii, &descriptors[ii]))) {
+                return;
+            }
+        }
+        ASSERT(!IsError());
+
+        if (GetDevice()->ConsumedError(
+                UpdateInstancesImpl(startInstance, instanceCount, descriptors))) {
+            return;
+        }
+
+        // Repoint the instance slots and take references on newly referenced geometry
+        // containers so their lifetime tracking stays in sync with the shadow copy.
+        for (uint32_t ii = 0; ii < instanceCount; ++ii) {
+            mInstanceSlots[startInstance + ii] = descriptors[ii].geometryContainer;
+            RegisterGeometryContainer(descriptors[ii].geometryContainer);
+        }
+
+        MarkInstancesDirty(startInstance, instanceCount);
+    }
+
+    void RayTracingAccelerationContainerBase::UpdateInstanceTransforms(uint32_t startInstance,
+                                                                       uint32_t instanceCount,
+                                                                       uint32_t transformFloatCount,
+                                                                       const float* transforms) {
+        if (GetDevice()->ConsumedError(ValidateUpdateInstanceTransforms(
+                startInstance, instanceCount, transformFloatCount))) {
             return;
         }
         ASSERT(!IsError());
 
-        if (GetDevice()->ConsumedError(UpdateInstanceImpl(instanceIndex, descriptor))) {
+        if (GetDevice()->ConsumedError(
+                UpdateInstanceTransformsImpl(startInstance, instanceCount, transforms))) {
             return;
         }
+
+        MarkInstancesDirty(startInstance, instanceCount);
+    }
+
+    void RayTracingAccelerationContainerBase::MarkInstancesDirty(uint32_t startInstance,
+                                                                 uint32_t instanceCount) {
+        uint32_t firstBlock = startInstance / kInstanceUpdateBlockSize;
+        uint32_t lastBlock = (startInstance + instanceCount - 1) / kInstanceUpdateBlockSize;
+        for (uint32_t block = firstBlock; block <= lastBlock; ++block) {
+            mDirtyInstanceBlocks[block] = true;
+        }
     }
 
     MaybeError RayTracingAccelerationContainerBase::ValidateUpdateInstance(
@@ -256,6 +477,13 @@ namespace dawn_native {
         if (GetLevel() != wgpu::RayTracingAccelerationContainerLevel::Top) {
             return DAWN_VALIDATION_ERROR("Only top-level containers support instance updates");
         }
+        if (mExternalInstanceBuffer != nullptr) {
+            return DAWN_VALIDATION_ERROR(
+                "Containers using an instance buffer must be updated through the buffer");
+        }
+        if (instanceIndex >= mInstanceCount) {
+            return DAWN_VALIDATION_ERROR("Instance index out of range");
+        }
 
         RayTracingAccelerationContainerBase* geometryContainer = descriptor->geometryContainer;
         if (geometryContainer == nullptr) {
@@ -272,6 +500,34 @@ namespace dawn_native {
         return {};
     }
 
+    MaybeError RayTracingAccelerationContainerBase::ValidateUpdateInstanceTransforms(
+        uint32_t startInstance,
+        uint32_t instanceCount,
+        uint32_t transformFloatCount) const {
+        DAWN_TRY(GetDevice()->ValidateIsAlive());
+        DAWN_TRY(GetDevice()->ValidateObject(this));
+
+        if (GetLevel() != wgpu::RayTracingAccelerationContainerLevel::Top) {
+            return DAWN_VALIDATION_ERROR("Only top-level containers support instance updates");
+        }
+        if (mExternalInstanceBuffer != nullptr) {
+            return DAWN_VALIDATION_ERROR(
+                "Containers using an instance buffer must be updated through the buffer");
+        }
+        if (instanceCount == 0) {
+            return DAWN_VALIDATION_ERROR("Instance count must not be zero");
+        }
+        if (uint64_t(startInstance) + instanceCount > mInstanceCount) {
+            return DAWN_VALIDATION_ERROR("Instance range out of bounds");
+        }
+        if (transformFloatCount != 16u * instanceCount) {
+            return DAWN_VALIDATION_ERROR(
+                "Transform data must hold one column-major 4x4 matrix per instance");
+        }
+
+        return {};
+    }
+
     bool RayTracingAccelerationContainerBase::IsBuilt() const {
         return mIsBuilt;
     }
@@ -314,4 +570,33 @@ namespace dawn_native {
         return mLevel;
     }
 
+    wgpu::RayTracingAccelerationContainerPriority RayTracingAccelerationContainerBase::GetPriority()
+        const {
+        return mPriority;
+    }
+
+    uint32_t RayTracingAccelerationContainerBase::GetInstanceCount() const {
+        return mInstanceCount;
+    }
+
+    BufferBase* RayTracingAccelerationContainerBase::GetExternalInstanceBuffer() const {
+        return mExternalInstanceBuffer.Get();
+    }
+
+    uint64_t RayTracingAccelerationContainerBase::GetBuildCostEstimate() const {
+        return mBuildCostEstimate;
+    }
+
+    const RayTracingMemoryUsage& RayTracingAccelerationContainerBase::GetMemoryUsage() const {
+        return mMemoryUsage;
+    }
+
+    bool RayTracingAccelerationContainerBase::IsDeferredBuildPending() const {
+        return mDeferredBuildPending;
+    }
+
+    void RayTracingAccelerationContainerBase::SetDeferredBuildPending(bool pending) {
+        mDeferredBuildPending = pending;
+    }
+
 }  // namespace dawn_native
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include <memory>
 #include <vector>
 
+#include "dawn_native/DawnNative.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
 #include "dawn_native/ObjectBase.h"
@@ -40,6 +41,17 @@ namespace dawn_native {
         void Destroy();
         void UpdateInstance(uint32_t instanceIndex,
                             const RayTracingAccelerationInstanceDescriptor* descriptor);
+        void UpdateInstances(uint32_t startInstance,
+                             uint32_t instanceCount,
+                             const RayTracingAccelerationInstanceDescriptor* descriptors);
+        // Converts `instanceCount` column-major 4x4 matrices and writes them as the
+        // transforms of a contiguous instance range, leaving the other instance fields
+        // untouched. Cheaper than UpdateInstances when only transforms change per frame.
+        // `transformFloatCount` must be 16 * instanceCount.
+        void UpdateInstanceTransforms(uint32_t startInstance,
+                                      uint32_t instanceCount,
+                                      uint32_t transformFloatCount,
+                                      const float* transforms);
 
         bool IsBuilt() const;
         bool IsUpdated() const;
@@ -52,12 +64,77 @@ namespace dawn_native {
 
         wgpu::RayTracingAccelerationContainerUsage GetUsage() const;
         wgpu::RayTracingAccelerationContainerLevel GetLevel() const;
+        wgpu::RayTracingAccelerationContainerPriority GetPriority() const;
+        uint32_t GetInstanceCount() const;
+
+        // The application-owned buffer holding the instance array when the container was
+        // created with one, or nullptr when instances are CPU-side and staged internally.
+        BufferBase* GetExternalInstanceBuffer() const;
+
+        // Relative build cost in primitives, used by the device's deferred build
+        // scheduler to bound how much background build work it submits per tick.
+        uint64_t GetBuildCostEstimate() const;
+
+        // The driver-reported memory footprint, registered by the backend once the
+        // container's memory requirements are known. All sizes are zero before that and
+        // after the container is destroyed.
+        const RayTracingMemoryUsage& GetMemoryUsage() const;
+
+        // Tracks whether this container is already waiting in the device's deferred
+        // build queue so repeated build requests are only scheduled once.
+        bool IsDeferredBuildPending() const;
+        void SetDeferredBuildPending(bool pending);
+
+        // Called on referencing top-level containers when a bottom-level container is
+        // destroyed: every instance slot still pointing at it is swapped to a degenerate
+        // instance that can never be hit, so destroying geometry doesn't force a
+        // synchronous top-level rebuild. The stale handle leaves the GPU copy once the
+        // next scheduled build or update uploads the dirtied slots.
+        void OnGeometryContainerDestroyed(RayTracingAccelerationContainerBase* geometryContainer);
 
       protected:
         RayTracingAccelerationContainerBase(DeviceBase* device, ObjectBase::ErrorTag tag);
+        ~RayTracingAccelerationContainerBase() override;
 
         void DestroyInternal();
 
+        // Called by the backend once the driver reported the container's memory
+        // requirements; also adds them to the device-level totals, which drop again
+        // when the container is destroyed.
+        void SetMemoryUsage(uint64_t resultSize,
+                            uint64_t buildScratchSize,
+                            uint64_t updateScratchSize);
+
+        // Instance updates are tracked block-wise so refits of large instance arrays only
+        // upload the spans that actually changed. UpdateInstances marks the touched blocks
+        // and the backends consume them in their FlushInstanceUpdates before a build or
+        // update command is recorded.
+        static constexpr uint32_t kInstanceUpdateBlockSize = 256;
+
+        // Calls f(firstInstance, instanceCount) for each contiguous run of dirty blocks,
+        // clamped to the container's instance count, and clears the dirty state.
+        template <typename F>
+        void ConsumeDirtyInstanceRanges(F f) {
+            for (uint32_t block = 0; block < mDirtyInstanceBlocks.size(); ++block) {
+                if (!mDirtyInstanceBlocks[block]) {
+                    continue;
+                }
+                uint32_t endBlock = block;
+                while (endBlock < mDirtyInstanceBlocks.size() && mDirtyInstanceBlocks[endBlock]) {
+                    mDirtyInstanceBlocks[endBlock] = false;
+                    endBlock++;
+                }
+                uint32_t firstInstance = block * kInstanceUpdateBlockSize;
+                uint32_t endInstance = endBlock * kInstanceUpdateBlockSize;
+                // the last block may be partially filled
+                if (endInstance > mInstanceCount) {
+                    endInstance = mInstanceCount;
+                }
+                f(firstInstance, endInstance - firstInstance);
+                block = endBlock;
+            }
+        }
+
       private:
         // bottom-level references
         std::vector<Ref<BufferBase>> mVertexBuffers;
@@ -66,22 +143,61 @@ namespace dawn_native {
 
         // top-level references
         std::vector<Ref<RayTracingAccelerationContainerBase>> mGeometryContainers;
+        Ref<BufferBase> mExternalInstanceBuffer;
+
+        // The bottom-level container each CPU-side instance slot currently points at.
+        // The slots hold strong references, so an entry can only change through an
+        // instance update or OnGeometryContainerDestroyed.
+        std::vector<Ref<RayTracingAccelerationContainerBase>> mInstanceSlots;
+
+        // Top-level containers holding this bottom-level container in a slot, notified
+        // on destruction. Back-links are raw pointers: the referencing container removes
+        // itself before it dies.
+        std::vector<RayTracingAccelerationContainerBase*> mReferencingContainers;
 
         bool mIsBuilt = false;
         bool mIsUpdated = false;
         bool mIsDestroyed = false;
+        bool mDeferredBuildPending = false;
+
+        uint32_t mInstanceCount = 0;
+        uint64_t mBuildCostEstimate = 0;
+        RayTracingMemoryUsage mMemoryUsage = {};
+        std::vector<bool> mDirtyInstanceBlocks;
 
         wgpu::RayTracingAccelerationContainerUsage mUsage;
         wgpu::RayTracingAccelerationContainerLevel mLevel;
+        wgpu::RayTracingAccelerationContainerPriority mPriority;
+
+        void MarkInstancesDirty(uint32_t startInstance, uint32_t instanceCount);
+
+        // Adds the container to mGeometryContainers (once) and registers the back-link
+        // used to notify this container when the geometry container is destroyed.
+        void RegisterGeometryContainer(RayTracingAccelerationContainerBase* geometryContainer);
+        // Removes the back-links again and releases the references.
+        void UnlinkFromGeometryContainers();
 
         MaybeError ValidateUpdateInstance(
             uint32_t instanceIndex,
             const RayTracingAccelerationInstanceDescriptor* descriptor) const;
+        MaybeError ValidateUpdateInstanceTransforms(uint32_t startInstance,
+                                                    uint32_t instanceCount,
+                                                    uint32_t transformFloatCount) const;
 
         virtual void DestroyImpl() = 0;
-        virtual MaybeError UpdateInstanceImpl(
-            uint32_t instanceIndex,
-            const RayTracingAccelerationInstanceDescriptor* descriptor) = 0;
+        // Writes a contiguous range of instances in a single upload so bulk updates do
+        // not pay a per-instance virtual call.
+        virtual MaybeError UpdateInstancesImpl(
+            uint32_t startInstance,
+            uint32_t instanceCount,
+            const RayTracingAccelerationInstanceDescriptor* descriptors) = 0;
+        virtual MaybeError UpdateInstanceTransformsImpl(uint32_t startInstance,
+                                                        uint32_t instanceCount,
+                                                        const float* transforms) = 0;
+        // Overwrites a contiguous range of the instance shadow copy with degenerate
+        // instances (zero mask, null handle) that can never be intersected.
+        virtual MaybeError NeutralizeInstancesImpl(uint32_t startInstance,
+                                                   uint32_t instanceCount) = 0;
     };
 
 }  // namespace dawn_native
@@ -0,0 +1,53 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/RayTracingBundle.h"
+
+#include "dawn_native/Commands.h"
+#include "dawn_native/Device.h"
+#include "dawn_native/RayTracingBundleEncoder.h"
+
+namespace dawn_native {
+
+    RayTracingBundleBase::RayTracingBundleBase(RayTracingBundleEncoder* encoder,
+                                               const RayTracingBundleDescriptor* descriptor,
+                                               PassResourceUsage resourceUsage)
+        : ObjectBase(encoder->GetDevice()),
+          mCommands(encoder->AcquireCommands()),
+          mResourceUsage(std::move(resourceUsage)) {
+    }
+
+    RayTracingBundleBase::~RayTracingBundleBase() {
+        FreeCommands(&mCommands);
+    }
+
+    // static
+    RayTracingBundleBase* RayTracingBundleBase::MakeError(DeviceBase* device) {
+        return new RayTracingBundleBase(device, ObjectBase::kError);
+    }
+
+    RayTracingBundleBase::RayTracingBundleBase(DeviceBase* device, ErrorTag errorTag)
+        : ObjectBase(device, errorTag) {
+    }
+
+    CommandIterator* RayTracingBundleBase::GetCommands() {
+        return &mCommands;
+    }
+
+    const PassResourceUsage& RayTracingBundleBase::GetResourceUsage() const {
+        ASSERT(!IsError());
+        return mResourceUsage;
+    }
+
+}  // namespace dawn_native
@@ -0,0 +1,115 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/RayTracingBundleEncoder.h"
+
+#include "dawn_native/CommandValidation.h"
+#include "dawn_native/Commands.h"
+#include "dawn_native/Device.h"
+#include "dawn_native/RayTracingPipeline.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
+
+namespace dawn_native {
+
+    MaybeError ValidateRayTracingBundleEncoderDescriptor(
+        const DeviceBase* device,
+        const RayTracingBundleEncoderDescriptor* descriptor) {
+        return {};
+    }
+
+    RayTracingBundleEncoder::RayTracingBundleEncoder(
+        DeviceBase* device,
+        const RayTracingBundleEncoderDescriptor* descriptor)
+        : ProgrammablePassEncoder(device, &mBundleEncodingContext, PassType::RayTracing),
+          mBundleEncodingContext(device, this) {
+    }
+
+    RayTracingBundleEncoder::RayTracingBundleEncoder(DeviceBase* device, ErrorTag errorTag)
+        : ProgrammablePassEncoder(device, &mBundleEncodingContext, errorTag, PassType::RayTracing),
+          mBundleEncodingContext(device, this) {
+    }
+
+    // static
+    RayTracingBundleEncoder* RayTracingBundleEncoder::MakeError(DeviceBase* device) {
+        return new RayTracingBundleEncoder(device, ObjectBase::kError);
+    }
+
+    CommandIterator RayTracingBundleEncoder::AcquireCommands() {
+        return mBundleEncodingContext.AcquireCommands();
+    }
+
+    void RayTracingBundleEncoder::TraceRays(uint32_t rayGenerationOffset,
+                                            uint32_t rayHitOffset,
+                                            uint32_t rayMissOffset,
+                                            uint32_t width,
+                                            uint32_t height,
+                                            uint32_t depth) {
+        mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            TraceRaysCmd* traceRays = allocator->Allocate<TraceRaysCmd>(Command::TraceRays);
+            traceRays->rayGenerationOffset = rayGenerationOffset;
+            traceRays->rayHitOffset = rayHitOffset;
+            traceRays->rayMissOffset = rayMissOffset;
+            traceRays->width = width;
+            traceRays->height = height;
+            traceRays->depth = depth;
+            return {};
+        });
+    }
+
+    void RayTracingBundleEncoder::SetPipeline(RayTracingPipelineBase* pipeline) {
+        mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            DAWN_TRY(GetDevice()->ValidateObject(pipeline));
+
+            if (pipeline->GetShaderBindingTable()->IsDestroyed()) {
+                return DAWN_VALIDATION_ERROR("Shader binding table is destroyed");
+            }
+
+            SetRayTracingPipelineCmd* setPipeline =
+                allocator->Allocate<SetRayTracingPipelineCmd>(Command::SetRayTracingPipeline);
+            setPipeline->pipeline = pipeline;
+
+            return {};
+        });
+    }
+
+    RayTracingBundleBase* RayTracingBundleEncoder::Finish(
+        const RayTracingBundleDescriptor* descriptor) {
+        PassResourceUsage usages = mUsageTracker.AcquireResourceUsage();
+
+        DeviceBase* device = GetDevice();
+        // Even if mBundleEncodingContext.Finish() validation fails, calling it will mutate the
+        // internal state of the encoding context. Subsequent calls to encode commands will generate
+        // errors.
+        if (device->ConsumedError(mBundleEncodingContext.Finish()) ||
+            (device->IsValidationEnabled() &&
+             device->ConsumedError(ValidateFinish(mBundleEncodingContext.GetIterator(), usages)))) {
+            return RayTracingBundleBase::MakeError(device);
+        }
+
+        ASSERT(!IsError());
+        return new RayTracingBundleBase(this, descriptor, std::move(usages));
+    }
+
+    MaybeError RayTracingBundleEncoder::ValidateFinish(CommandIterator* commands,
+                                                       const PassResourceUsage& usages) const {
+        TRACE_EVENT0(GetDevice()->GetPlatform(), Validation,
+                     "RayTracingBundleEncoder::ValidateFinish");
+        DAWN_TRY(GetDevice()->ValidateObject(this));
+        DAWN_TRY(ValidatePassResourceUsage(usages));
+        DAWN_TRY(ValidateRayTracingBundle(commands));
+        return {};
+    }
+
+}  // namespace dawn_native
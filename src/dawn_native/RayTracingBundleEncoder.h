@@ -0,0 +1,57 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_RAY_TRACING_BUNDLE_ENCODER_H_
+#define DAWNNATIVE_RAY_TRACING_BUNDLE_ENCODER_H_
+
+#include "dawn_native/EncodingContext.h"
+#include "dawn_native/Error.h"
+#include "dawn_native/ProgrammablePassEncoder.h"
+#include "dawn_native/RayTracingBundle.h"
+
+namespace dawn_native {
+
+    MaybeError ValidateRayTracingBundleEncoderDescriptor(
+        const DeviceBase* device,
+        const RayTracingBundleEncoderDescriptor* descriptor);
+
+    class RayTracingBundleEncoder final : public ProgrammablePassEncoder {
+      public:
+        RayTracingBundleEncoder(DeviceBase* device,
+                                const RayTracingBundleEncoderDescriptor* descriptor);
+
+        static RayTracingBundleEncoder* MakeError(DeviceBase* device);
+
+        RayTracingBundleBase* Finish(const RayTracingBundleDescriptor* descriptor);
+
+        CommandIterator AcquireCommands();
+
+        void TraceRays(uint32_t rayGenerationOffset,
+                       uint32_t rayHitOffset,
+                       uint32_t rayMissOffset,
+                       uint32_t width,
+                       uint32_t height,
+                       uint32_t depth);
+        void SetPipeline(RayTracingPipelineBase* pipeline);
+
+      private:
+        RayTracingBundleEncoder(DeviceBase* device, ErrorTag errorTag);
+
+        MaybeError ValidateFinish(CommandIterator* commands, const PassResourceUsage& usages) const;
+
+        EncodingContext mBundleEncodingContext;
+    };
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_RAY_TRACING_BUNDLE_ENCODER_H_
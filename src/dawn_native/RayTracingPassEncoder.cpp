@@ -14,10 +14,13 @@
 
 #include "dawn_native/RayTracingPassEncoder.h"
 
+#include "common/Assert.h"
 #include "dawn_native/Buffer.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/Commands.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/QuerySet.h"
+#include "dawn_native/RayTracingBundle.h"
 #include "dawn_native/RayTracingPipeline.h"
 
 namespace dawn_native {
@@ -46,6 +49,11 @@ namespace dawn_native {
 
     void RayTracingPassEncoder::EndPass() {
         if (mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+                if (mActiveQuerySet != nullptr) {
+                    return DAWN_VALIDATION_ERROR(
+                        "The pipeline statistics query must be ended before the pass");
+                }
+
                 allocator->Allocate<EndRayTracingPassCmd>(Command::EndRayTracingPass);
 
                 return {};
@@ -54,6 +62,84 @@ namespace dawn_native {
         }
     }
 
+    void RayTracingPassEncoder::BeginPipelineStatisticsQuery(QuerySetBase* querySet,
+                                                             uint32_t queryIndex) {
+        mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            DAWN_TRY(GetDevice()->ValidateObject(querySet));
+
+            if (querySet->GetQueryType() != wgpu::QueryType::PipelineStatistics) {
+                return DAWN_VALIDATION_ERROR("The query set type must be PipelineStatistics");
+            }
+            if (querySet->IsDestroyed()) {
+                return DAWN_VALIDATION_ERROR("Query set must not be destroyed");
+            }
+            if (queryIndex >= querySet->GetQueryCount()) {
+                return DAWN_VALIDATION_ERROR("Query index out of bounds");
+            }
+            if (mActiveQuerySet != nullptr) {
+                return DAWN_VALIDATION_ERROR("A pipeline statistics query is already active");
+            }
+
+            BeginPipelineStatisticsQueryCmd* cmd =
+                allocator->Allocate<BeginPipelineStatisticsQueryCmd>(
+                    Command::BeginPipelineStatisticsQuery);
+            cmd->querySet = querySet;
+            cmd->queryIndex = queryIndex;
+
+            mActiveQuerySet = querySet;
+            mActiveQueryIndex = queryIndex;
+
+            return {};
+        });
+    }
+
+    void RayTracingPassEncoder::EndPipelineStatisticsQuery() {
+        mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (mActiveQuerySet == nullptr) {
+                return DAWN_VALIDATION_ERROR("No pipeline statistics query is active");
+            }
+
+            EndPipelineStatisticsQueryCmd* cmd = allocator->Allocate<EndPipelineStatisticsQueryCmd>(
+                Command::EndPipelineStatisticsQuery);
+            cmd->querySet = mActiveQuerySet;
+            cmd->queryIndex = mActiveQueryIndex;
+
+            mActiveQuerySet = nullptr;
+
+            return {};
+        });
+    }
+
+    void RayTracingPassEncoder::ExecuteBundles(uint32_t count,
+                                               RayTracingBundleBase* const* bundles) {
+        mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            for (uint32_t i = 0; i < count; ++i) {
+                DAWN_TRY(GetDevice()->ValidateObject(bundles[i]));
+            }
+
+            ExecuteRayTracingBundlesCmd* cmd =
+                allocator->Allocate<ExecuteRayTracingBundlesCmd>(Command::ExecuteRayTracingBundles);
+            cmd->count = count;
+
+            Ref<RayTracingBundleBase>* trackedBundles =
+                allocator->AllocateData<Ref<RayTracingBundleBase>>(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                trackedBundles[i] = bundles[i];
+
+                const PassResourceUsage& usages = trackedBundles[i]->GetResourceUsage();
+                for (uint32_t i = 0; i < usages.buffers.size(); ++i) {
+                    mUsageTracker.BufferUsedAs(usages.buffers[i], usages.bufferUsages[i]);
+                }
+
+                for (uint32_t i = 0; i < usages.textures.size(); ++i) {
+                    mUsageTracker.AddTextureUsage(usages.textures[i], usages.textureUsages[i]);
+                }
+            }
+
+            return {};
+        });
+    }
+
     void RayTracingPassEncoder::TraceRays(uint32_t rayGenerationOffset,
                                           uint32_t rayHitOffset,
                                           uint32_t rayMissOffset,
@@ -72,17 +158,57 @@ namespace dawn_native {
         });
     }
 
+    void RayTracingPassEncoder::TraceRaysIndirect(uint32_t rayGenerationOffset,
+                                                  uint32_t rayHitOffset,
+                                                  uint32_t rayMissOffset,
+                                                  BufferBase* indirectBuffer,
+                                                  uint64_t indirectOffset) {
+        mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(indirectBuffer));
+
+                if (indirectOffset >= indirectBuffer->GetSize() ||
+                    indirectOffset + kTraceRaysIndirectSize > indirectBuffer->GetSize()) {
+                    return DAWN_VALIDATION_ERROR("Indirect offset out of bounds");
+                }
+            }
+            ASSERT(indirectOffset + kTraceRaysIndirectSize <= indirectBuffer->GetSize());
+
+            TraceRaysIndirectCmd* traceRays =
+                allocator->Allocate<TraceRaysIndirectCmd>(Command::TraceRaysIndirect);
+            traceRays->rayGenerationOffset = rayGenerationOffset;
+            traceRays->rayHitOffset = rayHitOffset;
+            traceRays->rayMissOffset = rayMissOffset;
+            traceRays->indirectBuffer = indirectBuffer;
+            traceRays->indirectOffset = indirectOffset;
+
+            mUsageTracker.BufferUsedAs(indirectBuffer, wgpu::BufferUsage::Indirect);
+
+            return {};
+        });
+    }
+
     void RayTracingPassEncoder::SetPipeline(RayTracingPipelineBase* pipeline) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
-            DAWN_TRY(GetDevice()->ValidateObject(pipeline));
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(pipeline));
 
-            if (pipeline->GetShaderBindingTable()->IsDestroyed()) {
-                return DAWN_VALIDATION_ERROR("Shader binding table is destroyed");
+                if (pipeline->GetShaderBindingTable()->IsDestroyed()) {
+                    return DAWN_VALIDATION_ERROR("Shader binding table is destroyed");
+                }
+            }
+            ASSERT(!pipeline->IsError());
+
+            // Re-setting the current pipeline is a no-op; skip recording it. The previously
+            // recorded command keeps the pipeline referenced.
+            if (pipeline == mLastPipeline) {
+                return {};
             }
 
             SetRayTracingPipelineCmd* setPipeline =
                 allocator->Allocate<SetRayTracingPipelineCmd>(Command::SetRayTracingPipeline);
             setPipeline->pipeline = pipeline;
+            mLastPipeline = pipeline;
 
             return {};
         });
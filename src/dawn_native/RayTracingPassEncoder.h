@@ -32,12 +32,20 @@ namespace dawn_native {
 
         void EndPass();
 
+        void BeginPipelineStatisticsQuery(QuerySetBase* querySet, uint32_t queryIndex);
+        void EndPipelineStatisticsQuery();
+        void ExecuteBundles(uint32_t count, RayTracingBundleBase* const* bundles);
         void TraceRays(uint32_t rayGenerationOffset,
                        uint32_t rayHitOffset,
                        uint32_t rayMissOffset,
                        uint32_t width,
                        uint32_t height,
                        uint32_t depth);
+        void TraceRaysIndirect(uint32_t rayGenerationOffset,
+                               uint32_t rayHitOffset,
+                               uint32_t rayMissOffset,
+                               BufferBase* indirectBuffer,
+                               uint64_t indirectOffset);
         void SetPipeline(RayTracingPipelineBase* pipeline);
 
       protected:
@@ -50,6 +58,14 @@ namespace dawn_native {
         // For render and compute passes, the encoding context is borrowed from the command encoder.
         // Keep a reference to the encoder to make sure the context isn't freed.
         Ref<CommandEncoder> mCommandEncoder;
+
+        // The pipeline statistics query that is currently open, if any.
+        Ref<QuerySetBase> mActiveQuerySet;
+        uint32_t mActiveQueryIndex = 0;
+
+        // Used to skip recording redundant SetPipeline calls; kept alive by the recorded
+        // command that set it.
+        RayTracingPipelineBase* mLastPipeline = nullptr;
     };
 
 }  // namespace dawn_native
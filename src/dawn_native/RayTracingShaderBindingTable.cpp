@@ -17,6 +17,7 @@
 #include "common/Assert.h"
 #include "common/Math.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/Pipeline.h"
 
 namespace dawn_native {
 
@@ -32,6 +33,12 @@ namespace dawn_native {
             void DestroyImpl() override {
                 UNREACHABLE();
             }
+            MaybeError UpdateGroupsImpl(uint32_t startGroup,
+                                        uint32_t groupCount,
+                                        const uint32_t* sourceGroupIndices) override {
+                UNREACHABLE();
+                return {};
+            }
         };
 
     }  // anonymous namespace
@@ -63,6 +70,7 @@ namespace dawn_native {
                 case wgpu::ShaderStage::Fragment:
                     return DAWN_VALIDATION_ERROR("Invalid shader stage");
             }
+            DAWN_TRY(ValidatePipelineConstants(device, stage.constantCount, stage.constants));
         }
         for (unsigned int ii = 0; ii < descriptor->groupCount; ++ii) {
             const RayTracingShaderBindingTableGroupDescriptor& group = descriptor->groups[ii];
@@ -116,7 +124,7 @@ namespace dawn_native {
     RayTracingShaderBindingTableBase::RayTracingShaderBindingTableBase(
         DeviceBase* device,
         const RayTracingShaderBindingTableDescriptor* descriptor)
-        : ObjectBase(device) {
+        : ObjectBase(device), mGroupCount(descriptor->groupCount) {
         if (!device->IsExtensionEnabled(Extension::RayTracing)) {
             GetDevice()->ConsumedError(
                 DAWN_VALIDATION_ERROR("Ray Tracing extension is not enabled"));
@@ -140,6 +148,66 @@ namespace dawn_native {
         DestroyInternal();
     }
 
+    void RayTracingShaderBindingTableBase::UpdateGroup(uint32_t groupIndex,
+                                                       uint32_t sourceGroupIndex) {
+        UpdateGroups(groupIndex, 1, &sourceGroupIndex);
+    }
+
+    void RayTracingShaderBindingTableBase::UpdateGroups(uint32_t startGroup,
+                                                        uint32_t groupCount,
+                                                        const uint32_t* sourceGroupIndices) {
+        for (uint32_t ii = 0; ii < groupCount; ++ii) {
+            if (GetDevice()->ConsumedError(
+                    ValidateUpdateGroup(startGroup + ii, sourceGroupIndices[ii]))) {
+                return;
+            }
+        }
+        ASSERT(!IsError());
+
+        if (GetDevice()->ConsumedError(
+                UpdateGroupsImpl(startGroup, groupCount, sourceGroupIndices))) {
+            return;
+        }
+    }
+
+    MaybeError RayTracingShaderBindingTableBase::ValidateUpdateGroup(
+        uint32_t groupIndex,
+        uint32_t sourceGroupIndex) const {
+        DAWN_TRY(GetDevice()->ValidateIsAlive());
+        DAWN_TRY(GetDevice()->ValidateObject(this));
+
+        if (IsDestroyed()) {
+            return DAWN_VALIDATION_ERROR("Shader binding table must not be destroyed");
+        }
+        if (groupIndex >= mGroupCount) {
+            return DAWN_VALIDATION_ERROR("Group index out of bounds");
+        }
+        if (sourceGroupIndex >= mGroupCount) {
+            return DAWN_VALIDATION_ERROR("Source group index out of bounds");
+        }
+
+        return {};
+    }
+
+    uint32_t RayTracingShaderBindingTableBase::GetGroupCount() const {
+        return mGroupCount;
+    }
+
+    uint32_t RayTracingShaderBindingTableBase::GetGroupStride() const {
+        ASSERT(!IsError());
+        return GetGroupStrideImpl();
+    }
+
+    uint64_t RayTracingShaderBindingTableBase::GetGroupOffset(uint32_t groupIndex) const {
+        ASSERT(!IsError());
+        ASSERT(groupIndex < mGroupCount);
+        return uint64_t(groupIndex) * GetGroupStrideImpl();
+    }
+
+    uint32_t RayTracingShaderBindingTableBase::GetGroupStrideImpl() const {
+        return 0;
+    }
+
     void RayTracingShaderBindingTableBase::DestroyInternal() {
         if (!IsDestroyed()) {
             DestroyImpl();
@@ -36,9 +36,24 @@ namespace dawn_native {
         ~RayTracingShaderBindingTableBase();
 
         void Destroy();
+        // Repoints table records at other groups declared at creation so that, for example,
+        // a material hot-swap is a handle-sized write instead of a full table rebuild.
+        void UpdateGroup(uint32_t groupIndex, uint32_t sourceGroupIndex);
+        void UpdateGroups(uint32_t startGroup,
+                          uint32_t groupCount,
+                          const uint32_t* sourceGroupIndices);
         bool IsDestroyed() const;
         void SetDestroyState(bool state);
 
+        uint32_t GetGroupCount() const;
+
+        // Layout introspection, exposed through dawn_native::GetShaderBindingTableGroupStride
+        // and GetShaderBindingTableGroupOffset: records are laid out contiguously, one per
+        // group, GetGroupStride() bytes apart. Lets tooling bake record contents offline
+        // without backend-specific queries.
+        uint32_t GetGroupStride() const;
+        uint64_t GetGroupOffset(uint32_t groupIndex) const;
+
         static RayTracingShaderBindingTableBase* MakeError(DeviceBase* device);
 
       protected:
@@ -48,10 +63,20 @@ namespace dawn_native {
 
       private:
         virtual uint32_t GetOffsetImpl(wgpu::ShaderStage stageKind);
+        // The distance between two records; the handle size of the backend today.
+        virtual uint32_t GetGroupStrideImpl() const;
+
+        MaybeError ValidateUpdateGroup(uint32_t groupIndex, uint32_t sourceGroupIndex) const;
 
         bool mIsDestroyed = false;
+        uint32_t mGroupCount = 0;
 
         virtual void DestroyImpl() = 0;
+        // Writes a contiguous range of records in one call so bulk updates do not pay a
+        // per-record virtual call.
+        virtual MaybeError UpdateGroupsImpl(uint32_t startGroup,
+                                            uint32_t groupCount,
+                                            const uint32_t* sourceGroupIndices) = 0;
     };
 
 }  // namespace dawn_native
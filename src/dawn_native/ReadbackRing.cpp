@@ -0,0 +1,121 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/ReadbackRing.h"
+#include "dawn_native/Buffer.h"
+#include "dawn_native/Device.h"
+
+namespace dawn_native {
+
+    ReadbackRing::ReadbackRing(DeviceBase* device) : mDevice(device) {
+        mRingBuffers.emplace_back(std::unique_ptr<RingBuffer>(
+            new RingBuffer{nullptr, RingBufferAllocator(kRingBufferSize)}));
+    }
+
+    MaybeError ReadbackRing::ReadBufferAsync(BufferBase* source,
+                                             uint64_t offset,
+                                             uint64_t size,
+                                             ReadbackCallback callback,
+                                             void* userdata) {
+        DAWN_TRY(mDevice->ValidateIsAlive());
+        DAWN_TRY(mDevice->ValidateObject(source));
+
+        if (size == 0) {
+            return DAWN_VALIDATION_ERROR("Readback size must be greater than 0");
+        }
+
+        if (size > source->GetSize() || offset > source->GetSize() - size) {
+            return DAWN_VALIDATION_ERROR("Readback range is out of bounds of the buffer");
+        }
+
+        if (!(source->GetUsage() & wgpu::BufferUsage::CopySrc)) {
+            return DAWN_VALIDATION_ERROR("Buffer needs the CopySrc usage bit");
+        }
+
+        DAWN_TRY(source->ValidateCanUseInSubmitNow());
+
+        const Serial serial = mDevice->GetPendingCommandSerial();
+
+        Request request;
+        request.size = size;
+        request.callback = callback;
+        request.userdata = userdata;
+
+        // Keep slice offsets 4-byte aligned so callbacks can read the results as words.
+        const uint64_t allocationSize = (size + 3u) & ~uint64_t(3u);
+
+        if (allocationSize > kRingBufferSize) {
+            // Too large for any ring; use a dedicated staging buffer that lives until the
+            // callback has run.
+            DAWN_TRY_ASSIGN(request.dedicatedBuffer, mDevice->CreateReadbackStagingBuffer(size));
+            request.stagingBuffer = request.dedicatedBuffer.get();
+            request.startOffset = 0;
+        } else {
+            // First-fit over the rings, appending a new ring when all of them are full.
+            RingBuffer* targetRingBuffer = nullptr;
+            uint64_t startOffset = RingBufferAllocator::kInvalidOffset;
+            for (auto& ringBuffer : mRingBuffers) {
+                startOffset = ringBuffer->mAllocator.Allocate(allocationSize, serial);
+                if (startOffset != RingBufferAllocator::kInvalidOffset) {
+                    targetRingBuffer = ringBuffer.get();
+                    break;
+                }
+            }
+
+            if (targetRingBuffer == nullptr) {
+                mRingBuffers.emplace_back(std::unique_ptr<RingBuffer>(
+                    new RingBuffer{nullptr, RingBufferAllocator(kRingBufferSize)}));
+                targetRingBuffer = mRingBuffers.back().get();
+                startOffset = targetRingBuffer->mAllocator.Allocate(allocationSize, serial);
+            }
+            ASSERT(startOffset != RingBufferAllocator::kInvalidOffset);
+
+            // Note: the staging memory backing a ring is lazily created.
+            if (targetRingBuffer->mStagingBuffer == nullptr) {
+                std::unique_ptr<StagingBufferBase> stagingBuffer;
+                DAWN_TRY_ASSIGN(stagingBuffer, mDevice->CreateReadbackStagingBuffer(
+                                                   targetRingBuffer->mAllocator.GetSize()));
+                targetRingBuffer->mStagingBuffer = std::move(stagingBuffer);
+            }
+
+            request.stagingBuffer = targetRingBuffer->mStagingBuffer.get();
+            request.startOffset = startOffset;
+        }
+
+        DAWN_TRY(mDevice->CopyFromBufferToStaging(source, offset, request.stagingBuffer,
+                                                  request.startOffset, size));
+
+        mInFlightRequests.Enqueue(std::move(request), serial);
+        return {};
+    }
+
+    void ReadbackRing::Tick(Serial lastCompletedSerial) {
+        for (Request& request : mInFlightRequests.IterateUpTo(lastCompletedSerial)) {
+            const uint8_t* data =
+                static_cast<const uint8_t*>(request.stagingBuffer->GetMappedPointer()) +
+                request.startOffset;
+            request.callback(data, request.size, request.userdata);
+        }
+        mInFlightRequests.ClearUpTo(lastCompletedSerial);
+
+        // Reclaim ring memory whose requests completed. Never erase the last ring so a
+        // steady readback load doesn't recreate its staging memory every frame.
+        for (size_t i = 0; i < mRingBuffers.size(); ++i) {
+            mRingBuffers[i]->mAllocator.Deallocate(lastCompletedSerial);
+            if (mRingBuffers[i]->mAllocator.Empty() && i < mRingBuffers.size() - 1) {
+                mRingBuffers.erase(mRingBuffers.begin() + i);
+            }
+        }
+    }
+}  // namespace dawn_native
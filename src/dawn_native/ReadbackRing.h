@@ -0,0 +1,76 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_READBACKRING_H_
+#define DAWNNATIVE_READBACKRING_H_
+
+#include "dawn_native/Forward.h"
+#include "dawn_native/RingBufferAllocator.h"
+#include "dawn_native/StagingBuffer.h"
+
+// ReadbackRing is the front-end implementation used to manage ring buffers for readback
+// usage: the DynamicUploader in the reverse direction. Small recurring GPU->CPU reads are
+// copied into slices of persistently mapped readback staging memory and handed to a
+// callback once the copy's serial completes, instead of each read creating, mapping and
+// destroying a dedicated MapRead buffer.
+namespace dawn_native {
+
+    using ReadbackCallback = void (*)(const void* data, uint64_t size, void* userdata);
+
+    class ReadbackRing {
+      public:
+        ReadbackRing(DeviceBase* device);
+        ~ReadbackRing() = default;
+
+        // Records a copy of [offset, offset + size) of |source| into the ring on the pending
+        // commands and registers |callback| to be invoked with the slice contents on the
+        // Tick that observes those commands complete. The data passed to the callback is
+        // only valid for the duration of the call.
+        MaybeError ReadBufferAsync(BufferBase* source,
+                                   uint64_t offset,
+                                   uint64_t size,
+                                   ReadbackCallback callback,
+                                   void* userdata);
+
+        void Tick(Serial lastCompletedSerial);
+
+      private:
+        // Readbacks are small and recurring, so one modest ring is usually enough. More
+        // rings of the same size are appended when a frame reads back more than this.
+        static constexpr uint64_t kRingBufferSize = 1 * 1024 * 1024;
+
+        struct RingBuffer {
+            std::unique_ptr<StagingBufferBase> mStagingBuffer;
+            RingBufferAllocator mAllocator;
+        };
+
+        struct Request {
+            StagingBufferBase* stagingBuffer = nullptr;
+            uint64_t startOffset = 0;
+            uint64_t size = 0;
+            ReadbackCallback callback = nullptr;
+            void* userdata = nullptr;
+            // Owns the staging memory for requests too large for any ring; destroyed once
+            // the callback has run.
+            std::unique_ptr<StagingBufferBase> dedicatedBuffer;
+        };
+
+        std::vector<std::unique_ptr<RingBuffer>> mRingBuffers;
+        SerialQueue<Request> mInFlightRequests;
+
+        DeviceBase* mDevice;
+    };
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_READBACKRING_H_
@@ -14,6 +14,7 @@
 
 #include "dawn_native/RenderEncoderBase.h"
 
+#include "common/Assert.h"
 #include "common/Constants.h"
 #include "dawn_native/Buffer.h"
 #include "dawn_native/CommandEncoder.h"
@@ -45,8 +46,10 @@ namespace dawn_native {
                                  uint32_t firstVertex,
                                  uint32_t firstInstance) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
-            if (mDisableBaseInstance && firstInstance != 0) {
-                return DAWN_VALIDATION_ERROR("Non-zero first instance not supported");
+            if (GetDevice()->IsValidationEnabled()) {
+                if (mDisableBaseInstance && firstInstance != 0) {
+                    return DAWN_VALIDATION_ERROR("Non-zero first instance not supported");
+                }
             }
 
             DrawCmd* draw = allocator->Allocate<DrawCmd>(Command::Draw);
@@ -65,11 +68,13 @@ namespace dawn_native {
                                         int32_t baseVertex,
                                         uint32_t firstInstance) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
-            if (mDisableBaseInstance && firstInstance != 0) {
-                return DAWN_VALIDATION_ERROR("Non-zero first instance not supported");
-            }
-            if (mDisableBaseInstance && baseVertex != 0) {
-                return DAWN_VALIDATION_ERROR("Non-zero base vertex not supported");
+            if (GetDevice()->IsValidationEnabled()) {
+                if (mDisableBaseInstance && firstInstance != 0) {
+                    return DAWN_VALIDATION_ERROR("Non-zero first instance not supported");
+                }
+                if (mDisableBaseInstance && baseVertex != 0) {
+                    return DAWN_VALIDATION_ERROR("Non-zero base vertex not supported");
+                }
             }
 
             DrawIndexedCmd* draw = allocator->Allocate<DrawIndexedCmd>(Command::DrawIndexed);
@@ -85,12 +90,15 @@ namespace dawn_native {
 
     void RenderEncoderBase::DrawIndirect(BufferBase* indirectBuffer, uint64_t indirectOffset) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
-            DAWN_TRY(GetDevice()->ValidateObject(indirectBuffer));
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(indirectBuffer));
 
-            if (indirectOffset >= indirectBuffer->GetSize() ||
-                indirectOffset + kDrawIndirectSize > indirectBuffer->GetSize()) {
-                return DAWN_VALIDATION_ERROR("Indirect offset out of bounds");
+                if (indirectOffset >= indirectBuffer->GetSize() ||
+                    indirectOffset + kDrawIndirectSize > indirectBuffer->GetSize()) {
+                    return DAWN_VALIDATION_ERROR("Indirect offset out of bounds");
+                }
             }
+            ASSERT(indirectOffset + kDrawIndirectSize <= indirectBuffer->GetSize());
 
             DrawIndirectCmd* cmd = allocator->Allocate<DrawIndirectCmd>(Command::DrawIndirect);
             cmd->indirectBuffer = indirectBuffer;
@@ -105,12 +113,15 @@ namespace dawn_native {
     void RenderEncoderBase::DrawIndexedIndirect(BufferBase* indirectBuffer,
                                                 uint64_t indirectOffset) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
-            DAWN_TRY(GetDevice()->ValidateObject(indirectBuffer));
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(indirectBuffer));
 
-            if ((indirectOffset >= indirectBuffer->GetSize() ||
-                 indirectOffset + kDrawIndexedIndirectSize > indirectBuffer->GetSize())) {
-                return DAWN_VALIDATION_ERROR("Indirect offset out of bounds");
+                if ((indirectOffset >= indirectBuffer->GetSize() ||
+                     indirectOffset + kDrawIndexedIndirectSize > indirectBuffer->GetSize())) {
+                    return DAWN_VALIDATION_ERROR("Indirect offset out of bounds");
+                }
             }
+            ASSERT(indirectOffset + kDrawIndexedIndirectSize <= indirectBuffer->GetSize());
 
             DrawIndexedIndirectCmd* cmd =
                 allocator->Allocate<DrawIndexedIndirectCmd>(Command::DrawIndexedIndirect);
@@ -123,13 +134,71 @@ namespace dawn_native {
         });
     }
 
+    void RenderEncoderBase::MultiDrawIndexedIndirect(BufferBase* indirectBuffer,
+                                                     uint64_t indirectOffset,
+                                                     uint32_t maxDrawCount,
+                                                     BufferBase* countBuffer,
+                                                     uint64_t countBufferOffset) {
+        mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(indirectBuffer));
+
+                if (maxDrawCount == 0) {
+                    return DAWN_VALIDATION_ERROR("Max draw count must not be zero");
+                }
+
+                if (indirectOffset >= indirectBuffer->GetSize() ||
+                    indirectOffset + maxDrawCount * kDrawIndexedIndirectSize >
+                        indirectBuffer->GetSize()) {
+                    return DAWN_VALIDATION_ERROR("Indirect offset out of bounds");
+                }
+
+                if (countBuffer != nullptr) {
+                    DAWN_TRY(GetDevice()->ValidateObject(countBuffer));
+
+                    if (countBufferOffset >= countBuffer->GetSize() ||
+                        countBufferOffset + sizeof(uint32_t) > countBuffer->GetSize()) {
+                        return DAWN_VALIDATION_ERROR("Count buffer offset out of bounds");
+                    }
+                }
+            }
+            ASSERT(indirectOffset + maxDrawCount * kDrawIndexedIndirectSize <=
+                   indirectBuffer->GetSize());
+
+            MultiDrawIndexedIndirectCmd* cmd =
+                allocator->Allocate<MultiDrawIndexedIndirectCmd>(Command::MultiDrawIndexedIndirect);
+            cmd->indirectBuffer = indirectBuffer;
+            cmd->indirectOffset = indirectOffset;
+            cmd->maxDrawCount = maxDrawCount;
+            cmd->countBuffer = countBuffer;
+            cmd->countBufferOffset = countBufferOffset;
+
+            mUsageTracker.BufferUsedAs(indirectBuffer, wgpu::BufferUsage::Indirect);
+            if (countBuffer != nullptr) {
+                mUsageTracker.BufferUsedAs(countBuffer, wgpu::BufferUsage::Indirect);
+            }
+
+            return {};
+        });
+    }
+
     void RenderEncoderBase::SetPipeline(RenderPipelineBase* pipeline) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
-            DAWN_TRY(GetDevice()->ValidateObject(pipeline));
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(pipeline));
+            }
+            ASSERT(!pipeline->IsError());
+
+            // Re-setting the current pipeline is a no-op; skip recording it. The previously
+            // recorded command keeps the pipeline referenced.
+            if (pipeline == mLastPipeline) {
+                return {};
+            }
 
             SetRenderPipelineCmd* cmd =
                 allocator->Allocate<SetRenderPipelineCmd>(Command::SetRenderPipeline);
             cmd->pipeline = pipeline;
+            mLastPipeline = pipeline;
 
             return {};
         });
@@ -137,21 +206,22 @@ namespace dawn_native {
 
     void RenderEncoderBase::SetIndexBuffer(BufferBase* buffer, uint64_t offset, uint64_t size) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
-            DAWN_TRY(GetDevice()->ValidateObject(buffer));
-
             uint64_t bufferSize = buffer->GetSize();
-            if (offset > bufferSize) {
-                return DAWN_VALIDATION_ERROR("Offset larger than the buffer size");
-            }
-            uint64_t remainingSize = bufferSize - offset;
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(buffer));
 
-            if (size == 0) {
-                size = remainingSize;
-            } else {
-                if (size > remainingSize) {
+                if (offset > bufferSize) {
+                    return DAWN_VALIDATION_ERROR("Offset larger than the buffer size");
+                }
+                if (size != 0 && size > bufferSize - offset) {
                     return DAWN_VALIDATION_ERROR("Size + offset larger than the buffer size");
                 }
             }
+            ASSERT(offset <= bufferSize);
+
+            if (size == 0) {
+                size = bufferSize - offset;
+            }
 
             SetIndexBufferCmd* cmd =
                 allocator->Allocate<SetIndexBufferCmd>(Command::SetIndexBuffer);
@@ -170,24 +240,26 @@ namespace dawn_native {
                                             uint64_t offset,
                                             uint64_t size) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
-            DAWN_TRY(GetDevice()->ValidateObject(buffer));
+            uint64_t bufferSize = buffer->GetSize();
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(buffer));
 
-            if (slot >= kMaxVertexBuffers) {
-                return DAWN_VALIDATION_ERROR("Vertex buffer slot out of bounds");
-            }
+                if (slot >= kMaxVertexBuffers) {
+                    return DAWN_VALIDATION_ERROR("Vertex buffer slot out of bounds");
+                }
 
-            uint64_t bufferSize = buffer->GetSize();
-            if (offset > bufferSize) {
-                return DAWN_VALIDATION_ERROR("Offset larger than the buffer size");
+                if (offset > bufferSize) {
+                    return DAWN_VALIDATION_ERROR("Offset larger than the buffer size");
+                }
+                if (size != 0 && size > bufferSize - offset) {
+                    return DAWN_VALIDATION_ERROR("Size + offset larger than the buffer size");
+                }
             }
-            uint64_t remainingSize = bufferSize - offset;
+            ASSERT(slot < kMaxVertexBuffers);
+            ASSERT(offset <= bufferSize);
 
             if (size == 0) {
-                size = remainingSize;
-            } else {
-                if (size > remainingSize) {
-                    return DAWN_VALIDATION_ERROR("Size + offset larger than the buffer size");
-                }
+                size = bufferSize - offset;
             }
 
             SetVertexBufferCmd* cmd =
@@ -36,6 +36,11 @@ namespace dawn_native {
 
         void DrawIndirect(BufferBase* indirectBuffer, uint64_t indirectOffset);
         void DrawIndexedIndirect(BufferBase* indirectBuffer, uint64_t indirectOffset);
+        void MultiDrawIndexedIndirect(BufferBase* indirectBuffer,
+                                      uint64_t indirectOffset,
+                                      uint32_t maxDrawCount,
+                                      BufferBase* countBuffer,
+                                      uint64_t countBufferOffset);
 
         void SetPipeline(RenderPipelineBase* pipeline);
 
@@ -46,6 +51,11 @@ namespace dawn_native {
         // Construct an "error" render encoder base.
         RenderEncoderBase(DeviceBase* device, EncodingContext* encodingContext, ErrorTag errorTag);
 
+        // Used to skip recording redundant SetPipeline calls; kept alive by the recorded
+        // command that set it. Protected so ExecuteBundles can forget it along with the
+        // rest of the pass state.
+        RenderPipelineBase* mLastPipeline = nullptr;
+
       private:
         const bool mDisableBaseVertex;
         const bool mDisableBaseInstance;
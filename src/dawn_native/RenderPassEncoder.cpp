@@ -149,6 +149,13 @@ namespace dawn_native {
             for (uint32_t i = 0; i < count; ++i) {
                 bundles[i] = renderBundles[i];
 
+                // Bundles are immutable, so a bundle already executed in this pass has
+                // already contributed its full resource usage to the pass's union and
+                // merging it again would only redo the same work.
+                if (!mExecutedBundles.insert(renderBundles[i]).second) {
+                    continue;
+                }
+
                 const PassResourceUsage& usages = bundles[i]->GetResourceUsage();
                 for (uint32_t i = 0; i < usages.buffers.size(); ++i) {
                     mUsageTracker.BufferUsedAs(usages.buffers[i], usages.bufferUsages[i]);
@@ -159,6 +166,11 @@ namespace dawn_native {
                 }
             }
 
+            // Executing bundles resets the pass's pipeline and bind group state, so sets
+            // that repeat pre-bundle state must be recorded again.
+            ForgetLastSetState();
+            mLastPipeline = nullptr;
+
             return {};
         });
     }
@@ -18,6 +18,8 @@
 #include "dawn_native/Error.h"
 #include "dawn_native/RenderEncoderBase.h"
 
+#include <set>
+
 namespace dawn_native {
 
     class RenderBundleBase;
@@ -56,6 +58,11 @@ namespace dawn_native {
         // For render and compute passes, the encoding context is borrowed from the command encoder.
         // Keep a reference to the encoder to make sure the context isn't freed.
         Ref<CommandEncoder> mCommandEncoder;
+
+        // Bundles whose resource usage was already merged into this pass. Bundles are
+        // immutable, so re-executing one contributes nothing new to the usage union and
+        // the merge can be skipped.
+        std::set<RenderBundleBase*> mExecutedBundles;
     };
 
 }  // namespace dawn_native
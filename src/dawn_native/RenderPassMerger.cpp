@@ -0,0 +1,285 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/RenderPassMerger.h"
+
+#include "common/BitSetIterator.h"
+#include "dawn_native/AttachmentState.h"
+#include "dawn_native/Commands.h"
+
+#include <algorithm>
+
+namespace dawn_native {
+
+    namespace {
+
+        // Whether ending the pass begun by |a| and immediately beginning |b| can be
+        // collapsed into one pass: same attachment views, and the second pass consumes
+        // exactly what the first one leaves behind.
+        bool CanMergePasses(const BeginRenderPassCmd* a, const BeginRenderPassCmd* b) {
+            if (a->attachmentState.Get() != b->attachmentState.Get()) {
+                return false;
+            }
+            for (uint32_t i : IterateBitSet(a->attachmentState->GetColorAttachmentsMask())) {
+                const RenderPassColorAttachmentInfo& ca = a->colorAttachments[i];
+                const RenderPassColorAttachmentInfo& cb = b->colorAttachments[i];
+                if (ca.view.Get() != cb.view.Get() ||
+                    ca.resolveTarget.Get() != cb.resolveTarget.Get()) {
+                    return false;
+                }
+                if (cb.loadOp != wgpu::LoadOp::Load || ca.storeOp != wgpu::StoreOp::Store) {
+                    return false;
+                }
+            }
+            if (a->attachmentState->HasDepthStencilAttachment()) {
+                const RenderPassDepthStencilAttachmentInfo& da = a->depthStencilAttachment;
+                const RenderPassDepthStencilAttachmentInfo& db = b->depthStencilAttachment;
+                if (da.view.Get() != db.view.Get()) {
+                    return false;
+                }
+                if (db.depthLoadOp != wgpu::LoadOp::Load ||
+                    db.stencilLoadOp != wgpu::LoadOp::Load ||
+                    da.depthStoreOp != wgpu::StoreOp::Store ||
+                    da.stencilStoreOp != wgpu::StoreOp::Store) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // True when every resource used by both passes is used the same way. The merged
+        // usage entry is never re-validated, so this keeps it equivalent to the union of
+        // the two separately validated ones.
+        bool CanMergeUsages(const PassResourceUsage& a, const PassResourceUsage& b) {
+            for (size_t i = 0; i < b.buffers.size(); ++i) {
+                for (size_t j = 0; j < a.buffers.size(); ++j) {
+                    if (a.buffers[j] == b.buffers[i] && a.bufferUsages[j] != b.bufferUsages[i]) {
+                        return false;
+                    }
+                }
+            }
+            for (size_t i = 0; i < b.textures.size(); ++i) {
+                for (size_t j = 0; j < a.textures.size(); ++j) {
+                    if (a.textures[j] == b.textures[i] &&
+                        (a.textureUsages[j].usage != b.textureUsages[i].usage ||
+                         a.textureUsages[j].subresourceUsages !=
+                             b.textureUsages[i].subresourceUsages)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Appends the resources of |b| that |a| doesn't already track. Only called after
+        // CanMergeUsages, so the resources both passes use carry identical usages.
+        void MergeUsages(PassResourceUsage* a, const PassResourceUsage& b) {
+            for (size_t i = 0; i < b.buffers.size(); ++i) {
+                if (std::find(a->buffers.begin(), a->buffers.end(), b.buffers[i]) ==
+                    a->buffers.end()) {
+                    a->buffers.push_back(b.buffers[i]);
+                    a->bufferUsages.push_back(b.bufferUsages[i]);
+                }
+            }
+            for (size_t i = 0; i < b.textures.size(); ++i) {
+                if (std::find(a->textures.begin(), a->textures.end(), b.textures[i]) ==
+                    a->textures.end()) {
+                    a->textures.push_back(b.textures[i]);
+                    a->textureUsages.push_back(b.textureUsages[i]);
+                }
+            }
+            for (RayTracingAccelerationContainerBase* container : b.accelerationContainers) {
+                if (std::find(a->accelerationContainers.begin(), a->accelerationContainers.end(),
+                              container) == a->accelerationContainers.end()) {
+                    a->accelerationContainers.push_back(container);
+                }
+            }
+        }
+
+        // Walks the tape without copying it to decide whether a rewrite is worth doing.
+        // Leaves |in| reset. Mirrors the merge conditions of RewriteWithMerges.
+        bool HasMergeableBoundary(CommandIterator* in, const PerPassUsages& passUsages) {
+            const BeginRenderPassCmd* openPass = nullptr;
+            bool openPassSetsDynamicState = false;
+            bool pendingEnd = false;
+            // Pass usages are recorded in pass order, across all pass types.
+            size_t passIndex = 0;
+            size_t openPassUsage = 0;
+
+            Command type;
+            while (in->NextCommandId(&type)) {
+                switch (type) {
+                    case Command::BeginComputePass:
+                    case Command::BeginRayTracingPass:
+                        SkipCommand(in, type);
+                        pendingEnd = false;
+                        openPass = nullptr;
+                        passIndex++;
+                        break;
+
+                    case Command::BeginRenderPass: {
+                        const BeginRenderPassCmd* cmd = in->NextCommand<BeginRenderPassCmd>();
+                        if (pendingEnd && !openPassSetsDynamicState &&
+                            CanMergePasses(openPass, cmd) &&
+                            CanMergeUsages(passUsages[openPassUsage], passUsages[passIndex])) {
+                            in->Reset();
+                            return true;
+                        }
+                        openPass = cmd;
+                        openPassSetsDynamicState = false;
+                        openPassUsage = passIndex;
+                        pendingEnd = false;
+                        passIndex++;
+                        break;
+                    }
+
+                    case Command::EndRenderPass:
+                        SkipCommand(in, type);
+                        pendingEnd = true;
+                        break;
+
+                    case Command::SetViewport:
+                    case Command::SetScissorRect:
+                    case Command::SetBlendColor:
+                    case Command::SetStencilReference:
+                        SkipCommand(in, type);
+                        openPassSetsDynamicState = true;
+                        break;
+
+                    default:
+                        SkipCommand(in, type);
+                        if (pendingEnd) {
+                            // A command between the passes keeps the boundary.
+                            pendingEnd = false;
+                            openPass = nullptr;
+                        }
+                        break;
+                }
+            }
+            in->Reset();
+            return false;
+        }
+
+        CommandIterator RewriteWithMerges(CommandIterator* in,
+                                          CommandBlockPool* pool,
+                                          PerPassUsages* passUsages) {
+            CommandAllocator output;
+            output.SetBlockPool(pool);
+
+            PerPassUsages mergedUsages;
+            mergedUsages.reserve(passUsages->size());
+
+            // The render pass currently open in the output tape; its EndRenderPass is
+            // withheld until the next command shows the boundary can't be merged away.
+            // The pointer stays valid because command blocks never move.
+            BeginRenderPassCmd* openPass = nullptr;
+            bool openPassSetsDynamicState = false;
+            bool pendingEnd = false;
+            size_t passIndex = 0;
+
+            auto FlushPendingEnd = [&] {
+                if (pendingEnd) {
+                    output.Allocate<EndRenderPassCmd>(Command::EndRenderPass);
+                    pendingEnd = false;
+                    openPass = nullptr;
+                }
+            };
+
+            Command type;
+            while (in->NextCommandId(&type)) {
+                switch (type) {
+                    case Command::BeginComputePass:
+                    case Command::BeginRayTracingPass:
+                        FlushPendingEnd();
+                        mergedUsages.push_back((*passUsages)[passIndex]);
+                        passIndex++;
+                        CopyCommand(in, &output, type);
+                        break;
+
+                    case Command::BeginRenderPass: {
+                        const BeginRenderPassCmd* cmd = in->NextCommand<BeginRenderPassCmd>();
+                        if (pendingEnd && !openPassSetsDynamicState &&
+                            CanMergePasses(openPass, cmd) &&
+                            CanMergeUsages(mergedUsages.back(), (*passUsages)[passIndex])) {
+                            // Continue the open pass: the End/Begin pair is dropped and the
+                            // merged pass finishes with the second pass's store ops. Its
+                            // load ops are Load so clear colors don't matter.
+                            for (uint32_t i : IterateBitSet(
+                                     openPass->attachmentState->GetColorAttachmentsMask())) {
+                                openPass->colorAttachments[i].storeOp =
+                                    cmd->colorAttachments[i].storeOp;
+                            }
+                            if (openPass->attachmentState->HasDepthStencilAttachment()) {
+                                openPass->depthStencilAttachment.depthStoreOp =
+                                    cmd->depthStencilAttachment.depthStoreOp;
+                                openPass->depthStencilAttachment.stencilStoreOp =
+                                    cmd->depthStencilAttachment.stencilStoreOp;
+                            }
+                            MergeUsages(&mergedUsages.back(), (*passUsages)[passIndex]);
+                            pendingEnd = false;
+                        } else {
+                            FlushPendingEnd();
+                            openPass =
+                                output.Allocate<BeginRenderPassCmd>(Command::BeginRenderPass);
+                            *openPass = *cmd;
+                            openPassSetsDynamicState = false;
+                            mergedUsages.push_back((*passUsages)[passIndex]);
+                        }
+                        passIndex++;
+                        break;
+                    }
+
+                    case Command::EndRenderPass:
+                        in->NextCommand<EndRenderPassCmd>();
+                        pendingEnd = true;
+                        break;
+
+                    case Command::SetViewport:
+                    case Command::SetScissorRect:
+                    case Command::SetBlendColor:
+                    case Command::SetStencilReference:
+                        openPassSetsDynamicState = true;
+                        CopyCommand(in, &output, type);
+                        break;
+
+                    default:
+                        FlushPendingEnd();
+                        CopyCommand(in, &output, type);
+                        break;
+                }
+            }
+            FlushPendingEnd();
+
+            *passUsages = std::move(mergedUsages);
+
+            // The copies above duplicated every Ref<>; release the references the source
+            // tape still holds before dropping it.
+            FreeCommands(in);
+            return CommandIterator(std::move(output));
+        }
+
+    }  // anonymous namespace
+
+    CommandIterator MergeCompatibleRenderPasses(CommandIterator commands,
+                                                CommandBlockPool* pool,
+                                                PerPassUsages* passUsages) {
+        commands.Reset();
+        if (!HasMergeableBoundary(&commands, *passUsages)) {
+            // The common case: hand the tape back untouched.
+            return commands;
+        }
+        return RewriteWithMerges(&commands, pool, passUsages);
+    }
+
+}  // namespace dawn_native
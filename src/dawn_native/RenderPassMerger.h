@@ -0,0 +1,46 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_RENDERPASSMERGER_H_
+#define DAWNNATIVE_RENDERPASSMERGER_H_
+
+#include "dawn_native/CommandAllocator.h"
+#include "dawn_native/PassResourceUsage.h"
+
+namespace dawn_native {
+
+    // Merges back-to-back render passes that target the same attachments into a single
+    // pass, removing the store/load round trip the boundary costs on every backend (and a
+    // full tile flush on tilers). A boundary is merged when no command separates the
+    // EndRenderPass from the next BeginRenderPass, the passes share the same attachment
+    // state and attachment views, the second pass loads everything the first one stores,
+    // and the merged-away pass set no dynamic state (a pass boundary resets viewport,
+    // scissor, blend color and stencil reference to their defaults, which the following
+    // pass may rely on).
+    //
+    // Backends walk the per-pass resource usages by pass index, so merging also collapses
+    // the corresponding |passUsages| entries. To keep the merged usages equivalent to the
+    // separately validated ones, a boundary is only merged when resources used by both
+    // passes are used the same way.
+    //
+    // The tape is only rewritten when a mergeable boundary exists; otherwise |commands| is
+    // returned untouched. |pool| backs the blocks of the rewritten tape. Used by
+    // CommandEncoder::Finish after validation so each pass is still validated on its own.
+    CommandIterator MergeCompatibleRenderPasses(CommandIterator commands,
+                                                CommandBlockPool* pool,
+                                                PerPassUsages* passUsages);
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_RENDERPASSMERGER_H_
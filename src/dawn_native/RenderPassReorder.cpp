@@ -0,0 +1,208 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/RenderPassReorder.h"
+
+#include "common/Assert.h"
+#include "dawn_native/BindGroup.h"
+#include "dawn_native/Buffer.h"
+#include "dawn_native/Commands.h"
+#include "dawn_native/PipelineLayout.h"
+#include "dawn_native/RayTracingAccelerationContainer.h"
+#include "dawn_native/RayTracingBundle.h"
+#include "dawn_native/RenderBundle.h"
+#include "dawn_native/RenderPipeline.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace dawn_native {
+
+    namespace {
+
+        template <typename T>
+        void CopyCmd(CommandIterator* in, CommandAllocator* out, Command type) {
+            *out->Allocate<T>(type) = *in->NextCommand<T>();
+        }
+
+        // A SetRenderPipeline and everything recorded until the next one, buffered in its
+        // own allocator so the sequences can be emitted in a different order. The first
+        // sequence of a pass holds the commands before any pipeline and always stays first.
+        struct DrawSequence {
+            CommandAllocator commands;
+            RenderPipelineBase* pipeline = nullptr;
+            // Group bound at index 0, used as the secondary sort key so sequences sharing
+            // per-material bindings end up adjacent too.
+            BindGroupBase* firstBindGroup = nullptr;
+            bool selfContained = true;
+
+            // State set so far within the sequence, to decide self containment at each draw.
+            std::bitset<kMaxBindGroups> bindGroupsSet;
+            std::bitset<kMaxVertexBuffers> vertexBuffersSet;
+            bool indexBufferSet = false;
+        };
+
+        // Consumes a render pass (everything up to and including EndRenderPass) from |in|
+        // and writes it to |out|, with the draw sequences sorted when that is safe.
+        void ReorderPass(CommandIterator* in, CommandAllocator* out) {
+            std::vector<std::unique_ptr<DrawSequence>> sequences;
+            sequences.push_back(std::make_unique<DrawSequence>());
+            DrawSequence* current = sequences.back().get();
+
+            bool sawPipeline = false;
+            bool reorderable = true;
+
+            // Evaluated at every draw: the draw may only depend on state the sequence set
+            // itself, otherwise moving the sequence would change what the draw sees.
+            auto CheckDrawSelfContained = [&](bool indexed) {
+                if (!sawPipeline) {
+                    // A draw before any pipeline; validation rejects this later but it must
+                    // not be moved meanwhile.
+                    reorderable = false;
+                    return;
+                }
+                const RenderPipelineBase* pipeline = current->pipeline;
+                if ((pipeline->GetLayout()->GetBindGroupLayoutsMask() & ~current->bindGroupsSet)
+                        .any() ||
+                    (pipeline->GetVertexBufferSlotsUsed() & ~current->vertexBuffersSet).any() ||
+                    (indexed && !current->indexBufferSet)) {
+                    current->selfContained = false;
+                }
+            };
+
+            Command type;
+            while (in->NextCommandId(&type)) {
+                if (type == Command::EndRenderPass) {
+                    in->NextCommand<EndRenderPassCmd>();
+                    break;
+                }
+
+                switch (type) {
+                    case Command::SetRenderPipeline: {
+                        const SetRenderPipelineCmd* cmd =
+                            in->NextCommand<SetRenderPipelineCmd>();
+                        sequences.push_back(std::make_unique<DrawSequence>());
+                        current = sequences.back().get();
+                        current->pipeline = cmd->pipeline.Get();
+                        sawPipeline = true;
+                        *current->commands.Allocate<SetRenderPipelineCmd>(type) = *cmd;
+                        break;
+                    }
+
+                    case Command::SetBindGroup: {
+                        const SetBindGroupCmd* cmd = in->NextCommand<SetBindGroupCmd>();
+                        if (sawPipeline) {
+                            current->bindGroupsSet.set(cmd->index);
+                            if (cmd->index == 0 && current->firstBindGroup == nullptr) {
+                                current->firstBindGroup = cmd->group.Get();
+                            }
+                        }
+                        *current->commands.Allocate<SetBindGroupCmd>(type) = *cmd;
+                        if (cmd->dynamicOffsetCount > 0) {
+                            CopyDataArray<uint32_t>(in, &current->commands,
+                                                    cmd->dynamicOffsetCount);
+                        }
+                        break;
+                    }
+
+                    case Command::SetVertexBuffer: {
+                        const SetVertexBufferCmd* cmd = in->NextCommand<SetVertexBufferCmd>();
+                        current->vertexBuffersSet.set(cmd->slot);
+                        *current->commands.Allocate<SetVertexBufferCmd>(type) = *cmd;
+                        break;
+                    }
+
+                    case Command::SetIndexBuffer:
+                        current->indexBufferSet = true;
+                        CopyCmd<SetIndexBufferCmd>(in, &current->commands, type);
+                        break;
+
+                    case Command::Draw:
+                    case Command::DrawIndirect:
+                        CheckDrawSelfContained(false);
+                        CopyCommand(in, &current->commands, type);
+                        break;
+
+                    case Command::DrawIndexed:
+                    case Command::DrawIndexedIndirect:
+                    case Command::MultiDrawIndexedIndirect:
+                        CheckDrawSelfContained(true);
+                        CopyCommand(in, &current->commands, type);
+                        break;
+
+                    default:
+                        // Dynamic state, immediate data, bundles, queries and markers make
+                        // the pass order sensitive once a pipeline was set; before that they
+                        // land in the leading sequence which is never moved.
+                        if (sawPipeline) {
+                            reorderable = false;
+                        }
+                        CopyCommand(in, &current->commands, type);
+                        break;
+                }
+            }
+
+            for (size_t i = 1; i < sequences.size(); ++i) {
+                if (!sequences[i]->selfContained) {
+                    reorderable = false;
+                }
+            }
+
+            if (reorderable && sequences.size() > 2) {
+                std::stable_sort(sequences.begin() + 1, sequences.end(),
+                                 [](const std::unique_ptr<DrawSequence>& a,
+                                    const std::unique_ptr<DrawSequence>& b) {
+                                     if (a->pipeline != b->pipeline) {
+                                         return a->pipeline < b->pipeline;
+                                     }
+                                     return a->firstBindGroup < b->firstBindGroup;
+                                 });
+            }
+
+            for (std::unique_ptr<DrawSequence>& sequence : sequences) {
+                CommandIterator sequenceCommands(std::move(sequence->commands));
+                Command sequenceType;
+                while (sequenceCommands.NextCommandId(&sequenceType)) {
+                    CopyCommand(&sequenceCommands, out, sequenceType);
+                }
+                FreeCommands(&sequenceCommands);
+            }
+            out->Allocate<EndRenderPassCmd>(Command::EndRenderPass);
+        }
+
+    }  // anonymous namespace
+
+    CommandIterator ReorderRenderPassDraws(CommandIterator commands, CommandBlockPool* pool) {
+        CommandAllocator output;
+        output.SetBlockPool(pool);
+
+        commands.Reset();
+        Command type;
+        while (commands.NextCommandId(&type)) {
+            if (type == Command::BeginRenderPass) {
+                CopyCmd<BeginRenderPassCmd>(&commands, &output, type);
+                ReorderPass(&commands, &output);
+            } else {
+                CopyCommand(&commands, &output, type);
+            }
+        }
+
+        // The copies above duplicated every Ref<>; release the references the source tape
+        // still holds before dropping it.
+        FreeCommands(&commands);
+        return CommandIterator(std::move(output));
+    }
+
+}  // namespace dawn_native
@@ -0,0 +1,41 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_RENDERPASSREORDER_H_
+#define DAWNNATIVE_RENDERPASSREORDER_H_
+
+#include "dawn_native/CommandAllocator.h"
+
+namespace dawn_native {
+
+    // Rewrites a finished command tape so that inside each render pass, the draw sequences
+    // (a SetRenderPipeline and everything recorded until the next one) are stably sorted by
+    // (pipeline, first bind group). Applications that interleave pipelines heavily get each
+    // pipeline bound once per pass instead of once per sequence when the backends replay the
+    // tape.
+    //
+    // The rewrite is conservative: a sequence is only moved when its draws use no state it
+    // doesn't set itself, and a pass is left in application order as soon as it records
+    // dynamic state, immediate data, bundles, queries or debug markers after its first
+    // pipeline. Commands before the first SetRenderPipeline stay at the front of the pass.
+    // Reordering changes which draw lands last on overlapping pixels, so this must only run
+    // when the application opted in with the reorder_render_pass_draws toggle.
+    //
+    // |commands| is consumed; |pool| backs the blocks of the rewritten tape. Used by
+    // CommandEncoder::Finish before validation so the reordered tape is what gets validated.
+    CommandIterator ReorderRenderPassDraws(CommandIterator commands, CommandBlockPool* pool);
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_RENDERPASSREORDER_H_
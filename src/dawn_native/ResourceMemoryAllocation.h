@@ -15,6 +15,8 @@
 #ifndef DAWNNATIVE_RESOURCEMEMORYALLOCATION_H_
 #define DAWNNATIVE_RESOURCEMEMORYALLOCATION_H_
 
+#include "dawn_native/MemoryStats.h"
+
 #include <cstdint>
 
 namespace dawn_native {
@@ -47,6 +49,11 @@ namespace dawn_native {
         uint64_t mBlockOffset = 0;
 
         AllocationMethod mMethod = AllocationMethod::kInvalid;
+
+        // The size the allocator reserved and the class it was accounted under, so the
+        // device's memory stats can be updated when the allocation is freed.
+        uint64_t mSize = 0;
+        AllocationClass mClass = AllocationClass::Buffer;
     };
 
     // Handle into a resource heap pool.
@@ -15,8 +15,10 @@
 #include "dawn_native/ShaderModule.h"
 
 #include "common/HashUtils.h"
+#include "dawn_native/Adapter.h"
 #include "dawn_native/BindGroupLayout.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/Instance.h"
 #include "dawn_native/Pipeline.h"
 #include "dawn_native/PipelineLayout.h"
 
@@ -415,7 +417,24 @@ namespace dawn_native {
             case wgpu::SType::ShaderModuleSPIRVDescriptor: {
                 const auto* spirvDesc =
                     static_cast<const ShaderModuleSPIRVDescriptor*>(chainedDescriptor);
-                DAWN_TRY(ValidateSpirv(device, spirvDesc->code, spirvDesc->codeSize));
+                // Shipped shaders are typically validated offline, in which case spirv-val
+                // dominates module creation; the toggle skips it for trusted sources while
+                // untrusted content keeps full validation.
+                if (!device->IsToggleEnabled(Toggle::SkipSpirvValidation)) {
+                    // The instance remembers blobs that already passed spirv-val. Devices
+                    // recreated after a loss share it, so warming the device back up
+                    // revalidates nothing that was validated before the reset.
+                    InstanceBase* instance = device->GetAdapter()->GetInstance();
+                    size_t blobHash = 0;
+                    HashCombine(&blobHash, spirvDesc->codeSize);
+                    for (uint32_t i = 0; i < spirvDesc->codeSize; ++i) {
+                        HashCombine(&blobHash, spirvDesc->code[i]);
+                    }
+                    if (!instance->IsSpirvValidated(blobHash)) {
+                        DAWN_TRY(ValidateSpirv(device, spirvDesc->code, spirvDesc->codeSize));
+                        instance->MarkSpirvValidated(blobHash);
+                    }
+                }
                 break;
             }
 
@@ -488,9 +507,28 @@ namespace dawn_native {
         } else {
             DAWN_TRY(ExtractSpirvInfoWithSpirvCross(compiler));
         }
+
+        // Publish the results so that future byte-identical modules can skip the extraction.
+        GetDevice()->CacheSpirvReflection(mSpirv,
+                                          {mBindingInfo, mUsedVertexAttributes, mExecutionModel,
+                                           mFragmentOutputFormatBaseTypes});
         return {};
     }
 
+    bool ShaderModuleBase::TryLoadCachedSpirvInfo() {
+        ASSERT(!IsError());
+        const ShaderModuleReflection* reflection = GetDevice()->FindCachedSpirvReflection(mSpirv);
+        if (reflection == nullptr) {
+            return false;
+        }
+
+        mBindingInfo = reflection->bindingInfo;
+        mUsedVertexAttributes = reflection->usedVertexAttributes;
+        mExecutionModel = reflection->executionModel;
+        mFragmentOutputFormatBaseTypes = reflection->fragmentOutputBaseTypes;
+        return true;
+    }
+
     MaybeError ShaderModuleBase::ExtractSpirvInfoWithSpvc() {
         shaderc_spvc_execution_model execution_model;
         DAWN_TRY(CheckSpvcSuccess(mSpvcContext.GetExecutionModel(&execution_model),
@@ -1028,7 +1066,8 @@ namespace dawn_native {
 
     shaderc_spvc::CompileOptions ShaderModuleBase::GetCompileOptions() const {
         shaderc_spvc::CompileOptions options;
-        options.SetValidate(GetDevice()->IsValidationEnabled());
+        options.SetValidate(GetDevice()->IsValidationEnabled() &&
+                            !GetDevice()->IsToggleEnabled(Toggle::SkipSpirvValidation));
         return options;
     }
 
@@ -52,6 +52,11 @@ namespace dawn_native {
 
         MaybeError ExtractSpirvInfo(const spirv_cross::Compiler& compiler);
 
+        // Tries to populate the reflection data (binding info, entry point, ...) from the
+        // device's SPIR-V reflection cache. On a hit ExtractSpirvInfo can be skipped, along
+        // with the spirv-cross parse backends would otherwise run just for reflection.
+        bool TryLoadCachedSpirvInfo();
+
         struct ShaderBindingInfo : BindingInfo {
             // The SPIRV ID of the resource.
             uint32_t id;
@@ -116,6 +121,16 @@ namespace dawn_native {
         FragmentOutputBaseTypes mFragmentOutputFormatBaseTypes;
     };
 
+    // Reflection data extracted from a SPIR-V module. Cached on the device keyed by the
+    // SPIR-V code so that byte-identical modules (for example on asset reloads) reuse the
+    // reflection instead of re-running spirv-cross.
+    struct ShaderModuleReflection {
+        ShaderModuleBase::ModuleBindingInfo bindingInfo;
+        std::bitset<kMaxVertexAttributes> usedVertexAttributes;
+        SingleShaderStage executionModel;
+        ShaderModuleBase::FragmentOutputBaseTypes fragmentOutputBaseTypes;
+    };
+
 }  // namespace dawn_native
 
 #endif  // DAWNNATIVE_SHADERMODULE_H_
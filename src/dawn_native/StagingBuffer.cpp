@@ -14,16 +14,71 @@
 
 #include "dawn_native/StagingBuffer.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define DAWN_HAS_NONTEMPORAL_STORES 1
+#    include <emmintrin.h>
+#endif
+
 namespace dawn_native {
 
-    StagingBufferBase::StagingBufferBase(size_t size) : mBufferSize(size) {
+    StagingBufferBase::StagingBufferBase(size_t size)
+        : StagingBufferBase(size, StagingAccess::Upload) {
+    }
+
+    StagingBufferBase::StagingBufferBase(size_t size, StagingAccess access)
+        : mBufferSize(size), mAccess(access) {
     }
 
     size_t StagingBufferBase::GetSize() const {
         return mBufferSize;
     }
 
+    StagingAccess StagingBufferBase::GetAccess() const {
+        return mAccess;
+    }
+
     void* StagingBufferBase::GetMappedPointer() const {
         return mMappedPointer;
     }
+
+    // static
+    void StagingBufferBase::StreamingCopy(void* dst, const void* src, size_t size) {
+#ifdef DAWN_HAS_NONTEMPORAL_STORES
+        uint8_t* dstBytes = static_cast<uint8_t*>(dst);
+        const uint8_t* srcBytes = static_cast<const uint8_t*>(src);
+
+        // Align the destination to 16 bytes with a small regular copy. memcpy only writes to
+        // the destination so it is safe on write-combined memory.
+        size_t headSize = (16 - (reinterpret_cast<uintptr_t>(dstBytes) & 15)) & 15;
+        headSize = std::min(headSize, size);
+        memcpy(dstBytes, srcBytes, headSize);
+        dstBytes += headSize;
+        srcBytes += headSize;
+        size -= headSize;
+
+        // Stream whole 16-byte blocks with non-temporal stores. The writes combine into full
+        // cache line transactions and don't pollute the cache with data the CPU won't read
+        // again. The source may be unaligned, so use unaligned loads.
+        size_t blockCount = size / 16;
+        for (size_t i = 0; i < blockCount; ++i) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcBytes) + i);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(dstBytes) + i, block);
+        }
+        dstBytes += blockCount * 16;
+        srcBytes += blockCount * 16;
+        size -= blockCount * 16;
+
+        memcpy(dstBytes, srcBytes, size);
+
+        // Make the streamed stores visible to subsequent operations; non-temporal stores are
+        // weakly ordered with respect to normal stores on x86.
+        _mm_sfence();
+#else
+        memcpy(dst, src, size);
+#endif
+    }
 }  // namespace dawn_native
\ No newline at end of file
@@ -19,21 +19,38 @@
 
 namespace dawn_native {
 
+    // Direction of a staging allocation. Upload staging memory is mapped for CPU writes and
+    // is typically write-combined; readback staging memory is allocated so the GPU can copy
+    // results into it and the CPU can then read them back efficiently.
+    enum class StagingAccess {
+        Upload,
+        Readback,
+    };
+
     class StagingBufferBase {
       public:
         StagingBufferBase(size_t size);
+        StagingBufferBase(size_t size, StagingAccess access);
         virtual ~StagingBufferBase() = default;
 
         virtual MaybeError Initialize() = 0;
 
         void* GetMappedPointer() const;
         size_t GetSize() const;
+        StagingAccess GetAccess() const;
+
+        // Copies |size| bytes from |src| to |dst| without ever reading from |dst|. Mapped
+        // upload heaps are typically write-combined memory where reads are uncached and
+        // extremely slow, so all writes into a staging buffer must go through this helper
+        // instead of open-coded loops that may read-modify-write the destination.
+        static void StreamingCopy(void* dst, const void* src, size_t size);
 
       protected:
         void* mMappedPointer = nullptr;
 
       private:
         const size_t mBufferSize;
+        const StagingAccess mAccess;
     };
 
 }  // namespace dawn_native
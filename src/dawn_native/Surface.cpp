@@ -28,6 +28,12 @@
 
 namespace dawn_native {
 
+    namespace {
+        // More buffers than any swapchain would reasonably use; this mostly guards against
+        // absurd values since each buffer slot only costs a tracked serial.
+        constexpr uint32_t kMaxHeadlessSurfaceBuffers = 16;
+    }  // anonymous namespace
+
 #if defined(DAWN_ENABLE_BACKEND_METAL)
     bool InheritsFromCAMetalLayer(void* obj);
 #endif  // defined(DAWN_ENABLE_BACKEND_METAL)
@@ -46,6 +52,19 @@ namespace dawn_native {
         }
 
         switch (chainedDescriptor->sType) {
+            case wgpu::SType::SurfaceDescriptorFromHeadless: {
+                const SurfaceDescriptorFromHeadless* headlessDesc =
+                    static_cast<const SurfaceDescriptorFromHeadless*>(chainedDescriptor);
+
+                if (headlessDesc->bufferCount == 0) {
+                    return DAWN_VALIDATION_ERROR("Headless surface needs at least one buffer");
+                }
+                if (headlessDesc->bufferCount > kMaxHeadlessSurfaceBuffers) {
+                    return DAWN_VALIDATION_ERROR("Headless surface buffer count too large");
+                }
+                break;
+            }
+
 #if defined(DAWN_ENABLE_BACKEND_METAL)
             case wgpu::SType::SurfaceDescriptorFromMetalLayer: {
                 const SurfaceDescriptorFromMetalLayer* metalDesc =
@@ -113,6 +132,14 @@ namespace dawn_native {
         const ChainedStruct* chainedDescriptor = descriptor->nextInChain;
 
         switch (chainedDescriptor->sType) {
+            case wgpu::SType::SurfaceDescriptorFromHeadless: {
+                const SurfaceDescriptorFromHeadless* headlessDesc =
+                    static_cast<const SurfaceDescriptorFromHeadless*>(chainedDescriptor);
+                mType = Type::Headless;
+                mHeadlessBufferCount = headlessDesc->bufferCount;
+                break;
+            }
+
             case wgpu::SType::SurfaceDescriptorFromMetalLayer: {
                 const SurfaceDescriptorFromMetalLayer* metalDesc =
                     static_cast<const SurfaceDescriptorFromMetalLayer*>(chainedDescriptor);
@@ -167,6 +194,11 @@ namespace dawn_native {
         return mType;
     }
 
+    uint32_t Surface::GetHeadlessBufferCount() const {
+        ASSERT(mType == Type::Headless);
+        return mHeadlessBufferCount;
+    }
+
     void* Surface::GetMetalLayer() const {
         ASSERT(mType == Type::MetalLayer);
         return mMetalLayer;
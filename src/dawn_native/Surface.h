@@ -31,6 +31,8 @@ namespace dawn_native {
     // ObjectiveC).
     // The surface is also used to store the current swapchain so that we can detach it when it is
     // replaced.
+    // A Headless surface isn't backed by any window at all; swapchains created against it are
+    // implemented entirely in the frontend (see HeadlessSwapChain).
     class Surface final : public RefCounted {
       public:
         Surface(InstanceBase* instance, const SurfaceDescriptor* descriptor);
@@ -39,10 +41,13 @@ namespace dawn_native {
         NewSwapChainBase* GetAttachedSwapChain() const;
 
         // These are valid to call on all Surfaces.
-        enum class Type { MetalLayer, WindowsHWND, Xlib };
+        enum class Type { Headless, MetalLayer, WindowsHWND, Xlib };
         Type GetType() const;
         InstanceBase* GetInstance();
 
+        // Valid to call if the type is Headless
+        uint32_t GetHeadlessBufferCount() const;
+
         // Valid to call if the type is MetalLayer
         void* GetMetalLayer() const;
 
@@ -63,6 +68,9 @@ namespace dawn_native {
         // The swapchain will set this to null when it is destroyed.
         NewSwapChainBase* mSwapChain = nullptr;
 
+        // Headless
+        uint32_t mHeadlessBufferCount = 0;
+
         // MetalLayer
         void* mMetalLayer = nullptr;
 
@@ -25,6 +25,11 @@ namespace dawn_native {
 
     namespace {
 
+        // How long a headless swapchain acquire blocks on the device's completion primitive
+        // per attempt before re-checking serials; bounded so a lost device can't hang the
+        // pacing loop forever.
+        constexpr uint64_t kHeadlessAcquireWaitNs = 2000000;
+
         class ErrorSwapChain final : public SwapChainBase {
           public:
             ErrorSwapChain(DeviceBase* device) : SwapChainBase(device, ObjectBase::kError) {
@@ -81,7 +86,15 @@ namespace dawn_native {
                 return DAWN_VALIDATION_ERROR("Format must (currently) be BGRA8Unorm");
             }
 
-            if (descriptor->usage != wgpu::TextureUsage::OutputAttachment) {
+            if (surface->GetType() == Surface::Type::Headless) {
+                // Headless swapchains render offscreen, typically to be read back, so any
+                // valid usage is allowed as long as the texture stays renderable.
+                DAWN_TRY(ValidateTextureUsage(descriptor->usage));
+                if ((descriptor->usage & wgpu::TextureUsage::OutputAttachment) == 0) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Headless swapchain usage must include OutputAttachment");
+                }
+            } else if (descriptor->usage != wgpu::TextureUsage::OutputAttachment) {
                 return DAWN_VALIDATION_ERROR("Usage must (currently) be OutputAttachment");
             }
 
@@ -159,6 +172,11 @@ namespace dawn_native {
         mHeight = height;
         mImplementation.Configure(mImplementation.userData, static_cast<WGPUTextureFormat>(format),
                                   static_cast<WGPUTextureUsage>(allowedUsage), width, height);
+
+        // The implementation now owns a new set of native images; the cached views (and any
+        // wrapper textures the backend recycles) belong to the previous ones.
+        mCachedTextureViews.clear();
+        OnConfigure();
     }
 
     TextureViewBase* OldSwapChainBase::GetCurrentTextureView() {
@@ -191,10 +209,27 @@ namespace dawn_native {
         // of dawn_native
         mCurrentTexture = AcquireRef(GetNextTextureImpl(&descriptor));
 
+        // Backends recycle the wrapper texture of each native image; when one comes back,
+        // reuse its view too so a steady-state acquire allocates nothing.
+        for (auto& entry : mCachedTextureViews) {
+            if (entry.first == mCurrentTexture.Get()) {
+                mCurrentTextureView = entry.second;
+                mCurrentTextureView->Reference();
+                return mCurrentTextureView.Get();
+            }
+        }
+
+        if (mCachedTextureViews.size() >= kMaxCachedTextureViews) {
+            mCachedTextureViews.clear();
+        }
         mCurrentTextureView = mCurrentTexture->CreateView(nullptr);
+        mCachedTextureViews.emplace_back(mCurrentTexture.Get(), mCurrentTextureView);
         return mCurrentTextureView.Get();
     }
 
+    void OldSwapChainBase::OnConfigure() {
+    }
+
     void OldSwapChainBase::Present() {
         if (GetDevice()->ConsumedError(ValidatePresent())) {
             return;
@@ -402,4 +437,63 @@ namespace dawn_native {
         return {};
     }
 
+    // HeadlessSwapChain
+
+    HeadlessSwapChain::HeadlessSwapChain(DeviceBase* device,
+                                         Surface* surface,
+                                         NewSwapChainBase* previousSwapChain,
+                                         const SwapChainDescriptor* descriptor)
+        : NewSwapChainBase(device, surface, descriptor),
+          mBufferLastUsageSerials(surface->GetHeadlessBufferCount(), Serial(0)) {
+        if (previousSwapChain != nullptr) {
+            // Headless swapchains own no native resources, so there is nothing to hand over
+            // from the previous swapchain regardless of which backend it came from.
+            previousSwapChain->DetachFromSurface();
+        }
+    }
+
+    HeadlessSwapChain::~HeadlessSwapChain() {
+        DetachFromSurface();
+    }
+
+    ResultOrError<TextureViewBase*> HeadlessSwapChain::GetCurrentTextureViewImpl() {
+        DeviceBase* device = GetDevice();
+
+        // Pace the CPU like a real N-buffered swapchain would: the slot being acquired was
+        // presented N frames ago, so block until the GPU finished that frame's work.
+        Serial lastUsage = mBufferLastUsageSerials[mPresentCount % mBufferLastUsageSerials.size()];
+        while (device->GetCompletedCommandSerial() < lastUsage) {
+            DAWN_TRY(device->ValidateIsAlive());
+            device->WaitForCompletedWork(kHeadlessAcquireWaitNs);
+            device->Tick();
+        }
+
+        TextureDescriptor textureDesc = GetSwapChainBaseTextureDescriptor(this);
+        mTexture = AcquireRef(device->CreateTexture(&textureDesc));
+        if (mTexture->IsError()) {
+            mTexture = nullptr;
+            return DAWN_VALIDATION_ERROR("Couldn't create the headless swapchain texture");
+        }
+        return mTexture->CreateView(nullptr);
+    }
+
+    MaybeError HeadlessSwapChain::PresentImpl() {
+        // All rendering to the texture has been submitted by now; remember the serial so that
+        // re-acquiring this buffer slot can wait for it.
+        mBufferLastUsageSerials[mPresentCount % mBufferLastUsageSerials.size()] =
+            GetDevice()->GetLastSubmittedCommandSerial();
+        mPresentCount++;
+
+        mTexture->Destroy();
+        mTexture = nullptr;
+        return {};
+    }
+
+    void HeadlessSwapChain::DetachFromSurfaceImpl() {
+        if (mTexture.Get() != nullptr) {
+            mTexture->Destroy();
+            mTexture = nullptr;
+        }
+    }
+
 }  // namespace dawn_native
@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_SWAPCHAIN_H_
 #define DAWNNATIVE_SWAPCHAIN_H_
 
+#include "common/Serial.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
 #include "dawn_native/ObjectBase.h"
@@ -22,6 +23,9 @@
 #include "dawn/dawn_wsi.h"
 #include "dawn_native/dawn_platform.h"
 
+#include <utility>
+#include <vector>
+
 namespace dawn_native {
 
     MaybeError ValidateSwapChainDescriptor(const DeviceBase* device,
@@ -69,6 +73,9 @@ namespace dawn_native {
         const DawnSwapChainImplementation& GetImplementation();
         virtual TextureBase* GetNextTextureImpl(const TextureDescriptor*) = 0;
         virtual MaybeError OnBeforePresent(TextureBase* texture) = 0;
+        // Called after the implementation was (re)configured so backends can drop state
+        // tied to the previous set of native images.
+        virtual void OnConfigure();
 
       private:
         MaybeError ValidateConfigure(wgpu::TextureFormat format,
@@ -85,6 +92,13 @@ namespace dawn_native {
         uint32_t mHeight = 0;
         Ref<TextureBase> mCurrentTexture;
         Ref<TextureViewBase> mCurrentTextureView;
+
+        // Views for the wrapper textures that backends recycle between acquires, keyed by
+        // the texture, so re-acquiring an image doesn't recreate its view either. Bounded
+        // because a backend creating a fresh wrapper per acquire would otherwise grow it a
+        // frame at a time.
+        static constexpr size_t kMaxCachedTextureViews = 8;
+        std::vector<std::pair<TextureBase*, Ref<TextureViewBase>>> mCachedTextureViews;
     };
 
     // The base class for surface-based SwapChains that aren't ready yet.
@@ -159,6 +173,33 @@ namespace dawn_native {
         virtual void DetachFromSurfaceImpl() = 0;
     };
 
+    // The swapchain used for Surface::Type::Headless surfaces. It lives entirely in the
+    // frontend so every backend supports headless surfaces for free: acquiring hands out a
+    // freshly created texture and presenting just retires it. Pacing however matches a real
+    // N-buffered swapchain: each buffer slot remembers the last submitted command serial
+    // when it was presented, and acquiring the slot again blocks until that serial completed
+    // on the GPU. This keeps an offscreen render loop at most N frames ahead without the
+    // fences applications hand-roll around texture + readback pseudo-swapchains.
+    class HeadlessSwapChain final : public NewSwapChainBase {
+      public:
+        HeadlessSwapChain(DeviceBase* device,
+                          Surface* surface,
+                          NewSwapChainBase* previousSwapChain,
+                          const SwapChainDescriptor* descriptor);
+
+      private:
+        ~HeadlessSwapChain() override;
+
+        ResultOrError<TextureViewBase*> GetCurrentTextureViewImpl() override;
+        MaybeError PresentImpl() override;
+        void DetachFromSurfaceImpl() override;
+
+        Ref<TextureBase> mTexture;
+        // One entry per buffer slot, indexed by the present count modulo the buffer count.
+        std::vector<Serial> mBufferLastUsageSerials;
+        uint64_t mPresentCount = 0;
+    };
+
 }  // namespace dawn_native
 
 #endif  // DAWNNATIVE_SWAPCHAIN_H_
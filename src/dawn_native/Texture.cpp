@@ -195,9 +195,35 @@ namespace dawn_native {
                 return DAWN_VALIDATION_ERROR("Format cannot be used in storage textures");
             }
 
+            // A transient attachment's contents never outlive the render pass that produced
+            // them, so the backing memory may never be materialized: it cannot be copied,
+            // sampled, or used as storage.
+            if (descriptor->usage & wgpu::TextureUsage::Transient) {
+                constexpr wgpu::TextureUsage kValidTransientUsages =
+                    wgpu::TextureUsage::Transient | wgpu::TextureUsage::OutputAttachment;
+                if (!(descriptor->usage & wgpu::TextureUsage::OutputAttachment)) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Transient usage requires the OutputAttachment usage");
+                }
+                if (descriptor->usage & (~kValidTransientUsages)) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Transient usage is only compatible with the OutputAttachment usage");
+                }
+            }
+
             return {};
         }
 
+        // Compares the descriptor fields that select the backing view, ignoring the label
+        // and the extension chain.
+        bool ViewDescriptorsSelectSameView(const TextureViewDescriptor& a,
+                                           const TextureViewDescriptor& b) {
+            return a.format == b.format && a.dimension == b.dimension &&
+                   a.baseMipLevel == b.baseMipLevel && a.mipLevelCount == b.mipLevelCount &&
+                   a.baseArrayLayer == b.baseArrayLayer && a.arrayLayerCount == b.arrayLayerCount &&
+                   a.aspect == b.aspect;
+        }
+
     }  // anonymous namespace
 
     MaybeError ValidateTextureDescriptor(const DeviceBase* device,
@@ -229,6 +255,14 @@ namespace dawn_native {
 
         DAWN_TRY(ValidateTextureSize(descriptor, format));
 
+        // Transient attachments may live in memory that is never materialized, which cannot
+        // be shared with other textures.
+        if (descriptor->aliasGroup != 0 && (descriptor->usage & wgpu::TextureUsage::Transient)) {
+            return DAWN_VALIDATION_ERROR("Transient textures cannot be in an alias group");
+        }
+
+        DAWN_TRY(ValidateMemoryAllocationHint(descriptor->allocationHint));
+
         return {};
     }
 
@@ -350,6 +384,8 @@ namespace dawn_native {
           mMipLevelCount(descriptor->mipLevelCount),
           mSampleCount(descriptor->sampleCount),
           mUsage(descriptor->usage),
+          mAliasGroup(descriptor->aliasGroup),
+          mAllocationHint(descriptor->allocationHint),
           mState(state) {
         uint32_t subresourceCount = GetSubresourceCount();
         mIsSubresourceContentInitializedAtIndex = std::vector<bool>(subresourceCount, false);
@@ -386,6 +422,18 @@ namespace dawn_native {
         ASSERT(!IsError());
         return mSize;
     }
+    uint32_t TextureBase::GetWidth() const {
+        ASSERT(!IsError());
+        return mSize.width;
+    }
+    uint32_t TextureBase::GetHeight() const {
+        ASSERT(!IsError());
+        return mSize.height;
+    }
+    uint32_t TextureBase::GetDepth() const {
+        ASSERT(!IsError());
+        return mSize.depth;
+    }
     uint32_t TextureBase::GetArrayLayers() const {
         ASSERT(!IsError());
         return mArrayLayerCount;
@@ -406,6 +454,14 @@ namespace dawn_native {
         ASSERT(!IsError());
         return mUsage;
     }
+    uint32_t TextureBase::GetAliasGroup() const {
+        ASSERT(!IsError());
+        return mAliasGroup;
+    }
+    wgpu::MemoryAllocationHint TextureBase::GetAllocationHint() const {
+        ASSERT(!IsError());
+        return mAllocationHint;
+    }
 
     TextureBase::TextureState TextureBase::GetTextureState() const {
         ASSERT(!IsError());
@@ -498,6 +554,43 @@ namespace dawn_native {
         return GetDevice()->CreateTextureView(this, descriptor);
     }
 
+    TextureViewBase* TextureBase::GetCachedView(const TextureViewDescriptor* descriptor) {
+        ASSERT(!IsError());
+        if (descriptor->nextInChain != nullptr) {
+            return nullptr;
+        }
+        for (const ViewCacheEntry& entry : mViewCache) {
+            if (ViewDescriptorsSelectSameView(entry.descriptor, *descriptor)) {
+                return entry.view;
+            }
+        }
+        return nullptr;
+    }
+
+    void TextureBase::CacheView(TextureViewBase* view, const TextureViewDescriptor* descriptor) {
+        ASSERT(!IsError());
+        if (descriptor->nextInChain != nullptr) {
+            return;
+        }
+        ViewCacheEntry entry;
+        entry.descriptor = *descriptor;
+        // The label doesn't select a different view and may dangle once the caller's
+        // descriptor goes away.
+        entry.descriptor.label = nullptr;
+        entry.view = view;
+        mViewCache.push_back(entry);
+    }
+
+    void TextureBase::UncacheView(const TextureViewBase* view) {
+        for (size_t i = 0; i < mViewCache.size(); ++i) {
+            if (mViewCache[i].view == view) {
+                mViewCache[i] = mViewCache.back();
+                mViewCache.pop_back();
+                return;
+            }
+        }
+    }
+
     void TextureBase::Destroy() {
         if (GetDevice()->ConsumedError(ValidateDestroy())) {
             return;
@@ -532,6 +625,12 @@ namespace dawn_native {
           mArrayLayerCount(descriptor->arrayLayerCount) {
     }
 
+    TextureViewBase::~TextureViewBase() {
+        if (mTexture != nullptr) {
+            mTexture->UncacheView(this);
+        }
+    }
+
     TextureViewBase::TextureViewBase(DeviceBase* device, ObjectBase::ErrorTag tag)
         : ObjectBase(device, tag), mFormat(kUnusedFormat) {
     }
@@ -52,11 +52,21 @@ namespace dawn_native {
         wgpu::TextureDimension GetDimension() const;
         const Format& GetFormat() const;
         const Extent3D& GetSize() const;
+        // Per-dimension accessors backing the texture getter methods of the API.
+        uint32_t GetWidth() const;
+        uint32_t GetHeight() const;
+        uint32_t GetDepth() const;
         uint32_t GetArrayLayers() const;
         uint32_t GetNumMipLevels() const;
         uint32_t GetSampleCount() const;
         uint32_t GetSubresourceCount() const;
         wgpu::TextureUsage GetUsage() const;
+        // Textures in the same nonzero alias group may share backing memory. The application
+        // guarantees their lifetimes are disjoint; using one invalidates the contents of the
+        // others.
+        uint32_t GetAliasGroup() const;
+        // Placement preferences for the backing memory; backends treat these as advisory.
+        wgpu::MemoryAllocationHint GetAllocationHint() const;
         TextureState GetTextureState() const;
         uint32_t GetSubresourceIndex(uint32_t mipLevel, uint32_t arraySlice) const;
         bool IsSubresourceContentInitialized(uint32_t baseMipLevel,
@@ -85,6 +95,14 @@ namespace dawn_native {
         TextureViewBase* CreateView(const TextureViewDescriptor* descriptor);
         void Destroy();
 
+        // Small dedup cache so repeated CreateView calls with an identical descriptor return
+        // the same view instead of multiplying backend view objects. Entries don't hold a
+        // reference (views already reference their texture, a strong entry would cycle):
+        // views uncache themselves on destruction.
+        TextureViewBase* GetCachedView(const TextureViewDescriptor* descriptor);
+        void CacheView(TextureViewBase* view, const TextureViewDescriptor* descriptor);
+        void UncacheView(const TextureViewBase* view);
+
       protected:
         void DestroyInternal();
 
@@ -101,15 +119,24 @@ namespace dawn_native {
         uint32_t mMipLevelCount;
         uint32_t mSampleCount;
         wgpu::TextureUsage mUsage = wgpu::TextureUsage::None;
+        uint32_t mAliasGroup = 0;
+        wgpu::MemoryAllocationHint mAllocationHint = wgpu::MemoryAllocationHint::None;
         TextureState mState;
 
         // TODO(natlee@microsoft.com): Use a more optimized data structure to save space
         std::vector<bool> mIsSubresourceContentInitializedAtIndex;
+
+        struct ViewCacheEntry {
+            TextureViewDescriptor descriptor;
+            TextureViewBase* view;
+        };
+        std::vector<ViewCacheEntry> mViewCache;
     };
 
     class TextureViewBase : public ObjectBase {
       public:
         TextureViewBase(TextureBase* texture, const TextureViewDescriptor* descriptor);
+        ~TextureViewBase() override;
 
         static TextureViewBase* MakeError(DeviceBase* device);
 
@@ -92,7 +92,10 @@ namespace dawn_native {
               "allocation failures when application memory exceeds physical device memory.",
               "https://crbug.com/dawn/193"}},
             {Toggle::SkipValidation,
-             {"skip_validation", "Skip expensive validation of Dawn commands.",
+             {"skip_validation",
+              "Skip expensive validation of Dawn commands. Meant for trusted content that was "
+              "already validated (e.g. in CI); per-command checks are reduced to debug-only "
+              "asserts and invalid input becomes undefined behavior.",
               "https://crbug.com/dawn/271"}},
             {Toggle::UseSpvc,
              {"use_spvc",
@@ -132,6 +135,90 @@ namespace dawn_native {
             {Toggle::UseDXC,
              {"use_dxc", "Use DXC instead of FXC for compiling HLSL",
               "https://crbug.com/dawn/402"}},
+            {Toggle::DeferSubmits,
+             {"defer_submits",
+              "Accumulate the command buffers from multiple queue submits and issue them in a "
+              "single driver submission on the next device Tick, instead of one driver submission "
+              "per submit call. This reduces per-submit driver overhead for applications that "
+              "submit many small command buffers per frame. Work is still flushed whenever a "
+              "dependency requires it, for example before transfer queue copies or presents.",
+              "https://crbug.com/dawn/443"}},
+            {Toggle::DeferObjectDestruction,
+             {"defer_object_destruction",
+              "Enqueue objects whose last reference is dropped onto a per-device reclamation "
+              "list drained on Device::Tick, instead of running backend destructors inline on "
+              "the releasing thread. This keeps destruction cost of large object graphs off "
+              "latency-critical threads and batches the backend deletions.",
+              "https://crbug.com/dawn/445"}},
+            {Toggle::NullBackendThroughputMode,
+             {"null_backend_throughput_mode",
+              "Make the null backend walk every command of the submitted command buffers at "
+              "submit time and report the number of commands consumed, so pure frontend CPU "
+              "overhead can be benchmarked deterministically without a GPU. Nothing is paced: "
+              "commands complete in the same submit that consumes them. Combine with "
+              "skip_validation to measure encoding-only cost.",
+              "https://crbug.com/dawn/447"}},
+            {Toggle::MetalUseArgumentBuffers,
+             {"metal_use_argument_buffers",
+              "Pre-encode eligible bind groups into Metal argument buffers at creation so "
+              "applying them is a single setBuffer call per stage instead of one call per "
+              "resource. Enabled by default on devices with Tier2 argument buffer support. "
+              "Bind groups with dynamic offsets, storage buffers or descriptor arrays keep "
+              "the per-resource path.",
+              "https://crbug.com/dawn/448"}},
+            {Toggle::BatchSwapchainPresents,
+             {"batch_swapchain_presents",
+              "Defer native swapchain presents on Vulkan instead of issuing one "
+              "vkQueuePresentKHR per swapchain. Deferred presents accumulate on the device "
+              "and are flushed as a single vkQueuePresentKHR with multiple swapchains at the "
+              "next queue submission, or explicitly with "
+              "dawn_native::vulkan::FlushPendingPresents. Saves per-present driver overhead "
+              "when one device presents to many displays.",
+              "https://crbug.com/dawn/449"}},
+            {Toggle::SkipSpirvValidation,
+             {"skip_spirv_validation",
+              "Skip the spirv-val run on SPIR-V shader module creation. For applications "
+              "whose shipped shaders were already validated offline, spirv-val dominates "
+              "module creation time. Descriptor and reflection validation still run; only "
+              "enable this for trusted shader sources. Unlike skip_validation this leaves "
+              "all other validation intact.",
+              "https://crbug.com/dawn/450"}},
+            {Toggle::ReorderRenderPassDraws,
+             {"reorder_render_pass_draws",
+              "Stably sort the self-contained draw sequences of each render pass by "
+              "(pipeline, first bind group) when the command buffer is finished, so backends "
+              "bind each pipeline once per pass instead of once per application-ordered "
+              "sequence. Only sequences that set all the state their draws use are moved, "
+              "and a pass recording dynamic state, immediate data, bundles, queries or "
+              "debug markers after its first pipeline is left in application order. "
+              "Reordering changes which draw lands last on overlapping pixels, so only "
+              "enable this when draw order within a pass doesn't affect the output (for "
+              "example opaque depth-tested geometry).",
+              "https://crbug.com/dawn/451"}},
+            {Toggle::UseLargePageCommandBlocks,
+             {"use_large_page_command_blocks",
+              "Let command blocks grow to 2MB and ask the kernel to back them with large "
+              "pages, instead of capping blocks at the pooled size. Long command tapes then "
+              "span a handful of large pages instead of hundreds of small ones, reducing TLB "
+              "misses during encoding and replay. Blocks above the pooled size are not "
+              "recycled through the block pool, so this trades pooling for TLB relief.",
+              "https://crbug.com/dawn/452"}},
+            {Toggle::TraceGPUSubmitTimings,
+             {"trace_gpu_submit_timings",
+              "Write begin/end GPU timestamps around every Vulkan queue submission and "
+              "resolve them asynchronously once the submission completed. The measured GPU "
+              "duration is reported through the platform trace sink as an instant GPUWork "
+              "event carrying the submit's serial, the same id the DeviceBase::GPUWork "
+              "async events use, so profiling tools can attribute GPU milliseconds to "
+              "specific submits without manual query plumbing.",
+              "https://crbug.com/dawn/453"}},
+            {Toggle::DisableRenderPassMerging,
+             {"disable_render_pass_merging",
+              "Keep back-to-back render passes that target the same attachments as separate "
+              "passes instead of merging them into one when the command buffer is finished. "
+              "The merge preserves rendering output, so this is an escape hatch for "
+              "debugging and for working around driver issues with long passes.",
+              "https://crbug.com/dawn/454"}},
         }};
 
     }  // anonymous namespace
@@ -42,6 +42,16 @@ namespace dawn_native {
         DisableBaseInstance,
         UseD3D12SmallShaderVisibleHeapForTesting,
         UseDXC,
+        DeferSubmits,
+        DeferObjectDestruction,
+        NullBackendThroughputMode,
+        MetalUseArgumentBuffers,
+        BatchSwapchainPresents,
+        SkipSpirvValidation,
+        ReorderRenderPassDraws,
+        UseLargePageCommandBlocks,
+        TraceGPUSubmitTimings,
+        DisableRenderPassMerging,
 
         EnumCount,
         InvalidEnum = EnumCount,
@@ -93,8 +93,10 @@ namespace dawn_native { namespace d3d12 {
     void Adapter::InitializeSupportedExtensions() {
         mSupportedExtensions.EnableExtension(Extension::TextureCompressionBC);
         mSupportedExtensions.EnableExtension(Extension::RayTracing);
+        mSupportedExtensions.EnableExtension(Extension::RayQuery);
         mSupportedExtensions.EnableExtension(Extension::PipelineStatisticsQuery);
         mSupportedExtensions.EnableExtension(Extension::TimestampQuery);
+        mSupportedExtensions.EnableExtension(Extension::ImmediateData);
     }
 
     ResultOrError<DeviceBase*> Adapter::CreateDeviceImpl(const DeviceDescriptor* descriptor) {
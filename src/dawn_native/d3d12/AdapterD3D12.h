@@ -24,7 +24,7 @@ namespace dawn_native { namespace d3d12 {
 
     class Backend;
 
-    class Adapter : public AdapterBase {
+    class Adapter final : public AdapterBase {
       public:
         Adapter(Backend* backend, ComPtr<IDXGIAdapter3> hardwareAdapter);
         ~Adapter() override = default;
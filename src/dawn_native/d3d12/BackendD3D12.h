@@ -23,7 +23,7 @@ namespace dawn_native { namespace d3d12 {
 
     class PlatformFunctions;
 
-    class Backend : public BackendConnection {
+    class Backend final : public BackendConnection {
       public:
         Backend(InstanceBase* instance);
 
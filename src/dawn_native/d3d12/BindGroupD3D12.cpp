@@ -52,6 +52,13 @@ namespace dawn_native { namespace d3d12 {
              bindingIndex < bgl->GetBindingCount(); ++bindingIndex) {
             const BindingInfo& bindingInfo = bgl->GetBindingInfo(bindingIndex);
 
+            // Binding arrays use update-after-bind semantics: the bind group has no
+            // resources for them, their descriptors are written later into the range
+            // reserved by the layout.
+            if (bindingInfo.bindingArraySize > 1) {
+                continue;
+            }
+
             // Increment size does not need to be stored and is only used to get a handle
             // local to the allocation with OffsetFrom().
             switch (bindingInfo.type) {
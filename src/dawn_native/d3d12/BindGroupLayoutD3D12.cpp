@@ -60,7 +60,10 @@ namespace dawn_native { namespace d3d12 {
             ASSERT(!bindingInfo.hasDynamicOffset);
 
             DescriptorType descriptorType = WGPUBindingTypeToDescriptorType(bindingInfo.type);
-            mBindingOffsets[bindingIndex] = mDescriptorCounts[descriptorType]++;
+            mBindingOffsets[bindingIndex] = mDescriptorCounts[descriptorType];
+            // Binding arrays occupy bindingArraySize contiguous descriptors starting at the
+            // binding's offset.
+            mDescriptorCounts[descriptorType] += bindingInfo.bindingArraySize;
         }
 
         auto SetDescriptorRange = [&](uint32_t index, uint32_t count, uint32_t* baseRegister,
@@ -61,6 +61,9 @@ namespace dawn_native { namespace d3d12 {
             if (usage & wgpu::BufferUsage::Indirect) {
                 resourceState |= D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT;
             }
+            if (usage & wgpu::BufferUsage::QueryResolve) {
+                resourceState |= D3D12_RESOURCE_STATE_COPY_DEST;
+            }
 
             return resourceState;
         }
@@ -117,9 +120,10 @@ namespace dawn_native { namespace d3d12 {
             mLastUsage = wgpu::BufferUsage::CopySrc;
         }
 
-        DAWN_TRY_ASSIGN(
-            mResourceAllocation,
-            ToBackend(GetDevice())->AllocateMemory(heapType, resourceDescriptor, bufferUsage));
+        DAWN_TRY_ASSIGN(mResourceAllocation,
+                        ToBackend(GetDevice())
+                            ->AllocateMemory(heapType, resourceDescriptor, bufferUsage,
+                                             AllocationClass::Buffer));
         return {};
     }
 
@@ -145,6 +149,31 @@ namespace dawn_native { namespace d3d12 {
         return TransitionUsageAndGetResourceBarrier(commandContext, barrier, newUsage);
     }
 
+    // When true is returned, the BEGIN half of a split barrier has been created and must be used
+    // in a ResourceBarrier call. The END half is recorded by the next transition of the buffer,
+    // which completes the transition that was begun here.
+    bool Buffer::TrackUsageAndGetSplitBarrierBegin(CommandRecordingContext* commandContext,
+                                                   D3D12_RESOURCE_BARRIER* barrier,
+                                                   wgpu::BufferUsage newUsage) {
+        ASSERT(!mSplitBarrierPending);
+
+        if (!TrackUsageAndGetResourceBarrier(commandContext, barrier, newUsage)) {
+            return false;
+        }
+
+        // UAV barriers are a full synchronization point and cannot be split. Recording the
+        // barrier at the earlier location is still correct.
+        if (barrier->Type != D3D12_RESOURCE_BARRIER_TYPE_TRANSITION) {
+            return true;
+        }
+
+        barrier->Flags = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY;
+        mPendingSplitBarrier = *barrier;
+        mPendingSplitBarrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
+        mSplitBarrierPending = true;
+        return true;
+    }
+
     void Buffer::TrackUsageAndTransitionNow(CommandRecordingContext* commandContext,
                                             wgpu::BufferUsage newUsage) {
         D3D12_RESOURCE_BARRIER barrier;
@@ -160,6 +189,19 @@ namespace dawn_native { namespace d3d12 {
     bool Buffer::TransitionUsageAndGetResourceBarrier(CommandRecordingContext* commandContext,
                                                       D3D12_RESOURCE_BARRIER* barrier,
                                                       wgpu::BufferUsage newUsage) {
+        // A previously begun split barrier must be finished before the buffer can be used or
+        // transitioned again.
+        if (mSplitBarrierPending) {
+            mSplitBarrierPending = false;
+            if (mPendingSplitBarrier.Transition.StateAfter == D3D12BufferUsage(newUsage)) {
+                *barrier = mPendingSplitBarrier;
+                return true;
+            }
+            // The predicted usage didn't materialize; complete the split transition in place
+            // and compute the real transition from the state it left the buffer in.
+            commandContext->GetCommandList()->ResourceBarrier(1, &mPendingSplitBarrier);
+        }
+
         // Resources in upload and readback heaps must be kept in the COPY_SOURCE/DEST state
         if (mFixedResourceState) {
             ASSERT(mLastUsage == newUsage);
@@ -283,6 +325,15 @@ namespace dawn_native { namespace d3d12 {
         return {};
     }
 
+    MaybeError Buffer::FreezeUsageImpl(wgpu::BufferUsage usage) {
+        // Transition to the frozen usage once; the frontend stops tracking the buffer per
+        // pass afterwards so no further barriers will be recorded for it.
+        CommandRecordingContext* commandContext;
+        DAWN_TRY_ASSIGN(commandContext, ToBackend(GetDevice())->GetPendingCommandContext());
+        TrackUsageAndTransitionNow(commandContext, usage);
+        return {};
+    }
+
     void Buffer::UnmapImpl() {
         GetD3D12Resource()->Unmap(0, &mWrittenMappedRange);
         // When buffers are mapped, they are locked to keep them in resident memory. We must unlock
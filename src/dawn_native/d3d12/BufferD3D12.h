@@ -38,6 +38,13 @@ namespace dawn_native { namespace d3d12 {
         bool TrackUsageAndGetResourceBarrier(CommandRecordingContext* commandContext,
                                              D3D12_RESOURCE_BARRIER* barrier,
                                              wgpu::BufferUsage newUsage);
+        // When the usage the buffer transitions to next is known ahead of time, the transition
+        // can be issued as a split barrier: the BEGIN half right after the producing pass and
+        // the END half at the consuming one, letting the driver overlap the transition with the
+        // work recorded in between.
+        bool TrackUsageAndGetSplitBarrierBegin(CommandRecordingContext* commandContext,
+                                               D3D12_RESOURCE_BARRIER* barrier,
+                                               wgpu::BufferUsage newUsage);
         void TrackUsageAndTransitionNow(CommandRecordingContext* commandContext,
                                         wgpu::BufferUsage newUsage);
 
@@ -49,6 +56,7 @@ namespace dawn_native { namespace d3d12 {
         // Dawn API
         MaybeError MapReadAsyncImpl(uint32_t serial) override;
         MaybeError MapWriteAsyncImpl(uint32_t serial) override;
+        MaybeError FreezeUsageImpl(wgpu::BufferUsage usage) override;
         void UnmapImpl() override;
         void DestroyImpl() override;
 
@@ -64,6 +72,10 @@ namespace dawn_native { namespace d3d12 {
         bool mFixedResourceState = false;
         wgpu::BufferUsage mLastUsage = wgpu::BufferUsage::None;
         Serial mLastUsedSerial = UINT64_MAX;
+        // The END half of a split barrier whose BEGIN half has already been recorded. It must
+        // be recorded before the buffer can be used or transitioned again.
+        D3D12_RESOURCE_BARRIER mPendingSplitBarrier;
+        bool mSplitBarrierPending = false;
         D3D12_RANGE mWrittenMappedRange;
         char* mMappedData = nullptr;
     };
@@ -18,54 +18,64 @@
 #include "dawn_native/d3d12/DeviceD3D12.h"
 
 #include "common/Assert.h"
-#include "common/BitSetIterator.h"
+#include "common/Counters.h"
 
 namespace dawn_native { namespace d3d12 {
 
-    CommandAllocatorManager::CommandAllocatorManager(Device* device)
-        : device(device), mAllocatorCount(0) {
-        mFreeAllocators.set();
+    CommandAllocatorManager::CommandAllocatorManager(Device* device) : device(device) {
     }
 
     ResultOrError<ID3D12CommandAllocator*> CommandAllocatorManager::ReserveCommandAllocator() {
-        // If there are no free allocators, get the oldest serial in flight and wait on it
-        if (mFreeAllocators.none()) {
-            const uint64_t firstSerial = mInFlightCommandAllocators.FirstSerial();
-            DAWN_TRY(device->WaitForSerial(firstSerial));
-            DAWN_TRY(Tick(firstSerial));
-        }
-
-        ASSERT(mFreeAllocators.any());
-
-        // Get the index of the first free allocator from the bitset
-        unsigned int firstFreeIndex = *(IterateBitSet(mFreeAllocators).begin());
-
-        if (firstFreeIndex >= mAllocatorCount) {
-            ASSERT(firstFreeIndex == mAllocatorCount);
-            mAllocatorCount++;
+        ComPtr<ID3D12CommandAllocator> commandAllocator;
+        if (mFreeAllocators.empty()) {
+            // Grow the pool instead of waiting on a fence for an in-flight allocator to be
+            // recycled; submit-heavy frames would otherwise serialize on the wait.
             DAWN_TRY(CheckHRESULT(device->GetD3D12Device()->CreateCommandAllocator(
                                       D3D12_COMMAND_LIST_TYPE_DIRECT,
-                                      IID_PPV_ARGS(&mCommandAllocators[firstFreeIndex])),
+                                      IID_PPV_ARGS(&commandAllocator)),
                                   "D3D12 create command allocator"));
+            mAllocatorCount++;
+            DAWN_COUNTER_INCREMENT(device->GetCounters(), CommandAllocatorsCreated);
+        } else {
+            // Take the most recently recycled allocator so idle ones sink to the front of
+            // the free list where Tick trims them.
+            commandAllocator = std::move(mFreeAllocators.back().commandAllocator);
+            mFreeAllocators.pop_back();
         }
 
-        // Mark the command allocator as used
-        mFreeAllocators.reset(firstFreeIndex);
-
         // Enqueue the command allocator. It will be scheduled for reset after the next
         // ExecuteCommandLists
-        mInFlightCommandAllocators.Enqueue({mCommandAllocators[firstFreeIndex], firstFreeIndex},
+        ID3D12CommandAllocator* result = commandAllocator.Get();
+        mInFlightCommandAllocators.Enqueue(std::move(commandAllocator),
                                            device->GetPendingCommandSerial());
-        return mCommandAllocators[firstFreeIndex].Get();
+        return result;
     }
 
     MaybeError CommandAllocatorManager::Tick(uint64_t lastCompletedSerial) {
-        // Reset all command allocators that are no longer in flight
-        for (auto it : mInFlightCommandAllocators.IterateUpTo(lastCompletedSerial)) {
-            DAWN_TRY(CheckHRESULT(it.commandAllocator->Reset(), "D3D12 reset command allocator"));
-            mFreeAllocators.set(it.index);
+        // Reset all command allocators that are no longer in flight and return them to the
+        // free list.
+        for (ComPtr<ID3D12CommandAllocator>& commandAllocator :
+             mInFlightCommandAllocators.IterateUpTo(lastCompletedSerial)) {
+            DAWN_TRY(CheckHRESULT(commandAllocator->Reset(), "D3D12 reset command allocator"));
+            mFreeAllocators.push_back({std::move(commandAllocator), lastCompletedSerial});
         }
         mInFlightCommandAllocators.ClearUpTo(lastCompletedSerial);
+
+        // Reset keeps an allocator's backing memory, so release allocators that stayed free
+        // for long enough. Entries are ordered by recycle serial so the idle ones are at the
+        // front.
+        size_t trimCount = 0;
+        while (trimCount < mFreeAllocators.size() &&
+               mAllocatorCount - trimCount > kMinCommandAllocators &&
+               mFreeAllocators[trimCount].lastUsedSerial + kAllocatorIdleSerialsBeforeTrim <=
+                   lastCompletedSerial) {
+            trimCount++;
+        }
+        if (trimCount > 0) {
+            mFreeAllocators.erase(mFreeAllocators.begin(), mFreeAllocators.begin() + trimCount);
+            mAllocatorCount -= trimCount;
+            DAWN_COUNTER_ADD(device->GetCounters(), CommandAllocatorsTrimmed, trimCount);
+        }
         return {};
     }
 
@@ -20,7 +20,7 @@
 #include "common/SerialQueue.h"
 #include "dawn_native/Error.h"
 
-#include <bitset>
+#include <vector>
 
 namespace dawn_native { namespace d3d12 {
 
@@ -38,18 +38,25 @@ namespace dawn_native { namespace d3d12 {
       private:
         Device* device;
 
-        // This must be at least 2 because the Device and Queue use separate command allocators
-        static constexpr unsigned int kMaxCommandAllocators = 32;
-        unsigned int mAllocatorCount;
+        // The pool never shrinks below this because the Device and Queue use separate
+        // command allocators.
+        static constexpr size_t kMinCommandAllocators = 2;
+        // ID3D12CommandAllocator::Reset keeps the allocator's memory for reuse, so a free
+        // allocator that stayed unused for this many completed serials is released instead
+        // to return its memory to the OS.
+        static constexpr uint64_t kAllocatorIdleSerialsBeforeTrim = 64;
 
-        struct IndexedCommandAllocator {
+        struct FreeCommandAllocator {
             ComPtr<ID3D12CommandAllocator> commandAllocator;
-            unsigned int index;
+            // The completed serial at which the allocator was returned to the pool.
+            uint64_t lastUsedSerial;
         };
 
-        ComPtr<ID3D12CommandAllocator> mCommandAllocators[kMaxCommandAllocators];
-        std::bitset<kMaxCommandAllocators> mFreeAllocators;
-        SerialQueue<IndexedCommandAllocator> mInFlightCommandAllocators;
+        size_t mAllocatorCount = 0;
+        // Used as a LIFO so burst frames reuse warm allocators and idle ones age out at
+        // the front.
+        std::vector<FreeCommandAllocator> mFreeAllocators;
+        SerialQueue<ComPtr<ID3D12CommandAllocator>> mInFlightCommandAllocators;
     };
 
 }}  // namespace dawn_native::d3d12
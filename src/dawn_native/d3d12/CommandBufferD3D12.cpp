@@ -15,11 +15,14 @@
 #include "dawn_native/d3d12/CommandBufferD3D12.h"
 
 #include <deque>
+#include <map>
 
 #include "common/Assert.h"
+#include "common/StackContainer.h"
 #include "dawn_native/BindGroupAndStorageBarrierTracker.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/Commands.h"
+#include "dawn_native/RayTracingBundle.h"
 #include "dawn_native/RenderBundle.h"
 #include "dawn_native/d3d12/BindGroupD3D12.h"
 #include "dawn_native/d3d12/BindGroupLayoutD3D12.h"
@@ -28,6 +31,7 @@
 #include "dawn_native/d3d12/ComputePipelineD3D12.h"
 #include "dawn_native/d3d12/DeviceD3D12.h"
 #include "dawn_native/d3d12/PipelineLayoutD3D12.h"
+#include "dawn_native/d3d12/QuerySetD3D12.h"
 #include "dawn_native/d3d12/PlatformFunctions.h"
 #include "dawn_native/d3d12/RayTracingAccelerationContainerD3D12.h"
 #include "dawn_native/d3d12/RayTracingPipelineD3D12.h"
@@ -46,6 +50,23 @@ namespace dawn_native { namespace d3d12 {
 
     namespace {
 
+        uint64_t D3D12PipelineStatisticOffset(wgpu::PipelineStatisticName statistic) {
+            switch (statistic) {
+                case wgpu::PipelineStatisticName::VertexShaderInvocations:
+                    return offsetof(D3D12_QUERY_DATA_PIPELINE_STATISTICS, VSInvocations);
+                case wgpu::PipelineStatisticName::ClipperInvocations:
+                    return offsetof(D3D12_QUERY_DATA_PIPELINE_STATISTICS, CInvocations);
+                case wgpu::PipelineStatisticName::ClipperPrimitivesOut:
+                    return offsetof(D3D12_QUERY_DATA_PIPELINE_STATISTICS, CPrimitives);
+                case wgpu::PipelineStatisticName::FragmentShaderInvocations:
+                    return offsetof(D3D12_QUERY_DATA_PIPELINE_STATISTICS, PSInvocations);
+                case wgpu::PipelineStatisticName::ComputeShaderInvocations:
+                    return offsetof(D3D12_QUERY_DATA_PIPELINE_STATISTICS, CSInvocations);
+                default:
+                    UNREACHABLE();
+            }
+        }
+
         DXGI_FORMAT DXGIIndexFormat(wgpu::IndexFormat format) {
             switch (format) {
                 case wgpu::IndexFormat::Uint16:
@@ -393,6 +414,60 @@ namespace dawn_native { namespace d3d12 {
             std::array<D3D12_VERTEX_BUFFER_VIEW, kMaxVertexBuffers> mD3D12BufferViews = {};
         };
 
+        // Buffers SetImmediateData on the CPU and applies the dirty range as root constants
+        // right before the next draw/dispatch/trace. Setting a different root signature resets
+        // all root constant values, so a pipeline layout change re-dirties everything that was
+        // pushed so far.
+        class ImmediateDataTracker {
+          public:
+            void OnSetPipeline(PipelineLayout* pipelineLayout) {
+                if (mPipelineLayout != pipelineLayout) {
+                    mPipelineLayout = pipelineLayout;
+                    mDirtyBegin = mSetBegin;
+                    mDirtyEnd = mSetEnd;
+                }
+            }
+
+            void OnSetImmediateData(uint32_t offset, uint32_t size, const uint8_t* data) {
+                memcpy(&mData[offset], data, size);
+                mDirtyBegin = std::min(mDirtyBegin, offset);
+                mDirtyEnd = std::max(mDirtyEnd, offset + size);
+                mSetBegin = std::min(mSetBegin, offset);
+                mSetEnd = std::max(mSetEnd, offset + size);
+            }
+
+            void Apply(ID3D12GraphicsCommandList* commandList, bool isCompute) {
+                if (mDirtyBegin >= mDirtyEnd) {
+                    return;
+                }
+                ASSERT(mPipelineLayout != nullptr);
+
+                const uint32_t rootParameterIndex =
+                    mPipelineLayout->GetImmediateDataRootParameterIndex();
+                const uint32_t num32BitValues = (mDirtyEnd - mDirtyBegin) / 4;
+                if (isCompute) {
+                    commandList->SetComputeRoot32BitConstants(rootParameterIndex, num32BitValues,
+                                                              &mData[mDirtyBegin], mDirtyBegin / 4);
+                } else {
+                    commandList->SetGraphicsRoot32BitConstants(rootParameterIndex, num32BitValues,
+                                                               &mData[mDirtyBegin],
+                                                               mDirtyBegin / 4);
+                }
+
+                mDirtyBegin = kMaxImmediateDataBytes;
+                mDirtyEnd = 0;
+            }
+
+          private:
+            PipelineLayout* mPipelineLayout = nullptr;
+            // The dirty range waiting to be applied and the union of all ranges set so far.
+            uint32_t mDirtyBegin = kMaxImmediateDataBytes;
+            uint32_t mDirtyEnd = 0;
+            uint32_t mSetBegin = kMaxImmediateDataBytes;
+            uint32_t mSetEnd = 0;
+            std::array<uint8_t, kMaxImmediateDataBytes> mData = {};
+        };
+
         class IndexBufferTracker {
           public:
             void OnSetIndexBuffer(Buffer* buffer, uint64_t offset, uint64_t size) {
@@ -481,7 +556,9 @@ namespace dawn_native { namespace d3d12 {
         // Records the necessary barriers for the resource usage pre-computed by the frontend
         auto PrepareResourcesForSubmission = [](CommandRecordingContext* commandContext,
                                                 const PassResourceUsage& usages) -> bool {
-            std::vector<D3D12_RESOURCE_BARRIER> barriers;
+            // Give the per-pass batch inline storage to avoid a heap allocation for the common
+            // case of a pass that only transitions a few resources.
+            StackVector<D3D12_RESOURCE_BARRIER, 16> barriers;
 
             ID3D12GraphicsCommandList* commandList = commandContext->GetCommandList();
 
@@ -492,7 +569,7 @@ namespace dawn_native { namespace d3d12 {
                 if (ToBackend(usages.buffers[i])
                         ->TrackUsageAndGetResourceBarrier(commandContext, &barrier,
                                                           usages.bufferUsages[i])) {
-                    barriers.push_back(barrier);
+                    barriers->push_back(barrier);
                 }
                 bufferUsages |= usages.bufferUsages[i];
             }
@@ -516,13 +593,13 @@ namespace dawn_native { namespace d3d12 {
                 if (ToBackend(usages.textures[i])
                         ->TrackUsageAndGetResourceBarrier(commandContext, &barrier,
                                                           usages.textureUsages[i].usage)) {
-                    barriers.push_back(barrier);
+                    barriers->push_back(barrier);
                 }
                 textureUsages |= usages.textureUsages[i].usage;
             }
 
-            if (barriers.size()) {
-                commandList->ResourceBarrier(barriers.size(), barriers.data());
+            if (barriers->size()) {
+                commandList->ResourceBarrier(barriers->size(), barriers->data());
             }
 
             return (bufferUsages & wgpu::BufferUsage::Storage ||
@@ -532,6 +609,76 @@ namespace dawn_native { namespace d3d12 {
         const std::vector<PassResourceUsage>& passResourceUsages = GetResourceUsages().perPass;
         uint32_t nextPassNumber = 0;
 
+        // Gather, for every pass, the resources whose next use is in a later, non-adjacent pass.
+        // Their transitions can be begun as split barriers right after the producing pass and
+        // finished by the consuming one, letting the driver overlap the transition with the
+        // passes recorded in between.
+        struct SplitBarrierCandidates {
+            std::vector<std::pair<Buffer*, wgpu::BufferUsage>> buffers;
+            std::vector<std::pair<Texture*, wgpu::TextureUsage>> textures;
+        };
+        std::vector<SplitBarrierCandidates> splitBarrierCandidates(passResourceUsages.size());
+        {
+            std::map<BufferBase*, std::pair<size_t, wgpu::BufferUsage>> nextBufferUse;
+            std::map<TextureBase*, std::pair<size_t, wgpu::TextureUsage>> nextTextureUse;
+            for (size_t passIndex = passResourceUsages.size(); passIndex-- > 0;) {
+                const PassResourceUsage& usages = passResourceUsages[passIndex];
+                for (size_t i = 0; i < usages.buffers.size(); ++i) {
+                    auto it = nextBufferUse.find(usages.buffers[i]);
+                    if (it != nextBufferUse.end() && it->second.first > passIndex + 1) {
+                        splitBarrierCandidates[passIndex].buffers.emplace_back(
+                            ToBackend(usages.buffers[i]), it->second.second);
+                    }
+                    nextBufferUse[usages.buffers[i]] = {passIndex, usages.bufferUsages[i]};
+                }
+                for (size_t i = 0; i < usages.textures.size(); ++i) {
+                    auto it = nextTextureUse.find(usages.textures[i]);
+                    if (it != nextTextureUse.end() && it->second.first > passIndex + 1) {
+                        splitBarrierCandidates[passIndex].textures.emplace_back(
+                            ToBackend(usages.textures[i]), it->second.second);
+                    }
+                    nextTextureUse[usages.textures[i]] = {passIndex,
+                                                          usages.textureUsages[i].usage};
+                }
+            }
+        }
+
+        // Begins the transitions towards the next use of the resources produced by the pass that
+        // was just recorded. The END halves are recorded by PrepareResourcesForSubmission when
+        // the consuming pass transitions the resources.
+        auto BeginSplitBarriersForPass = [](CommandRecordingContext* commandContext,
+                                            const SplitBarrierCandidates& candidates) {
+            StackVector<D3D12_RESOURCE_BARRIER, 16> barriers;
+
+            for (const auto& bufferUse : candidates.buffers) {
+                D3D12_RESOURCE_BARRIER barrier;
+                if (bufferUse.first->TrackUsageAndGetSplitBarrierBegin(commandContext, &barrier,
+                                                                       bufferUse.second)) {
+                    barriers->push_back(barrier);
+                }
+            }
+            for (const auto& textureUse : candidates.textures) {
+                Texture* texture = textureUse.first;
+                // An uninitialized texture is lazily cleared when the consuming pass prepares
+                // it, which would immediately flush the split barrier again. Don't bother
+                // beginning the transition early.
+                if (!texture->IsSubresourceContentInitialized(0, texture->GetNumMipLevels(), 0,
+                                                              texture->GetArrayLayers())) {
+                    continue;
+                }
+                D3D12_RESOURCE_BARRIER barrier;
+                if (texture->TrackUsageAndGetSplitBarrierBegin(commandContext, &barrier,
+                                                               textureUse.second)) {
+                    barriers->push_back(barrier);
+                }
+            }
+
+            if (barriers->size()) {
+                commandContext->GetCommandList()->ResourceBarrier(barriers->size(),
+                                                                  barriers->data());
+            }
+        };
+
         RayTracingAccelerationContainer* lastBuildContainer = nullptr;
         RayTracingAccelerationContainer* lastUpdateContainer = nullptr;
 
@@ -546,6 +693,8 @@ namespace dawn_native { namespace d3d12 {
                     bindingTracker.SetInComputePass(true);
                     DAWN_TRY(RecordComputePass(commandContext, &bindingTracker));
 
+                    BeginSplitBarriersForPass(commandContext,
+                                              splitBarrierCandidates[nextPassNumber]);
                     nextPassNumber++;
                     break;
                 }
@@ -562,6 +711,8 @@ namespace dawn_native { namespace d3d12 {
                     DAWN_TRY(RecordRenderPass(commandContext, &bindingTracker, beginRenderPassCmd,
                                               passHasUAV));
 
+                    BeginSplitBarriersForPass(commandContext,
+                                              splitBarrierCandidates[nextPassNumber]);
                     nextPassNumber++;
                     break;
                 }
@@ -574,6 +725,8 @@ namespace dawn_native { namespace d3d12 {
                     bindingTracker.SetInRayTracingPass(true);
                     DAWN_TRY(RecordRayTracingPass(commandContext, &bindingTracker));
 
+                    BeginSplitBarriersForPass(commandContext,
+                                              splitBarrierCandidates[nextPassNumber]);
                     nextPassNumber++;
                     break;
                 }
@@ -583,6 +736,9 @@ namespace dawn_native { namespace d3d12 {
                         mCommands.NextCommand<BuildRayTracingAccelerationContainerCmd>();
                     RayTracingAccelerationContainer* container = ToBackend(build->container.Get());
 
+                    container->FlushInstanceUpdates();
+                    container->TrackHeapsUsage(commandContext);
+
                     MemoryEntry* resultMemory = &container->GetScratchMemory().result;
                     MemoryEntry* buildMemory = &container->GetScratchMemory().build;
 
@@ -618,6 +774,183 @@ namespace dawn_native { namespace d3d12 {
                     break;
                 }
 
+                case Command::BuildRayTracingAccelerationContainers: {
+                    BuildRayTracingAccelerationContainersCmd* build =
+                        mCommands.NextCommand<BuildRayTracingAccelerationContainersCmd>();
+                    auto containers =
+                        mCommands.NextData<Ref<RayTracingAccelerationContainerBase>>(build->count);
+
+                    // Record all builds back-to-back and only insert a single trailing UAV
+                    // barrier, instead of serializing the GPU with one barrier per build.
+                    for (uint32_t i = 0; i < build->count; ++i) {
+                        RayTracingAccelerationContainer* container =
+                            ToBackend(containers[i].Get());
+
+                        container->FlushInstanceUpdates();
+                        container->TrackHeapsUsage(commandContext);
+
+                        MemoryEntry* resultMemory = &container->GetScratchMemory().result;
+                        MemoryEntry* buildMemory = &container->GetScratchMemory().build;
+
+                        D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC buildDesc;
+                        buildDesc.Inputs = container->GetBuildInformation();
+                        buildDesc.SourceAccelerationStructureData = 0;
+                        buildDesc.DestAccelerationStructureData = resultMemory->address;
+                        buildDesc.ScratchAccelerationStructureData = buildMemory->address;
+
+                        commandList4->BuildRaytracingAccelerationStructure(&buildDesc, 0, nullptr);
+
+                        container->SetBuildState(true);
+
+                        if (container->GetLevel() != containers[0]->GetLevel()) {
+                            return DAWN_VALIDATION_ERROR(
+                                "Acceleration containers of different levels must be built in "
+                                "separate batches");
+                        }
+                    }
+
+                    // global barrier covering every result memory written by the batch
+                    D3D12_RESOURCE_BARRIER uavBarrier;
+                    uavBarrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+                    uavBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+                    uavBarrier.UAV.pResource = nullptr;
+                    commandList->ResourceBarrier(1, &uavBarrier);
+
+                    if (lastUpdateContainer != nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Build and update passes for acceleration containers must be "
+                            "separated");
+                    }
+                    if (build->count > 0) {
+                        RayTracingAccelerationContainer* firstContainer =
+                            ToBackend(containers[0].Get());
+                        if (lastBuildContainer != nullptr &&
+                            lastBuildContainer->GetLevel() != firstContainer->GetLevel()) {
+                            return DAWN_VALIDATION_ERROR(
+                                "Acceleration containers of different levels must be built in "
+                                "separate passes");
+                        }
+                        lastBuildContainer = firstContainer;
+                    }
+                    break;
+                }
+
+                case Command::CompactRayTracingAccelerationContainer: {
+                    CompactRayTracingAccelerationContainerCmd* compact =
+                        mCommands.NextCommand<CompactRayTracingAccelerationContainerCmd>();
+                    RayTracingAccelerationContainer* srcContainer =
+                        ToBackend(compact->srcContainer.Get());
+                    RayTracingAccelerationContainer* dstContainer =
+                        ToBackend(compact->dstContainer.Get());
+
+                    srcContainer->TrackHeapsUsage(commandContext);
+                    dstContainer->TrackHeapsUsage(commandContext);
+
+                    MemoryEntry* srcMemory = &srcContainer->GetScratchMemory().result;
+                    MemoryEntry* dstMemory = &dstContainer->GetScratchMemory().result;
+
+                    commandList4->CopyRaytracingAccelerationStructure(
+                        dstMemory->address, srcMemory->address,
+                        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_COMPACT);
+
+                    dstContainer->SetBuildState(true);
+                    break;
+                }
+
+                case Command::WriteRayTracingAccelerationContainerCompactedSize: {
+                    WriteRayTracingAccelerationContainerCompactedSizeCmd* write =
+                        mCommands
+                            .NextCommand<WriteRayTracingAccelerationContainerCompactedSizeCmd>();
+                    RayTracingAccelerationContainer* container = ToBackend(write->container.Get());
+                    Buffer* destination = ToBackend(write->destination.Get());
+
+                    container->TrackHeapsUsage(commandContext);
+
+                    // The postbuild info is written on the GPU timeline, the buffer must be in
+                    // the UAV state while the compacted size is emitted.
+                    destination->TrackUsageAndTransitionNow(commandContext,
+                                                            wgpu::BufferUsage::Storage);
+
+                    MemoryEntry* resultMemory = &container->GetScratchMemory().result;
+
+                    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC postbuildInfo;
+                    postbuildInfo.DestBuffer =
+                        destination->GetVA() + write->destinationOffset;
+                    postbuildInfo.InfoType =
+                        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE;
+
+                    commandList4->EmitRaytracingAccelerationStructurePostbuildInfo(
+                        &postbuildInfo, 1, &resultMemory->address);
+                    break;
+                }
+
+                case Command::WriteRayTracingAccelerationContainerSerializationSize: {
+                    WriteRayTracingAccelerationContainerSerializationSizeCmd* write =
+                        mCommands
+                            .NextCommand<WriteRayTracingAccelerationContainerSerializationSizeCmd>();
+                    RayTracingAccelerationContainer* container = ToBackend(write->container.Get());
+                    Buffer* destination = ToBackend(write->destination.Get());
+
+                    container->TrackHeapsUsage(commandContext);
+
+                    // The postbuild info is written on the GPU timeline, the buffer must be in
+                    // the UAV state while the serialization size is emitted.
+                    destination->TrackUsageAndTransitionNow(commandContext,
+                                                            wgpu::BufferUsage::Storage);
+
+                    MemoryEntry* resultMemory = &container->GetScratchMemory().result;
+
+                    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC postbuildInfo;
+                    postbuildInfo.DestBuffer =
+                        destination->GetVA() + write->destinationOffset;
+                    postbuildInfo.InfoType =
+                        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_SERIALIZATION;
+
+                    commandList4->EmitRaytracingAccelerationStructurePostbuildInfo(
+                        &postbuildInfo, 1, &resultMemory->address);
+                    break;
+                }
+
+                case Command::SerializeRayTracingAccelerationContainer: {
+                    SerializeRayTracingAccelerationContainerCmd* serialize =
+                        mCommands.NextCommand<SerializeRayTracingAccelerationContainerCmd>();
+                    RayTracingAccelerationContainer* container =
+                        ToBackend(serialize->container.Get());
+                    Buffer* destination = ToBackend(serialize->destination.Get());
+
+                    container->TrackHeapsUsage(commandContext);
+                    destination->TrackUsageAndTransitionNow(commandContext,
+                                                            wgpu::BufferUsage::Storage);
+
+                    MemoryEntry* srcMemory = &container->GetScratchMemory().result;
+
+                    commandList4->CopyRaytracingAccelerationStructure(
+                        destination->GetVA() + serialize->destinationOffset, srcMemory->address,
+                        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_SERIALIZE);
+                    break;
+                }
+
+                case Command::DeserializeRayTracingAccelerationContainer: {
+                    DeserializeRayTracingAccelerationContainerCmd* deserialize =
+                        mCommands.NextCommand<DeserializeRayTracingAccelerationContainerCmd>();
+                    RayTracingAccelerationContainer* container =
+                        ToBackend(deserialize->container.Get());
+                    Buffer* source = ToBackend(deserialize->source.Get());
+
+                    container->TrackHeapsUsage(commandContext);
+                    source->TrackUsageAndTransitionNow(commandContext,
+                                                       wgpu::BufferUsage::Storage);
+
+                    MemoryEntry* dstMemory = &container->GetScratchMemory().result;
+
+                    commandList4->CopyRaytracingAccelerationStructure(
+                        dstMemory->address, source->GetVA() + deserialize->sourceOffset,
+                        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_DESERIALIZE);
+
+                    container->SetBuildState(true);
+                    break;
+                }
+
                 case Command::CopyRayTracingAccelerationContainer: {
                     CopyRayTracingAccelerationContainerCmd* copy =
                         mCommands.NextCommand<CopyRayTracingAccelerationContainerCmd>();
@@ -626,6 +959,9 @@ namespace dawn_native { namespace d3d12 {
                     RayTracingAccelerationContainer* dstContainer =
                         ToBackend(copy->dstContainer.Get());
 
+                    srcContainer->TrackHeapsUsage(commandContext);
+                    dstContainer->TrackHeapsUsage(commandContext);
+
                     MemoryEntry* srcMemory = &srcContainer->GetScratchMemory().result;
                     MemoryEntry* dstMemory = &dstContainer->GetScratchMemory().result;
 
@@ -640,12 +976,16 @@ namespace dawn_native { namespace d3d12 {
                         mCommands.NextCommand<UpdateRayTracingAccelerationContainerCmd>();
                     RayTracingAccelerationContainer* container = ToBackend(update->container.Get());
 
+                    container->FlushInstanceUpdates();
+
                     // we can destroy the scratch build memory after the first update
                     if (container->IsBuilt() && !container->IsUpdated()) {
                         container->DestroyScratchBuildMemory();
                         container->SetUpdateState(true);
                     }
 
+                    container->TrackHeapsUsage(commandContext);
+
                     MemoryEntry* resultMemory = &container->GetScratchMemory().result;
                     MemoryEntry* updateMemory = &container->GetScratchMemory().update;
 
@@ -700,6 +1040,51 @@ namespace dawn_native { namespace d3d12 {
                     break;
                 }
 
+                case Command::CopyBufferToBufferBatch: {
+                    CopyBufferToBufferBatchCmd* copy =
+                        mCommands.NextCommand<CopyBufferToBufferBatchCmd>();
+                    const BufferCopyRegion* regions =
+                        mCommands.NextData<BufferCopyRegion>(copy->regionCount);
+                    Buffer* srcBuffer = ToBackend(copy->source.Get());
+                    Buffer* dstBuffer = ToBackend(copy->destination.Get());
+
+                    // One transition pair covers the whole batch; D3D12 has no multi-region
+                    // copy so the regions are recorded back to back.
+                    srcBuffer->TrackUsageAndTransitionNow(commandContext,
+                                                          wgpu::BufferUsage::CopySrc);
+                    dstBuffer->TrackUsageAndTransitionNow(commandContext,
+                                                          wgpu::BufferUsage::CopyDst);
+
+                    for (uint32_t i = 0; i < copy->regionCount; ++i) {
+                        commandList->CopyBufferRegion(dstBuffer->GetD3D12Resource().Get(),
+                                                      regions[i].destinationOffset,
+                                                      srcBuffer->GetD3D12Resource().Get(),
+                                                      regions[i].sourceOffset, regions[i].size);
+                    }
+                    break;
+                }
+
+                case Command::CopyBufferToRayTracingInstances: {
+                    CopyBufferToRayTracingInstancesCmd* copy =
+                        mCommands.NextCommand<CopyBufferToRayTracingInstancesCmd>();
+                    Buffer* srcBuffer = ToBackend(copy->source.Get());
+                    RayTracingAccelerationContainer* container =
+                        ToBackend(copy->container.Get());
+                    Buffer* instanceBuffer = container->GetInstanceMemory().allocation.Get();
+
+                    srcBuffer->TrackUsageAndTransitionNow(commandContext,
+                                                          wgpu::BufferUsage::CopySrc);
+                    instanceBuffer->TrackUsageAndTransitionNow(commandContext,
+                                                               wgpu::BufferUsage::CopyDst);
+
+                    commandList->CopyBufferRegion(
+                        instanceBuffer->GetD3D12Resource().Get(),
+                        copy->firstInstance * kRayTracingInstanceSize,
+                        srcBuffer->GetD3D12Resource().Get(), copy->sourceOffset,
+                        copy->instanceCount * kRayTracingInstanceSize);
+                    break;
+                }
+
                 case Command::CopyBufferToTexture: {
                     CopyBufferToTextureCmd* copy = mCommands.NextCommand<CopyBufferToTextureCmd>();
                     Buffer* buffer = ToBackend(copy->source.buffer.Get());
@@ -828,6 +1213,72 @@ namespace dawn_native { namespace d3d12 {
                     break;
                 }
 
+                case Command::ResolveQuerySet: {
+                    ResolveQuerySetCmd* cmd = mCommands.NextCommand<ResolveQuerySetCmd>();
+                    QuerySet* querySet = ToBackend(cmd->querySet.Get());
+                    Buffer* destination = ToBackend(cmd->destination.Get());
+
+                    destination->TrackUsageAndTransitionNow(commandContext,
+                                                            wgpu::BufferUsage::QueryResolve);
+
+                    if (querySet->GetQueryType() == wgpu::QueryType::PipelineStatistics) {
+                        // ResolveQueryData writes the full D3D12 statistics struct for every
+                        // query. Resolve into the query set's scratch buffer and copy just the
+                        // requested statistics, tightly packed, into the destination.
+                        ID3D12Resource* scratchResource =
+                            querySet->GetResolveScratchResource().Get();
+                        uint64_t statisticsSize = sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS);
+
+                        commandList->ResolveQueryData(
+                            querySet->GetQueryHeap(), D3D12_QUERY_TYPE_PIPELINE_STATISTICS,
+                            cmd->firstQuery, cmd->queryCount, scratchResource,
+                            cmd->firstQuery * statisticsSize);
+
+                        D3D12_RESOURCE_BARRIER barrier;
+                        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+                        barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+                        barrier.Transition.pResource = scratchResource;
+                        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+                        barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
+                        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
+                        commandList->ResourceBarrier(1, &barrier);
+
+                        const std::vector<wgpu::PipelineStatisticName>& statistics =
+                            querySet->GetPipelineStatistics();
+                        for (uint32_t query = 0; query < cmd->queryCount; ++query) {
+                            uint64_t sourceOffset = (cmd->firstQuery + query) * statisticsSize;
+                            uint64_t destinationOffset =
+                                cmd->destinationOffset + query * querySet->GetQueryDataSize();
+                            for (uint32_t i = 0; i < statistics.size(); ++i) {
+                                commandList->CopyBufferRegion(
+                                    destination->GetD3D12Resource().Get(),
+                                    destinationOffset + i * sizeof(uint64_t), scratchResource,
+                                    sourceOffset + D3D12PipelineStatisticOffset(statistics[i]),
+                                    sizeof(uint64_t));
+                            }
+                        }
+
+                        barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_SOURCE;
+                        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
+                        commandList->ResourceBarrier(1, &barrier);
+                    } else {
+                        commandList->ResolveQueryData(
+                            querySet->GetQueryHeap(), D3D12_QUERY_TYPE_TIMESTAMP, cmd->firstQuery,
+                            cmd->queryCount, destination->GetD3D12Resource().Get(),
+                            cmd->destinationOffset);
+                    }
+                    break;
+                }
+
+                case Command::WriteTimestamp: {
+                    WriteTimestampCmd* cmd = mCommands.NextCommand<WriteTimestampCmd>();
+                    QuerySet* querySet = ToBackend(cmd->querySet.Get());
+
+                    commandList->EndQuery(querySet->GetQueryHeap(), D3D12_QUERY_TYPE_TIMESTAMP,
+                                          cmd->queryIndex);
+                    break;
+                }
+
                 default: {
                     UNREACHABLE();
                     break;
@@ -842,6 +1293,7 @@ namespace dawn_native { namespace d3d12 {
                                                 BindGroupStateTracker* bindingTracker) {
         PipelineLayout* lastLayout = nullptr;
         ID3D12GraphicsCommandList* commandList = commandContext->GetCommandList();
+        ImmediateDataTracker immediateDataTracker = {};
 
         Command type;
         while (mCommands.NextCommandId(&type)) {
@@ -850,14 +1302,35 @@ namespace dawn_native { namespace d3d12 {
                     DispatchCmd* dispatch = mCommands.NextCommand<DispatchCmd>();
 
                     DAWN_TRY(bindingTracker->Apply(commandContext));
+                    immediateDataTracker.Apply(commandList, true);
                     commandList->Dispatch(dispatch->x, dispatch->y, dispatch->z);
                     break;
                 }
 
+                case Command::DispatchBatch: {
+                    DispatchBatchCmd* dispatch = mCommands.NextCommand<DispatchBatchCmd>();
+                    DispatchBatchEntry* entries =
+                        mCommands.NextData<DispatchBatchEntry>(dispatch->entryCount);
+                    BindGroup* group = ToBackend(dispatch->group.Get());
+
+                    // Each entry only moves the dynamic offset, so Apply() re-sets the
+                    // single dirty root descriptor and the loop stays a tight bind+dispatch
+                    // pair per entry.
+                    for (uint32_t i = 0; i < dispatch->entryCount; ++i) {
+                        bindingTracker->OnSetBindGroup(dispatch->groupIndex, group, 1,
+                                                       &entries[i].dynamicOffset);
+                        DAWN_TRY(bindingTracker->Apply(commandContext));
+                        immediateDataTracker.Apply(commandList, true);
+                        commandList->Dispatch(entries[i].x, entries[i].y, entries[i].z);
+                    }
+                    break;
+                }
+
                 case Command::DispatchIndirect: {
                     DispatchIndirectCmd* dispatch = mCommands.NextCommand<DispatchIndirectCmd>();
 
                     DAWN_TRY(bindingTracker->Apply(commandContext));
+                    immediateDataTracker.Apply(commandList, true);
                     Buffer* buffer = ToBackend(dispatch->indirectBuffer.Get());
                     ComPtr<ID3D12CommandSignature> signature =
                         ToBackend(GetDevice())->GetDispatchIndirectSignature();
@@ -872,6 +1345,26 @@ namespace dawn_native { namespace d3d12 {
                     return {};
                 }
 
+                case Command::BeginPipelineStatisticsQuery: {
+                    BeginPipelineStatisticsQueryCmd* cmd =
+                        mCommands.NextCommand<BeginPipelineStatisticsQueryCmd>();
+                    QuerySet* querySet = ToBackend(cmd->querySet.Get());
+
+                    commandList->BeginQuery(querySet->GetQueryHeap(),
+                                            D3D12_QUERY_TYPE_PIPELINE_STATISTICS, cmd->queryIndex);
+                    break;
+                }
+
+                case Command::EndPipelineStatisticsQuery: {
+                    EndPipelineStatisticsQueryCmd* cmd =
+                        mCommands.NextCommand<EndPipelineStatisticsQueryCmd>();
+                    QuerySet* querySet = ToBackend(cmd->querySet.Get());
+
+                    commandList->EndQuery(querySet->GetQueryHeap(),
+                                          D3D12_QUERY_TYPE_PIPELINE_STATISTICS, cmd->queryIndex);
+                    break;
+                }
+
                 case Command::SetComputePipeline: {
                     SetComputePipelineCmd* cmd = mCommands.NextCommand<SetComputePipelineCmd>();
                     ComputePipeline* pipeline = ToBackend(cmd->pipeline).Get();
@@ -881,6 +1374,7 @@ namespace dawn_native { namespace d3d12 {
                     commandList->SetPipelineState(pipeline->GetPipelineState());
 
                     bindingTracker->OnSetPipeline(pipeline);
+                    immediateDataTracker.OnSetPipeline(layout);
 
                     lastLayout = layout;
                     break;
@@ -900,6 +1394,14 @@ namespace dawn_native { namespace d3d12 {
                     break;
                 }
 
+                case Command::SetImmediateData: {
+                    SetImmediateDataCmd* cmd = mCommands.NextCommand<SetImmediateDataCmd>();
+                    uint8_t* data = mCommands.NextData<uint8_t>(cmd->size);
+
+                    immediateDataTracker.OnSetImmediateData(cmd->offset, cmd->size, data);
+                    break;
+                }
+
                 case Command::InsertDebugMarker: {
                     InsertDebugMarkerCmd* cmd = mCommands.NextCommand<InsertDebugMarkerCmd>();
                     const char* label = mCommands.NextData<char>(cmd->length + 1);
@@ -956,12 +1458,13 @@ namespace dawn_native { namespace d3d12 {
 
         ID3D12GraphicsCommandList* commandList = commandContext->GetCommandList();
         ID3D12GraphicsCommandList4* commandList4 = commandContext->GetCommandList4();
+        ImmediateDataTracker immediateDataTracker = {};
 
-        Command type;
-        while (mCommands.NextCommandId(&type)) {
+        auto EncodeRayTracingBundleCommand = [&](CommandIterator* iter,
+                                                 Command type) -> MaybeError {
             switch (type) {
                 case Command::TraceRays: {
-                    TraceRaysCmd* traceRays = mCommands.NextCommand<TraceRaysCmd>();
+                    TraceRaysCmd* traceRays = iter->NextCommand<TraceRaysCmd>();
 
                     ASSERT(usedPipeline != nullptr);
 
@@ -974,6 +1477,7 @@ namespace dawn_native { namespace d3d12 {
                         sbtTableBuffer.Get()->GetGPUVirtualAddress();
 
                     DAWN_TRY(bindingTracker->Apply(commandContext));
+                    immediateDataTracker.Apply(commandList, true);
 
                     D3D12_DISPATCH_RAYS_DESC desc;
                     desc.Width = traceRays->width;
@@ -1005,14 +1509,16 @@ namespace dawn_native { namespace d3d12 {
                     commandList4->DispatchRays(&desc);
                 } break;
 
-                case Command::EndRayTracingPass: {
-                    mCommands.NextCommand<EndRayTracingPassCmd>();
-                    return {};
+                case Command::TraceRaysIndirect: {
+                    iter->NextCommand<TraceRaysIndirectCmd>();
+                    // DXR has no equivalent of an indirect dispatch that consumes just the ray
+                    // dimensions: ExecuteIndirect with ray dispatches requires a full
+                    // D3D12_DISPATCH_RAYS_DESC in the argument buffer.
+                    return DAWN_VALIDATION_ERROR("TraceRaysIndirect is not supported on D3D12");
                 } break;
 
                 case Command::SetRayTracingPipeline: {
-                    SetRayTracingPipelineCmd* cmd =
-                        mCommands.NextCommand<SetRayTracingPipelineCmd>();
+                    SetRayTracingPipelineCmd* cmd = iter->NextCommand<SetRayTracingPipelineCmd>();
 
                     RayTracingPipeline* pipeline = ToBackend(cmd->pipeline).Get();
                     PipelineLayout* layout = ToBackend(pipeline->GetLayout());
@@ -1021,18 +1527,39 @@ namespace dawn_native { namespace d3d12 {
                     commandList4->SetPipelineState1(pipeline->GetPipelineState());
 
                     bindingTracker->OnSetPipeline(pipeline);
+                    immediateDataTracker.OnSetPipeline(layout);
 
                     lastLayout = layout;
                     usedPipeline = pipeline;
                 } break;
 
+                case Command::SetImmediateData: {
+                    SetImmediateDataCmd* cmd = iter->NextCommand<SetImmediateDataCmd>();
+                    uint8_t* data = iter->NextData<uint8_t>(cmd->size);
+
+                    immediateDataTracker.OnSetImmediateData(cmd->offset, cmd->size, data);
+                } break;
+
                 case Command::SetBindGroup: {
-                    SetBindGroupCmd* cmd = mCommands.NextCommand<SetBindGroupCmd>();
+                    SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
                     BindGroup* group = ToBackend(cmd->group.Get());
                     uint32_t* dynamicOffsets = nullptr;
 
                     if (cmd->dynamicOffsetCount > 0) {
-                        dynamicOffsets = mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
+                        dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                    }
+
+                    // Acceleration containers bound for this pass must be resident while the
+                    // pass executes.
+                    const BindGroupLayoutBase* layout = group->GetLayout();
+                    for (BindingIndex bindingIndex = 0; bindingIndex < layout->GetBindingCount();
+                         ++bindingIndex) {
+                        if (layout->GetBindingInfo(bindingIndex).type ==
+                            wgpu::BindingType::AccelerationContainer) {
+                            ToBackend(group->GetBindingAsRayTracingAccelerationContainer(
+                                          bindingIndex))
+                                ->TrackHeapsUsage(commandContext);
+                        }
                     }
 
                     bindingTracker->OnSetBindGroup(cmd->index, group, cmd->dynamicOffsetCount,
@@ -1040,8 +1567,8 @@ namespace dawn_native { namespace d3d12 {
                 } break;
 
                 case Command::InsertDebugMarker: {
-                    InsertDebugMarkerCmd* cmd = mCommands.NextCommand<InsertDebugMarkerCmd>();
-                    const char* label = mCommands.NextData<char>(cmd->length + 1);
+                    InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
+                    const char* label = iter->NextData<char>(cmd->length + 1);
 
                     if (ToBackend(GetDevice())->GetFunctions()->IsPIXEventRuntimeLoaded()) {
                         // PIX color is 1 byte per channel in ARGB format
@@ -1053,7 +1580,7 @@ namespace dawn_native { namespace d3d12 {
                 } break;
 
                 case Command::PopDebugGroup: {
-                    mCommands.NextCommand<PopDebugGroupCmd>();
+                    iter->NextCommand<PopDebugGroupCmd>();
 
                     if (ToBackend(GetDevice())->GetFunctions()->IsPIXEventRuntimeLoaded()) {
                         ToBackend(GetDevice())
@@ -1063,8 +1590,8 @@ namespace dawn_native { namespace d3d12 {
                 } break;
 
                 case Command::PushDebugGroup: {
-                    PushDebugGroupCmd* cmd = mCommands.NextCommand<PushDebugGroupCmd>();
-                    const char* label = mCommands.NextData<char>(cmd->length + 1);
+                    PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
+                    const char* label = iter->NextData<char>(cmd->length + 1);
 
                     if (ToBackend(GetDevice())->GetFunctions()->IsPIXEventRuntimeLoaded()) {
                         // PIX color is 1 byte per channel in ARGB format
@@ -1079,6 +1606,54 @@ namespace dawn_native { namespace d3d12 {
                     UNREACHABLE();
                 } break;
             }
+
+            return {};
+        };
+
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            switch (type) {
+                case Command::EndRayTracingPass: {
+                    mCommands.NextCommand<EndRayTracingPassCmd>();
+                    return {};
+                } break;
+
+                case Command::BeginPipelineStatisticsQuery: {
+                    BeginPipelineStatisticsQueryCmd* cmd =
+                        mCommands.NextCommand<BeginPipelineStatisticsQueryCmd>();
+                    QuerySet* querySet = ToBackend(cmd->querySet.Get());
+
+                    commandList->BeginQuery(querySet->GetQueryHeap(),
+                                            D3D12_QUERY_TYPE_PIPELINE_STATISTICS, cmd->queryIndex);
+                } break;
+
+                case Command::EndPipelineStatisticsQuery: {
+                    EndPipelineStatisticsQueryCmd* cmd =
+                        mCommands.NextCommand<EndPipelineStatisticsQueryCmd>();
+                    QuerySet* querySet = ToBackend(cmd->querySet.Get());
+
+                    commandList->EndQuery(querySet->GetQueryHeap(),
+                                          D3D12_QUERY_TYPE_PIPELINE_STATISTICS, cmd->queryIndex);
+                } break;
+
+                case Command::ExecuteRayTracingBundles: {
+                    ExecuteRayTracingBundlesCmd* cmd =
+                        mCommands.NextCommand<ExecuteRayTracingBundlesCmd>();
+                    auto bundles = mCommands.NextData<Ref<RayTracingBundleBase>>(cmd->count);
+
+                    for (uint32_t i = 0; i < cmd->count; ++i) {
+                        CommandIterator* iter = bundles[i]->GetCommands();
+                        iter->Reset();
+                        while (iter->NextCommandId(&type)) {
+                            DAWN_TRY(EncodeRayTracingBundleCommand(iter, type));
+                        }
+                    }
+                } break;
+
+                default: {
+                    DAWN_TRY(EncodeRayTracingBundleCommand(&mCommands, type));
+                } break;
+            }
         }
 
         return {};
@@ -1277,6 +1852,7 @@ namespace dawn_native { namespace d3d12 {
         PipelineLayout* lastLayout = nullptr;
         VertexBufferTracker vertexBufferTracker = {};
         IndexBufferTracker indexBufferTracker = {};
+        ImmediateDataTracker immediateDataTracker = {};
 
         auto EncodeRenderBundleCommand = [&](CommandIterator* iter, Command type) -> MaybeError {
             switch (type) {
@@ -1285,6 +1861,7 @@ namespace dawn_native { namespace d3d12 {
 
                     DAWN_TRY(bindingTracker->Apply(commandContext));
                     vertexBufferTracker.Apply(commandList, lastPipeline);
+                    immediateDataTracker.Apply(commandList, false);
                     commandList->DrawInstanced(draw->vertexCount, draw->instanceCount,
                                                draw->firstVertex, draw->firstInstance);
                     break;
@@ -1296,6 +1873,7 @@ namespace dawn_native { namespace d3d12 {
                     DAWN_TRY(bindingTracker->Apply(commandContext));
                     indexBufferTracker.Apply(commandList);
                     vertexBufferTracker.Apply(commandList, lastPipeline);
+                    immediateDataTracker.Apply(commandList, false);
                     commandList->DrawIndexedInstanced(draw->indexCount, draw->instanceCount,
                                                       draw->firstIndex, draw->baseVertex,
                                                       draw->firstInstance);
@@ -1307,6 +1885,7 @@ namespace dawn_native { namespace d3d12 {
 
                     DAWN_TRY(bindingTracker->Apply(commandContext));
                     vertexBufferTracker.Apply(commandList, lastPipeline);
+                    immediateDataTracker.Apply(commandList, false);
                     Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
                     ComPtr<ID3D12CommandSignature> signature =
                         ToBackend(GetDevice())->GetDrawIndirectSignature();
@@ -1322,6 +1901,7 @@ namespace dawn_native { namespace d3d12 {
                     DAWN_TRY(bindingTracker->Apply(commandContext));
                     indexBufferTracker.Apply(commandList);
                     vertexBufferTracker.Apply(commandList, lastPipeline);
+                    immediateDataTracker.Apply(commandList, false);
                     Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
                     ComPtr<ID3D12CommandSignature> signature =
                         ToBackend(GetDevice())->GetDrawIndexedIndirectSignature();
@@ -1331,6 +1911,31 @@ namespace dawn_native { namespace d3d12 {
                     break;
                 }
 
+                case Command::MultiDrawIndexedIndirect: {
+                    MultiDrawIndexedIndirectCmd* draw =
+                        iter->NextCommand<MultiDrawIndexedIndirectCmd>();
+
+                    DAWN_TRY(bindingTracker->Apply(commandContext));
+                    indexBufferTracker.Apply(commandList);
+                    vertexBufferTracker.Apply(commandList, lastPipeline);
+                    immediateDataTracker.Apply(commandList, false);
+                    Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+                    // The command signature's stride matches the indirect arguments so the
+                    // count buffer can be passed straight to ExecuteIndirect.
+                    ID3D12Resource* countResource =
+                        draw->countBuffer != nullptr
+                            ? ToBackend(draw->countBuffer.Get())->GetD3D12Resource().Get()
+                            : nullptr;
+                    uint64_t countOffset =
+                        draw->countBuffer != nullptr ? draw->countBufferOffset : 0;
+                    ComPtr<ID3D12CommandSignature> signature =
+                        ToBackend(GetDevice())->GetDrawIndexedIndirectSignature();
+                    commandList->ExecuteIndirect(signature.Get(), draw->maxDrawCount,
+                                                 buffer->GetD3D12Resource().Get(),
+                                                 draw->indirectOffset, countResource, countOffset);
+                    break;
+                }
+
                 case Command::InsertDebugMarker: {
                     InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
                     const char* label = iter->NextData<char>(cmd->length + 1);
@@ -1381,12 +1986,21 @@ namespace dawn_native { namespace d3d12 {
 
                     bindingTracker->OnSetPipeline(pipeline);
                     indexBufferTracker.OnSetPipeline(pipeline);
+                    immediateDataTracker.OnSetPipeline(layout);
 
                     lastPipeline = pipeline;
                     lastLayout = layout;
                     break;
                 }
 
+                case Command::SetImmediateData: {
+                    SetImmediateDataCmd* cmd = iter->NextCommand<SetImmediateDataCmd>();
+                    uint8_t* data = iter->NextData<uint8_t>(cmd->size);
+
+                    immediateDataTracker.OnSetImmediateData(cmd->offset, cmd->size, data);
+                    break;
+                }
+
                 case Command::SetBindGroup: {
                     SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
                     BindGroup* group = ToBackend(cmd->group.Get());
@@ -68,8 +68,29 @@ namespace dawn_native { namespace d3d12 {
             d3dDesc.CS.BytecodeLength = compiledFXCShader->GetBufferSize();
         }
 
+        // Try to load the pipeline from the device's pipeline library before compiling it.
+        // The name is a hash of the compiled shader; the library validates the stored
+        // descriptor on load so a collision only costs a cache miss.
+        ID3D12PipelineLibrary* pipelineLibrary = device->GetPipelineLibrary();
+        std::wstring pipelineName;
+        if (pipelineLibrary != nullptr) {
+            size_t hash = 0;
+            HashShaderBytecode(&hash, d3dDesc.CS);
+            pipelineName = std::to_wstring(hash);
+            if (SUCCEEDED(pipelineLibrary->LoadComputePipeline(pipelineName.c_str(), &d3dDesc,
+                                                               IID_PPV_ARGS(&mPipelineState)))) {
+                return {};
+            }
+        }
+
         device->GetD3D12Device()->CreateComputePipelineState(&d3dDesc,
                                                              IID_PPV_ARGS(&mPipelineState));
+
+        if (pipelineLibrary != nullptr && mPipelineState != nullptr) {
+            // Storing can fail when the name is already taken by a colliding pipeline;
+            // this only means the new pipeline isn't cached.
+            pipelineLibrary->StorePipeline(pipelineName.c_str(), mPipelineState.Get());
+        }
         return {};
     }
 
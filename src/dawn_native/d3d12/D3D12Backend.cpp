@@ -19,8 +19,10 @@
 
 #include "common/SwapChainUtils.h"
 #include "dawn_native/d3d12/DeviceD3D12.h"
+#include "dawn_native/d3d12/HeapD3D12.h"
 #include "dawn_native/d3d12/NativeSwapChainImplD3D12.h"
 #include "dawn_native/d3d12/ResidencyManagerD3D12.h"
+#include "dawn_native/d3d12/ShaderVisibleDescriptorAllocatorD3D12.h"
 #include "dawn_native/d3d12/TextureD3D12.h"
 
 namespace dawn_native { namespace d3d12 {
@@ -41,12 +43,35 @@ namespace dawn_native { namespace d3d12 {
         return impl;
     }
 
+    DawnSwapChainImplementation CreateNativeSwapChainImpl(
+        WGPUDevice device,
+        HWND window,
+        const SwapChainLatencyDescriptor* latencyDescriptor) {
+        if (latencyDescriptor == nullptr) {
+            return CreateNativeSwapChainImpl(device, window);
+        }
+
+        Device* backendDevice = reinterpret_cast<Device*>(device);
+
+        DawnSwapChainImplementation impl;
+        impl = CreateSwapChainImplementation(
+            new NativeSwapChainImpl(backendDevice, window, *latencyDescriptor));
+        impl.textureUsage = WGPUTextureUsage_Present;
+
+        return impl;
+    }
+
     WGPUTextureFormat GetNativeSwapChainPreferredFormat(
         const DawnSwapChainImplementation* swapChain) {
         NativeSwapChainImpl* impl = reinterpret_cast<NativeSwapChainImpl*>(swapChain->userData);
         return static_cast<WGPUTextureFormat>(impl->GetPreferredFormat());
     }
 
+    HANDLE GetFrameLatencyWaitableObject(const DawnSwapChainImplementation* swapChain) {
+        NativeSwapChainImpl* impl = reinterpret_cast<NativeSwapChainImpl*>(swapChain->userData);
+        return impl->GetFrameLatencyWaitableObject();
+    }
+
     ExternalImageDescriptorDXGISharedHandle::ExternalImageDescriptorDXGISharedHandle()
         : ExternalImageDescriptor(ExternalImageDescriptorType::DXGISharedHandle) {
     }
@@ -60,6 +85,61 @@ namespace dawn_native { namespace d3d12 {
             memorySegment, requestedReservationSize);
     }
 
+    bool MakeResidentAsync(WGPUDevice device, WGPUTexture const* textures, uint64_t textureCount) {
+        Device* backendDevice = reinterpret_cast<Device*>(device);
+
+        for (uint64_t i = 0; i < textureCount; ++i) {
+            Texture* texture = reinterpret_cast<Texture*>(textures[i]);
+            Heap* heap = texture->GetHeap();
+
+            // Textures wrapping externally created resources have no heap Dawn manages.
+            if (heap == nullptr) {
+                continue;
+            }
+
+            if (backendDevice->ConsumedError(
+                    backendDevice->GetResidencyManager()->MakeResidentAsync(heap))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ShaderVisibleHeapStatistics GetShaderVisibleHeapStatistics(WGPUDevice device) {
+        Device* backendDevice = reinterpret_cast<Device*>(device);
+        ShaderVisibleDescriptorAllocator* viewAllocator =
+            backendDevice->GetViewShaderVisibleDescriptorAllocator();
+        ShaderVisibleDescriptorAllocator* samplerAllocator =
+            backendDevice->GetSamplerShaderVisibleDescriptorAllocator();
+
+        ShaderVisibleHeapStatistics statistics;
+        statistics.viewHeapSize = viewAllocator->GetHeapSize();
+        statistics.viewDescriptorHighWaterMark = viewAllocator->GetDescriptorHighWaterMark();
+        statistics.viewHeapSwitchCount = viewAllocator->GetHeapSwitchCount();
+        statistics.samplerHeapSize = samplerAllocator->GetHeapSize();
+        statistics.samplerDescriptorHighWaterMark = samplerAllocator->GetDescriptorHighWaterMark();
+        statistics.samplerHeapSwitchCount = samplerAllocator->GetHeapSwitchCount();
+        return statistics;
+    }
+
+    bool ReserveShaderVisibleDescriptorHeaps(WGPUDevice device,
+                                             uint32_t viewDescriptorCount,
+                                             uint32_t samplerDescriptorCount) {
+        Device* backendDevice = reinterpret_cast<Device*>(device);
+
+        if (backendDevice->ConsumedError(
+                backendDevice->GetViewShaderVisibleDescriptorAllocator()->SetDescriptorCount(
+                    viewDescriptorCount))) {
+            return false;
+        }
+        if (backendDevice->ConsumedError(
+                backendDevice->GetSamplerShaderVisibleDescriptorAllocator()->SetDescriptorCount(
+                    samplerDescriptorCount))) {
+            return false;
+        }
+        return true;
+    }
+
     WGPUTexture WrapSharedHandle(WGPUDevice device,
                                  const ExternalImageDescriptorDXGISharedHandle* descriptor) {
         Device* backendDevice = reinterpret_cast<Device*>(device);
@@ -69,4 +149,15 @@ namespace dawn_native { namespace d3d12 {
         return reinterpret_cast<WGPUTexture>(texture.Detach());
     }
 
+    HANDLE ExportFenceSharedHandle(WGPUDevice device, uint64_t* outCompletionValue) {
+        Device* backendDevice = reinterpret_cast<Device*>(device);
+
+        HANDLE sharedHandle = nullptr;
+        if (backendDevice->ConsumedError(
+                backendDevice->ExportFenceSharedHandle(&sharedHandle, outCompletionValue))) {
+            return nullptr;
+        }
+        return sharedHandle;
+    }
+
 }}  // namespace dawn_native::d3d12
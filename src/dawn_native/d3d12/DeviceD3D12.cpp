@@ -17,6 +17,8 @@
 #include "common/Assert.h"
 #include "common/Log.h"
 #include "dawn_native/BackendConnection.h"
+#include "dawn_native/CommandBuffer.h"
+#include "dawn_native/Commands.h"
 #include "dawn_native/ErrorData.h"
 #include "dawn_native/d3d12/AdapterD3D12.h"
 #include "dawn_native/d3d12/BackendD3D12.h"
@@ -28,6 +30,7 @@
 #include "dawn_native/d3d12/ComputePipelineD3D12.h"
 #include "dawn_native/d3d12/D3D12Error.h"
 #include "dawn_native/d3d12/PipelineLayoutD3D12.h"
+#include "dawn_native/d3d12/QuerySetD3D12.h"
 #include "dawn_native/d3d12/PlatformFunctions.h"
 #include "dawn_native/d3d12/QueueD3D12.h"
 #include "dawn_native/d3d12/RayTracingAccelerationContainerD3D12.h"
@@ -43,7 +46,9 @@
 #include "dawn_native/d3d12/StagingBufferD3D12.h"
 #include "dawn_native/d3d12/StagingDescriptorAllocatorD3D12.h"
 #include "dawn_native/d3d12/SwapChainD3D12.h"
+#include "dawn_native/d3d12/TextureCopySplitter.h"
 #include "dawn_native/d3d12/TextureD3D12.h"
+#include "dawn_native/d3d12/UtilsD3D12.h"
 
 namespace dawn_native { namespace d3d12 {
 
@@ -85,13 +90,23 @@ namespace dawn_native { namespace d3d12 {
         mCommandQueue.As(&mD3d12SharingContract);
 
         DAWN_TRY(
+            // The fence is created shared so ExportFenceSharedHandle can hand it to other
+            // processes; the flag has no cost when the fence is never exported.
             CheckHRESULT(mD3d12Device->CreateFence(GetLastSubmittedCommandSerial(),
-                                                   D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&mFence)),
+                                                   D3D12_FENCE_FLAG_SHARED, IID_PPV_ARGS(&mFence)),
                          "D3D12 create fence"));
 
         mFenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
         ASSERT(mFenceEvent != nullptr);
 
+        // Create the pipeline library backing the persistent pipeline cache. This can fail
+        // on OS versions without ID3D12Device1, in which case pipelines are compiled from
+        // scratch every run.
+        ComPtr<ID3D12Device1> d3d12Device1;
+        if (SUCCEEDED(mD3d12Device.As(&d3d12Device1))) {
+            d3d12Device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&mPipelineLibrary));
+        }
+
         // Initialize backend services
         mCommandAllocatorManager = std::make_unique<CommandAllocatorManager>(this);
 
@@ -168,6 +183,49 @@ namespace dawn_native { namespace d3d12 {
         return mD3d12Device5.Get();
     }
 
+    ID3D12PipelineLibrary* Device::GetPipelineLibrary() const {
+        return mPipelineLibrary.Get();
+    }
+
+    MaybeError Device::LoadPipelineCacheDataImpl(const void* data, size_t size) {
+        ComPtr<ID3D12Device1> d3d12Device1;
+        if (FAILED(mD3d12Device.As(&d3d12Device1))) {
+            return {};
+        }
+
+        // The library reads from the blob for its whole lifetime, so copy the data before
+        // handing it over. Creation fails for blobs recorded on a different driver or
+        // adapter, in which case the current library is kept.
+        std::vector<uint8_t> blob(static_cast<const uint8_t*>(data),
+                                  static_cast<const uint8_t*>(data) + size);
+
+        ComPtr<ID3D12PipelineLibrary> library;
+        if (FAILED(d3d12Device1->CreatePipelineLibrary(blob.data(), blob.size(),
+                                                       IID_PPV_ARGS(&library)))) {
+            return DAWN_VALIDATION_ERROR(
+                "Pipeline cache data is not compatible with this adapter");
+        }
+
+        mPipelineLibrary = std::move(library);
+        mPipelineLibraryBlob = std::move(blob);
+        return {};
+    }
+
+    ResultOrError<std::vector<uint8_t>> Device::GetPipelineCacheDataImpl() {
+        if (mPipelineLibrary == nullptr) {
+            return std::vector<uint8_t>();
+        }
+
+        std::vector<uint8_t> data(mPipelineLibrary->GetSerializedSize());
+        DAWN_TRY(CheckHRESULT(mPipelineLibrary->Serialize(data.data(), data.size()),
+                              "ID3D12PipelineLibrary::Serialize"));
+        return std::move(data);
+    }
+
+    MemoryBudgetInfo Device::QueryMemoryBudgetImpl() {
+        return mResidencyManager->QueryMemoryBudget();
+    }
+
     ComPtr<ID3D12CommandQueue> Device::GetCommandQueue() const {
         return mCommandQueue;
     }
@@ -260,6 +318,20 @@ namespace dawn_native { namespace d3d12 {
         return mFence->GetCompletedValue();
     }
 
+    bool Device::WaitForCompletedWorkImpl(uint64_t timeoutNanoseconds) {
+        if (FAILED(mFence->SetEventOnCompletion(GetCompletedCommandSerial() + 1, mFenceEvent))) {
+            return false;
+        }
+        // WaitForSingleObject only has millisecond granularity; round up so a short timeout
+        // still waits instead of degenerating into a poll, and clamp below INFINITE.
+        uint64_t timeoutMilliseconds = (timeoutNanoseconds + 999999) / 1000000;
+        if (timeoutMilliseconds >= INFINITE) {
+            timeoutMilliseconds = INFINITE - 1;
+        }
+        return WaitForSingleObject(mFenceEvent, static_cast<DWORD>(timeoutMilliseconds)) ==
+               WAIT_OBJECT_0;
+    }
+
     void Device::ReferenceUntilUnused(ComPtr<IUnknown> object) {
         mUsedComObjectRefs.Enqueue(object, GetPendingCommandSerial());
     }
@@ -306,6 +378,9 @@ namespace dawn_native { namespace d3d12 {
         const PipelineLayoutDescriptor* descriptor) {
         return PipelineLayout::Create(this, descriptor);
     }
+    ResultOrError<QuerySetBase*> Device::CreateQuerySetImpl(const QuerySetDescriptor* descriptor) {
+        return QuerySet::Create(this, descriptor);
+    }
     ResultOrError<RenderPipelineBase*> Device::CreateRenderPipelineImpl(
         const RenderPipelineDescriptor* descriptor) {
         return RenderPipeline::Create(this, descriptor);
@@ -338,7 +413,15 @@ namespace dawn_native { namespace d3d12 {
 
     ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateStagingBuffer(size_t size) {
         std::unique_ptr<StagingBufferBase> stagingBuffer =
-            std::make_unique<StagingBuffer>(size, this);
+            std::make_unique<StagingBuffer>(size, this, StagingAccess::Upload);
+        DAWN_TRY(stagingBuffer->Initialize());
+        return std::move(stagingBuffer);
+    }
+
+    ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateReadbackStagingBuffer(
+        size_t size) {
+        std::unique_ptr<StagingBufferBase> stagingBuffer =
+            std::make_unique<StagingBuffer>(size, this, StagingAccess::Readback);
         DAWN_TRY(stagingBuffer->Initialize());
         return std::move(stagingBuffer);
     }
@@ -362,6 +445,71 @@ namespace dawn_native { namespace d3d12 {
         return {};
     }
 
+    MaybeError Device::CopyFromBufferToStaging(BufferBase* source,
+                                               uint64_t sourceOffset,
+                                               StagingBufferBase* destination,
+                                               uint64_t destinationOffset,
+                                               uint64_t size) {
+        CommandRecordingContext* commandRecordingContext;
+        DAWN_TRY_ASSIGN(commandRecordingContext, GetPendingCommandContext());
+
+        Buffer* srcBuffer = ToBackend(source);
+        StagingBuffer* dstBuffer = ToBackend(destination);
+        srcBuffer->TrackUsageAndTransitionNow(commandRecordingContext, wgpu::BufferUsage::CopySrc);
+
+        // Readback staging resources are created in and stay in the COPY_DEST state, so only
+        // the source needs a transition.
+        commandRecordingContext->GetCommandList()->CopyBufferRegion(
+            dstBuffer->GetResource(), destinationOffset, srcBuffer->GetD3D12Resource().Get(),
+            sourceOffset, size);
+
+        return {};
+    }
+
+    MaybeError Device::CopyFromStagingToTexture(StagingBufferBase* source,
+                                                uint64_t sourceOffset,
+                                                uint32_t bytesPerRow,
+                                                uint32_t rowsPerImage,
+                                                const TextureCopy& dst,
+                                                const Extent3D& copySizePixels) {
+        CommandRecordingContext* commandContext;
+        DAWN_TRY_ASSIGN(commandContext, GetPendingCommandContext());
+
+        Texture* texture = ToBackend(dst.texture.Get());
+
+        if (IsCompleteSubresourceCopiedTo(texture, copySizePixels, dst.mipLevel)) {
+            texture->SetIsSubresourceContentInitialized(true, dst.mipLevel, 1, dst.arrayLayer, 1);
+        } else {
+            texture->EnsureSubresourceContentInitialized(commandContext, dst.mipLevel, 1,
+                                                         dst.arrayLayer, 1);
+        }
+
+        texture->TrackUsageAndTransitionNow(commandContext, wgpu::TextureUsage::CopyDst);
+
+        auto copySplit = ComputeTextureCopySplit(dst.origin, copySizePixels, texture->GetFormat(),
+                                                 sourceOffset, bytesPerRow, rowsPerImage);
+
+        D3D12_TEXTURE_COPY_LOCATION textureLocation =
+            ComputeTextureCopyLocationForTexture(texture, dst.mipLevel, dst.arrayLayer);
+
+        for (uint32_t i = 0; i < copySplit.count; ++i) {
+            TextureCopySplit::CopyInfo& info = copySplit.copies[i];
+
+            D3D12_TEXTURE_COPY_LOCATION bufferLocation =
+                ComputeBufferLocationForCopyTextureRegion(texture, ToBackend(source)->GetResource(),
+                                                          info.bufferSize, copySplit.offset,
+                                                          bytesPerRow);
+            D3D12_BOX sourceRegion =
+                ComputeD3D12BoxFromOffsetAndSize(info.bufferOffset, info.copySize);
+
+            commandContext->GetCommandList()->CopyTextureRegion(
+                &textureLocation, info.textureOffset.x, info.textureOffset.y, info.textureOffset.z,
+                &bufferLocation, &sourceRegion);
+        }
+
+        return {};
+    }
+
     void Device::DeallocateMemory(ResourceHeapAllocation& allocation) {
         mResourceAllocatorManager->DeallocateMemory(allocation);
     }
@@ -369,9 +517,10 @@ namespace dawn_native { namespace d3d12 {
     ResultOrError<ResourceHeapAllocation> Device::AllocateMemory(
         D3D12_HEAP_TYPE heapType,
         const D3D12_RESOURCE_DESC& resourceDescriptor,
-        D3D12_RESOURCE_STATES initialUsage) {
+        D3D12_RESOURCE_STATES initialUsage,
+        AllocationClass allocationClass) {
         return mResourceAllocatorManager->AllocateMemory(heapType, resourceDescriptor,
-                                                         initialUsage);
+                                                         initialUsage, allocationClass);
     }
 
     Ref<TextureBase> Device::WrapSharedHandle(const ExternalImageDescriptor* descriptor,
@@ -387,6 +536,23 @@ namespace dawn_native { namespace d3d12 {
         return dawnTexture;
     }
 
+    MaybeError Device::ExportFenceSharedHandle(HANDLE* outSharedHandle,
+                                               uint64_t* outCompletionValue) {
+        // Flush recorded commands and signal the fence so that the exported completion
+        // value covers all the work submitted so far.
+        DAWN_TRY(ExecutePendingCommandContext());
+        DAWN_TRY(NextSerial());
+
+        HANDLE sharedHandle = nullptr;
+        DAWN_TRY(CheckHRESULT(mD3d12Device->CreateSharedHandle(mFence.Get(), nullptr, GENERIC_ALL,
+                                                               nullptr, &sharedHandle),
+                              "D3D12 create fence shared handle"));
+
+        *outSharedHandle = sharedHandle;
+        *outCompletionValue = GetLastSubmittedCommandSerial();
+        return {};
+    }
+
     // We use IDXGIKeyedMutexes to synchronize access between D3D11 and D3D12. D3D11/12 fences
     // are a viable alternative but are, unfortunately, not available on all versions of Windows
     // 10. Since D3D12 does not directly support keyed mutexes, we need to wrap the D3D12
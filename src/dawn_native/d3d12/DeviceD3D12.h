@@ -45,7 +45,7 @@ namespace dawn_native { namespace d3d12 {
     } while (0)
 
     // Definition of backend types
-    class Device : public DeviceBase {
+    class Device final : public DeviceBase {
       public:
         static ResultOrError<Device*> Create(Adapter* adapter, const DeviceDescriptor* descriptor);
         ~Device() override;
@@ -60,6 +60,12 @@ namespace dawn_native { namespace d3d12 {
         ID3D12Device* GetD3D12Device() const;
         ID3D12Device5* GetD3D12Device5() const;
 
+        // Pipeline library backing the persistent pipeline cache, nullptr when the OS
+        // doesn't support ID3D12Device1. Graphics and compute pipelines are stored under a
+        // name derived from a hash of their descriptor; ray tracing state objects cannot
+        // be stored in a pipeline library.
+        ID3D12PipelineLibrary* GetPipelineLibrary() const;
+
         ComPtr<ID3D12CommandQueue> GetCommandQueue() const;
         ID3D12SharingContract* GetSharingContract() const;
 
@@ -87,16 +93,30 @@ namespace dawn_native { namespace d3d12 {
         MaybeError ExecutePendingCommandContext();
 
         ResultOrError<std::unique_ptr<StagingBufferBase>> CreateStagingBuffer(size_t size) override;
+        ResultOrError<std::unique_ptr<StagingBufferBase>> CreateReadbackStagingBuffer(
+            size_t size) override;
         MaybeError CopyFromStagingToBuffer(StagingBufferBase* source,
                                            uint64_t sourceOffset,
                                            BufferBase* destination,
                                            uint64_t destinationOffset,
                                            uint64_t size) override;
+        MaybeError CopyFromStagingToTexture(StagingBufferBase* source,
+                                            uint64_t sourceOffset,
+                                            uint32_t bytesPerRow,
+                                            uint32_t rowsPerImage,
+                                            const TextureCopy& dst,
+                                            const Extent3D& copySizePixels) override;
+        MaybeError CopyFromBufferToStaging(BufferBase* source,
+                                           uint64_t sourceOffset,
+                                           StagingBufferBase* destination,
+                                           uint64_t destinationOffset,
+                                           uint64_t size) override;
 
         ResultOrError<ResourceHeapAllocation> AllocateMemory(
             D3D12_HEAP_TYPE heapType,
             const D3D12_RESOURCE_DESC& resourceDescriptor,
-            D3D12_RESOURCE_STATES initialUsage);
+            D3D12_RESOURCE_STATES initialUsage,
+            AllocationClass allocationClass);
 
         void DeallocateMemory(ResourceHeapAllocation& allocation);
 
@@ -120,6 +140,10 @@ namespace dawn_native { namespace d3d12 {
                                           HANDLE sharedHandle,
                                           uint64_t acquireMutexKey,
                                           bool isSwapChainTexture);
+        // Exports the fence the queue signals after each submission as a shared handle,
+        // flushing pending commands first so `outCompletionValue` covers all the work
+        // submitted so far. The caller owns the returned handle.
+        MaybeError ExportFenceSharedHandle(HANDLE* outSharedHandle, uint64_t* outCompletionValue);
         ResultOrError<ComPtr<IDXGIKeyedMutex>> CreateKeyedMutexForTexture(
             ID3D12Resource* d3d12Resource);
         void ReleaseKeyedMutexForTexture(ComPtr<IDXGIKeyedMutex> dxgiKeyedMutex);
@@ -145,6 +169,8 @@ namespace dawn_native { namespace d3d12 {
             const ComputePipelineDescriptor* descriptor) override;
         ResultOrError<PipelineLayoutBase*> CreatePipelineLayoutImpl(
             const PipelineLayoutDescriptor* descriptor) override;
+        ResultOrError<QuerySetBase*> CreateQuerySetImpl(
+            const QuerySetDescriptor* descriptor) override;
         ResultOrError<RenderPipelineBase*> CreateRenderPipelineImpl(
             const RenderPipelineDescriptor* descriptor) override;
         ResultOrError<SamplerBase*> CreateSamplerImpl(const SamplerDescriptor* descriptor) override;
@@ -162,6 +188,15 @@ namespace dawn_native { namespace d3d12 {
             TextureBase* texture,
             const TextureViewDescriptor* descriptor) override;
 
+        MaybeError LoadPipelineCacheDataImpl(const void* data, size_t size) override;
+        ResultOrError<std::vector<uint8_t>> GetPipelineCacheDataImpl() override;
+
+        MemoryBudgetInfo QueryMemoryBudgetImpl() override;
+
+        // Waits on mFenceEvent for the fence to pass the last serial Tick observed, so
+        // embedders can sleep until a Tick would make progress.
+        bool WaitForCompletedWorkImpl(uint64_t timeoutNanoseconds) override;
+
         void ShutDownImpl() override;
         MaybeError WaitForIdleForDestruction() override;
 
@@ -178,6 +213,11 @@ namespace dawn_native { namespace d3d12 {
         ComPtr<ID3D11On12Device> mD3d11On12Device;
         ComPtr<ID3D11DeviceContext2> mD3d11On12DeviceContext;
 
+        // The pipeline library requires the blob it was created from to stay alive for the
+        // library's lifetime, so keep the loaded data next to it.
+        ComPtr<ID3D12PipelineLibrary> mPipelineLibrary;
+        std::vector<uint8_t> mPipelineLibraryBlob;
+
         ComPtr<ID3D12CommandSignature> mDispatchIndirectSignature;
         ComPtr<ID3D12CommandSignature> mDrawIndirectSignature;
         ComPtr<ID3D12CommandSignature> mDrawIndexedIndirectSignature;
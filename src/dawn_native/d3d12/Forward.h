@@ -28,6 +28,7 @@ namespace dawn_native { namespace d3d12 {
     class Device;
     class Heap;
     class PipelineLayout;
+    class QuerySet;
     class Queue;
     class RayTracingAccelerationContainer;
     class RayTracingShaderBindingTable;
@@ -49,6 +50,7 @@ namespace dawn_native { namespace d3d12 {
         using ComputePipelineType = ComputePipeline;
         using DeviceType = Device;
         using PipelineLayoutType = PipelineLayout;
+        using QuerySetType = QuerySet;
         using QueueType = Queue;
         using RayTracingAccelerationContainerType = RayTracingAccelerationContainer;
         using RayTracingPipelineType = RayTracingPipeline;
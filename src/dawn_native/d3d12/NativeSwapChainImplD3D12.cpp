@@ -18,6 +18,8 @@
 #include "dawn_native/d3d12/DeviceD3D12.h"
 #include "dawn_native/d3d12/TextureD3D12.h"
 
+#include <algorithm>
+
 namespace dawn_native { namespace d3d12 {
 
     namespace {
@@ -39,10 +41,20 @@ namespace dawn_native { namespace d3d12 {
     }  // anonymous namespace
 
     NativeSwapChainImpl::NativeSwapChainImpl(Device* device, HWND window)
-        : mWindow(window), mDevice(device), mInterval(1) {
+        : NativeSwapChainImpl(device, window, SwapChainLatencyDescriptor()) {
+    }
+
+    NativeSwapChainImpl::NativeSwapChainImpl(Device* device,
+                                             HWND window,
+                                             const SwapChainLatencyDescriptor& latencyDescriptor)
+        : mWindow(window), mDevice(device), mInterval(1), mLatencyDescriptor(latencyDescriptor) {
     }
 
     NativeSwapChainImpl::~NativeSwapChainImpl() {
+        if (mFrameLatencyWaitableObject != nullptr) {
+            CloseHandle(mFrameLatencyWaitableObject);
+            mFrameLatencyWaitableObject = nullptr;
+        }
     }
 
     void NativeSwapChainImpl::Init(DawnWSIContextD3D12* /*context*/) {
@@ -59,18 +71,32 @@ namespace dawn_native { namespace d3d12 {
         ComPtr<IDXGIFactory4> factory = mDevice->GetFactory();
         ComPtr<ID3D12CommandQueue> queue = mDevice->GetCommandQueue();
 
-        mInterval = mDevice->IsToggleEnabled(Toggle::TurnOffVsync) == true ? 0 : 1;
+        // FIFO presents one frame per vblank; mailbox and immediate present without waiting
+        // for one. DXGI's flip model doesn't tear with interval 0, giving mailbox semantics.
+        mInterval = mLatencyDescriptor.presentMode == PresentMode::Fifo ? 1 : 0;
+        if (mDevice->IsToggleEnabled(Toggle::TurnOffVsync)) {
+            mInterval = 0;
+        }
+
+        // Flip-model swapchains need at least two buffers; one more buffer than the frame
+        // latency lets DXGI present one while the application renders ahead.
+        uint32_t bufferCount = kFrameCount;
+        UINT swapChainFlags = 0;
+        if (mLatencyDescriptor.maximumFrameLatency != 0) {
+            bufferCount = std::max(mLatencyDescriptor.maximumFrameLatency + 1, 2u);
+            swapChainFlags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+        }
 
-        // Create the D3D12 swapchain, assuming only two buffers for now
         DXGI_SWAP_CHAIN_DESC1 swapChainDesc = {};
         swapChainDesc.Width = width;
         swapChainDesc.Height = height;
         swapChainDesc.Format = D3D12TextureFormat(GetPreferredFormat());
         swapChainDesc.BufferUsage = D3D12SwapChainBufferUsage(usage);
-        swapChainDesc.BufferCount = kFrameCount;
+        swapChainDesc.BufferCount = bufferCount;
         swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
         swapChainDesc.SampleDesc.Count = 1;
         swapChainDesc.SampleDesc.Quality = 0;
+        swapChainDesc.Flags = swapChainFlags;
 
         ComPtr<IDXGISwapChain1> swapChain1;
         ASSERT_SUCCESS(factory->CreateSwapChainForHwnd(queue.Get(), mWindow, &swapChainDesc,
@@ -78,15 +104,24 @@ namespace dawn_native { namespace d3d12 {
 
         ASSERT_SUCCESS(swapChain1.As(&mSwapChain));
 
+        if (mLatencyDescriptor.maximumFrameLatency != 0) {
+            ASSERT_SUCCESS(
+                mSwapChain->SetMaximumFrameLatency(mLatencyDescriptor.maximumFrameLatency));
+            if (mFrameLatencyWaitableObject != nullptr) {
+                CloseHandle(mFrameLatencyWaitableObject);
+            }
+            mFrameLatencyWaitableObject = mSwapChain->GetFrameLatencyWaitableObject();
+        }
+
         // Gather the resources that will be used to present to the swapchain
-        mBuffers.resize(kFrameCount);
-        for (uint32_t i = 0; i < kFrameCount; ++i) {
+        mBuffers.resize(bufferCount);
+        for (uint32_t i = 0; i < bufferCount; ++i) {
             ASSERT_SUCCESS(mSwapChain->GetBuffer(i, IID_PPV_ARGS(&mBuffers[i])));
         }
 
         // Set the initial serial of buffers to 0 so that we don't wait on them when they are first
         // used
-        mBufferSerials.resize(kFrameCount, 0);
+        mBufferSerials.resize(bufferCount, 0);
 
         return DAWN_SWAP_CHAIN_NO_ERROR;
     }
@@ -117,4 +152,8 @@ namespace dawn_native { namespace d3d12 {
         return wgpu::TextureFormat::RGBA8Unorm;
     }
 
+    HANDLE NativeSwapChainImpl::GetFrameLatencyWaitableObject() const {
+        return mFrameLatencyWaitableObject;
+    }
+
 }}  // namespace dawn_native::d3d12
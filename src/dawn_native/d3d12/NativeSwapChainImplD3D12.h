@@ -18,6 +18,7 @@
 #include "dawn_native/d3d12/d3d12_platform.h"
 
 #include "dawn/dawn_wsi.h"
+#include "dawn_native/DawnNative.h"
 #include "dawn_native/dawn_platform.h"
 
 #include <vector>
@@ -31,6 +32,9 @@ namespace dawn_native { namespace d3d12 {
         using WSIContext = DawnWSIContextD3D12;
 
         NativeSwapChainImpl(Device* device, HWND window);
+        NativeSwapChainImpl(Device* device,
+                            HWND window,
+                            const SwapChainLatencyDescriptor& latencyDescriptor);
         ~NativeSwapChainImpl();
 
         void Init(DawnWSIContextD3D12* context);
@@ -43,11 +47,17 @@ namespace dawn_native { namespace d3d12 {
 
         wgpu::TextureFormat GetPreferredFormat() const;
 
+        // Null unless a maximumFrameLatency was requested and Configure has run.
+        HANDLE GetFrameLatencyWaitableObject() const;
+
       private:
         HWND mWindow = nullptr;
         Device* mDevice = nullptr;
         UINT mInterval;
 
+        SwapChainLatencyDescriptor mLatencyDescriptor;
+        HANDLE mFrameLatencyWaitableObject = nullptr;
+
         ComPtr<IDXGISwapChain3> mSwapChain = nullptr;
         std::vector<ComPtr<ID3D12Resource>> mBuffers;
         std::vector<uint64_t> mBufferSerials;
@@ -70,7 +70,7 @@ namespace dawn_native { namespace d3d12 {
 
     MaybeError PipelineLayout::Initialize() {
         Device* device = ToBackend(GetDevice());
-        D3D12_ROOT_PARAMETER rootParameters[kMaxBindGroups * 2 + kMaxDynamicBufferCount];
+        D3D12_ROOT_PARAMETER rootParameters[kMaxBindGroups * 2 + kMaxDynamicBufferCount + 1];
 
         // A root parameter is one of these types
         union {
@@ -156,6 +156,19 @@ namespace dawn_native { namespace d3d12 {
             }
         }
 
+        // The immediate data lives in a root constants parameter placed last so the indices
+        // computed above are unaffected. It uses a register space past the ones used for bind
+        // groups to not collide with their shader registers.
+        if (device->IsExtensionEnabled(Extension::ImmediateData)) {
+            D3D12_ROOT_PARAMETER* rootParameter = &rootParameters[parameterIndex];
+            rootParameter->ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+            rootParameter->Constants.ShaderRegister = 0;
+            rootParameter->Constants.RegisterSpace = kMaxBindGroups;
+            rootParameter->Constants.Num32BitValues = kMaxImmediateDataBytes / 4;
+            rootParameter->ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+            mImmediateDataRootParameterIndex = parameterIndex++;
+        }
+
         D3D12_ROOT_SIGNATURE_DESC rootSignatureDescriptor;
         rootSignatureDescriptor.NumParameters = parameterIndex;
         rootSignatureDescriptor.pParameters = rootParameters;
@@ -198,4 +211,9 @@ namespace dawn_native { namespace d3d12 {
         ASSERT(GetBindGroupLayout(group)->GetBindingInfo(bindingIndex).hasDynamicOffset);
         return mDynamicRootParameterIndices[group][bindingIndex];
     }
+
+    uint32_t PipelineLayout::GetImmediateDataRootParameterIndex() const {
+        ASSERT(GetDevice()->IsExtensionEnabled(Extension::ImmediateData));
+        return mImmediateDataRootParameterIndex;
+    }
 }}  // namespace dawn_native::d3d12
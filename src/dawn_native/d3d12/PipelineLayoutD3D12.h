@@ -34,6 +34,10 @@ namespace dawn_native { namespace d3d12 {
         // Returns the index of the root parameter reserved for a dynamic buffer binding
         uint32_t GetDynamicRootParameterIndex(uint32_t group, BindingIndex bindingIndex) const;
 
+        // Returns the index of the root constants parameter holding the immediate data. Only
+        // valid when the immediate_data extension is enabled on the device.
+        uint32_t GetImmediateDataRootParameterIndex() const;
+
         ID3D12RootSignature* GetRootSignature() const;
 
       private:
@@ -44,6 +48,7 @@ namespace dawn_native { namespace d3d12 {
         std::array<uint32_t, kMaxBindGroups> mSamplerRootParameterInfo;
         std::array<std::array<uint32_t, kMaxBindingsPerGroup>, kMaxBindGroups>
             mDynamicRootParameterIndices;
+        uint32_t mImmediateDataRootParameterIndex = 0;
         ComPtr<ID3D12RootSignature> mRootSignature;
     };
 
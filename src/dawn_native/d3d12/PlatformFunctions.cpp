@@ -91,7 +91,8 @@ namespace dawn_native { namespace d3d12 {
     MaybeError PlatformFunctions::LoadFXCompiler() {
         std::string error;
         if (!mFXCompilerLib.Open("d3dcompiler_47.dll", &error) ||
-            !mFXCompilerLib.GetProc(&d3dCompile, "D3DCompile", &error)) {
+            !mFXCompilerLib.GetProc(&d3dCompile, "D3DCompile", &error) ||
+            !mFXCompilerLib.GetProc(&d3dCreateBlob, "D3DCreateBlob", &error)) {
             return DAWN_INTERNAL_ERROR(error.c_str());
         }
 
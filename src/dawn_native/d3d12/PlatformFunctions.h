@@ -68,6 +68,9 @@ namespace dawn_native { namespace d3d12 {
         // Functions from d3d3compiler.dll
         pD3DCompile d3dCompile = nullptr;
 
+        using PFN_D3D_CREATE_BLOB = HRESULT(WINAPI*)(SIZE_T size, ID3DBlob** ppBlob);
+        PFN_D3D_CREATE_BLOB d3dCreateBlob = nullptr;
+
         // Functions from WinPixEventRuntime.dll
         using PFN_PIX_END_EVENT_ON_COMMAND_LIST =
             HRESULT(WINAPI*)(ID3D12GraphicsCommandList* commandList);
@@ -0,0 +1,101 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/d3d12/QuerySetD3D12.h"
+
+#include "dawn_native/d3d12/D3D12Error.h"
+#include "dawn_native/d3d12/DeviceD3D12.h"
+
+namespace dawn_native { namespace d3d12 {
+
+    namespace {
+
+        D3D12_QUERY_HEAP_TYPE D3D12QueryHeapType(wgpu::QueryType type) {
+            switch (type) {
+                case wgpu::QueryType::Occlusion:
+                    return D3D12_QUERY_HEAP_TYPE_OCCLUSION;
+                case wgpu::QueryType::PipelineStatistics:
+                    return D3D12_QUERY_HEAP_TYPE_PIPELINE_STATISTICS;
+                case wgpu::QueryType::Timestamp:
+                    return D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+                default:
+                    UNREACHABLE();
+            }
+        }
+
+    }  // anonymous namespace
+
+    // static
+    ResultOrError<QuerySet*> QuerySet::Create(Device* device,
+                                              const QuerySetDescriptor* descriptor) {
+        Ref<QuerySet> querySet = AcquireRef(new QuerySet(device, descriptor));
+        DAWN_TRY(querySet->Initialize());
+        return querySet.Detach();
+    }
+
+    MaybeError QuerySet::Initialize() {
+        Device* device = ToBackend(GetDevice());
+
+        D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
+        queryHeapDesc.Type = D3D12QueryHeapType(GetQueryType());
+        queryHeapDesc.Count = GetQueryCount();
+
+        DAWN_TRY(CheckHRESULT(
+            device->GetD3D12Device()->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&mQueryHeap)),
+            "ID3D12Device::CreateQueryHeap"));
+
+        if (GetQueryType() == wgpu::QueryType::PipelineStatistics) {
+            D3D12_RESOURCE_DESC resourceDesc;
+            resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+            resourceDesc.Alignment = 0;
+            resourceDesc.Width = GetQueryCount() * sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS);
+            resourceDesc.Height = 1;
+            resourceDesc.DepthOrArraySize = 1;
+            resourceDesc.MipLevels = 1;
+            resourceDesc.Format = DXGI_FORMAT_UNKNOWN;
+            resourceDesc.SampleDesc.Count = 1;
+            resourceDesc.SampleDesc.Quality = 0;
+            resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+            resourceDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+            DAWN_TRY_ASSIGN(mResolveScratchResource,
+                            device->AllocateMemory(D3D12_HEAP_TYPE_DEFAULT, resourceDesc,
+                                                   D3D12_RESOURCE_STATE_COPY_DEST,
+                                                   AllocationClass::Buffer));
+        }
+
+        return {};
+    }
+
+    QuerySet::~QuerySet() {
+        DestroyInternal();
+    }
+
+    ID3D12QueryHeap* QuerySet::GetQueryHeap() const {
+        return mQueryHeap.Get();
+    }
+
+    ComPtr<ID3D12Resource> QuerySet::GetResolveScratchResource() const {
+        return mResolveScratchResource.GetD3D12Resource();
+    }
+
+    void QuerySet::DestroyImpl() {
+        ToBackend(GetDevice())->ReferenceUntilUnused(mQueryHeap);
+        mQueryHeap = nullptr;
+        if (mResolveScratchResource.GetD3D12Resource() != nullptr) {
+            ToBackend(GetDevice())->DeallocateMemory(mResolveScratchResource);
+        }
+    }
+
+}}  // namespace dawn_native::d3d12
@@ -0,0 +1,51 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_D3D12_QUERYSETD3D12_H_
+#define DAWNNATIVE_D3D12_QUERYSETD3D12_H_
+
+#include "dawn_native/QuerySet.h"
+#include "dawn_native/d3d12/ResourceHeapAllocationD3D12.h"
+#include "dawn_native/d3d12/d3d12_platform.h"
+
+namespace dawn_native { namespace d3d12 {
+
+    class Device;
+
+    class QuerySet final : public QuerySetBase {
+      public:
+        static ResultOrError<QuerySet*> Create(Device* device,
+                                               const QuerySetDescriptor* descriptor);
+
+        ID3D12QueryHeap* GetQueryHeap() const;
+        ComPtr<ID3D12Resource> GetResolveScratchResource() const;
+
+      private:
+        using QuerySetBase::QuerySetBase;
+        ~QuerySet() override;
+
+        MaybeError Initialize();
+
+        void DestroyImpl() override;
+
+        ComPtr<ID3D12QueryHeap> mQueryHeap;
+
+        // Pipeline statistics queries resolve to the full D3D12 statistics struct. This scratch
+        // buffer holds the resolved data until the requested statistics are copied out of it.
+        ResourceHeapAllocation mResolveScratchResource;
+    };
+
+}}  // namespace dawn_native::d3d12
+
+#endif  // DAWNNATIVE_D3D12_QUERYSETD3D12_H_
@@ -16,6 +16,7 @@
 
 #include "common/Assert.h"
 #include "common/Math.h"
+#include "dawn_native/d3d12/CommandRecordingContext.h"
 #include "dawn_native/d3d12/D3D12Error.h"
 #include "dawn_native/d3d12/DeviceD3D12.h"
 #include "dawn_native/d3d12/HeapD3D12.h"
@@ -80,11 +81,17 @@ namespace dawn_native { namespace d3d12 {
         }
         if (mInstanceMemory.buffer != nullptr) {
             Buffer* buffer = mInstanceMemory.allocation.Get();
-            if (buffer != nullptr) {
+            // application-owned instance buffers are only unreferenced, not destroyed
+            if (buffer != nullptr && GetExternalInstanceBuffer() == nullptr) {
                 buffer->Destroy();
             }
+            mInstanceMemory.allocation = nullptr;
             mInstanceMemory.buffer = nullptr;
         }
+        for (Ref<Buffer>& buffer : mStagedBuffers) {
+            buffer->Destroy();
+        }
+        mStagedBuffers.clear();
     }
 
     MaybeError RayTracingAccelerationContainer::Initialize(
@@ -102,8 +109,11 @@ namespace dawn_native { namespace d3d12 {
                 geometryDesc.Flags = ToD3D12RayTracingGeometryFlags(geometry.usage);
 
                 // vertex buffer
-                if (geometry.vertex != nullptr && geometry.vertex->buffer != nullptr) {
-                    Buffer* vertexBuffer = ToBackend(geometry.vertex->buffer);
+                if (geometry.vertex != nullptr) {
+                    Buffer* vertexBuffer =
+                        geometry.vertex->buffer != nullptr
+                            ? ToBackend(geometry.vertex->buffer)
+                            : StageGeometryData(geometry.vertex->data, geometry.vertex->dataSize);
                     geometryDesc.Triangles.VertexBuffer.StartAddress =
                         vertexBuffer->GetD3D12Resource()->GetGPUVirtualAddress() +
                         geometry.vertex->offset;
@@ -114,8 +124,11 @@ namespace dawn_native { namespace d3d12 {
                         ToD3D12RayTracingAccelerationContainerVertexFormat(geometry.vertex->format);
                 }
                 // index buffer
-                if (geometry.index != nullptr && geometry.index->buffer != nullptr) {
-                    Buffer* indexBuffer = ToBackend(geometry.index->buffer);
+                if (geometry.index != nullptr) {
+                    Buffer* indexBuffer =
+                        geometry.index->buffer != nullptr
+                            ? ToBackend(geometry.index->buffer)
+                            : StageGeometryData(geometry.index->data, geometry.index->dataSize);
                     geometryDesc.Triangles.IndexBuffer =
                         indexBuffer->GetD3D12Resource()->GetGPUVirtualAddress() +
                         geometry.index->offset;
@@ -124,8 +137,11 @@ namespace dawn_native { namespace d3d12 {
                         ToD3D12RayTracingAccelerationContainerIndexFormat(geometry.index->format);
                 }
                 // aabb buffer
-                if (geometry.aabb != nullptr && geometry.aabb->buffer != nullptr) {
-                    Buffer* aabbBuffer = ToBackend(geometry.aabb->buffer);
+                if (geometry.aabb != nullptr) {
+                    Buffer* aabbBuffer =
+                        geometry.aabb->buffer != nullptr
+                            ? ToBackend(geometry.aabb->buffer)
+                            : StageGeometryData(geometry.aabb->data, geometry.aabb->dataSize);
                     geometryDesc.AABBs.AABBs.StartAddress =
                         aabbBuffer->GetD3D12Resource()->GetGPUVirtualAddress() +
                         geometry.aabb->offset;
@@ -138,7 +154,8 @@ namespace dawn_native { namespace d3d12 {
         }
 
         // acceleration container holds instances
-        if (descriptor->level == wgpu::RayTracingAccelerationContainerLevel::Top) {
+        if (descriptor->level == wgpu::RayTracingAccelerationContainerLevel::Top &&
+            descriptor->instances != nullptr) {
             mInstances.reserve(descriptor->instanceCount);
             // create data for instance buffer
             for (unsigned int ii = 0; ii < descriptor->instanceCount; ++ii) {
@@ -152,18 +169,28 @@ namespace dawn_native { namespace d3d12 {
 
         // container requires instance buffer
         if (descriptor->level == wgpu::RayTracingAccelerationContainerLevel::Top) {
-            uint64_t bufferSize =
-                descriptor->instanceCount * sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
-
-            BufferDescriptor descriptor = {nullptr, nullptr, wgpu::BufferUsage::CopyDst,
-                                           bufferSize};
-            Buffer* buffer = ToBackend(device->CreateBuffer(&descriptor));
-            mInstanceMemory.allocation = AcquireRef(buffer);
-            mInstanceMemory.buffer = buffer->GetD3D12Resource();
-            mInstanceMemory.address = mInstanceMemory.buffer.Get()->GetGPUVirtualAddress();
-
-            // copy instance data into instance buffer
-            buffer->SetSubData(0, bufferSize, mInstances.data());
+            if (descriptor->instanceBuffer != nullptr) {
+                // the instance array lives in an application-owned buffer that the GPU
+                // fills, so builds consume it in place instead of staging through an
+                // internal copy
+                Buffer* buffer = ToBackend(descriptor->instanceBuffer);
+                mInstanceMemory.allocation = buffer;
+                mInstanceMemory.buffer = buffer->GetD3D12Resource();
+                mInstanceMemory.address = mInstanceMemory.buffer.Get()->GetGPUVirtualAddress();
+            } else {
+                uint64_t bufferSize =
+                    descriptor->instanceCount * sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
+
+                BufferDescriptor bufDescriptor = {nullptr, nullptr, wgpu::BufferUsage::CopyDst,
+                                                  bufferSize};
+                Buffer* buffer = ToBackend(device->CreateBuffer(&bufDescriptor));
+                mInstanceMemory.allocation = AcquireRef(buffer);
+                mInstanceMemory.buffer = buffer->GetD3D12Resource();
+                mInstanceMemory.address = mInstanceMemory.buffer.Get()->GetGPUVirtualAddress();
+
+                // copy instance data into instance buffer
+                buffer->SetSubData(0, bufferSize, mInstances.data());
+            }
         }
 
         // reserve scratch memory
@@ -176,7 +203,7 @@ namespace dawn_native { namespace d3d12 {
                 mBuildInformation.NumDescs = mGeometries.size();
                 mBuildInformation.pGeometryDescs = mGeometries.data();
             } else if (descriptor->level == wgpu::RayTracingAccelerationContainerLevel::Top) {
-                mBuildInformation.NumDescs = mInstances.size();
+                mBuildInformation.NumDescs = descriptor->instanceCount;
                 mBuildInformation.InstanceDescs = mInstanceMemory.buffer->GetGPUVirtualAddress();
             }
             D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO prebuildInfo = {};
@@ -196,22 +223,47 @@ namespace dawn_native { namespace d3d12 {
 
             // allocate memory
             DAWN_TRY(AllocateScratchMemory(mScratchMemory.result, resultMemorySize,
-                                           D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE));
+                                           D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE,
+                                           AllocationClass::AccelerationContainerResult));
             DAWN_TRY(AllocateScratchMemory(mScratchMemory.build, buildMemorySize,
-                                           D3D12_RESOURCE_STATE_UNORDERED_ACCESS));
+                                           D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                                           AllocationClass::AccelerationContainerScratch));
             if (prebuildInfo.UpdateScratchDataSizeInBytes > 0) {
                 DAWN_TRY(AllocateScratchMemory(mScratchMemory.update, updateMemorySize,
-                                               D3D12_RESOURCE_STATE_UNORDERED_ACCESS));
+                                               D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                                               AllocationClass::AccelerationContainerScratch));
             }
+
+            SetMemoryUsage(resultMemorySize, buildMemorySize,
+                           prebuildInfo.UpdateScratchDataSizeInBytes > 0 ? updateMemorySize : 0);
         }
 
         return {};
     }
 
+    Buffer* RayTracingAccelerationContainer::StageGeometryData(const uint8_t* data,
+                                                               uint32_t dataSize) {
+        Device* device = ToBackend(GetDevice());
+
+        // create an internal buffer for the staged data so the streamer does not have to
+        // allocate one per mesh; the data travels through the dynamic uploader's ring and
+        // is copied over before the build command executes
+        BufferDescriptor bufDescriptor = {
+            nullptr, nullptr, wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::RayTracing,
+            dataSize};
+        Buffer* buffer = ToBackend(device->CreateBuffer(&bufDescriptor));
+        mStagedBuffers.push_back(AcquireRef(buffer));
+
+        buffer->SetSubData(0, dataSize, data);
+
+        return buffer;
+    }
+
     MaybeError RayTracingAccelerationContainer::AllocateScratchMemory(
         MemoryEntry& memoryEntry,
         uint64_t size,
-        D3D12_RESOURCE_STATES initialUsage) {
+        D3D12_RESOURCE_STATES initialUsage,
+        AllocationClass allocationClass) {
         Device* device = ToBackend(GetDevice());
 
         D3D12_RESOURCE_DESC resourceDesc;
@@ -227,19 +279,69 @@ namespace dawn_native { namespace d3d12 {
         resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
         resourceDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
 
-        DAWN_TRY_ASSIGN(memoryEntry.resource, device->AllocateMemory(D3D12_HEAP_TYPE_DEFAULT,
-                                                                     resourceDesc, initialUsage));
+        DAWN_TRY_ASSIGN(memoryEntry.resource,
+                        device->AllocateMemory(D3D12_HEAP_TYPE_DEFAULT, resourceDesc, initialUsage,
+                                               allocationClass));
 
         memoryEntry.buffer = memoryEntry.resource.GetD3D12Resource();
         memoryEntry.address = memoryEntry.buffer.Get()->GetGPUVirtualAddress();
 
+        // Hint the OS that acceleration structure memory may be demoted before normal-priority
+        // resources when the budget is oversubscribed, so cold containers page out before the
+        // textures the current view needs. Only direct allocations own their heap exclusively,
+        // so only those can be re-prioritized safely.
+        if (memoryEntry.resource.GetInfo().mMethod == AllocationMethod::kDirect) {
+            ComPtr<ID3D12Device1> d3d12Device1;
+            if (SUCCEEDED(device->GetD3D12Device()->QueryInterface(IID_PPV_ARGS(&d3d12Device1)))) {
+                ID3D12Pageable* pageable =
+                    ToBackend(memoryEntry.resource.GetResourceHeap())->GetD3D12Pageable();
+                D3D12_RESIDENCY_PRIORITY priority = D3D12_RESIDENCY_PRIORITY_LOW;
+                d3d12Device1->SetResidencyPriority(1, &pageable, &priority);
+            }
+        }
+
         return {};
     }
 
+    void RayTracingAccelerationContainer::TrackHeapsUsage(
+        CommandRecordingContext* commandContext) {
+        Serial pendingSerial = GetDevice()->GetPendingCommandSerial();
+
+        if (mScratchMemory.result.buffer != nullptr) {
+            commandContext->TrackHeapUsage(
+                ToBackend(mScratchMemory.result.resource.GetResourceHeap()), pendingSerial);
+        }
+        if (mScratchMemory.build.buffer != nullptr) {
+            commandContext->TrackHeapUsage(
+                ToBackend(mScratchMemory.build.resource.GetResourceHeap()), pendingSerial);
+        }
+        if (mScratchMemory.update.buffer != nullptr) {
+            commandContext->TrackHeapUsage(
+                ToBackend(mScratchMemory.update.resource.GetResourceHeap()), pendingSerial);
+        }
+        // The instance buffer of top-level containers is read while builds execute.
+        if (mInstanceMemory.allocation.Get() != nullptr) {
+            // application-owned instance buffers have RAY_TRACING usage while the
+            // internal staging buffer only has COPY_DST
+            wgpu::BufferUsage usage = GetExternalInstanceBuffer() != nullptr
+                                          ? wgpu::BufferUsage::RayTracing
+                                          : wgpu::BufferUsage::CopyDst;
+            mInstanceMemory.allocation->TrackUsageAndTransitionNow(commandContext, usage);
+        }
+        // So are the internal buffers holding staged geometry data.
+        for (Ref<Buffer>& buffer : mStagedBuffers) {
+            buffer->TrackUsageAndTransitionNow(commandContext, wgpu::BufferUsage::RayTracing);
+        }
+    }
+
     ScratchMemoryPool& RayTracingAccelerationContainer::GetScratchMemory() {
         return mScratchMemory;
     }
 
+    MemoryEntry& RayTracingAccelerationContainer::GetInstanceMemory() {
+        return mInstanceMemory;
+    }
+
     D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS&
     RayTracingAccelerationContainer::GetBuildInformation() {
         return mBuildInformation;
@@ -258,15 +360,47 @@ namespace dawn_native { namespace d3d12 {
         }
     }
 
-    MaybeError RayTracingAccelerationContainer::UpdateInstanceImpl(
-        uint32_t instanceIndex,
-        const RayTracingAccelerationInstanceDescriptor* descriptor) {
-        uint32_t start = instanceIndex * sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
-        uint32_t count = sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
-        D3D12_RAYTRACING_INSTANCE_DESC instanceData = GetD3D12AccelerationInstance(*descriptor);
-        mInstanceMemory.allocation.Get()->SetSubData(start, count,
-                                                     reinterpret_cast<void*>(&instanceData));
+    MaybeError RayTracingAccelerationContainer::UpdateInstancesImpl(
+        uint32_t startInstance,
+        uint32_t instanceCount,
+        const RayTracingAccelerationInstanceDescriptor* descriptors) {
+        // only write the shadow copy; the base class tracks the touched blocks and the
+        // upload happens in FlushInstanceUpdates once the data is actually consumed
+        for (uint32_t ii = 0; ii < instanceCount; ++ii) {
+            mInstances[startInstance + ii] = GetD3D12AccelerationInstance(descriptors[ii]);
+        }
         return {};
     }
 
+    MaybeError RayTracingAccelerationContainer::UpdateInstanceTransformsImpl(
+        uint32_t startInstance,
+        uint32_t instanceCount,
+        const float* transforms) {
+        // The transform lies at the start of D3D12_RAYTRACING_INSTANCE_DESC, so all the
+        // matrices convert in one strided pass over the shadow copy.
+        static_assert(offsetof(D3D12_RAYTRACING_INSTANCE_DESC, Transform) == 0, "");
+        ConvertColumnMajor4x4ToRowMajor4x3(&mInstances[startInstance],
+                                           sizeof(D3D12_RAYTRACING_INSTANCE_DESC), transforms,
+                                           instanceCount);
+        return {};
+    }
+
+    MaybeError RayTracingAccelerationContainer::NeutralizeInstancesImpl(uint32_t startInstance,
+                                                                        uint32_t instanceCount) {
+        // A zeroed instance has a zero mask and a null acceleration structure address, so
+        // it can never be intersected once the shadow copy is uploaded.
+        memset(&mInstances[startInstance], 0,
+               instanceCount * sizeof(D3D12_RAYTRACING_INSTANCE_DESC));
+        return {};
+    }
+
+    void RayTracingAccelerationContainer::FlushInstanceUpdates() {
+        ConsumeDirtyInstanceRanges([this](uint32_t firstInstance, uint32_t instanceCount) {
+            mInstanceMemory.allocation.Get()->SetSubData(
+                firstInstance * sizeof(D3D12_RAYTRACING_INSTANCE_DESC),
+                instanceCount * sizeof(D3D12_RAYTRACING_INSTANCE_DESC),
+                reinterpret_cast<void*>(&mInstances[firstInstance]));
+        });
+    }
+
 }}  // namespace dawn_native::d3d12
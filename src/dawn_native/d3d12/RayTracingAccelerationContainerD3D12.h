@@ -22,6 +22,7 @@
 
 namespace dawn_native { namespace d3d12 {
 
+    class CommandRecordingContext;
     class Device;
 
     struct SBTEntry {
@@ -36,7 +37,7 @@ namespace dawn_native { namespace d3d12 {
         MemoryEntry build;
     };
 
-    class RayTracingAccelerationContainer : public RayTracingAccelerationContainerBase {
+    class RayTracingAccelerationContainer final : public RayTracingAccelerationContainerBase {
       public:
         static ResultOrError<RayTracingAccelerationContainer*> Create(
             Device* device,
@@ -46,26 +47,53 @@ namespace dawn_native { namespace d3d12 {
         ScratchMemoryPool& GetScratchMemory();
         D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS& GetBuildInformation();
 
+        MemoryEntry& GetInstanceMemory();
+
+        // Enrolls the heaps backing this container's memory in the residency LRU so they are
+        // made resident before the current command list executes and stay evictable afterwards.
+        void TrackHeapsUsage(CommandRecordingContext* commandContext);
+
+        // Uploads the dirty blocks of the instance shadow copy before a build or update
+        // command is recorded. Deferring the upload lets scattered per-frame instance
+        // updates of a large instance array pay only for the blocks they touched.
+        void FlushInstanceUpdates();
+
         void DestroyScratchBuildMemory();
 
       private:
         using RayTracingAccelerationContainerBase::RayTracingAccelerationContainerBase;
 
         void DestroyImpl() override;
-        MaybeError UpdateInstanceImpl(
-            uint32_t instanceIndex,
-            const RayTracingAccelerationInstanceDescriptor* descriptor) override;
+        MaybeError UpdateInstancesImpl(
+            uint32_t startInstance,
+            uint32_t instanceCount,
+            const RayTracingAccelerationInstanceDescriptor* descriptors) override;
+        MaybeError UpdateInstanceTransformsImpl(uint32_t startInstance,
+                                                uint32_t instanceCount,
+                                                const float* transforms) override;
+        MaybeError NeutralizeInstancesImpl(uint32_t startInstance,
+                                           uint32_t instanceCount) override;
 
         MaybeError AllocateScratchMemory(MemoryEntry& memoryEntry,
                                          uint64_t size,
-                                         D3D12_RESOURCE_STATES initialResourceState);
+                                         D3D12_RESOURCE_STATES initialResourceState,
+                                         AllocationClass allocationClass);
 
         // scratch memory
         ScratchMemoryPool mScratchMemory;
 
         MemoryEntry mInstanceMemory;
 
+        // internal buffers holding geometry data that was staged through the dynamic
+        // uploader instead of being provided in an external buffer
+        std::vector<Ref<Buffer>> mStagedBuffers;
+
+        Buffer* StageGeometryData(const uint8_t* data, uint32_t dataSize);
+
         std::vector<D3D12_RAYTRACING_GEOMETRY_DESC> mGeometries;
+
+        // instance updates are written into this shadow copy and the dirty spans tracked
+        // by the base class are uploaded once the next build or update command is recorded
         std::vector<D3D12_RAYTRACING_INSTANCE_DESC> mInstances;
 
         D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS mBuildInformation;
@@ -27,7 +27,7 @@ namespace dawn_native { namespace d3d12 {
 
     class Device;
 
-    class RayTracingPipeline : public RayTracingPipelineBase {
+    class RayTracingPipeline final : public RayTracingPipelineBase {
       public:
         static ResultOrError<RayTracingPipeline*> Create(
             Device* device,
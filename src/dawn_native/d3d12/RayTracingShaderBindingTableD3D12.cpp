@@ -14,6 +14,7 @@
 
 #include "dawn_native/d3d12/RayTracingShaderBindingTableD3D12.h"
 
+#include "common/Assert.h"
 #include "common/Math.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/d3d12/AdapterD3D12.h"
@@ -39,8 +40,12 @@ namespace dawn_native { namespace d3d12 {
 
     void RayTracingShaderBindingTable::DestroyImpl() {
         Device* device = ToBackend(GetDevice());
-        device->DeallocateMemory(mTableResource);
-        mTableBuffer = nullptr;
+        for (TableSlice& slice : mSlices) {
+            device->DeallocateMemory(slice.resource);
+            slice.buffer = nullptr;
+        }
+        mSlices.clear();
+        mCurrentSlice = 0;
     }
 
     MaybeError RayTracingShaderBindingTable::Initialize(
@@ -53,6 +58,11 @@ namespace dawn_native { namespace d3d12 {
             const RayTracingShaderBindingTableGroupDescriptor& group = descriptor->groups[ii];
             mGroups.push_back(group);
         }
+        // Each record initially points at the group with the same index.
+        mRecordGroupIndices.resize(mGroups.size());
+        for (uint32_t ii = 0; ii < mRecordGroupIndices.size(); ++ii) {
+            mRecordGroupIndices[ii] = ii;
+        }
         return {};
     }
 
@@ -65,7 +75,69 @@ namespace dawn_native { namespace d3d12 {
     }
 
     ID3D12Resource* RayTracingShaderBindingTable::GetTableBuffer() {
-        return mTableBuffer.Get();
+        ASSERT(!mSlices.empty());
+        // Called while recording a dispatch: the slice may not be rewritten until the
+        // commands of the pending submit complete.
+        TableSlice& slice = mSlices[mCurrentSlice];
+        slice.lastUsageSerial = GetDevice()->GetPendingCommandSerial();
+        return slice.buffer.Get();
+    }
+
+    MaybeError RayTracingShaderBindingTable::AcquireWritableSlice() {
+        Device* device = ToBackend(GetDevice());
+        Serial completedSerial = device->GetCompletedCommandSerial();
+
+        // Reuse a slice the GPU is done with before growing the storage. The current slice
+        // is preferred so back-to-back updates keep writing the same memory.
+        if (!mSlices.empty() && mSlices[mCurrentSlice].lastUsageSerial <= completedSerial) {
+            return {};
+        }
+        for (uint32_t ii = 0; ii < mSlices.size(); ++ii) {
+            if (mSlices[ii].lastUsageSerial <= completedSerial) {
+                mCurrentSlice = ii;
+                return {};
+            }
+        }
+
+        // Every slice is still in flight, add a new one.
+        D3D12_RESOURCE_DESC resourceDesc;
+        resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        resourceDesc.Alignment = 0;
+        resourceDesc.Width = mTableSize;
+        resourceDesc.Height = 1;
+        resourceDesc.DepthOrArraySize = 1;
+        resourceDesc.MipLevels = 1;
+        resourceDesc.Format = DXGI_FORMAT_UNKNOWN;
+        resourceDesc.SampleDesc.Count = 1;
+        resourceDesc.SampleDesc.Quality = 0;
+        resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+        resourceDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+        TableSlice slice;
+        DAWN_TRY_ASSIGN(slice.resource,
+                        device->AllocateMemory(D3D12_HEAP_TYPE_UPLOAD, resourceDesc,
+                                               D3D12_RESOURCE_STATE_GENERIC_READ,
+                                               AllocationClass::Buffer));
+        slice.buffer = slice.resource.GetD3D12Resource();
+        mSlices.push_back(std::move(slice));
+        mCurrentSlice = mSlices.size() - 1;
+        return {};
+    }
+
+    MaybeError RayTracingShaderBindingTable::WriteRecords(TableSlice* slice) {
+        uint8_t* pData;
+        DAWN_TRY(CheckHRESULT(slice->buffer->Map(0, nullptr, (void**)&pData), "Map SBT"));
+
+        // Records are laid out with an identifier-sized stride.
+        for (unsigned int ii = 0; ii < mGroups.size(); ++ii) {
+            memcpy(pData + ii * D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES,
+                   mGroupIdentifiers.data() +
+                       mRecordGroupIndices[ii] * D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES,
+                   D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES);
+        }
+
+        slice->buffer->Unmap(0, nullptr);
+        return {};
     }
 
     MaybeError RayTracingShaderBindingTable::Generate(RayTracingPipeline* pipeline,
@@ -101,39 +173,45 @@ namespace dawn_native { namespace d3d12 {
         hitSectionSize = Align(hitSectionSize, D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT);
         missSectionSize = Align(missSectionSize, D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT);
 
-        mTableSize = genSectionSize + hitSectionSize + missSectionSize;
-
-        D3D12_RESOURCE_DESC resourceDesc;
-        resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-        resourceDesc.Alignment = 0;
-        resourceDesc.Width = mTableSize;
-        resourceDesc.Height = 1;
-        resourceDesc.DepthOrArraySize = 1;
-        resourceDesc.MipLevels = 1;
-        resourceDesc.Format = DXGI_FORMAT_UNKNOWN;
-        resourceDesc.SampleDesc.Count = 1;
-        resourceDesc.SampleDesc.Quality = 0;
-        resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-        resourceDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+        uint32_t tableSize = genSectionSize + hitSectionSize + missSectionSize;
+        if (tableSize != mTableSize) {
+            // A regenerate with a different table size cannot reuse the old slices. The
+            // deallocations are deferred until the GPU is done with them.
+            for (TableSlice& slice : mSlices) {
+                device->DeallocateMemory(slice.resource);
+            }
+            mSlices.clear();
+            mCurrentSlice = 0;
+        }
+        mTableSize = tableSize;
 
-        DAWN_TRY_ASSIGN(mTableResource, device->AllocateMemory(D3D12_HEAP_TYPE_UPLOAD, resourceDesc,
-                                                               D3D12_RESOURCE_STATE_GENERIC_READ));
-        mTableBuffer = mTableResource.GetD3D12Resource();
+        // Keep a CPU copy of the identifiers so record updates don't need the pipeline.
+        mGroupIdentifiers.resize(mGroups.size() * D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES);
+        for (unsigned int ii = 0; ii < mGroups.size(); ++ii) {
+            memcpy(mGroupIdentifiers.data() + ii * D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES,
+                   pipeline->GetShaderIdentifier(ii), D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES);
+        }
 
-        // Map the SBT
-        uint8_t* pData;
-        DAWN_TRY(CheckHRESULT(mTableBuffer->Map(0, nullptr, (void**)&pData), "Map SBT"));
+        DAWN_TRY(AcquireWritableSlice());
+        return WriteRecords(&mSlices[mCurrentSlice]);
+    }
 
-        uint32_t offset = 0;
-        for (unsigned int ii = 0; ii < mGroups.size(); ++ii) {
-            memcpy(pData + offset, pipeline->GetShaderIdentifier(ii),
-                   D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES);
-            offset = Align(offset + mTableSize, D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT);
+    MaybeError RayTracingShaderBindingTable::UpdateGroupsImpl(uint32_t startGroup,
+                                                              uint32_t groupCount,
+                                                              const uint32_t* sourceGroupIndices) {
+        for (uint32_t ii = 0; ii < groupCount; ++ii) {
+            mRecordGroupIndices[startGroup + ii] = sourceGroupIndices[ii];
+        }
+        if (mGroupIdentifiers.empty()) {
+            // No pipeline generated the table yet; the records are written by Generate.
+            return {};
         }
 
-        // Unmap the SBT
-        mTableBuffer->Unmap(0, nullptr);
-        return {};
+        // The writable slice may be a different one than the last dispatch used, so all the
+        // records are rewritten from the CPU-side state. Tables are a few identifiers big,
+        // making the full rewrite cheaper than tracking partial slice contents.
+        DAWN_TRY(AcquireWritableSlice());
+        return WriteRecords(&mSlices[mCurrentSlice]);
     }
 
     std::vector<RayTracingShaderBindingTableStageDescriptor>&
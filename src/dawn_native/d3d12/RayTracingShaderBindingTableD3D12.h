@@ -17,6 +17,7 @@
 
 #include <vector>
 
+#include "common/Serial.h"
 #include "dawn_native/RayTracingShaderBindingTable.h"
 #include "dawn_native/d3d12/BufferD3D12.h"
 #include "dawn_native/d3d12/PipelineLayoutD3D12.h"
@@ -28,7 +29,7 @@ namespace dawn_native { namespace d3d12 {
 
     class Device;
 
-    class RayTracingShaderBindingTable : public RayTracingShaderBindingTableBase {
+    class RayTracingShaderBindingTable final : public RayTracingShaderBindingTableBase {
       public:
         static ResultOrError<RayTracingShaderBindingTable*> Create(
             Device* device,
@@ -49,11 +50,34 @@ namespace dawn_native { namespace d3d12 {
         std::vector<RayTracingShaderBindingTableStageDescriptor> mStages;
         std::vector<RayTracingShaderBindingTableGroupDescriptor> mGroups;
 
-        ResourceHeapAllocation mTableResource;
-        ComPtr<ID3D12Resource> mTableBuffer;
-        uint32_t mTableSize;
+        // Table storage is frame-versioned so record updates never write a buffer the GPU
+        // is still reading: writes go to a slice whose last usage serial has completed,
+        // and the slice list only grows when every slice is still in flight.
+        struct TableSlice {
+            ResourceHeapAllocation resource;
+            ComPtr<ID3D12Resource> buffer;
+            Serial lastUsageSerial = 0;
+        };
+
+        std::vector<TableSlice> mSlices;
+        uint32_t mCurrentSlice = 0;
+        uint32_t mTableSize = 0;
+
+        // Makes mCurrentSlice point at a slice the GPU is done with, allocating a new one
+        // when none has retired yet.
+        MaybeError AcquireWritableSlice();
+        // Writes every record of the table into |slice| from the CPU-side group state.
+        MaybeError WriteRecords(TableSlice* slice);
+
+        // Which group each table record points at, and a CPU copy of the shader identifiers
+        // so single records can be rewritten without regenerating the whole table.
+        std::vector<uint32_t> mRecordGroupIndices;
+        std::vector<uint8_t> mGroupIdentifiers;
 
         void DestroyImpl() override;
+        MaybeError UpdateGroupsImpl(uint32_t startGroup,
+                                    uint32_t groupCount,
+                                    const uint32_t* sourceGroupIndices) override;
 
         MaybeError Initialize(const RayTracingShaderBindingTableDescriptor* descriptor);
     };
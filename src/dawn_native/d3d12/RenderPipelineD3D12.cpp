@@ -15,6 +15,7 @@
 #include "dawn_native/d3d12/RenderPipelineD3D12.h"
 
 #include "common/Assert.h"
+#include "common/HashUtils.h"
 #include "common/Log.h"
 #include "dawn_native/d3d12/D3D12Error.h"
 #include "dawn_native/d3d12/DeviceD3D12.h"
@@ -397,9 +398,34 @@ namespace dawn_native { namespace d3d12 {
 
         mD3d12PrimitiveTopology = D3D12PrimitiveTopology(GetPrimitiveTopology());
 
+        // Try to load the pipeline from the device's pipeline library before compiling it.
+        // The name is a hash of the compiled shaders and key state; the library validates
+        // the stored descriptor on load so a collision only costs a cache miss.
+        ID3D12PipelineLibrary* pipelineLibrary = device->GetPipelineLibrary();
+        std::wstring pipelineName;
+        if (pipelineLibrary != nullptr) {
+            size_t hash = 0;
+            HashShaderBytecode(&hash, descriptorD3D12.VS);
+            HashShaderBytecode(&hash, descriptorD3D12.PS);
+            HashCombine(&hash, descriptorD3D12.PrimitiveTopologyType,
+                        descriptorD3D12.NumRenderTargets, descriptorD3D12.SampleDesc.Count,
+                        descriptorD3D12.DSVFormat);
+            pipelineName = std::to_wstring(hash);
+            if (SUCCEEDED(pipelineLibrary->LoadGraphicsPipeline(
+                    pipelineName.c_str(), &descriptorD3D12, IID_PPV_ARGS(&mPipelineState)))) {
+                return {};
+            }
+        }
+
         DAWN_TRY(CheckHRESULT(device->GetD3D12Device()->CreateGraphicsPipelineState(
                                   &descriptorD3D12, IID_PPV_ARGS(&mPipelineState)),
                               "D3D12 create graphics pipeline state"));
+
+        if (pipelineLibrary != nullptr) {
+            // Storing can fail when the name is already taken by a colliding pipeline;
+            // this only means the new pipeline isn't cached.
+            pipelineLibrary->StorePipeline(pipelineName.c_str(), mPipelineState.Get());
+        }
         return {};
     }
 
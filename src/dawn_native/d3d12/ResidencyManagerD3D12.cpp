@@ -27,6 +27,19 @@ namespace dawn_native { namespace d3d12 {
           mResidencyManagementEnabled(
               device->IsToggleEnabled(Toggle::UseD3D12ResidencyManagement)) {
         UpdateVideoMemoryInfo();
+
+        if (mResidencyManagementEnabled) {
+            // EnqueueMakeResident needs ID3D12Device3, which is not available on all
+            // Windows 10 platforms. When it is missing, MakeResidentAsync falls back to
+            // the synchronous path.
+            if (SUCCEEDED(
+                    mDevice->GetD3D12Device()->QueryInterface(IID_PPV_ARGS(&mD3d12Device3)))) {
+                if (FAILED(mDevice->GetD3D12Device()->CreateFence(
+                        0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&mMakeResidentFence)))) {
+                    mD3d12Device3 = nullptr;
+                }
+            }
+        }
     }
 
     // Increments number of locks on a heap to ensure the heap remains resident.
@@ -103,6 +116,21 @@ namespace dawn_native { namespace d3d12 {
         return segmentInfo->externalReservation;
     }
 
+    MemoryBudgetInfo ResidencyManager::QueryMemoryBudget() {
+        MemoryBudgetInfo info;
+        if (!mResidencyManagementEnabled) {
+            return info;
+        }
+
+        UpdateVideoMemoryInfo();
+
+        // Report the local segment: it is the one textures and buffers are allocated from
+        // (and on UMA adapters it covers all memory).
+        info.budget = mVideoMemoryInfo.local.budget;
+        info.usage = mVideoMemoryInfo.local.usage;
+        return info;
+    }
+
     void ResidencyManager::UpdateVideoMemoryInfo() {
         UpdateMemorySegmentInfo(&mVideoMemoryInfo.local);
         if (!mDevice->GetDeviceInfo().isUMA) {
@@ -294,6 +322,57 @@ namespace dawn_native { namespace d3d12 {
         return {};
     }
 
+    // Starts making a pageable resident ahead of its first use, typically on a hint from a
+    // streaming system that knows what the next frames need. The paging work overlaps with
+    // whatever the application does next; the command queue waits on the paging fence so a
+    // submit that uses the pageable never executes before its memory arrived.
+    MaybeError ResidencyManager::MakeResidentAsync(Pageable* pageable) {
+        if (!mResidencyManagementEnabled) {
+            return {};
+        }
+
+        // Locked pageables are always resident.
+        if (pageable->IsResidencyLocked()) {
+            return {};
+        }
+
+        if (pageable->IsInResidencyLRUCache()) {
+            // Already resident. Refresh the LRU position so the prefetched pageable isn't
+            // the next eviction candidate.
+            pageable->RemoveFromList();
+            pageable->SetLastSubmission(mDevice->GetPendingCommandSerial());
+            TrackResidentAllocation(pageable);
+            return {};
+        }
+
+        DAWN_TRY(EnsureCanMakeResident(pageable->GetSize(),
+                                       GetMemorySegmentInfo(pageable->GetMemorySegment())));
+
+        ID3D12Pageable* d3d12Pageable = pageable->GetD3D12Pageable();
+        if (mD3d12Device3 != nullptr) {
+            mLastMakeResidentFenceValue++;
+            DAWN_TRY(CheckHRESULT(
+                mD3d12Device3->EnqueueMakeResident(D3D12_RESIDENCY_FLAG_NONE, 1, &d3d12Pageable,
+                                                   mMakeResidentFence.Get(),
+                                                   mLastMakeResidentFenceValue),
+                "Enqueueing an asynchronous resident prefetch"));
+
+            // A GPU-side wait: only command lists submitted from here on are held back,
+            // and only until the paging queue signals completion.
+            DAWN_TRY(CheckHRESULT(mDevice->GetCommandQueue()->Wait(mMakeResidentFence.Get(),
+                                                                   mLastMakeResidentFenceValue),
+                                  "Waiting for a resident prefetch on the command queue"));
+        } else {
+            DAWN_TRY(CheckHRESULT(mDevice->GetD3D12Device()->MakeResident(1, &d3d12Pageable),
+                                  "Making a prefetched resource resident"));
+        }
+
+        pageable->SetLastSubmission(mDevice->GetPendingCommandSerial());
+        TrackResidentAllocation(pageable);
+
+        return {};
+    }
+
     // Inserts a heap at the bottom of the LRU. The passed heap must be resident or scheduled to
     // become resident within the current serial.
     void ResidencyManager::TrackResidentAllocation(Pageable* pageable) {
@@ -303,6 +382,9 @@ namespace dawn_native { namespace d3d12 {
 
         ASSERT(pageable->IsInList() == false);
         GetMemorySegmentInfo(pageable->GetMemorySegment())->lruCache.Append(pageable);
+
+        // A new resident allocation may have brought usage close to the adapter budget.
+        mDevice->CheckMemoryBudgetPressure();
     }
 
     // Places an artifical cap on Dawn's budget so we can test in a predictable manner. If used,
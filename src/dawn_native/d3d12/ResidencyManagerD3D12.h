@@ -39,9 +39,22 @@ namespace dawn_native { namespace d3d12 {
         MaybeError EnsureCanAllocate(uint64_t allocationSize, MemorySegment memorySegment);
         MaybeError EnsureHeapsAreResident(Heap** heaps, size_t heapCount);
 
+        // Starts paging in a pageable ahead of its first use so the first submit
+        // referencing it doesn't pay for a synchronous MakeResident. The residency
+        // operation is enqueued on the OS paging queue and the device's command queue
+        // waits on it, so submits stay correct even when the prefetch hasn't finished.
+        // Falls back to a synchronous MakeResident on platforms without
+        // ID3D12Device3::EnqueueMakeResident.
+        MaybeError MakeResidentAsync(Pageable* pageable);
+
         uint64_t SetExternalMemoryReservation(MemorySegment segment,
                                               uint64_t requestedReservationSize);
 
+        // Returns the OS-provided budget and current usage of the local memory segment,
+        // refreshed with QueryVideoMemoryInfo. Returns zeros when residency management is
+        // disabled.
+        MemoryBudgetInfo QueryMemoryBudget();
+
         void TrackResidentAllocation(Pageable* pageable);
 
         void RestrictBudgetForTesting(uint64_t artificialBudgetCap);
@@ -71,6 +84,12 @@ namespace dawn_native { namespace d3d12 {
         bool mResidencyManagementEnabled = false;
         bool mRestrictBudgetForTesting = false;
         VideoMemoryInfo mVideoMemoryInfo = {};
+
+        // Set when the platform supports EnqueueMakeResident; the fence is signaled by
+        // the OS paging queue as each asynchronous make-resident operation completes.
+        ComPtr<ID3D12Device3> mD3d12Device3;
+        ComPtr<ID3D12Fence> mMakeResidentFence;
+        uint64_t mLastMakeResidentFenceValue = 0;
     };
 
 }}  // namespace dawn_native::d3d12
@@ -168,23 +168,28 @@ namespace dawn_native { namespace d3d12 {
     ResultOrError<ResourceHeapAllocation> ResourceAllocatorManager::AllocateMemory(
         D3D12_HEAP_TYPE heapType,
         const D3D12_RESOURCE_DESC& resourceDescriptor,
-        D3D12_RESOURCE_STATES initialUsage) {
+        D3D12_RESOURCE_STATES initialUsage,
+        AllocationClass allocationClass) {
         // TODO(bryan.bernhart@intel.com): Conditionally disable sub-allocation.
         // For very large resources, there is no benefit to suballocate.
         // For very small resources, it is inefficent to suballocate given the min. heap
         // size could be much larger then the resource allocation.
         // Attempt to satisfy the request using sub-allocation (placed resource in a heap).
         ResourceHeapAllocation subAllocation;
-        DAWN_TRY_ASSIGN(subAllocation,
-                        CreatePlacedResource(heapType, resourceDescriptor, initialUsage));
+        DAWN_TRY_ASSIGN(subAllocation, CreatePlacedResource(heapType, resourceDescriptor,
+                                                            initialUsage, allocationClass));
         if (subAllocation.GetInfo().mMethod != AllocationMethod::kInvalid) {
+            mDevice->TrackMemoryAllocation(allocationClass, subAllocation.GetInfo().mSize);
             return std::move(subAllocation);
         }
 
         // If sub-allocation fails, fall-back to direct allocation (committed resource).
         ResourceHeapAllocation directAllocation;
-        DAWN_TRY_ASSIGN(directAllocation,
-                        CreateCommittedResource(heapType, resourceDescriptor, initialUsage));
+        DAWN_TRY_ASSIGN(directAllocation, CreateCommittedResource(heapType, resourceDescriptor,
+                                                                  initialUsage, allocationClass));
+        if (directAllocation.GetInfo().mMethod != AllocationMethod::kInvalid) {
+            mDevice->TrackMemoryAllocation(allocationClass, directAllocation.GetInfo().mSize);
+        }
 
         return std::move(directAllocation);
     }
@@ -204,6 +209,11 @@ namespace dawn_native { namespace d3d12 {
             return;
         }
 
+        if (allocation.GetInfo().mSize > 0) {
+            mDevice->TrackMemoryDeallocation(allocation.GetInfo().mClass,
+                                             allocation.GetInfo().mSize);
+        }
+
         mAllocationsToDelete.Enqueue(allocation, mDevice->GetPendingCommandSerial());
 
         // Directly allocated ResourceHeapAllocations are created with a heap object that must be
@@ -238,7 +248,8 @@ namespace dawn_native { namespace d3d12 {
     ResultOrError<ResourceHeapAllocation> ResourceAllocatorManager::CreatePlacedResource(
         D3D12_HEAP_TYPE heapType,
         const D3D12_RESOURCE_DESC& requestedResourceDescriptor,
-        D3D12_RESOURCE_STATES initialUsage) {
+        D3D12_RESOURCE_STATES initialUsage,
+        AllocationClass allocationClass) {
         const ResourceHeapKind resourceHeapKind =
             GetResourceHeapKind(requestedResourceDescriptor.Dimension, heapType,
                                 requestedResourceDescriptor.Flags, mResourceHeapTier);
@@ -302,14 +313,21 @@ namespace dawn_native { namespace d3d12 {
         // will insert it into the residency LRU.
         mDevice->GetResidencyManager()->UnlockAllocation(heap);
 
-        return ResourceHeapAllocation{allocation.GetInfo(), allocation.GetOffset(),
-                                      std::move(placedResource), heap};
+        // Stamp the size and class on the allocation so DeallocateMemory can update the
+        // device's memory stats.
+        AllocationInfo info = allocation.GetInfo();
+        info.mSize = resourceInfo.SizeInBytes;
+        info.mClass = allocationClass;
+
+        return ResourceHeapAllocation{info, allocation.GetOffset(), std::move(placedResource),
+                                      heap};
     }
 
     ResultOrError<ResourceHeapAllocation> ResourceAllocatorManager::CreateCommittedResource(
         D3D12_HEAP_TYPE heapType,
         const D3D12_RESOURCE_DESC& resourceDescriptor,
-        D3D12_RESOURCE_STATES initialUsage) {
+        D3D12_RESOURCE_STATES initialUsage,
+        AllocationClass allocationClass) {
         D3D12_HEAP_PROPERTIES heapProperties;
         heapProperties.Type = heapType;
         heapProperties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
@@ -361,6 +379,8 @@ namespace dawn_native { namespace d3d12 {
 
         AllocationInfo info;
         info.mMethod = AllocationMethod::kDirect;
+        info.mSize = resourceInfo.SizeInBytes;
+        info.mClass = allocationClass;
 
         return ResourceHeapAllocation{info,
                                       /*offset*/ 0, std::move(committedResource), heap};
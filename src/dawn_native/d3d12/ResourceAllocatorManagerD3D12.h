@@ -61,7 +61,8 @@ namespace dawn_native { namespace d3d12 {
         ResultOrError<ResourceHeapAllocation> AllocateMemory(
             D3D12_HEAP_TYPE heapType,
             const D3D12_RESOURCE_DESC& resourceDescriptor,
-            D3D12_RESOURCE_STATES initialUsage);
+            D3D12_RESOURCE_STATES initialUsage,
+            AllocationClass allocationClass);
 
         void DeallocateMemory(ResourceHeapAllocation& allocation);
 
@@ -73,12 +74,14 @@ namespace dawn_native { namespace d3d12 {
         ResultOrError<ResourceHeapAllocation> CreatePlacedResource(
             D3D12_HEAP_TYPE heapType,
             const D3D12_RESOURCE_DESC& requestedResourceDescriptor,
-            D3D12_RESOURCE_STATES initialUsage);
+            D3D12_RESOURCE_STATES initialUsage,
+            AllocationClass allocationClass);
 
         ResultOrError<ResourceHeapAllocation> CreateCommittedResource(
             D3D12_HEAP_TYPE heapType,
             const D3D12_RESOURCE_DESC& resourceDescriptor,
-            D3D12_RESOURCE_STATES initialUsage);
+            D3D12_RESOURCE_STATES initialUsage,
+            AllocationClass allocationClass);
 
         Device* mDevice;
         uint32_t mResourceHeapTier;
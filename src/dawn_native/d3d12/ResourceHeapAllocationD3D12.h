@@ -22,7 +22,7 @@ namespace dawn_native { namespace d3d12 {
 
     class Heap;
 
-    class ResourceHeapAllocation : public ResourceMemoryAllocation {
+    class ResourceHeapAllocation final : public ResourceMemoryAllocation {
       public:
         ResourceHeapAllocation() = default;
         ResourceHeapAllocation(const AllocationInfo& info,
@@ -43,7 +43,7 @@ namespace dawn_native { namespace d3d12 {
     class ShaderVisibleDescriptorAllocator;
 
     // Wraps sampler descriptor heap allocations in a cache.
-    class SamplerHeapCacheEntry : public RefCounted {
+    class SamplerHeapCacheEntry final : public RefCounted {
       public:
         SamplerHeapCacheEntry() = default;
         SamplerHeapCacheEntry(std::vector<Sampler*> samplers);
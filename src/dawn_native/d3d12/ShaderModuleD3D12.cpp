@@ -17,6 +17,7 @@
 #include "common/Assert.h"
 #include "common/BitSetIterator.h"
 #include "common/Log.h"
+#include "dawn_native/PersistentCache.h"
 #include "dawn_native/d3d12/BindGroupLayoutD3D12.h"
 #include "dawn_native/d3d12/D3D12Error.h"
 #include "dawn_native/d3d12/DeviceD3D12.h"
@@ -28,6 +29,8 @@
 
 #include <spirv_hlsl.hpp>
 
+#include <sstream>
+
 namespace dawn_native { namespace d3d12 {
 
     namespace {
@@ -76,6 +79,24 @@ namespace dawn_native { namespace d3d12 {
             return arguments;
         }
 
+        PersistentCacheKey CreateHLSLCacheKey(const char* compilerTag,
+                                              uint32_t compilerVersion,
+                                              SingleShaderStage stage,
+                                              const char* entryPoint,
+                                              uint32_t compileFlags,
+                                              const std::string& hlslSource) {
+            // The full source goes into the key so a hit can never return another shader's
+            // blob; the embedder's store is free to digest keys into fixed-size identifiers.
+            // The stage determines the target profile and the compile flags determine the
+            // compiler arguments, so both are part of the key.
+            std::ostringstream stream;
+            stream << "D3D12HLSL:" << compilerTag << ":" << compilerVersion << ":"
+                   << static_cast<uint32_t>(stage) << ":" << entryPoint << ":" << compileFlags
+                   << ":" << hlslSource;
+            std::string key = stream.str();
+            return PersistentCacheKey(key.begin(), key.end());
+        }
+
     }  // anonymous namespace
 
     // static
@@ -112,11 +133,16 @@ namespace dawn_native { namespace d3d12 {
                 mSpvcContext.InitializeForHlsl(spirv.data(), spirv.size(), options),
                 "Unable to initialize instance of spvc"));
 
-            spirv_cross::Compiler* compiler;
-            DAWN_TRY(CheckSpvcSuccess(mSpvcContext.GetCompiler(reinterpret_cast<void**>(&compiler)),
-                                      "Unable to get cross compiler"));
-            DAWN_TRY(ExtractSpirvInfo(*compiler));
-        } else {
+            if (!TryLoadCachedSpirvInfo()) {
+                spirv_cross::Compiler* compiler;
+                DAWN_TRY(
+                    CheckSpvcSuccess(mSpvcContext.GetCompiler(reinterpret_cast<void**>(&compiler)),
+                                     "Unable to get cross compiler"));
+                DAWN_TRY(ExtractSpirvInfo(*compiler));
+            }
+        } else if (!TryLoadCachedSpirvInfo()) {
+            // The compiler is only needed for reflection here (GetHLSLSource builds its own)
+            // so a cache hit skips the whole parse.
             spirv_cross::CompilerHLSL compiler(spirv);
             DAWN_TRY(ExtractSpirvInfo(compiler));
         }
@@ -215,14 +241,39 @@ namespace dawn_native { namespace d3d12 {
         IDxcLibrary* dxcLibrary;
         DAWN_TRY_ASSIGN(dxcLibrary, ToBackend(GetDevice())->GetOrCreateDxcLibrary());
 
+        IDxcCompiler* dxcCompiler;
+        DAWN_TRY_ASSIGN(dxcCompiler, ToBackend(GetDevice())->GetOrCreateDxcCompiler());
+
+        // The compiler version partitions the cache so a toolchain update invalidates
+        // blobs produced by the previous compiler.
+        uint32_t compilerVersion = 0;
+        {
+            ComPtr<IDxcVersionInfo> versionInfo;
+            uint32_t major = 0;
+            uint32_t minor = 0;
+            if (SUCCEEDED(dxcCompiler->QueryInterface(IID_PPV_ARGS(&versionInfo))) &&
+                SUCCEEDED(versionInfo->GetVersion(&major, &minor))) {
+                compilerVersion = (major << 16) | minor;
+            }
+        }
+
+        PersistentCacheKey cacheKey =
+            CreateHLSLCacheKey("dxc", compilerVersion, stage, entryPoint, compileFlags, hlslSource);
+        std::vector<uint8_t> cachedBlob = GetDevice()->GetPersistentCache()->LoadData(cacheKey);
+        if (!cachedBlob.empty()) {
+            ComPtr<IDxcBlobEncoding> cachedShader;
+            DAWN_TRY(CheckHRESULT(
+                dxcLibrary->CreateBlobWithEncodingOnHeapCopy(cachedBlob.data(), cachedBlob.size(),
+                                                             CP_ACP, &cachedShader),
+                "DXC create cached blob"));
+            return ComPtr<IDxcBlob>(cachedShader);
+        }
+
         ComPtr<IDxcBlobEncoding> sourceBlob;
         DAWN_TRY(CheckHRESULT(dxcLibrary->CreateBlobWithEncodingOnHeapCopy(
                                   hlslSource.c_str(), hlslSource.length(), CP_UTF8, &sourceBlob),
                               "DXC create blob"));
 
-        IDxcCompiler* dxcCompiler;
-        DAWN_TRY_ASSIGN(dxcCompiler, ToBackend(GetDevice())->GetOrCreateDxcCompiler());
-
         std::wstring entryPointW;
         DAWN_TRY_ASSIGN(entryPointW, ConvertStringToWstring(entryPoint));
 
@@ -248,6 +299,8 @@ namespace dawn_native { namespace d3d12 {
 
         ComPtr<IDxcBlob> compiledShader;
         DAWN_TRY(CheckHRESULT(result->GetResult(&compiledShader), "DXC get result"));
+        GetDevice()->GetPersistentCache()->StoreData(
+            cacheKey, compiledShader->GetBufferPointer(), compiledShader->GetBufferSize());
         return std::move(compiledShader);
     }
 
@@ -275,10 +328,23 @@ namespace dawn_native { namespace d3d12 {
                 break;
         }
 
+        const PlatformFunctions* functions = ToBackend(GetDevice())->GetFunctions();
+
+        PersistentCacheKey cacheKey =
+            CreateHLSLCacheKey("fxc", D3D_COMPILER_VERSION, stage, entryPoint, compileFlags,
+                               hlslSource);
+        std::vector<uint8_t> cachedBlob = GetDevice()->GetPersistentCache()->LoadData(cacheKey);
+        if (!cachedBlob.empty()) {
+            ComPtr<ID3DBlob> cachedShader;
+            DAWN_TRY(CheckHRESULT(functions->d3dCreateBlob(cachedBlob.size(), &cachedShader),
+                                  "D3D create blob"));
+            memcpy(cachedShader->GetBufferPointer(), cachedBlob.data(), cachedBlob.size());
+            return std::move(cachedShader);
+        }
+
         ComPtr<ID3DBlob> compiledShader;
         ComPtr<ID3DBlob> errors;
 
-        const PlatformFunctions* functions = ToBackend(GetDevice())->GetFunctions();
         if (FAILED(functions->d3dCompile(hlslSource.c_str(), hlslSource.length(), nullptr, nullptr,
                                          nullptr, entryPoint, targetProfile, compileFlags, 0,
                                          &compiledShader, &errors))) {
@@ -287,6 +353,8 @@ namespace dawn_native { namespace d3d12 {
             return DAWN_INTERNAL_ERROR(message);
         }
 
+        GetDevice()->GetPersistentCache()->StoreData(
+            cacheKey, compiledShader->GetBufferPointer(), compiledShader->GetBufferSize());
         return std::move(compiledShader);
     }
 
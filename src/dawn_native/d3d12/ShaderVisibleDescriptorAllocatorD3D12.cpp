@@ -17,6 +17,10 @@
 #include "dawn_native/d3d12/DeviceD3D12.h"
 #include "dawn_native/d3d12/GPUDescriptorHeapAllocationD3D12.h"
 #include "dawn_native/d3d12/ResidencyManagerD3D12.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
+
+#include <algorithm>
 
 namespace dawn_native { namespace d3d12 {
 
@@ -96,6 +100,8 @@ namespace dawn_native { namespace d3d12 {
         // still valid.
         *allocation = GPUDescriptorHeapAllocation{baseGPUDescriptor, pendingSerial, mHeapSerial};
 
+        mDescriptorHighWaterMark = std::max(mDescriptorHighWaterMark, mAllocator.GetUsedSize());
+
         return true;
     }
 
@@ -116,21 +122,31 @@ namespace dawn_native { namespace d3d12 {
         // TODO(dawn:256): Consider periodically triming to avoid OOM.
         if (mHeap != nullptr) {
             mDevice->GetResidencyManager()->UnlockAllocation(mHeap.get());
-            mPool.push_back({mDevice->GetPendingCommandSerial(), std::move(mHeap)});
+            mPool.push_back({mDevice->GetPendingCommandSerial(),
+                             static_cast<uint32_t>(mAllocator.GetSize()), std::move(mHeap)});
+
+            // Every switch after the initial allocation forces a SetDescriptorHeaps flush
+            // on the next command list; trace them so sizing issues show up in captures.
+            mHeapSwitchCount++;
+            TRACE_EVENT1(mDevice->GetPlatform(), Recording,
+                         "ShaderVisibleDescriptorAllocator::HeapSwitch", "highWaterMark",
+                         mDescriptorHighWaterMark);
         }
 
-        // Recycle existing heap if possible.
-        if (!mPool.empty() && mPool.front().heapSerial <= mDevice->GetCompletedCommandSerial()) {
-            descriptorHeap = std::move(mPool.front().heap);
+        const uint32_t descriptorCount = GetDescriptorCountForHeap();
+
+        // Recycle an existing heap of the right size if possible. Completed heaps of
+        // another size (left over from a SetDescriptorCount change) are released instead.
+        while (!mPool.empty() && mPool.front().heapSerial <= mDevice->GetCompletedCommandSerial()) {
+            SerialDescriptorHeap& serialHeap = mPool.front();
+            if (serialHeap.descriptorCount == descriptorCount) {
+                descriptorHeap = std::move(serialHeap.heap);
+                mPool.pop_front();
+                break;
+            }
             mPool.pop_front();
         }
 
-        // TODO(bryan.bernhart@intel.com): Allocating to max heap size wastes memory
-        // should the developer not allocate any bindings for the heap type.
-        // Consider dynamically re-sizing GPU heaps.
-        const uint32_t descriptorCount = GetD3D12ShaderVisibleHeapSize(
-            mHeapType, mDevice->IsToggleEnabled(Toggle::UseD3D12SmallShaderVisibleHeapForTesting));
-
         if (descriptorHeap == nullptr) {
             // The size in bytes of a descriptor heap is best calculated by the increment size
             // multiplied by the number of descriptors. In practice, this is only an estimate and
@@ -167,6 +183,36 @@ namespace dawn_native { namespace d3d12 {
         return {};
     }
 
+    MaybeError ShaderVisibleDescriptorAllocator::SetDescriptorCount(uint32_t descriptorCount) {
+        mRequestedDescriptorCount = descriptorCount;
+        // Switch right away: done at startup this pre-allocates the heap at the requested
+        // size so the first frame never pays a mid-frame heap switch.
+        return AllocateAndSwitchShaderVisibleHeap();
+    }
+
+    uint64_t ShaderVisibleDescriptorAllocator::GetDescriptorHighWaterMark() const {
+        return mDescriptorHighWaterMark;
+    }
+
+    uint64_t ShaderVisibleDescriptorAllocator::GetHeapSwitchCount() const {
+        return mHeapSwitchCount;
+    }
+
+    uint64_t ShaderVisibleDescriptorAllocator::GetHeapSize() const {
+        return mAllocator.GetSize();
+    }
+
+    uint32_t ShaderVisibleDescriptorAllocator::GetDescriptorCountForHeap() const {
+        if (mRequestedDescriptorCount != 0) {
+            return mRequestedDescriptorCount;
+        }
+        // TODO(bryan.bernhart@intel.com): Allocating to max heap size wastes memory
+        // should the developer not allocate any bindings for the heap type.
+        // Consider dynamically re-sizing GPU heaps.
+        return GetD3D12ShaderVisibleHeapSize(
+            mHeapType, mDevice->IsToggleEnabled(Toggle::UseD3D12SmallShaderVisibleHeapForTesting));
+    }
+
     Serial ShaderVisibleDescriptorAllocator::GetShaderVisibleHeapSerialForTesting() const {
         return mHeapSerial;
     }
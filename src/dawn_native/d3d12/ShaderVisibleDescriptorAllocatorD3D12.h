@@ -33,7 +33,7 @@ namespace dawn_native { namespace d3d12 {
     class Device;
     class GPUDescriptorHeapAllocation;
 
-    class ShaderVisibleDescriptorHeap : public Pageable {
+    class ShaderVisibleDescriptorHeap final : public Pageable {
       public:
         ShaderVisibleDescriptorHeap(ComPtr<ID3D12DescriptorHeap> d3d12DescriptorHeap,
                                     uint64_t size);
@@ -63,6 +63,18 @@ namespace dawn_native { namespace d3d12 {
         ID3D12DescriptorHeap* GetShaderVisibleHeap() const;
         MaybeError AllocateAndSwitchShaderVisibleHeap();
 
+        // Overrides the heap size and reallocates the heap immediately, so applications
+        // can size the heap once at startup instead of taking a mid-frame heap switch.
+        // A count of 0 restores the default (maximum tier) size.
+        MaybeError SetDescriptorCount(uint32_t descriptorCount);
+
+        // Telemetry for capacity planning. The high-water mark is the most descriptors
+        // ever used within a single heap lifetime; switches after the initial allocation
+        // each force a SetDescriptorHeaps flush on the next command list.
+        uint64_t GetDescriptorHighWaterMark() const;
+        uint64_t GetHeapSwitchCount() const;
+        uint64_t GetHeapSize() const;
+
         // For testing purposes only.
         Serial GetShaderVisibleHeapSerialForTesting() const;
         uint64_t GetShaderVisibleHeapSizeForTesting() const;
@@ -75,9 +87,12 @@ namespace dawn_native { namespace d3d12 {
       private:
         struct SerialDescriptorHeap {
             Serial heapSerial;
+            uint32_t descriptorCount;
             std::unique_ptr<ShaderVisibleDescriptorHeap> heap;
         };
 
+        uint32_t GetDescriptorCountForHeap() const;
+
         std::unique_ptr<ShaderVisibleDescriptorHeap> mHeap;
         RingBufferAllocator mAllocator;
         std::list<SerialDescriptorHeap> mPool;
@@ -91,6 +106,12 @@ namespace dawn_native { namespace d3d12 {
         Serial mHeapSerial = 0;
 
         uint32_t mSizeIncrement;
+
+        // Non-zero when the application overrode the heap size with SetDescriptorCount.
+        uint32_t mRequestedDescriptorCount = 0;
+
+        uint64_t mDescriptorHighWaterMark = 0;
+        uint64_t mHeapSwitchCount = 0;
     };
 }}  // namespace dawn_native::d3d12
 
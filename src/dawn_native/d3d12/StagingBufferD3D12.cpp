@@ -20,8 +20,8 @@
 
 namespace dawn_native { namespace d3d12 {
 
-    StagingBuffer::StagingBuffer(size_t size, Device* device)
-        : StagingBufferBase(size), mDevice(device) {
+    StagingBuffer::StagingBuffer(size_t size, Device* device, StagingAccess access)
+        : StagingBufferBase(size, access), mDevice(device) {
     }
 
     MaybeError StagingBuffer::Initialize() {
@@ -38,14 +38,22 @@ namespace dawn_native { namespace d3d12 {
         resourceDescriptor.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
         resourceDescriptor.Flags = D3D12_RESOURCE_FLAG_NONE;
 
-        DAWN_TRY_ASSIGN(mUploadHeap,
-                        mDevice->AllocateMemory(D3D12_HEAP_TYPE_UPLOAD, resourceDescriptor,
-                                                D3D12_RESOURCE_STATE_GENERIC_READ));
+        // Upload staging memory lives in an upload heap the CPU writes and the GPU reads;
+        // readback staging memory lives in a readback heap that stays in the COPY_DEST state
+        // so the GPU can copy results into it for the CPU to read.
+        const bool isUpload = GetAccess() == StagingAccess::Upload;
+        DAWN_TRY_ASSIGN(mStagingHeap,
+                        mDevice->AllocateMemory(
+                            isUpload ? D3D12_HEAP_TYPE_UPLOAD : D3D12_HEAP_TYPE_READBACK,
+                            resourceDescriptor,
+                            isUpload ? D3D12_RESOURCE_STATE_GENERIC_READ
+                                     : D3D12_RESOURCE_STATE_COPY_DEST,
+                            AllocationClass::Staging));
 
         // The mapped buffer can be accessed at any time, so it must be locked to ensure it is never
         // evicted. This buffer should already have been made resident when it was created.
         DAWN_TRY(mDevice->GetResidencyManager()->LockAllocation(
-            ToBackend(mUploadHeap.GetResourceHeap())));
+            ToBackend(mStagingHeap.GetResourceHeap())));
 
         return CheckHRESULT(GetResource()->Map(0, nullptr, &mMappedPointer), "ID3D12Resource::Map");
     }
@@ -53,22 +61,22 @@ namespace dawn_native { namespace d3d12 {
     StagingBuffer::~StagingBuffer() {
         // Always check if the allocation is valid before Unmap.
         // The resource would not exist had it failed to allocate.
-        if (mUploadHeap.GetInfo().mMethod == AllocationMethod::kInvalid) {
+        if (mStagingHeap.GetInfo().mMethod == AllocationMethod::kInvalid) {
             return;
         }
 
         // The underlying heap was locked in residency upon creation. We must unlock it when this
         // buffer becomes unmapped.
-        mDevice->GetResidencyManager()->UnlockAllocation(ToBackend(mUploadHeap.GetResourceHeap()));
+        mDevice->GetResidencyManager()->UnlockAllocation(ToBackend(mStagingHeap.GetResourceHeap()));
 
         // Invalidate the CPU virtual address & flush cache (if needed).
         GetResource()->Unmap(0, nullptr);
         mMappedPointer = nullptr;
 
-        mDevice->DeallocateMemory(mUploadHeap);
+        mDevice->DeallocateMemory(mStagingHeap);
     }
 
     ID3D12Resource* StagingBuffer::GetResource() const {
-        return mUploadHeap.GetD3D12Resource().Get();
+        return mStagingHeap.GetD3D12Resource().Get();
     }
 }}  // namespace dawn_native::d3d12
@@ -24,9 +24,9 @@ namespace dawn_native { namespace d3d12 {
     class CommandRecordingContext;
     class Device;
 
-    class StagingBuffer : public StagingBufferBase {
+    class StagingBuffer final : public StagingBufferBase {
       public:
-        StagingBuffer(size_t size, Device* device);
+        StagingBuffer(size_t size, Device* device, StagingAccess access);
         ~StagingBuffer() override;
 
         ID3D12Resource* GetResource() const;
@@ -35,7 +35,7 @@ namespace dawn_native { namespace d3d12 {
 
       private:
         Device* mDevice;
-        ResourceHeapAllocation mUploadHeap;
+        ResourceHeapAllocation mStagingHeap;
     };
 }}  // namespace dawn_native::d3d12
 
@@ -15,9 +15,12 @@
 #include "dawn_native/d3d12/TextureCopySplitter.h"
 
 #include "common/Assert.h"
+#include "common/Math.h"
 #include "dawn_native/Format.h"
 #include "dawn_native/d3d12/d3d12_platform.h"
 
+#include <algorithm>
+
 namespace dawn_native { namespace d3d12 {
 
     namespace {
@@ -181,4 +184,38 @@ namespace dawn_native { namespace d3d12 {
         return copy;
     }
 
+    MipChainCopySplit ComputeMipChainCopySplit(Extent3D baseSize,
+                                               uint32_t baseMipLevel,
+                                               uint32_t levelCount,
+                                               const Format& format) {
+        MipChainCopySplit split;
+
+        ASSERT(levelCount <= kMaxTexture2DMipLevels);
+
+        uint64_t offset = 0;
+        for (uint32_t i = 0; i < levelCount; ++i) {
+            uint32_t level = baseMipLevel + i;
+
+            // The physical size of the level: the virtual size rounded up to a multiple of
+            // the block size so compressed formats copy whole blocks.
+            Extent3D levelSize;
+            levelSize.width = Align(std::max(baseSize.width >> level, 1u), format.blockWidth);
+            levelSize.height = Align(std::max(baseSize.height >> level, 1u), format.blockHeight);
+            levelSize.depth = std::max(baseSize.depth >> level, 1u);
+
+            MipChainCopySplit::LevelInfo& info = split.levels[split.count++];
+            info.offset = offset;
+            info.bytesPerRow = Align(levelSize.width / format.blockWidth * format.blockByteSize,
+                                     kTextureBytesPerRowAlignment);
+            info.copySize = levelSize;
+
+            uint64_t levelBytes = uint64_t(info.bytesPerRow) *
+                                  (levelSize.height / format.blockHeight) * levelSize.depth;
+            offset = RoundUp(offset + levelBytes, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+        }
+
+        split.totalSize = offset;
+        return split;
+    }
+
 }}  // namespace dawn_native::d3d12
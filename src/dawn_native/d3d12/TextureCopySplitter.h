@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_D3D12_TEXTURECOPYSPLITTER_H_
 #define DAWNNATIVE_D3D12_TEXTURECOPYSPLITTER_H_
 
+#include "common/Constants.h"
 #include "dawn_native/dawn_platform.h"
 
 #include <array>
@@ -49,6 +50,30 @@ namespace dawn_native { namespace d3d12 {
                                              uint64_t offset,
                                              uint32_t bytesPerRow,
                                              uint32_t rowsPerImage);
+
+    // Plans the staging layout for a whole mip chain at once. Each level gets a
+    // placement-aligned offset and a 256-aligned row pitch so that every subresource is a
+    // single CopyTextureRegion out of one staging allocation of |totalSize| bytes, instead
+    // of one allocation and up to two copy regions per level.
+    struct MipChainCopySplit {
+        struct LevelInfo {
+            // Offset of the level data relative to the start of the staging data. It is
+            // D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT-aligned so the caller only needs to
+            // align the base of the allocation.
+            uint64_t offset;
+            uint32_t bytesPerRow;
+            Extent3D copySize;
+        };
+
+        uint64_t totalSize = 0;
+        uint32_t count = 0;
+        std::array<LevelInfo, kMaxTexture2DMipLevels> levels;
+    };
+
+    MipChainCopySplit ComputeMipChainCopySplit(Extent3D baseSize,
+                                               uint32_t baseMipLevel,
+                                               uint32_t levelCount,
+                                               const Format& format);
 }}  // namespace dawn_native::d3d12
 
 #endif  // DAWNNATIVE_D3D12_TEXTURECOPYSPLITTER_H_
@@ -471,7 +471,8 @@ namespace dawn_native { namespace d3d12 {
         DAWN_TRY_ASSIGN(mResourceAllocation,
                         ToBackend(GetDevice())
                             ->AllocateMemory(D3D12_HEAP_TYPE_DEFAULT, resourceDescriptor,
-                                             D3D12_RESOURCE_STATE_COMMON));
+                                             D3D12_RESOURCE_STATE_COMMON,
+                                             AllocationClass::Texture));
 
         Device* device = ToBackend(GetDevice());
 
@@ -537,6 +538,10 @@ namespace dawn_native { namespace d3d12 {
         return mResourceAllocation.GetD3D12Resource().Get();
     }
 
+    Heap* Texture::GetHeap() const {
+        return ToBackend(mResourceAllocation.GetResourceHeap());
+    }
+
     UINT16 Texture::GetDepthOrArraySize() {
         switch (GetDimension()) {
             case wgpu::TextureDimension::e2D:
@@ -572,6 +577,25 @@ namespace dawn_native { namespace d3d12 {
         return TransitionUsageAndGetResourceBarrier(commandContext, barrier, newState);
     }
 
+    // When true is returned, the BEGIN half of a split barrier has been created and must be used
+    // in a ResourceBarrier call. The END half is recorded by the next transition of the texture,
+    // which completes the transition that was begun here.
+    bool Texture::TrackUsageAndGetSplitBarrierBegin(CommandRecordingContext* commandContext,
+                                                    D3D12_RESOURCE_BARRIER* barrier,
+                                                    wgpu::TextureUsage newUsage) {
+        ASSERT(!mSplitBarrierPending);
+
+        if (!TrackUsageAndGetResourceBarrier(commandContext, barrier, newUsage)) {
+            return false;
+        }
+
+        barrier->Flags = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY;
+        mPendingSplitBarrier = *barrier;
+        mPendingSplitBarrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
+        mSplitBarrierPending = true;
+        return true;
+    }
+
     void Texture::TrackUsageAndTransitionNow(CommandRecordingContext* commandContext,
                                              wgpu::TextureUsage usage) {
         D3D12_RESOURCE_BARRIER barrier;
@@ -596,6 +620,19 @@ namespace dawn_native { namespace d3d12 {
     bool Texture::TransitionUsageAndGetResourceBarrier(CommandRecordingContext* commandContext,
                                                        D3D12_RESOURCE_BARRIER* barrier,
                                                        D3D12_RESOURCE_STATES newState) {
+        // A previously begun split barrier must be finished before the texture can be used or
+        // transitioned again.
+        if (mSplitBarrierPending) {
+            mSplitBarrierPending = false;
+            if (mPendingSplitBarrier.Transition.StateAfter == newState) {
+                *barrier = mPendingSplitBarrier;
+                return true;
+            }
+            // The predicted usage didn't materialize; complete the split transition in place
+            // and compute the real transition from the state it left the texture in.
+            commandContext->GetCommandList()->ResourceBarrier(1, &mPendingSplitBarrier);
+        }
+
         // Textures with keyed mutexes can be written from other graphics queues. Hence, they
         // must be acquired before command list submission to ensure work from the other queues
         // has finished. See Device::ExecuteCommandContext.
@@ -803,11 +840,11 @@ namespace dawn_native { namespace d3d12 {
             }
         } else {
             // TODO(natlee@microsoft.com): test compressed textures are cleared
-            // create temp buffer with clear color to copy to the texture image
-            uint32_t bytesPerRow =
-                Align((GetSize().width / GetFormat().blockWidth) * GetFormat().blockByteSize,
-                      kTextureBytesPerRowAlignment);
-            uint64_t bufferSize64 = bytesPerRow * (GetSize().height / GetFormat().blockHeight);
+            // Plan the staging layout for all the levels at once so each subresource is a
+            // single CopyTextureRegion out of one allocation.
+            MipChainCopySplit mipChain =
+                ComputeMipChainCopySplit(GetSize(), baseMipLevel, levelCount, GetFormat());
+            uint64_t bufferSize64 = mipChain.totalSize + D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT;
             if (bufferSize64 > std::numeric_limits<uint32_t>::max()) {
                 return DAWN_OUT_OF_MEMORY_ERROR("Unable to allocate buffer.");
             }
@@ -820,11 +857,14 @@ namespace dawn_native { namespace d3d12 {
 
             TrackUsageAndTransitionNow(commandContext, D3D12_RESOURCE_STATE_COPY_DEST);
 
-            for (uint32_t level = baseMipLevel; level < baseMipLevel + levelCount; ++level) {
-                // compute d3d12 texture copy locations for texture and buffer
-                Extent3D copySize = GetMipLevelVirtualSize(level);
-                TextureCopySplit copySplit = ComputeTextureCopySplit(
-                    {0, 0, 0}, copySize, GetFormat(), uploadHandle.startOffset, bytesPerRow, 0);
+            // The level offsets are placement-aligned relative to the start of the staging
+            // data, so only the base of the allocation needs to be aligned.
+            const uint64_t baseOffset =
+                RoundUp(uploadHandle.startOffset, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+            for (uint32_t i = 0; i < mipChain.count; ++i) {
+                uint32_t level = baseMipLevel + i;
+                const MipChainCopySplit::LevelInfo& info = mipChain.levels[i];
 
                 for (uint32_t layer = baseArrayLayer; layer < baseArrayLayer + layerCount;
                      ++layer) {
@@ -836,21 +876,16 @@ namespace dawn_native { namespace d3d12 {
 
                     D3D12_TEXTURE_COPY_LOCATION textureLocation =
                         ComputeTextureCopyLocationForTexture(this, level, layer);
-                    for (uint32_t i = 0; i < copySplit.count; ++i) {
-                        TextureCopySplit::CopyInfo& info = copySplit.copies[i];
-
-                        D3D12_TEXTURE_COPY_LOCATION bufferLocation =
-                            ComputeBufferLocationForCopyTextureRegion(
-                                this, ToBackend(uploadHandle.stagingBuffer)->GetResource(),
-                                info.bufferSize, copySplit.offset, bytesPerRow);
-                        D3D12_BOX sourceRegion =
-                            ComputeD3D12BoxFromOffsetAndSize(info.bufferOffset, info.copySize);
-
-                        // copy the buffer filled with clear color to the texture
-                        commandList->CopyTextureRegion(&textureLocation, info.textureOffset.x,
-                                                       info.textureOffset.y, info.textureOffset.z,
-                                                       &bufferLocation, &sourceRegion);
-                    }
+                    D3D12_TEXTURE_COPY_LOCATION bufferLocation =
+                        ComputeBufferLocationForCopyTextureRegion(
+                            this, ToBackend(uploadHandle.stagingBuffer)->GetResource(),
+                            info.copySize, baseOffset + info.offset, info.bytesPerRow);
+                    D3D12_BOX sourceRegion =
+                        ComputeD3D12BoxFromOffsetAndSize({0, 0, 0}, info.copySize);
+
+                    // copy the buffer filled with clear color to the texture
+                    commandList->CopyTextureRegion(&textureLocation, 0, 0, 0, &bufferLocation,
+                                                   &sourceRegion);
                 }
             }
         }
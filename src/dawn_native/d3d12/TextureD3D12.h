@@ -47,6 +47,9 @@ namespace dawn_native { namespace d3d12 {
 
         DXGI_FORMAT GetD3D12Format() const;
         ID3D12Resource* GetD3D12Resource() const;
+        // The memory heap backing the texture, or nullptr for textures wrapping
+        // externally created resources.
+        Heap* GetHeap() const;
 
         D3D12_RENDER_TARGET_VIEW_DESC GetRTVDescriptor(uint32_t mipLevel,
                                                        uint32_t baseArrayLayer,
@@ -63,6 +66,13 @@ namespace dawn_native { namespace d3d12 {
         bool TrackUsageAndGetResourceBarrier(CommandRecordingContext* commandContext,
                                              D3D12_RESOURCE_BARRIER* barrier,
                                              wgpu::TextureUsage newUsage);
+        // When the usage the texture transitions to next is known ahead of time, the transition
+        // can be issued as a split barrier: the BEGIN half right after the producing pass and
+        // the END half at the consuming one, letting the driver overlap the transition with the
+        // work recorded in between.
+        bool TrackUsageAndGetSplitBarrierBegin(CommandRecordingContext* commandContext,
+                                               D3D12_RESOURCE_BARRIER* barrier,
+                                               wgpu::TextureUsage newUsage);
         void TrackUsageAndTransitionNow(CommandRecordingContext* commandContext,
                                         wgpu::TextureUsage usage);
         void TrackUsageAndTransitionNow(CommandRecordingContext* commandContext,
@@ -101,6 +111,10 @@ namespace dawn_native { namespace d3d12 {
 
         Serial mLastUsedSerial = UINT64_MAX;
         bool mValidToDecay = false;
+        // The END half of a split barrier whose BEGIN half has already been recorded. It must
+        // be recorded before the texture can be used or transitioned again.
+        D3D12_RESOURCE_BARRIER mPendingSplitBarrier;
+        bool mSplitBarrierPending = false;
         bool mSwapChainTexture = false;
 
         Serial mAcquireMutexKey = 0;
@@ -15,9 +15,13 @@
 #include "dawn_native/d3d12/UtilsD3D12.h"
 
 #include "common/Assert.h"
+#include "common/HashUtils.h"
 
 #include <stringapiset.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace dawn_native { namespace d3d12 {
 
     ResultOrError<std::wstring> ConvertStringToWstring(const char* str) {
@@ -138,6 +142,9 @@ namespace dawn_native { namespace d3d12 {
         if (buildUsage & wgpu::RayTracingAccelerationContainerUsage::LowMemory) {
             flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_MINIMIZE_MEMORY;
         }
+        if (buildUsage & wgpu::RayTracingAccelerationContainerUsage::AllowCompaction) {
+            flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_COMPACTION;
+        }
         return static_cast<D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS>(flags);
     }
 
@@ -212,4 +219,14 @@ namespace dawn_native { namespace d3d12 {
         return sourceRegion;
     }
 
+    void HashShaderBytecode(size_t* hash, const D3D12_SHADER_BYTECODE& bytecode) {
+        const uint8_t* data = static_cast<const uint8_t*>(bytecode.pShaderBytecode);
+        for (size_t i = 0; i < bytecode.BytecodeLength; i += sizeof(size_t)) {
+            size_t word = 0;
+            memcpy(&word, data + i, std::min(sizeof(size_t), bytecode.BytecodeLength - i));
+            HashCombine(hash, word);
+        }
+        HashCombine(hash, bytecode.BytecodeLength);
+    }
+
 }}  // namespace dawn_native::d3d12
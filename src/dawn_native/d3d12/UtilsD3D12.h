@@ -54,6 +54,9 @@ namespace dawn_native { namespace d3d12 {
         const uint32_t rowPitch);
     D3D12_BOX ComputeD3D12BoxFromOffsetAndSize(const Origin3D& offset, const Extent3D& copySize);
 
+    // Hashes compiled shader bytecode, used to derive names for the pipeline library.
+    void HashShaderBytecode(size_t* hash, const D3D12_SHADER_BYTECODE& bytecode);
+
 }}  // namespace dawn_native::d3d12
 
 #endif  // DAWNNATIVE_D3D12_UTILSD3D12_H_
@@ -18,6 +18,10 @@
 #include "common/SlabAllocator.h"
 #include "dawn_native/BindGroupLayout.h"
 
+#import <Metal/Metal.h>
+
+#include <mutex>
+
 namespace dawn_native { namespace metal {
 
     class BindGroup;
@@ -30,9 +34,23 @@ namespace dawn_native { namespace metal {
         BindGroup* AllocateBindGroup(Device* device, const BindGroupDescriptor* descriptor);
         void DeallocateBindGroup(BindGroup* bindGroup);
 
+        // True when bind groups of this layout are pre-encoded into a Metal argument buffer
+        // at creation (metal_use_argument_buffers toggle, see CanUseArgumentBuffer in the
+        // implementation for which layouts are eligible).
+        bool UsesArgumentBuffer() const;
+
+        // Allocates and encodes the argument buffer for |group|. The resources use their
+        // BindingNumber as [[id]] so the shader side only needs the binding numbers.
+        id<MTLBuffer> EncodeArgumentBuffer(Device* device, BindGroupBase* group);
+
       private:
-        ~BindGroupLayout() override = default;
+        ~BindGroupLayout() override;
         SlabAllocator<BindGroup> mBindGroupAllocator;
+
+        id<MTLArgumentEncoder> mArgumentEncoder = nil;
+        // MTLArgumentEncoder mutates internal state while encoding and bind groups may be
+        // created from several threads, so encoding is serialized.
+        std::mutex mArgumentEncoderMutex;
     };
 
 }}  // namespace dawn_native::metal
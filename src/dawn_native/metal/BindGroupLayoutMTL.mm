@@ -15,13 +15,172 @@
 #include "dawn_native/metal/BindGroupLayoutMTL.h"
 
 #include "dawn_native/metal/BindGroupMTL.h"
+#include "dawn_native/metal/BufferMTL.h"
+#include "dawn_native/metal/DeviceMTL.h"
+#include "dawn_native/metal/SamplerMTL.h"
+#include "dawn_native/metal/TextureMTL.h"
 
 namespace dawn_native { namespace metal {
 
+    namespace {
+
+        // Layouts with dynamic offsets can't be pre-encoded because the offsets change per
+        // draw, storage buffers still need the separate buffer length table, and descriptor
+        // arrays have no resources at creation. All of those keep the per-resource path.
+        bool CanUseArgumentBuffer(const BindGroupLayoutBase* layout) {
+            if (layout->GetDynamicBufferCount() != 0) {
+                return false;
+            }
+            for (BindingIndex bindingIndex = 0; bindingIndex < layout->GetBindingCount();
+                 ++bindingIndex) {
+                const BindingInfo& bindingInfo = layout->GetBindingInfo(bindingIndex);
+                if (bindingInfo.bindingArraySize > 1) {
+                    return false;
+                }
+                switch (bindingInfo.type) {
+                    case wgpu::BindingType::UniformBuffer:
+                    case wgpu::BindingType::Sampler:
+                    case wgpu::BindingType::ComparisonSampler:
+                    case wgpu::BindingType::SampledTexture:
+                    case wgpu::BindingType::ReadonlyStorageTexture:
+                    case wgpu::BindingType::WriteonlyStorageTexture:
+                        break;
+                    default:
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        API_AVAILABLE(macos(10.13), ios(11.0))
+        MTLTextureType MetalTextureViewType(wgpu::TextureViewDimension dimension,
+                                            bool multisampled) {
+            switch (dimension) {
+                case wgpu::TextureViewDimension::e2D:
+                    return multisampled ? MTLTextureType2DMultisample : MTLTextureType2D;
+                case wgpu::TextureViewDimension::e2DArray:
+                    return MTLTextureType2DArray;
+                case wgpu::TextureViewDimension::Cube:
+                    return MTLTextureTypeCube;
+                case wgpu::TextureViewDimension::CubeArray:
+                    return MTLTextureTypeCubeArray;
+                case wgpu::TextureViewDimension::e3D:
+                    return MTLTextureType3D;
+                default:
+                    UNREACHABLE();
+                    return MTLTextureType2D;
+            }
+        }
+
+    }  // anonymous namespace
+
     BindGroupLayout::BindGroupLayout(DeviceBase* device,
                                      const BindGroupLayoutDescriptor* descriptor)
         : BindGroupLayoutBase(device, descriptor),
           mBindGroupAllocator(MakeFrontendBindGroupAllocator<BindGroup>(4096)) {
+        if (!device->IsToggleEnabled(Toggle::MetalUseArgumentBuffers) ||
+            !CanUseArgumentBuffer(this)) {
+            return;
+        }
+
+        if (@available(macOS 10.13, iOS 11.0, *)) {
+            NSMutableArray<MTLArgumentDescriptor*>* arguments = [NSMutableArray array];
+            for (const auto& it : GetBindingMap()) {
+                BindingNumber bindingNumber = it.first;
+                const BindingInfo& bindingInfo = GetBindingInfo(it.second);
+
+                MTLArgumentDescriptor* argument = [MTLArgumentDescriptor argumentDescriptor];
+                argument.index = bindingNumber;
+                switch (bindingInfo.type) {
+                    case wgpu::BindingType::UniformBuffer:
+                        argument.dataType = MTLDataTypePointer;
+                        argument.access = MTLArgumentAccessReadOnly;
+                        break;
+                    case wgpu::BindingType::Sampler:
+                    case wgpu::BindingType::ComparisonSampler:
+                        argument.dataType = MTLDataTypeSampler;
+                        break;
+                    case wgpu::BindingType::SampledTexture:
+                    case wgpu::BindingType::ReadonlyStorageTexture:
+                        argument.dataType = MTLDataTypeTexture;
+                        argument.access = MTLArgumentAccessReadOnly;
+                        argument.textureType = MetalTextureViewType(bindingInfo.viewDimension,
+                                                                    bindingInfo.multisampled);
+                        break;
+                    case wgpu::BindingType::WriteonlyStorageTexture:
+                        argument.dataType = MTLDataTypeTexture;
+                        argument.access = MTLArgumentAccessWriteOnly;
+                        argument.textureType = MetalTextureViewType(bindingInfo.viewDimension,
+                                                                    bindingInfo.multisampled);
+                        break;
+                    default:
+                        UNREACHABLE();
+                        break;
+                }
+                [arguments addObject:argument];
+            }
+
+            mArgumentEncoder =
+                [ToBackend(device)->GetMTLDevice() newArgumentEncoderWithArguments:arguments];
+        }
+    }
+
+    BindGroupLayout::~BindGroupLayout() {
+        [mArgumentEncoder release];
+        mArgumentEncoder = nil;
+    }
+
+    bool BindGroupLayout::UsesArgumentBuffer() const {
+        return mArgumentEncoder != nil;
+    }
+
+    id<MTLBuffer> BindGroupLayout::EncodeArgumentBuffer(Device* device, BindGroupBase* group) {
+        ASSERT(UsesArgumentBuffer());
+
+        if (@available(macOS 10.13, iOS 11.0, *)) {
+            id<MTLBuffer> buffer =
+                [device->GetMTLDevice() newBufferWithLength:[mArgumentEncoder encodedLength]
+                                                    options:MTLResourceStorageModeShared];
+
+            std::lock_guard<std::mutex> lock(mArgumentEncoderMutex);
+            [mArgumentEncoder setArgumentBuffer:buffer offset:0];
+            for (const auto& it : GetBindingMap()) {
+                BindingNumber bindingNumber = it.first;
+                BindingIndex bindingIndex = it.second;
+                const BindingInfo& bindingInfo = GetBindingInfo(bindingIndex);
+
+                switch (bindingInfo.type) {
+                    case wgpu::BindingType::UniformBuffer: {
+                        const BufferBinding& binding =
+                            group->GetBindingAsBufferBinding(bindingIndex);
+                        [mArgumentEncoder setBuffer:ToBackend(binding.buffer)->GetMTLBuffer()
+                                             offset:binding.offset
+                                            atIndex:bindingNumber];
+                        break;
+                    }
+                    case wgpu::BindingType::Sampler:
+                    case wgpu::BindingType::ComparisonSampler:
+                        [mArgumentEncoder
+                            setSamplerState:ToBackend(group->GetBindingAsSampler(bindingIndex))
+                                                ->GetMTLSamplerState()
+                                    atIndex:bindingNumber];
+                        break;
+                    case wgpu::BindingType::SampledTexture:
+                    case wgpu::BindingType::ReadonlyStorageTexture:
+                    case wgpu::BindingType::WriteonlyStorageTexture:
+                        [mArgumentEncoder
+                            setTexture:ToBackend(group->GetBindingAsTextureView(bindingIndex))
+                                           ->GetMTLTexture()
+                               atIndex:bindingNumber];
+                        break;
+                    default:
+                        UNREACHABLE();
+                        break;
+                }
+            }
+            return buffer;
+        }
+        return nil;
     }
 
     BindGroup* BindGroupLayout::AllocateBindGroup(Device* device,
@@ -18,6 +18,8 @@
 #include "common/PlacementAllocated.h"
 #include "dawn_native/BindGroup.h"
 
+#import <Metal/Metal.h>
+
 namespace dawn_native { namespace metal {
 
     class BindGroupLayout;
@@ -29,8 +31,13 @@ namespace dawn_native { namespace metal {
 
         static BindGroup* Create(Device* device, const BindGroupDescriptor* descriptor);
 
+        // The pre-encoded argument buffer, or nil when the layout doesn't use one.
+        id<MTLBuffer> GetArgumentBuffer() const;
+
       private:
         ~BindGroup() override;
+
+        id<MTLBuffer> mArgumentBuffer = nil;
     };
 
 }}  // namespace dawn_native::metal
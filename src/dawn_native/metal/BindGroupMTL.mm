@@ -20,12 +20,22 @@ namespace dawn_native { namespace metal {
 
     BindGroup::BindGroup(Device* device, const BindGroupDescriptor* descriptor)
         : BindGroupBase(this, device, descriptor) {
+        BindGroupLayout* layout = ToBackend(GetLayout());
+        if (layout->UsesArgumentBuffer()) {
+            mArgumentBuffer = layout->EncodeArgumentBuffer(device, this);
+        }
     }
 
     BindGroup::~BindGroup() {
+        [mArgumentBuffer release];
+        mArgumentBuffer = nil;
         ToBackend(GetLayout())->DeallocateBindGroup(this);
     }
 
+    id<MTLBuffer> BindGroup::GetArgumentBuffer() const {
+        return mArgumentBuffer;
+    }
+
     // static
     BindGroup* BindGroup::Create(Device* device, const BindGroupDescriptor* descriptor) {
         return ToBackend(descriptor->layout)->AllocateBindGroup(device, descriptor);
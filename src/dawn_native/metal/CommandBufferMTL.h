@@ -48,6 +48,15 @@ namespace dawn_native { namespace metal {
                                       uint32_t width,
                                       uint32_t height);
 
+        // Splits a draw-heavy render pass across several MTLRenderCommandEncoders of a
+        // MTLParallelRenderCommandEncoder, encoded concurrently on the platform worker
+        // pool. Returns false without consuming any command when the pass is too small
+        // or contains commands the split path doesn't handle; the serial path then runs.
+        bool TryEncodeRenderPassInParallel(CommandRecordingContext* commandContext,
+                                           MTLRenderPassDescriptor* mtlRenderPass,
+                                           uint32_t width,
+                                           uint32_t height);
+
         CommandIterator mCommands;
     };
 
@@ -26,6 +26,14 @@
 #include "dawn_native/metal/RenderPipelineMTL.h"
 #include "dawn_native/metal/SamplerMTL.h"
 #include "dawn_native/metal/TextureMTL.h"
+#include "dawn_native/metal/UtilsMetal.h"
+
+#include "dawn_platform/DawnPlatform.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
 
 namespace dawn_native { namespace metal {
 
@@ -40,6 +48,10 @@ namespace dawn_native { namespace metal {
             MTLStoreActionStoreAndMultisampleResolve;
 #pragma clang diagnostic pop
 
+        // Minimum number of draws each sub-encoder of a parallel render pass must get for
+        // the split to pay for the extra tape copies and the thread handoffs.
+        constexpr uint64_t kMinDrawsPerParallelRenderEncoder = 512;
+
         // Creates an autoreleased MTLRenderPassDescriptor matching desc
         MTLRenderPassDescriptor* CreateMTLRenderPassDescriptor(BeginRenderPassCmd* renderPass) {
             MTLRenderPassDescriptor* descriptor = [MTLRenderPassDescriptor renderPassDescriptor];
@@ -306,142 +318,6 @@ namespace dawn_native { namespace metal {
             }
         };
 
-        struct TextureBufferCopySplit {
-            static constexpr uint32_t kMaxTextureBufferCopyRegions = 3;
-
-            struct CopyInfo {
-                NSUInteger bufferOffset;
-                NSUInteger bytesPerRow;
-                NSUInteger bytesPerImage;
-                MTLOrigin textureOrigin;
-                MTLSize copyExtent;
-            };
-
-            uint32_t count = 0;
-            std::array<CopyInfo, kMaxTextureBufferCopyRegions> copies;
-        };
-
-        MTLOrigin MakeMTLOrigin(Origin3D origin) {
-            return MTLOriginMake(origin.x, origin.y, origin.z);
-        }
-
-        MTLSize MakeMTLSize(Extent3D extent) {
-            return MTLSizeMake(extent.width, extent.height, extent.depth);
-        }
-
-        TextureBufferCopySplit ComputeTextureBufferCopySplit(Origin3D origin,
-                                                             Extent3D copyExtent,
-                                                             Format textureFormat,
-                                                             Extent3D virtualSizeAtLevel,
-                                                             uint64_t bufferSize,
-                                                             uint64_t bufferOffset,
-                                                             uint32_t bytesPerRow,
-                                                             uint32_t rowsPerImage) {
-            TextureBufferCopySplit copy;
-
-            // When copying textures from/to an unpacked buffer, the Metal validation layer doesn't
-            // compute the correct range when checking if the buffer is big enough to contain the
-            // data for the whole copy. Instead of looking at the position of the last texel in the
-            // buffer, it computes the volume of the 3D box with bytesPerRow * (rowsPerImage /
-            // format.blockHeight) * copySize.depth. For example considering the pixel buffer below
-            // where in memory, each row data (D) of the texture is followed by some padding data
-            // (P):
-            //     |DDDDDDD|PP|
-            //     |DDDDDDD|PP|
-            //     |DDDDDDD|PP|
-            //     |DDDDDDD|PP|
-            //     |DDDDDDA|PP|
-            // The last pixel read will be A, but the driver will think it is the whole last padding
-            // row, causing it to generate an error when the pixel buffer is just big enough.
-
-            // We work around this limitation by detecting when Metal would complain and copy the
-            // last image and row separately using tight sourceBytesPerRow or sourceBytesPerImage.
-            uint32_t dataRowsPerImage = rowsPerImage / textureFormat.blockHeight;
-            uint32_t bytesPerImage = bytesPerRow * dataRowsPerImage;
-
-            // Metal validation layer requires that if the texture's pixel format is a compressed
-            // format, the sourceSize must be a multiple of the pixel format's block size or be
-            // clamped to the edge of the texture if the block extends outside the bounds of a
-            // texture.
-            uint32_t clampedCopyExtentWidth =
-                (origin.x + copyExtent.width > virtualSizeAtLevel.width)
-                    ? (virtualSizeAtLevel.width - origin.x)
-                    : copyExtent.width;
-            uint32_t clampedCopyExtentHeight =
-                (origin.y + copyExtent.height > virtualSizeAtLevel.height)
-                    ? (virtualSizeAtLevel.height - origin.y)
-                    : copyExtent.height;
-
-            // Check whether buffer size is big enough.
-            bool needWorkaround = bufferSize - bufferOffset < bytesPerImage * copyExtent.depth;
-            if (!needWorkaround) {
-                copy.count = 1;
-                copy.copies[0].bufferOffset = bufferOffset;
-                copy.copies[0].bytesPerRow = bytesPerRow;
-                copy.copies[0].bytesPerImage = bytesPerImage;
-                copy.copies[0].textureOrigin = MakeMTLOrigin(origin);
-                copy.copies[0].copyExtent =
-                    MTLSizeMake(clampedCopyExtentWidth, clampedCopyExtentHeight, copyExtent.depth);
-                return copy;
-            }
-
-            uint64_t currentOffset = bufferOffset;
-
-            // Doing all the copy except the last image.
-            if (copyExtent.depth > 1) {
-                copy.copies[copy.count].bufferOffset = currentOffset;
-                copy.copies[copy.count].bytesPerRow = bytesPerRow;
-                copy.copies[copy.count].bytesPerImage = bytesPerImage;
-                copy.copies[copy.count].textureOrigin = MakeMTLOrigin(origin);
-                copy.copies[copy.count].copyExtent = MTLSizeMake(
-                    clampedCopyExtentWidth, clampedCopyExtentHeight, copyExtent.depth - 1);
-
-                ++copy.count;
-
-                // Update offset to copy to the last image.
-                currentOffset += (copyExtent.depth - 1) * bytesPerImage;
-            }
-
-            // Doing all the copy in last image except the last row.
-            uint32_t copyBlockRowCount = copyExtent.height / textureFormat.blockHeight;
-            if (copyBlockRowCount > 1) {
-                copy.copies[copy.count].bufferOffset = currentOffset;
-                copy.copies[copy.count].bytesPerRow = bytesPerRow;
-                copy.copies[copy.count].bytesPerImage = bytesPerRow * (copyBlockRowCount - 1);
-                copy.copies[copy.count].textureOrigin =
-                    MTLOriginMake(origin.x, origin.y, origin.z + copyExtent.depth - 1);
-
-                ASSERT(copyExtent.height - textureFormat.blockHeight < virtualSizeAtLevel.height);
-                copy.copies[copy.count].copyExtent = MTLSizeMake(
-                    clampedCopyExtentWidth, copyExtent.height - textureFormat.blockHeight, 1);
-
-                ++copy.count;
-
-                // Update offset to copy to the last row.
-                currentOffset += (copyBlockRowCount - 1) * bytesPerRow;
-            }
-
-            // Doing the last row copy with the exact number of bytes in last row.
-            // Workaround this issue in a way just like the copy to a 1D texture.
-            uint32_t lastRowDataSize =
-                (copyExtent.width / textureFormat.blockWidth) * textureFormat.blockByteSize;
-            uint32_t lastRowCopyExtentHeight =
-                textureFormat.blockHeight + clampedCopyExtentHeight - copyExtent.height;
-            ASSERT(lastRowCopyExtentHeight <= textureFormat.blockHeight);
-
-            copy.copies[copy.count].bufferOffset = currentOffset;
-            copy.copies[copy.count].bytesPerRow = lastRowDataSize;
-            copy.copies[copy.count].bytesPerImage = lastRowDataSize;
-            copy.copies[copy.count].textureOrigin =
-                MTLOriginMake(origin.x, origin.y + copyExtent.height - textureFormat.blockHeight,
-                              origin.z + copyExtent.depth - 1);
-            copy.copies[copy.count].copyExtent =
-                MTLSizeMake(clampedCopyExtentWidth, lastRowCopyExtentHeight, 1);
-            ++copy.count;
-
-            return copy;
-        }
-
         void EnsureSourceTextureInitialized(Texture* texture,
                                             const Extent3D& size,
                                             const TextureCopy& src) {
@@ -493,6 +369,11 @@ namespace dawn_native { namespace metal {
                                     uint32_t dynamicOffsetCount,
                                     uint64_t* dynamicOffsets,
                                     PipelineLayout* pipelineLayout) {
+                if (group->GetArgumentBuffer() != nil) {
+                    ApplyArgumentBuffer(render, compute, index, group, pipelineLayout);
+                    return;
+                }
+
                 uint32_t currentDynamicBufferIndex = 0;
 
                 // TODO(kainino@chromium.org): Maintain buffers and offsets arrays in BindGroup
@@ -620,6 +501,83 @@ namespace dawn_native { namespace metal {
                 }
             }
 
+            // Fast path for bind groups that were pre-encoded into an argument buffer: bind
+            // the single buffer per stage and make its resources resident, instead of one
+            // set*{Buffer,Texture,SamplerState} call per resource.
+            void ApplyArgumentBuffer(id<MTLRenderCommandEncoder> render,
+                                     id<MTLComputeCommandEncoder> compute,
+                                     uint32_t index,
+                                     BindGroup* group,
+                                     PipelineLayout* pipelineLayout) {
+                if (@available(macOS 10.13, iOS 11.0, *)) {
+                    id<MTLBuffer> argumentBuffer = group->GetArgumentBuffer();
+
+                    if (render != nil) {
+                        [render setVertexBuffer:argumentBuffer
+                                         offset:0
+                                        atIndex:pipelineLayout->GetArgumentBufferIndex(
+                                                    SingleShaderStage::Vertex, index)];
+                        [render setFragmentBuffer:argumentBuffer
+                                           offset:0
+                                          atIndex:pipelineLayout->GetArgumentBufferIndex(
+                                                      SingleShaderStage::Fragment, index)];
+                    }
+                    if (compute != nil) {
+                        [compute setBuffer:argumentBuffer
+                                    offset:0
+                                   atIndex:pipelineLayout->GetArgumentBufferIndex(
+                                               SingleShaderStage::Compute, index)];
+                    }
+
+                    // Argument buffers only reference their resources, they must be made
+                    // resident explicitly.
+                    const BindGroupLayoutBase* layout = group->GetLayout();
+                    for (BindingIndex bindingIndex = 0; bindingIndex < layout->GetBindingCount();
+                         ++bindingIndex) {
+                        const BindingInfo& bindingInfo = layout->GetBindingInfo(bindingIndex);
+
+                        id<MTLResource> resource = nil;
+                        MTLResourceUsage usage = MTLResourceUsageRead;
+                        switch (bindingInfo.type) {
+                            case wgpu::BindingType::UniformBuffer:
+                                resource =
+                                    ToBackend(
+                                        group->GetBindingAsBufferBinding(bindingIndex).buffer)
+                                        ->GetMTLBuffer();
+                                break;
+                            case wgpu::BindingType::SampledTexture:
+                            case wgpu::BindingType::ReadonlyStorageTexture:
+                                resource = ToBackend(group->GetBindingAsTextureView(bindingIndex))
+                                               ->GetMTLTexture();
+                                usage |= MTLResourceUsageSample;
+                                break;
+                            case wgpu::BindingType::WriteonlyStorageTexture:
+                                resource = ToBackend(group->GetBindingAsTextureView(bindingIndex))
+                                               ->GetMTLTexture();
+                                usage = MTLResourceUsageWrite;
+                                break;
+                            case wgpu::BindingType::Sampler:
+                            case wgpu::BindingType::ComparisonSampler:
+                                // Samplers aren't resources and are always resident.
+                                break;
+                            default:
+                                UNREACHABLE();
+                                break;
+                        }
+
+                        if (resource == nil) {
+                            continue;
+                        }
+                        if (render != nil) {
+                            [render useResource:resource usage:usage];
+                        }
+                        if (compute != nil) {
+                            [compute useResource:resource usage:usage];
+                        }
+                    }
+                }
+            }
+
             template <typename... Args>
             void ApplyBindGroup(id<MTLRenderCommandEncoder> encoder, Args&&... args) {
                 ApplyBindGroupImpl(encoder, nil, std::forward<Args&&>(args)...);
@@ -675,6 +633,282 @@ namespace dawn_native { namespace metal {
             std::array<NSUInteger, kMaxVertexBuffers> mVertexBufferOffsets;
         };
 
+        // Encodes the commands of one render pass (or one slice of it, with parallel
+        // encoding) into a single MTLRenderCommandEncoder, holding the lazily-applied
+        // state the draws depend on. Every encoder needs its own instance because the
+        // state trackers mirror what was set on that encoder; sibling encoders of a
+        // MTLParallelRenderCommandEncoder each run one instance on a worker thread.
+        class RenderPassCommandEncoder {
+          public:
+            RenderPassCommandEncoder(id<MTLRenderCommandEncoder> encoder,
+                                     uint32_t width,
+                                     uint32_t height)
+                : mEncoder(encoder), mWidth(width), mHeight(height) {
+            }
+
+            void EncodeCommand(CommandIterator* iter, Command type) {
+                switch (type) {
+                    case Command::Draw: {
+                        DrawCmd* draw = iter->NextCommand<DrawCmd>();
+
+                        mVertexBuffers.Apply(mEncoder, mLastPipeline);
+                        mBindGroups.Apply(mEncoder);
+                        mStorageBufferLengths.Apply(mEncoder, mLastPipeline);
+
+                        // The instance count must be non-zero, otherwise no-op
+                        if (draw->instanceCount != 0) {
+                            // MTLFeatureSet_iOS_GPUFamily3_v1 does not support baseInstance
+                            if (draw->firstInstance == 0) {
+                                [mEncoder drawPrimitives:mLastPipeline->GetMTLPrimitiveTopology()
+                                             vertexStart:draw->firstVertex
+                                             vertexCount:draw->vertexCount
+                                           instanceCount:draw->instanceCount];
+                            } else {
+                                [mEncoder drawPrimitives:mLastPipeline->GetMTLPrimitiveTopology()
+                                             vertexStart:draw->firstVertex
+                                             vertexCount:draw->vertexCount
+                                           instanceCount:draw->instanceCount
+                                            baseInstance:draw->firstInstance];
+                            }
+                        }
+                        break;
+                    }
+
+                    case Command::DrawIndexed: {
+                        DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
+                        size_t formatSize = IndexFormatSize(
+                            mLastPipeline->GetVertexStateDescriptor()->indexFormat);
+
+                        mVertexBuffers.Apply(mEncoder, mLastPipeline);
+                        mBindGroups.Apply(mEncoder);
+                        mStorageBufferLengths.Apply(mEncoder, mLastPipeline);
+
+                        // The index and instance count must be non-zero, otherwise no-op
+                        if (draw->indexCount != 0 && draw->instanceCount != 0) {
+                            // MTLFeatureSet_iOS_GPUFamily3_v1 does not support baseInstance and
+                            // baseVertex.
+                            if (draw->baseVertex == 0 && draw->firstInstance == 0) {
+                                [mEncoder
+                                    drawIndexedPrimitives:mLastPipeline->GetMTLPrimitiveTopology()
+                                               indexCount:draw->indexCount
+                                                indexType:mLastPipeline->GetMTLIndexType()
+                                              indexBuffer:mIndexBuffer
+                                        indexBufferOffset:mIndexBufferBaseOffset +
+                                                          draw->firstIndex * formatSize
+                                            instanceCount:draw->instanceCount];
+                            } else {
+                                [mEncoder
+                                    drawIndexedPrimitives:mLastPipeline->GetMTLPrimitiveTopology()
+                                               indexCount:draw->indexCount
+                                                indexType:mLastPipeline->GetMTLIndexType()
+                                              indexBuffer:mIndexBuffer
+                                        indexBufferOffset:mIndexBufferBaseOffset +
+                                                          draw->firstIndex * formatSize
+                                            instanceCount:draw->instanceCount
+                                               baseVertex:draw->baseVertex
+                                             baseInstance:draw->firstInstance];
+                            }
+                        }
+                        break;
+                    }
+
+                    case Command::DrawIndirect: {
+                        DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
+
+                        mVertexBuffers.Apply(mEncoder, mLastPipeline);
+                        mBindGroups.Apply(mEncoder);
+                        mStorageBufferLengths.Apply(mEncoder, mLastPipeline);
+
+                        Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+                        id<MTLBuffer> indirectBuffer = buffer->GetMTLBuffer();
+                        [mEncoder drawPrimitives:mLastPipeline->GetMTLPrimitiveTopology()
+                                  indirectBuffer:indirectBuffer
+                            indirectBufferOffset:draw->indirectOffset];
+                        break;
+                    }
+
+                    case Command::DrawIndexedIndirect: {
+                        DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
+
+                        mVertexBuffers.Apply(mEncoder, mLastPipeline);
+                        mBindGroups.Apply(mEncoder);
+                        mStorageBufferLengths.Apply(mEncoder, mLastPipeline);
+
+                        Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+                        id<MTLBuffer> indirectBuffer = buffer->GetMTLBuffer();
+                        [mEncoder drawIndexedPrimitives:mLastPipeline->GetMTLPrimitiveTopology()
+                                              indexType:mLastPipeline->GetMTLIndexType()
+                                            indexBuffer:mIndexBuffer
+                                      indexBufferOffset:mIndexBufferBaseOffset
+                                         indirectBuffer:indirectBuffer
+                                   indirectBufferOffset:draw->indirectOffset];
+                        break;
+                    }
+
+                    case Command::MultiDrawIndexedIndirect: {
+                        MultiDrawIndexedIndirectCmd* draw =
+                            iter->NextCommand<MultiDrawIndexedIndirectCmd>();
+
+                        mVertexBuffers.Apply(mEncoder, mLastPipeline);
+                        mBindGroups.Apply(mEncoder);
+                        mStorageBufferLengths.Apply(mEncoder, mLastPipeline);
+
+                        // Metal has no count buffer equivalent so maxDrawCount draws are always
+                        // issued. Unused trailing entries must be zeroed, making them no-op draws.
+                        Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
+                        id<MTLBuffer> indirectBuffer = buffer->GetMTLBuffer();
+                        for (uint32_t i = 0; i < draw->maxDrawCount; ++i) {
+                            [mEncoder drawIndexedPrimitives:mLastPipeline->GetMTLPrimitiveTopology()
+                                                  indexType:mLastPipeline->GetMTLIndexType()
+                                                indexBuffer:mIndexBuffer
+                                          indexBufferOffset:mIndexBufferBaseOffset
+                                             indirectBuffer:indirectBuffer
+                                       indirectBufferOffset:draw->indirectOffset +
+                                                            i * kDrawIndexedIndirectSize];
+                        }
+                        break;
+                    }
+
+                    case Command::InsertDebugMarker: {
+                        InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
+                        char* label = iter->NextData<char>(cmd->length + 1);
+                        NSString* mtlLabel = [[NSString alloc] initWithUTF8String:label];
+
+                        [mEncoder insertDebugSignpost:mtlLabel];
+                        [mtlLabel release];
+                        break;
+                    }
+
+                    case Command::PopDebugGroup: {
+                        iter->NextCommand<PopDebugGroupCmd>();
+
+                        [mEncoder popDebugGroup];
+                        break;
+                    }
+
+                    case Command::PushDebugGroup: {
+                        PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
+                        char* label = iter->NextData<char>(cmd->length + 1);
+                        NSString* mtlLabel = [[NSString alloc] initWithUTF8String:label];
+
+                        [mEncoder pushDebugGroup:mtlLabel];
+                        [mtlLabel release];
+                        break;
+                    }
+
+                    case Command::SetRenderPipeline: {
+                        SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
+                        RenderPipeline* newPipeline = ToBackend(cmd->pipeline).Get();
+
+                        mVertexBuffers.OnSetPipeline(mLastPipeline, newPipeline);
+                        mBindGroups.OnSetPipeline(newPipeline);
+
+                        [mEncoder setDepthStencilState:newPipeline->GetMTLDepthStencilState()];
+                        [mEncoder setFrontFacingWinding:newPipeline->GetMTLFrontFace()];
+                        [mEncoder setCullMode:newPipeline->GetMTLCullMode()];
+                        newPipeline->Encode(mEncoder);
+
+                        mLastPipeline = newPipeline;
+                        break;
+                    }
+
+                    case Command::SetBindGroup: {
+                        SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
+                        uint32_t* dynamicOffsets = nullptr;
+                        if (cmd->dynamicOffsetCount > 0) {
+                            dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                        }
+
+                        mBindGroups.OnSetBindGroup(cmd->index, ToBackend(cmd->group.Get()),
+                                                   cmd->dynamicOffsetCount, dynamicOffsets);
+                        break;
+                    }
+
+                    case Command::SetIndexBuffer: {
+                        SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
+                        auto b = ToBackend(cmd->buffer.Get());
+                        mIndexBuffer = b->GetMTLBuffer();
+                        mIndexBufferBaseOffset = cmd->offset;
+                        break;
+                    }
+
+                    case Command::SetVertexBuffer: {
+                        SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
+
+                        mVertexBuffers.OnSetVertexBuffer(cmd->slot, ToBackend(cmd->buffer.Get()),
+                                                         cmd->offset);
+                        break;
+                    }
+
+                    case Command::SetStencilReference: {
+                        SetStencilReferenceCmd* cmd = iter->NextCommand<SetStencilReferenceCmd>();
+                        [mEncoder setStencilReferenceValue:cmd->reference];
+                        break;
+                    }
+
+                    case Command::SetViewport: {
+                        SetViewportCmd* cmd = iter->NextCommand<SetViewportCmd>();
+                        MTLViewport viewport;
+                        viewport.originX = cmd->x;
+                        viewport.originY = cmd->y;
+                        viewport.width = cmd->width;
+                        viewport.height = cmd->height;
+                        viewport.znear = cmd->minDepth;
+                        viewport.zfar = cmd->maxDepth;
+
+                        [mEncoder setViewport:viewport];
+                        break;
+                    }
+
+                    case Command::SetScissorRect: {
+                        SetScissorRectCmd* cmd = iter->NextCommand<SetScissorRectCmd>();
+                        MTLScissorRect rect;
+                        rect.x = cmd->x;
+                        rect.y = cmd->y;
+                        rect.width = cmd->width;
+                        rect.height = cmd->height;
+
+                        // The scissor rect x + width must be <= render pass width
+                        if ((rect.x + rect.width) > mWidth) {
+                            rect.width = mWidth - rect.x;
+                        }
+                        // The scissor rect y + height must be <= render pass height
+                        if ((rect.y + rect.height > mHeight)) {
+                            rect.height = mHeight - rect.y;
+                        }
+
+                        [mEncoder setScissorRect:rect];
+                        break;
+                    }
+
+                    case Command::SetBlendColor: {
+                        SetBlendColorCmd* cmd = iter->NextCommand<SetBlendColorCmd>();
+                        [mEncoder setBlendColorRed:cmd->color.r
+                                             green:cmd->color.g
+                                              blue:cmd->color.b
+                                             alpha:cmd->color.a];
+                        break;
+                    }
+
+                    default:
+                        UNREACHABLE();
+                        break;
+                }
+            }
+
+          private:
+            id<MTLRenderCommandEncoder> mEncoder;
+            uint32_t mWidth;
+            uint32_t mHeight;
+
+            RenderPipeline* mLastPipeline = nullptr;
+            id<MTLBuffer> mIndexBuffer = nil;
+            uint32_t mIndexBufferBaseOffset = 0;
+            VertexBufferTracker mVertexBuffers;
+            StorageBufferLengthTracker mStorageBufferLengths = {};
+            BindGroupTracker mBindGroups{&mStorageBufferLengths};
+        };
+
     }  // anonymous namespace
 
     CommandBuffer::CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor)
@@ -743,6 +977,27 @@ namespace dawn_native { namespace metal {
                     break;
                 }
 
+                case Command::CopyBufferToBufferBatch: {
+                    CopyBufferToBufferBatchCmd* copy =
+                        mCommands.NextCommand<CopyBufferToBufferBatchCmd>();
+                    const BufferCopyRegion* regions =
+                        mCommands.NextData<BufferCopyRegion>(copy->regionCount);
+
+                    // Metal has no multi-region blit; the single blit encoder amortizes the
+                    // per-command cost across the batch.
+                    id<MTLBlitCommandEncoder> blit = commandContext->EnsureBlit();
+                    id<MTLBuffer> srcBuffer = ToBackend(copy->source)->GetMTLBuffer();
+                    id<MTLBuffer> dstBuffer = ToBackend(copy->destination)->GetMTLBuffer();
+                    for (uint32_t i = 0; i < copy->regionCount; ++i) {
+                        [blit copyFromBuffer:srcBuffer
+                                sourceOffset:regions[i].sourceOffset
+                                    toBuffer:dstBuffer
+                           destinationOffset:regions[i].destinationOffset
+                                        size:regions[i].size];
+                    }
+                    break;
+                }
+
                 case Command::CopyBufferToTexture: {
                     CopyBufferToTextureCmd* copy = mCommands.NextCommand<CopyBufferToTextureCmd>();
                     auto& src = copy->source;
@@ -863,6 +1118,28 @@ namespace dawn_native { namespace metal {
                     break;
                 }
 
+                case Command::DispatchBatch: {
+                    DispatchBatchCmd* dispatch = mCommands.NextCommand<DispatchBatchCmd>();
+                    DispatchBatchEntry* entries =
+                        mCommands.NextData<DispatchBatchEntry>(dispatch->entryCount);
+                    BindGroup* group = ToBackend(dispatch->group.Get());
+
+                    // Each entry only moves the dynamic offset, so Apply() re-binds the
+                    // single dirty group and the loop stays a tight bind+dispatch pair per
+                    // entry.
+                    for (uint32_t i = 0; i < dispatch->entryCount; ++i) {
+                        bindGroups.OnSetBindGroup(dispatch->groupIndex, group, 1,
+                                                  &entries[i].dynamicOffset);
+                        bindGroups.Apply(encoder);
+                        storageBufferLengths.Apply(encoder, lastPipeline);
+
+                        [encoder dispatchThreadgroups:MTLSizeMake(entries[i].x, entries[i].y,
+                                                                  entries[i].z)
+                                threadsPerThreadgroup:lastPipeline->GetLocalWorkGroupSize()];
+                    }
+                    break;
+                }
+
                 case Command::DispatchIndirect: {
                     DispatchIndirectCmd* dispatch = mCommands.NextCommand<DispatchIndirectCmd>();
 
@@ -1034,271 +1311,321 @@ namespace dawn_native { namespace metal {
                                                  MTLRenderPassDescriptor* mtlRenderPass,
                                                  uint32_t width,
                                                  uint32_t height) {
-        RenderPipeline* lastPipeline = nullptr;
-        id<MTLBuffer> indexBuffer = nil;
-        uint32_t indexBufferBaseOffset = 0;
-        VertexBufferTracker vertexBuffers;
-        StorageBufferLengthTracker storageBufferLengths = {};
-        BindGroupTracker bindGroups(&storageBufferLengths);
+        if (TryEncodeRenderPassInParallel(commandContext, mtlRenderPass, width, height)) {
+            return;
+        }
 
-        id<MTLRenderCommandEncoder> encoder = commandContext->BeginRender(mtlRenderPass);
+        RenderPassCommandEncoder passEncoder(commandContext->BeginRender(mtlRenderPass), width,
+                                             height);
 
-        auto EncodeRenderBundleCommand = [&](CommandIterator* iter, Command type) {
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
             switch (type) {
-                case Command::Draw: {
-                    DrawCmd* draw = iter->NextCommand<DrawCmd>();
+                case Command::EndRenderPass: {
+                    mCommands.NextCommand<EndRenderPassCmd>();
+                    commandContext->EndRender();
+                    return;
+                }
 
-                    vertexBuffers.Apply(encoder, lastPipeline);
-                    bindGroups.Apply(encoder);
-                    storageBufferLengths.Apply(encoder, lastPipeline);
+                case Command::ExecuteBundles: {
+                    ExecuteBundlesCmd* cmd = mCommands.NextCommand<ExecuteBundlesCmd>();
+                    auto bundles = mCommands.NextData<Ref<RenderBundleBase>>(cmd->count);
 
-                    // The instance count must be non-zero, otherwise no-op
-                    if (draw->instanceCount != 0) {
-                        // MTLFeatureSet_iOS_GPUFamily3_v1 does not support baseInstance
-                        if (draw->firstInstance == 0) {
-                            [encoder drawPrimitives:lastPipeline->GetMTLPrimitiveTopology()
-                                        vertexStart:draw->firstVertex
-                                        vertexCount:draw->vertexCount
-                                      instanceCount:draw->instanceCount];
-                        } else {
-                            [encoder drawPrimitives:lastPipeline->GetMTLPrimitiveTopology()
-                                        vertexStart:draw->firstVertex
-                                        vertexCount:draw->vertexCount
-                                      instanceCount:draw->instanceCount
-                                       baseInstance:draw->firstInstance];
+                    for (uint32_t i = 0; i < cmd->count; ++i) {
+                        CommandIterator* iter = bundles[i]->GetCommands();
+                        iter->Reset();
+                        while (iter->NextCommandId(&type)) {
+                            passEncoder.EncodeCommand(iter, type);
                         }
                     }
                     break;
                 }
 
-                case Command::DrawIndexed: {
-                    DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
-                    size_t formatSize =
-                        IndexFormatSize(lastPipeline->GetVertexStateDescriptor()->indexFormat);
-
-                    vertexBuffers.Apply(encoder, lastPipeline);
-                    bindGroups.Apply(encoder);
-                    storageBufferLengths.Apply(encoder, lastPipeline);
-
-                    // The index and instance count must be non-zero, otherwise no-op
-                    if (draw->indexCount != 0 && draw->instanceCount != 0) {
-                        // MTLFeatureSet_iOS_GPUFamily3_v1 does not support baseInstance and
-                        // baseVertex.
-                        if (draw->baseVertex == 0 && draw->firstInstance == 0) {
-                            [encoder drawIndexedPrimitives:lastPipeline->GetMTLPrimitiveTopology()
-                                                indexCount:draw->indexCount
-                                                 indexType:lastPipeline->GetMTLIndexType()
-                                               indexBuffer:indexBuffer
-                                         indexBufferOffset:indexBufferBaseOffset +
-                                                           draw->firstIndex * formatSize
-                                             instanceCount:draw->instanceCount];
-                        } else {
-                            [encoder drawIndexedPrimitives:lastPipeline->GetMTLPrimitiveTopology()
-                                                indexCount:draw->indexCount
-                                                 indexType:lastPipeline->GetMTLIndexType()
-                                               indexBuffer:indexBuffer
-                                         indexBufferOffset:indexBufferBaseOffset +
-                                                           draw->firstIndex * formatSize
-                                             instanceCount:draw->instanceCount
-                                                baseVertex:draw->baseVertex
-                                              baseInstance:draw->firstInstance];
-                        }
-                    }
+                default: {
+                    passEncoder.EncodeCommand(&mCommands, type);
                     break;
                 }
+            }
+        }
 
-                case Command::DrawIndirect: {
-                    DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
-
-                    vertexBuffers.Apply(encoder, lastPipeline);
-                    bindGroups.Apply(encoder);
-                    storageBufferLengths.Apply(encoder, lastPipeline);
+        // EndRenderPass should have been called
+        UNREACHABLE();
+    }
 
-                    Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
-                    id<MTLBuffer> indirectBuffer = buffer->GetMTLBuffer();
-                    [encoder drawPrimitives:lastPipeline->GetMTLPrimitiveTopology()
-                              indirectBuffer:indirectBuffer
-                        indirectBufferOffset:draw->indirectOffset];
-                    break;
-                }
+    bool CommandBuffer::TryEncodeRenderPassInParallel(CommandRecordingContext* commandContext,
+                                                      MTLRenderPassDescriptor* mtlRenderPass,
+                                                      uint32_t width,
+                                                      uint32_t height) {
+        dawn_platform::Platform* platform = GetDevice()->GetPlatform();
+        if (platform == nullptr) {
+            return false;
+        }
+        dawn_platform::WorkerTaskPool* workerPool = platform->GetWorkerTaskPool();
+        if (workerPool == nullptr || workerPool->GetMaxConcurrentTasks() <= 1) {
+            return false;
+        }
 
-                case Command::DrawIndexedIndirect: {
-                    DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
+        const size_t passStart = mCommands.GetPosition();
 
-                    vertexBuffers.Apply(encoder, lastPipeline);
-                    bindGroups.Apply(encoder);
-                    storageBufferLengths.Apply(encoder, lastPipeline);
+        // First pass over the commands: count the draws to decide whether splitting the
+        // encode is worth it. Bundles replay shared iterators and debug groups must stay
+        // balanced within one encoder, so passes using either take the serial path.
+        uint64_t drawCount = 0;
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            switch (type) {
+                case Command::Draw:
+                case Command::DrawIndexed:
+                case Command::DrawIndirect:
+                case Command::DrawIndexedIndirect:
+                    drawCount++;
+                    SkipCommand(&mCommands, type);
+                    break;
 
-                    Buffer* buffer = ToBackend(draw->indirectBuffer.Get());
-                    id<MTLBuffer> indirectBuffer = buffer->GetMTLBuffer();
-                    [encoder drawIndexedPrimitives:lastPipeline->GetMTLPrimitiveTopology()
-                                         indexType:lastPipeline->GetMTLIndexType()
-                                       indexBuffer:indexBuffer
-                                 indexBufferOffset:indexBufferBaseOffset
-                                    indirectBuffer:indirectBuffer
-                              indirectBufferOffset:draw->indirectOffset];
+                case Command::MultiDrawIndexedIndirect: {
+                    MultiDrawIndexedIndirectCmd* cmd =
+                        mCommands.NextCommand<MultiDrawIndexedIndirectCmd>();
+                    drawCount += cmd->maxDrawCount;
                     break;
                 }
 
-                case Command::InsertDebugMarker: {
-                    InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
-                    char* label = iter->NextData<char>(cmd->length + 1);
-                    NSString* mtlLabel = [[NSString alloc] initWithUTF8String:label];
+                case Command::SetRenderPipeline:
+                case Command::SetBindGroup:
+                case Command::SetIndexBuffer:
+                case Command::SetVertexBuffer:
+                case Command::SetStencilReference:
+                case Command::SetViewport:
+                case Command::SetScissorRect:
+                case Command::SetBlendColor:
+                    SkipCommand(&mCommands, type);
+                    break;
 
-                    [encoder insertDebugSignpost:mtlLabel];
-                    [mtlLabel release];
+                case Command::EndRenderPass:
+                    SkipCommand(&mCommands, type);
                     break;
-                }
 
-                case Command::PopDebugGroup: {
-                    iter->NextCommand<PopDebugGroupCmd>();
+                default:
+                    mCommands.SeekTo(passStart);
+                    return false;
+            }
+            if (type == Command::EndRenderPass) {
+                break;
+            }
+        }
 
-                    [encoder popDebugGroup];
-                    break;
+        uint32_t encoderCount = static_cast<uint32_t>(
+            std::min<uint64_t>(workerPool->GetMaxConcurrentTasks(),
+                               drawCount / kMinDrawsPerParallelRenderEncoder));
+        if (encoderCount < 2) {
+            mCommands.SeekTo(passStart);
+            return false;
+        }
+        const uint64_t drawsPerEncoder = (drawCount + encoderCount - 1) / encoderCount;
+
+        // Second pass: split the commands into one tape per encoder, at draw boundaries.
+        // State setting commands persist across the split points, so the latest one of
+        // each kind is remembered and replayed at the start of the next tape.
+        mCommands.SeekTo(passStart);
+
+        SetRenderPipelineCmd* lastPipeline = nullptr;
+        SetIndexBufferCmd* lastIndexBuffer = nullptr;
+        std::array<SetBindGroupCmd*, kMaxBindGroups> lastBindGroups = {};
+        std::array<uint32_t*, kMaxBindGroups> lastDynamicOffsets = {};
+        std::array<SetVertexBufferCmd*, kMaxVertexBuffers> lastVertexBuffers = {};
+        SetStencilReferenceCmd* lastStencilReference = nullptr;
+        SetViewportCmd* lastViewport = nullptr;
+        SetScissorRectCmd* lastScissorRect = nullptr;
+        SetBlendColorCmd* lastBlendColor = nullptr;
+
+        std::vector<CommandIterator> chunks;
+        std::unique_ptr<CommandAllocator> currentChunk = std::make_unique<CommandAllocator>();
+        uint64_t drawsInChunk = 0;
+
+        auto CopyBindGroup = [](CommandAllocator* out, SetBindGroupCmd* cmd,
+                                uint32_t* dynamicOffsets) {
+            *out->Allocate<SetBindGroupCmd>(Command::SetBindGroup) = *cmd;
+            if (cmd->dynamicOffsetCount > 0) {
+                uint32_t* offsets = out->AllocateData<uint32_t>(cmd->dynamicOffsetCount);
+                memcpy(offsets, dynamicOffsets, cmd->dynamicOffsetCount * sizeof(uint32_t));
+            }
+        };
+
+        auto BeginNextChunk = [&]() {
+            chunks.emplace_back(std::move(*currentChunk));
+            currentChunk = std::make_unique<CommandAllocator>();
+            drawsInChunk = 0;
+
+            if (lastViewport != nullptr) {
+                *currentChunk->Allocate<SetViewportCmd>(Command::SetViewport) = *lastViewport;
+            }
+            if (lastScissorRect != nullptr) {
+                *currentChunk->Allocate<SetScissorRectCmd>(Command::SetScissorRect) =
+                    *lastScissorRect;
+            }
+            if (lastBlendColor != nullptr) {
+                *currentChunk->Allocate<SetBlendColorCmd>(Command::SetBlendColor) =
+                    *lastBlendColor;
+            }
+            if (lastStencilReference != nullptr) {
+                *currentChunk->Allocate<SetStencilReferenceCmd>(Command::SetStencilReference) =
+                    *lastStencilReference;
+            }
+            if (lastPipeline != nullptr) {
+                *currentChunk->Allocate<SetRenderPipelineCmd>(Command::SetRenderPipeline) =
+                    *lastPipeline;
+            }
+            if (lastIndexBuffer != nullptr) {
+                *currentChunk->Allocate<SetIndexBufferCmd>(Command::SetIndexBuffer) =
+                    *lastIndexBuffer;
+            }
+            for (uint32_t slot = 0; slot < kMaxVertexBuffers; ++slot) {
+                if (lastVertexBuffers[slot] != nullptr) {
+                    *currentChunk->Allocate<SetVertexBufferCmd>(Command::SetVertexBuffer) =
+                        *lastVertexBuffers[slot];
+                }
+            }
+            for (uint32_t index = 0; index < kMaxBindGroups; ++index) {
+                if (lastBindGroups[index] != nullptr) {
+                    CopyBindGroup(currentChunk.get(), lastBindGroups[index], lastDynamicOffsets[index]);
                 }
+            }
+        };
 
-                case Command::PushDebugGroup: {
-                    PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
-                    char* label = iter->NextData<char>(cmd->length + 1);
-                    NSString* mtlLabel = [[NSString alloc] initWithUTF8String:label];
+        while (mCommands.NextCommandId(&type)) {
+            if (type == Command::EndRenderPass) {
+                mCommands.NextCommand<EndRenderPassCmd>();
+                break;
+            }
 
-                    [encoder pushDebugGroup:mtlLabel];
-                    [mtlLabel release];
+            bool isDraw = false;
+            switch (type) {
+                case Command::Draw:
+                    isDraw = true;
+                    *currentChunk->Allocate<DrawCmd>(type) = *mCommands.NextCommand<DrawCmd>();
                     break;
-                }
 
-                case Command::SetRenderPipeline: {
-                    SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
-                    RenderPipeline* newPipeline = ToBackend(cmd->pipeline).Get();
+                case Command::DrawIndexed:
+                    isDraw = true;
+                    *currentChunk->Allocate<DrawIndexedCmd>(type) =
+                        *mCommands.NextCommand<DrawIndexedCmd>();
+                    break;
 
-                    vertexBuffers.OnSetPipeline(lastPipeline, newPipeline);
-                    bindGroups.OnSetPipeline(newPipeline);
+                case Command::DrawIndirect:
+                case Command::DrawIndexedIndirect:
+                    isDraw = true;
+                    *currentChunk->Allocate<DrawIndirectCmd>(type) =
+                        *mCommands.NextCommand<DrawIndirectCmd>();
+                    break;
 
-                    [encoder setDepthStencilState:newPipeline->GetMTLDepthStencilState()];
-                    [encoder setFrontFacingWinding:newPipeline->GetMTLFrontFace()];
-                    [encoder setCullMode:newPipeline->GetMTLCullMode()];
-                    newPipeline->Encode(encoder);
+                case Command::MultiDrawIndexedIndirect:
+                    isDraw = true;
+                    *currentChunk->Allocate<MultiDrawIndexedIndirectCmd>(type) =
+                        *mCommands.NextCommand<MultiDrawIndexedIndirectCmd>();
+                    break;
 
-                    lastPipeline = newPipeline;
+                case Command::SetRenderPipeline:
+                    lastPipeline = mCommands.NextCommand<SetRenderPipelineCmd>();
+                    *currentChunk->Allocate<SetRenderPipelineCmd>(type) = *lastPipeline;
                     break;
-                }
 
                 case Command::SetBindGroup: {
-                    SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
+                    SetBindGroupCmd* cmd = mCommands.NextCommand<SetBindGroupCmd>();
                     uint32_t* dynamicOffsets = nullptr;
                     if (cmd->dynamicOffsetCount > 0) {
-                        dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                        dynamicOffsets = mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
                     }
-
-                    bindGroups.OnSetBindGroup(cmd->index, ToBackend(cmd->group.Get()),
-                                              cmd->dynamicOffsetCount, dynamicOffsets);
+                    lastBindGroups[cmd->index] = cmd;
+                    lastDynamicOffsets[cmd->index] = dynamicOffsets;
+                    CopyBindGroup(currentChunk.get(), cmd, dynamicOffsets);
                     break;
                 }
 
-                case Command::SetIndexBuffer: {
-                    SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
-                    auto b = ToBackend(cmd->buffer.Get());
-                    indexBuffer = b->GetMTLBuffer();
-                    indexBufferBaseOffset = cmd->offset;
+                case Command::SetIndexBuffer:
+                    lastIndexBuffer = mCommands.NextCommand<SetIndexBufferCmd>();
+                    *currentChunk->Allocate<SetIndexBufferCmd>(type) = *lastIndexBuffer;
                     break;
-                }
 
                 case Command::SetVertexBuffer: {
-                    SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
-
-                    vertexBuffers.OnSetVertexBuffer(cmd->slot, ToBackend(cmd->buffer.Get()),
-                                                    cmd->offset);
+                    SetVertexBufferCmd* cmd = mCommands.NextCommand<SetVertexBufferCmd>();
+                    lastVertexBuffers[cmd->slot] = cmd;
+                    *currentChunk->Allocate<SetVertexBufferCmd>(type) = *cmd;
                     break;
                 }
 
-                default:
-                    UNREACHABLE();
+                case Command::SetStencilReference:
+                    lastStencilReference = mCommands.NextCommand<SetStencilReferenceCmd>();
+                    *currentChunk->Allocate<SetStencilReferenceCmd>(type) = *lastStencilReference;
                     break;
-            }
-        };
-
-        Command type;
-        while (mCommands.NextCommandId(&type)) {
-            switch (type) {
-                case Command::EndRenderPass: {
-                    mCommands.NextCommand<EndRenderPassCmd>();
-                    commandContext->EndRender();
-                    return;
-                }
 
-                case Command::SetStencilReference: {
-                    SetStencilReferenceCmd* cmd = mCommands.NextCommand<SetStencilReferenceCmd>();
-                    [encoder setStencilReferenceValue:cmd->reference];
+                case Command::SetViewport:
+                    lastViewport = mCommands.NextCommand<SetViewportCmd>();
+                    *currentChunk->Allocate<SetViewportCmd>(type) = *lastViewport;
                     break;
-                }
 
-                case Command::SetViewport: {
-                    SetViewportCmd* cmd = mCommands.NextCommand<SetViewportCmd>();
-                    MTLViewport viewport;
-                    viewport.originX = cmd->x;
-                    viewport.originY = cmd->y;
-                    viewport.width = cmd->width;
-                    viewport.height = cmd->height;
-                    viewport.znear = cmd->minDepth;
-                    viewport.zfar = cmd->maxDepth;
-
-                    [encoder setViewport:viewport];
+                case Command::SetScissorRect:
+                    lastScissorRect = mCommands.NextCommand<SetScissorRectCmd>();
+                    *currentChunk->Allocate<SetScissorRectCmd>(type) = *lastScissorRect;
                     break;
-                }
-
-                case Command::SetScissorRect: {
-                    SetScissorRectCmd* cmd = mCommands.NextCommand<SetScissorRectCmd>();
-                    MTLScissorRect rect;
-                    rect.x = cmd->x;
-                    rect.y = cmd->y;
-                    rect.width = cmd->width;
-                    rect.height = cmd->height;
-
-                    // The scissor rect x + width must be <= render pass width
-                    if ((rect.x + rect.width) > width) {
-                        rect.width = width - rect.x;
-                    }
-                    // The scissor rect y + height must be <= render pass height
-                    if ((rect.y + rect.height > height)) {
-                        rect.height = height - rect.y;
-                    }
 
-                    [encoder setScissorRect:rect];
+                case Command::SetBlendColor:
+                    lastBlendColor = mCommands.NextCommand<SetBlendColorCmd>();
+                    *currentChunk->Allocate<SetBlendColorCmd>(type) = *lastBlendColor;
                     break;
-                }
-
-                case Command::SetBlendColor: {
-                    SetBlendColorCmd* cmd = mCommands.NextCommand<SetBlendColorCmd>();
-                    [encoder setBlendColorRed:cmd->color.r
-                                        green:cmd->color.g
-                                         blue:cmd->color.b
-                                        alpha:cmd->color.a];
-                    break;
-                }
 
-                case Command::ExecuteBundles: {
-                    ExecuteBundlesCmd* cmd = mCommands.NextCommand<ExecuteBundlesCmd>();
-                    auto bundles = mCommands.NextData<Ref<RenderBundleBase>>(cmd->count);
-
-                    for (uint32_t i = 0; i < cmd->count; ++i) {
-                        CommandIterator* iter = bundles[i]->GetCommands();
-                        iter->Reset();
-                        while (iter->NextCommandId(&type)) {
-                            EncodeRenderBundleCommand(iter, type);
-                        }
-                    }
+                default:
+                    // The first pass already rejected everything else.
+                    UNREACHABLE();
                     break;
-                }
+            }
 
-                default: {
-                    EncodeRenderBundleCommand(&mCommands, type);
-                    break;
+            if (isDraw) {
+                drawsInChunk++;
+                if (drawsInChunk >= drawsPerEncoder && chunks.size() + 1 < encoderCount) {
+                    BeginNextChunk();
                 }
             }
         }
+        chunks.emplace_back(std::move(*currentChunk));
+
+        // The sub-encoders execute in creation order, so creating them on this thread in
+        // chunk order preserves the application's draw order.
+        id<MTLParallelRenderCommandEncoder> parallelEncoder = [commandContext->GetCommands()
+            parallelRenderCommandEncoderWithDescriptor:mtlRenderPass];
+        std::vector<id<MTLRenderCommandEncoder>> encoders(chunks.size());
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            encoders[i] = [parallelEncoder renderCommandEncoder];
+        }
 
-        // EndRenderPass should have been called
-        UNREACHABLE();
+        struct ChunkEncodeState {
+            std::vector<CommandIterator>* chunks;
+            std::vector<id<MTLRenderCommandEncoder>>* encoders;
+            uint32_t width;
+            uint32_t height;
+        };
+        ChunkEncodeState state = {&chunks, &encoders, width, height};
+
+        workerPool->ParallelFor(
+            static_cast<uint32_t>(chunks.size()),
+            [](void* userdata, uint32_t index) {
+                ChunkEncodeState* state = static_cast<ChunkEncodeState*>(userdata);
+                id<MTLRenderCommandEncoder> encoder = (*state->encoders)[index];
+                RenderPassCommandEncoder passEncoder(encoder, state->width, state->height);
+
+                CommandIterator* chunk = &(*state->chunks)[index];
+                Command type;
+                while (chunk->NextCommandId(&type)) {
+                    passEncoder.EncodeCommand(chunk, type);
+                }
+                [encoder endEncoding];
+            },
+            &state);
+
+        [parallelEncoder endEncoding];
+
+        for (CommandIterator& chunk : chunks) {
+            FreeCommands(&chunk);
+        }
+        return true;
     }
 
 }}  // namespace dawn_native::metal
@@ -16,6 +16,8 @@
 
 #include "dawn_native/BackendConnection.h"
 #include "dawn_native/BindGroupLayout.h"
+#include "dawn_native/CommandBuffer.h"
+#include "dawn_native/Commands.h"
 #include "dawn_native/ErrorData.h"
 #include "dawn_native/metal/BindGroupLayoutMTL.h"
 #include "dawn_native/metal/BindGroupMTL.h"
@@ -30,6 +32,7 @@
 #include "dawn_native/metal/StagingBufferMTL.h"
 #include "dawn_native/metal/SwapChainMTL.h"
 #include "dawn_native/metal/TextureMTL.h"
+#include "dawn_native/metal/UtilsMetal.h"
 #include "dawn_platform/DawnPlatform.h"
 #include "dawn_platform/tracing/TraceEvent.h"
 
@@ -98,6 +101,19 @@ namespace dawn_native { namespace metal {
 
         // TODO(jiawei.shao@intel.com): tighten this workaround when the driver bug is fixed.
         SetToggle(Toggle::AlwaysResolveIntoZeroLevelAndLayer, true);
+
+        {
+            // With Tier2 argument buffers a bind group can be pre-encoded into a single
+            // buffer bound in one call. The spvc compilation path doesn't expose the
+            // argument buffer options yet, so keep the per-resource path there.
+            bool haveTier2ArgumentBuffers = false;
+            if (@available(macOS 10.13, iOS 11.0, *)) {
+                haveTier2ArgumentBuffers =
+                    [mMtlDevice argumentBuffersSupport] == MTLArgumentBuffersTier2;
+            }
+            SetToggle(Toggle::MetalUseArgumentBuffers,
+                      haveTier2ArgumentBuffers && !IsToggleEnabled(Toggle::UseSpvc));
+        }
     }
     ResultOrError<BindGroupBase*> Device::CreateBindGroupImpl(
         const BindGroupDescriptor* descriptor) {
@@ -243,7 +259,15 @@ namespace dawn_native { namespace metal {
 
     ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateStagingBuffer(size_t size) {
         std::unique_ptr<StagingBufferBase> stagingBuffer =
-            std::make_unique<StagingBuffer>(size, this);
+            std::make_unique<StagingBuffer>(size, this, StagingAccess::Upload);
+        DAWN_TRY(stagingBuffer->Initialize());
+        return std::move(stagingBuffer);
+    }
+
+    ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateReadbackStagingBuffer(
+        size_t size) {
+        std::unique_ptr<StagingBufferBase> stagingBuffer =
+            std::make_unique<StagingBuffer>(size, this, StagingAccess::Readback);
         DAWN_TRY(stagingBuffer->Initialize());
         return std::move(stagingBuffer);
     }
@@ -268,6 +292,63 @@ namespace dawn_native { namespace metal {
         return {};
     }
 
+    MaybeError Device::CopyFromBufferToStaging(BufferBase* source,
+                                               uint64_t sourceOffset,
+                                               StagingBufferBase* destination,
+                                               uint64_t destinationOffset,
+                                               uint64_t size) {
+        // Metal validation layers forbid  0-sized copies, skip it since it is a noop.
+        if (size == 0) {
+            return {};
+        }
+
+        id<MTLBuffer> buffer = ToBackend(source)->GetMTLBuffer();
+        id<MTLBuffer> readbackBuffer = ToBackend(destination)->GetBufferHandle();
+        [GetPendingCommandContext()->EnsureBlit() copyFromBuffer:buffer
+                                                    sourceOffset:sourceOffset
+                                                        toBuffer:readbackBuffer
+                                               destinationOffset:destinationOffset
+                                                            size:size];
+        return {};
+    }
+
+    MaybeError Device::CopyFromStagingToTexture(StagingBufferBase* source,
+                                                uint64_t sourceOffset,
+                                                uint32_t bytesPerRow,
+                                                uint32_t rowsPerImage,
+                                                const TextureCopy& dst,
+                                                const Extent3D& copySizePixels) {
+        Texture* texture = ToBackend(dst.texture.Get());
+
+        // TODO(crbug.com/dawn/145): Specify multiple layers based on |copySizePixels|
+        if (IsCompleteSubresourceCopiedTo(texture, copySizePixels, dst.mipLevel)) {
+            texture->SetIsSubresourceContentInitialized(true, dst.mipLevel, 1, dst.arrayLayer, 1);
+        } else {
+            texture->EnsureSubresourceContentInitialized(dst.mipLevel, 1, dst.arrayLayer, 1);
+        }
+
+        Extent3D virtualSizeAtLevel = texture->GetMipLevelVirtualSize(dst.mipLevel);
+        TextureBufferCopySplit splittedCopies = ComputeTextureBufferCopySplit(
+            dst.origin, copySizePixels, texture->GetFormat(), virtualSizeAtLevel, source->GetSize(),
+            sourceOffset, bytesPerRow, rowsPerImage);
+
+        for (uint32_t i = 0; i < splittedCopies.count; ++i) {
+            const TextureBufferCopySplit::CopyInfo& copyInfo = splittedCopies.copies[i];
+            [GetPendingCommandContext()->EnsureBlit()
+                     copyFromBuffer:ToBackend(source)->GetBufferHandle()
+                       sourceOffset:copyInfo.bufferOffset
+                  sourceBytesPerRow:copyInfo.bytesPerRow
+                sourceBytesPerImage:copyInfo.bytesPerImage
+                         sourceSize:copyInfo.copyExtent
+                          toTexture:texture->GetMTLTexture()
+                   destinationSlice:dst.arrayLayer
+                   destinationLevel:dst.mipLevel
+                  destinationOrigin:copyInfo.textureOrigin];
+        }
+
+        return {};
+    }
+
     TextureBase* Device::CreateTextureWrappingIOSurface(const ExternalImageDescriptor* descriptor,
                                                         IOSurfaceRef ioSurface,
                                                         uint32_t plane) {
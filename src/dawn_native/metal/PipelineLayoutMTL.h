@@ -47,9 +47,14 @@ namespace dawn_native { namespace metal {
         // The number of Metal vertex stage buffers used for the whole pipeline layout.
         uint32_t GetBufferBindingCount(SingleShaderStage stage);
 
+        // The buffer slot the pre-encoded argument buffer of |group| is bound at. Only valid
+        // when the group's BindGroupLayout::UsesArgumentBuffer().
+        uint32_t GetArgumentBufferIndex(SingleShaderStage stage, uint32_t group) const;
+
       private:
         ~PipelineLayout() override = default;
         PerStage<BindingIndexInfo> mIndexInfo;
+        PerStage<std::array<uint32_t, kMaxBindGroups>> mArgumentBufferIndex;
         PerStage<uint32_t> mBufferBindingCount;
     };
 
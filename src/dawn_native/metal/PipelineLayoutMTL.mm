@@ -16,6 +16,7 @@
 
 #include "common/BitSetIterator.h"
 #include "dawn_native/BindGroupLayout.h"
+#include "dawn_native/metal/BindGroupLayoutMTL.h"
 #include "dawn_native/metal/DeviceMTL.h"
 
 namespace dawn_native { namespace metal {
@@ -29,6 +30,15 @@ namespace dawn_native { namespace metal {
             uint32_t textureIndex = 0;
 
             for (uint32_t group : IterateBitSet(GetBindGroupLayoutsMask())) {
+                if (ToBackend(GetBindGroupLayout(group))->UsesArgumentBuffer()) {
+                    // The whole group is a single pre-encoded buffer: reserve one buffer slot
+                    // for it and none for its bindings, which are addressed by [[id]] inside
+                    // the argument buffer.
+                    mArgumentBufferIndex[stage][group] = bufferIndex;
+                    bufferIndex++;
+                    continue;
+                }
+
                 for (BindingIndex bindingIndex = 0;
                      bindingIndex < GetBindGroupLayout(group)->GetBindingCount(); ++bindingIndex) {
                     const BindingInfo& bindingInfo =
@@ -76,4 +86,10 @@ namespace dawn_native { namespace metal {
         return mBufferBindingCount[stage];
     }
 
+    uint32_t PipelineLayout::GetArgumentBufferIndex(SingleShaderStage stage,
+                                                    uint32_t group) const {
+        ASSERT(group < kMaxBindGroups);
+        return mArgumentBufferIndex[stage][group];
+    }
+
 }}  // namespace dawn_native::metal
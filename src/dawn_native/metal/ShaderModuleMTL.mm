@@ -15,6 +15,7 @@
 #include "dawn_native/metal/ShaderModuleMTL.h"
 
 #include "dawn_native/BindGroupLayout.h"
+#include "dawn_native/metal/BindGroupLayoutMTL.h"
 #include "dawn_native/metal/DeviceMTL.h"
 #include "dawn_native/metal/PipelineLayoutMTL.h"
 
@@ -122,6 +123,14 @@ namespace dawn_native { namespace metal {
             // the shader storage buffer lengths.
             options_msl.buffer_size_buffer_index = kBufferLengthBufferSlot;
 
+            // Bind groups that were pre-encoded become argument buffers in MSL; groups that
+            // keep the per-resource path are marked as discrete descriptor sets below.
+            if (GetDevice()->IsToggleEnabled(Toggle::MetalUseArgumentBuffers)) {
+                options_msl.argument_buffers = true;
+                options_msl.msl_version =
+                    spirv_cross::CompilerMSL::Options::make_msl_version(2, 0);
+            }
+
             compilerImpl = std::make_unique<spirv_cross::CompilerMSL>(spirv);
             compiler = compilerImpl.get();
             compiler->set_msl_options(options_msl);
@@ -131,11 +140,36 @@ namespace dawn_native { namespace metal {
         // To make the MSL indices match the indices chosen in the PipelineLayout, we build
         // a table of MSLResourceBinding to give to SPIRV-Cross.
 
+        const bool useArgumentBuffers =
+            GetDevice()->IsToggleEnabled(Toggle::MetalUseArgumentBuffers) &&
+            !GetDevice()->IsToggleEnabled(Toggle::UseSpvc);
+
         // Create one resource binding entry per stage per binding.
         for (uint32_t group : IterateBitSet(layout->GetBindGroupLayoutsMask())) {
             const BindGroupLayoutBase::BindingMap& bindingMap =
                 layout->GetBindGroupLayout(group)->GetBindingMap();
 
+            const bool groupUsesArgumentBuffer =
+                ToBackend(layout->GetBindGroupLayout(group))->UsesArgumentBuffer();
+
+            if (useArgumentBuffers) {
+                if (groupUsesArgumentBuffer) {
+                    // The group's argument buffer is bound at the slot the PipelineLayout
+                    // reserved for it. The resources inside are addressed by BindingNumber,
+                    // matching the [[id]]s the argument encoder was built with.
+                    for (auto stage : IterateStages(kAllStages)) {
+                        spirv_cross::MSLResourceBinding mslBinding;
+                        mslBinding.stage = SpirvExecutionModelForStage(stage);
+                        mslBinding.desc_set = group;
+                        mslBinding.binding = spirv_cross::kArgumentBufferBinding;
+                        mslBinding.msl_buffer = layout->GetArgumentBufferIndex(stage, group);
+                        compiler->add_msl_resource_binding(mslBinding);
+                    }
+                } else {
+                    compiler->add_discrete_descriptor_set(group);
+                }
+            }
+
             for (const auto& it : bindingMap) {
                 BindingNumber bindingNumber = it.first;
                 BindingIndex bindingIndex = it.second;
@@ -144,7 +178,10 @@ namespace dawn_native { namespace metal {
                     layout->GetBindGroupLayout(group)->GetBindingInfo(bindingIndex);
 
                 for (auto stage : IterateStages(bindingInfo.visibility)) {
-                    uint32_t shaderIndex = layout->GetBindingIndexInfo(stage)[group][bindingIndex];
+                    uint32_t shaderIndex =
+                        groupUsesArgumentBuffer
+                            ? static_cast<uint32_t>(bindingNumber)
+                            : layout->GetBindingIndexInfo(stage)[group][bindingIndex];
                     if (GetDevice()->IsToggleEnabled(Toggle::UseSpvc)) {
                         shaderc_spvc_msl_resource_binding mslBinding;
                         mslBinding.stage = ToSpvcExecutionModel(stage);
@@ -23,9 +23,9 @@ namespace dawn_native { namespace metal {
 
     class Device;
 
-    class StagingBuffer : public StagingBufferBase {
+    class StagingBuffer final : public StagingBufferBase {
       public:
-        StagingBuffer(size_t size, Device* device);
+        StagingBuffer(size_t size, Device* device, StagingAccess access);
         ~StagingBuffer() override;
 
         id<MTLBuffer> GetBufferHandle() const;
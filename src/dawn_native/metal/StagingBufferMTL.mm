@@ -17,11 +17,12 @@
 
 namespace dawn_native { namespace metal {
 
-    StagingBuffer::StagingBuffer(size_t size, Device* device)
-        : StagingBufferBase(size), mDevice(device) {
+    StagingBuffer::StagingBuffer(size_t size, Device* device, StagingAccess access)
+        : StagingBufferBase(size, access), mDevice(device) {
     }
 
     MaybeError StagingBuffer::Initialize() {
+        // Shared storage memory serves both staging directions on Metal.
         const size_t bufferSize = GetSize();
         mBuffer = [mDevice->GetMTLDevice() newBufferWithLength:bufferSize
                                                        options:MTLResourceStorageModeShared];
@@ -313,6 +313,13 @@ namespace dawn_native { namespace metal {
         mtlDesc.mipmapLevelCount = descriptor->mipLevelCount;
         mtlDesc.arrayLength = descriptor->arrayLayerCount;
         mtlDesc.storageMode = MTLStorageModePrivate;
+#if defined(DAWN_PLATFORM_IOS)
+        // Transient attachments are only ever produced and consumed within a render pass so
+        // they can live in tile memory and never be backed by system memory.
+        if (descriptor->usage & wgpu::TextureUsage::Transient) {
+            mtlDesc.storageMode = MTLStorageModeMemoryless;
+        }
+#endif
 
         mtlDesc.sampleCount = descriptor->sampleCount;
 
@@ -325,7 +332,9 @@ namespace dawn_native { namespace metal {
         mMtlTexture = [device->GetMTLDevice() newTextureWithDescriptor:mtlDesc];
         [mtlDesc release];
 
-        if (device->IsToggleEnabled(Toggle::NonzeroClearResourcesOnCreationForTesting)) {
+        // Memoryless transient attachments cannot be written outside of a render pass.
+        if (device->IsToggleEnabled(Toggle::NonzeroClearResourcesOnCreationForTesting) &&
+            !(descriptor->usage & wgpu::TextureUsage::Transient)) {
             device->ConsumedError(ClearTexture(0, GetNumMipLevels(), 0, GetArrayLayers(),
                                                TextureBase::ClearValue::NonZero));
         }
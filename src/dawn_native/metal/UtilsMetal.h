@@ -15,14 +15,44 @@
 #ifndef DAWNNATIVE_METAL_UTILSMETAL_H_
 #define DAWNNATIVE_METAL_UTILSMETAL_H_
 
+#include "dawn_native/Format.h"
 #include "dawn_native/dawn_platform.h"
 
 #import <Metal/Metal.h>
 
+#include <array>
+
 namespace dawn_native { namespace metal {
 
     MTLCompareFunction ToMetalCompareFunction(wgpu::CompareFunction compareFunction);
 
+    struct TextureBufferCopySplit {
+        static constexpr uint32_t kMaxTextureBufferCopyRegions = 3;
+
+        struct CopyInfo {
+            NSUInteger bufferOffset;
+            NSUInteger bytesPerRow;
+            NSUInteger bytesPerImage;
+            MTLOrigin textureOrigin;
+            MTLSize copyExtent;
+        };
+
+        uint32_t count = 0;
+        std::array<CopyInfo, kMaxTextureBufferCopyRegions> copies;
+    };
+
+    MTLOrigin MakeMTLOrigin(Origin3D origin);
+    MTLSize MakeMTLSize(Extent3D extent);
+
+    TextureBufferCopySplit ComputeTextureBufferCopySplit(Origin3D origin,
+                                                         Extent3D copyExtent,
+                                                         Format textureFormat,
+                                                         Extent3D virtualSizeAtLevel,
+                                                         uint64_t bufferSize,
+                                                         uint64_t bufferOffset,
+                                                         uint32_t bytesPerRow,
+                                                         uint32_t rowsPerImage);
+
 }}  // namespace dawn_native::metal
 
 #endif  // DAWNNATIVE_METAL_UTILSMETAL_H_
@@ -14,6 +14,7 @@
 
 #include "dawn_native/null/DeviceNull.h"
 
+#include "common/Counters.h"
 #include "dawn_native/BackendConnection.h"
 #include "dawn_native/Commands.h"
 #include "dawn_native/ErrorData.h"
@@ -75,6 +76,18 @@ namespace dawn_native { namespace null {
         uint64_t size;
     };
 
+    struct CopyFromBufferToStagingOperation : PendingOperation {
+        virtual void Execute() {
+            source->CopyToStaging(staging, sourceOffset, destinationOffset, size);
+        }
+
+        Ref<Buffer> source;
+        StagingBufferBase* staging;
+        uint64_t sourceOffset;
+        uint64_t destinationOffset;
+        uint64_t size;
+    };
+
     // Device
 
     // static
@@ -127,25 +140,27 @@ namespace dawn_native { namespace null {
         const ShaderModuleDescriptor* descriptor) {
         Ref<ShaderModule> module = AcquireRef(new ShaderModule(this, descriptor));
 
-        if (IsToggleEnabled(Toggle::UseSpvc)) {
-            shaderc_spvc::CompileOptions options;
-            options.SetValidate(IsValidationEnabled());
-            shaderc_spvc::Context* context = module->GetContext();
-            shaderc_spvc_status status = context->InitializeForGlsl(
-                module->GetSpirv().data(), module->GetSpirv().size(), options);
-            if (status != shaderc_spvc_status_success) {
-                return DAWN_VALIDATION_ERROR("Unable to initialize instance of spvc");
-            }
-
-            spirv_cross::Compiler* compiler;
-            status = context->GetCompiler(reinterpret_cast<void**>(&compiler));
-            if (status != shaderc_spvc_status_success) {
-                return DAWN_VALIDATION_ERROR("Unable to get cross compiler");
+        if (!module->TryLoadCachedSpirvInfo()) {
+            if (IsToggleEnabled(Toggle::UseSpvc)) {
+                shaderc_spvc::CompileOptions options;
+                options.SetValidate(IsValidationEnabled());
+                shaderc_spvc::Context* context = module->GetContext();
+                shaderc_spvc_status status = context->InitializeForGlsl(
+                    module->GetSpirv().data(), module->GetSpirv().size(), options);
+                if (status != shaderc_spvc_status_success) {
+                    return DAWN_VALIDATION_ERROR("Unable to initialize instance of spvc");
+                }
+
+                spirv_cross::Compiler* compiler;
+                status = context->GetCompiler(reinterpret_cast<void**>(&compiler));
+                if (status != shaderc_spvc_status_success) {
+                    return DAWN_VALIDATION_ERROR("Unable to get cross compiler");
+                }
+                DAWN_TRY(module->ExtractSpirvInfo(*compiler));
+            } else {
+                spirv_cross::Compiler compiler(module->GetSpirv());
+                DAWN_TRY(module->ExtractSpirvInfo(compiler));
             }
-            DAWN_TRY(module->ExtractSpirvInfo(*compiler));
-        } else {
-            spirv_cross::Compiler compiler(module->GetSpirv());
-            DAWN_TRY(module->ExtractSpirvInfo(compiler));
         }
         return module.Detach();
     }
@@ -175,6 +190,13 @@ namespace dawn_native { namespace null {
         return std::move(stagingBuffer);
     }
 
+    ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateReadbackStagingBuffer(
+        size_t size) {
+        // Staging memory is plain heap memory in the null backend, so both directions share
+        // the same implementation.
+        return CreateStagingBuffer(size);
+    }
+
     void Device::ShutDownImpl() {
         ASSERT(GetState() == State::Disconnected);
 
@@ -207,6 +229,33 @@ namespace dawn_native { namespace null {
         return {};
     }
 
+    MaybeError Device::CopyFromBufferToStaging(BufferBase* source,
+                                               uint64_t sourceOffset,
+                                               StagingBufferBase* destination,
+                                               uint64_t destinationOffset,
+                                               uint64_t size) {
+        auto operation = std::make_unique<CopyFromBufferToStagingOperation>();
+        operation->source = ToBackend(source);
+        operation->staging = destination;
+        operation->sourceOffset = sourceOffset;
+        operation->destinationOffset = destinationOffset;
+        operation->size = size;
+
+        AddPendingOperation(std::move(operation));
+
+        return {};
+    }
+
+    MaybeError Device::CopyFromStagingToTexture(StagingBufferBase* source,
+                                                uint64_t sourceOffset,
+                                                uint32_t bytesPerRow,
+                                                uint32_t rowsPerImage,
+                                                const TextureCopy& dst,
+                                                const Extent3D& copySizePixels) {
+        // Textures are not backed by memory in the null backend so there is nothing to copy.
+        return {};
+    }
+
     MaybeError Device::IncrementMemoryUsage(size_t bytes) {
         static_assert(kMaxMemoryUsage <= std::numeric_limits<size_t>::max() / 2, "");
         if (bytes > kMaxMemoryUsage || mMemoryUsage + bytes > kMaxMemoryUsage) {
@@ -221,6 +270,15 @@ namespace dawn_native { namespace null {
         mMemoryUsage -= bytes;
     }
 
+    void Device::CountConsumedCommands(uint64_t count) {
+        mCommandsConsumed += count;
+        DAWN_COUNTER_ADD(GetCounters(), CommandsConsumed, count);
+    }
+
+    uint64_t Device::GetCommandsConsumed() const {
+        return mCommandsConsumed;
+    }
+
     MaybeError Device::TickImpl() {
         SubmitPendingOperations();
         return {};
@@ -304,6 +362,14 @@ namespace dawn_native { namespace null {
         memcpy(mBackingData.get() + destinationOffset, ptr + sourceOffset, size);
     }
 
+    void Buffer::CopyToStaging(StagingBufferBase* staging,
+                               uint64_t sourceOffset,
+                               uint64_t destinationOffset,
+                               uint64_t size) {
+        uint8_t* ptr = reinterpret_cast<uint8_t*>(staging->GetMappedPointer());
+        memcpy(ptr + destinationOffset, mBackingData.get() + sourceOffset, size);
+    }
+
     MaybeError Buffer::SetSubDataImpl(uint32_t start, uint32_t count, const void* data) {
         ASSERT(start + count <= GetSize());
         ASSERT(mBackingData);
@@ -353,6 +419,16 @@ namespace dawn_native { namespace null {
         FreeCommands(&mCommands);
     }
 
+    uint64_t CommandBuffer::ConsumeCommands() {
+        uint64_t consumed = 0;
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            SkipCommand(&mCommands, type);
+            consumed++;
+        }
+        return consumed;
+    }
+
     // Queue
 
     Queue::Queue(Device* device) : QueueBase(device) {
@@ -361,8 +437,21 @@ namespace dawn_native { namespace null {
     Queue::~Queue() {
     }
 
-    MaybeError Queue::SubmitImpl(uint32_t, CommandBufferBase* const*) {
-        ToBackend(GetDevice())->SubmitPendingOperations();
+    MaybeError Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) {
+        Device* device = ToBackend(GetDevice());
+
+        if (device->IsToggleEnabled(Toggle::NullBackendThroughputMode)) {
+            // Walk every recorded command so a submit pays a realistic CPU cost, and report
+            // how many were consumed. There is nothing to pace: the commands complete in the
+            // SubmitPendingOperations call below.
+            uint64_t consumed = 0;
+            for (uint32_t i = 0; i < commandCount; ++i) {
+                consumed += ToBackend(commands[i])->ConsumeCommands();
+            }
+            device->CountConsumedCommands(consumed);
+        }
+
+        device->SubmitPendingOperations();
         return {};
     }
 
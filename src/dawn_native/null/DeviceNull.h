@@ -89,7 +89,7 @@ namespace dawn_native { namespace null {
         virtual void Execute() = 0;
     };
 
-    class Device : public DeviceBase {
+    class Device final : public DeviceBase {
       public:
         static ResultOrError<Device*> Create(Adapter* adapter, const DeviceDescriptor* descriptor);
         ~Device() override;
@@ -105,15 +105,32 @@ namespace dawn_native { namespace null {
         void SubmitPendingOperations();
 
         ResultOrError<std::unique_ptr<StagingBufferBase>> CreateStagingBuffer(size_t size) override;
+        ResultOrError<std::unique_ptr<StagingBufferBase>> CreateReadbackStagingBuffer(
+            size_t size) override;
         MaybeError CopyFromStagingToBuffer(StagingBufferBase* source,
                                            uint64_t sourceOffset,
                                            BufferBase* destination,
                                            uint64_t destinationOffset,
                                            uint64_t size) override;
+        MaybeError CopyFromStagingToTexture(StagingBufferBase* source,
+                                            uint64_t sourceOffset,
+                                            uint32_t bytesPerRow,
+                                            uint32_t rowsPerImage,
+                                            const TextureCopy& dst,
+                                            const Extent3D& copySizePixels) override;
+        MaybeError CopyFromBufferToStaging(BufferBase* source,
+                                           uint64_t sourceOffset,
+                                           StagingBufferBase* destination,
+                                           uint64_t destinationOffset,
+                                           uint64_t size) override;
 
         MaybeError IncrementMemoryUsage(size_t bytes);
         void DecrementMemoryUsage(size_t bytes);
 
+        // Bookkeeping for the null_backend_throughput_mode toggle.
+        void CountConsumedCommands(uint64_t count);
+        uint64_t GetCommandsConsumed() const;
+
       private:
         using DeviceBase::DeviceBase;
 
@@ -139,6 +156,10 @@ namespace dawn_native { namespace null {
             const ComputePipelineDescriptor* descriptor) override;
         ResultOrError<PipelineLayoutBase*> CreatePipelineLayoutImpl(
             const PipelineLayoutDescriptor* descriptor) override;
+        ResultOrError<QuerySetBase*> CreateQuerySetImpl(
+            const QuerySetDescriptor* descriptor) override {
+            UNREACHABLE();
+        }
         ResultOrError<RenderPipelineBase*> CreateRenderPipelineImpl(
             const RenderPipelineDescriptor* descriptor) override;
         ResultOrError<SamplerBase*> CreateSamplerImpl(const SamplerDescriptor* descriptor) override;
@@ -165,9 +186,10 @@ namespace dawn_native { namespace null {
 
         static constexpr size_t kMaxMemoryUsage = 256 * 1024 * 1024;
         size_t mMemoryUsage = 0;
+        uint64_t mCommandsConsumed = 0;
     };
 
-    class Adapter : public AdapterBase {
+    class Adapter final : public AdapterBase {
       public:
         Adapter(InstanceBase* instance);
         ~Adapter() override;
@@ -207,6 +229,10 @@ namespace dawn_native { namespace null {
                              uint64_t sourceOffset,
                              uint64_t destinationOffset,
                              uint64_t size);
+        void CopyToStaging(StagingBufferBase* staging,
+                           uint64_t sourceOffset,
+                           uint64_t destinationOffset,
+                           uint64_t size);
 
       private:
         ~Buffer() override;
@@ -230,6 +256,10 @@ namespace dawn_native { namespace null {
       public:
         CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor);
 
+        // Walks all the recorded commands and returns how many there were, for the
+        // null_backend_throughput_mode toggle.
+        uint64_t ConsumeCommands();
+
       private:
         ~CommandBuffer() override;
 
@@ -285,7 +315,7 @@ namespace dawn_native { namespace null {
         wgpu::TextureFormat GetPreferredFormat() const;
     };
 
-    class StagingBuffer : public StagingBufferBase {
+    class StagingBuffer final : public StagingBufferBase {
       public:
         StagingBuffer(size_t size, Device* device);
         ~StagingBuffer() override;
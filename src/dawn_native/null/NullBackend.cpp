@@ -29,4 +29,9 @@ namespace dawn_native { namespace null {
         return impl;
     }
 
+    uint64_t GetCommandsConsumed(WGPUDevice device) {
+        Device* backendDevice = reinterpret_cast<Device*>(device);
+        return backendDevice->GetCommandsConsumed();
+    }
+
 }}  // namespace dawn_native::null
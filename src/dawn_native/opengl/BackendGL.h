@@ -19,7 +19,7 @@
 
 namespace dawn_native { namespace opengl {
 
-    class Backend : public BackendConnection {
+    class Backend final : public BackendConnection {
       public:
         Backend(InstanceBase* instance);
 
@@ -49,94 +49,11 @@ namespace dawn_native { namespace opengl {
             }
         }
 
-        GLenum VertexFormatType(wgpu::VertexFormat format) {
-            switch (format) {
-                case wgpu::VertexFormat::UChar2:
-                case wgpu::VertexFormat::UChar4:
-                case wgpu::VertexFormat::UChar2Norm:
-                case wgpu::VertexFormat::UChar4Norm:
-                    return GL_UNSIGNED_BYTE;
-                case wgpu::VertexFormat::Char2:
-                case wgpu::VertexFormat::Char4:
-                case wgpu::VertexFormat::Char2Norm:
-                case wgpu::VertexFormat::Char4Norm:
-                    return GL_BYTE;
-                case wgpu::VertexFormat::UShort2:
-                case wgpu::VertexFormat::UShort4:
-                case wgpu::VertexFormat::UShort2Norm:
-                case wgpu::VertexFormat::UShort4Norm:
-                    return GL_UNSIGNED_SHORT;
-                case wgpu::VertexFormat::Short2:
-                case wgpu::VertexFormat::Short4:
-                case wgpu::VertexFormat::Short2Norm:
-                case wgpu::VertexFormat::Short4Norm:
-                    return GL_SHORT;
-                case wgpu::VertexFormat::Half2:
-                case wgpu::VertexFormat::Half4:
-                    return GL_HALF_FLOAT;
-                case wgpu::VertexFormat::Float:
-                case wgpu::VertexFormat::Float2:
-                case wgpu::VertexFormat::Float3:
-                case wgpu::VertexFormat::Float4:
-                    return GL_FLOAT;
-                case wgpu::VertexFormat::UInt:
-                case wgpu::VertexFormat::UInt2:
-                case wgpu::VertexFormat::UInt3:
-                case wgpu::VertexFormat::UInt4:
-                    return GL_UNSIGNED_INT;
-                case wgpu::VertexFormat::Int:
-                case wgpu::VertexFormat::Int2:
-                case wgpu::VertexFormat::Int3:
-                case wgpu::VertexFormat::Int4:
-                    return GL_INT;
-                default:
-                    UNREACHABLE();
-            }
-        }
-
-        GLboolean VertexFormatIsNormalized(wgpu::VertexFormat format) {
-            switch (format) {
-                case wgpu::VertexFormat::UChar2Norm:
-                case wgpu::VertexFormat::UChar4Norm:
-                case wgpu::VertexFormat::Char2Norm:
-                case wgpu::VertexFormat::Char4Norm:
-                case wgpu::VertexFormat::UShort2Norm:
-                case wgpu::VertexFormat::UShort4Norm:
-                case wgpu::VertexFormat::Short2Norm:
-                case wgpu::VertexFormat::Short4Norm:
-                    return GL_TRUE;
-                default:
-                    return GL_FALSE;
-            }
-        }
-
-        bool VertexFormatIsInt(wgpu::VertexFormat format) {
-            switch (format) {
-                case wgpu::VertexFormat::UChar2:
-                case wgpu::VertexFormat::UChar4:
-                case wgpu::VertexFormat::Char2:
-                case wgpu::VertexFormat::Char4:
-                case wgpu::VertexFormat::UShort2:
-                case wgpu::VertexFormat::UShort4:
-                case wgpu::VertexFormat::Short2:
-                case wgpu::VertexFormat::Short4:
-                case wgpu::VertexFormat::UInt:
-                case wgpu::VertexFormat::UInt2:
-                case wgpu::VertexFormat::UInt3:
-                case wgpu::VertexFormat::UInt4:
-                case wgpu::VertexFormat::Int:
-                case wgpu::VertexFormat::Int2:
-                case wgpu::VertexFormat::Int3:
-                case wgpu::VertexFormat::Int4:
-                    return true;
-                default:
-                    return false;
-            }
-        }
-
         // Vertex buffers and index buffers are implemented as part of an OpenGL VAO that
         // corresponds to a VertexState. On the contrary in Dawn they are part of the global state.
-        // This means that we have to re-apply these buffers on a VertexState change.
+        // The pipeline caches one complete VAO per set of vertex buffer bindings, so a
+        // pipeline/buffer change only has to bind the matching VAO instead of re-specifying
+        // the attribute pointers.
         class VertexStateBufferBindingTracker {
           public:
             void OnSetIndexBuffer(BufferBase* buffer) {
@@ -147,71 +64,59 @@ namespace dawn_native { namespace opengl {
             void OnSetVertexBuffer(uint32_t slot, BufferBase* buffer, uint64_t offset) {
                 mVertexBuffers[slot] = ToBackend(buffer);
                 mVertexBufferOffsets[slot] = offset;
-
-                // Use 64 bit masks and make sure there are no shift UB
-                static_assert(kMaxVertexBuffers <= 8 * sizeof(unsigned long long) - 1, "");
-                mDirtyVertexBuffers |= 1ull << slot;
+                mVAODirty = true;
             }
 
-            void OnSetPipeline(RenderPipelineBase* pipeline) {
+            void OnSetPipeline(RenderPipeline* pipeline) {
                 if (mLastPipeline == pipeline) {
                     return;
                 }
 
                 mIndexBufferDirty = true;
-                mDirtyVertexBuffers |= pipeline->GetVertexBufferSlotsUsed();
+                mVAODirty = true;
 
                 mLastPipeline = pipeline;
             }
 
-            void Apply(const OpenGLFunctions& gl) {
-                if (mIndexBufferDirty && mIndexBuffer != nullptr) {
-                    gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer->GetHandle());
-                    mIndexBufferDirty = false;
-                }
+            void Apply(const OpenGLFunctions& gl, PersistentPipelineState* persistentPipelineState) {
+                if (mVAODirty) {
+                    // Only the slots the pipeline uses contribute to the cache key so that
+                    // stale bindings in unused slots don't create duplicate VAOs.
+                    std::array<GLuint, kMaxVertexBuffers> bufferHandles = {};
+                    std::array<uint64_t, kMaxVertexBuffers> bufferOffsets = {};
+                    for (uint32_t slot : IterateBitSet(mLastPipeline->GetVertexBufferSlotsUsed())) {
+                        bufferHandles[slot] = mVertexBuffers[slot]->GetHandle();
+                        bufferOffsets[slot] = mVertexBufferOffsets[slot];
+                    }
 
-                for (uint32_t slot : IterateBitSet(mDirtyVertexBuffers &
-                                                   mLastPipeline->GetVertexBufferSlotsUsed())) {
-                    for (uint32_t location :
-                         IterateBitSet(mLastPipeline->GetAttributesUsingVertexBuffer(slot))) {
-                        const VertexAttributeInfo& attribute =
-                            mLastPipeline->GetAttribute(location);
-
-                        GLuint buffer = mVertexBuffers[slot]->GetHandle();
-                        uint64_t offset = mVertexBufferOffsets[slot];
-
-                        const VertexBufferInfo& vertexBuffer = mLastPipeline->GetVertexBuffer(slot);
-                        uint32_t components = VertexFormatNumComponents(attribute.format);
-                        GLenum formatType = VertexFormatType(attribute.format);
-
-                        GLboolean normalized = VertexFormatIsNormalized(attribute.format);
-                        gl.BindBuffer(GL_ARRAY_BUFFER, buffer);
-                        if (VertexFormatIsInt(attribute.format)) {
-                            gl.VertexAttribIPointer(
-                                location, components, formatType, vertexBuffer.arrayStride,
-                                reinterpret_cast<void*>(
-                                    static_cast<intptr_t>(offset + attribute.offset)));
-                        } else {
-                            gl.VertexAttribPointer(location, components, formatType, normalized,
-                                                   vertexBuffer.arrayStride,
-                                                   reinterpret_cast<void*>(static_cast<intptr_t>(
-                                                       offset + attribute.offset)));
-                        }
+                    GLuint vao = mLastPipeline->BindVAOForVertexBuffers(
+                        gl, persistentPipelineState, bufferHandles, bufferOffsets);
+
+                    // The element array binding is part of the VAO state, so the index buffer
+                    // has to be re-bound whenever a different VAO gets bound.
+                    if (vao != mLastVAO) {
+                        mLastVAO = vao;
+                        mIndexBufferDirty = true;
                     }
+                    mVAODirty = false;
                 }
 
-                mDirtyVertexBuffers.reset();
+                if (mIndexBufferDirty && mIndexBuffer != nullptr) {
+                    gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer->GetHandle());
+                    mIndexBufferDirty = false;
+                }
             }
 
           private:
             bool mIndexBufferDirty = false;
             Buffer* mIndexBuffer = nullptr;
 
-            std::bitset<kMaxVertexBuffers> mDirtyVertexBuffers;
+            bool mVAODirty = false;
+            GLuint mLastVAO = 0;
             std::array<Buffer*, kMaxVertexBuffers> mVertexBuffers;
             std::array<uint64_t, kMaxVertexBuffers> mVertexBufferOffsets;
 
-            RenderPipelineBase* mLastPipeline = nullptr;
+            RenderPipeline* mLastPipeline = nullptr;
         };
 
         class BindGroupTracker : public BindGroupTrackerBase<false, uint64_t> {
@@ -471,6 +376,27 @@ namespace dawn_native { namespace opengl {
                     break;
                 }
 
+                case Command::CopyBufferToBufferBatch: {
+                    CopyBufferToBufferBatchCmd* copy =
+                        mCommands.NextCommand<CopyBufferToBufferBatchCmd>();
+                    const BufferCopyRegion* regions =
+                        mCommands.NextData<BufferCopyRegion>(copy->regionCount);
+
+                    // The buffers are bound once for the whole batch.
+                    gl.BindBuffer(GL_PIXEL_PACK_BUFFER, ToBackend(copy->source)->GetHandle());
+                    gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER,
+                                  ToBackend(copy->destination)->GetHandle());
+                    for (uint32_t i = 0; i < copy->regionCount; ++i) {
+                        gl.CopyBufferSubData(GL_PIXEL_PACK_BUFFER, GL_PIXEL_UNPACK_BUFFER,
+                                             regions[i].sourceOffset,
+                                             regions[i].destinationOffset, regions[i].size);
+                    }
+
+                    gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                    gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                    break;
+                }
+
                 case Command::CopyBufferToTexture: {
                     CopyBufferToTextureCmd* copy = mCommands.NextCommand<CopyBufferToTextureCmd>();
                     auto& src = copy->source;
@@ -671,6 +597,24 @@ namespace dawn_native { namespace opengl {
                     break;
                 }
 
+                case Command::DispatchBatch: {
+                    DispatchBatchCmd* dispatch = mCommands.NextCommand<DispatchBatchCmd>();
+                    DispatchBatchEntry* entries =
+                        mCommands.NextData<DispatchBatchEntry>(dispatch->entryCount);
+
+                    for (uint32_t i = 0; i < dispatch->entryCount; ++i) {
+                        bindGroupTracker.OnSetBindGroup(dispatch->groupIndex,
+                                                        dispatch->group.Get(), 1,
+                                                        &entries[i].dynamicOffset);
+                        bindGroupTracker.Apply(gl);
+
+                        gl.DispatchCompute(entries[i].x, entries[i].y, entries[i].z);
+                        // TODO(cwallez@chromium.org): add barriers to the API
+                        gl.MemoryBarrier(GL_ALL_BARRIER_BITS);
+                    }
+                    break;
+                }
+
                 case Command::DispatchIndirect: {
                     DispatchIndirectCmd* dispatch = mCommands.NextCommand<DispatchIndirectCmd>();
                     bindGroupTracker.Apply(gl);
@@ -868,7 +812,7 @@ namespace dawn_native { namespace opengl {
             switch (type) {
                 case Command::Draw: {
                     DrawCmd* draw = iter->NextCommand<DrawCmd>();
-                    vertexStateBufferBindingTracker.Apply(gl);
+                    vertexStateBufferBindingTracker.Apply(gl, &persistentPipelineState);
                     bindGroupTracker.Apply(gl);
 
                     if (draw->firstInstance > 0) {
@@ -886,7 +830,7 @@ namespace dawn_native { namespace opengl {
 
                 case Command::DrawIndexed: {
                     DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
-                    vertexStateBufferBindingTracker.Apply(gl);
+                    vertexStateBufferBindingTracker.Apply(gl, &persistentPipelineState);
                     bindGroupTracker.Apply(gl);
 
                     wgpu::IndexFormat indexFormat =
@@ -924,7 +868,7 @@ namespace dawn_native { namespace opengl {
 
                 case Command::DrawIndirect: {
                     DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
-                    vertexStateBufferBindingTracker.Apply(gl);
+                    vertexStateBufferBindingTracker.Apply(gl, &persistentPipelineState);
                     bindGroupTracker.Apply(gl);
 
                     uint64_t indirectBufferOffset = draw->indirectOffset;
@@ -939,7 +883,7 @@ namespace dawn_native { namespace opengl {
 
                 case Command::DrawIndexedIndirect: {
                     DrawIndexedIndirectCmd* draw = iter->NextCommand<DrawIndexedIndirectCmd>();
-                    vertexStateBufferBindingTracker.Apply(gl);
+                    vertexStateBufferBindingTracker.Apply(gl, &persistentPipelineState);
                     bindGroupTracker.Apply(gl);
 
                     wgpu::IndexFormat indexFormat =
@@ -956,6 +900,31 @@ namespace dawn_native { namespace opengl {
                     break;
                 }
 
+                case Command::MultiDrawIndexedIndirect: {
+                    MultiDrawIndexedIndirectCmd* draw =
+                        iter->NextCommand<MultiDrawIndexedIndirectCmd>();
+                    vertexStateBufferBindingTracker.Apply(gl, &persistentPipelineState);
+                    bindGroupTracker.Apply(gl);
+
+                    wgpu::IndexFormat indexFormat =
+                        lastPipeline->GetVertexStateDescriptor()->indexFormat;
+                    GLenum formatType = IndexFormatType(indexFormat);
+
+                    Buffer* indirectBuffer = ToBackend(draw->indirectBuffer.Get());
+
+                    // OpenGL has no count buffer equivalent so maxDrawCount draws are always
+                    // issued. Unused trailing entries must be zeroed, making them no-op draws.
+                    gl.BindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer->GetHandle());
+                    for (uint32_t i = 0; i < draw->maxDrawCount; ++i) {
+                        uint64_t indirectBufferOffset =
+                            draw->indirectOffset + i * kDrawIndexedIndirectSize;
+                        gl.DrawElementsIndirect(
+                            lastPipeline->GetGLPrimitiveTopology(), formatType,
+                            reinterpret_cast<void*>(static_cast<intptr_t>(indirectBufferOffset)));
+                    }
+                    break;
+                }
+
                 case Command::InsertDebugMarker:
                 case Command::PopDebugGroup:
                 case Command::PushDebugGroup: {
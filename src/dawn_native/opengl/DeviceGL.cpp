@@ -189,6 +189,11 @@ namespace dawn_native { namespace opengl {
         return DAWN_UNIMPLEMENTED_ERROR("Device unable to create staging buffer.");
     }
 
+    ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateReadbackStagingBuffer(
+        size_t size) {
+        return DAWN_UNIMPLEMENTED_ERROR("Device unable to create staging buffer.");
+    }
+
     MaybeError Device::CopyFromStagingToBuffer(StagingBufferBase* source,
                                                uint64_t sourceOffset,
                                                BufferBase* destination,
@@ -197,6 +202,14 @@ namespace dawn_native { namespace opengl {
         return DAWN_UNIMPLEMENTED_ERROR("Device unable to copy from staging buffer.");
     }
 
+    MaybeError Device::CopyFromBufferToStaging(BufferBase* source,
+                                               uint64_t sourceOffset,
+                                               StagingBufferBase* destination,
+                                               uint64_t destinationOffset,
+                                               uint64_t size) {
+        return DAWN_UNIMPLEMENTED_ERROR("Device unable to copy to staging buffer.");
+    }
+
     void Device::ShutDownImpl() {
         ASSERT(GetState() == State::Disconnected);
 
@@ -14,12 +14,129 @@
 
 #include "dawn_native/opengl/PersistentPipelineStateGL.h"
 
+#include "common/Assert.h"
 #include "dawn_native/opengl/OpenGLFunctions.h"
 
 namespace dawn_native { namespace opengl {
 
+    namespace {
+
+        void SetCapabilityEnabled(const OpenGLFunctions& gl, GLenum capability, bool enabled) {
+            if (enabled) {
+                gl.Enable(capability);
+            } else {
+                gl.Disable(capability);
+            }
+        }
+
+    }  // anonymous namespace
+
     void PersistentPipelineState::SetDefaultState(const OpenGLFunctions& gl) {
+        // Unconditionally apply every cached value so the shadow state matches the context.
+        gl.BindVertexArray(mVertexArrayObject);
+
+        SetCapabilityEnabled(gl, GL_CULL_FACE, mCullFaceEnabled);
+        gl.FrontFace(mFrontFace);
+        gl.CullFace(mCullFace);
+
+        SetCapabilityEnabled(gl, GL_DEPTH_TEST, mDepthTestEnabled);
+        gl.DepthMask(mDepthMask);
+        gl.DepthFunc(mDepthFunc);
+
+        SetCapabilityEnabled(gl, GL_STENCIL_TEST, mStencilTestEnabled);
         CallGLStencilFunc(gl);
+        gl.StencilOpSeparate(GL_BACK, mStencilBackFailOp, mStencilBackDepthFailOp,
+                             mStencilBackPassOp);
+        gl.StencilOpSeparate(GL_FRONT, mStencilFrontFailOp, mStencilFrontDepthFailOp,
+                             mStencilFrontPassOp);
+        gl.StencilMask(mStencilWriteMask);
+
+        for (uint32_t attachment = 0; attachment < kMaxColorAttachments; ++attachment) {
+            const BlendState& blend = mBlendState[attachment];
+            if (blend.enabled) {
+                gl.Enablei(GL_BLEND, attachment);
+            } else {
+                gl.Disablei(GL_BLEND, attachment);
+            }
+            gl.BlendEquationSeparatei(attachment, blend.colorOperation, blend.alphaOperation);
+            gl.BlendFuncSeparatei(attachment, blend.srcColorFactor, blend.dstColorFactor,
+                                  blend.srcAlphaFactor, blend.dstAlphaFactor);
+            gl.ColorMaski(attachment, blend.writeRed, blend.writeGreen, blend.writeBlue,
+                          blend.writeAlpha);
+        }
+    }
+
+    void PersistentPipelineState::SetVertexArrayObject(const OpenGLFunctions& gl,
+                                                       GLuint vertexArrayObject) {
+        if (mVertexArrayObject == vertexArrayObject) {
+            return;
+        }
+
+        mVertexArrayObject = vertexArrayObject;
+        gl.BindVertexArray(vertexArrayObject);
+    }
+
+    void PersistentPipelineState::SetCullFaceEnabled(const OpenGLFunctions& gl, bool enabled) {
+        if (mCullFaceEnabled == enabled) {
+            return;
+        }
+
+        mCullFaceEnabled = enabled;
+        SetCapabilityEnabled(gl, GL_CULL_FACE, enabled);
+    }
+
+    void PersistentPipelineState::SetFrontFace(const OpenGLFunctions& gl, GLenum frontFace) {
+        if (mFrontFace == frontFace) {
+            return;
+        }
+
+        mFrontFace = frontFace;
+        gl.FrontFace(frontFace);
+    }
+
+    void PersistentPipelineState::SetCullFace(const OpenGLFunctions& gl, GLenum cullFace) {
+        if (mCullFace == cullFace) {
+            return;
+        }
+
+        mCullFace = cullFace;
+        gl.CullFace(cullFace);
+    }
+
+    void PersistentPipelineState::SetDepthTestEnabled(const OpenGLFunctions& gl, bool enabled) {
+        if (mDepthTestEnabled == enabled) {
+            return;
+        }
+
+        mDepthTestEnabled = enabled;
+        SetCapabilityEnabled(gl, GL_DEPTH_TEST, enabled);
+    }
+
+    void PersistentPipelineState::SetDepthMask(const OpenGLFunctions& gl, GLboolean mask) {
+        if (mDepthMask == mask) {
+            return;
+        }
+
+        mDepthMask = mask;
+        gl.DepthMask(mask);
+    }
+
+    void PersistentPipelineState::SetDepthFunc(const OpenGLFunctions& gl, GLenum depthFunc) {
+        if (mDepthFunc == depthFunc) {
+            return;
+        }
+
+        mDepthFunc = depthFunc;
+        gl.DepthFunc(depthFunc);
+    }
+
+    void PersistentPipelineState::SetStencilTestEnabled(const OpenGLFunctions& gl, bool enabled) {
+        if (mStencilTestEnabled == enabled) {
+            return;
+        }
+
+        mStencilTestEnabled = enabled;
+        SetCapabilityEnabled(gl, GL_STENCIL_TEST, enabled);
     }
 
     void PersistentPipelineState::SetStencilFuncsAndMask(const OpenGLFunctions& gl,
@@ -48,6 +165,113 @@ namespace dawn_native { namespace opengl {
         CallGLStencilFunc(gl);
     }
 
+    void PersistentPipelineState::SetStencilOps(const OpenGLFunctions& gl,
+                                                GLenum backFailOp,
+                                                GLenum backDepthFailOp,
+                                                GLenum backPassOp,
+                                                GLenum frontFailOp,
+                                                GLenum frontDepthFailOp,
+                                                GLenum frontPassOp) {
+        if (mStencilBackFailOp != backFailOp || mStencilBackDepthFailOp != backDepthFailOp ||
+            mStencilBackPassOp != backPassOp) {
+            mStencilBackFailOp = backFailOp;
+            mStencilBackDepthFailOp = backDepthFailOp;
+            mStencilBackPassOp = backPassOp;
+            gl.StencilOpSeparate(GL_BACK, backFailOp, backDepthFailOp, backPassOp);
+        }
+
+        if (mStencilFrontFailOp != frontFailOp || mStencilFrontDepthFailOp != frontDepthFailOp ||
+            mStencilFrontPassOp != frontPassOp) {
+            mStencilFrontFailOp = frontFailOp;
+            mStencilFrontDepthFailOp = frontDepthFailOp;
+            mStencilFrontPassOp = frontPassOp;
+            gl.StencilOpSeparate(GL_FRONT, frontFailOp, frontDepthFailOp, frontPassOp);
+        }
+    }
+
+    void PersistentPipelineState::SetStencilWriteMask(const OpenGLFunctions& gl,
+                                                      GLuint stencilWriteMask) {
+        if (mStencilWriteMask == stencilWriteMask) {
+            return;
+        }
+
+        mStencilWriteMask = stencilWriteMask;
+        gl.StencilMask(stencilWriteMask);
+    }
+
+    void PersistentPipelineState::SetBlendEnabled(const OpenGLFunctions& gl,
+                                                  uint32_t attachment,
+                                                  bool enabled) {
+        ASSERT(attachment < kMaxColorAttachments);
+        BlendState* blend = &mBlendState[attachment];
+        if (blend->enabled == enabled) {
+            return;
+        }
+
+        blend->enabled = enabled;
+        if (enabled) {
+            gl.Enablei(GL_BLEND, attachment);
+        } else {
+            gl.Disablei(GL_BLEND, attachment);
+        }
+    }
+
+    void PersistentPipelineState::SetBlendEquations(const OpenGLFunctions& gl,
+                                                    uint32_t attachment,
+                                                    GLenum colorOperation,
+                                                    GLenum alphaOperation) {
+        ASSERT(attachment < kMaxColorAttachments);
+        BlendState* blend = &mBlendState[attachment];
+        if (blend->colorOperation == colorOperation && blend->alphaOperation == alphaOperation) {
+            return;
+        }
+
+        blend->colorOperation = colorOperation;
+        blend->alphaOperation = alphaOperation;
+        gl.BlendEquationSeparatei(attachment, colorOperation, alphaOperation);
+    }
+
+    void PersistentPipelineState::SetBlendFuncs(const OpenGLFunctions& gl,
+                                                uint32_t attachment,
+                                                GLenum srcColorFactor,
+                                                GLenum dstColorFactor,
+                                                GLenum srcAlphaFactor,
+                                                GLenum dstAlphaFactor) {
+        ASSERT(attachment < kMaxColorAttachments);
+        BlendState* blend = &mBlendState[attachment];
+        if (blend->srcColorFactor == srcColorFactor && blend->dstColorFactor == dstColorFactor &&
+            blend->srcAlphaFactor == srcAlphaFactor && blend->dstAlphaFactor == dstAlphaFactor) {
+            return;
+        }
+
+        blend->srcColorFactor = srcColorFactor;
+        blend->dstColorFactor = dstColorFactor;
+        blend->srcAlphaFactor = srcAlphaFactor;
+        blend->dstAlphaFactor = dstAlphaFactor;
+        gl.BlendFuncSeparatei(attachment, srcColorFactor, dstColorFactor, srcAlphaFactor,
+                              dstAlphaFactor);
+    }
+
+    void PersistentPipelineState::SetColorWriteMask(const OpenGLFunctions& gl,
+                                                    uint32_t attachment,
+                                                    GLboolean red,
+                                                    GLboolean green,
+                                                    GLboolean blue,
+                                                    GLboolean alpha) {
+        ASSERT(attachment < kMaxColorAttachments);
+        BlendState* blend = &mBlendState[attachment];
+        if (blend->writeRed == red && blend->writeGreen == green && blend->writeBlue == blue &&
+            blend->writeAlpha == alpha) {
+            return;
+        }
+
+        blend->writeRed = red;
+        blend->writeGreen = green;
+        blend->writeBlue = blue;
+        blend->writeAlpha = alpha;
+        gl.ColorMaski(attachment, red, green, blue, alpha);
+    }
+
     void PersistentPipelineState::CallGLStencilFunc(const OpenGLFunctions& gl) {
         gl.StencilFuncSeparate(GL_BACK, mStencilBackCompareFunction, mStencilReference,
                                mStencilReadMask);
@@ -15,29 +15,115 @@
 #ifndef DAWNNATIVE_OPENGL_PERSISTENTPIPELINESTATEGL_H_
 #define DAWNNATIVE_OPENGL_PERSISTENTPIPELINESTATEGL_H_
 
+#include "common/Constants.h"
 #include "dawn_native/dawn_platform.h"
 #include "dawn_native/opengl/opengl_platform.h"
 
+#include <array>
+
 namespace dawn_native { namespace opengl {
 
     struct OpenGLFunctions;
 
+    // Shadows the OpenGL state that RenderPipeline::ApplyNow touches so that switching
+    // pipelines only emits GL calls for the state groups that actually changed. Each setter
+    // compares against the cached values and early-outs when the state is already current.
+    //
+    // The cached values start at the GL default state. SetDefaultState force-applies them so
+    // that the shadow matches the context regardless of what previously executed command
+    // buffers left behind.
     class PersistentPipelineState {
       public:
         void SetDefaultState(const OpenGLFunctions& gl);
+
+        // Vertex state
+        void SetVertexArrayObject(const OpenGLFunctions& gl, GLuint vertexArrayObject);
+
+        // Rasterization state
+        void SetCullFaceEnabled(const OpenGLFunctions& gl, bool enabled);
+        void SetFrontFace(const OpenGLFunctions& gl, GLenum frontFace);
+        void SetCullFace(const OpenGLFunctions& gl, GLenum cullFace);
+
+        // Depth state
+        void SetDepthTestEnabled(const OpenGLFunctions& gl, bool enabled);
+        void SetDepthMask(const OpenGLFunctions& gl, GLboolean mask);
+        void SetDepthFunc(const OpenGLFunctions& gl, GLenum depthFunc);
+
+        // Stencil state
+        void SetStencilTestEnabled(const OpenGLFunctions& gl, bool enabled);
         void SetStencilFuncsAndMask(const OpenGLFunctions& gl,
                                     GLenum stencilBackCompareFunction,
                                     GLenum stencilFrontCompareFunction,
                                     uint32_t stencilReadMask);
         void SetStencilReference(const OpenGLFunctions& gl, uint32_t stencilReference);
+        void SetStencilOps(const OpenGLFunctions& gl,
+                           GLenum backFailOp,
+                           GLenum backDepthFailOp,
+                           GLenum backPassOp,
+                           GLenum frontFailOp,
+                           GLenum frontDepthFailOp,
+                           GLenum frontPassOp);
+        void SetStencilWriteMask(const OpenGLFunctions& gl, GLuint stencilWriteMask);
+
+        // Per-attachment blend state
+        void SetBlendEnabled(const OpenGLFunctions& gl, uint32_t attachment, bool enabled);
+        void SetBlendEquations(const OpenGLFunctions& gl,
+                               uint32_t attachment,
+                               GLenum colorOperation,
+                               GLenum alphaOperation);
+        void SetBlendFuncs(const OpenGLFunctions& gl,
+                           uint32_t attachment,
+                           GLenum srcColorFactor,
+                           GLenum dstColorFactor,
+                           GLenum srcAlphaFactor,
+                           GLenum dstAlphaFactor);
+        void SetColorWriteMask(const OpenGLFunctions& gl,
+                               uint32_t attachment,
+                               GLboolean red,
+                               GLboolean green,
+                               GLboolean blue,
+                               GLboolean alpha);
 
       private:
         void CallGLStencilFunc(const OpenGLFunctions& gl);
 
+        GLuint mVertexArrayObject = 0;
+
+        bool mCullFaceEnabled = false;
+        GLenum mFrontFace = GL_CCW;
+        GLenum mCullFace = GL_BACK;
+
+        bool mDepthTestEnabled = false;
+        GLboolean mDepthMask = GL_TRUE;
+        GLenum mDepthFunc = GL_LESS;
+
+        bool mStencilTestEnabled = false;
         GLenum mStencilBackCompareFunction = GL_ALWAYS;
         GLenum mStencilFrontCompareFunction = GL_ALWAYS;
         GLuint mStencilReadMask = 0xffffffff;
         GLuint mStencilReference = 0;
+        GLenum mStencilBackFailOp = GL_KEEP;
+        GLenum mStencilBackDepthFailOp = GL_KEEP;
+        GLenum mStencilBackPassOp = GL_KEEP;
+        GLenum mStencilFrontFailOp = GL_KEEP;
+        GLenum mStencilFrontDepthFailOp = GL_KEEP;
+        GLenum mStencilFrontPassOp = GL_KEEP;
+        GLuint mStencilWriteMask = 0xffffffff;
+
+        struct BlendState {
+            bool enabled = false;
+            GLenum colorOperation = GL_FUNC_ADD;
+            GLenum alphaOperation = GL_FUNC_ADD;
+            GLenum srcColorFactor = GL_ONE;
+            GLenum dstColorFactor = GL_ZERO;
+            GLenum srcAlphaFactor = GL_ONE;
+            GLenum dstAlphaFactor = GL_ZERO;
+            GLboolean writeRed = GL_TRUE;
+            GLboolean writeGreen = GL_TRUE;
+            GLboolean writeBlue = GL_TRUE;
+            GLboolean writeAlpha = GL_TRUE;
+        };
+        std::array<BlendState, kMaxColorAttachments> mBlendState;
     };
 
 }}  // namespace dawn_native::opengl
@@ -23,6 +23,91 @@ namespace dawn_native { namespace opengl {
 
     namespace {
 
+        GLenum VertexFormatType(wgpu::VertexFormat format) {
+            switch (format) {
+                case wgpu::VertexFormat::UChar2:
+                case wgpu::VertexFormat::UChar4:
+                case wgpu::VertexFormat::UChar2Norm:
+                case wgpu::VertexFormat::UChar4Norm:
+                    return GL_UNSIGNED_BYTE;
+                case wgpu::VertexFormat::Char2:
+                case wgpu::VertexFormat::Char4:
+                case wgpu::VertexFormat::Char2Norm:
+                case wgpu::VertexFormat::Char4Norm:
+                    return GL_BYTE;
+                case wgpu::VertexFormat::UShort2:
+                case wgpu::VertexFormat::UShort4:
+                case wgpu::VertexFormat::UShort2Norm:
+                case wgpu::VertexFormat::UShort4Norm:
+                    return GL_UNSIGNED_SHORT;
+                case wgpu::VertexFormat::Short2:
+                case wgpu::VertexFormat::Short4:
+                case wgpu::VertexFormat::Short2Norm:
+                case wgpu::VertexFormat::Short4Norm:
+                    return GL_SHORT;
+                case wgpu::VertexFormat::Half2:
+                case wgpu::VertexFormat::Half4:
+                    return GL_HALF_FLOAT;
+                case wgpu::VertexFormat::Float:
+                case wgpu::VertexFormat::Float2:
+                case wgpu::VertexFormat::Float3:
+                case wgpu::VertexFormat::Float4:
+                    return GL_FLOAT;
+                case wgpu::VertexFormat::UInt:
+                case wgpu::VertexFormat::UInt2:
+                case wgpu::VertexFormat::UInt3:
+                case wgpu::VertexFormat::UInt4:
+                    return GL_UNSIGNED_INT;
+                case wgpu::VertexFormat::Int:
+                case wgpu::VertexFormat::Int2:
+                case wgpu::VertexFormat::Int3:
+                case wgpu::VertexFormat::Int4:
+                    return GL_INT;
+                default:
+                    UNREACHABLE();
+            }
+        }
+
+        GLboolean VertexFormatIsNormalized(wgpu::VertexFormat format) {
+            switch (format) {
+                case wgpu::VertexFormat::UChar2Norm:
+                case wgpu::VertexFormat::UChar4Norm:
+                case wgpu::VertexFormat::Char2Norm:
+                case wgpu::VertexFormat::Char4Norm:
+                case wgpu::VertexFormat::UShort2Norm:
+                case wgpu::VertexFormat::UShort4Norm:
+                case wgpu::VertexFormat::Short2Norm:
+                case wgpu::VertexFormat::Short4Norm:
+                    return GL_TRUE;
+                default:
+                    return GL_FALSE;
+            }
+        }
+
+        bool VertexFormatIsInt(wgpu::VertexFormat format) {
+            switch (format) {
+                case wgpu::VertexFormat::UChar2:
+                case wgpu::VertexFormat::UChar4:
+                case wgpu::VertexFormat::Char2:
+                case wgpu::VertexFormat::Char4:
+                case wgpu::VertexFormat::UShort2:
+                case wgpu::VertexFormat::UShort4:
+                case wgpu::VertexFormat::Short2:
+                case wgpu::VertexFormat::Short4:
+                case wgpu::VertexFormat::UInt:
+                case wgpu::VertexFormat::UInt2:
+                case wgpu::VertexFormat::UInt3:
+                case wgpu::VertexFormat::UInt4:
+                case wgpu::VertexFormat::Int:
+                case wgpu::VertexFormat::Int2:
+                case wgpu::VertexFormat::Int3:
+                case wgpu::VertexFormat::Int4:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
         GLenum GLPrimitiveTopology(wgpu::PrimitiveTopology primitiveTopology) {
             switch (primitiveTopology) {
                 case wgpu::PrimitiveTopology::PointList:
@@ -42,18 +127,19 @@ namespace dawn_native { namespace opengl {
 
         void ApplyFrontFaceAndCulling(const OpenGLFunctions& gl,
                                       wgpu::FrontFace face,
-                                      wgpu::CullMode mode) {
+                                      wgpu::CullMode mode,
+                                      PersistentPipelineState* persistentPipelineState) {
             if (mode == wgpu::CullMode::None) {
-                gl.Disable(GL_CULL_FACE);
+                persistentPipelineState->SetCullFaceEnabled(gl, false);
             } else {
-                gl.Enable(GL_CULL_FACE);
+                persistentPipelineState->SetCullFaceEnabled(gl, true);
                 // Note that we invert winding direction in OpenGL. Because Y axis is up in OpenGL,
                 // which is different from WebGPU and other backends (Y axis is down).
                 GLenum direction = (face == wgpu::FrontFace::CCW) ? GL_CW : GL_CCW;
-                gl.FrontFace(direction);
+                persistentPipelineState->SetFrontFace(gl, direction);
 
                 GLenum cullMode = (mode == wgpu::CullMode::Front) ? GL_FRONT : GL_BACK;
-                gl.CullFace(cullMode);
+                persistentPipelineState->SetCullFace(gl, cullMode);
             }
         }
 
@@ -109,23 +195,26 @@ namespace dawn_native { namespace opengl {
 
         void ApplyColorState(const OpenGLFunctions& gl,
                              uint32_t attachment,
-                             const ColorStateDescriptor* descriptor) {
+                             const ColorStateDescriptor* descriptor,
+                             PersistentPipelineState* persistentPipelineState) {
             if (BlendEnabled(descriptor)) {
-                gl.Enablei(GL_BLEND, attachment);
-                gl.BlendEquationSeparatei(attachment, GLBlendMode(descriptor->colorBlend.operation),
-                                          GLBlendMode(descriptor->alphaBlend.operation));
-                gl.BlendFuncSeparatei(attachment,
-                                      GLBlendFactor(descriptor->colorBlend.srcFactor, false),
-                                      GLBlendFactor(descriptor->colorBlend.dstFactor, false),
-                                      GLBlendFactor(descriptor->alphaBlend.srcFactor, true),
-                                      GLBlendFactor(descriptor->alphaBlend.dstFactor, true));
+                persistentPipelineState->SetBlendEnabled(gl, attachment, true);
+                persistentPipelineState->SetBlendEquations(
+                    gl, attachment, GLBlendMode(descriptor->colorBlend.operation),
+                    GLBlendMode(descriptor->alphaBlend.operation));
+                persistentPipelineState->SetBlendFuncs(
+                    gl, attachment, GLBlendFactor(descriptor->colorBlend.srcFactor, false),
+                    GLBlendFactor(descriptor->colorBlend.dstFactor, false),
+                    GLBlendFactor(descriptor->alphaBlend.srcFactor, true),
+                    GLBlendFactor(descriptor->alphaBlend.dstFactor, true));
             } else {
-                gl.Disablei(GL_BLEND, attachment);
+                persistentPipelineState->SetBlendEnabled(gl, attachment, false);
             }
-            gl.ColorMaski(attachment, descriptor->writeMask & wgpu::ColorWriteMask::Red,
-                          descriptor->writeMask & wgpu::ColorWriteMask::Green,
-                          descriptor->writeMask & wgpu::ColorWriteMask::Blue,
-                          descriptor->writeMask & wgpu::ColorWriteMask::Alpha);
+            persistentPipelineState->SetColorWriteMask(
+                gl, attachment, descriptor->writeMask & wgpu::ColorWriteMask::Red,
+                descriptor->writeMask & wgpu::ColorWriteMask::Green,
+                descriptor->writeMask & wgpu::ColorWriteMask::Blue,
+                descriptor->writeMask & wgpu::ColorWriteMask::Alpha);
         }
 
         GLuint OpenGLStencilOperation(wgpu::StencilOperation stencilOperation) {
@@ -155,59 +244,53 @@ namespace dawn_native { namespace opengl {
                                     const DepthStencilStateDescriptor* descriptor,
                                     PersistentPipelineState* persistentPipelineState) {
             // Depth writes only occur if depth is enabled
-            if (descriptor->depthCompare == wgpu::CompareFunction::Always &&
-                !descriptor->depthWriteEnabled) {
-                gl.Disable(GL_DEPTH_TEST);
-            } else {
-                gl.Enable(GL_DEPTH_TEST);
-            }
+            bool depthTestEnabled = descriptor->depthCompare != wgpu::CompareFunction::Always ||
+                                    descriptor->depthWriteEnabled;
+            persistentPipelineState->SetDepthTestEnabled(gl, depthTestEnabled);
+            persistentPipelineState->SetDepthMask(
+                gl, descriptor->depthWriteEnabled ? GL_TRUE : GL_FALSE);
+            persistentPipelineState->SetDepthFunc(
+                gl, ToOpenGLCompareFunction(descriptor->depthCompare));
 
-            if (descriptor->depthWriteEnabled) {
-                gl.DepthMask(GL_TRUE);
-            } else {
-                gl.DepthMask(GL_FALSE);
-            }
-
-            gl.DepthFunc(ToOpenGLCompareFunction(descriptor->depthCompare));
-
-            if (StencilTestEnabled(descriptor)) {
-                gl.Enable(GL_STENCIL_TEST);
-            } else {
-                gl.Disable(GL_STENCIL_TEST);
-            }
+            persistentPipelineState->SetStencilTestEnabled(gl, StencilTestEnabled(descriptor));
 
             GLenum backCompareFunction = ToOpenGLCompareFunction(descriptor->stencilBack.compare);
             GLenum frontCompareFunction = ToOpenGLCompareFunction(descriptor->stencilFront.compare);
             persistentPipelineState->SetStencilFuncsAndMask(
                 gl, backCompareFunction, frontCompareFunction, descriptor->stencilReadMask);
 
-            gl.StencilOpSeparate(GL_BACK, OpenGLStencilOperation(descriptor->stencilBack.failOp),
-                                 OpenGLStencilOperation(descriptor->stencilBack.depthFailOp),
-                                 OpenGLStencilOperation(descriptor->stencilBack.passOp));
-            gl.StencilOpSeparate(GL_FRONT, OpenGLStencilOperation(descriptor->stencilFront.failOp),
-                                 OpenGLStencilOperation(descriptor->stencilFront.depthFailOp),
-                                 OpenGLStencilOperation(descriptor->stencilFront.passOp));
+            persistentPipelineState->SetStencilOps(
+                gl, OpenGLStencilOperation(descriptor->stencilBack.failOp),
+                OpenGLStencilOperation(descriptor->stencilBack.depthFailOp),
+                OpenGLStencilOperation(descriptor->stencilBack.passOp),
+                OpenGLStencilOperation(descriptor->stencilFront.failOp),
+                OpenGLStencilOperation(descriptor->stencilFront.depthFailOp),
+                OpenGLStencilOperation(descriptor->stencilFront.passOp));
 
-            gl.StencilMask(descriptor->stencilWriteMask);
+            persistentPipelineState->SetStencilWriteMask(gl, descriptor->stencilWriteMask);
         }
 
     }  // anonymous namespace
 
     RenderPipeline::RenderPipeline(Device* device, const RenderPipelineDescriptor* descriptor)
         : RenderPipelineBase(device, descriptor),
-          mVertexArrayObject(0),
           mGlPrimitiveTopology(GLPrimitiveTopology(GetPrimitiveTopology())) {
         PerStage<const ShaderModule*> modules(nullptr);
         modules[SingleShaderStage::Vertex] = ToBackend(descriptor->vertexStage.module);
         modules[SingleShaderStage::Fragment] = ToBackend(descriptor->fragmentStage->module);
 
         PipelineGL::Initialize(device->gl, ToBackend(GetLayout()), modules);
-        CreateVAOForVertexState(descriptor->vertexState);
+
+        for (uint32_t location : IterateBitSet(GetAttributeLocationsUsed())) {
+            attributesUsingVertexBuffer[GetAttribute(location).vertexBufferSlot][location] = true;
+        }
     }
 
     RenderPipeline::~RenderPipeline() {
         const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
-        gl.DeleteVertexArrays(1, &mVertexArrayObject);
+        for (auto& entry : mVertexArrayObjects) {
+            gl.DeleteVertexArrays(1, &entry.second);
+        }
         gl.BindVertexArray(0);
     }
 
@@ -215,18 +298,28 @@ namespace dawn_native { namespace opengl {
         return mGlPrimitiveTopology;
     }
 
-    void RenderPipeline::CreateVAOForVertexState(const VertexStateDescriptor* vertexState) {
-        const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
+    GLuint RenderPipeline::BindVAOForVertexBuffers(
+        const OpenGLFunctions& gl,
+        PersistentPipelineState* persistentPipelineState,
+        const std::array<GLuint, kMaxVertexBuffers>& bufferHandles,
+        const std::array<uint64_t, kMaxVertexBuffers>& bufferOffsets) {
+        VAOCacheKey key(bufferHandles, bufferOffsets);
+        auto it = mVertexArrayObjects.find(key);
+        if (it != mVertexArrayObjects.end()) {
+            persistentPipelineState->SetVertexArrayObject(gl, it->second);
+            return it->second;
+        }
 
-        gl.GenVertexArrays(1, &mVertexArrayObject);
-        gl.BindVertexArray(mVertexArrayObject);
+        GLuint vao = 0;
+        gl.GenVertexArrays(1, &vao);
+        persistentPipelineState->SetVertexArrayObject(gl, vao);
 
         for (uint32_t location : IterateBitSet(GetAttributeLocationsUsed())) {
             const auto& attribute = GetAttribute(location);
             gl.EnableVertexAttribArray(location);
 
-            attributesUsingVertexBuffer[attribute.vertexBufferSlot][location] = true;
-            const VertexBufferInfo& vertexBuffer = GetVertexBuffer(attribute.vertexBufferSlot);
+            uint32_t slot = attribute.vertexBufferSlot;
+            const VertexBufferInfo& vertexBuffer = GetVertexBuffer(slot);
 
             if (vertexBuffer.arrayStride == 0) {
                 // Emulate a stride of zero (constant vertex attribute) by
@@ -243,22 +336,39 @@ namespace dawn_native { namespace opengl {
                         UNREACHABLE();
                 }
             }
+
+            uint32_t components = VertexFormatNumComponents(attribute.format);
+            GLenum formatType = VertexFormatType(attribute.format);
+            uint64_t offset = bufferOffsets[slot] + attribute.offset;
+
+            gl.BindBuffer(GL_ARRAY_BUFFER, bufferHandles[slot]);
+            if (VertexFormatIsInt(attribute.format)) {
+                gl.VertexAttribIPointer(location, components, formatType,
+                                        vertexBuffer.arrayStride,
+                                        reinterpret_cast<void*>(static_cast<intptr_t>(offset)));
+            } else {
+                GLboolean normalized = VertexFormatIsNormalized(attribute.format);
+                gl.VertexAttribPointer(location, components, formatType, normalized,
+                                       vertexBuffer.arrayStride,
+                                       reinterpret_cast<void*>(static_cast<intptr_t>(offset)));
+            }
         }
+
+        mVertexArrayObjects[key] = vao;
+        return vao;
     }
 
     void RenderPipeline::ApplyNow(PersistentPipelineState& persistentPipelineState) {
         const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
         PipelineGL::ApplyNow(gl);
 
-        ASSERT(mVertexArrayObject);
-        gl.BindVertexArray(mVertexArrayObject);
-
-        ApplyFrontFaceAndCulling(gl, GetFrontFace(), GetCullMode());
+        ApplyFrontFaceAndCulling(gl, GetFrontFace(), GetCullMode(), &persistentPipelineState);
 
         ApplyDepthStencilState(gl, GetDepthStencilStateDescriptor(), &persistentPipelineState);
 
         for (uint32_t attachmentSlot : IterateBitSet(GetColorAttachmentsMask())) {
-            ApplyColorState(gl, attachmentSlot, GetColorStateDescriptor(attachmentSlot));
+            ApplyColorState(gl, attachmentSlot, GetColorStateDescriptor(attachmentSlot),
+                            &persistentPipelineState);
         }
     }
 
@@ -20,12 +20,16 @@
 #include "dawn_native/opengl/PipelineGL.h"
 #include "dawn_native/opengl/opengl_platform.h"
 
+#include <array>
+#include <map>
+#include <utility>
 #include <vector>
 
 namespace dawn_native { namespace opengl {
 
     class Device;
     class PersistentPipelineState;
+    struct OpenGLFunctions;
 
     class RenderPipeline final : public RenderPipelineBase, public PipelineGL {
       public:
@@ -33,14 +37,26 @@ namespace dawn_native { namespace opengl {
 
         GLenum GetGLPrimitiveTopology() const;
 
+        // Binds (creating it on first use) the VAO holding the full vertex specification for
+        // this pipeline's vertex state and the given vertex buffer bindings, and returns its
+        // handle. Repeated draw configurations reuse one GL object instead of re-specifying
+        // the attribute pointers. Only the slots in GetVertexBufferSlotsUsed() are read;
+        // unused entries must be zeroed so equal configurations produce equal cache keys.
+        GLuint BindVAOForVertexBuffers(const OpenGLFunctions& gl,
+                                       PersistentPipelineState* persistentPipelineState,
+                                       const std::array<GLuint, kMaxVertexBuffers>& bufferHandles,
+                                       const std::array<uint64_t, kMaxVertexBuffers>& bufferOffsets);
+
         void ApplyNow(PersistentPipelineState& persistentPipelineState);
 
       private:
         ~RenderPipeline() override;
-        void CreateVAOForVertexState(const VertexStateDescriptor* vertexState);
 
-        // TODO(yunchao.he@intel.com): vao need to be deduplicated between pipelines.
-        GLuint mVertexArrayObject;
+        // VAOs are keyed on the vertex buffer bindings they were specified with; the vertex
+        // state itself is constant for the lifetime of the pipeline.
+        using VAOCacheKey =
+            std::pair<std::array<GLuint, kMaxVertexBuffers>, std::array<uint64_t, kMaxVertexBuffers>>;
+        std::map<VAOCacheKey, GLuint> mVertexArrayObjects;
         GLenum mGlPrimitiveTopology;
     };
 
@@ -14,6 +14,8 @@
 
 #include "dawn_native/vulkan/AdapterVk.h"
 
+#include "common/Constants.h"
+
 #include "dawn_native/vulkan/BackendVk.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 
@@ -37,6 +39,23 @@ namespace dawn_native { namespace vulkan {
         return mBackend;
     }
 
+    std::vector<uint8_t> Adapter::GetAccelerationContainerCompatibilityId() const {
+        // Vulkan ties acceleration structure compatibility to the device and driver,
+        // so their UUIDs together identify which blobs can be deserialized. The UUIDs
+        // are only gathered when vkGetPhysicalDeviceProperties2 is available.
+        if (!mBackend->GetGlobalInfo().getPhysicalDeviceProperties2) {
+            return {};
+        }
+
+        std::vector<uint8_t> id;
+        id.reserve(2 * VK_UUID_SIZE);
+        id.insert(id.end(), mDeviceInfo.idProperties.driverUUID,
+                  mDeviceInfo.idProperties.driverUUID + VK_UUID_SIZE);
+        id.insert(id.end(), mDeviceInfo.idProperties.deviceUUID,
+                  mDeviceInfo.idProperties.deviceUUID + VK_UUID_SIZE);
+        return id;
+    }
+
     MaybeError Adapter::Initialize() {
         DAWN_TRY_ASSIGN(mDeviceInfo, GatherDeviceInfo(*this));
         if (!mDeviceInfo.maintenance1) {
@@ -78,6 +97,10 @@ namespace dawn_native { namespace vulkan {
             mSupportedExtensions.EnableExtension(Extension::RayTracing);
         }
 
+        if (mDeviceInfo.rayTracingKHR && mDeviceInfo.rayTracingFeatures.rayQuery == VK_TRUE) {
+            mSupportedExtensions.EnableExtension(Extension::RayQuery);
+        }
+
         if (mDeviceInfo.shaderFloat16Int8 &&
             mDeviceInfo.shaderFloat16Int8Features.shaderFloat16 == VK_TRUE &&
             mDeviceInfo._16BitStorage &&
@@ -92,6 +115,14 @@ namespace dawn_native { namespace vulkan {
         if (mDeviceInfo.properties.limits.timestampComputeAndGraphics == VK_TRUE) {
             mSupportedExtensions.EnableExtension(Extension::TimestampQuery);
         }
+
+        if (mDeviceInfo.properties.limits.maxPushConstantsSize >= kMaxImmediateDataBytes) {
+            mSupportedExtensions.EnableExtension(Extension::ImmediateData);
+        }
+
+        // Specialization constants are core Vulkan; other backends would need to patch
+        // or recompile shaders, so the extension is only advertised here.
+        mSupportedExtensions.EnableExtension(Extension::SpecializationConstants);
     }
 
     ResultOrError<DeviceBase*> Adapter::CreateDeviceImpl(const DeviceDescriptor* descriptor) {
@@ -24,7 +24,7 @@ namespace dawn_native { namespace vulkan {
 
     class Backend;
 
-    class Adapter : public AdapterBase {
+    class Adapter final : public AdapterBase {
       public:
         Adapter(Backend* backend, VkPhysicalDevice physicalDevice);
         ~Adapter() override = default;
@@ -33,6 +33,8 @@ namespace dawn_native { namespace vulkan {
         VkPhysicalDevice GetPhysicalDevice() const;
         Backend* GetBackend() const;
 
+        std::vector<uint8_t> GetAccelerationContainerCompatibilityId() const override;
+
         MaybeError Initialize();
 
       private:
@@ -23,7 +23,7 @@
 
 namespace dawn_native { namespace vulkan {
 
-    class Backend : public BackendConnection {
+    class Backend final : public BackendConnection {
       public:
         Backend(InstanceBase* instance);
         ~Backend() override;
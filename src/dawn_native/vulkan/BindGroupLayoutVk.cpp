@@ -21,6 +21,7 @@
 #include "dawn_native/vulkan/DescriptorSetAllocator.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/SamplerVk.h"
 #include "dawn_native/vulkan/UtilsVulkan.h"
 #include "dawn_native/vulkan/VulkanError.h"
 
@@ -70,6 +71,8 @@ namespace dawn_native { namespace vulkan {
         // bindings of the same type.
         uint32_t numBindings = 0;
         std::array<VkDescriptorSetLayoutBinding, kMaxBindingsPerGroup> bindings;
+        std::array<VkSampler, kMaxBindingsPerGroup> immutableSamplers;
+        std::array<VkDescriptorBindingFlags, kMaxBindingsPerGroup> bindingFlags;
         for (const auto& it : GetBindingMap()) {
             BindingNumber bindingNumber = it.first;
             BindingIndex bindingIndex = it.second;
@@ -78,9 +81,26 @@ namespace dawn_native { namespace vulkan {
             vkBinding->binding = bindingNumber;
             vkBinding->descriptorType =
                 VulkanDescriptorType(bindingInfo.type, bindingInfo.hasDynamicOffset);
-            vkBinding->descriptorCount = 1;
+            vkBinding->descriptorCount = bindingInfo.bindingArraySize;
             vkBinding->stageFlags = ToVulkanShaderStageFlags(bindingInfo.visibility);
             vkBinding->pImmutableSamplers = nullptr;
+
+            // Binding arrays use update-after-bind semantics: the bind group never writes
+            // their descriptors so the application can fill them in after creation.
+            bindingFlags[numBindings] = 0;
+            if (bindingInfo.bindingArraySize > 1) {
+                bindingFlags[numBindings] = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                                            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+            }
+
+            // Embed static samplers into the descriptor set layout so bind groups never
+            // write a descriptor for them. The sampler is kept alive by the frontend
+            // layout's reference.
+            SamplerBase* staticSampler = GetStaticSampler(bindingIndex);
+            if (staticSampler != nullptr) {
+                immutableSamplers[numBindings] = ToBackend(staticSampler)->GetHandle();
+                vkBinding->pImmutableSamplers = &*immutableSamplers[numBindings];
+            }
             numBindings++;
         }
         VkDescriptorSetLayoutCreateInfo createInfo;
@@ -91,10 +111,83 @@ namespace dawn_native { namespace vulkan {
         createInfo.pBindings = bindings.data();
 
         Device* device = ToBackend(GetDevice());
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsCreateInfo;
+        if (GetBindingArrayCount() > 0) {
+            if (!device->GetDeviceInfo().descriptorIndexing) {
+                return DAWN_VALIDATION_ERROR(
+                    "binding arrays require the Vulkan descriptor indexing extension");
+            }
+            bindingFlagsCreateInfo.sType =
+                VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+            bindingFlagsCreateInfo.pNext = nullptr;
+            bindingFlagsCreateInfo.bindingCount = numBindings;
+            bindingFlagsCreateInfo.pBindingFlags = bindingFlags.data();
+            createInfo.pNext = &bindingFlagsCreateInfo;
+            createInfo.flags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+        }
         DAWN_TRY(CheckVkSuccess(device->fn.CreateDescriptorSetLayout(
                                     device->GetVkDevice(), &createInfo, nullptr, &*mHandle),
                                 "CreateDescriptorSetLayout"));
 
+        // Cache a descriptor update template so bind groups of this layout can be written
+        // with a single vkUpdateDescriptorSetWithTemplate call from a packed blob instead of
+        // one VkWriteDescriptorSet per binding. Acceleration container descriptors cannot be
+        // written through a template, so such layouts keep the vkUpdateDescriptorSets path.
+        if (device->fn.CreateDescriptorUpdateTemplateKHR != nullptr) {
+            uint32_t numEntries = 0;
+            bool templateUsable = true;
+            std::array<VkDescriptorUpdateTemplateEntry, kMaxBindingsPerGroup> entries;
+            for (const auto& it : GetBindingMap()) {
+                BindingNumber bindingNumber = it.first;
+                BindingIndex bindingIndex = it.second;
+                const BindingInfo& bindingInfo = GetBindingInfo(bindingIndex);
+
+                if (bindingInfo.type == wgpu::BindingType::AccelerationContainer) {
+                    templateUsable = false;
+                    break;
+                }
+                // Static samplers are embedded in the descriptor set layout, no descriptor
+                // is ever written for them. Binding arrays are written by the application
+                // after creation, not by the bind group.
+                if (GetStaticSampler(bindingIndex) != nullptr ||
+                    bindingInfo.bindingArraySize > 1) {
+                    continue;
+                }
+
+                VkDescriptorUpdateTemplateEntry* entry = &entries[numEntries];
+                entry->dstBinding = bindingNumber;
+                entry->dstArrayElement = 0;
+                entry->descriptorCount = 1;
+                entry->descriptorType =
+                    VulkanDescriptorType(bindingInfo.type, bindingInfo.hasDynamicOffset);
+                entry->offset = numEntries * sizeof(DescriptorSetUpdateData);
+                entry->stride = sizeof(DescriptorSetUpdateData);
+                numEntries++;
+            }
+
+            if (templateUsable && numEntries > 0) {
+                VkDescriptorUpdateTemplateCreateInfo templateCreateInfo;
+                templateCreateInfo.sType =
+                    VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+                templateCreateInfo.pNext = nullptr;
+                templateCreateInfo.flags = 0;
+                templateCreateInfo.descriptorUpdateEntryCount = numEntries;
+                templateCreateInfo.pDescriptorUpdateEntries = entries.data();
+                templateCreateInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+                templateCreateInfo.descriptorSetLayout = mHandle;
+                // Ignored for the DESCRIPTOR_SET template type.
+                templateCreateInfo.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+                templateCreateInfo.pipelineLayout = VK_NULL_HANDLE;
+                templateCreateInfo.set = 0;
+
+                DAWN_TRY(CheckVkSuccess(device->fn.CreateDescriptorUpdateTemplateKHR(
+                                            device->GetVkDevice(), &templateCreateInfo, nullptr,
+                                            &*mUpdateTemplate),
+                                        "CreateDescriptorUpdateTemplate"));
+            }
+        }
+
         // Compute the size of descriptor pools used for this layout.
         std::map<VkDescriptorType, uint32_t> descriptorCountPerType;
 
@@ -104,7 +197,7 @@ namespace dawn_native { namespace vulkan {
                 VulkanDescriptorType(bindingInfo.type, bindingInfo.hasDynamicOffset);
 
             // map::operator[] will return 0 if the key doesn't exist.
-            descriptorCountPerType[vulkanType]++;
+            descriptorCountPerType[vulkanType] += bindingInfo.bindingArraySize;
         }
 
         // TODO(enga): Consider deduping allocators for layouts with the same descriptor type
@@ -133,12 +226,24 @@ namespace dawn_native { namespace vulkan {
             device->fn.DestroyDescriptorSetLayout(device->GetVkDevice(), mHandle, nullptr);
             mHandle = VK_NULL_HANDLE;
         }
+
+        // Update templates are only read during descriptor set updates, never by execution
+        // on the GPU, so they can be destroyed immediately as well.
+        if (mUpdateTemplate != VK_NULL_HANDLE) {
+            device->fn.DestroyDescriptorUpdateTemplateKHR(device->GetVkDevice(), mUpdateTemplate,
+                                                          nullptr);
+            mUpdateTemplate = VK_NULL_HANDLE;
+        }
     }
 
     VkDescriptorSetLayout BindGroupLayout::GetHandle() const {
         return mHandle;
     }
 
+    VkDescriptorUpdateTemplate BindGroupLayout::GetDescriptorUpdateTemplate() const {
+        return mUpdateTemplate;
+    }
+
     ResultOrError<BindGroup*> BindGroupLayout::AllocateBindGroup(
         Device* device,
         const BindGroupDescriptor* descriptor) {
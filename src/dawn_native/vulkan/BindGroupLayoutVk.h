@@ -32,6 +32,13 @@ namespace dawn_native { namespace vulkan {
 
     VkDescriptorType VulkanDescriptorType(wgpu::BindingType type, bool isDynamic);
 
+    // One entry of the packed blob consumed by vkUpdateDescriptorSetWithTemplate. Each
+    // template entry reads either a buffer or an image descriptor at the same packed index.
+    union DescriptorSetUpdateData {
+        VkDescriptorBufferInfo bufferInfo;
+        VkDescriptorImageInfo imageInfo;
+    };
+
     // In Vulkan descriptor pools have to be sized to an exact number of descriptors. This means
     // it's hard to have something where we can mix different types of descriptor sets because
     // we don't know if their vector of number of descriptors will be similar.
@@ -53,6 +60,12 @@ namespace dawn_native { namespace vulkan {
 
         VkDescriptorSetLayout GetHandle() const;
 
+        // The cached update template for writing bind groups of this layout from a packed
+        // array of DescriptorSetUpdateData, or VK_NULL_HANDLE if the device doesn't support
+        // VK_KHR_descriptor_update_template or the layout contains bindings that cannot be
+        // written through a template.
+        VkDescriptorUpdateTemplate GetDescriptorUpdateTemplate() const;
+
         ResultOrError<BindGroup*> AllocateBindGroup(Device* device,
                                                     const BindGroupDescriptor* descriptor);
         void DeallocateBindGroup(BindGroup* bindGroup,
@@ -64,6 +77,7 @@ namespace dawn_native { namespace vulkan {
         MaybeError Initialize();
 
         VkDescriptorSetLayout mHandle = VK_NULL_HANDLE;
+        VkDescriptorUpdateTemplate mUpdateTemplate = VK_NULL_HANDLE;
 
         SlabAllocator<BindGroup> mBindGroupAllocator;
         std::unique_ptr<DescriptorSetAllocator> mDescriptorSetAllocator;
@@ -37,6 +37,81 @@ namespace dawn_native { namespace vulkan {
                          DescriptorSetAllocation descriptorSetAllocation)
         : BindGroupBase(this, device, descriptor),
           mDescriptorSetAllocation(descriptorSetAllocation) {
+        // Fast path: when the layout cached a descriptor update template, fill the packed
+        // data blob in the layout's entry order and write the whole set with a single
+        // vkUpdateDescriptorSetWithTemplate call.
+        VkDescriptorUpdateTemplate updateTemplate =
+            ToBackend(GetLayout())->GetDescriptorUpdateTemplate();
+        if (updateTemplate != VK_NULL_HANDLE) {
+            uint32_t numEntries = 0;
+            std::array<DescriptorSetUpdateData, kMaxBindingsPerGroup> updateData;
+
+            for (const auto& it : GetLayout()->GetBindingMap()) {
+                BindingIndex bindingIndex = it.second;
+                const BindingInfo& bindingInfo = GetLayout()->GetBindingInfo(bindingIndex);
+
+                // The template has no entry for binding arrays, the application writes
+                // their descriptors after creation.
+                if (bindingInfo.bindingArraySize > 1) {
+                    continue;
+                }
+
+                switch (bindingInfo.type) {
+                    case wgpu::BindingType::UniformBuffer:
+                    case wgpu::BindingType::StorageBuffer:
+                    case wgpu::BindingType::ReadonlyStorageBuffer: {
+                        BufferBinding binding = GetBindingAsBufferBinding(bindingIndex);
+
+                        Buffer* buffer = ToBackend(binding.buffer);
+                        updateData[numEntries].bufferInfo.buffer = buffer->GetHandle();
+                        updateData[numEntries].bufferInfo.offset =
+                            buffer->GetHandleOffset() + binding.offset;
+                        updateData[numEntries].bufferInfo.range = binding.size;
+                        break;
+                    }
+
+                    case wgpu::BindingType::Sampler:
+                    case wgpu::BindingType::ComparisonSampler: {
+                        if (GetLayout()->GetStaticSampler(bindingIndex) != nullptr) {
+                            // The template has no entry for static samplers, they are
+                            // embedded in the descriptor set layout.
+                            continue;
+                        }
+                        Sampler* sampler = ToBackend(GetBindingAsSampler(bindingIndex));
+                        updateData[numEntries].imageInfo.sampler = sampler->GetHandle();
+                        break;
+                    }
+
+                    case wgpu::BindingType::SampledTexture: {
+                        TextureView* view = ToBackend(GetBindingAsTextureView(bindingIndex));
+                        updateData[numEntries].imageInfo.imageView = view->GetHandle();
+                        updateData[numEntries].imageInfo.imageLayout =
+                            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                        break;
+                    }
+
+                    case wgpu::BindingType::ReadonlyStorageTexture:
+                    case wgpu::BindingType::WriteonlyStorageTexture: {
+                        TextureView* view = ToBackend(GetBindingAsTextureView(bindingIndex));
+                        updateData[numEntries].imageInfo.imageView = view->GetHandle();
+                        updateData[numEntries].imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+                        break;
+                    }
+
+                    default:
+                        // Layouts with acceleration container bindings never cache a
+                        // template.
+                        UNREACHABLE();
+                }
+
+                numEntries++;
+            }
+
+            device->fn.UpdateDescriptorSetWithTemplateKHR(device->GetVkDevice(), GetHandle(),
+                                                          updateTemplate, updateData.data());
+            return;
+        }
+
         // Now do a write of a single descriptor set with all possible chained data allocated on the
         // stack.
         uint32_t numWrites = 0;
@@ -52,6 +127,12 @@ namespace dawn_native { namespace vulkan {
             BindingIndex bindingIndex = it.second;
             const BindingInfo& bindingInfo = GetLayout()->GetBindingInfo(bindingIndex);
 
+            // Binding arrays use update-after-bind semantics, the bind group has no
+            // resources to write for them.
+            if (bindingInfo.bindingArraySize > 1) {
+                continue;
+            }
+
             auto& write = writes[numWrites];
             write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
             write.pNext = nullptr;
@@ -68,8 +149,9 @@ namespace dawn_native { namespace vulkan {
                 case wgpu::BindingType::ReadonlyStorageBuffer: {
                     BufferBinding binding = GetBindingAsBufferBinding(bindingIndex);
 
-                    writeBufferInfo[numWrites].buffer = ToBackend(binding.buffer)->GetHandle();
-                    writeBufferInfo[numWrites].offset = binding.offset;
+                    Buffer* buffer = ToBackend(binding.buffer);
+                    writeBufferInfo[numWrites].buffer = buffer->GetHandle();
+                    writeBufferInfo[numWrites].offset = buffer->GetHandleOffset() + binding.offset;
                     writeBufferInfo[numWrites].range = binding.size;
                     write.pBufferInfo = &writeBufferInfo[numWrites];
                     break;
@@ -77,6 +159,11 @@ namespace dawn_native { namespace vulkan {
 
                 case wgpu::BindingType::Sampler:
                 case wgpu::BindingType::ComparisonSampler: {
+                    if (GetLayout()->GetStaticSampler(bindingIndex) != nullptr) {
+                        // The sampler is embedded in the descriptor set layout as an
+                        // immutable sampler, there is nothing to write.
+                        continue;
+                    }
                     Sampler* sampler = ToBackend(GetBindingAsSampler(bindingIndex));
                     writeImageInfo[numWrites].sampler = sampler->GetHandle();
                     write.pImageInfo = &writeImageInfo[numWrites];
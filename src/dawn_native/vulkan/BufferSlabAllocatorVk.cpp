@@ -0,0 +1,166 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/vulkan/BufferSlabAllocatorVk.h"
+
+#include <algorithm>
+
+#include "dawn_native/vulkan/DeviceVk.h"
+#include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/ResourceHeapVk.h"
+#include "dawn_native/vulkan/VulkanError.h"
+
+namespace dawn_native { namespace vulkan {
+
+    namespace {
+
+        // TODO(cwallez@chromium.org): Like the resource memory heuristics, these are
+        // hardcoded but should ideally depend on the size of the memory heaps.
+        constexpr uint64_t kMaxBufferSlabSystemSize = 4ull * 1024ull * 1024ull * 1024ull;  // 4GB
+        constexpr uint64_t kMaxSizeForBufferSubAllocation = 64ull * 1024ull;               // 64KB
+
+        // Slabs are sized like DynamicUploader's staging rings so a single slab can hold
+        // thousands of small uniform buffers.
+        constexpr uint64_t kBufferSlabSize = 4ull * 1024ull * 1024ull;  // 4MB
+
+        // Slabs may hold buffers of any non-mappable usage, so they are created with the
+        // union of the usages a pooled buffer can have. Mappable buffers aren't pooled
+        // because the mapped pointer belongs to a dedicated allocation, and neither are
+        // ray tracing buffers because their device address must resolve to the start of
+        // the VkBuffer.
+        constexpr VkBufferUsageFlags kBufferSlabUsage =
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+            VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+
+        // A slab is a VkBuffer bound to its own direct memory allocation. The buddy
+        // system tracks it as a resource heap and sub-allocates offsets inside it.
+        class BufferSlab : public ResourceHeapBase {
+          public:
+            BufferSlab(VkBuffer buffer, ResourceMemoryAllocation memory)
+                : mBuffer(buffer), mMemory(memory) {
+            }
+            ~BufferSlab() override = default;
+
+            VkBuffer GetBuffer() const {
+                return mBuffer;
+            }
+
+            ResourceMemoryAllocation* GetMemory() {
+                return &mMemory;
+            }
+
+          private:
+            VkBuffer mBuffer = VK_NULL_HANDLE;
+            ResourceMemoryAllocation mMemory;
+        };
+
+    }  // anonymous namespace
+
+    BufferSlabAllocator::BufferSlabAllocator(Device* device)
+        : mDevice(device),
+          mOffsetAlignment(std::max(
+              {static_cast<uint64_t>(
+                   device->GetDeviceInfo().properties.limits.minUniformBufferOffsetAlignment),
+               static_cast<uint64_t>(
+                   device->GetDeviceInfo().properties.limits.minStorageBufferOffsetAlignment),
+               uint64_t(4)})),
+          mBuddySystem(kMaxBufferSlabSystemSize, kBufferSlabSize, this) {
+    }
+
+    BufferSlabAllocator::~BufferSlabAllocator() = default;
+
+    ResultOrError<BufferSlabAllocator::BufferSlabAllocation> BufferSlabAllocator::Allocate(
+        uint64_t size) {
+        BufferSlabAllocation result;
+
+        if (size > kMaxSizeForBufferSubAllocation) {
+            return std::move(result);
+        }
+
+        // Allocate at least 4 bytes so that zero-sized buffers still get a valid range.
+        DAWN_TRY_ASSIGN(result.allocation,
+                        mBuddySystem.Allocate(std::max(size, uint64_t(4)), mOffsetAlignment));
+        if (result.allocation.GetInfo().mMethod == AllocationMethod::kInvalid) {
+            return std::move(result);
+        }
+
+        result.buffer = static_cast<BufferSlab*>(result.allocation.GetResourceHeap())->GetBuffer();
+        result.offset = result.allocation.GetOffset();
+        return std::move(result);
+    }
+
+    void BufferSlabAllocator::Deallocate(ResourceMemoryAllocation* allocation) {
+        ASSERT(allocation->GetInfo().mMethod == AllocationMethod::kSubAllocated);
+
+        // Like resource memory sub-allocations, the range can't be reused until the GPU
+        // is done with the buffer, otherwise a new buffer could alias it and would
+        // require a barrier.
+        mSubAllocationsToDelete.Enqueue(*allocation, mDevice->GetPendingCommandSerial());
+
+        allocation->Invalidate();
+    }
+
+    void BufferSlabAllocator::Tick(Serial completedSerial) {
+        for (const ResourceMemoryAllocation& allocation :
+             mSubAllocationsToDelete.IterateUpTo(completedSerial)) {
+            mBuddySystem.Deallocate(allocation);
+        }
+
+        mSubAllocationsToDelete.ClearUpTo(completedSerial);
+    }
+
+    ResultOrError<std::unique_ptr<ResourceHeapBase>> BufferSlabAllocator::AllocateResourceHeap(
+        uint64_t size) {
+        VkBufferCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.size = size;
+        createInfo.usage = kBufferSlabUsage;
+        createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount = 0;
+        createInfo.pQueueFamilyIndices = 0;
+
+        VkBuffer buffer = VK_NULL_HANDLE;
+        DAWN_TRY(CheckVkSuccess(
+            mDevice->fn.CreateBuffer(mDevice->GetVkDevice(), &createInfo, nullptr, &*buffer),
+            "vkCreateBuffer"));
+
+        VkMemoryRequirements requirements;
+        mDevice->fn.GetBufferMemoryRequirements(mDevice->GetVkDevice(), buffer, &requirements);
+
+        // Slabs are as large as kMaxSizeForSubAllocation so this is always a direct
+        // memory allocation and doesn't recurse into another buddy system.
+        ResourceMemoryAllocation memory;
+        DAWN_TRY_ASSIGN(memory,
+                        mDevice->AllocateMemory(requirements, false, AllocationClass::Buffer));
+
+        DAWN_TRY(CheckVkSuccess(
+            mDevice->fn.BindBufferMemory(mDevice->GetVkDevice(), buffer,
+                                         ToBackend(memory.GetResourceHeap())->GetMemory(),
+                                         memory.GetOffset()),
+            "vkBindBufferMemory"));
+
+        return {std::make_unique<BufferSlab>(buffer, memory)};
+    }
+
+    void BufferSlabAllocator::DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) {
+        BufferSlab* slab = static_cast<BufferSlab*>(allocation.get());
+        mDevice->GetFencedDeleter()->DeleteWhenUnused(slab->GetBuffer());
+        mDevice->DeallocateMemory(slab->GetMemory());
+    }
+
+}}  // namespace dawn_native::vulkan
@@ -0,0 +1,81 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_BUFFERSLABALLOCATORVK_H_
+#define DAWNNATIVE_VULKAN_BUFFERSLABALLOCATORVK_H_
+
+#include <memory>
+
+#include "common/SerialQueue.h"
+#include "common/vulkan_platform.h"
+#include "dawn_native/BuddyMemoryAllocator.h"
+#include "dawn_native/Error.h"
+#include "dawn_native/ResourceHeapAllocator.h"
+#include "dawn_native/ResourceMemoryAllocation.h"
+
+namespace dawn_native { namespace vulkan {
+
+    class Device;
+
+    // BufferSlabAllocator sub-allocates small buffers out of large shared VkBuffers
+    // ("slabs"), the same way DynamicUploader shares its staging memory between many
+    // uploads. Binding a dedicated VkBuffer has a per-buffer driver cost and pads every
+    // allocation to the memory requirements' alignment, which wastes most of the memory
+    // of tiny uniform buffers. Pooled buffers instead address their data through an
+    // offset into the slab.
+    class BufferSlabAllocator final : public ResourceHeapAllocator {
+      public:
+        struct BufferSlabAllocation {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            uint64_t offset = 0;
+            ResourceMemoryAllocation allocation;
+        };
+
+        BufferSlabAllocator(Device* device);
+        ~BufferSlabAllocator() override;
+
+        // Returns an allocation with an invalid method when |size| is too large to be
+        // pooled or when no slab space could be found, in which case the caller should
+        // fall back to a dedicated VkBuffer.
+        ResultOrError<BufferSlabAllocation> Allocate(uint64_t size);
+
+        void Deallocate(ResourceMemoryAllocation* allocation);
+
+        void Tick(Serial completedSerial);
+
+        // Implementation of the ResourceHeapAllocator interface to be a client of
+        // BuddyMemoryAllocator. Heaps are whole slabs: a VkBuffer bound to its own
+        // direct memory allocation.
+        ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(
+            uint64_t size) override;
+        void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override;
+
+      private:
+        Device* mDevice;
+
+        // Offsets handed out to descriptors and copies must respect the device's buffer
+        // offset alignment limits, so they are computed once at creation.
+        uint64_t mOffsetAlignment;
+
+        BuddyMemoryAllocator mBuddySystem;
+
+        // Like resource memory sub-allocations, freed slab ranges aren't reusable
+        // immediately because a new buffer could alias the old one's data without a
+        // barrier.
+        SerialQueue<ResourceMemoryAllocation> mSubAllocationsToDelete;
+    };
+
+}}  // namespace dawn_native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_BUFFERSLABALLOCATORVK_H_
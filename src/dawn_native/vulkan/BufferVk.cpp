@@ -16,6 +16,8 @@
 
 #include <cstring>
 
+#include "common/Counters.h"
+#include "dawn_native/vulkan/BufferSlabAllocatorVk.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/ResourceHeapVk.h"
@@ -53,6 +55,9 @@ namespace dawn_native { namespace vulkan {
             if (usage & wgpu::BufferUsage::RayTracing) {
                 flags |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
             }
+            if (usage & wgpu::BufferUsage::QueryResolve) {
+                flags |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            }
 
             return flags;
         }
@@ -79,6 +84,12 @@ namespace dawn_native { namespace vulkan {
             if (usage & wgpu::BufferUsage::Indirect) {
                 flags |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
             }
+            if (usage & wgpu::BufferUsage::RayTracing) {
+                flags |= VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR;
+            }
+            if (usage & wgpu::BufferUsage::QueryResolve) {
+                flags |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+            }
 
             return flags;
         }
@@ -113,6 +124,12 @@ namespace dawn_native { namespace vulkan {
             if (usage & wgpu::BufferUsage::Indirect) {
                 flags |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
             }
+            if (usage & wgpu::BufferUsage::RayTracing) {
+                flags |= VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+            }
+            if (usage & wgpu::BufferUsage::QueryResolve) {
+                flags |= VK_ACCESS_TRANSFER_WRITE_BIT;
+            }
 
             return flags;
         }
@@ -126,6 +143,231 @@ namespace dawn_native { namespace vulkan {
         return buffer.Detach();
     }
 
+    // static
+    ResultOrError<Buffer*> Buffer::CreateFromExternalMemory(
+        Device* device,
+        const BufferDescriptor* descriptor,
+        external_memory::Service* externalMemoryService,
+        ExternalMemoryHandle memoryHandle,
+        VkDeviceSize allocationSize,
+        uint32_t memoryTypeIndex,
+        const std::vector<VkSemaphore>& waitSemaphores,
+        VkSemaphore signalSemaphore) {
+        Ref<Buffer> buffer = AcquireRef(new Buffer(device, descriptor));
+        DAWN_TRY(buffer->InitializeFromExternalMemory(externalMemoryService, memoryHandle,
+                                                      allocationSize, memoryTypeIndex,
+                                                      waitSemaphores, signalSemaphore));
+        return buffer.Detach();
+    }
+
+    // static
+    ResultOrError<Buffer*> Buffer::CreateFromHostPointer(Device* device,
+                                                         const BufferDescriptor* descriptor,
+                                                         void* hostPointer,
+                                                         uint64_t allocationSize) {
+        Ref<Buffer> buffer = AcquireRef(new Buffer(device, descriptor));
+        DAWN_TRY(buffer->InitializeFromHostPointer(hostPointer, allocationSize));
+        return buffer.Detach();
+    }
+
+    // static
+    ResultOrError<Buffer*> Buffer::CreateExportable(
+        Device* device,
+        const BufferDescriptor* descriptor,
+        external_memory::Service* externalMemoryService,
+        VkSemaphore signalSemaphore,
+        ExternalMemoryHandle* outMemoryHandle,
+        VkDeviceSize* outAllocationSize,
+        uint32_t* outMemoryTypeIndex) {
+        Ref<Buffer> buffer = AcquireRef(new Buffer(device, descriptor));
+        DAWN_TRY(buffer->InitializeAsExportableBuffer(externalMemoryService, signalSemaphore,
+                                                      outMemoryHandle, outAllocationSize,
+                                                      outMemoryTypeIndex));
+        return buffer.Detach();
+    }
+
+    // Creates the dedicated VkBuffer for a buffer bound to external memory.
+    MaybeError Buffer::CreateHandleForExternalMemory(VkExternalMemoryHandleTypeFlagBits handleType) {
+        Device* device = ToBackend(GetDevice());
+
+        // The mapped pointer and the device address of external memory aren't plumbed.
+        if (GetUsage() & (wgpu::BufferUsage::MapRead | wgpu::BufferUsage::MapWrite |
+                          wgpu::BufferUsage::RayTracing)) {
+            return DAWN_VALIDATION_ERROR(
+                "External buffers don't support map or ray tracing usages");
+        }
+
+        VkExternalMemoryBufferCreateInfo externalCreateInfo;
+        externalCreateInfo.sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO;
+        externalCreateInfo.pNext = nullptr;
+        externalCreateInfo.handleTypes = handleType;
+
+        VkBufferCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext = &externalCreateInfo;
+        createInfo.flags = 0;
+        // Rounded up to 4 so the 4-byte aligned vkCmdFillBuffer in InitializeToZero
+        // stays within the buffer.
+        createInfo.size = std::max((GetSize() + 3) & ~uint64_t(3), uint64_t(4u));
+        // Add CopyDst for robust resource initialization, matching internal buffers.
+        createInfo.usage = VulkanBufferUsage(GetUsage() | wgpu::BufferUsage::CopyDst);
+        createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount = 0;
+        createInfo.pQueueFamilyIndices = 0;
+
+        DAWN_TRY(CheckVkSuccess(
+            device->fn.CreateBuffer(device->GetVkDevice(), &createInfo, nullptr, &*mHandle),
+            "vkCreateBuffer"));
+        return {};
+    }
+
+    MaybeError Buffer::InitializeFromExternalMemory(
+        external_memory::Service* externalMemoryService,
+        ExternalMemoryHandle memoryHandle,
+        VkDeviceSize allocationSize,
+        uint32_t memoryTypeIndex,
+        const std::vector<VkSemaphore>& waitSemaphores,
+        VkSemaphore signalSemaphore) {
+        Device* device = ToBackend(GetDevice());
+
+        DAWN_TRY(CreateHandleForExternalMemory(externalMemoryService->GetMemoryHandleType()));
+
+        external_memory::MemoryImportParams importParams = {allocationSize, memoryTypeIndex};
+        DAWN_TRY_ASSIGN(mExternalAllocation, externalMemoryService->ImportBufferMemory(
+                                                 memoryHandle, importParams, mHandle));
+
+        DAWN_TRY(CheckVkSuccess(
+            device->fn.BindBufferMemory(device->GetVkDevice(), mHandle, mExternalAllocation, 0),
+            "vkBindBufferMemory (external)"));
+
+        // Success: the pending submit waits on the exporting device's semaphores and acquires
+        // the memory from the external queue family before any use of the buffer. The wait
+        // semaphores are owned by the recording context from here on.
+        CommandRecordingContext* recordingContext = device->GetPendingRecordingContext();
+        recordingContext->waitSemaphores.insert(recordingContext->waitSemaphores.end(),
+                                                waitSemaphores.begin(), waitSemaphores.end());
+
+        VkBufferMemoryBarrier barrier;
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.pNext = nullptr;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VulkanAccessFlags(GetUsage());
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_EXTERNAL_KHR;
+        barrier.dstQueueFamilyIndex = device->GetGraphicsQueueFamily();
+        barrier.buffer = mHandle;
+        barrier.offset = 0;
+        barrier.size = VK_WHOLE_SIZE;
+
+        device->fn.CmdPipelineBarrier(recordingContext->commandBuffer,
+                                      VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                      VulkanPipelineStage(GetUsage()), 0, 0, nullptr, 1, &barrier,
+                                      0, nullptr);
+
+        mSignalSemaphore = signalSemaphore;
+        return {};
+    }
+
+    MaybeError Buffer::InitializeFromHostPointer(void* hostPointer, uint64_t allocationSize) {
+        Device* device = ToBackend(GetDevice());
+
+        if (!device->GetDeviceInfo().externalMemoryHost) {
+            return DAWN_VALIDATION_ERROR(
+                "Host pointer import requires VK_EXT_external_memory_host");
+        }
+
+        const VkDeviceSize alignment =
+            device->GetDeviceInfo().externalMemoryHostProperties.minImportedHostPointerAlignment;
+        if (reinterpret_cast<uintptr_t>(hostPointer) % alignment != 0 ||
+            allocationSize % alignment != 0 || allocationSize < GetSize()) {
+            return DAWN_VALIDATION_ERROR(
+                "Imported host memory must cover the buffer and be aligned to "
+                "minImportedHostPointerAlignment");
+        }
+
+        DAWN_TRY(
+            CreateHandleForExternalMemory(VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT));
+
+        VkMemoryRequirements requirements;
+        device->fn.GetBufferMemoryRequirements(device->GetVkDevice(), mHandle, &requirements);
+
+        VkMemoryHostPointerPropertiesEXT hostPointerProperties;
+        hostPointerProperties.sType = VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT;
+        hostPointerProperties.pNext = nullptr;
+        DAWN_TRY(CheckVkSuccess(
+            device->fn.GetMemoryHostPointerPropertiesEXT(
+                device->GetVkDevice(), VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT,
+                hostPointer, &hostPointerProperties),
+            "vkGetMemoryHostPointerPropertiesEXT"));
+
+        // The memory type must both support importing the host pointer and satisfy the
+        // buffer's requirements. Imported host memory types are host-visible.
+        requirements.memoryTypeBits &= hostPointerProperties.memoryTypeBits;
+        if (requirements.memoryTypeBits == 0) {
+            return DAWN_VALIDATION_ERROR(
+                "No memory type can import the host pointer for buffer use");
+        }
+        int memoryType = device->FindBestMemoryTypeIndex(requirements, true);
+        if (memoryType < 0) {
+            return DAWN_VALIDATION_ERROR("No compatible memory type for host pointer import");
+        }
+
+        VkImportMemoryHostPointerInfoEXT importInfo;
+        importInfo.sType = VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT;
+        importInfo.pNext = nullptr;
+        importInfo.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+        importInfo.pHostPointer = hostPointer;
+
+        VkMemoryAllocateInfo allocateInfo;
+        allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocateInfo.pNext = &importInfo;
+        allocateInfo.allocationSize = allocationSize;
+        allocateInfo.memoryTypeIndex = static_cast<uint32_t>(memoryType);
+
+        DAWN_TRY(CheckVkSuccess(device->fn.AllocateMemory(device->GetVkDevice(), &allocateInfo,
+                                                          nullptr, &*mExternalAllocation),
+                                "vkAllocateMemory (host pointer import)"));
+
+        DAWN_TRY(CheckVkSuccess(
+            device->fn.BindBufferMemory(device->GetVkDevice(), mHandle, mExternalAllocation, 0),
+            "vkBindBufferMemory (host pointer import)"));
+
+        // The contents are whatever the host wrote there; don't lazily clear them.
+        MarkDataInitialized();
+        return {};
+    }
+
+    MaybeError Buffer::InitializeAsExportableBuffer(
+        external_memory::Service* externalMemoryService,
+        VkSemaphore signalSemaphore,
+        ExternalMemoryHandle* outMemoryHandle,
+        VkDeviceSize* outAllocationSize,
+        uint32_t* outMemoryTypeIndex) {
+        Device* device = ToBackend(GetDevice());
+
+        DAWN_TRY(CreateHandleForExternalMemory(externalMemoryService->GetMemoryHandleType()));
+
+        VkMemoryRequirements requirements;
+        device->fn.GetBufferMemoryRequirements(device->GetVkDevice(), mHandle, &requirements);
+
+        int memoryType = device->FindBestMemoryTypeIndex(requirements, false);
+        ASSERT(memoryType >= 0);
+
+        DAWN_TRY_ASSIGN(mExternalAllocation,
+                        externalMemoryService->AllocateExportableMemory(
+                            requirements.size, static_cast<uint32_t>(memoryType)));
+
+        DAWN_TRY(CheckVkSuccess(
+            device->fn.BindBufferMemory(device->GetVkDevice(), mHandle, mExternalAllocation, 0),
+            "vkBindBufferMemory (external)"));
+
+        DAWN_TRY_ASSIGN(*outMemoryHandle, externalMemoryService->ExportMemory(mExternalAllocation));
+        *outAllocationSize = requirements.size;
+        *outMemoryTypeIndex = static_cast<uint32_t>(memoryType);
+
+        mSignalSemaphore = signalSemaphore;
+        return {};
+    }
+
     MaybeError Buffer::Initialize() {
         // Avoid passing ludicrously large sizes to drivers because it causes issues: drivers add
         // some constants to the size passed and align it, but for values close to the maximum
@@ -137,13 +379,44 @@ namespace dawn_native { namespace vulkan {
             return DAWN_OUT_OF_MEMORY_ERROR("Buffer size is HUGE and could cause overflows");
         }
 
+        Device* device = ToBackend(GetDevice());
+
+        bool requestMappable =
+            (GetUsage() & (wgpu::BufferUsage::MapRead | wgpu::BufferUsage::MapWrite)) != 0;
+        bool requestDeviceAddress = (GetUsage() & wgpu::BufferUsage::RayTracing) != 0;
+
+        if (requestDeviceAddress && !device->IsExtensionEnabled(Extension::RayTracing)) {
+            return DAWN_VALIDATION_ERROR("Ray tracing extension is not enabled");
+        }
+
+        // Small non-mappable buffers are sub-allocated out of a shared slab VkBuffer so
+        // they don't each pay for a vkBindBufferMemory and for padding the allocation up
+        // to the memory requirements' alignment. Mappable buffers need a dedicated
+        // allocation to own the mapped pointer and ray tracing buffers need their device
+        // address to resolve to the start of the VkBuffer.
+        if (!requestMappable && !requestDeviceAddress &&
+            !(GetAllocationHint() & wgpu::MemoryAllocationHint::Dedicated)) {
+            BufferSlabAllocator::BufferSlabAllocation slabAllocation;
+            DAWN_TRY_ASSIGN(slabAllocation,
+                            device->GetBufferSlabAllocator()->Allocate(GetSize()));
+            if (slabAllocation.allocation.GetInfo().mMethod != AllocationMethod::kInvalid) {
+                mHandle = slabAllocation.buffer;
+                mHandleOffset = slabAllocation.offset;
+                mMemoryAllocation = slabAllocation.allocation;
+                mAllocatedFromSlab = true;
+                return {};
+            }
+        }
+
         VkBufferCreateInfo createInfo;
         createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
         createInfo.pNext = nullptr;
         createInfo.flags = 0;
         // TODO(cwallez@chromium.org): Have a global "zero" buffer that can do everything instead
         // of creating a new 4-byte buffer?
-        createInfo.size = std::max(GetSize(), uint64_t(4u));
+        // Rounded up to 4 so the 4-byte aligned vkCmdFillBuffer in InitializeToZero
+        // stays within the buffer.
+        createInfo.size = std::max((GetSize() + 3) & ~uint64_t(3), uint64_t(4u));
         // Add CopyDst for non-mappable buffer initialization in CreateBufferMapped
         // and robust resource initialization.
         createInfo.usage = VulkanBufferUsage(GetUsage() | wgpu::BufferUsage::CopyDst);
@@ -151,7 +424,6 @@ namespace dawn_native { namespace vulkan {
         createInfo.queueFamilyIndexCount = 0;
         createInfo.pQueueFamilyIndices = 0;
 
-        Device* device = ToBackend(GetDevice());
         DAWN_TRY(CheckVkSuccess(
             device->fn.CreateBuffer(device->GetVkDevice(), &createInfo, nullptr, &*mHandle),
             "vkCreateBuffer"));
@@ -159,16 +431,26 @@ namespace dawn_native { namespace vulkan {
         VkMemoryRequirements requirements;
         device->fn.GetBufferMemoryRequirements(device->GetVkDevice(), mHandle, &requirements);
 
-        bool requestMappable =
-            (GetUsage() & (wgpu::BufferUsage::MapRead | wgpu::BufferUsage::MapWrite)) != 0;
-        bool requestDeviceAddress = (GetUsage() & wgpu::BufferUsage::RayTracing) != 0;
-
-        if (requestDeviceAddress && !device->IsExtensionEnabled(Extension::RayTracing)) {
-            return DAWN_VALIDATION_ERROR("Ray tracing extension is not enabled");
+        // Readback through uncached host memory runs at uncached read speeds, so always
+        // prefer host cached memory for buffers that will be read on the CPU.
+        wgpu::MemoryAllocationHint allocationHint = GetAllocationHint();
+        if (GetUsage() & wgpu::BufferUsage::MapRead) {
+            allocationHint |= wgpu::MemoryAllocationHint::HostCached;
         }
 
-        DAWN_TRY_ASSIGN(mMemoryAllocation, device->AllocateMemory(requirements, requestMappable,
-                                                                  requestDeviceAddress));
+        DAWN_TRY_ASSIGN(mMemoryAllocation,
+                        device->AllocateMemory(requirements, requestMappable,
+                                               AllocationClass::Buffer, requestDeviceAddress,
+                                               /*transient*/ false, allocationHint, mHandle));
+
+        if (requestMappable) {
+            // The cached memory picked for readback may be non-coherent; remember that so
+            // map and unmap synchronize the mapped ranges explicitly.
+            size_t memoryType = ToBackend(mMemoryAllocation.GetResourceHeap())->GetMemoryType();
+            mHostMemoryCoherent =
+                (device->GetDeviceInfo().memoryTypes[memoryType].propertyFlags &
+                 VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+        }
 
         DAWN_TRY(CheckVkSuccess(
             device->fn.BindBufferMemory(device->GetVkDevice(), mHandle,
@@ -194,6 +476,9 @@ namespace dawn_native { namespace vulkan {
     }
 
     void Buffer::OnMapReadCommandSerialFinished(uint32_t mapSerial, const void* data) {
+        // GPU writes that landed in non-coherent memory must be made visible to the host
+        // before the application reads through the mapped pointer.
+        InvalidateMappedMemory();
         CallMapReadCallback(mapSerial, WGPUBufferMapAsyncStatus_Success, data, GetSize());
     }
 
@@ -205,6 +490,10 @@ namespace dawn_native { namespace vulkan {
         return mHandle;
     }
 
+    uint64_t Buffer::GetHandleOffset() const {
+        return mHandleOffset;
+    }
+
     uint64_t Buffer::GetDeviceAddress() const {
         return mDeviceAddress;
     }
@@ -215,6 +504,28 @@ namespace dawn_native { namespace vulkan {
 
     void Buffer::TransitionUsageNow(CommandRecordingContext* recordingContext,
                                     wgpu::BufferUsage usage) {
+        BufferBarrierStackVector barriers;
+        VkPipelineStageFlags srcStages = 0;
+        VkPipelineStageFlags dstStages = 0;
+
+        TransitionUsageAndGetResourceBarrier(usage, &barriers.container(), &srcStages, &dstStages);
+
+        if (barriers->empty()) {
+            return;
+        }
+        ASSERT(barriers->size() == 1);
+
+        DAWN_COUNTER_INCREMENT(GetDevice()->GetCounters(), PipelineBarriers);
+        ToBackend(GetDevice())
+            ->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
+                                    nullptr, barriers->size(), barriers->data(), 0, nullptr);
+    }
+
+    void Buffer::TransitionUsageAndGetResourceBarrier(
+        wgpu::BufferUsage usage,
+        BufferBarrierVector* bufferBarriers,
+        VkPipelineStageFlags* srcStages,
+        VkPipelineStageFlags* dstStages) {
         bool lastIncludesTarget = (mLastUsage & usage) == usage;
         bool lastReadOnly = (mLastUsage & kReadOnlyBufferUsages) == mLastUsage;
 
@@ -229,8 +540,8 @@ namespace dawn_native { namespace vulkan {
             return;
         }
 
-        VkPipelineStageFlags srcStages = VulkanPipelineStage(mLastUsage);
-        VkPipelineStageFlags dstStages = VulkanPipelineStage(usage);
+        *srcStages |= VulkanPipelineStage(mLastUsage);
+        *dstStages |= VulkanPipelineStage(usage);
 
         VkBufferMemoryBarrier barrier;
         barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
@@ -240,16 +551,74 @@ namespace dawn_native { namespace vulkan {
         barrier.srcQueueFamilyIndex = 0;
         barrier.dstQueueFamilyIndex = 0;
         barrier.buffer = mHandle;
-        barrier.offset = 0;
+        // Only barrier the buffer's own range: the VkBuffer may be a slab shared with
+        // other buffers.
+        barrier.offset = mHandleOffset;
         barrier.size = GetSize();
 
-        ToBackend(GetDevice())
-            ->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
-                                    nullptr, 1, &barrier, 0, nullptr);
+        bufferBarriers->push_back(barrier);
 
         mLastUsage = usage;
     }
 
+    void Buffer::EnsureDataInitialized(CommandRecordingContext* recordingContext) {
+        if (!GetDevice()->IsToggleEnabled(Toggle::LazyClearResourceOnFirstUse)) {
+            return;
+        }
+        if (IsDataInitialized()) {
+            return;
+        }
+        InitializeToZero(recordingContext);
+    }
+
+    void Buffer::EnsureDataInitializedAsDestination(CommandRecordingContext* recordingContext,
+                                                    uint64_t offset,
+                                                    uint64_t size) {
+        if (!GetDevice()->IsToggleEnabled(Toggle::LazyClearResourceOnFirstUse)) {
+            return;
+        }
+        if (IsDataInitialized()) {
+            return;
+        }
+        // The caller is about to write [offset, offset + size), so extend the watermark
+        // before deciding whether a clear is needed. Streaming buffers overwritten front
+        // to back never reach InitializeToZero this way.
+        MarkRangeInitialized(offset, size);
+        if (!IsDataInitialized()) {
+            InitializeToZero(recordingContext);
+        }
+    }
+
+    void Buffer::InitializeToZero(CommandRecordingContext* recordingContext) {
+        ASSERT(!IsDataInitialized());
+        Device* device = ToBackend(GetDevice());
+
+        TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
+
+        // Only clear past the initialized watermark: the bytes below it hold data that
+        // must be preserved. vkCmdFillBuffer requires 4-byte aligned offset and size; the
+        // watermark only moves by the 4-byte multiples the write paths validate, and
+        // allocations are at least 4-byte aligned so rounding the end up stays inside
+        // the allocation.
+        uint64_t clearStart = (GetInitializedSize() + 3) & ~uint64_t(3);
+        uint64_t clearEnd = (GetSize() + 3) & ~uint64_t(3);
+        if (clearStart < clearEnd) {
+            device->fn.CmdFillBuffer(recordingContext->commandBuffer, mHandle,
+                                     mHandleOffset + clearStart, clearEnd - clearStart, 0u);
+        }
+
+        device->IncrementLazyClearCountForTesting();
+        MarkDataInitialized();
+    }
+
+    wgpu::BufferUsage Buffer::GetLastUsage() const {
+        return mLastUsage;
+    }
+
+    void Buffer::SetLastUsage(wgpu::BufferUsage usage) {
+        mLastUsage = usage;
+    }
+
     bool Buffer::IsMapWritable() const {
         // TODO(enga): Handle CPU-visible memory on UMA
         return mMemoryAllocation.GetMappedPointer() != nullptr;
@@ -264,6 +633,9 @@ namespace dawn_native { namespace vulkan {
         Device* device = ToBackend(GetDevice());
 
         CommandRecordingContext* recordingContext = device->GetPendingRecordingContext();
+        // The mapped pointer exposes the buffer's memory, so bytes that were never
+        // written must be zeroed before the map request completes.
+        EnsureDataInitialized(recordingContext);
         TransitionUsageNow(recordingContext, wgpu::BufferUsage::MapRead);
         return {};
     }
@@ -276,8 +648,62 @@ namespace dawn_native { namespace vulkan {
         return {};
     }
 
+    MaybeError Buffer::FreezeUsageImpl(wgpu::BufferUsage usage) {
+        // Transition to the frozen usage once; the frontend stops tracking the buffer per
+        // pass afterwards so no further barriers will be recorded for it.
+        Device* device = ToBackend(GetDevice());
+
+        CommandRecordingContext* recordingContext = device->GetPendingRecordingContext();
+        // Frozen buffers also skip the per-pass clears, so settle the initialization
+        // state while we still record barriers for the buffer.
+        EnsureDataInitialized(recordingContext);
+        TransitionUsageNow(recordingContext, usage);
+        return {};
+    }
+
     void Buffer::UnmapImpl() {
-        // No need to do anything, we keep CPU-visible memory mapped at all time.
+        // We keep CPU-visible memory mapped at all time, but writes the application made
+        // through the mapped pointer of non-coherent memory must be flushed before the
+        // GPU can see them.
+        FlushMappedMemory();
+    }
+
+    void Buffer::FlushMappedMemory() {
+        if (mHostMemoryCoherent) {
+            return;
+        }
+        Device* device = ToBackend(GetDevice());
+
+        VkMappedMemoryRange range;
+        range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range.pNext = nullptr;
+        range.memory = ToBackend(mMemoryAllocation.GetResourceHeap())->GetMemory();
+        // Mappable buffers own their allocation, so the whole memory is the buffer; this
+        // also satisfies the nonCoherentAtomSize alignment rules.
+        range.offset = 0;
+        range.size = VK_WHOLE_SIZE;
+
+        device->ConsumedError(
+            CheckVkSuccess(device->fn.FlushMappedMemoryRanges(device->GetVkDevice(), 1, &range),
+                           "vkFlushMappedMemoryRanges"));
+    }
+
+    void Buffer::InvalidateMappedMemory() {
+        if (mHostMemoryCoherent) {
+            return;
+        }
+        Device* device = ToBackend(GetDevice());
+
+        VkMappedMemoryRange range;
+        range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range.pNext = nullptr;
+        range.memory = ToBackend(mMemoryAllocation.GetResourceHeap())->GetMemory();
+        range.offset = 0;
+        range.size = VK_WHOLE_SIZE;
+
+        device->ConsumedError(CheckVkSuccess(
+            device->fn.InvalidateMappedMemoryRanges(device->GetVkDevice(), 1, &range),
+            "vkInvalidateMappedMemoryRanges"));
     }
 
     void* Buffer::GetMappedPointerImpl() {
@@ -286,13 +712,73 @@ namespace dawn_native { namespace vulkan {
         return memory;
     }
 
+    MaybeError Buffer::SignalAndDestroy(VkSemaphore* outSignalSemaphore) {
+        Device* device = ToBackend(GetDevice());
+
+        if (mExternalAllocation == VK_NULL_HANDLE) {
+            return DAWN_VALIDATION_ERROR(
+                "Can't export signal semaphore from destroyed / non-external buffer");
+        }
+
+        ASSERT(mSignalSemaphore != VK_NULL_HANDLE);
+
+        // Release the buffer to the external queue family so its contents are well defined
+        // for the importing device, and signal we are done with it.
+        CommandRecordingContext* recordingContext = device->GetPendingRecordingContext();
+
+        VkBufferMemoryBarrier barrier;
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.pNext = nullptr;
+        barrier.srcAccessMask = VulkanAccessFlags(mLastUsage);
+        barrier.dstAccessMask = 0;
+        barrier.srcQueueFamilyIndex = device->GetGraphicsQueueFamily();
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_EXTERNAL_KHR;
+        barrier.buffer = mHandle;
+        barrier.offset = 0;
+        barrier.size = VK_WHOLE_SIZE;
+
+        // An unused buffer has no stages to wait for; Vulkan doesn't allow a stage mask of 0.
+        VkPipelineStageFlags srcStages = mLastUsage == wgpu::BufferUsage::None
+                                             ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT
+                                             : VulkanPipelineStage(mLastUsage);
+        device->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages,
+                                      VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1,
+                                      &barrier, 0, nullptr);
+
+        recordingContext->signalSemaphores.push_back(mSignalSemaphore);
+        DAWN_TRY(device->SubmitPendingCommands());
+
+        // Write out the signal semaphore
+        *outSignalSemaphore = mSignalSemaphore;
+        mSignalSemaphore = VK_NULL_HANDLE;
+
+        // Destroy the buffer so it can't be used again
+        DestroyInternal();
+        return {};
+    }
+
     void Buffer::DestroyImpl() {
+        if (mAllocatedFromSlab) {
+            // The slab VkBuffer is owned by the allocator and shared with other buffers,
+            // only the sub-allocated range is returned.
+            ToBackend(GetDevice())->GetBufferSlabAllocator()->Deallocate(&mMemoryAllocation);
+            mHandle = VK_NULL_HANDLE;
+            return;
+        }
+
         ToBackend(GetDevice())->DeallocateMemory(&mMemoryAllocation);
 
         if (mHandle != VK_NULL_HANDLE) {
             ToBackend(GetDevice())->GetFencedDeleter()->DeleteWhenUnused(mHandle);
             mHandle = VK_NULL_HANDLE;
         }
+
+        if (mExternalAllocation != VK_NULL_HANDLE) {
+            ToBackend(GetDevice())->GetFencedDeleter()->DeleteWhenUnused(mExternalAllocation);
+            mExternalAllocation = VK_NULL_HANDLE;
+        }
+        // If a signal semaphore exists it should be requested before we delete the buffer
+        ASSERT(mSignalSemaphore == VK_NULL_HANDLE);
     }
 
 }}  // namespace dawn_native::vulkan
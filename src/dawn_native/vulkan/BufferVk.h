@@ -18,22 +18,74 @@
 #include "dawn_native/Buffer.h"
 
 #include "common/SerialQueue.h"
+#include "common/StackContainer.h"
 #include "common/vulkan_platform.h"
 #include "dawn_native/ResourceMemoryAllocation.h"
+#include "dawn_native/vulkan/ExternalHandle.h"
+#include "dawn_native/vulkan/external_memory/MemoryService.h"
+
+#include <vector>
 
 namespace dawn_native { namespace vulkan {
 
     struct CommandRecordingContext;
     class Device;
 
+    // Barrier batches are built per pass, so give them inline storage to avoid a heap
+    // allocation for the common case of a pass that only transitions a few buffers.
+    static constexpr size_t kInlineBufferBarrierCapacity = 16;
+    using BufferBarrierStackVector =
+        StackVector<VkBufferMemoryBarrier, kInlineBufferBarrierCapacity>;
+    using BufferBarrierVector = BufferBarrierStackVector::ContainerType;
+
     class Buffer final : public BufferBase {
       public:
         static ResultOrError<Buffer*> Create(Device* device, const BufferDescriptor* descriptor);
 
+        // Creates a buffer bound to externally allocated memory shared by another device. On
+        // success the buffer takes ownership of `signalSemaphore` and the semaphores in
+        // `waitSemaphores` are handed to the pending submit, which waits on them and acquires
+        // the memory before any use of the buffer; the caller keeps ownership of all the
+        // semaphores when this errors.
+        static ResultOrError<Buffer*> CreateFromExternalMemory(
+            Device* device,
+            const BufferDescriptor* descriptor,
+            external_memory::Service* externalMemoryService,
+            ExternalMemoryHandle memoryHandle,
+            VkDeviceSize allocationSize,
+            uint32_t memoryTypeIndex,
+            const std::vector<VkSemaphore>& waitSemaphores,
+            VkSemaphore signalSemaphore);
+
+        // Creates a buffer aliasing host memory imported with VK_EXT_external_memory_host,
+        // so GPU copies can read directly from memory the CPU already owns (for example a
+        // shared memory region filled by another process) without an intermediate staging
+        // copy. `hostPointer` and `allocationSize` must be aligned to the device's
+        // minImportedHostPointerAlignment and the memory must outlive the buffer.
+        static ResultOrError<Buffer*> CreateFromHostPointer(Device* device,
+                                                            const BufferDescriptor* descriptor,
+                                                            void* hostPointer,
+                                                            uint64_t allocationSize);
+
+        // Creates a buffer backed by memory allocated for export so that another device can
+        // import it; see Texture::CreateExportable.
+        static ResultOrError<Buffer*> CreateExportable(
+            Device* device,
+            const BufferDescriptor* descriptor,
+            external_memory::Service* externalMemoryService,
+            VkSemaphore signalSemaphore,
+            ExternalMemoryHandle* outMemoryHandle,
+            VkDeviceSize* outAllocationSize,
+            uint32_t* outMemoryTypeIndex);
+
         void OnMapReadCommandSerialFinished(uint32_t mapSerial, const void* data);
         void OnMapWriteCommandSerialFinished(uint32_t mapSerial, void* data);
 
         VkBuffer GetHandle() const;
+        // Offset of the buffer's data inside its VkBuffer. Non-zero when the buffer is
+        // sub-allocated out of a shared slab VkBuffer, in which case every Vulkan
+        // command referencing the buffer must add it to the buffer-relative offset.
+        uint64_t GetHandleOffset() const;
         uint64_t GetDeviceAddress() const;
         ResourceMemoryAllocation GetMemoryResource() const;
 
@@ -41,15 +93,56 @@ namespace dawn_native { namespace vulkan {
         // `commands`.
         // TODO(cwallez@chromium.org): coalesce barriers and do them early when possible.
         void TransitionUsageNow(CommandRecordingContext* recordingContext, wgpu::BufferUsage usage);
+        // Collects the barrier needed to transition to `usage` into `bufferBarriers` and merges
+        // the required pipeline stages into `srcStages`/`dstStages`, so all the transitions of a
+        // pass can be batched into a single barrier call.
+        void TransitionUsageAndGetResourceBarrier(wgpu::BufferUsage usage,
+                                                  BufferBarrierVector* bufferBarriers,
+                                                  VkPipelineStageFlags* srcStages,
+                                                  VkPipelineStageFlags* dstStages);
+
+        // Lazily zero the bytes the application never wrote before the buffer is read.
+        // Only the bytes past the frontend's initialized watermark are filled, so
+        // buffers that are fully overwritten before their first read cost nothing.
+        void EnsureDataInitialized(CommandRecordingContext* recordingContext);
+        // Same, for a use that is about to write [offset, offset + size): the written
+        // range counts as initialized so streaming copies never trigger the clear.
+        void EnsureDataInitializedAsDestination(CommandRecordingContext* recordingContext,
+                                                uint64_t offset,
+                                                uint64_t size);
+
+        // The usage the buffer was last transitioned to. Used with SetLastUsage when
+        // replaying a reusable command buffer: the replayed recording already contains
+        // the barriers so only the tracker needs updating.
+        wgpu::BufferUsage GetLastUsage() const;
+        void SetLastUsage(wgpu::BufferUsage usage);
+
+        // Submits a signal of the buffer's export semaphore and destroys the buffer; the
+        // returned semaphore hands the memory over to the importing device.
+        MaybeError SignalAndDestroy(VkSemaphore* outSignalSemaphore);
 
       private:
         ~Buffer() override;
         using BufferBase::BufferBase;
         MaybeError Initialize();
+        MaybeError InitializeFromExternalMemory(external_memory::Service* externalMemoryService,
+                                                ExternalMemoryHandle memoryHandle,
+                                                VkDeviceSize allocationSize,
+                                                uint32_t memoryTypeIndex,
+                                                const std::vector<VkSemaphore>& waitSemaphores,
+                                                VkSemaphore signalSemaphore);
+        MaybeError InitializeFromHostPointer(void* hostPointer, uint64_t allocationSize);
+        MaybeError InitializeAsExportableBuffer(external_memory::Service* externalMemoryService,
+                                                VkSemaphore signalSemaphore,
+                                                ExternalMemoryHandle* outMemoryHandle,
+                                                VkDeviceSize* outAllocationSize,
+                                                uint32_t* outMemoryTypeIndex);
+        MaybeError CreateHandleForExternalMemory(VkExternalMemoryHandleTypeFlagBits handleType);
 
         // Dawn API
         MaybeError MapReadAsyncImpl(uint32_t serial) override;
         MaybeError MapWriteAsyncImpl(uint32_t serial) override;
+        MaybeError FreezeUsageImpl(wgpu::BufferUsage usage) override;
         void UnmapImpl() override;
         void DestroyImpl() override;
 
@@ -57,9 +150,27 @@ namespace dawn_native { namespace vulkan {
         MaybeError MapAtCreationImpl(uint8_t** mappedPointer) override;
         void* GetMappedPointerImpl() override;
 
+        void InitializeToZero(CommandRecordingContext* recordingContext);
+
+        // Synchronize the mapped pointer with the GPU when the buffer's memory is
+        // non-coherent (host cached memory picked for readback may be). No-ops on
+        // coherent memory.
+        void FlushMappedMemory();
+        void InvalidateMappedMemory();
+
         VkBuffer mHandle = VK_NULL_HANDLE;
+        uint64_t mHandleOffset = 0;
         uint64_t mDeviceAddress = 0;
         ResourceMemoryAllocation mMemoryAllocation;
+        VkDeviceMemory mExternalAllocation = VK_NULL_HANDLE;
+        VkSemaphore mSignalSemaphore = VK_NULL_HANDLE;
+        // True when mHandle is a shared slab VkBuffer owned by the BufferSlabAllocator
+        // instead of a dedicated buffer owned by this object.
+        bool mAllocatedFromSlab = false;
+
+        // False when the buffer's memory type isn't HOST_COHERENT, in which case maps
+        // invalidate and unmaps flush the mapped range explicitly.
+        bool mHostMemoryCoherent = true;
 
         wgpu::BufferUsage mLastUsage = wgpu::BufferUsage::None;
     };
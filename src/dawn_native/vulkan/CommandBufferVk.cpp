@@ -14,9 +14,11 @@
 
 #include "dawn_native/vulkan/CommandBufferVk.h"
 
+#include "common/Counters.h"
 #include "dawn_native/BindGroupAndStorageBarrierTracker.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/Commands.h"
+#include "dawn_native/RayTracingBundle.h"
 #include "dawn_native/RenderBundle.h"
 #include "dawn_native/vulkan/BindGroupVk.h"
 #include "dawn_native/vulkan/BufferVk.h"
@@ -25,16 +27,21 @@
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/PipelineLayoutVk.h"
+#include "dawn_native/vulkan/QuerySetVk.h"
 #include "dawn_native/vulkan/RayTracingAccelerationContainerVk.h"
 #include "dawn_native/vulkan/RayTracingPipelineVk.h"
 #include "dawn_native/vulkan/RayTracingShaderBindingTableVk.h"
 #include "dawn_native/vulkan/RenderPassCache.h"
 #include "dawn_native/vulkan/RenderPipelineVk.h"
 #include "dawn_native/vulkan/ResourceHeapVk.h"
+#include "dawn_native/vulkan/ScratchBufferPool.h"
 #include "dawn_native/vulkan/TextureVk.h"
 #include "dawn_native/vulkan/UtilsVulkan.h"
 #include "dawn_native/vulkan/VulkanError.h"
 
+#include <algorithm>
+#include <set>
+
 namespace dawn_native { namespace vulkan {
 
     namespace {
@@ -104,14 +111,18 @@ namespace dawn_native { namespace vulkan {
                                  const std::array<uint32_t, kMaxBindGroups>& dynamicOffsetCounts,
                                  const std::array<std::array<uint32_t, kMaxBindingsPerGroup>,
                                                   kMaxBindGroups>& dynamicOffsets) {
+            // Load the entry point out of the dispatch table once for all the dirty sets;
+            // the table is reachable through Device::GetMutableFunctions so the compiler
+            // has to assume it may change between iterations and would reload it otherwise.
+            const PFN_vkCmdBindDescriptorSets CmdBindDescriptorSets =
+                device->fn.CmdBindDescriptorSets;
             for (uint32_t dirtyIndex : IterateBitSet(bindGroupsToApply)) {
                 VkDescriptorSet set = ToBackend(bindGroups[dirtyIndex])->GetHandle();
                 const uint32_t* dynamicOffset = dynamicOffsetCounts[dirtyIndex] > 0
                                                     ? dynamicOffsets[dirtyIndex].data()
                                                     : nullptr;
-                device->fn.CmdBindDescriptorSets(commands, bindPoint, pipelineLayout, dirtyIndex, 1,
-                                                 &*set, dynamicOffsetCounts[dirtyIndex],
-                                                 dynamicOffset);
+                CmdBindDescriptorSets(commands, bindPoint, pipelineLayout, dirtyIndex, 1, &*set,
+                                      dynamicOffsetCounts[dirtyIndex], dynamicOffset);
             }
         }
 
@@ -184,9 +195,45 @@ namespace dawn_native { namespace vulkan {
             }
         };
 
+        // Buffers SetImmediateData on the CPU and pushes the dirty range right before the next
+        // draw/dispatch/trace, once a pipeline layout to push against is bound. Every pipeline
+        // layout declares the exact same push constant range so pushed data stays valid across
+        // pipeline and layout changes.
+        class ImmediateDataTracker {
+          public:
+            void OnSetPipeline(PipelineLayout* pipelineLayout) {
+                mPipelineLayout = pipelineLayout;
+            }
+
+            void OnSetImmediateData(uint32_t offset, uint32_t size, const uint8_t* data) {
+                memcpy(&mData[offset], data, size);
+                mDirtyBegin = std::min(mDirtyBegin, offset);
+                mDirtyEnd = std::max(mDirtyEnd, offset + size);
+            }
+
+            void Apply(Device* device, VkCommandBuffer commands) {
+                if (mDirtyBegin >= mDirtyEnd) {
+                    return;
+                }
+                ASSERT(mPipelineLayout != nullptr);
+                device->fn.CmdPushConstants(commands, mPipelineLayout->GetHandle(),
+                                            VK_SHADER_STAGE_ALL, mDirtyBegin,
+                                            mDirtyEnd - mDirtyBegin, &mData[mDirtyBegin]);
+                mDirtyBegin = kMaxImmediateDataBytes;
+                mDirtyEnd = 0;
+            }
+
+          private:
+            PipelineLayout* mPipelineLayout = nullptr;
+            std::array<uint8_t, kMaxImmediateDataBytes> mData = {};
+            uint32_t mDirtyBegin = kMaxImmediateDataBytes;
+            uint32_t mDirtyEnd = 0;
+        };
+
         MaybeError RecordBeginRenderPass(CommandRecordingContext* recordingContext,
                                          Device* device,
-                                         BeginRenderPassCmd* renderPass) {
+                                         BeginRenderPassCmd* renderPass,
+                                         std::vector<VkFramebuffer>* keepAliveFramebuffers) {
             VkCommandBuffer commands = recordingContext->commandBuffer;
 
             // Query a VkRenderPass from the cache
@@ -282,9 +329,15 @@ namespace dawn_native { namespace vulkan {
                                                                 nullptr, &*framebuffer),
                                    "CreateFramebuffer"));
 
-                // We don't reuse VkFramebuffers so mark the framebuffer for deletion as soon as the
-                // commands currently being recorded are finished.
-                device->GetFencedDeleter()->DeleteWhenUnused(framebuffer);
+                if (keepAliveFramebuffers != nullptr) {
+                    // A reusable command buffer replays the render pass, so the framebuffer
+                    // must stay alive as long as the cached recording.
+                    keepAliveFramebuffers->push_back(framebuffer);
+                } else {
+                    // We don't reuse VkFramebuffers so mark the framebuffer for deletion as soon
+                    // as the commands currently being recorded are finished.
+                    device->GetFencedDeleter()->DeleteWhenUnused(framebuffer);
+                }
             }
 
             VkRenderPassBeginInfo beginInfo;
@@ -317,6 +370,19 @@ namespace dawn_native { namespace vulkan {
 
     CommandBuffer::~CommandBuffer() {
         FreeCommands(&mCommands);
+
+        // Objects kept alive for the cached recording of a reusable command buffer can
+        // only go away once the last replay finished executing.
+        FencedDeleter* deleter = ToBackend(GetDevice())->GetFencedDeleter();
+        for (VkFramebuffer framebuffer : mCachedFramebuffers) {
+            deleter->DeleteWhenUnused(framebuffer);
+        }
+        for (VkQueryPool queryPool : mCachedQueryPools) {
+            deleter->DeleteWhenUnused(queryPool);
+        }
+        if (mCachedCommandPool != VK_NULL_HANDLE) {
+            deleter->DeleteWhenUnused(mCachedCommandPool);
+        }
     }
 
     void CommandBuffer::RecordCopyImageWithTemporaryBuffer(
@@ -354,6 +420,7 @@ namespace dawn_native { namespace vulkan {
         tempBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
         VkBufferImageCopy srcToTempBufferRegion =
             ComputeBufferImageCopyRegion(tempBufferCopy, srcCopy, copySize);
+        srcToTempBufferRegion.bufferOffset += tempBuffer->GetHandleOffset();
 
         // The Dawn CopySrc usage is always mapped to GENERAL
         device->fn.CmdCopyImageToBuffer(commands, srcImage, VK_IMAGE_LAYOUT_GENERAL,
@@ -362,6 +429,7 @@ namespace dawn_native { namespace vulkan {
         tempBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
         VkBufferImageCopy tempBufferToDstRegion =
             ComputeBufferImageCopyRegion(tempBufferCopy, dstCopy, copySize);
+        tempBufferToDstRegion.bufferOffset += tempBuffer->GetHandleOffset();
 
         // Dawn guarantees dstImage be in the TRANSFER_DST_OPTIMAL layout after the
         // copy command.
@@ -372,16 +440,239 @@ namespace dawn_native { namespace vulkan {
         recordingContext->tempBuffers.emplace_back(tempBuffer);
     }
 
+    bool CommandBuffer::OnlyContainsAccelerationContainerBuilds() {
+        bool onlyBuilds = true;
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            switch (type) {
+                case Command::BuildRayTracingAccelerationContainer:
+                case Command::BuildRayTracingAccelerationContainers:
+                case Command::UpdateRayTracingAccelerationContainer:
+                    break;
+                default:
+                    onlyBuilds = false;
+                    break;
+            }
+            SkipCommand(&mCommands, type);
+        }
+        mCommands.Reset();
+        return onlyBuilds;
+    }
+
     MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingContext) {
+        if (!IsReusable()) {
+            return RecordCommandsImpl(recordingContext);
+        }
+
+        Device* device = ToBackend(GetDevice());
+
+        bool isRecordingSubmit = false;
+        if (mCachedCommands == VK_NULL_HANDLE) {
+            // Keep lazy clears out of the cached recording: a clear baked into it would run
+            // again on every replay and overwrite the resource's contents. Until every
+            // referenced texture has been initialized the commands are re-encoded as usual.
+            bool texturesInitialized = true;
+            for (const PassResourceUsage& usages : GetResourceUsages().perPass) {
+                for (TextureBase* texture : usages.textures) {
+                    texturesInitialized &= texture->IsSubresourceContentInitialized(
+                        0, texture->GetNumMipLevels(), 0, texture->GetArrayLayers());
+                }
+            }
+            for (TextureBase* texture : GetResourceUsages().topLevelTextures) {
+                texturesInitialized &= texture->IsSubresourceContentInitialized(
+                    0, texture->GetNumMipLevels(), 0, texture->GetArrayLayers());
+            }
+            if (!texturesInitialized) {
+                return RecordCommandsImpl(recordingContext);
+            }
+
+            DAWN_TRY(RecordCachedCommands(recordingContext));
+            isRecordingSubmit = true;
+        }
+
+        // Recreate the entry states the cached recording assumed. This must not run on the
+        // submit that performed the recording: at that point the trackers already hold the
+        // pass's exit states while the images are still in their pre-pass layouts (the
+        // secondary's baked barriers execute later), so the oldLayouts would be wrong.
+        if (!isRecordingSubmit) {
+            BufferBarrierStackVector bufferBarriers;
+            ImageBarrierStackVector imageBarriers;
+            VkPipelineStageFlags srcStages = 0;
+            VkPipelineStageFlags dstStages = 0;
+
+            for (auto& entry : mBufferEntryUsages) {
+                if (entry.second == wgpu::BufferUsage::None) {
+                    continue;
+                }
+                entry.first->TransitionUsageAndGetResourceBarrier(
+                    entry.second, &bufferBarriers.container(), &srcStages, &dstStages);
+            }
+            for (auto& entry : mTextureEntryUsages) {
+                entry.first->TransitionUsageForPass(recordingContext, entry.second,
+                                                    &imageBarriers.container(), &srcStages,
+                                                    &dstStages);
+            }
+
+            if (bufferBarriers->size() || imageBarriers->size()) {
+                DAWN_COUNTER_INCREMENT(device->GetCounters(), PipelineBarriers);
+                device->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages,
+                                              dstStages, 0, 0, nullptr, bufferBarriers->size(),
+                                              bufferBarriers->data(), imageBarriers->size(),
+                                              imageBarriers->data());
+            }
+        }
+
+        device->fn.CmdExecuteCommands(recordingContext->commandBuffer, 1, &mCachedCommands);
+
+        // The barriers baked into the cached recording left the resources in the exit
+        // states, so only the trackers need updating.
+        for (auto& exit : mBufferExitUsages) {
+            exit.first->SetLastUsage(exit.second);
+        }
+        for (auto& exit : mTextureExitUsages) {
+            exit.first->SetLastSubresourceUsages(exit.second);
+        }
+
+        return {};
+    }
+
+    MaybeError CommandBuffer::RecordCachedCommands(CommandRecordingContext* recordingContext) {
+        Device* device = ToBackend(GetDevice());
+
+        // Gather the set of referenced resources and snapshot their entry states.
+        std::set<Buffer*> buffers;
+        std::set<Texture*> textures;
+        const CommandBufferResourceUsage& resourceUsages = GetResourceUsages();
+        for (const PassResourceUsage& usages : resourceUsages.perPass) {
+            for (BufferBase* buffer : usages.buffers) {
+                buffers.insert(ToBackend(buffer));
+            }
+            for (TextureBase* texture : usages.textures) {
+                textures.insert(ToBackend(texture));
+            }
+        }
+        for (BufferBase* buffer : resourceUsages.topLevelBuffers) {
+            buffers.insert(ToBackend(buffer));
+        }
+        for (TextureBase* texture : resourceUsages.topLevelTextures) {
+            textures.insert(ToBackend(texture));
+        }
+
+        for (Buffer* buffer : buffers) {
+            mBufferEntryUsages.emplace_back(buffer, buffer->GetLastUsage());
+        }
+        for (Texture* texture : textures) {
+            mTextureEntryUsages.emplace_back(texture, texture->GetLastSubresourceUsages());
+        }
+
+        // The cached commands live in a secondary command buffer recorded with the
+        // SIMULTANEOUS_USE flag, so a replay may be submitted while the previous one is
+        // still in flight. The pool isn't transient: the recording is meant to be
+        // executed many times.
+        VkCommandPoolCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.queueFamilyIndex = device->GetGraphicsQueueFamily();
+        DAWN_TRY(CheckVkSuccess(device->fn.CreateCommandPool(device->GetVkDevice(), &createInfo,
+                                                             nullptr, &*mCachedCommandPool),
+                                "vkCreateCommandPool"));
+
+        VkCommandBufferAllocateInfo allocateInfo;
+        allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.pNext = nullptr;
+        allocateInfo.commandPool = mCachedCommandPool;
+        allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocateInfo.commandBufferCount = 1;
+        DAWN_TRY(CheckVkSuccess(device->fn.AllocateCommandBuffers(
+                                    device->GetVkDevice(), &allocateInfo, &mCachedCommands),
+                                "vkAllocateCommandBuffers"));
+
+        // The inheritance info is required for secondary command buffers but all of it is
+        // ignored because the replay happens outside of a render pass instance.
+        VkCommandBufferInheritanceInfo inheritanceInfo;
+        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.pNext = nullptr;
+        inheritanceInfo.renderPass = VK_NULL_HANDLE;
+        inheritanceInfo.subpass = 0;
+        inheritanceInfo.framebuffer = VK_NULL_HANDLE;
+        inheritanceInfo.occlusionQueryEnable = VK_FALSE;
+        inheritanceInfo.queryFlags = 0;
+        inheritanceInfo.pipelineStatistics = 0;
+
+        VkCommandBufferBeginInfo beginInfo;
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext = nullptr;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+        beginInfo.pInheritanceInfo = &inheritanceInfo;
+        DAWN_TRY(CheckVkSuccess(device->fn.BeginCommandBuffer(mCachedCommands, &beginInfo),
+                                "vkBeginCommandBuffer"));
+
+        CommandRecordingContext cachedContext;
+        cachedContext.commandBuffer = mCachedCommands;
+        DAWN_TRY(RecordCommandsImpl(&cachedContext));
+
+        DAWN_TRY(CheckVkSuccess(device->fn.EndCommandBuffer(mCachedCommands),
+                                "vkEndCommandBuffer"));
+
+        // Semaphores gathered while recording (for example by external textures) belong
+        // to the submit being built, while the temporary buffers of compressed-format
+        // copies are referenced by every replay and live with the cached recording.
+        recordingContext->waitSemaphores.insert(recordingContext->waitSemaphores.end(),
+                                                cachedContext.waitSemaphores.begin(),
+                                                cachedContext.waitSemaphores.end());
+        recordingContext->signalSemaphores.insert(recordingContext->signalSemaphores.end(),
+                                                  cachedContext.signalSemaphores.begin(),
+                                                  cachedContext.signalSemaphores.end());
+        mCachedTempBuffers = std::move(cachedContext.tempBuffers);
+
+        // Snapshot the exit states. Entries whose entry state was still None saw their
+        // first use inside the recording; replays restore those to the exit state instead
+        // so writes from previous submits are synchronized before the cached recording
+        // runs (its own barriers assume there was no previous use).
+        for (auto& entry : mBufferEntryUsages) {
+            wgpu::BufferUsage exitUsage = entry.first->GetLastUsage();
+            mBufferExitUsages.emplace_back(entry.first, exitUsage);
+            if (entry.second == wgpu::BufferUsage::None) {
+                entry.second = exitUsage;
+            }
+        }
+        for (auto& entry : mTextureEntryUsages) {
+            const std::vector<wgpu::TextureUsage>& exitUsages =
+                entry.first->GetLastSubresourceUsages();
+            mTextureExitUsages.emplace_back(entry.first, exitUsages);
+            for (size_t i = 0; i < entry.second.size(); ++i) {
+                if (entry.second[i] == wgpu::TextureUsage::None) {
+                    entry.second[i] = exitUsages[i];
+                }
+            }
+        }
+
+        return {};
+    }
+
+    MaybeError CommandBuffer::RecordCommandsImpl(CommandRecordingContext* recordingContext) {
         Device* device = ToBackend(GetDevice());
         VkCommandBuffer commands = recordingContext->commandBuffer;
 
-        // Records the necessary barriers for the resource usage pre-computed by the frontend
-        auto TransitionForPass = [](CommandRecordingContext* recordingContext,
-                                    const PassResourceUsage& usages) {
+        // Records the necessary barriers for the resource usage pre-computed by the frontend.
+        // All the transitions of a pass are collected and emitted as a single barrier call
+        // instead of one per resource.
+        auto TransitionForPass = [device](CommandRecordingContext* recordingContext,
+                                          const PassResourceUsage& usages) {
+            BufferBarrierStackVector bufferBarriers;
+            ImageBarrierStackVector imageBarriers;
+            VkPipelineStageFlags srcStages = 0;
+            VkPipelineStageFlags dstStages = 0;
+
             for (size_t i = 0; i < usages.buffers.size(); ++i) {
                 Buffer* buffer = ToBackend(usages.buffers[i]);
-                buffer->TransitionUsageNow(recordingContext, usages.bufferUsages[i]);
+                // Clear buffers that still have never-written bytes; like for textures
+                // this is a no-op once the buffer is fully initialized.
+                buffer->EnsureDataInitialized(recordingContext);
+                buffer->TransitionUsageAndGetResourceBarrier(usages.bufferUsages[i],
+                                                             &bufferBarriers.container(),
+                                                             &srcStages, &dstStages);
             }
             for (size_t i = 0; i < usages.textures.size(); ++i) {
                 Texture* texture = ToBackend(usages.textures[i]);
@@ -394,7 +685,17 @@ namespace dawn_native { namespace vulkan {
                                                                  texture->GetArrayLayers());
                 }
                 texture->TransitionUsageForPass(recordingContext,
-                                                usages.textureUsages[i].subresourceUsages);
+                                                usages.textureUsages[i].subresourceUsages,
+                                                &imageBarriers.container(), &srcStages,
+                                                &dstStages);
+            }
+
+            if (bufferBarriers->size() || imageBarriers->size()) {
+                DAWN_COUNTER_INCREMENT(device->GetCounters(), PipelineBarriers);
+                device->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages,
+                                              dstStages, 0, 0, nullptr, bufferBarriers->size(),
+                                              bufferBarriers->data(), imageBarriers->size(),
+                                              imageBarriers->data());
             }
         };
         const std::vector<PassResourceUsage>& passResourceUsages = GetResourceUsages().perPass;
@@ -411,6 +712,15 @@ namespace dawn_native { namespace vulkan {
                         mCommands.NextCommand<BuildRayTracingAccelerationContainerCmd>();
                     RayTracingAccelerationContainer* container = ToBackend(build->container.Get());
 
+                    container->FlushInstanceUpdates();
+
+                    // application-owned instance buffers may have just been written by a
+                    // compute pass, so make the writes visible to the build
+                    if (container->GetExternalInstanceBuffer() != nullptr) {
+                        ToBackend(container->GetExternalInstanceBuffer())
+                            ->TransitionUsageNow(recordingContext, wgpu::BufferUsage::RayTracing);
+                    }
+
                     std::vector<VkAccelerationStructureGeometryKHR>& geometries =
                         container->GetGeometries();
                     const VkAccelerationStructureGeometryKHR* ppGeometries = geometries.data();
@@ -426,8 +736,11 @@ namespace dawn_native { namespace vulkan {
                     asInfo.geometryArrayOfPointers = VK_FALSE;
                     asInfo.geometryCount = geometries.size();
                     asInfo.ppGeometries = &ppGeometries;
-                    asInfo.scratchData.deviceAddress =
-                        container->GetScratchMemory().build.deviceAddress;
+
+                    ScratchBufferPool::ScratchBuffer* buildScratch;
+                    DAWN_TRY_ASSIGN(buildScratch, device->GetScratchBufferPool()->Acquire(
+                                                      container->GetBuildScratchSize()));
+                    asInfo.scratchData.deviceAddress = buildScratch->deviceAddress;
 
                     std::vector<VkAccelerationStructureBuildOffsetInfoKHR>& buildOffsets =
                         container->GetBuildOffsets();
@@ -454,6 +767,277 @@ namespace dawn_native { namespace vulkan {
                     break;
                 }
 
+                case Command::BuildRayTracingAccelerationContainers: {
+                    BuildRayTracingAccelerationContainersCmd* build =
+                        mCommands.NextCommand<BuildRayTracingAccelerationContainersCmd>();
+                    auto containers =
+                        mCommands.NextData<Ref<RayTracingAccelerationContainerBase>>(build->count);
+
+                    // Record all builds back-to-back and only insert a single trailing
+                    // barrier, instead of serializing the GPU with one barrier per build.
+                    std::vector<VkAccelerationStructureBuildGeometryInfoKHR> asInfos(build->count);
+                    std::vector<const VkAccelerationStructureGeometryKHR*> ppGeometries(
+                        build->count);
+                    std::vector<const VkAccelerationStructureBuildOffsetInfoKHR*> ppBuildOffsets(
+                        build->count);
+                    for (uint32_t i = 0; i < build->count; ++i) {
+                        RayTracingAccelerationContainer* container =
+                            ToBackend(containers[i].Get());
+
+                        container->FlushInstanceUpdates();
+
+                        if (container->GetExternalInstanceBuffer() != nullptr) {
+                            ToBackend(container->GetExternalInstanceBuffer())
+                                ->TransitionUsageNow(recordingContext,
+                                                     wgpu::BufferUsage::RayTracing);
+                        }
+
+                        std::vector<VkAccelerationStructureGeometryKHR>& geometries =
+                            container->GetGeometries();
+                        ppGeometries[i] = geometries.data();
+
+                        VkAccelerationStructureBuildGeometryInfoKHR& asInfo = asInfos[i];
+                        asInfo.sType =
+                            VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
+                        asInfo.pNext = nullptr;
+                        asInfo.type = ToVulkanAccelerationContainerLevel(container->GetLevel());
+                        asInfo.flags =
+                            ToVulkanBuildAccelerationContainerFlags(container->GetUsage());
+                        asInfo.update = VK_FALSE;
+                        asInfo.srcAccelerationStructure = VK_NULL_HANDLE;
+                        asInfo.dstAccelerationStructure = container->GetAccelerationStructure();
+                        asInfo.geometryArrayOfPointers = VK_FALSE;
+                        asInfo.geometryCount = geometries.size();
+                        asInfo.ppGeometries = &ppGeometries[i];
+
+                        ScratchBufferPool::ScratchBuffer* buildScratch;
+                        DAWN_TRY_ASSIGN(buildScratch, device->GetScratchBufferPool()->Acquire(
+                                                          container->GetBuildScratchSize()));
+                        asInfo.scratchData.deviceAddress = buildScratch->deviceAddress;
+
+                        ppBuildOffsets[i] = container->GetBuildOffsets().data();
+
+                        container->SetBuildState(true);
+
+                        if (container->GetLevel() != containers[0]->GetLevel()) {
+                            return DAWN_VALIDATION_ERROR(
+                                "Acceleration containers of different levels must be built in "
+                                "separate batches");
+                        }
+                    }
+
+                    device->fn.CmdBuildAccelerationStructureKHR(commands, build->count,
+                                                                asInfos.data(),
+                                                                ppBuildOffsets.data());
+
+                    VkMemoryBarrier barrier;
+                    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+                    barrier.pNext = nullptr;
+                    barrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+                    barrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR |
+                                            VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+                    DAWN_COUNTER_INCREMENT(device->GetCounters(), PipelineBarriers);
+                    device->fn.CmdPipelineBarrier(
+                        commands, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                        VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR |
+                            VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+                        0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+                    if (lastUpdateContainer != nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Build and update passes for acceleration containers must be "
+                            "separated");
+                    }
+                    if (build->count > 0) {
+                        RayTracingAccelerationContainer* firstContainer =
+                            ToBackend(containers[0].Get());
+                        if (lastBuildContainer != nullptr &&
+                            lastBuildContainer->GetLevel() != firstContainer->GetLevel()) {
+                            return DAWN_VALIDATION_ERROR(
+                                "Acceleration containers of different levels must be built in "
+                                "separate passes");
+                        }
+                        lastBuildContainer = firstContainer;
+                    }
+                    break;
+                }
+
+                case Command::CompactRayTracingAccelerationContainer: {
+                    CompactRayTracingAccelerationContainerCmd* compact =
+                        mCommands.NextCommand<CompactRayTracingAccelerationContainerCmd>();
+                    RayTracingAccelerationContainer* srcContainer =
+                        ToBackend(compact->srcContainer.Get());
+                    RayTracingAccelerationContainer* dstContainer =
+                        ToBackend(compact->dstContainer.Get());
+
+                    VkCopyAccelerationStructureInfoKHR copyInfo;
+                    copyInfo.sType = VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR;
+                    copyInfo.pNext = nullptr;
+                    copyInfo.src = srcContainer->GetAccelerationStructure();
+                    copyInfo.dst = dstContainer->GetAccelerationStructure();
+                    copyInfo.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR;
+
+                    device->fn.CmdCopyAccelerationStructureKHR(commands, &copyInfo);
+
+                    dstContainer->SetBuildState(true);
+                    break;
+                }
+
+                case Command::WriteRayTracingAccelerationContainerCompactedSize: {
+                    WriteRayTracingAccelerationContainerCompactedSizeCmd* write =
+                        mCommands
+                            .NextCommand<WriteRayTracingAccelerationContainerCompactedSizeCmd>();
+                    RayTracingAccelerationContainer* container = ToBackend(write->container.Get());
+                    Buffer* destination = ToBackend(write->destination.Get());
+
+                    // The compacted size is only available once the build commands finished
+                    // executing, so the query result is written on the GPU timeline and read
+                    // back through a mapped buffer.
+                    VkQueryPoolCreateInfo createInfo;
+                    createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+                    createInfo.pNext = nullptr;
+                    createInfo.flags = 0;
+                    createInfo.queryType =
+                        VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR;
+                    createInfo.queryCount = 1;
+                    createInfo.pipelineStatistics = 0;
+
+                    VkQueryPool queryPool = VK_NULL_HANDLE;
+                    DAWN_TRY(CheckVkSuccess(device->fn.CreateQueryPool(device->GetVkDevice(),
+                                                                       &createInfo, nullptr,
+                                                                       &*queryPool),
+                                            "vkCreateQueryPool"));
+                    if (IsReusable()) {
+                        // Replays of the cached recording reset and write the pool again, so
+                        // it is kept alive with the command buffer.
+                        mCachedQueryPools.push_back(queryPool);
+                    } else {
+                        device->GetFencedDeleter()->DeleteWhenUnused(queryPool);
+                    }
+
+                    device->fn.CmdResetQueryPool(commands, queryPool, 0, 1);
+
+                    VkAccelerationStructureKHR accelerationStructure =
+                        container->GetAccelerationStructure();
+                    device->fn.CmdWriteAccelerationStructuresPropertiesKHR(
+                        commands, 1, &accelerationStructure,
+                        VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR, queryPool, 0);
+
+                    destination->EnsureDataInitializedAsDestination(
+                        recordingContext, write->destinationOffset, sizeof(uint64_t));
+                    destination->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
+
+                    device->fn.CmdCopyQueryPoolResults(
+                        commands, queryPool, 0, 1, destination->GetHandle(),
+                        destination->GetHandleOffset() + write->destinationOffset,
+                        sizeof(uint64_t),
+                        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+                    break;
+                }
+
+                case Command::WriteRayTracingAccelerationContainerSerializationSize: {
+                    WriteRayTracingAccelerationContainerSerializationSizeCmd* write =
+                        mCommands
+                            .NextCommand<WriteRayTracingAccelerationContainerSerializationSizeCmd>();
+                    RayTracingAccelerationContainer* container = ToBackend(write->container.Get());
+                    Buffer* destination = ToBackend(write->destination.Get());
+
+                    // Like the compacted size, the serialization size is only available once
+                    // the build commands finished executing, so it is queried on the GPU
+                    // timeline and read back through a mapped buffer.
+                    VkQueryPoolCreateInfo createInfo;
+                    createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+                    createInfo.pNext = nullptr;
+                    createInfo.flags = 0;
+                    createInfo.queryType =
+                        VK_QUERY_TYPE_ACCELERATION_STRUCTURE_SERIALIZATION_SIZE_KHR;
+                    createInfo.queryCount = 1;
+                    createInfo.pipelineStatistics = 0;
+
+                    VkQueryPool queryPool = VK_NULL_HANDLE;
+                    DAWN_TRY(CheckVkSuccess(device->fn.CreateQueryPool(device->GetVkDevice(),
+                                                                       &createInfo, nullptr,
+                                                                       &*queryPool),
+                                            "vkCreateQueryPool"));
+                    if (IsReusable()) {
+                        // Replays of the cached recording reset and write the pool again, so
+                        // it is kept alive with the command buffer.
+                        mCachedQueryPools.push_back(queryPool);
+                    } else {
+                        device->GetFencedDeleter()->DeleteWhenUnused(queryPool);
+                    }
+
+                    device->fn.CmdResetQueryPool(commands, queryPool, 0, 1);
+
+                    VkAccelerationStructureKHR accelerationStructure =
+                        container->GetAccelerationStructure();
+                    device->fn.CmdWriteAccelerationStructuresPropertiesKHR(
+                        commands, 1, &accelerationStructure,
+                        VK_QUERY_TYPE_ACCELERATION_STRUCTURE_SERIALIZATION_SIZE_KHR, queryPool, 0);
+
+                    destination->EnsureDataInitializedAsDestination(
+                        recordingContext, write->destinationOffset, sizeof(uint64_t));
+                    destination->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
+
+                    device->fn.CmdCopyQueryPoolResults(
+                        commands, queryPool, 0, 1, destination->GetHandle(),
+                        destination->GetHandleOffset() + write->destinationOffset,
+                        sizeof(uint64_t),
+                        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+                    break;
+                }
+
+                case Command::SerializeRayTracingAccelerationContainer: {
+                    SerializeRayTracingAccelerationContainerCmd* serialize =
+                        mCommands.NextCommand<SerializeRayTracingAccelerationContainerCmd>();
+                    RayTracingAccelerationContainer* container =
+                        ToBackend(serialize->container.Get());
+                    Buffer* destination = ToBackend(serialize->destination.Get());
+
+                    // The written size is only known on the GPU timeline, so the whole buffer
+                    // is considered initialized by the serialization.
+                    destination->EnsureDataInitialized(recordingContext);
+                    destination->TransitionUsageNow(recordingContext,
+                                                    wgpu::BufferUsage::RayTracing);
+
+                    VkCopyAccelerationStructureToMemoryInfoKHR copyInfo;
+                    copyInfo.sType =
+                        VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_TO_MEMORY_INFO_KHR;
+                    copyInfo.pNext = nullptr;
+                    copyInfo.src = container->GetAccelerationStructure();
+                    copyInfo.dst.deviceAddress =
+                        destination->GetDeviceAddress() + serialize->destinationOffset;
+                    copyInfo.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_SERIALIZE_KHR;
+
+                    device->fn.CmdCopyAccelerationStructureToMemoryKHR(commands, &copyInfo);
+                    break;
+                }
+
+                case Command::DeserializeRayTracingAccelerationContainer: {
+                    DeserializeRayTracingAccelerationContainerCmd* deserialize =
+                        mCommands.NextCommand<DeserializeRayTracingAccelerationContainerCmd>();
+                    RayTracingAccelerationContainer* container =
+                        ToBackend(deserialize->container.Get());
+                    Buffer* source = ToBackend(deserialize->source.Get());
+
+                    source->EnsureDataInitialized(recordingContext);
+                    source->TransitionUsageNow(recordingContext, wgpu::BufferUsage::RayTracing);
+
+                    VkCopyMemoryToAccelerationStructureInfoKHR copyInfo;
+                    copyInfo.sType =
+                        VK_STRUCTURE_TYPE_COPY_MEMORY_TO_ACCELERATION_STRUCTURE_INFO_KHR;
+                    copyInfo.pNext = nullptr;
+                    copyInfo.src.deviceAddress =
+                        source->GetDeviceAddress() + deserialize->sourceOffset;
+                    copyInfo.dst = container->GetAccelerationStructure();
+                    copyInfo.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_DESERIALIZE_KHR;
+
+                    device->fn.CmdCopyMemoryToAccelerationStructureKHR(commands, &copyInfo);
+
+                    container->SetBuildState(true);
+                    break;
+                }
+
                 case Command::CopyRayTracingAccelerationContainer: {
                     CopyRayTracingAccelerationContainerCmd* copy =
                         mCommands.NextCommand<CopyRayTracingAccelerationContainerCmd>();
@@ -478,9 +1062,14 @@ namespace dawn_native { namespace vulkan {
                         mCommands.NextCommand<UpdateRayTracingAccelerationContainerCmd>();
                     RayTracingAccelerationContainer* container = ToBackend(update->container.Get());
 
-                    // we can destroy the scratch build memory after the first update
+                    container->FlushInstanceUpdates();
+
+                    if (container->GetExternalInstanceBuffer() != nullptr) {
+                        ToBackend(container->GetExternalInstanceBuffer())
+                            ->TransitionUsageNow(recordingContext, wgpu::BufferUsage::RayTracing);
+                    }
+
                     if (container->IsBuilt() && !container->IsUpdated()) {
-                        container->DestroyScratchBuildMemory();
                         container->SetUpdateState(true);
                     }
 
@@ -499,8 +1088,11 @@ namespace dawn_native { namespace vulkan {
                     asInfo.geometryArrayOfPointers = VK_FALSE;
                     asInfo.geometryCount = geometries.size();
                     asInfo.ppGeometries = &ppGeometries;
-                    asInfo.scratchData.deviceAddress =
-                        container->GetScratchMemory().update.deviceAddress;
+
+                    ScratchBufferPool::ScratchBuffer* updateScratch;
+                    DAWN_TRY_ASSIGN(updateScratch, device->GetScratchBufferPool()->Acquire(
+                                                       container->GetUpdateScratchSize()));
+                    asInfo.scratchData.deviceAddress = updateScratch->deviceAddress;
 
                     std::vector<VkAccelerationStructureBuildOffsetInfoKHR>& buildOffsets =
                         container->GetBuildOffsets();
@@ -532,12 +1124,16 @@ namespace dawn_native { namespace vulkan {
                     Buffer* srcBuffer = ToBackend(copy->source.Get());
                     Buffer* dstBuffer = ToBackend(copy->destination.Get());
 
+                    srcBuffer->EnsureDataInitialized(recordingContext);
+                    dstBuffer->EnsureDataInitializedAsDestination(
+                        recordingContext, copy->destinationOffset, copy->size);
+
                     srcBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
                     dstBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
 
                     VkBufferCopy region;
-                    region.srcOffset = copy->sourceOffset;
-                    region.dstOffset = copy->destinationOffset;
+                    region.srcOffset = srcBuffer->GetHandleOffset() + copy->sourceOffset;
+                    region.dstOffset = dstBuffer->GetHandleOffset() + copy->destinationOffset;
                     region.size = copy->size;
 
                     VkBuffer srcHandle = srcBuffer->GetHandle();
@@ -546,6 +1142,65 @@ namespace dawn_native { namespace vulkan {
                     break;
                 }
 
+                case Command::CopyBufferToBufferBatch: {
+                    CopyBufferToBufferBatchCmd* copy =
+                        mCommands.NextCommand<CopyBufferToBufferBatchCmd>();
+                    const BufferCopyRegion* copyRegions =
+                        mCommands.NextData<BufferCopyRegion>(copy->regionCount);
+                    Buffer* srcBuffer = ToBackend(copy->source.Get());
+                    Buffer* dstBuffer = ToBackend(copy->destination.Get());
+
+                    srcBuffer->EnsureDataInitialized(recordingContext);
+                    for (uint32_t i = 0; i < copy->regionCount; ++i) {
+                        dstBuffer->EnsureDataInitializedAsDestination(
+                            recordingContext, copyRegions[i].destinationOffset,
+                            copyRegions[i].size);
+                    }
+
+                    // One barrier pair covers the whole batch.
+                    srcBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
+                    dstBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
+
+                    std::vector<VkBufferCopy> regions(copy->regionCount);
+                    for (uint32_t i = 0; i < copy->regionCount; ++i) {
+                        regions[i].srcOffset =
+                            srcBuffer->GetHandleOffset() + copyRegions[i].sourceOffset;
+                        regions[i].dstOffset =
+                            dstBuffer->GetHandleOffset() + copyRegions[i].destinationOffset;
+                        regions[i].size = copyRegions[i].size;
+                    }
+
+                    device->fn.CmdCopyBuffer(commands, srcBuffer->GetHandle(),
+                                             dstBuffer->GetHandle(), copy->regionCount,
+                                             regions.data());
+                    break;
+                }
+
+                case Command::CopyBufferToRayTracingInstances: {
+                    CopyBufferToRayTracingInstancesCmd* copy =
+                        mCommands.NextCommand<CopyBufferToRayTracingInstancesCmd>();
+                    Buffer* srcBuffer = ToBackend(copy->source.Get());
+                    RayTracingAccelerationContainer* container =
+                        ToBackend(copy->container.Get());
+                    Buffer* instanceBuffer = container->GetInstanceMemory().allocation.Get();
+
+                    srcBuffer->EnsureDataInitialized(recordingContext);
+
+                    srcBuffer->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
+                    instanceBuffer->TransitionUsageNow(recordingContext,
+                                                       wgpu::BufferUsage::CopyDst);
+
+                    VkBufferCopy region;
+                    region.srcOffset = srcBuffer->GetHandleOffset() + copy->sourceOffset;
+                    region.dstOffset = instanceBuffer->GetHandleOffset() +
+                                       copy->firstInstance * kRayTracingInstanceSize;
+                    region.size = copy->instanceCount * kRayTracingInstanceSize;
+
+                    device->fn.CmdCopyBuffer(commands, srcBuffer->GetHandle(),
+                                             instanceBuffer->GetHandle(), 1, &region);
+                    break;
+                }
+
                 case Command::CopyBufferToTexture: {
                     CopyBufferToTextureCmd* copy = mCommands.NextCommand<CopyBufferToTextureCmd>();
                     auto& src = copy->source;
@@ -553,6 +1208,7 @@ namespace dawn_native { namespace vulkan {
 
                     VkBufferImageCopy region =
                         ComputeBufferImageCopyRegion(src, dst, copy->copySize);
+                    region.bufferOffset += ToBackend(src.buffer)->GetHandleOffset();
                     VkImageSubresourceLayers subresource = region.imageSubresource;
 
                     if (IsCompleteSubresourceCopiedTo(dst.texture.Get(), copy->copySize,
@@ -566,6 +1222,7 @@ namespace dawn_native { namespace vulkan {
                                                                   subresource.mipLevel, 1,
                                                                   subresource.baseArrayLayer, 1);
                     }
+                    ToBackend(src.buffer)->EnsureDataInitialized(recordingContext);
                     ToBackend(src.buffer)
                         ->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
                     ToBackend(dst.texture)
@@ -590,6 +1247,7 @@ namespace dawn_native { namespace vulkan {
 
                     VkBufferImageCopy region =
                         ComputeBufferImageCopyRegion(dst, src, copy->copySize);
+                    region.bufferOffset += ToBackend(dst.buffer)->GetHandleOffset();
                     VkImageSubresourceLayers subresource = region.imageSubresource;
 
                     ToBackend(src.texture)
@@ -597,6 +1255,12 @@ namespace dawn_native { namespace vulkan {
                                                               subresource.mipLevel, 1,
                                                               subresource.baseArrayLayer, 1);
 
+                    // The copy writes the destination in bytesPerRow strides but never
+                    // touches the row-padding bytes, so the footprint can't be counted as
+                    // written: a later MapRead would see stale memory in the padding.
+                    // Clear the uninitialized tail before the copy instead.
+                    ToBackend(dst.buffer)->EnsureDataInitialized(recordingContext);
+
                     ToBackend(src.texture)
                         ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopySrc,
                                              subresource.mipLevel, 1, subresource.baseArrayLayer,
@@ -674,6 +1338,39 @@ namespace dawn_native { namespace vulkan {
                     break;
                 }
 
+                case Command::ResolveQuerySet: {
+                    ResolveQuerySetCmd* cmd = mCommands.NextCommand<ResolveQuerySetCmd>();
+                    QuerySet* querySet = ToBackend(cmd->querySet.Get());
+                    Buffer* destination = ToBackend(cmd->destination.Get());
+
+                    destination->EnsureDataInitializedAsDestination(
+                        recordingContext, cmd->destinationOffset,
+                        uint64_t(cmd->queryCount) * querySet->GetQueryDataSize());
+                    destination->TransitionUsageNow(recordingContext,
+                                                    wgpu::BufferUsage::QueryResolve);
+
+                    device->fn.CmdCopyQueryPoolResults(
+                        commands, querySet->GetHandle(), cmd->firstQuery, cmd->queryCount,
+                        destination->GetHandle(),
+                        destination->GetHandleOffset() + cmd->destinationOffset,
+                        querySet->GetQueryDataSize(),
+                        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+                    break;
+                }
+
+                case Command::WriteTimestamp: {
+                    WriteTimestampCmd* cmd = mCommands.NextCommand<WriteTimestampCmd>();
+                    QuerySet* querySet = ToBackend(cmd->querySet.Get());
+
+                    // Queries must be reset before they are written; resetting just before the
+                    // write keeps the query reusable across submits.
+                    device->fn.CmdResetQueryPool(commands, querySet->GetHandle(), cmd->queryIndex,
+                                                 1);
+                    device->fn.CmdWriteTimestamp(commands, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                                 querySet->GetHandle(), cmd->queryIndex);
+                    break;
+                }
+
                 case Command::BeginRenderPass: {
                     BeginRenderPassCmd* cmd = mCommands.NextCommand<BeginRenderPassCmd>();
 
@@ -720,6 +1417,10 @@ namespace dawn_native { namespace vulkan {
         VkCommandBuffer commands = recordingContext->commandBuffer;
 
         ComputeDescriptorSetTracker descriptorSets = {};
+        ImmediateDataTracker immediateData = {};
+
+        // Resolve the hot entry point once per pass, as in RecordRenderPass.
+        const PFN_vkCmdDispatch CmdDispatch = device->fn.CmdDispatch;
 
         Command type;
         while (mCommands.NextCommandId(&type)) {
@@ -729,11 +1430,52 @@ namespace dawn_native { namespace vulkan {
                     return;
                 }
 
+                case Command::BeginPipelineStatisticsQuery: {
+                    BeginPipelineStatisticsQueryCmd* cmd =
+                        mCommands.NextCommand<BeginPipelineStatisticsQueryCmd>();
+                    QuerySet* querySet = ToBackend(cmd->querySet.Get());
+
+                    device->fn.CmdResetQueryPool(commands, querySet->GetHandle(), cmd->queryIndex,
+                                                 1);
+                    device->fn.CmdBeginQuery(commands, querySet->GetHandle(), cmd->queryIndex, 0);
+                    break;
+                }
+
+                case Command::EndPipelineStatisticsQuery: {
+                    EndPipelineStatisticsQueryCmd* cmd =
+                        mCommands.NextCommand<EndPipelineStatisticsQueryCmd>();
+                    QuerySet* querySet = ToBackend(cmd->querySet.Get());
+
+                    device->fn.CmdEndQuery(commands, querySet->GetHandle(), cmd->queryIndex);
+                    break;
+                }
+
                 case Command::Dispatch: {
                     DispatchCmd* dispatch = mCommands.NextCommand<DispatchCmd>();
 
                     descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_COMPUTE);
-                    device->fn.CmdDispatch(commands, dispatch->x, dispatch->y, dispatch->z);
+                    immediateData.Apply(device, commands);
+                    CmdDispatch(commands, dispatch->x, dispatch->y, dispatch->z);
+                    break;
+                }
+
+                case Command::DispatchBatch: {
+                    DispatchBatchCmd* dispatch = mCommands.NextCommand<DispatchBatchCmd>();
+                    DispatchBatchEntry* entries =
+                        mCommands.NextData<DispatchBatchEntry>(dispatch->entryCount);
+                    BindGroup* bindGroup = ToBackend(dispatch->group.Get());
+
+                    // Each entry only moves the dynamic offset, so Apply() re-binds the
+                    // single dirty set and the loop stays a tight bind+dispatch pair per
+                    // entry.
+                    for (uint32_t i = 0; i < dispatch->entryCount; ++i) {
+                        descriptorSets.OnSetBindGroup(dispatch->groupIndex, bindGroup, 1,
+                                                      &entries[i].dynamicOffset);
+                        descriptorSets.Apply(device, recordingContext,
+                                             VK_PIPELINE_BIND_POINT_COMPUTE);
+                        immediateData.Apply(device, commands);
+                        CmdDispatch(commands, entries[i].x, entries[i].y, entries[i].z);
+                    }
                     break;
                 }
 
@@ -742,9 +1484,12 @@ namespace dawn_native { namespace vulkan {
                     VkBuffer indirectBuffer = ToBackend(dispatch->indirectBuffer)->GetHandle();
 
                     descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_COMPUTE);
+                    immediateData.Apply(device, commands);
                     device->fn.CmdDispatchIndirect(
                         commands, indirectBuffer,
-                        static_cast<VkDeviceSize>(dispatch->indirectOffset));
+                        static_cast<VkDeviceSize>(
+                            ToBackend(dispatch->indirectBuffer)->GetHandleOffset() +
+                            dispatch->indirectOffset));
                     break;
                 }
 
@@ -769,6 +1514,15 @@ namespace dawn_native { namespace vulkan {
                     device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_COMPUTE,
                                                pipeline->GetHandle());
                     descriptorSets.OnSetPipeline(pipeline);
+                    immediateData.OnSetPipeline(ToBackend(pipeline->GetLayout()));
+                    break;
+                }
+
+                case Command::SetImmediateData: {
+                    SetImmediateDataCmd* cmd = mCommands.NextCommand<SetImmediateDataCmd>();
+                    uint8_t* data = mCommands.NextData<uint8_t>(cmd->size);
+
+                    immediateData.OnSetImmediateData(cmd->offset, cmd->size, data);
                     break;
                 }
 
@@ -838,19 +1592,14 @@ namespace dawn_native { namespace vulkan {
         VkCommandBuffer commands = recordingContext->commandBuffer;
 
         ComputeDescriptorSetTracker descriptorSets = {};
+        ImmediateDataTracker immediateData = {};
 
         RayTracingPipeline* usedPipeline = nullptr;
 
-        Command type;
-        while (mCommands.NextCommandId(&type)) {
+        auto EncodeRayTracingBundleCommand = [&](CommandIterator* iter, Command type) {
             switch (type) {
-                case Command::EndRayTracingPass: {
-                    mCommands.NextCommand<EndRayTracingPassCmd>();
-                    return;
-                } break;
-
                 case Command::TraceRays: {
-                    TraceRaysCmd* traceRays = mCommands.NextCommand<TraceRaysCmd>();
+                    TraceRaysCmd* traceRays = iter->NextCommand<TraceRaysCmd>();
 
                     ASSERT(usedPipeline != nullptr);
 
@@ -860,7 +1609,7 @@ namespace dawn_native { namespace vulkan {
                     VkBuffer sbtBuffer = sbt->GetGroupBufferHandle();
 
                     uint32_t groupHandleSize = sbt->GetShaderGroupHandleSize();
-                    uint32_t groupSize = sbt->GetGroups().size();
+                    uint32_t groupSize = sbt->GetGroupCount();
                     uint32_t sbtSize = groupSize * groupHandleSize;
 
                     uint32_t rayGenOffset = traceRays->rayGenerationOffset;
@@ -869,6 +1618,7 @@ namespace dawn_native { namespace vulkan {
 
                     descriptorSets.Apply(device, recordingContext,
                                          VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR);
+                    immediateData.Apply(device, commands);
 
                     // clang-format off
                     VkStridedBufferRegionKHR rayGenSBT = {
@@ -890,13 +1640,58 @@ namespace dawn_native { namespace vulkan {
                                                traceRays->depth);
                 } break;
 
+                case Command::TraceRaysIndirect: {
+                    TraceRaysIndirectCmd* traceRays = iter->NextCommand<TraceRaysIndirectCmd>();
+
+                    ASSERT(usedPipeline != nullptr);
+
+                    RayTracingShaderBindingTable* sbt =
+                        ToBackend(usedPipeline->GetShaderBindingTable());
+
+                    VkBuffer sbtBuffer = sbt->GetGroupBufferHandle();
+
+                    uint32_t groupHandleSize = sbt->GetShaderGroupHandleSize();
+                    uint32_t groupSize = sbt->GetGroupCount();
+                    uint32_t sbtSize = groupSize * groupHandleSize;
+
+                    uint32_t rayGenOffset = traceRays->rayGenerationOffset;
+                    uint32_t rayHitOffset = traceRays->rayHitOffset;
+                    uint32_t rayMissOffset = traceRays->rayMissOffset;
+
+                    Buffer* indirectBuffer = ToBackend(traceRays->indirectBuffer.Get());
+
+                    descriptorSets.Apply(device, recordingContext,
+                                         VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR);
+                    immediateData.Apply(device, commands);
+
+                    // clang-format off
+                    VkStridedBufferRegionKHR rayGenSBT = {
+                        sbtBuffer, rayGenOffset * groupHandleSize, groupHandleSize, sbtSize
+                    };
+                    VkStridedBufferRegionKHR rayHitSBT = {
+                        sbtBuffer, rayHitOffset * groupHandleSize, groupHandleSize, sbtSize
+                    };
+                    VkStridedBufferRegionKHR rayMissSBT = {
+                        sbtBuffer, rayMissOffset * groupHandleSize, groupHandleSize, sbtSize
+                    };
+                    VkStridedBufferRegionKHR rayCallSBT = {
+                        VK_NULL_HANDLE, 0, 0, 0
+                    };
+                    // clang-format on
+
+                    device->fn.CmdTraceRaysIndirectKHR(
+                        commands, &rayGenSBT, &rayMissSBT, &rayHitSBT, &rayCallSBT,
+                        indirectBuffer->GetHandle(),
+                        indirectBuffer->GetHandleOffset() + traceRays->indirectOffset);
+                } break;
+
                 case Command::SetBindGroup: {
-                    SetBindGroupCmd* cmd = mCommands.NextCommand<SetBindGroupCmd>();
+                    SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
 
                     BindGroup* bindGroup = ToBackend(cmd->group.Get());
                     uint32_t* dynamicOffsets = nullptr;
                     if (cmd->dynamicOffsetCount > 0) {
-                        dynamicOffsets = mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
+                        dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
                     }
 
                     descriptorSets.OnSetBindGroup(cmd->index, bindGroup, cmd->dynamicOffsetCount,
@@ -904,8 +1699,7 @@ namespace dawn_native { namespace vulkan {
                 } break;
 
                 case Command::SetRayTracingPipeline: {
-                    SetRayTracingPipelineCmd* cmd =
-                        mCommands.NextCommand<SetRayTracingPipelineCmd>();
+                    SetRayTracingPipelineCmd* cmd = iter->NextCommand<SetRayTracingPipelineCmd>();
                     RayTracingPipeline* pipeline = ToBackend(cmd->pipeline).Get();
 
                     device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_RAY_TRACING_NV,
@@ -914,12 +1708,20 @@ namespace dawn_native { namespace vulkan {
                     usedPipeline = pipeline;
 
                     descriptorSets.OnSetPipeline(pipeline);
+                    immediateData.OnSetPipeline(ToBackend(pipeline->GetLayout()));
+                } break;
+
+                case Command::SetImmediateData: {
+                    SetImmediateDataCmd* cmd = iter->NextCommand<SetImmediateDataCmd>();
+                    uint8_t* data = iter->NextData<uint8_t>(cmd->size);
+
+                    immediateData.OnSetImmediateData(cmd->offset, cmd->size, data);
                 } break;
 
                 case Command::InsertDebugMarker: {
                     if (device->GetDeviceInfo().debugMarker) {
-                        InsertDebugMarkerCmd* cmd = mCommands.NextCommand<InsertDebugMarkerCmd>();
-                        const char* label = mCommands.NextData<char>(cmd->length + 1);
+                        InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
+                        const char* label = iter->NextData<char>(cmd->length + 1);
                         VkDebugMarkerMarkerInfoEXT markerInfo;
                         markerInfo.sType = VK_STRUCTURE_TYPE_DEBUG_MARKER_MARKER_INFO_EXT;
                         markerInfo.pNext = nullptr;
@@ -931,23 +1733,23 @@ namespace dawn_native { namespace vulkan {
                         markerInfo.color[3] = 1.0;
                         device->fn.CmdDebugMarkerInsertEXT(commands, &markerInfo);
                     } else {
-                        SkipCommand(&mCommands, Command::InsertDebugMarker);
+                        SkipCommand(iter, Command::InsertDebugMarker);
                     }
                 } break;
 
                 case Command::PopDebugGroup: {
                     if (device->GetDeviceInfo().debugMarker) {
-                        mCommands.NextCommand<PopDebugGroupCmd>();
+                        iter->NextCommand<PopDebugGroupCmd>();
                         device->fn.CmdDebugMarkerEndEXT(commands);
                     } else {
-                        SkipCommand(&mCommands, Command::PopDebugGroup);
+                        SkipCommand(iter, Command::PopDebugGroup);
                     }
                 } break;
 
                 case Command::PushDebugGroup: {
                     if (device->GetDeviceInfo().debugMarker) {
-                        PushDebugGroupCmd* cmd = mCommands.NextCommand<PushDebugGroupCmd>();
-                        const char* label = mCommands.NextData<char>(cmd->length + 1);
+                        PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
+                        const char* label = iter->NextData<char>(cmd->length + 1);
                         VkDebugMarkerMarkerInfoEXT markerInfo;
                         markerInfo.sType = VK_STRUCTURE_TYPE_DEBUG_MARKER_MARKER_INFO_EXT;
                         markerInfo.pNext = nullptr;
@@ -959,7 +1761,7 @@ namespace dawn_native { namespace vulkan {
                         markerInfo.color[3] = 1.0;
                         device->fn.CmdDebugMarkerBeginEXT(commands, &markerInfo);
                     } else {
-                        SkipCommand(&mCommands, Command::PushDebugGroup);
+                        SkipCommand(iter, Command::PushDebugGroup);
                     }
                 } break;
 
@@ -967,9 +1769,55 @@ namespace dawn_native { namespace vulkan {
                     UNREACHABLE();
                 } break;
             }
+        };
+
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            switch (type) {
+                case Command::EndRayTracingPass: {
+                    mCommands.NextCommand<EndRayTracingPassCmd>();
+                    return;
+                } break;
+
+                case Command::BeginPipelineStatisticsQuery: {
+                    BeginPipelineStatisticsQueryCmd* cmd =
+                        mCommands.NextCommand<BeginPipelineStatisticsQueryCmd>();
+                    QuerySet* querySet = ToBackend(cmd->querySet.Get());
+
+                    device->fn.CmdResetQueryPool(commands, querySet->GetHandle(), cmd->queryIndex,
+                                                 1);
+                    device->fn.CmdBeginQuery(commands, querySet->GetHandle(), cmd->queryIndex, 0);
+                } break;
+
+                case Command::EndPipelineStatisticsQuery: {
+                    EndPipelineStatisticsQueryCmd* cmd =
+                        mCommands.NextCommand<EndPipelineStatisticsQueryCmd>();
+                    QuerySet* querySet = ToBackend(cmd->querySet.Get());
+
+                    device->fn.CmdEndQuery(commands, querySet->GetHandle(), cmd->queryIndex);
+                } break;
+
+                case Command::ExecuteRayTracingBundles: {
+                    ExecuteRayTracingBundlesCmd* cmd =
+                        mCommands.NextCommand<ExecuteRayTracingBundlesCmd>();
+                    auto bundles = mCommands.NextData<Ref<RayTracingBundleBase>>(cmd->count);
+
+                    for (uint32_t i = 0; i < cmd->count; ++i) {
+                        CommandIterator* iter = bundles[i]->GetCommands();
+                        iter->Reset();
+                        while (iter->NextCommandId(&type)) {
+                            EncodeRayTracingBundleCommand(iter, type);
+                        }
+                    }
+                } break;
+
+                default: {
+                    EncodeRayTracingBundleCommand(&mCommands, type);
+                } break;
+            }
         }
 
-        // EndComputePass should have been called
+        // EndRayTracingPass should have been called
         UNREACHABLE();
     }
 
@@ -978,7 +1826,8 @@ namespace dawn_native { namespace vulkan {
         Device* device = ToBackend(GetDevice());
         VkCommandBuffer commands = recordingContext->commandBuffer;
 
-        DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd));
+        DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd,
+                                       IsReusable() ? &mCachedFramebuffers : nullptr));
 
         // Set the default value for the dynamic state
         {
@@ -1014,16 +1863,26 @@ namespace dawn_native { namespace vulkan {
         }
 
         RenderDescriptorSetTracker descriptorSets = {};
+        ImmediateDataTracker immediateData = {};
         RenderPipeline* lastPipeline = nullptr;
 
+        // Resolve the draw entry points once per pass instead of once per command. As in
+        // ApplyDescriptorSets, the dispatch table is otherwise reloaded on every draw.
+        const PFN_vkCmdDraw CmdDraw = device->fn.CmdDraw;
+        const PFN_vkCmdDrawIndexed CmdDrawIndexed = device->fn.CmdDrawIndexed;
+        const PFN_vkCmdDrawIndirect CmdDrawIndirect = device->fn.CmdDrawIndirect;
+        const PFN_vkCmdDrawIndexedIndirect CmdDrawIndexedIndirect =
+            device->fn.CmdDrawIndexedIndirect;
+
         auto EncodeRenderBundleCommand = [&](CommandIterator* iter, Command type) {
             switch (type) {
                 case Command::Draw: {
                     DrawCmd* draw = iter->NextCommand<DrawCmd>();
 
                     descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDraw(commands, draw->vertexCount, draw->instanceCount,
-                                       draw->firstVertex, draw->firstInstance);
+                    immediateData.Apply(device, commands);
+                    CmdDraw(commands, draw->vertexCount, draw->instanceCount, draw->firstVertex,
+                            draw->firstInstance);
                     break;
                 }
 
@@ -1031,9 +1890,9 @@ namespace dawn_native { namespace vulkan {
                     DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
 
                     descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDrawIndexed(commands, draw->indexCount, draw->instanceCount,
-                                              draw->firstIndex, draw->baseVertex,
-                                              draw->firstInstance);
+                    immediateData.Apply(device, commands);
+                    CmdDrawIndexed(commands, draw->indexCount, draw->instanceCount,
+                                   draw->firstIndex, draw->baseVertex, draw->firstInstance);
                     break;
                 }
 
@@ -1042,9 +1901,12 @@ namespace dawn_native { namespace vulkan {
                     VkBuffer indirectBuffer = ToBackend(draw->indirectBuffer)->GetHandle();
 
                     descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDrawIndirect(commands, indirectBuffer,
-                                               static_cast<VkDeviceSize>(draw->indirectOffset), 1,
-                                               0);
+                    immediateData.Apply(device, commands);
+                    CmdDrawIndirect(commands, indirectBuffer,
+                                    static_cast<VkDeviceSize>(
+                                        ToBackend(draw->indirectBuffer)->GetHandleOffset() +
+                                        draw->indirectOffset),
+                                    1, 0);
                     break;
                 }
 
@@ -1053,9 +1915,37 @@ namespace dawn_native { namespace vulkan {
                     VkBuffer indirectBuffer = ToBackend(draw->indirectBuffer)->GetHandle();
 
                     descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDrawIndexedIndirect(
-                        commands, indirectBuffer, static_cast<VkDeviceSize>(draw->indirectOffset),
-                        1, 0);
+                    immediateData.Apply(device, commands);
+                    CmdDrawIndexedIndirect(commands, indirectBuffer,
+                                           static_cast<VkDeviceSize>(
+                                               ToBackend(draw->indirectBuffer)->GetHandleOffset() +
+                                               draw->indirectOffset),
+                                           1, 0);
+                    break;
+                }
+
+                case Command::MultiDrawIndexedIndirect: {
+                    MultiDrawIndexedIndirectCmd* draw =
+                        iter->NextCommand<MultiDrawIndexedIndirectCmd>();
+                    VkBuffer indirectBuffer = ToBackend(draw->indirectBuffer)->GetHandle();
+                    VkDeviceSize indirectOffset = static_cast<VkDeviceSize>(
+                        ToBackend(draw->indirectBuffer)->GetHandleOffset() + draw->indirectOffset);
+
+                    descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                    immediateData.Apply(device, commands);
+                    if (draw->countBuffer != nullptr) {
+                        ASSERT(device->fn.CmdDrawIndexedIndirectCountKHR != nullptr);
+                        VkBuffer countBuffer = ToBackend(draw->countBuffer)->GetHandle();
+                        device->fn.CmdDrawIndexedIndirectCountKHR(
+                            commands, indirectBuffer, indirectOffset, countBuffer,
+                            static_cast<VkDeviceSize>(
+                                ToBackend(draw->countBuffer)->GetHandleOffset() +
+                                draw->countBufferOffset),
+                            draw->maxDrawCount, kDrawIndexedIndirectSize);
+                    } else {
+                        CmdDrawIndexedIndirect(commands, indirectBuffer, indirectOffset,
+                                               draw->maxDrawCount, kDrawIndexedIndirectSize);
+                    }
                     break;
                 }
 
@@ -1132,7 +2022,10 @@ namespace dawn_native { namespace vulkan {
                     VkIndexType indexType =
                         VulkanIndexType(lastPipeline->GetVertexStateDescriptor()->indexFormat);
                     device->fn.CmdBindIndexBuffer(
-                        commands, indexBuffer, static_cast<VkDeviceSize>(cmd->offset), indexType);
+                        commands, indexBuffer,
+                        static_cast<VkDeviceSize>(ToBackend(cmd->buffer)->GetHandleOffset() +
+                                                  cmd->offset),
+                        indexType);
                     break;
                 }
 
@@ -1145,13 +2038,23 @@ namespace dawn_native { namespace vulkan {
                     lastPipeline = pipeline;
 
                     descriptorSets.OnSetPipeline(pipeline);
+                    immediateData.OnSetPipeline(ToBackend(pipeline->GetLayout()));
+                    break;
+                }
+
+                case Command::SetImmediateData: {
+                    SetImmediateDataCmd* cmd = iter->NextCommand<SetImmediateDataCmd>();
+                    uint8_t* data = iter->NextData<uint8_t>(cmd->size);
+
+                    immediateData.OnSetImmediateData(cmd->offset, cmd->size, data);
                     break;
                 }
 
                 case Command::SetVertexBuffer: {
                     SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
                     VkBuffer buffer = ToBackend(cmd->buffer)->GetHandle();
-                    VkDeviceSize offset = static_cast<VkDeviceSize>(cmd->offset);
+                    VkDeviceSize offset = static_cast<VkDeviceSize>(
+                        ToBackend(cmd->buffer)->GetHandleOffset() + cmd->offset);
 
                     device->fn.CmdBindVertexBuffers(commands, cmd->slot, 1, &*buffer, &offset);
                     break;
@@ -26,10 +26,15 @@ namespace dawn_native {
     struct TextureCopy;
 }  // namespace dawn_native
 
+#include <utility>
+#include <vector>
+
 namespace dawn_native { namespace vulkan {
 
+    class Buffer;
     struct CommandRecordingContext;
     class Device;
+    class Texture;
 
     class CommandBuffer final : public CommandBufferBase {
       public:
@@ -38,10 +43,19 @@ namespace dawn_native { namespace vulkan {
 
         MaybeError RecordCommands(CommandRecordingContext* recordingContext);
 
+        // True when the command buffer only records acceleration container builds and
+        // updates, in which case it can run on the device's background queue.
+        bool OnlyContainsAccelerationContainerBuilds();
+
       private:
         CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor);
         ~CommandBuffer() override;
 
+        MaybeError RecordCommandsImpl(CommandRecordingContext* recordingContext);
+        // Records the commands once into mCachedCommands so later submits can replay them
+        // with vkCmdExecuteCommands instead of re-encoding.
+        MaybeError RecordCachedCommands(CommandRecordingContext* recordingContext);
+
         void RecordComputePass(CommandRecordingContext* recordingContext);
         void RecordRayTracingPass(CommandRecordingContext* recordingContext);
         MaybeError RecordRenderPass(CommandRecordingContext* recordingContext,
@@ -52,6 +66,21 @@ namespace dawn_native { namespace vulkan {
                                                 const Extent3D& copySize);
 
         CommandIterator mCommands;
+
+        // State for reusable command buffers. The commands are recorded once into a
+        // secondary command buffer and the usage-tracker state of every referenced
+        // resource is snapshotted at the start (entry) and end (exit) of the recording,
+        // so replays can recreate the entry states before executing the cached commands
+        // and restore the exit states afterwards.
+        VkCommandPool mCachedCommandPool = VK_NULL_HANDLE;
+        VkCommandBuffer mCachedCommands = VK_NULL_HANDLE;
+        std::vector<Ref<Buffer>> mCachedTempBuffers;
+        std::vector<VkFramebuffer> mCachedFramebuffers;
+        std::vector<VkQueryPool> mCachedQueryPools;
+        std::vector<std::pair<Buffer*, wgpu::BufferUsage>> mBufferEntryUsages;
+        std::vector<std::pair<Buffer*, wgpu::BufferUsage>> mBufferExitUsages;
+        std::vector<std::pair<Texture*, std::vector<wgpu::TextureUsage>>> mTextureEntryUsages;
+        std::vector<std::pair<Texture*, std::vector<wgpu::TextureUsage>>> mTextureExitUsages;
     };
 
 }}  // namespace dawn_native::vulkan
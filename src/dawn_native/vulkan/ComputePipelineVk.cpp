@@ -18,6 +18,7 @@
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/PipelineLayoutVk.h"
 #include "dawn_native/vulkan/ShaderModuleVk.h"
+#include "dawn_native/vulkan/UtilsVulkan.h"
 #include "dawn_native/vulkan/VulkanError.h"
 
 namespace dawn_native { namespace vulkan {
@@ -46,11 +47,17 @@ namespace dawn_native { namespace vulkan {
         createInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
         createInfo.stage.module = ToBackend(descriptor->computeStage.module)->GetHandle();
         createInfo.stage.pName = descriptor->computeStage.entryPoint;
-        createInfo.stage.pSpecializationInfo = nullptr;
+
+        // One module serves every constant-specialized variant: the stage's constant
+        // entries become a VkSpecializationInfo instead of a shader module per variant.
+        SpecializationInfoStorage specialization;
+        createInfo.stage.pSpecializationInfo =
+            BuildSpecializationInfo(descriptor->computeStage.constantCount,
+                                    descriptor->computeStage.constants, &specialization);
 
         Device* device = ToBackend(GetDevice());
         return CheckVkSuccess(
-            device->fn.CreateComputePipelines(device->GetVkDevice(), ::VK_NULL_HANDLE, 1,
+            device->fn.CreateComputePipelines(device->GetVkDevice(), device->GetPipelineCache(), 1,
                                               &createInfo, nullptr, &*mHandle),
             "CreateComputePipeline");
     }
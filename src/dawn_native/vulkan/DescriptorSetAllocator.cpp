@@ -14,20 +14,26 @@
 
 #include "dawn_native/vulkan/DescriptorSetAllocator.h"
 
+#include "common/Counters.h"
 #include "dawn_native/vulkan/BindGroupLayoutVk.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/VulkanError.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 namespace dawn_native { namespace vulkan {
 
     // TODO(enga): Figure out this value.
     static constexpr uint32_t kMaxDescriptorsPerPool = 512;
 
+    static std::atomic<uint64_t> sNextAllocatorId{1};
+
     DescriptorSetAllocator::DescriptorSetAllocator(
         BindGroupLayout* layout,
         std::map<VkDescriptorType, uint32_t> descriptorCountPerType)
-        : mLayout(layout) {
+        : mLayout(layout), mAllocatorId(sNextAllocatorId.fetch_add(1u)) {
         ASSERT(layout != nullptr);
 
         // Compute the total number of descriptors for this layout.
@@ -61,35 +67,78 @@ namespace dawn_native { namespace vulkan {
     }
 
     DescriptorSetAllocator::~DescriptorSetAllocator() {
+        ASSERT(mReturnedAllocations.load() == nullptr);
         for (auto& pool : mDescriptorPools) {
-            ASSERT(pool.freeSetIndices.size() == mMaxSets);
-            if (pool.vkPool != VK_NULL_HANDLE) {
+            DrainRecycledSets(pool.get());
+            ASSERT(pool->freeSetIndices.size() == mMaxSets);
+            if (pool->vkPool != VK_NULL_HANDLE) {
                 Device* device = ToBackend(mLayout->GetDevice());
-                device->GetFencedDeleter()->DeleteWhenUnused(pool.vkPool);
+                device->GetFencedDeleter()->DeleteWhenUnused(pool->vkPool);
             }
         }
     }
 
     ResultOrError<DescriptorSetAllocation> DescriptorSetAllocator::Allocate() {
-        if (mAvailableDescriptorPoolIndices.empty()) {
-            DAWN_TRY(AllocateDescriptorPool());
-        }
+        ThreadArena* arena = GetThreadArena();
 
-        ASSERT(!mAvailableDescriptorPoolIndices.empty());
+        // Fast path: the arena's pool is only touched by this thread, so no lock is
+        // needed to pop a free set or to drain the pool's recycled-set stack.
+        if (arena->pool != nullptr) {
+            if (arena->pool->freeSetIndices.empty()) {
+                DrainRecycledSets(arena->pool);
+            }
+            if (!arena->pool->freeSetIndices.empty()) {
+                SetIndex setIndex = arena->pool->freeSetIndices.back();
+                arena->pool->freeSetIndices.pop_back();
+                return DescriptorSetAllocation{arena->pool->sets[setIndex], arena->poolIndex,
+                                               setIndex};
+            }
+        }
 
-        const PoolIndex poolIndex = mAvailableDescriptorPoolIndices.back();
-        DescriptorPool* pool = &mDescriptorPools[poolIndex];
+        // Slow path: exchange the exhausted pool for one with free sets, creating a
+        // new VkDescriptorPool when none is available.
+        std::lock_guard<std::mutex> lock(mPoolMutex);
+
+        if (arena->pool != nullptr) {
+            arena->pool->ownedByArena = false;
+            // Recycled sets may have arrived since the drain above; if so the pool is
+            // immediately allocatable again for another arena.
+            if (arena->pool->recycledHead.load(std::memory_order_relaxed) != -1 &&
+                !arena->pool->inAvailableList) {
+                mAvailableDescriptorPoolIndices.push_back(arena->poolIndex);
+                arena->pool->inAvailableList = true;
+            }
+            arena->pool = nullptr;
+        }
 
-        ASSERT(!pool->freeSetIndices.empty());
+        while (!mAvailableDescriptorPoolIndices.empty()) {
+            PoolIndex poolIndex = mAvailableDescriptorPoolIndices.back();
+            mAvailableDescriptorPoolIndices.pop_back();
 
-        SetIndex setIndex = pool->freeSetIndices.back();
-        pool->freeSetIndices.pop_back();
+            DescriptorPool* pool = mDescriptorPools[poolIndex].get();
+            pool->inAvailableList = false;
+            DrainRecycledSets(pool);
+            if (!pool->freeSetIndices.empty()) {
+                pool->ownedByArena = true;
+                arena->pool = pool;
+                arena->poolIndex = poolIndex;
+                break;
+            }
+        }
 
-        if (pool->freeSetIndices.empty()) {
-            mAvailableDescriptorPoolIndices.pop_back();
+        if (arena->pool == nullptr) {
+            PoolIndex poolIndex;
+            DAWN_TRY_ASSIGN(poolIndex, AllocateDescriptorPool());
+            DescriptorPool* pool = mDescriptorPools[poolIndex].get();
+            pool->ownedByArena = true;
+            arena->pool = pool;
+            arena->poolIndex = poolIndex;
         }
 
-        return DescriptorSetAllocation{pool->sets[setIndex], poolIndex, setIndex};
+        SetIndex setIndex = arena->pool->freeSetIndices.back();
+        arena->pool->freeSetIndices.pop_back();
+        DAWN_COUNTER_INCREMENT(mLayout->GetDevice()->GetCounters(), DescriptorSetsAllocated);
+        return DescriptorSetAllocation{arena->pool->sets[setIndex], arena->poolIndex, setIndex};
     }
 
     void DescriptorSetAllocator::Deallocate(DescriptorSetAllocation* allocationInfo) {
@@ -101,12 +150,28 @@ namespace dawn_native { namespace vulkan {
         // host execution of the command and the end of the draw/dispatch.
         Device* device = ToBackend(mLayout->GetDevice());
         const Serial serial = device->GetPendingCommandSerial();
-        mPendingDeallocations.Enqueue({allocationInfo->poolIndex, allocationInfo->setIndex},
-                                      serial);
 
-        if (mLastDeallocationSerial != serial) {
+        // Lock-free return: push onto the stack of returned sets. The device thread
+        // moves them to the pending queue in FinishDeallocation.
+        ReturnedAllocation* node = new ReturnedAllocation{
+            allocationInfo->poolIndex, allocationInfo->setIndex, serial, nullptr};
+        node->next = mReturnedAllocations.load(std::memory_order_relaxed);
+        while (!mReturnedAllocations.compare_exchange_weak(node->next, node,
+                                                           std::memory_order_release)) {
+        }
+
+        // Ask the device to call FinishDeallocation once per new serial.
+        Serial last = mLastDeallocationSerial.load(std::memory_order_relaxed);
+        bool advanced = false;
+        while (last < serial) {
+            if (mLastDeallocationSerial.compare_exchange_weak(last, serial,
+                                                              std::memory_order_relaxed)) {
+                advanced = true;
+                break;
+            }
+        }
+        if (advanced) {
             device->EnqueueDeferredDeallocation(mLayout);
-            mLastDeallocationSerial = serial;
         }
 
         // Clear the content of allocation so that use after frees are more visible.
@@ -114,23 +179,49 @@ namespace dawn_native { namespace vulkan {
     }
 
     void DescriptorSetAllocator::FinishDeallocation(Serial completedSerial) {
-        for (const Deallocation& dealloc : mPendingDeallocations.IterateUpTo(completedSerial)) {
-            ASSERT(dealloc.poolIndex < mDescriptorPools.size());
-
-            auto& freeSetIndices = mDescriptorPools[dealloc.poolIndex].freeSetIndices;
-            if (freeSetIndices.empty()) {
-                mAvailableDescriptorPoolIndices.emplace_back(dealloc.poolIndex);
+        // Take the whole returned stack and move it into the serial queue. The stack is
+        // most-recent-first and concurrent returns may interleave, so sort by serial and
+        // promote stragglers like ConcurrentSerialQueue does; a promotion only delays the
+        // recycle, which is always safe.
+        ReturnedAllocation* node = mReturnedAllocations.exchange(nullptr, std::memory_order_acquire);
+        if (node != nullptr) {
+            std::vector<ReturnedAllocation> returned;
+            while (node != nullptr) {
+                returned.push_back(*node);
+                ReturnedAllocation* next = node->next;
+                delete node;
+                node = next;
+            }
+            std::stable_sort(returned.begin(), returned.end(),
+                             [](const ReturnedAllocation& a, const ReturnedAllocation& b) {
+                                 return a.serial < b.serial;
+                             });
+            for (const ReturnedAllocation& allocation : returned) {
+                Serial serial = allocation.serial;
+                if (!mPendingDeallocations.Empty()) {
+                    serial = std::max(serial, mPendingDeallocations.LastSerial());
+                }
+                mPendingDeallocations.Enqueue({allocation.poolIndex, allocation.setIndex}, serial);
             }
-            freeSetIndices.emplace_back(dealloc.setIndex);
+        }
+
+        for (const Deallocation& dealloc : mPendingDeallocations.IterateUpTo(completedSerial)) {
+            RecycleSet(dealloc.poolIndex, dealloc.setIndex);
         }
         mPendingDeallocations.ClearUpTo(completedSerial);
     }
 
-    MaybeError DescriptorSetAllocator::AllocateDescriptorPool() {
+    ResultOrError<DescriptorSetAllocator::PoolIndex>
+    DescriptorSetAllocator::AllocateDescriptorPool() {
         VkDescriptorPoolCreateInfo createInfo;
         createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
         createInfo.pNext = nullptr;
         createInfo.flags = 0;
+        // Layouts with binding arrays are created with the UPDATE_AFTER_BIND_POOL flag and
+        // their sets must come from a pool with the matching flag.
+        if (mLayout->GetBindingArrayCount() > 0) {
+            createInfo.flags |= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+        }
         createInfo.maxSets = mMaxSets;
         createInfo.poolSizeCount = static_cast<PoolIndex>(mPoolSizes.size());
         createInfo.pPoolSizes = mPoolSizes.data();
@@ -162,18 +253,64 @@ namespace dawn_native { namespace vulkan {
             DAWN_TRY(std::move(result));
         }
 
-        std::vector<SetIndex> freeSetIndices;
-        freeSetIndices.reserve(mMaxSets);
-
+        auto pool = std::make_unique<DescriptorPool>();
+        pool->vkPool = descriptorPool;
+        pool->sets = std::move(sets);
+        pool->recycledNext.resize(mMaxSets, -1);
+        pool->freeSetIndices.reserve(mMaxSets);
         for (SetIndex i = 0; i < mMaxSets; ++i) {
-            freeSetIndices.push_back(i);
+            pool->freeSetIndices.push_back(i);
+        }
+
+        PoolIndex poolIndex = static_cast<PoolIndex>(mDescriptorPools.size());
+        mDescriptorPools.push_back(std::move(pool));
+        return poolIndex;
+    }
+
+    DescriptorSetAllocator::ThreadArena* DescriptorSetAllocator::GetThreadArena() {
+        // The cache is keyed by the allocator id rather than |this| so entries left by
+        // destroyed allocators can never alias a new allocator. Stale entries persist
+        // until the thread exits; they are bounded by the number of layouts ever created.
+        thread_local std::unordered_map<uint64_t, ThreadArena*> tArenaCache;
+        auto it = tArenaCache.find(mAllocatorId);
+        if (it != tArenaCache.end()) {
+            return it->second;
         }
 
-        mAvailableDescriptorPoolIndices.push_back(mDescriptorPools.size());
-        mDescriptorPools.emplace_back(
-            DescriptorPool{descriptorPool, std::move(sets), std::move(freeSetIndices)});
+        std::lock_guard<std::mutex> lock(mPoolMutex);
+        mArenas.push_back(std::make_unique<ThreadArena>());
+        ThreadArena* arena = mArenas.back().get();
+        tArenaCache[mAllocatorId] = arena;
+        return arena;
+    }
+
+    // static
+    void DescriptorSetAllocator::DrainRecycledSets(DescriptorPool* pool) {
+        int32_t head = pool->recycledHead.exchange(-1, std::memory_order_acquire);
+        while (head != -1) {
+            pool->freeSetIndices.push_back(static_cast<SetIndex>(head));
+            head = pool->recycledNext[head];
+        }
+    }
 
-        return {};
+    void DescriptorSetAllocator::RecycleSet(PoolIndex poolIndex, SetIndex setIndex) {
+        std::lock_guard<std::mutex> lock(mPoolMutex);
+        ASSERT(poolIndex < mDescriptorPools.size());
+        DescriptorPool* pool = mDescriptorPools[poolIndex].get();
+
+        // Push onto the pool's recycled stack. The owning arena (if any) drains it
+        // lock-free when its free list runs out.
+        int32_t head = pool->recycledHead.load(std::memory_order_relaxed);
+        do {
+            pool->recycledNext[setIndex] = head;
+        } while (!pool->recycledHead.compare_exchange_weak(head, static_cast<int32_t>(setIndex),
+                                                           std::memory_order_release));
+
+        // An unowned pool with recycled sets is allocatable again.
+        if (!pool->ownedByArena && !pool->inAvailableList) {
+            mAvailableDescriptorPoolIndices.push_back(poolIndex);
+            pool->inAvailableList = true;
+        }
     }
 
 }}  // namespace dawn_native::vulkan
@@ -15,18 +15,27 @@
 #ifndef DAWNNATIVE_VULKAN_DESCRIPTORSETALLOCATOR_H_
 #define DAWNNATIVE_VULKAN_DESCRIPTORSETALLOCATOR_H_
 
+#include "common/Serial.h"
 #include "common/SerialQueue.h"
 #include "common/vulkan_platform.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/vulkan/DescriptorSetAllocation.h"
 
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace dawn_native { namespace vulkan {
 
     class BindGroupLayout;
 
+    // Allocates descriptor sets for one bind group layout. Allocation is designed so
+    // that concurrent encoding threads don't contend: each thread owns a pool arena it
+    // allocates from without locking, and Deallocate returns sets through a lock-free
+    // list. The shared mutex is only taken on the slow paths (creating or exchanging a
+    // VkDescriptorPool) and by the device-thread recycling in FinishDeallocation.
     class DescriptorSetAllocator {
         using PoolIndex = uint32_t;
         using SetIndex = uint16_t;
@@ -41,28 +50,65 @@ namespace dawn_native { namespace vulkan {
         void FinishDeallocation(Serial completedSerial);
 
       private:
-        MaybeError AllocateDescriptorPool();
+        struct DescriptorPool {
+            VkDescriptorPool vkPool = VK_NULL_HANDLE;
+            std::vector<VkDescriptorSet> sets;
+            // Free list owned by the arena the pool is currently attached to. No lock
+            // is needed because a pool is attached to at most one thread at a time.
+            std::vector<SetIndex> freeSetIndices;
+            // Lock-free stack of recycled sets: pushed by FinishDeallocation, drained
+            // by the owning arena when its free list runs out. -1 terminates the list.
+            std::atomic<int32_t> recycledHead{-1};
+            std::vector<int32_t> recycledNext;
+            // Both guarded by mPoolMutex.
+            bool ownedByArena = false;
+            bool inAvailableList = false;
+        };
+
+        struct ThreadArena {
+            DescriptorPool* pool = nullptr;
+            PoolIndex poolIndex = 0;
+        };
+
+        // A set returned by Deallocate, waiting for the device thread to observe its
+        // serial completed. Nodes form a lock-free singly-linked stack.
+        struct ReturnedAllocation {
+            PoolIndex poolIndex;
+            SetIndex setIndex;
+            Serial serial;
+            ReturnedAllocation* next;
+        };
+
+        ResultOrError<PoolIndex> AllocateDescriptorPool();
+        ThreadArena* GetThreadArena();
+        static void DrainRecycledSets(DescriptorPool* pool);
+        void RecycleSet(PoolIndex poolIndex, SetIndex setIndex);
 
         BindGroupLayout* mLayout;
+        // Never-reused id for the per-thread arena cache, so a stale cache entry from
+        // a destroyed allocator cannot alias a new allocator at the same address.
+        uint64_t mAllocatorId;
 
         std::vector<VkDescriptorPoolSize> mPoolSizes;
         SetIndex mMaxSets;
 
-        struct DescriptorPool {
-            VkDescriptorPool vkPool;
-            std::vector<VkDescriptorSet> sets;
-            std::vector<SetIndex> freeSetIndices;
-        };
-
+        // Guards pool creation, the shared available-pool list, pool ownership flags
+        // and arena registration. Only taken on slow paths.
+        std::mutex mPoolMutex;
+        std::vector<std::unique_ptr<DescriptorPool>> mDescriptorPools;
         std::vector<PoolIndex> mAvailableDescriptorPoolIndices;
-        std::vector<DescriptorPool> mDescriptorPools;
+        std::vector<std::unique_ptr<ThreadArena>> mArenas;
+
+        // The lock-free return path.
+        std::atomic<ReturnedAllocation*> mReturnedAllocations{nullptr};
+        std::atomic<Serial> mLastDeallocationSerial{0};
 
         struct Deallocation {
             PoolIndex poolIndex;
             SetIndex setIndex;
         };
+        // Only touched on the device thread, in FinishDeallocation.
         SerialQueue<Deallocation> mPendingDeallocations;
-        Serial mLastDeallocationSerial = 0;
     };
 
 }}  // namespace dawn_native::vulkan
@@ -16,6 +16,7 @@
 
 #include "common/Platform.h"
 #include "dawn_native/BackendConnection.h"
+#include "dawn_native/CommandBuffer.h"
 #include "dawn_native/Commands.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/ErrorData.h"
@@ -24,24 +25,31 @@
 #include "dawn_native/vulkan/BackendVk.h"
 #include "dawn_native/vulkan/BindGroupLayoutVk.h"
 #include "dawn_native/vulkan/BindGroupVk.h"
+#include "dawn_native/vulkan/BufferSlabAllocatorVk.h"
 #include "dawn_native/vulkan/BufferVk.h"
 #include "dawn_native/vulkan/CommandBufferVk.h"
 #include "dawn_native/vulkan/ComputePipelineVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/PipelineLayoutVk.h"
+#include "dawn_native/vulkan/QuerySetVk.h"
 #include "dawn_native/vulkan/QueueVk.h"
 #include "dawn_native/vulkan/RayTracingAccelerationContainerVk.h"
 #include "dawn_native/vulkan/RayTracingPipelineVk.h"
 #include "dawn_native/vulkan/RayTracingShaderBindingTableVk.h"
 #include "dawn_native/vulkan/RenderPassCache.h"
 #include "dawn_native/vulkan/RenderPipelineVk.h"
+#include "dawn_native/vulkan/ResourceHeapVk.h"
 #include "dawn_native/vulkan/ResourceMemoryAllocatorVk.h"
 #include "dawn_native/vulkan/SamplerVk.h"
+#include "dawn_native/vulkan/ScratchBufferPool.h"
 #include "dawn_native/vulkan/ShaderModuleVk.h"
 #include "dawn_native/vulkan/StagingBufferVk.h"
 #include "dawn_native/vulkan/SwapChainVk.h"
 #include "dawn_native/vulkan/TextureVk.h"
+#include "dawn_native/vulkan/UtilsVulkan.h"
 #include "dawn_native/vulkan/VulkanError.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 namespace dawn_native { namespace vulkan {
 
@@ -53,7 +61,7 @@ namespace dawn_native { namespace vulkan {
     }
 
     Device::Device(Adapter* adapter, const DeviceDescriptor* descriptor)
-        : DeviceBase(adapter, descriptor) {
+        : DeviceBase(adapter, descriptor), mTextureViewAllocator(4096) {
         InitTogglesFromDriver();
     }
 
@@ -87,10 +95,33 @@ namespace dawn_native { namespace vulkan {
 
         mRenderPassCache = std::make_unique<RenderPassCache>(this);
         mResourceMemoryAllocator = std::make_unique<ResourceMemoryAllocator>(this);
+        mScratchBufferPool = std::make_unique<ScratchBufferPool>(this);
+        mBufferSlabAllocator = std::make_unique<BufferSlabAllocator>(this);
 
         mExternalMemoryService = std::make_unique<external_memory::Service>(this);
         mExternalSemaphoreService = std::make_unique<external_semaphore::Service>(this);
 
+        DAWN_TRY(CreatePipelineCache(nullptr, 0));
+
+        // Create the timeline semaphore that backs the serial machinery when the extension is
+        // available. Its initial value of 0 matches the completed serial of a fresh device.
+        if (mDeviceInfo.timelineSemaphore) {
+            VkSemaphoreTypeCreateInfo typeCreateInfo;
+            typeCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+            typeCreateInfo.pNext = nullptr;
+            typeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+            typeCreateInfo.initialValue = 0;
+
+            VkSemaphoreCreateInfo createInfo;
+            createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            createInfo.pNext = &typeCreateInfo;
+            createInfo.flags = 0;
+
+            DAWN_TRY(CheckVkSuccess(
+                fn.CreateSemaphore(mVkDevice, &createInfo, nullptr, &*mTimelineSemaphore),
+                "vkCreateSemaphore"));
+        }
+
         DAWN_TRY(PrepareRecordingContext());
 
         // The environment can request to use D32S8 or D24S8 when it's not available. Override
@@ -140,6 +171,18 @@ namespace dawn_native { namespace vulkan {
         const PipelineLayoutDescriptor* descriptor) {
         return PipelineLayout::Create(this, descriptor);
     }
+    ResultOrError<QuerySetBase*> Device::CreateQuerySetImpl(const QuerySetDescriptor* descriptor) {
+        return QuerySet::Create(this, descriptor);
+    }
+    ResultOrError<QueueBase*> Device::CreateQueueImpl(const QueueDescriptor* descriptor) {
+        // Transfer-class queues get their own VkQueue when the universal family offers a
+        // second one; other queue types share the default queue.
+        if (descriptor->type == wgpu::QueueType::Transfer && mHasTransferQueue) {
+            mTransferQueueUsed = true;
+            return Queue::Create(this, descriptor);
+        }
+        return DeviceBase::CreateQueueImpl(descriptor);
+    }
     ResultOrError<RenderPipelineBase*> Device::CreateRenderPipelineImpl(
         const RenderPipelineDescriptor* descriptor) {
         return RenderPipeline::Create(this, descriptor);
@@ -183,8 +226,12 @@ namespace dawn_native { namespace vulkan {
         mBindGroupLayoutsPendingDeallocation.ClearUpTo(completedSerial);
 
         mResourceMemoryAllocator->Tick(completedSerial);
+        mScratchBufferPool->Tick(completedSerial);
+        mBufferSlabAllocator->Tick(completedSerial);
         mDeleter->Tick(completedSerial);
 
+        ResolveCompletedSubmitTimestamps();
+
         if (mRecordingContext.used) {
             DAWN_TRY(SubmitPendingCommands());
         } else if (completedSerial == GetLastSubmittedCommandSerial()) {
@@ -223,6 +270,111 @@ namespace dawn_native { namespace vulkan {
         return mRenderPassCache.get();
     }
 
+    ScratchBufferPool* Device::GetScratchBufferPool() const {
+        return mScratchBufferPool.get();
+    }
+
+    BufferSlabAllocator* Device::GetBufferSlabAllocator() const {
+        return mBufferSlabAllocator.get();
+    }
+
+    TextureView* Device::AllocateTextureView(TextureBase* texture,
+                                             const TextureViewDescriptor* descriptor) {
+        std::lock_guard<std::mutex> lock(mTextureViewAllocatorMutex);
+        return mTextureViewAllocator.Allocate(texture, descriptor);
+    }
+
+    void Device::DeallocateTextureView(TextureView* view) {
+        std::lock_guard<std::mutex> lock(mTextureViewAllocatorMutex);
+        mTextureViewAllocator.Deallocate(view);
+    }
+
+    VkPipelineCache Device::GetPipelineCache() const {
+        return mPipelineCache;
+    }
+
+    MaybeError Device::CreatePipelineCache(const void* data, size_t size) {
+        VkPipelineCacheCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.initialDataSize = size;
+        createInfo.pInitialData = data;
+
+        return CheckVkSuccess(
+            fn.CreatePipelineCache(mVkDevice, &createInfo, nullptr, &*mPipelineCache),
+            "vkCreatePipelineCache");
+    }
+
+    MaybeError Device::LoadPipelineCacheDataImpl(const void* data, size_t size) {
+        // Create a temporary cache from the blob and merge it into the device cache. The
+        // driver validates the blob's header so data recorded by a different driver
+        // version is rejected instead of corrupting the device cache.
+        VkPipelineCacheCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.initialDataSize = size;
+        createInfo.pInitialData = data;
+
+        VkPipelineCache loadedCache = VK_NULL_HANDLE;
+        DAWN_TRY(
+            CheckVkSuccess(fn.CreatePipelineCache(mVkDevice, &createInfo, nullptr, &*loadedCache),
+                           "vkCreatePipelineCache"));
+
+        MaybeError result =
+            CheckVkSuccess(fn.MergePipelineCaches(mVkDevice, mPipelineCache, 1,
+                                                  AsVkArray(&loadedCache)),
+                           "vkMergePipelineCaches");
+        fn.DestroyPipelineCache(mVkDevice, loadedCache, nullptr);
+        return result;
+    }
+
+    ResultOrError<std::vector<uint8_t>> Device::GetPipelineCacheDataImpl() {
+        size_t dataSize = 0;
+        DAWN_TRY(
+            CheckVkSuccess(fn.GetPipelineCacheData(mVkDevice, mPipelineCache, &dataSize, nullptr),
+                           "vkGetPipelineCacheData"));
+
+        std::vector<uint8_t> data(dataSize);
+        if (dataSize > 0) {
+            DAWN_TRY(CheckVkSuccess(
+                fn.GetPipelineCacheData(mVkDevice, mPipelineCache, &dataSize, data.data()),
+                "vkGetPipelineCacheData"));
+            data.resize(dataSize);
+        }
+        return std::move(data);
+    }
+
+    MemoryBudgetInfo Device::QueryMemoryBudgetImpl() {
+        if (!mDeviceInfo.memoryBudget || fn.GetPhysicalDeviceMemoryProperties2 == nullptr) {
+            return {};
+        }
+
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties;
+        budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+        budgetProperties.pNext = nullptr;
+
+        VkPhysicalDeviceMemoryProperties2 memoryProperties;
+        memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        memoryProperties.pNext = &budgetProperties;
+
+        fn.GetPhysicalDeviceMemoryProperties2(ToBackend(GetAdapter())->GetPhysicalDevice(),
+                                              &memoryProperties);
+
+        // Sum over the device-local heaps; that is the segment textures and buffers are
+        // allocated from and the one streaming systems need to throttle against.
+        MemoryBudgetInfo info;
+        const VkPhysicalDeviceMemoryProperties& properties = memoryProperties.memoryProperties;
+        for (uint32_t heap = 0; heap < properties.memoryHeapCount; ++heap) {
+            if (properties.memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+                info.budget += budgetProperties.heapBudget[heap];
+                info.usage += budgetProperties.heapUsage[heap];
+            }
+        }
+        return info;
+    }
+
     void Device::EnqueueDeferredDeallocation(BindGroupLayout* bindGroupLayout) {
         mBindGroupLayoutsPendingDeallocation.Enqueue(bindGroupLayout, GetPendingCommandSerial());
     }
@@ -233,17 +385,112 @@ namespace dawn_native { namespace vulkan {
         return &mRecordingContext;
     }
 
+    void Device::EnqueuePresent(VkSwapchainKHR swapChain, uint32_t imageIndex) {
+        mPendingPresentSwapChains.push_back(swapChain);
+        mPendingPresentImageIndices.push_back(imageIndex);
+    }
+
+    void Device::FlushPendingPresents() {
+        if (mPendingPresentSwapChains.empty()) {
+            return;
+        }
+
+        // The queue synchronization for the presented images already happened on their own
+        // Present calls, so like NativeSwapChainImpl::Present no semaphores are waited on.
+        VkPresentInfoKHR presentInfo;
+        presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.pNext = nullptr;
+        presentInfo.waitSemaphoreCount = 0;
+        presentInfo.pWaitSemaphores = nullptr;
+        presentInfo.swapchainCount = static_cast<uint32_t>(mPendingPresentSwapChains.size());
+        presentInfo.pSwapchains = AsVkArray(mPendingPresentSwapChains.data());
+        presentInfo.pImageIndices = mPendingPresentImageIndices.data();
+        presentInfo.pResults = nullptr;
+
+        if (fn.QueuePresentKHR(mQueue, &presentInfo) != VK_SUCCESS) {
+            ASSERT(false);
+        }
+
+        mPendingPresentSwapChains.clear();
+        mPendingPresentImageIndices.clear();
+    }
+
+    VkPipeline Device::GetCachedPipelineLibrary(size_t key) const {
+        auto it = mPipelineLibraries.find(key);
+        if (it == mPipelineLibraries.end()) {
+            return VK_NULL_HANDLE;
+        }
+        return it->second;
+    }
+
+    void Device::CachePipelineLibrary(size_t key, VkPipeline library) {
+        ASSERT(library != VK_NULL_HANDLE);
+        ASSERT(mPipelineLibraries.count(key) == 0);
+        mPipelineLibraries[key] = library;
+    }
+
     MaybeError Device::SubmitPendingCommands() {
         if (!mRecordingContext.used) {
             return {};
         }
 
+        if (mArmedSubmitTimestampSlot >= 0) {
+            uint32_t slot = static_cast<uint32_t>(mArmedSubmitTimestampSlot);
+            fn.CmdWriteTimestamp(mRecordingContext.commandBuffer,
+                                 VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, mSubmitTimestampQueryPool,
+                                 2 * slot + 1);
+            mSubmitTimestampsInFlight.Enqueue({slot, GetPendingCommandSerial()},
+                                              GetPendingCommandSerial());
+            mArmedSubmitTimestampSlot = -1;
+        }
+
         DAWN_TRY(CheckVkSuccess(fn.EndCommandBuffer(mRecordingContext.commandBuffer),
                                 "vkEndCommandBuffer"));
 
         std::vector<VkPipelineStageFlags> dstStageMasks(mRecordingContext.waitSemaphores.size(),
                                                         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
 
+        // App-created transfer queues order their copies after the work submitted here by
+        // waiting on this semaphore. It is owned by mTransferWaitSemaphores and deleted
+        // when the next transfer submit consumes it.
+        std::vector<VkSemaphore> signalSemaphores = mRecordingContext.signalSemaphores;
+        if (mTransferQueueUsed) {
+            VkSemaphoreCreateInfo semaphoreCreateInfo;
+            semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            semaphoreCreateInfo.pNext = nullptr;
+            semaphoreCreateInfo.flags = 0;
+
+            VkSemaphore transferSemaphore = VK_NULL_HANDLE;
+            DAWN_TRY(CheckVkSuccess(
+                fn.CreateSemaphore(mVkDevice, &semaphoreCreateInfo, nullptr, &*transferSemaphore),
+                "vkCreateSemaphore"));
+
+            signalSemaphores.push_back(transferSemaphore);
+            mTransferWaitSemaphores.push_back(transferSemaphore);
+        }
+
+        // The background-build queue orders its builds after the work submitted here by
+        // waiting on this semaphore. Only the most recent one is kept: its signal
+        // operation also covers every earlier main-queue command in submission order.
+        if (mHasBackgroundQueue) {
+            VkSemaphoreCreateInfo semaphoreCreateInfo;
+            semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            semaphoreCreateInfo.pNext = nullptr;
+            semaphoreCreateInfo.flags = 0;
+
+            VkSemaphore backgroundSemaphore = VK_NULL_HANDLE;
+            DAWN_TRY(CheckVkSuccess(
+                fn.CreateSemaphore(mVkDevice, &semaphoreCreateInfo, nullptr,
+                                   &*backgroundSemaphore),
+                "vkCreateSemaphore"));
+
+            if (mBackgroundWaitSemaphore != VK_NULL_HANDLE) {
+                mDeleter->DeleteWhenUnused(mBackgroundWaitSemaphore);
+            }
+            signalSemaphores.push_back(backgroundSemaphore);
+            mBackgroundWaitSemaphore = backgroundSemaphore;
+        }
+
         VkSubmitInfo submitInfo;
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
         submitInfo.pNext = nullptr;
@@ -253,12 +500,39 @@ namespace dawn_native { namespace vulkan {
         submitInfo.pWaitDstStageMask = dstStageMasks.data();
         submitInfo.commandBufferCount = 1;
         submitInfo.pCommandBuffers = &mRecordingContext.commandBuffer;
-        submitInfo.signalSemaphoreCount =
-            static_cast<uint32_t>(mRecordingContext.signalSemaphores.size());
-        submitInfo.pSignalSemaphores = AsVkArray(mRecordingContext.signalSemaphores.data());
-
+        submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
+        submitInfo.pSignalSemaphores = AsVkArray(signalSemaphores.data());
+
+        // When VK_KHR_timeline_semaphore is available a single monotonically increasing
+        // semaphore tracks completion: each submit signals it with the serial of its commands
+        // and CheckAndUpdateCompletedSerials reads the counter back, so no fence is needed.
+        VkTimelineSemaphoreSubmitInfo timelineSubmitInfo;
+        std::vector<uint64_t> waitSemaphoreValues;
+        std::vector<uint64_t> signalSemaphoreValues;
         VkFence fence = VK_NULL_HANDLE;
-        DAWN_TRY_ASSIGN(fence, GetUnusedFence());
+        if (mTimelineSemaphore != VK_NULL_HANDLE) {
+            signalSemaphores.push_back(mTimelineSemaphore);
+
+            // Binary semaphores must use a value of 0 in the value arrays.
+            waitSemaphoreValues.resize(mRecordingContext.waitSemaphores.size(), 0);
+            signalSemaphoreValues.resize(signalSemaphores.size(), 0);
+            signalSemaphoreValues.back() = GetPendingCommandSerial();
+
+            timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            timelineSubmitInfo.pNext = nullptr;
+            timelineSubmitInfo.waitSemaphoreValueCount =
+                static_cast<uint32_t>(waitSemaphoreValues.size());
+            timelineSubmitInfo.pWaitSemaphoreValues = waitSemaphoreValues.data();
+            timelineSubmitInfo.signalSemaphoreValueCount =
+                static_cast<uint32_t>(signalSemaphoreValues.size());
+            timelineSubmitInfo.pSignalSemaphoreValues = signalSemaphoreValues.data();
+
+            submitInfo.pNext = &timelineSubmitInfo;
+            submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
+            submitInfo.pSignalSemaphores = AsVkArray(signalSemaphores.data());
+        } else {
+            DAWN_TRY_ASSIGN(fence, GetUnusedFence());
+        }
         DAWN_TRY(CheckVkSuccess(fn.QueueSubmit(mQueue, 1, &submitInfo, fence), "vkQueueSubmit"));
 
         // Enqueue the semaphores before incrementing the serial, so that they can be deleted as
@@ -272,7 +546,9 @@ namespace dawn_native { namespace vulkan {
 
         IncrementLastSubmittedCommandSerial();
         Serial lastSubmittedSerial = GetLastSubmittedCommandSerial();
-        mFencesInFlight.emplace(fence, lastSubmittedSerial);
+        if (fence != VK_NULL_HANDLE) {
+            mFencesInFlight.emplace(fence, lastSubmittedSerial);
+        }
 
         CommandPoolAndBuffer submittedCommands = {mRecordingContext.commandPool,
                                                   mRecordingContext.commandBuffer};
@@ -283,6 +559,234 @@ namespace dawn_native { namespace vulkan {
         return {};
     }
 
+    bool Device::HasBackgroundQueue() const {
+        return mHasBackgroundQueue;
+    }
+
+    ResultOrError<CommandRecordingContext*> Device::GetBackgroundRecordingContext() {
+        ASSERT(mHasBackgroundQueue);
+
+        // The background recording context is created lazily so devices that never build
+        // acceleration containers don't pay for an extra command pool.
+        if (mBackgroundRecordingContext.commandBuffer == VK_NULL_HANDLE) {
+            // First try to recycle unused background command pools.
+            if (!mUnusedBackgroundCommands.empty()) {
+                CommandPoolAndBuffer commands = mUnusedBackgroundCommands.back();
+                mUnusedBackgroundCommands.pop_back();
+                DAWN_TRY(CheckVkSuccess(fn.ResetCommandPool(mVkDevice, commands.pool, 0),
+                                        "vkResetCommandPool"));
+
+                mBackgroundRecordingContext.commandBuffer = commands.commandBuffer;
+                mBackgroundRecordingContext.commandPool = commands.pool;
+            } else {
+                VkCommandPoolCreateInfo createInfo;
+                createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+                createInfo.pNext = nullptr;
+                createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+                createInfo.queueFamilyIndex = mBackgroundQueueFamily;
+
+                DAWN_TRY(
+                    CheckVkSuccess(fn.CreateCommandPool(mVkDevice, &createInfo, nullptr,
+                                                        &*mBackgroundRecordingContext.commandPool),
+                                   "vkCreateCommandPool"));
+
+                VkCommandBufferAllocateInfo allocateInfo;
+                allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+                allocateInfo.pNext = nullptr;
+                allocateInfo.commandPool = mBackgroundRecordingContext.commandPool;
+                allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+                allocateInfo.commandBufferCount = 1;
+
+                DAWN_TRY(CheckVkSuccess(
+                    fn.AllocateCommandBuffers(mVkDevice, &allocateInfo,
+                                              &mBackgroundRecordingContext.commandBuffer),
+                    "vkAllocateCommandBuffers"));
+            }
+
+            VkCommandBufferBeginInfo beginInfo;
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.pNext = nullptr;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            beginInfo.pInheritanceInfo = nullptr;
+
+            DAWN_TRY(CheckVkSuccess(
+                fn.BeginCommandBuffer(mBackgroundRecordingContext.commandBuffer, &beginInfo),
+                "vkBeginCommandBuffer"));
+        }
+
+        mBackgroundRecordingContext.used = true;
+        return &mBackgroundRecordingContext;
+    }
+
+    MaybeError Device::SubmitBackgroundCommands() {
+        if (!mBackgroundRecordingContext.used) {
+            return {};
+        }
+
+        DAWN_TRY(CheckVkSuccess(fn.EndCommandBuffer(mBackgroundRecordingContext.commandBuffer),
+                                "vkEndCommandBuffer"));
+
+        // The next main-queue submit waits on this semaphore so that work submitted there
+        // is ordered after the background builds.
+        VkSemaphoreCreateInfo semaphoreCreateInfo;
+        semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreCreateInfo.pNext = nullptr;
+        semaphoreCreateInfo.flags = 0;
+
+        VkSemaphore semaphore = VK_NULL_HANDLE;
+        DAWN_TRY(CheckVkSuccess(
+            fn.CreateSemaphore(mVkDevice, &semaphoreCreateInfo, nullptr, &*semaphore),
+            "vkCreateSemaphore"));
+
+        // The builds wait on the semaphore signaled by the latest main-queue submit so
+        // they are ordered after the work that produced their vertex and instance data.
+        VkPipelineStageFlags waitDstStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+        VkSubmitInfo submitInfo;
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext = nullptr;
+        submitInfo.waitSemaphoreCount = mBackgroundWaitSemaphore != VK_NULL_HANDLE ? 1 : 0;
+        submitInfo.pWaitSemaphores = AsVkArray(&mBackgroundWaitSemaphore);
+        submitInfo.pWaitDstStageMask = &waitDstStageMask;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &mBackgroundRecordingContext.commandBuffer;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = AsVkArray(&semaphore);
+
+        DAWN_TRY(CheckVkSuccess(fn.QueueSubmit(mBackgroundQueue, 1, &submitInfo, VK_NULL_HANDLE),
+                                "vkQueueSubmit"));
+
+        if (mBackgroundWaitSemaphore != VK_NULL_HANDLE) {
+            mDeleter->DeleteWhenUnused(mBackgroundWaitSemaphore);
+            mBackgroundWaitSemaphore = VK_NULL_HANDLE;
+        }
+
+        mRecordingContext.waitSemaphores.push_back(semaphore);
+
+        // Because the main queue waits on the semaphore, the background commands are done
+        // executing once the pending serial completes; recycle them against that serial.
+        CommandPoolAndBuffer submittedCommands = {mBackgroundRecordingContext.commandPool,
+                                                  mBackgroundRecordingContext.commandBuffer};
+        mBackgroundCommandsInFlight.Enqueue(submittedCommands, GetPendingCommandSerial());
+        mBackgroundRecordingContext = CommandRecordingContext();
+
+        return {};
+    }
+
+    bool Device::HasTransferQueue() const {
+        return mHasTransferQueue;
+    }
+
+    ResultOrError<CommandRecordingContext*> Device::GetTransferRecordingContext() {
+        ASSERT(mHasTransferQueue);
+
+        // The transfer recording context is created lazily so devices that never create a
+        // transfer-class queue don't pay for an extra command pool. The transfer queue is
+        // on the universal family, so its pools can be recycled through mUnusedCommands.
+        if (mTransferRecordingContext.commandBuffer == VK_NULL_HANDLE) {
+            if (!mUnusedCommands.empty()) {
+                CommandPoolAndBuffer commands = mUnusedCommands.back();
+                mUnusedCommands.pop_back();
+                DAWN_TRY(CheckVkSuccess(fn.ResetCommandPool(mVkDevice, commands.pool, 0),
+                                        "vkResetCommandPool"));
+
+                mTransferRecordingContext.commandBuffer = commands.commandBuffer;
+                mTransferRecordingContext.commandPool = commands.pool;
+            } else {
+                VkCommandPoolCreateInfo createInfo;
+                createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+                createInfo.pNext = nullptr;
+                createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+                createInfo.queueFamilyIndex = mQueueFamily;
+
+                DAWN_TRY(
+                    CheckVkSuccess(fn.CreateCommandPool(mVkDevice, &createInfo, nullptr,
+                                                        &*mTransferRecordingContext.commandPool),
+                                   "vkCreateCommandPool"));
+
+                VkCommandBufferAllocateInfo allocateInfo;
+                allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+                allocateInfo.pNext = nullptr;
+                allocateInfo.commandPool = mTransferRecordingContext.commandPool;
+                allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+                allocateInfo.commandBufferCount = 1;
+
+                DAWN_TRY(CheckVkSuccess(
+                    fn.AllocateCommandBuffers(mVkDevice, &allocateInfo,
+                                              &mTransferRecordingContext.commandBuffer),
+                    "vkAllocateCommandBuffers"));
+            }
+
+            VkCommandBufferBeginInfo beginInfo;
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.pNext = nullptr;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            beginInfo.pInheritanceInfo = nullptr;
+
+            DAWN_TRY(CheckVkSuccess(
+                fn.BeginCommandBuffer(mTransferRecordingContext.commandBuffer, &beginInfo),
+                "vkBeginCommandBuffer"));
+        }
+
+        mTransferRecordingContext.used = true;
+        return &mTransferRecordingContext;
+    }
+
+    MaybeError Device::SubmitTransferCommands() {
+        if (!mTransferRecordingContext.used) {
+            return {};
+        }
+
+        DAWN_TRY(CheckVkSuccess(fn.EndCommandBuffer(mTransferRecordingContext.commandBuffer),
+                                "vkEndCommandBuffer"));
+
+        // The copies wait on the semaphores signaled by earlier main-queue submits so
+        // they see the results of the work they depend on, and the next main-queue
+        // submit waits on this semaphore so work submitted there is ordered after them.
+        VkSemaphoreCreateInfo semaphoreCreateInfo;
+        semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreCreateInfo.pNext = nullptr;
+        semaphoreCreateInfo.flags = 0;
+
+        VkSemaphore semaphore = VK_NULL_HANDLE;
+        DAWN_TRY(CheckVkSuccess(
+            fn.CreateSemaphore(mVkDevice, &semaphoreCreateInfo, nullptr, &*semaphore),
+            "vkCreateSemaphore"));
+
+        std::vector<VkPipelineStageFlags> dstStageMasks(mTransferWaitSemaphores.size(),
+                                                        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
+        VkSubmitInfo submitInfo;
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext = nullptr;
+        submitInfo.waitSemaphoreCount = static_cast<uint32_t>(mTransferWaitSemaphores.size());
+        submitInfo.pWaitSemaphores = AsVkArray(mTransferWaitSemaphores.data());
+        submitInfo.pWaitDstStageMask = dstStageMasks.data();
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &mTransferRecordingContext.commandBuffer;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = AsVkArray(&semaphore);
+
+        DAWN_TRY(CheckVkSuccess(fn.QueueSubmit(mTransferQueue, 1, &submitInfo, VK_NULL_HANDLE),
+                                "vkQueueSubmit"));
+
+        for (VkSemaphore waitSemaphore : mTransferWaitSemaphores) {
+            mDeleter->DeleteWhenUnused(waitSemaphore);
+        }
+        mTransferWaitSemaphores.clear();
+
+        mRecordingContext.waitSemaphores.push_back(semaphore);
+
+        // Because the main queue waits on the semaphore, the transfer commands are done
+        // executing once the pending serial completes; recycle them against that serial.
+        CommandPoolAndBuffer submittedCommands = {mTransferRecordingContext.commandPool,
+                                                  mTransferRecordingContext.commandBuffer};
+        mTransferCommandsInFlight.Enqueue(submittedCommands, GetPendingCommandSerial());
+        mTransferRecordingContext = CommandRecordingContext();
+
+        return {};
+    }
+
     ResultOrError<VulkanDeviceKnobs> Device::CreateDevice(VkPhysicalDevice physicalDevice) {
         VulkanDeviceKnobs usedKnobs = {};
 
@@ -307,6 +811,10 @@ namespace dawn_native { namespace vulkan {
             extensionsToRequest.push_back(kExtensionNameExtExternalMemoryDmaBuf);
             usedKnobs.externalMemoryDmaBuf = true;
         }
+        if (mDeviceInfo.externalMemoryHost) {
+            extensionsToRequest.push_back(kExtensionNameExtExternalMemoryHost);
+            usedKnobs.externalMemoryHost = true;
+        }
         if (mDeviceInfo.imageDrmFormatModifier) {
             extensionsToRequest.push_back(kExtensionNameExtImageDrmFormatModifier);
             usedKnobs.imageDrmFormatModifier = true;
@@ -335,6 +843,22 @@ namespace dawn_native { namespace vulkan {
             extensionsToRequest.push_back(kExtensionNameKhrMaintenance1);
             usedKnobs.maintenance1 = true;
         }
+        if (mDeviceInfo.descriptorUpdateTemplate) {
+            extensionsToRequest.push_back(kExtensionNameKhrDescriptorUpdateTemplate);
+            usedKnobs.descriptorUpdateTemplate = true;
+        }
+        if (mDeviceInfo.drawIndirectCount) {
+            extensionsToRequest.push_back(kExtensionNameKhrDrawIndirectCount);
+            usedKnobs.drawIndirectCount = true;
+        }
+        if (mDeviceInfo.timelineSemaphore) {
+            extensionsToRequest.push_back(kExtensionNameKhrTimelineSemaphore);
+            usedKnobs.timelineSemaphore = true;
+        }
+        if (mDeviceInfo.memoryBudget) {
+            extensionsToRequest.push_back(kExtensionNameExtMemoryBudget);
+            usedKnobs.memoryBudget = true;
+        }
         if (mDeviceInfo.rayTracingKHR) {
             extensionsToRequest.push_back(kExtensionNameKhrRayTracing);
             usedKnobs.rayTracingKHR = true;
@@ -343,6 +867,11 @@ namespace dawn_native { namespace vulkan {
             extensionsToRequest.push_back(kExtensionNameKhrGetMemoryRequirements2);
             usedKnobs.memoryRequirements2 = true;
         }
+        // VK_KHR_dedicated_allocation requires VK_KHR_get_memory_requirements2.
+        if (mDeviceInfo.dedicatedAllocation && mDeviceInfo.memoryRequirements2) {
+            extensionsToRequest.push_back(kExtensionNameKhrDedicatedAllocation);
+            usedKnobs.dedicatedAllocation = true;
+        }
         if (mDeviceInfo.descriptorIndexing) {
             extensionsToRequest.push_back(kExtensionNameExtDescriptorIndexing);
             usedKnobs.descriptorIndexing = true;
@@ -384,6 +913,13 @@ namespace dawn_native { namespace vulkan {
             usedKnobs.rayTracingKHR = true;
         }
 
+        if (IsExtensionEnabled(Extension::RayQuery)) {
+            ASSERT(ToBackend(GetAdapter())->GetDeviceInfo().rayTracingKHR == true);
+            ASSERT(ToBackend(GetAdapter())->GetDeviceInfo().rayTracingFeatures.rayQuery == VK_TRUE);
+            usedKnobs.rayTracingKHR = true;
+            usedKnobs.rayTracingFeatures.rayQuery = VK_TRUE;
+        }
+
         if (IsExtensionEnabled(Extension::ShaderFloat16)) {
             const VulkanDeviceInfo& deviceInfo = ToBackend(GetAdapter())->GetDeviceInfo();
             ASSERT(deviceInfo.shaderFloat16Int8 &&
@@ -422,7 +958,35 @@ namespace dawn_native { namespace vulkan {
             mQueueFamily = static_cast<uint32_t>(universalQueueFamily);
         }
 
-        // Choose to create a single universal queue
+        // Find a queue for background acceleration container builds. It must be a second
+        // queue on the universal family: the buffers the builds read are created with
+        // EXCLUSIVE sharing so a different family would need queue family ownership
+        // transfers, and the graphics stage masks baked into build barriers (e.g.
+        // VERTEX_INPUT) are invalid on a compute-only queue.
+        if (IsExtensionEnabled(Extension::RayTracing) &&
+            mDeviceInfo.queueFamilies[mQueueFamily].queueCount >= 2) {
+            mHasBackgroundQueue = true;
+            mBackgroundQueueFamily = mQueueFamily;
+            mBackgroundQueueIndex = 1;
+        }
+
+        // A further queue on the universal family backs app-created transfer-class
+        // queues. Staying on the universal family avoids queue family ownership
+        // transfers for the resources the copies touch.
+        {
+            uint32_t universalQueueCount = 1;
+            if (mHasBackgroundQueue) {
+                universalQueueCount++;
+            }
+            if (mDeviceInfo.queueFamilies[mQueueFamily].queueCount > universalQueueCount) {
+                mHasTransferQueue = true;
+                mTransferQueueIndex = universalQueueCount;
+            }
+        }
+
+        // Choose to create a single universal queue, plus the background-build and
+        // transfer queues when they were found.
+        float queuePriorities[3] = {zero, zero, zero};
         {
             VkDeviceQueueCreateInfo queueCreateInfo;
             queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
@@ -430,7 +994,14 @@ namespace dawn_native { namespace vulkan {
             queueCreateInfo.flags = 0;
             queueCreateInfo.queueFamilyIndex = static_cast<uint32_t>(mQueueFamily);
             queueCreateInfo.queueCount = 1;
-            queueCreateInfo.pQueuePriorities = &zero;
+            queueCreateInfo.pQueuePriorities = queuePriorities;
+
+            if (mHasBackgroundQueue) {
+                queueCreateInfo.queueCount = 2;
+            }
+            if (mHasTransferQueue) {
+                queueCreateInfo.queueCount = mTransferQueueIndex + 1;
+            }
 
             queuesToRequest.push_back(queueCreateInfo);
         }
@@ -456,13 +1027,33 @@ namespace dawn_native { namespace vulkan {
         deviceVulkan12Features.pNext = nullptr;
 
         // Enable device extensions for RT
-        if (IsExtensionEnabled(Extension::RayTracing)) {
-            deviceRayTracingFeatures.rayTracing = VK_TRUE;
+        if (IsExtensionEnabled(Extension::RayTracing) || IsExtensionEnabled(Extension::RayQuery)) {
+            if (IsExtensionEnabled(Extension::RayTracing)) {
+                deviceRayTracingFeatures.rayTracing = VK_TRUE;
+            }
+            if (IsExtensionEnabled(Extension::RayQuery)) {
+                deviceRayTracingFeatures.rayQuery = VK_TRUE;
+            }
             deviceVulkan12Features.bufferDeviceAddress = VK_TRUE;
             deviceVulkan12Features.pNext = &deviceRayTracingFeatures;
             createInfo.pNext = &deviceVulkan12Features;
         }
 
+        // Enable the descriptor indexing features used by binding arrays.
+        if (mDeviceInfo.descriptorIndexing) {
+            deviceVulkan12Features.descriptorIndexing = VK_TRUE;
+            deviceVulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+            deviceVulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+            deviceVulkan12Features.runtimeDescriptorArray = VK_TRUE;
+            createInfo.pNext = &deviceVulkan12Features;
+        }
+
+        // Enable timeline semaphores so submit completion can be tracked without fences.
+        if (mDeviceInfo.timelineSemaphore) {
+            deviceVulkan12Features.timelineSemaphore = VK_TRUE;
+            createInfo.pNext = &deviceVulkan12Features;
+        }
+
         DAWN_TRY(CheckVkSuccess(fn.CreateDevice(physicalDevice, &createInfo, nullptr, &mVkDevice),
                                 "vkCreateDevice"));
 
@@ -471,6 +1062,13 @@ namespace dawn_native { namespace vulkan {
 
     void Device::GatherQueueFromDevice() {
         fn.GetDeviceQueue(mVkDevice, mQueueFamily, 0, &mQueue);
+        if (mHasBackgroundQueue) {
+            fn.GetDeviceQueue(mVkDevice, mBackgroundQueueFamily, mBackgroundQueueIndex,
+                              &mBackgroundQueue);
+        }
+        if (mHasTransferQueue) {
+            fn.GetDeviceQueue(mVkDevice, mQueueFamily, mTransferQueueIndex, &mTransferQueue);
+        }
     }
 
     void Device::InitTogglesFromDriver() {
@@ -539,6 +1137,19 @@ namespace dawn_native { namespace vulkan {
     }
 
     Serial Device::CheckAndUpdateCompletedSerials() {
+        // With a timeline semaphore the completed serial is simply the semaphore's counter:
+        // each submit signals it with its own serial, so a single read replaces polling a
+        // fence per in-flight submit.
+        if (mTimelineSemaphore != VK_NULL_HANDLE) {
+            uint64_t completedSerial = 0;
+            VkResult result = VkResult::WrapUnsafe(INJECT_ERROR_OR_RUN(
+                fn.GetSemaphoreCounterValueKHR(mVkDevice, mTimelineSemaphore, &completedSerial),
+                VK_ERROR_DEVICE_LOST));
+            // TODO: Handle DeviceLost error.
+            ASSERT(result == VK_SUCCESS);
+            return completedSerial;
+        }
+
         Serial fenceSerial = 0;
         while (!mFencesInFlight.empty()) {
             VkFence fence = mFencesInFlight.front().first;
@@ -564,6 +1175,31 @@ namespace dawn_native { namespace vulkan {
         return fenceSerial;
     }
 
+    bool Device::WaitForCompletedWorkImpl(uint64_t timeoutNanoseconds) {
+        // With a timeline semaphore, wait for it to advance past the last serial Tick saw.
+        if (mTimelineSemaphore != VK_NULL_HANDLE) {
+            uint64_t waitValue = static_cast<uint64_t>(GetCompletedCommandSerial()) + 1;
+
+            VkSemaphoreWaitInfo waitInfo;
+            waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+            waitInfo.pNext = nullptr;
+            waitInfo.flags = 0;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &*mTimelineSemaphore;
+            waitInfo.pValues = &waitValue;
+
+            return fn.WaitSemaphoresKHR(mVkDevice, &waitInfo, timeoutNanoseconds) == VK_SUCCESS;
+        }
+
+        // Otherwise wait on the oldest in-flight fence: fences are submitted in order so its
+        // completion is exactly when CheckAndUpdateCompletedSerials can advance.
+        if (mFencesInFlight.empty()) {
+            return true;
+        }
+        VkFence fence = mFencesInFlight.front().first;
+        return fn.WaitForFences(mVkDevice, 1, &*fence, true, timeoutNanoseconds) == VK_SUCCESS;
+    }
+
     MaybeError Device::PrepareRecordingContext() {
         ASSERT(!mRecordingContext.used);
         ASSERT(mRecordingContext.commandBuffer == VK_NULL_HANDLE);
@@ -609,8 +1245,81 @@ namespace dawn_native { namespace vulkan {
         beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
         beginInfo.pInheritanceInfo = nullptr;
 
-        return CheckVkSuccess(fn.BeginCommandBuffer(mRecordingContext.commandBuffer, &beginInfo),
-                              "vkBeginCommandBuffer");
+        DAWN_TRY(CheckVkSuccess(fn.BeginCommandBuffer(mRecordingContext.commandBuffer, &beginInfo),
+                                "vkBeginCommandBuffer"));
+
+        if (IsToggleEnabled(Toggle::TraceGPUSubmitTimings)) {
+            ArmSubmitTimestamps();
+        }
+
+        return {};
+    }
+
+    void Device::ArmSubmitTimestamps() {
+        mArmedSubmitTimestampSlot = -1;
+
+        // Timestamps aren't meaningful on devices that don't support them on the
+        // graphics queue.
+        if (mDeviceInfo.properties.limits.timestampComputeAndGraphics != VK_TRUE ||
+            mDeviceInfo.properties.limits.timestampPeriod == 0.0f) {
+            return;
+        }
+
+        // The pool is created lazily so devices with the toggle off pay nothing; a
+        // creation failure just leaves submissions uninstrumented.
+        if (mSubmitTimestampQueryPool == VK_NULL_HANDLE) {
+            VkQueryPoolCreateInfo createInfo;
+            createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            createInfo.pNext = nullptr;
+            createInfo.flags = 0;
+            createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+            createInfo.queryCount = 2 * kMaxSubmitTimestampsInFlight;
+            createInfo.pipelineStatistics = 0;
+            if (fn.CreateQueryPool(mVkDevice, &createInfo, nullptr, &*mSubmitTimestampQueryPool) !=
+                VK_SUCCESS) {
+                return;
+            }
+        }
+
+        // When every slot is still in flight this submission goes uninstrumented rather
+        // than blocking on readback.
+        if (mSubmitTimestampSlotsInUse == kMaxSubmitTimestampsInFlight) {
+            return;
+        }
+
+        uint32_t slot = mNextSubmitTimestampSlot;
+        mNextSubmitTimestampSlot = (mNextSubmitTimestampSlot + 1) % kMaxSubmitTimestampsInFlight;
+        mSubmitTimestampSlotsInUse++;
+
+        // Queries must be reset on the GPU before reuse; resetting here keeps the whole
+        // query lifecycle inside the submission's own command buffer.
+        fn.CmdResetQueryPool(mRecordingContext.commandBuffer, mSubmitTimestampQueryPool, 2 * slot,
+                             2);
+        fn.CmdWriteTimestamp(mRecordingContext.commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                             mSubmitTimestampQueryPool, 2 * slot);
+        mArmedSubmitTimestampSlot = static_cast<int32_t>(slot);
+    }
+
+    void Device::ResolveCompletedSubmitTimestamps() {
+        Serial completedSerial = GetCompletedCommandSerial();
+        for (const SubmitTimestamps& timestamps :
+             mSubmitTimestampsInFlight.IterateUpTo(completedSerial)) {
+            uint64_t results[2];
+            if (fn.GetQueryPoolResults(mVkDevice, mSubmitTimestampQueryPool, 2 * timestamps.slot,
+                                       2, sizeof(results), results, sizeof(uint64_t),
+                                       VK_QUERY_RESULT_64_BIT) == VK_SUCCESS) {
+                // timestampPeriod is in nanoseconds per timestamp tick.
+                double gpuTimeUs = (results[1] - results[0]) *
+                                   mDeviceInfo.properties.limits.timestampPeriod / 1000.0;
+                // The serial is the same id the DeviceBase::GPUWork async events use, so
+                // trace consumers can join the GPU duration to the submit that caused it.
+                TRACE_EVENT_INSTANT2(GetPlatform(), GPUWork, "QueueVk::SubmitGPUTime",
+                                     "submitSerial", static_cast<uint64_t>(timestamps.serial),
+                                     "gpuTimeUs", gpuTimeUs);
+            }
+            mSubmitTimestampSlotsInUse--;
+        }
+        mSubmitTimestampsInFlight.ClearUpTo(completedSerial);
     }
 
     void Device::RecycleCompletedCommands() {
@@ -618,11 +1327,31 @@ namespace dawn_native { namespace vulkan {
             mUnusedCommands.push_back(commands);
         }
         mCommandsInFlight.ClearUpTo(GetCompletedCommandSerial());
+
+        for (auto& commands : mBackgroundCommandsInFlight.IterateUpTo(GetCompletedCommandSerial())) {
+            mUnusedBackgroundCommands.push_back(commands);
+        }
+        mBackgroundCommandsInFlight.ClearUpTo(GetCompletedCommandSerial());
+
+        // Transfer command pools are on the universal family, so they are recycled into
+        // the main unused list.
+        for (auto& commands : mTransferCommandsInFlight.IterateUpTo(GetCompletedCommandSerial())) {
+            mUnusedCommands.push_back(commands);
+        }
+        mTransferCommandsInFlight.ClearUpTo(GetCompletedCommandSerial());
     }
 
     ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateStagingBuffer(size_t size) {
         std::unique_ptr<StagingBufferBase> stagingBuffer =
-            std::make_unique<StagingBuffer>(size, this);
+            std::make_unique<StagingBuffer>(size, this, StagingAccess::Upload);
+        DAWN_TRY(stagingBuffer->Initialize());
+        return std::move(stagingBuffer);
+    }
+
+    ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateReadbackStagingBuffer(
+        size_t size) {
+        std::unique_ptr<StagingBufferBase> stagingBuffer =
+            std::make_unique<StagingBuffer>(size, this, StagingAccess::Readback);
         DAWN_TRY(stagingBuffer->Initialize());
         return std::move(stagingBuffer);
     }
@@ -646,13 +1375,18 @@ namespace dawn_native { namespace vulkan {
         // used with HOST_COHERENT as vkQueueSubmit does an implicit barrier between host and
         // device. See "Availability, Visibility, and Domain Operations" in Vulkan spec for details.
 
+        // Clear any never-written bytes first so the lazy clear cannot land on top of the
+        // data this copy writes.
+        ToBackend(destination)
+            ->EnsureDataInitializedAsDestination(recordingContext, destinationOffset, size);
+
         // Insert pipeline barrier to ensure correct ordering with previous memory operations on the
         // buffer.
         ToBackend(destination)->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopyDst);
 
         VkBufferCopy copy;
         copy.srcOffset = sourceOffset;
-        copy.dstOffset = destinationOffset;
+        copy.dstOffset = ToBackend(destination)->GetHandleOffset() + destinationOffset;
         copy.size = size;
 
         this->fn.CmdCopyBuffer(recordingContext->commandBuffer,
@@ -662,6 +1396,79 @@ namespace dawn_native { namespace vulkan {
         return {};
     }
 
+    MaybeError Device::CopyFromBufferToStaging(BufferBase* source,
+                                               uint64_t sourceOffset,
+                                               StagingBufferBase* destination,
+                                               uint64_t destinationOffset,
+                                               uint64_t size) {
+        // It is a validation error to do a 0-sized copy in Vulkan skip it since it is a noop.
+        if (size == 0) {
+            return {};
+        }
+
+        CommandRecordingContext* recordingContext = GetPendingRecordingContext();
+
+        // Insert pipeline barrier to ensure correct ordering with previous memory operations on the
+        // buffer.
+        ToBackend(source)->TransitionUsageNow(recordingContext, wgpu::BufferUsage::CopySrc);
+
+        VkBufferCopy copy;
+        copy.srcOffset = ToBackend(source)->GetHandleOffset() + sourceOffset;
+        copy.dstOffset = destinationOffset;
+        copy.size = size;
+
+        this->fn.CmdCopyBuffer(recordingContext->commandBuffer, ToBackend(source)->GetHandle(),
+                               ToBackend(destination)->GetBufferHandle(), 1, &copy);
+
+        // Make the transfer writes available to the host so the CPU can read the results
+        // once a wait on this serial's fence returns.
+        VkMemoryBarrier barrier;
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.pNext = nullptr;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        this->fn.CmdPipelineBarrier(recordingContext->commandBuffer,
+                                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+                                    1, &barrier, 0, nullptr, 0, nullptr);
+
+        return {};
+    }
+
+    MaybeError Device::CopyFromStagingToTexture(StagingBufferBase* source,
+                                                uint64_t sourceOffset,
+                                                uint32_t bytesPerRow,
+                                                uint32_t rowsPerImage,
+                                                const TextureCopy& dst,
+                                                const Extent3D& copySizePixels) {
+        CommandRecordingContext* recordingContext = GetPendingRecordingContext();
+
+        VkBufferImageCopy region = ComputeBufferImageCopyRegion(sourceOffset, bytesPerRow,
+                                                                rowsPerImage, dst, copySizePixels);
+        VkImageSubresourceLayers subresource = region.imageSubresource;
+
+        if (IsCompleteSubresourceCopiedTo(dst.texture.Get(), copySizePixels,
+                                          subresource.mipLevel)) {
+            // Since the texture is overwritten entirely, it is now "initialized".
+            dst.texture->SetIsSubresourceContentInitialized(true, subresource.mipLevel, 1,
+                                                            subresource.baseArrayLayer, 1);
+        } else {
+            ToBackend(dst.texture)
+                ->EnsureSubresourceContentInitialized(recordingContext, subresource.mipLevel, 1,
+                                                      subresource.baseArrayLayer, 1);
+        }
+
+        ToBackend(dst.texture)
+            ->TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopyDst,
+                                 subresource.mipLevel, 1, subresource.baseArrayLayer, 1);
+
+        this->fn.CmdCopyBufferToImage(recordingContext->commandBuffer,
+                                      ToBackend(source)->GetBufferHandle(),
+                                      ToBackend(dst.texture)->GetHandle(),
+                                      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        return {};
+    }
+
     MaybeError Device::ImportExternalImage(const ExternalImageDescriptor* descriptor,
                                            ExternalMemoryHandle memoryHandle,
                                            VkImage image,
@@ -697,12 +1504,19 @@ namespace dawn_native { namespace vulkan {
                         mExternalMemoryService->ImportMemory(memoryHandle, importParams, image));
 
         // Import semaphores we have to wait on before using the texture
+        DAWN_TRY(ImportExternalSemaphores(waitHandles, outWaitSemaphores));
+
+        return {};
+    }
+
+    MaybeError Device::ImportExternalSemaphores(
+        const std::vector<ExternalSemaphoreHandle>& waitHandles,
+        std::vector<VkSemaphore>* outWaitSemaphores) {
         for (const ExternalSemaphoreHandle& handle : waitHandles) {
             VkSemaphore semaphore = VK_NULL_HANDLE;
             DAWN_TRY_ASSIGN(semaphore, mExternalSemaphoreService->ImportSemaphore(handle));
             outWaitSemaphores->push_back(semaphore);
         }
-
         return {};
     }
 
@@ -773,17 +1587,260 @@ namespace dawn_native { namespace vulkan {
         return result;
     }
 
+    TextureBase* Device::CreateExportableTexture(const TextureDescriptor* descriptor,
+                                                 ExternalMemoryHandle* outMemoryHandle,
+                                                 uint64_t* outAllocationSize,
+                                                 uint32_t* outMemoryTypeIndex) {
+        // Initial validation
+        if (ConsumedError(ValidateTextureDescriptor(this, descriptor))) {
+            return nullptr;
+        }
+        if (ConsumedError(ValidateVulkanImageCanBeWrapped(this, descriptor))) {
+            return nullptr;
+        }
+        if (!mExternalMemoryService->Supported() || !mExternalSemaphoreService->Supported()) {
+            ConsumedError(DAWN_VALIDATION_ERROR("External memory usage not supported"));
+            return nullptr;
+        }
+
+        VkSemaphore signalSemaphore = VK_NULL_HANDLE;
+        VkDeviceSize allocationSize = 0;
+
+        Texture* result = nullptr;
+        if (ConsumedError(mExternalSemaphoreService->CreateExportableSemaphore(),
+                          &signalSemaphore) ||
+            ConsumedError(Texture::CreateExportable(this, descriptor, mExternalMemoryService.get(),
+                                                    signalSemaphore, outMemoryHandle,
+                                                    &allocationSize, outMemoryTypeIndex),
+                          &result)) {
+            // The texture only acquires the semaphore once fully initialized.
+            if (result != nullptr) {
+                result->Release();
+            }
+            fn.DestroySemaphore(GetVkDevice(), signalSemaphore, nullptr);
+            return nullptr;
+        }
+
+        *outAllocationSize = allocationSize;
+        return result;
+    }
+
+    BufferBase* Device::CreateBufferWrappingVulkanMemory(
+        const BufferDescriptor* descriptor,
+        ExternalMemoryHandle memoryHandle,
+        uint64_t allocationSize,
+        uint32_t memoryTypeIndex,
+        const std::vector<ExternalSemaphoreHandle>& waitHandles) {
+        // Initial validation
+        if (ConsumedError(ValidateBufferDescriptor(this, descriptor))) {
+            return nullptr;
+        }
+        if (!mExternalMemoryService->Supported() || !mExternalSemaphoreService->Supported()) {
+            ConsumedError(DAWN_VALIDATION_ERROR("External memory usage not supported"));
+            return nullptr;
+        }
+
+        VkSemaphore signalSemaphore = VK_NULL_HANDLE;
+        std::vector<VkSemaphore> waitSemaphores;
+        waitSemaphores.reserve(waitHandles.size());
+
+        // Cleanup in case of a failure: the buffer only acquires the external objects once
+        // fully initialized.
+        Buffer* result = nullptr;
+        if (ConsumedError(mExternalSemaphoreService->CreateExportableSemaphore(),
+                          &signalSemaphore) ||
+            ConsumedError(ImportExternalSemaphores(waitHandles, &waitSemaphores)) ||
+            ConsumedError(Buffer::CreateFromExternalMemory(
+                              this, descriptor, mExternalMemoryService.get(), memoryHandle,
+                              allocationSize, memoryTypeIndex, waitSemaphores, signalSemaphore),
+                          &result)) {
+            if (result != nullptr) {
+                result->Release();
+            }
+
+            fn.DestroySemaphore(GetVkDevice(), signalSemaphore, nullptr);
+
+            for (VkSemaphore semaphore : waitSemaphores) {
+                fn.DestroySemaphore(GetVkDevice(), semaphore, nullptr);
+            }
+            return nullptr;
+        }
+
+        return result;
+    }
+
+    BufferBase* Device::CreateExportableBuffer(const BufferDescriptor* descriptor,
+                                               ExternalMemoryHandle* outMemoryHandle,
+                                               uint64_t* outAllocationSize,
+                                               uint32_t* outMemoryTypeIndex) {
+        // Initial validation
+        if (ConsumedError(ValidateBufferDescriptor(this, descriptor))) {
+            return nullptr;
+        }
+        if (!mExternalMemoryService->Supported() || !mExternalSemaphoreService->Supported()) {
+            ConsumedError(DAWN_VALIDATION_ERROR("External memory usage not supported"));
+            return nullptr;
+        }
+
+        VkSemaphore signalSemaphore = VK_NULL_HANDLE;
+        VkDeviceSize allocationSize = 0;
+
+        Buffer* result = nullptr;
+        if (ConsumedError(mExternalSemaphoreService->CreateExportableSemaphore(),
+                          &signalSemaphore) ||
+            ConsumedError(Buffer::CreateExportable(this, descriptor, mExternalMemoryService.get(),
+                                                   signalSemaphore, outMemoryHandle,
+                                                   &allocationSize, outMemoryTypeIndex),
+                          &result)) {
+            if (result != nullptr) {
+                result->Release();
+            }
+            fn.DestroySemaphore(GetVkDevice(), signalSemaphore, nullptr);
+            return nullptr;
+        }
+
+        *outAllocationSize = allocationSize;
+        return result;
+    }
+
+    BufferBase* Device::CreateBufferWrappingHostMemory(const BufferDescriptor* descriptor,
+                                                       void* hostPointer,
+                                                       uint64_t allocationSize) {
+        // Initial validation
+        if (ConsumedError(ValidateBufferDescriptor(this, descriptor))) {
+            return nullptr;
+        }
+
+        Buffer* result = nullptr;
+        if (ConsumedError(
+                Buffer::CreateFromHostPointer(this, descriptor, hostPointer, allocationSize),
+                &result)) {
+            if (result != nullptr) {
+                result->Release();
+            }
+            return nullptr;
+        }
+        return result;
+    }
+
+    MaybeError Device::SignalAndExportExternalBuffer(Buffer* buffer,
+                                                     ExternalSemaphoreHandle* outHandle) {
+        DAWN_TRY(ValidateObject(buffer));
+
+        VkSemaphore outSignalSemaphore;
+        DAWN_TRY(buffer->SignalAndDestroy(&outSignalSemaphore));
+
+        // This has to happen right after SignalAndDestroy, since the semaphore will be
+        // deleted when the fenced deleter runs after the queue submission
+        DAWN_TRY_ASSIGN(*outHandle, mExternalSemaphoreService->ExportSemaphore(outSignalSemaphore));
+
+        return {};
+    }
+
+    MaybeError Device::ExportQueueSignalSemaphore(ExternalSemaphoreHandle* outHandle) {
+        if (!mExternalSemaphoreService->Supported()) {
+            return DAWN_VALIDATION_ERROR("External semaphore usage not supported");
+        }
+
+        VkSemaphore signalSemaphore = VK_NULL_HANDLE;
+        DAWN_TRY_ASSIGN(signalSemaphore, mExternalSemaphoreService->CreateExportableSemaphore());
+
+        // GetPendingRecordingContext marks the context used so the submit happens even when
+        // no commands were recorded since the last one; the semaphore then still signals
+        // once the previously submitted work completes.
+        GetPendingRecordingContext()->signalSemaphores.push_back(signalSemaphore);
+        DAWN_TRY(SubmitPendingCommands());
+
+        // This has to happen right after SubmitPendingCommands, since the semaphore will be
+        // deleted when the fenced deleter runs after the queue submission
+        DAWN_TRY_ASSIGN(*outHandle, mExternalSemaphoreService->ExportSemaphore(signalSemaphore));
+
+        return {};
+    }
+
     ResultOrError<ResourceMemoryAllocation> Device::AllocateMemory(
         VkMemoryRequirements requirements,
         bool mappable,
-        bool requestDeviceAddress) {
-        return mResourceMemoryAllocator->Allocate(requirements, mappable, requestDeviceAddress);
+        AllocationClass allocationClass,
+        bool requestDeviceAddress,
+        bool transient,
+        wgpu::MemoryAllocationHint hint,
+        VkBuffer dedicatedBuffer,
+        VkImage dedicatedImage) {
+        return mResourceMemoryAllocator->Allocate(requirements, mappable, allocationClass,
+                                                  requestDeviceAddress, transient, hint,
+                                                  dedicatedBuffer, dedicatedImage);
     }
 
     void Device::DeallocateMemory(ResourceMemoryAllocation* allocation) {
         mResourceMemoryAllocator->Deallocate(allocation);
     }
 
+    ResultOrError<ResourceMemoryAllocation> Device::AllocateAliasedMemory(
+        uint32_t aliasGroup,
+        VkMemoryRequirements requirements,
+        bool* aliased) {
+        ASSERT(aliasGroup != 0);
+
+        auto it = mAliasGroups.find(aliasGroup);
+        if (it != mAliasGroups.end()) {
+            AliasGroup* group = &it->second;
+
+            // The shared allocation can only be reused when the new texture fits in it.
+            // Creating the largest member of the group first guarantees full sharing.
+            if (requirements.size <= group->size &&
+                (requirements.memoryTypeBits & (1u << group->memoryType)) != 0 &&
+                (group->allocation.GetOffset() & (requirements.alignment - 1)) == 0) {
+                group->refCount++;
+                *aliased = true;
+                return ResourceMemoryAllocation(group->allocation);
+            }
+
+            *aliased = false;
+            return AllocateMemory(requirements, false, AllocationClass::Texture);
+        }
+
+        ResourceMemoryAllocation allocation;
+        DAWN_TRY_ASSIGN(allocation,
+                        AllocateMemory(requirements, false, AllocationClass::Texture));
+
+        AliasGroup group;
+        group.allocation = allocation;
+        group.size = requirements.size;
+        group.memoryType = ToBackend(allocation.GetResourceHeap())->GetMemoryType();
+        group.refCount = 1;
+        mAliasGroups.emplace(aliasGroup, group);
+
+        *aliased = true;
+        return std::move(allocation);
+    }
+
+    void Device::ReleaseAliasedMemory(uint32_t aliasGroup, Texture* texture) {
+        auto it = mAliasGroups.find(aliasGroup);
+        ASSERT(it != mAliasGroups.end());
+        ASSERT(it->second.refCount > 0);
+
+        if (it->second.lastUser == texture) {
+            it->second.lastUser = nullptr;
+        }
+
+        if (--it->second.refCount == 0) {
+            DeallocateMemory(&it->second.allocation);
+            mAliasGroups.erase(it);
+        }
+    }
+
+    bool Device::UpdateAliasGroupUsage(uint32_t aliasGroup, Texture* texture) {
+        auto it = mAliasGroups.find(aliasGroup);
+        ASSERT(it != mAliasGroups.end());
+
+        if (it->second.lastUser == texture) {
+            return false;
+        }
+        it->second.lastUser = texture;
+        return true;
+    }
+
     int Device::FindBestMemoryTypeIndex(VkMemoryRequirements requirements, bool mappable) {
         return mResourceMemoryAllocator->FindBestTypeIndex(requirements, mappable);
     }
@@ -799,6 +1856,11 @@ namespace dawn_native { namespace vulkan {
         // (so they are as good as waited on) or success.
         DAWN_UNUSED(waitIdleResult);
 
+        if (mBackgroundQueue != VK_NULL_HANDLE) {
+            waitIdleResult = VkResult::WrapUnsafe(fn.QueueWaitIdle(mBackgroundQueue));
+            DAWN_UNUSED(waitIdleResult);
+        }
+
         // Make sure all fences are complete by explicitly waiting on them all
         while (!mFencesInFlight.empty()) {
             VkFence fence = mFencesInFlight.front().first;
@@ -846,10 +1908,31 @@ namespace dawn_native { namespace vulkan {
         // Enough of the Device's initialization happened that we can now do regular robust
         // deinitialization.
 
-        // Immediately tag the recording context as unused so we don't try to submit it in Tick.
+        // Immediately tag the recording contexts as unused so we don't try to submit them in
+        // Tick.
         mRecordingContext.used = false;
         fn.DestroyCommandPool(mVkDevice, mRecordingContext.commandPool, nullptr);
 
+        mBackgroundRecordingContext.used = false;
+        if (mBackgroundRecordingContext.commandPool != VK_NULL_HANDLE) {
+            fn.DestroyCommandPool(mVkDevice, mBackgroundRecordingContext.commandPool, nullptr);
+        }
+
+        mTransferRecordingContext.used = false;
+        if (mTransferRecordingContext.commandPool != VK_NULL_HANDLE) {
+            fn.DestroyCommandPool(mVkDevice, mTransferRecordingContext.commandPool, nullptr);
+        }
+
+        for (VkSemaphore semaphore : mTransferWaitSemaphores) {
+            fn.DestroySemaphore(mVkDevice, semaphore, nullptr);
+        }
+        mTransferWaitSemaphores.clear();
+
+        if (mBackgroundWaitSemaphore != VK_NULL_HANDLE) {
+            fn.DestroySemaphore(mVkDevice, mBackgroundWaitSemaphore, nullptr);
+            mBackgroundWaitSemaphore = VK_NULL_HANDLE;
+        }
+
         for (VkSemaphore semaphore : mRecordingContext.waitSemaphores) {
             fn.DestroySemaphore(mVkDevice, semaphore, nullptr);
         }
@@ -874,11 +1957,36 @@ namespace dawn_native { namespace vulkan {
         }
         mUnusedCommands.clear();
 
+        ASSERT(mBackgroundCommandsInFlight.Empty());
+        for (const CommandPoolAndBuffer& commands : mUnusedBackgroundCommands) {
+            fn.DestroyCommandPool(mVkDevice, commands.pool, nullptr);
+        }
+        mUnusedBackgroundCommands.clear();
+
+        ASSERT(mTransferCommandsInFlight.Empty());
+
         for (VkFence fence : mUnusedFences) {
             fn.DestroyFence(mVkDevice, fence, nullptr);
         }
         mUnusedFences.clear();
 
+        if (mTimelineSemaphore != VK_NULL_HANDLE) {
+            fn.DestroySemaphore(mVkDevice, mTimelineSemaphore, nullptr);
+            mTimelineSemaphore = VK_NULL_HANDLE;
+        }
+
+        if (mSubmitTimestampQueryPool != VK_NULL_HANDLE) {
+            fn.DestroyQueryPool(mVkDevice, mSubmitTimestampQueryPool, nullptr);
+            mSubmitTimestampQueryPool = VK_NULL_HANDLE;
+        }
+
+        // Pipeline libraries are only referenced by pipelines, which are all destroyed by
+        // now, so they can be destroyed immediately.
+        for (const auto& it : mPipelineLibraries) {
+            fn.DestroyPipeline(mVkDevice, it.second, nullptr);
+        }
+        mPipelineLibraries.clear();
+
         // Releasing the uploader enqueues buffers to be released.
         // Call Tick() again to clear them before releasing the deleter.
         mDeleter->Tick(GetCompletedCommandSerial());
@@ -887,6 +1995,18 @@ namespace dawn_native { namespace vulkan {
         // to them are guaranteed to be finished executing.
         mRenderPassCache = nullptr;
 
+        // The pipeline cache isn't referenced by pipelines once they are created.
+        if (mPipelineCache != VK_NULL_HANDLE) {
+            fn.DestroyPipelineCache(mVkDevice, mPipelineCache, nullptr);
+            mPipelineCache = VK_NULL_HANDLE;
+        }
+
+        // Scratch buffers are released through the deleter, which is destroyed below.
+        if (mScratchBufferPool != nullptr) {
+            mScratchBufferPool->Destroy();
+            mScratchBufferPool = nullptr;
+        }
+
         // We need handle deleting all child objects by calling Tick() again with a large serial to
         // force all operations to look as if they were completed, and delete all objects before
         // destroying the Deleter and vkDevice.
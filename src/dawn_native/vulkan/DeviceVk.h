@@ -15,12 +15,17 @@
 #ifndef DAWNNATIVE_VULKAN_DEVICEVK_H_
 #define DAWNNATIVE_VULKAN_DEVICEVK_H_
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
 
+#include "common/ConcurrentSerialQueue.h"
 #include "common/Serial.h"
 #include "common/SerialQueue.h"
+#include "common/SlabAllocator.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/ResourceMemoryAllocation.h"
 #include "dawn_native/dawn_platform.h"
 #include "dawn_native/vulkan/CommandRecordingContext.h"
 #include "dawn_native/vulkan/Forward.h"
@@ -33,12 +38,14 @@ namespace dawn_native { namespace vulkan {
 
     class Adapter;
     class BindGroupLayout;
+    class BufferSlabAllocator;
     class BufferUploader;
     class FencedDeleter;
     class RenderPassCache;
+    class ScratchBufferPool;
     class ResourceMemoryAllocator;
 
-    class Device : public DeviceBase {
+    class Device final : public DeviceBase {
       public:
         static ResultOrError<Device*> Create(Adapter* adapter, const DeviceDescriptor* descriptor);
         ~Device() override;
@@ -57,12 +64,44 @@ namespace dawn_native { namespace vulkan {
         BufferUploader* GetBufferUploader() const;
         FencedDeleter* GetFencedDeleter() const;
         RenderPassCache* GetRenderPassCache() const;
+        ScratchBufferPool* GetScratchBufferPool() const;
+        BufferSlabAllocator* GetBufferSlabAllocator() const;
+        VkPipelineCache GetPipelineCache() const;
 
         CommandRecordingContext* GetPendingRecordingContext();
         MaybeError SubmitPendingCommands();
 
+        // Deferred presents for the batch_swapchain_presents toggle. Presents accumulate
+        // per device and FlushPendingPresents issues them all as a single
+        // vkQueuePresentKHR, which is called at the next queue submission and from the
+        // dawn_native::vulkan::FlushPendingPresents export.
+        void EnqueuePresent(VkSwapchainKHR swapChain, uint32_t imageIndex);
+        void FlushPendingPresents();
+
+        // Background-build queue for acceleration container builds. When the adapter
+        // exposes a dedicated compute queue family (or a second queue on the universal
+        // family), builds can be submitted there so they run concurrently with raster
+        // work on the main queue.
+        bool HasBackgroundQueue() const;
+        ResultOrError<CommandRecordingContext*> GetBackgroundRecordingContext();
+        MaybeError SubmitBackgroundCommands();
+
+        // Transfer queue for app-created transfer-class queues. A second queue on the
+        // universal family (so no queue family ownership transfers are needed) that copy
+        // submissions run on, ordered against the main queue with semaphores.
+        bool HasTransferQueue() const;
+        ResultOrError<CommandRecordingContext*> GetTransferRecordingContext();
+        MaybeError SubmitTransferCommands();
+
         void EnqueueDeferredDeallocation(BindGroupLayout* bindGroupLayout);
 
+        // Cache of ray tracing pipeline libraries (pipelines created with
+        // VK_PIPELINE_CREATE_LIBRARY_BIT_KHR), keyed by a hash of the group's shaders,
+        // layout and interface. Shared groups compile once and later pipelines link the
+        // cached library instead of recompiling. Entries live until device shutdown.
+        VkPipeline GetCachedPipelineLibrary(size_t key) const;
+        void CachePipelineLibrary(size_t key, VkPipeline library);
+
         // Dawn Native API
 
         TextureBase* CreateTextureWrappingVulkanImage(
@@ -73,6 +112,42 @@ namespace dawn_native { namespace vulkan {
         MaybeError SignalAndExportExternalTexture(Texture* texture,
                                                   ExternalSemaphoreHandle* outHandle);
 
+        // Creates a texture backed by exportable memory so another device can wrap the same
+        // allocation instead of copying through the CPU. The out parameters receive what the
+        // importing device passes to CreateTextureWrappingVulkanImage; ownership transfers via
+        // SignalAndExportExternalTexture on this device and waitHandles on the importing one.
+        TextureBase* CreateExportableTexture(const TextureDescriptor* descriptor,
+                                             ExternalMemoryHandle* outMemoryHandle,
+                                             uint64_t* outAllocationSize,
+                                             uint32_t* outMemoryTypeIndex);
+
+        // Buffer equivalents of the external texture entry points.
+        BufferBase* CreateBufferWrappingVulkanMemory(
+            const BufferDescriptor* descriptor,
+            ExternalMemoryHandle memoryHandle,
+            uint64_t allocationSize,
+            uint32_t memoryTypeIndex,
+            const std::vector<ExternalSemaphoreHandle>& waitHandles);
+
+        BufferBase* CreateExportableBuffer(const BufferDescriptor* descriptor,
+                                           ExternalMemoryHandle* outMemoryHandle,
+                                           uint64_t* outAllocationSize,
+                                           uint32_t* outMemoryTypeIndex);
+
+        // Creates a buffer aliasing already-owned host memory through
+        // VK_EXT_external_memory_host; see Buffer::CreateFromHostPointer.
+        BufferBase* CreateBufferWrappingHostMemory(const BufferDescriptor* descriptor,
+                                                   void* hostPointer,
+                                                   uint64_t allocationSize);
+
+        MaybeError SignalAndExportExternalBuffer(Buffer* buffer,
+                                                 ExternalSemaphoreHandle* outHandle);
+
+        // Submits the commands recorded so far with an extra exportable semaphore signaled
+        // on their completion and exports it, so an external process (e.g. a compositor)
+        // can wait on the queue GPU-side instead of through a CPU round-trip.
+        MaybeError ExportQueueSignalSemaphore(ExternalSemaphoreHandle* outHandle);
+
         // Dawn API
         CommandBufferBase* CreateCommandBuffer(CommandEncoder* encoder,
                                                const CommandBufferDescriptor* descriptor) override;
@@ -80,17 +155,56 @@ namespace dawn_native { namespace vulkan {
         MaybeError TickImpl() override;
 
         ResultOrError<std::unique_ptr<StagingBufferBase>> CreateStagingBuffer(size_t size) override;
+        ResultOrError<std::unique_ptr<StagingBufferBase>> CreateReadbackStagingBuffer(
+            size_t size) override;
         MaybeError CopyFromStagingToBuffer(StagingBufferBase* source,
                                            uint64_t sourceOffset,
                                            BufferBase* destination,
                                            uint64_t destinationOffset,
                                            uint64_t size) override;
+        MaybeError CopyFromStagingToTexture(StagingBufferBase* source,
+                                            uint64_t sourceOffset,
+                                            uint32_t bytesPerRow,
+                                            uint32_t rowsPerImage,
+                                            const TextureCopy& dst,
+                                            const Extent3D& copySizePixels) override;
+        MaybeError CopyFromBufferToStaging(BufferBase* source,
+                                           uint64_t sourceOffset,
+                                           StagingBufferBase* destination,
+                                           uint64_t destinationOffset,
+                                           uint64_t size) override;
 
-        ResultOrError<ResourceMemoryAllocation> AllocateMemory(VkMemoryRequirements requirements,
-                                                               bool mappable,
-                                                               bool requestDeviceAddress = false);
+        ResultOrError<ResourceMemoryAllocation> AllocateMemory(
+            VkMemoryRequirements requirements,
+            bool mappable,
+            AllocationClass allocationClass,
+            bool requestDeviceAddress = false,
+            bool transient = false,
+            wgpu::MemoryAllocationHint hint = wgpu::MemoryAllocationHint::None,
+            VkBuffer dedicatedBuffer = VK_NULL_HANDLE,
+            VkImage dedicatedImage = VK_NULL_HANDLE);
         void DeallocateMemory(ResourceMemoryAllocation* allocation);
 
+        // Shared allocations for textures created with a nonzero alias group. The first
+        // member sizes the allocation; a later member that doesn't fit in it falls back to
+        // its own memory and `aliased` is set to false.
+        ResultOrError<ResourceMemoryAllocation> AllocateAliasedMemory(
+            uint32_t aliasGroup,
+            VkMemoryRequirements requirements,
+            bool* aliased);
+        void ReleaseAliasedMemory(uint32_t aliasGroup, Texture* texture);
+        // Returns true when `texture` wasn't the last group member to touch the shared
+        // memory, in which case its contents are garbage and it must perform an aliasing
+        // acquire before use.
+        bool UpdateAliasGroupUsage(uint32_t aliasGroup, Texture* texture);
+
+        // TextureViews are placement-allocated out of a per-device slab to avoid a heap
+        // allocation per view. Both methods may be called from any thread because the
+        // last reference to a view can be dropped anywhere.
+        TextureView* AllocateTextureView(TextureBase* texture,
+                                         const TextureViewDescriptor* descriptor);
+        void DeallocateTextureView(TextureView* view);
+
         int FindBestMemoryTypeIndex(VkMemoryRequirements requirements, bool mappable);
 
         ResourceMemoryAllocator* GetResourceMemoryAllocatorForTesting() const;
@@ -113,6 +227,9 @@ namespace dawn_native { namespace vulkan {
             const ComputePipelineDescriptor* descriptor) override;
         ResultOrError<PipelineLayoutBase*> CreatePipelineLayoutImpl(
             const PipelineLayoutDescriptor* descriptor) override;
+        ResultOrError<QuerySetBase*> CreateQuerySetImpl(
+            const QuerySetDescriptor* descriptor) override;
+        ResultOrError<QueueBase*> CreateQueueImpl(const QueueDescriptor* descriptor) override;
         ResultOrError<RenderPipelineBase*> CreateRenderPipelineImpl(
             const RenderPipelineDescriptor* descriptor) override;
         ResultOrError<SamplerBase*> CreateSamplerImpl(const SamplerDescriptor* descriptor) override;
@@ -133,6 +250,18 @@ namespace dawn_native { namespace vulkan {
         ResultOrError<VulkanDeviceKnobs> CreateDevice(VkPhysicalDevice physicalDevice);
         void GatherQueueFromDevice();
 
+        MaybeError CreatePipelineCache(const void* data, size_t size);
+        MaybeError LoadPipelineCacheDataImpl(const void* data, size_t size) override;
+        ResultOrError<std::vector<uint8_t>> GetPipelineCacheDataImpl() override;
+
+        // Reports the device-local heap budgets from VK_EXT_memory_budget, or no budget
+        // when the extension isn't available.
+        MemoryBudgetInfo QueryMemoryBudgetImpl() override;
+
+        // Blocks on the timeline semaphore (or the oldest in-flight fence) so embedders
+        // can sleep until a Tick would make progress.
+        bool WaitForCompletedWorkImpl(uint64_t timeoutNanoseconds) override;
+
         void InitTogglesFromDriver();
         void ApplyDepth24PlusS8Toggle();
 
@@ -147,11 +276,35 @@ namespace dawn_native { namespace vulkan {
         VkDevice mVkDevice = VK_NULL_HANDLE;
         uint32_t mQueueFamily = 0;
         VkQueue mQueue = VK_NULL_HANDLE;
+        VkPipelineCache mPipelineCache = VK_NULL_HANDLE;
 
-        SerialQueue<Ref<BindGroupLayout>> mBindGroupLayoutsPendingDeallocation;
+        // Concurrent because DescriptorSetAllocator::Deallocate enqueues here and may be
+        // called from any thread returning a bind group.
+        ConcurrentSerialQueue<Ref<BindGroupLayout>> mBindGroupLayoutsPendingDeallocation;
         std::unique_ptr<FencedDeleter> mDeleter;
         std::unique_ptr<ResourceMemoryAllocator> mResourceMemoryAllocator;
         std::unique_ptr<RenderPassCache> mRenderPassCache;
+        std::unique_ptr<ScratchBufferPool> mScratchBufferPool;
+        std::unique_ptr<BufferSlabAllocator> mBufferSlabAllocator;
+
+        // One entry per alive texture alias group, refcounted by the member textures.
+        struct AliasGroup {
+            ResourceMemoryAllocation allocation;
+            VkDeviceSize size = 0;
+            uint32_t memoryType = 0;
+            uint32_t refCount = 0;
+            Texture* lastUser = nullptr;
+        };
+        std::map<uint32_t, AliasGroup> mAliasGroups;
+
+        // Ray tracing pipeline libraries, see GetCachedPipelineLibrary. Destroyed in
+        // ShutDownImpl.
+        std::map<size_t, VkPipeline> mPipelineLibraries;
+
+        // Guards mTextureViewAllocator: the SlabAllocator isn't thread-safe and views can
+        // be created and released from multiple threads.
+        std::mutex mTextureViewAllocatorMutex;
+        SlabAllocator<TextureView> mTextureViewAllocator;
 
         std::unique_ptr<external_memory::Service> mExternalMemoryService;
         std::unique_ptr<external_semaphore::Service> mExternalSemaphoreService;
@@ -167,9 +320,21 @@ namespace dawn_native { namespace vulkan {
         // Fences in the unused list aren't reset yet.
         std::vector<VkFence> mUnusedFences;
 
+        // When VK_KHR_timeline_semaphore is available this semaphore replaces the fences
+        // above: every submit signals it with its serial and completed serials are read
+        // back with vkGetSemaphoreCounterValueKHR.
+        VkSemaphore mTimelineSemaphore = VK_NULL_HANDLE;
+
         MaybeError PrepareRecordingContext();
         void RecycleCompletedCommands();
 
+        // GPU submit timing for the trace_gpu_submit_timings toggle. A begin timestamp is
+        // written when the recording context is prepared and an end timestamp right before
+        // submission; the pair is read back asynchronously on Tick once the submission's
+        // serial completed and the duration reported through the platform trace sink.
+        void ArmSubmitTimestamps();
+        void ResolveCompletedSubmitTimestamps();
+
         struct CommandPoolAndBuffer {
             VkCommandPool pool = VK_NULL_HANDLE;
             VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
@@ -180,6 +345,53 @@ namespace dawn_native { namespace vulkan {
         // There is always a valid recording context stored in mRecordingContext
         CommandRecordingContext mRecordingContext;
 
+        // Ring of begin/end timestamp query pairs for trace_gpu_submit_timings. The pool
+        // is created lazily; a submission finding every slot still in flight simply goes
+        // uninstrumented instead of blocking.
+        static constexpr uint32_t kMaxSubmitTimestampsInFlight = 128;
+        struct SubmitTimestamps {
+            uint32_t slot;
+            Serial serial;
+        };
+        VkQueryPool mSubmitTimestampQueryPool = VK_NULL_HANDLE;
+        uint32_t mNextSubmitTimestampSlot = 0;
+        uint32_t mSubmitTimestampSlotsInUse = 0;
+        // The slot armed in the pending recording context, -1 when uninstrumented.
+        int32_t mArmedSubmitTimestampSlot = -1;
+        SerialQueue<SubmitTimestamps> mSubmitTimestampsInFlight;
+
+        // Presents deferred by the batch_swapchain_presents toggle, parallel arrays
+        // matching VkPresentInfoKHR's pSwapchains/pImageIndices layout.
+        std::vector<VkSwapchainKHR> mPendingPresentSwapChains;
+        std::vector<uint32_t> mPendingPresentImageIndices;
+
+        // Background-build queue state. The background recording context is created
+        // lazily on first use. mBackgroundWaitSemaphore is signaled by the latest
+        // main-queue submit and consumed by the next background submit so builds are
+        // ordered after the work that produced their inputs.
+        bool mHasBackgroundQueue = false;
+        uint32_t mBackgroundQueueFamily = 0;
+        uint32_t mBackgroundQueueIndex = 0;
+        VkQueue mBackgroundQueue = VK_NULL_HANDLE;
+        VkSemaphore mBackgroundWaitSemaphore = VK_NULL_HANDLE;
+        CommandRecordingContext mBackgroundRecordingContext;
+        SerialQueue<CommandPoolAndBuffer> mBackgroundCommandsInFlight;
+        std::vector<CommandPoolAndBuffer> mUnusedBackgroundCommands;
+
+        // Transfer queue state. The transfer queue lives on the universal family so its
+        // command pools can be recycled through mUnusedCommands. Semaphores in
+        // mTransferWaitSemaphores were signaled by main-queue submits and are consumed by
+        // the next transfer submit so copies are ordered after the work they depend on.
+        bool mHasTransferQueue = false;
+        uint32_t mTransferQueueIndex = 0;
+        VkQueue mTransferQueue = VK_NULL_HANDLE;
+        // Set once the first transfer-class queue is created; main-queue submits only
+        // signal transfer-ordering semaphores from then on.
+        bool mTransferQueueUsed = false;
+        CommandRecordingContext mTransferRecordingContext;
+        SerialQueue<CommandPoolAndBuffer> mTransferCommandsInFlight;
+        std::vector<VkSemaphore> mTransferWaitSemaphores;
+
         MaybeError ImportExternalImage(const ExternalImageDescriptor* descriptor,
                                        ExternalMemoryHandle memoryHandle,
                                        VkImage image,
@@ -187,6 +399,10 @@ namespace dawn_native { namespace vulkan {
                                        VkSemaphore* outSignalSemaphore,
                                        VkDeviceMemory* outAllocation,
                                        std::vector<VkSemaphore>* outWaitSemaphores);
+
+        MaybeError ImportExternalSemaphores(
+            const std::vector<ExternalSemaphoreHandle>& waitHandles,
+            std::vector<VkSemaphore>* outWaitSemaphores);
     };
 
 }}  // namespace dawn_native::vulkan
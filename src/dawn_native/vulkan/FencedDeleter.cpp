@@ -24,6 +24,7 @@ namespace dawn_native { namespace vulkan {
     FencedDeleter::~FencedDeleter() {
         ASSERT(mBuffersToDelete.Empty());
         ASSERT(mAccelerationStructuresToDelete.Empty());
+        ASSERT(mCommandPoolsToDelete.Empty());
         ASSERT(mDescriptorPoolsToDelete.Empty());
         ASSERT(mFramebuffersToDelete.Empty());
         ASSERT(mImagesToDelete.Empty());
@@ -31,6 +32,7 @@ namespace dawn_native { namespace vulkan {
         ASSERT(mMemoriesToDelete.Empty());
         ASSERT(mPipelinesToDelete.Empty());
         ASSERT(mPipelineLayoutsToDelete.Empty());
+        ASSERT(mQueryPoolsToDelete.Empty());
         ASSERT(mRenderPassesToDelete.Empty());
         ASSERT(mSamplersToDelete.Empty());
         ASSERT(mSemaphoresToDelete.Empty());
@@ -47,6 +49,10 @@ namespace dawn_native { namespace vulkan {
         mAccelerationStructuresToDelete.Enqueue(as, mDevice->GetPendingCommandSerial());
     }
 
+    void FencedDeleter::DeleteWhenUnused(VkCommandPool pool) {
+        mCommandPoolsToDelete.Enqueue(pool, mDevice->GetPendingCommandSerial());
+    }
+
     void FencedDeleter::DeleteWhenUnused(VkDescriptorPool pool) {
         mDescriptorPoolsToDelete.Enqueue(pool, mDevice->GetPendingCommandSerial());
     }
@@ -71,6 +77,10 @@ namespace dawn_native { namespace vulkan {
         mPipelinesToDelete.Enqueue(pipeline, mDevice->GetPendingCommandSerial());
     }
 
+    void FencedDeleter::DeleteWhenUnused(VkQueryPool queryPool) {
+        mQueryPoolsToDelete.Enqueue(queryPool, mDevice->GetPendingCommandSerial());
+    }
+
     void FencedDeleter::DeleteWhenUnused(VkPipelineLayout layout) {
         mPipelineLayoutsToDelete.Enqueue(layout, mDevice->GetPendingCommandSerial());
     }
@@ -154,6 +164,11 @@ namespace dawn_native { namespace vulkan {
         }
         mPipelinesToDelete.ClearUpTo(completedSerial);
 
+        for (VkQueryPool queryPool : mQueryPoolsToDelete.IterateUpTo(completedSerial)) {
+            mDevice->fn.DestroyQueryPool(vkDevice, queryPool, nullptr);
+        }
+        mQueryPoolsToDelete.ClearUpTo(completedSerial);
+
         // Vulkan swapchains must be destroyed before their corresponding VkSurface
         for (VkSwapchainKHR swapChain : mSwapChainsToDelete.IterateUpTo(completedSerial)) {
             mDevice->fn.DestroySwapchainKHR(vkDevice, swapChain, nullptr);
@@ -169,6 +184,11 @@ namespace dawn_native { namespace vulkan {
         }
         mSemaphoresToDelete.ClearUpTo(completedSerial);
 
+        for (VkCommandPool pool : mCommandPoolsToDelete.IterateUpTo(completedSerial)) {
+            mDevice->fn.DestroyCommandPool(vkDevice, pool, nullptr);
+        }
+        mCommandPoolsToDelete.ClearUpTo(completedSerial);
+
         for (VkDescriptorPool pool : mDescriptorPoolsToDelete.IterateUpTo(completedSerial)) {
             mDevice->fn.DestroyDescriptorPool(vkDevice, pool, nullptr);
         }
@@ -15,13 +15,17 @@
 #ifndef DAWNNATIVE_VULKAN_FENCEDDELETER_H_
 #define DAWNNATIVE_VULKAN_FENCEDDELETER_H_
 
-#include "common/SerialQueue.h"
+#include "common/ConcurrentSerialQueue.h"
 #include "common/vulkan_platform.h"
 
 namespace dawn_native { namespace vulkan {
 
     class Device;
 
+    // FencedDeleter defers the destruction of Vulkan objects until the serial of their
+    // last use completes. DeleteWhenUnused may be called from any thread (for example
+    // workers tearing down resources during a level unload); Tick must stay on the
+    // device thread.
     class FencedDeleter {
       public:
         FencedDeleter(Device* device);
@@ -29,6 +33,7 @@ namespace dawn_native { namespace vulkan {
 
         void DeleteWhenUnused(VkBuffer buffer);
         void DeleteWhenUnused(VkAccelerationStructureKHR as);
+        void DeleteWhenUnused(VkCommandPool pool);
         void DeleteWhenUnused(VkDescriptorPool pool);
         void DeleteWhenUnused(VkDeviceMemory memory);
         void DeleteWhenUnused(VkFramebuffer framebuffer);
@@ -37,6 +42,7 @@ namespace dawn_native { namespace vulkan {
         void DeleteWhenUnused(VkPipelineLayout layout);
         void DeleteWhenUnused(VkRenderPass renderPass);
         void DeleteWhenUnused(VkPipeline pipeline);
+        void DeleteWhenUnused(VkQueryPool queryPool);
         void DeleteWhenUnused(VkSampler sampler);
         void DeleteWhenUnused(VkSemaphore semaphore);
         void DeleteWhenUnused(VkShaderModule module);
@@ -47,21 +53,23 @@ namespace dawn_native { namespace vulkan {
 
       private:
         Device* mDevice = nullptr;
-        SerialQueue<VkBuffer> mBuffersToDelete;
-        SerialQueue<VkAccelerationStructureKHR> mAccelerationStructuresToDelete;
-        SerialQueue<VkDescriptorPool> mDescriptorPoolsToDelete;
-        SerialQueue<VkDeviceMemory> mMemoriesToDelete;
-        SerialQueue<VkFramebuffer> mFramebuffersToDelete;
-        SerialQueue<VkImage> mImagesToDelete;
-        SerialQueue<VkImageView> mImageViewsToDelete;
-        SerialQueue<VkPipeline> mPipelinesToDelete;
-        SerialQueue<VkPipelineLayout> mPipelineLayoutsToDelete;
-        SerialQueue<VkRenderPass> mRenderPassesToDelete;
-        SerialQueue<VkSampler> mSamplersToDelete;
-        SerialQueue<VkSemaphore> mSemaphoresToDelete;
-        SerialQueue<VkShaderModule> mShaderModulesToDelete;
-        SerialQueue<VkSurfaceKHR> mSurfacesToDelete;
-        SerialQueue<VkSwapchainKHR> mSwapChainsToDelete;
+        ConcurrentSerialQueue<VkBuffer> mBuffersToDelete;
+        ConcurrentSerialQueue<VkAccelerationStructureKHR> mAccelerationStructuresToDelete;
+        ConcurrentSerialQueue<VkCommandPool> mCommandPoolsToDelete;
+        ConcurrentSerialQueue<VkDescriptorPool> mDescriptorPoolsToDelete;
+        ConcurrentSerialQueue<VkDeviceMemory> mMemoriesToDelete;
+        ConcurrentSerialQueue<VkFramebuffer> mFramebuffersToDelete;
+        ConcurrentSerialQueue<VkImage> mImagesToDelete;
+        ConcurrentSerialQueue<VkImageView> mImageViewsToDelete;
+        ConcurrentSerialQueue<VkPipeline> mPipelinesToDelete;
+        ConcurrentSerialQueue<VkPipelineLayout> mPipelineLayoutsToDelete;
+        ConcurrentSerialQueue<VkQueryPool> mQueryPoolsToDelete;
+        ConcurrentSerialQueue<VkRenderPass> mRenderPassesToDelete;
+        ConcurrentSerialQueue<VkSampler> mSamplersToDelete;
+        ConcurrentSerialQueue<VkSemaphore> mSemaphoresToDelete;
+        ConcurrentSerialQueue<VkShaderModule> mShaderModulesToDelete;
+        ConcurrentSerialQueue<VkSurfaceKHR> mSurfacesToDelete;
+        ConcurrentSerialQueue<VkSwapchainKHR> mSwapChainsToDelete;
     };
 
 }}  // namespace dawn_native::vulkan
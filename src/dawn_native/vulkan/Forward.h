@@ -28,6 +28,7 @@ namespace dawn_native { namespace vulkan {
     class ComputePipeline;
     class Device;
     class PipelineLayout;
+    class QuerySet;
     class Queue;
     class RayTracingAccelerationContainer;
     class RayTracingPipeline;
@@ -50,6 +51,7 @@ namespace dawn_native { namespace vulkan {
         using ComputePipelineType = ComputePipeline;
         using DeviceType = Device;
         using PipelineLayoutType = PipelineLayout;
+        using QuerySetType = QuerySet;
         using QueueType = Queue;
         using RayTracingAccelerationContainerType = RayTracingAccelerationContainer;
         using RayTracingPipelineType = RayTracingPipeline;
@@ -18,34 +18,67 @@
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/TextureVk.h"
 
+#include <algorithm>
 #include <limits>
 
 namespace dawn_native { namespace vulkan {
 
     namespace {
 
+        bool IsPresentModeAvailable(const std::vector<VkPresentModeKHR>& availablePresentModes,
+                                    VkPresentModeKHR presentMode) {
+            for (const auto& availablePresentMode : availablePresentModes) {
+                if (availablePresentMode == presentMode) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
         bool chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes,
                                    bool turnOffVsync,
+                                   dawn_native::PresentMode requestedMode,
                                    VkPresentModeKHR* presentMode) {
             if (turnOffVsync) {
-                for (const auto& availablePresentMode : availablePresentModes) {
-                    if (availablePresentMode == VK_PRESENT_MODE_IMMEDIATE_KHR) {
-                        *presentMode = availablePresentMode;
-                        return true;
-                    }
+                if (IsPresentModeAvailable(availablePresentModes,
+                                           VK_PRESENT_MODE_IMMEDIATE_KHR)) {
+                    *presentMode = VK_PRESENT_MODE_IMMEDIATE_KHR;
+                    return true;
                 }
                 return false;
             }
 
+            switch (requestedMode) {
+                case dawn_native::PresentMode::Immediate:
+                    if (IsPresentModeAvailable(availablePresentModes,
+                                               VK_PRESENT_MODE_IMMEDIATE_KHR)) {
+                        *presentMode = VK_PRESENT_MODE_IMMEDIATE_KHR;
+                        return true;
+                    }
+                    break;
+                case dawn_native::PresentMode::Mailbox:
+                    if (IsPresentModeAvailable(availablePresentModes,
+                                               VK_PRESENT_MODE_MAILBOX_KHR)) {
+                        *presentMode = VK_PRESENT_MODE_MAILBOX_KHR;
+                        return true;
+                    }
+                    break;
+                case dawn_native::PresentMode::Fifo:
+                    break;
+            }
+
+            // FIFO support is required by the Vulkan specification.
             *presentMode = VK_PRESENT_MODE_FIFO_KHR;
             return true;
         }
 
         bool ChooseSurfaceConfig(const VulkanSurfaceInfo& info,
                                  NativeSwapChainImpl::ChosenConfig* config,
-                                 bool turnOffVsync) {
+                                 bool turnOffVsync,
+                                 const SwapChainLatencyDescriptor& latencyDescriptor) {
             VkPresentModeKHR presentMode;
-            if (!chooseSwapPresentMode(info.presentModes, turnOffVsync, &presentMode)) {
+            if (!chooseSwapPresentMode(info.presentModes, turnOffVsync,
+                                       latencyDescriptor.presentMode, &presentMode)) {
                 return false;
             }
             // TODO(cwallez@chromium.org): For now this is hardcoded to what works with one NVIDIA
@@ -53,7 +86,20 @@ namespace dawn_native { namespace vulkan {
             config->nativeFormat = VK_FORMAT_B8G8R8A8_UNORM;
             config->colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
             config->format = wgpu::TextureFormat::BGRA8Unorm;
-            config->minImageCount = 3;
+
+            // Request one more image than the frame latency so one image can be presented
+            // while |maximumFrameLatency| frames are being rendered.
+            uint32_t minImageCount = 3;
+            if (latencyDescriptor.maximumFrameLatency != 0) {
+                minImageCount =
+                    std::max(latencyDescriptor.maximumFrameLatency + 1,
+                             info.capabilities.minImageCount);
+                if (info.capabilities.maxImageCount != 0) {
+                    minImageCount = std::min(minImageCount, info.capabilities.maxImageCount);
+                }
+            }
+            config->minImageCount = minImageCount;
+
             // TODO(cwallez@chromium.org): This is upside down compared to what we want, at least
             // on Linux
             config->preTransform = info.capabilities.currentTransform;
@@ -65,7 +111,13 @@ namespace dawn_native { namespace vulkan {
     }  // anonymous namespace
 
     NativeSwapChainImpl::NativeSwapChainImpl(Device* device, VkSurfaceKHR surface)
-        : mSurface(surface), mDevice(device) {
+        : NativeSwapChainImpl(device, surface, SwapChainLatencyDescriptor()) {
+    }
+
+    NativeSwapChainImpl::NativeSwapChainImpl(Device* device,
+                                             VkSurfaceKHR surface,
+                                             const SwapChainLatencyDescriptor& latencyDescriptor)
+        : mSurface(surface), mLatencyDescriptor(latencyDescriptor), mDevice(device) {
         // Call this immediately, so that BackendBinding::GetPreferredSwapChainTextureFormat
         // will return a correct result before a SwapChain is created.
         UpdateSurfaceConfig();
@@ -88,7 +140,8 @@ namespace dawn_native { namespace vulkan {
             ASSERT(false);
         }
 
-        if (!ChooseSurfaceConfig(mInfo, &mConfig, mDevice->IsToggleEnabled(Toggle::TurnOffVsync))) {
+        if (!ChooseSurfaceConfig(mInfo, &mConfig, mDevice->IsToggleEnabled(Toggle::TurnOffVsync),
+                                 mLatencyDescriptor)) {
             ASSERT(false);
         }
     }
@@ -197,6 +250,13 @@ namespace dawn_native { namespace vulkan {
         // This assumes that the image has already been transitioned to the PRESENT layout and
         // writes were made available to the stage.
 
+        // In batched mode the present is queued on the device and issued together with the
+        // other swapchains' presents in a single vkQueuePresentKHR.
+        if (mDevice->IsToggleEnabled(Toggle::BatchSwapchainPresents)) {
+            mDevice->EnqueuePresent(mSwapChain, mLastImageIndex);
+            return DAWN_SWAP_CHAIN_NO_ERROR;
+        }
+
         // Assuming that the present queue is the same as the graphics queue, the proper
         // synchronization has already been done on the queue so we don't need to wait on any
         // semaphores.
@@ -18,6 +18,7 @@
 #include "dawn_native/vulkan/VulkanInfo.h"
 
 #include "dawn/dawn_wsi.h"
+#include "dawn_native/DawnNative.h"
 #include "dawn_native/dawn_platform.h"
 
 namespace dawn_native { namespace vulkan {
@@ -29,6 +30,9 @@ namespace dawn_native { namespace vulkan {
         using WSIContext = DawnWSIContextVulkan;
 
         NativeSwapChainImpl(Device* device, VkSurfaceKHR surface);
+        NativeSwapChainImpl(Device* device,
+                            VkSurfaceKHR surface,
+                            const SwapChainLatencyDescriptor& latencyDescriptor);
         ~NativeSwapChainImpl();
 
         void Init(DawnWSIContextVulkan* context);
@@ -61,6 +65,8 @@ namespace dawn_native { namespace vulkan {
 
         VulkanSurfaceInfo mInfo;
 
+        SwapChainLatencyDescriptor mLatencyDescriptor;
+
         ChosenConfig mConfig;
 
         Device* mDevice = nullptr;
@@ -42,6 +42,8 @@ namespace dawn_native { namespace vulkan {
             numSetLayouts++;
         }
 
+        Device* device = ToBackend(GetDevice());
+
         VkPipelineLayoutCreateInfo createInfo;
         createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
         createInfo.pNext = nullptr;
@@ -51,7 +53,18 @@ namespace dawn_native { namespace vulkan {
         createInfo.pushConstantRangeCount = 0;
         createInfo.pPushConstantRanges = nullptr;
 
-        Device* device = ToBackend(GetDevice());
+        // All layouts share the same push constant range so that immediate data pushed with one
+        // layout bound stays valid when a compatible pipeline with another layout is set.
+        VkPushConstantRange pushConstantRange;
+        if (device->IsExtensionEnabled(Extension::ImmediateData)) {
+            pushConstantRange.stageFlags = VK_SHADER_STAGE_ALL;
+            pushConstantRange.offset = 0;
+            pushConstantRange.size = kMaxImmediateDataBytes;
+
+            createInfo.pushConstantRangeCount = 1;
+            createInfo.pPushConstantRanges = &pushConstantRange;
+        }
+
         return CheckVkSuccess(
             device->fn.CreatePipelineLayout(device->GetVkDevice(), &createInfo, nullptr, &*mHandle),
             "CreatePipelineLayout");
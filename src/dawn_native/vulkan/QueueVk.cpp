@@ -27,23 +27,73 @@ namespace dawn_native { namespace vulkan {
         return new Queue(device);
     }
 
+    // static
+    Queue* Queue::Create(Device* device, const QueueDescriptor* descriptor) {
+        return new Queue(device, descriptor);
+    }
+
     Queue::~Queue() {
     }
 
     MaybeError Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) {
         Device* device = ToBackend(GetDevice());
 
-        device->Tick();
+        // Presents deferred by batch_swapchain_presents are flushed at the submission
+        // boundary so they never outlive the frame that produced them.
+        device->FlushPendingPresents();
+
+        // In deferred mode the recorded commands accumulate in the pending recording context
+        // and Tick would flush them, so ticking per-submit would defeat the batching.
+        if (!device->IsToggleEnabled(Toggle::DeferSubmits)) {
+            device->Tick();
+        }
+
+        // Transfer-class queues run their commands on the device's transfer VkQueue.
+        // Pending main-queue work is flushed first so the transfer submit waits on its
+        // semaphore and the copies are ordered after the work they depend on.
+        if (GetQueueType() == wgpu::QueueType::Transfer && device->HasTransferQueue()) {
+            DAWN_TRY(device->SubmitPendingCommands());
+
+            CommandRecordingContext* transferContext = nullptr;
+            DAWN_TRY_ASSIGN(transferContext, device->GetTransferRecordingContext());
+            for (uint32_t i = 0; i < commandCount; ++i) {
+                DAWN_TRY(ToBackend(commands[i])->RecordCommands(transferContext));
+            }
+
+            return device->SubmitTransferCommands();
+        }
 
         TRACE_EVENT_BEGIN0(GetDevice()->GetPlatform(), Recording,
                            "CommandBufferVk::RecordCommands");
-        CommandRecordingContext* recordingContext = device->GetPendingRecordingContext();
         for (uint32_t i = 0; i < commandCount; ++i) {
-            DAWN_TRY(ToBackend(commands[i])->RecordCommands(recordingContext));
+            // Command buffers that only build acceleration containers run on the background
+            // queue when one is available, so they overlap with work on the main queue.
+            // Pending main-queue work is flushed first so the background submit waits on
+            // its semaphore and the builds are ordered after the work that produced their
+            // inputs, including command buffers earlier in this call.
+            if (device->HasBackgroundQueue() &&
+                ToBackend(commands[i])->OnlyContainsAccelerationContainerBuilds()) {
+                DAWN_TRY(device->SubmitPendingCommands());
+
+                CommandRecordingContext* backgroundContext = nullptr;
+                DAWN_TRY_ASSIGN(backgroundContext, device->GetBackgroundRecordingContext());
+                DAWN_TRY(ToBackend(commands[i])->RecordCommands(backgroundContext));
+                continue;
+            }
+            // Fetched per command buffer because a background flush above resets the
+            // pending recording context's used flag.
+            DAWN_TRY(ToBackend(commands[i])->RecordCommands(device->GetPendingRecordingContext()));
         }
         TRACE_EVENT_END0(GetDevice()->GetPlatform(), Recording, "CommandBufferVk::RecordCommands");
 
-        DAWN_TRY(device->SubmitPendingCommands());
+        DAWN_TRY(device->SubmitBackgroundCommands());
+
+        // When submits are deferred the commands stay in the pending recording context; they
+        // are batched into a single vkQueueSubmit on the next Tick, or earlier if a dependency
+        // (transfer queue copy, present, idle wait) forces a flush.
+        if (!device->IsToggleEnabled(Toggle::DeferSubmits)) {
+            DAWN_TRY(device->SubmitPendingCommands());
+        }
 
         return {};
     }
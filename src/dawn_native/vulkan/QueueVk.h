@@ -25,6 +25,7 @@ namespace dawn_native { namespace vulkan {
     class Queue final : public QueueBase {
       public:
         static Queue* Create(Device* device);
+        static Queue* Create(Device* device, const QueueDescriptor* descriptor);
 
       private:
         ~Queue() override;
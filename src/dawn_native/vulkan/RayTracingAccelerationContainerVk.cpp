@@ -66,24 +66,24 @@ namespace dawn_native { namespace vulkan {
 
     void RayTracingAccelerationContainer::DestroyImpl() {
         Device* device = ToBackend(GetDevice());
-        DestroyScratchBuildMemory();
         if (mScratchMemory.result.buffer != VK_NULL_HANDLE) {
             device->DeallocateMemory(&mScratchMemory.result.resource);
             device->GetFencedDeleter()->DeleteWhenUnused(mScratchMemory.result.buffer);
             mScratchMemory.result.buffer = VK_NULL_HANDLE;
         }
-        if (mScratchMemory.update.buffer != VK_NULL_HANDLE) {
-            device->DeallocateMemory(&mScratchMemory.update.resource);
-            device->GetFencedDeleter()->DeleteWhenUnused(mScratchMemory.update.buffer);
-            mScratchMemory.update.buffer = VK_NULL_HANDLE;
-        }
         if (mInstanceMemory.buffer != VK_NULL_HANDLE) {
             Buffer* buffer = mInstanceMemory.allocation.Get();
-            if (buffer != nullptr) {
+            // application-owned instance buffers are only unreferenced, not destroyed
+            if (buffer != nullptr && GetExternalInstanceBuffer() == nullptr) {
                 buffer->Destroy();
             }
+            mInstanceMemory.allocation = nullptr;
             mInstanceMemory.buffer = VK_NULL_HANDLE;
         }
+        for (Ref<Buffer>& buffer : mStagedBuffers) {
+            buffer->Destroy();
+        }
+        mStagedBuffers.clear();
         if (mAccelerationStructure != VK_NULL_HANDLE) {
             // delete acceleration structure
             device->GetFencedDeleter()->DeleteWhenUnused(mAccelerationStructure);
@@ -124,16 +124,22 @@ namespace dawn_native { namespace vulkan {
                 geometryInfo.geometry.instances.pNext = nullptr;
 
                 // vertex buffer
-                if (geometry.vertex != nullptr && geometry.vertex->buffer != nullptr) {
-                    Buffer* vertexBuffer = ToBackend(geometry.vertex->buffer);
+                if (geometry.vertex != nullptr) {
+                    Buffer* vertexBuffer =
+                        geometry.vertex->buffer != nullptr
+                            ? ToBackend(geometry.vertex->buffer)
+                            : StageGeometryData(geometry.vertex->data, geometry.vertex->dataSize);
                     geometryInfo.geometry.triangles.vertexFormat =
                         ToVulkanAccelerationContainerVertexFormat(geometry.vertex->format);
                     geometryInfo.geometry.triangles.vertexStride = geometry.vertex->stride;
                     geometryInfo.geometry.triangles.vertexData.deviceAddress =
                         vertexBuffer->GetDeviceAddress();
                     // index buffer
-                    if (geometry.index != nullptr && geometry.index->buffer != nullptr) {
-                        Buffer* indexBuffer = ToBackend(geometry.index->buffer);
+                    if (geometry.index != nullptr) {
+                        Buffer* indexBuffer =
+                            geometry.index->buffer != nullptr
+                                ? ToBackend(geometry.index->buffer)
+                                : StageGeometryData(geometry.index->data, geometry.index->dataSize);
                         geometryInfo.geometry.triangles.indexType =
                             ToVulkanAccelerationContainerIndexFormat(geometry.index->format);
                         geometryInfo.geometry.triangles.indexData.deviceAddress =
@@ -150,8 +156,11 @@ namespace dawn_native { namespace vulkan {
                     }
                 }
                 // aabb buffer
-                if (geometry.aabb != nullptr && geometry.aabb->buffer != nullptr) {
-                    Buffer* aabbBuffer = ToBackend(geometry.aabb->buffer);
+                if (geometry.aabb != nullptr) {
+                    Buffer* aabbBuffer =
+                        geometry.aabb->buffer != nullptr
+                            ? ToBackend(geometry.aabb->buffer)
+                            : StageGeometryData(geometry.aabb->data, geometry.aabb->dataSize);
                     geometryInfo.geometry.aabbs.stride = geometry.aabb->stride;
                     geometryInfo.geometry.aabbs.data.deviceAddress = aabbBuffer->GetDeviceAddress();
                     // build offset
@@ -169,12 +178,21 @@ namespace dawn_native { namespace vulkan {
             uint64_t bufferSize =
                 descriptor->instanceCount * sizeof(VkAccelerationStructureInstanceKHR);
 
-            // create internal buffer holding instances
-            BufferDescriptor bufDescriptor = {
-                nullptr, nullptr, wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::RayTracing,
-                bufferSize};
-            Buffer* buffer = ToBackend(device->CreateBuffer(&bufDescriptor));
-            mInstanceMemory.allocation = AcquireRef(buffer);
+            Buffer* buffer = nullptr;
+            if (descriptor->instanceBuffer != nullptr) {
+                // the instance array lives in an application-owned buffer that the GPU
+                // fills, so builds consume it in place instead of staging through an
+                // internal copy
+                buffer = ToBackend(descriptor->instanceBuffer);
+                mInstanceMemory.allocation = buffer;
+            } else {
+                // create internal buffer holding instances
+                BufferDescriptor bufDescriptor = {
+                    nullptr, nullptr, wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::RayTracing,
+                    bufferSize};
+                buffer = ToBackend(device->CreateBuffer(&bufDescriptor));
+                mInstanceMemory.allocation = AcquireRef(buffer);
+            }
             mInstanceMemory.buffer = buffer->GetHandle();
             mInstanceMemory.offset = buffer->GetMemoryResource().GetOffset();
             mInstanceMemory.memory =
@@ -193,12 +211,13 @@ namespace dawn_native { namespace vulkan {
             mGeometries.push_back(geometryInfo);
 
             // copy instance data into instance buffer
-            std::vector<VkAccelerationStructureInstanceKHR> mInstances;
-            mInstances.reserve(descriptor->instanceCount);
-            for (unsigned int ii = 0; ii < descriptor->instanceCount; ++ii) {
-                mInstances.push_back(GetVkAccelerationInstance(descriptor->instances[ii]));
+            if (descriptor->instances != nullptr) {
+                mInstances.reserve(descriptor->instanceCount);
+                for (unsigned int ii = 0; ii < descriptor->instanceCount; ++ii) {
+                    mInstances.push_back(GetVkAccelerationInstance(descriptor->instances[ii]));
+                }
+                buffer->SetSubData(0, bufferSize, mInstances.data());
             }
-            buffer->SetSubData(0, bufferSize, mInstances.data());
 
             // build offset
             mBuildOffsets.push_back({descriptor->instanceCount, 0x0, 0, 0x0});
@@ -211,23 +230,21 @@ namespace dawn_native { namespace vulkan {
                 return result.AcquireError();
         }
 
-        // reserve scratch memory
+        // reserve result memory, build and update scratch is borrowed from the device's
+        // ScratchBufferPool at command recording time since it is only needed while the
+        // build command executes
         {
             VkMemoryRequirements resultRequirements = GetMemoryRequirements(
                 VK_ACCELERATION_STRUCTURE_MEMORY_REQUIREMENTS_TYPE_OBJECT_KHR);
 
-            VkMemoryRequirements buildRequirements = GetMemoryRequirements(
-                VK_ACCELERATION_STRUCTURE_MEMORY_REQUIREMENTS_TYPE_BUILD_SCRATCH_KHR);
+            DAWN_TRY(AllocateScratchMemory(mScratchMemory.result, resultRequirements));
 
-            VkMemoryRequirements updateRequirements = GetMemoryRequirements(
+            mBuildScratchSize = GetMemoryRequirementSize(
+                VK_ACCELERATION_STRUCTURE_MEMORY_REQUIREMENTS_TYPE_BUILD_SCRATCH_KHR);
+            mUpdateScratchSize = GetMemoryRequirementSize(
                 VK_ACCELERATION_STRUCTURE_MEMORY_REQUIREMENTS_TYPE_UPDATE_SCRATCH_KHR);
 
-            DAWN_TRY(AllocateScratchMemory(mScratchMemory.result, resultRequirements));
-            DAWN_TRY(AllocateScratchMemory(mScratchMemory.build, buildRequirements));
-            // update memory is optional
-            if (updateRequirements.size > 0) {
-                DAWN_TRY(AllocateScratchMemory(mScratchMemory.update, updateRequirements));
-            }
+            SetMemoryUsage(resultRequirements.size, mBuildScratchSize, mUpdateScratchSize);
         }
 
         // bind scratch result memory
@@ -266,14 +283,30 @@ namespace dawn_native { namespace vulkan {
         DestroyInternal();
     }
 
-    void RayTracingAccelerationContainer::DestroyScratchBuildMemory() {
+    uint64_t RayTracingAccelerationContainer::GetBuildScratchSize() const {
+        return mBuildScratchSize;
+    }
+
+    uint64_t RayTracingAccelerationContainer::GetUpdateScratchSize() const {
+        return mUpdateScratchSize;
+    }
+
+    Buffer* RayTracingAccelerationContainer::StageGeometryData(const uint8_t* data,
+                                                               uint32_t dataSize) {
         Device* device = ToBackend(GetDevice());
-        // delete scratch build memory
-        if (mScratchMemory.build.buffer != VK_NULL_HANDLE) {
-            device->DeallocateMemory(&mScratchMemory.build.resource);
-            device->GetFencedDeleter()->DeleteWhenUnused(mScratchMemory.build.buffer);
-            mScratchMemory.build.buffer = VK_NULL_HANDLE;
-        }
+
+        // create an internal buffer for the staged data so the streamer does not have to
+        // allocate one per mesh; the data travels through the dynamic uploader's ring and
+        // is copied over before the build command executes
+        BufferDescriptor bufDescriptor = {
+            nullptr, nullptr, wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::RayTracing,
+            dataSize};
+        Buffer* buffer = ToBackend(device->CreateBuffer(&bufDescriptor));
+        mStagedBuffers.push_back(AcquireRef(buffer));
+
+        buffer->SetSubData(0, dataSize, data);
+
+        return buffer;
     }
 
     MaybeError RayTracingAccelerationContainer::AllocateScratchMemory(
@@ -317,7 +350,10 @@ namespace dawn_native { namespace vulkan {
         requirements.alignment = bufferSizeRequirements.memoryRequirements.alignment;
         requirements.memoryTypeBits = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
-        DAWN_TRY_ASSIGN(memoryEntry.resource, device->AllocateMemory(requirements, false, true));
+        DAWN_TRY_ASSIGN(memoryEntry.resource,
+                        device->AllocateMemory(
+                            requirements, false, AllocationClass::AccelerationContainerResult,
+                            true));
 
         DAWN_TRY(CheckVkSuccess(device->fn.BindBufferMemory(
                                     device->GetVkDevice(), memoryEntry.buffer,
@@ -389,19 +425,19 @@ namespace dawn_native { namespace vulkan {
                 accelerationCreateGeometryInfo.vertexFormat = VK_FORMAT_UNDEFINED;
                 accelerationCreateGeometryInfo.indexType = VK_INDEX_TYPE_NONE_KHR;
                 // vertex buffer
-                if (geometry.vertex != nullptr && geometry.vertex->buffer != nullptr) {
+                if (geometry.vertex != nullptr) {
                     accelerationCreateGeometryInfo.maxVertexCount = geometry.vertex->count;
                     accelerationCreateGeometryInfo.vertexFormat =
                         ToVulkanAccelerationContainerVertexFormat(geometry.vertex->format);
                 }
                 // index buffer
-                if (geometry.index != nullptr && geometry.index->buffer != nullptr) {
+                if (geometry.index != nullptr) {
                     accelerationCreateGeometryInfo.indexType =
                         ToVulkanAccelerationContainerIndexFormat(geometry.index->format);
                     accelerationCreateGeometryInfo.maxPrimitiveCount = geometry.index->count;
                 }
                 // aabb buffer
-                if (geometry.aabb != nullptr && geometry.aabb->buffer != nullptr) {
+                if (geometry.aabb != nullptr) {
                     accelerationCreateGeometryInfo.maxPrimitiveCount = geometry.aabb->count;
                 }
                 accelerationGeometries.push_back(accelerationCreateGeometryInfo);
@@ -449,17 +485,49 @@ namespace dawn_native { namespace vulkan {
         return mInstanceMemory;
     }
 
-    MaybeError RayTracingAccelerationContainer::UpdateInstanceImpl(
-        uint32_t instanceIndex,
-        const RayTracingAccelerationInstanceDescriptor* descriptor) {
-        uint32_t start = instanceIndex * sizeof(VkAccelerationStructureInstanceKHR);
-        uint32_t count = sizeof(VkAccelerationStructureInstanceKHR);
-        VkAccelerationStructureInstanceKHR instanceData = GetVkAccelerationInstance(*descriptor);
-        mInstanceMemory.allocation.Get()->SetSubData(start, count,
-                                                     reinterpret_cast<void*>(&instanceData));
+    MaybeError RayTracingAccelerationContainer::UpdateInstancesImpl(
+        uint32_t startInstance,
+        uint32_t instanceCount,
+        const RayTracingAccelerationInstanceDescriptor* descriptors) {
+        // only write the shadow copy; the base class tracks the touched blocks and the
+        // upload happens in FlushInstanceUpdates once the data is actually consumed
+        for (uint32_t ii = 0; ii < instanceCount; ++ii) {
+            mInstances[startInstance + ii] = GetVkAccelerationInstance(descriptors[ii]);
+        }
         return {};
     }
 
+    MaybeError RayTracingAccelerationContainer::UpdateInstanceTransformsImpl(
+        uint32_t startInstance,
+        uint32_t instanceCount,
+        const float* transforms) {
+        // The transform lies at the start of VkAccelerationStructureInstanceKHR, so all
+        // the matrices convert in one strided pass over the shadow copy.
+        static_assert(offsetof(VkAccelerationStructureInstanceKHR, transform) == 0, "");
+        ConvertColumnMajor4x4ToRowMajor4x3(&mInstances[startInstance],
+                                           sizeof(VkAccelerationStructureInstanceKHR), transforms,
+                                           instanceCount);
+        return {};
+    }
+
+    MaybeError RayTracingAccelerationContainer::NeutralizeInstancesImpl(uint32_t startInstance,
+                                                                        uint32_t instanceCount) {
+        // A zeroed instance has a zero mask and a null acceleration structure handle, so
+        // it can never be intersected once the shadow copy is uploaded.
+        memset(&mInstances[startInstance], 0,
+               instanceCount * sizeof(VkAccelerationStructureInstanceKHR));
+        return {};
+    }
+
+    void RayTracingAccelerationContainer::FlushInstanceUpdates() {
+        ConsumeDirtyInstanceRanges([this](uint32_t firstInstance, uint32_t instanceCount) {
+            mInstanceMemory.allocation.Get()->SetSubData(
+                firstInstance * sizeof(VkAccelerationStructureInstanceKHR),
+                instanceCount * sizeof(VkAccelerationStructureInstanceKHR),
+                reinterpret_cast<void*>(&mInstances[firstInstance]));
+        });
+    }
+
     uint64_t RayTracingAccelerationContainer::GetHandle() const {
         return mAccelerationHandle;
     }
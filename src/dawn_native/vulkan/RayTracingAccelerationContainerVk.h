@@ -25,13 +25,13 @@ namespace dawn_native { namespace vulkan {
 
     class Device;
 
+    // Only the result memory is owned by the container; build and update scratch is
+    // borrowed from the device's ScratchBufferPool while build commands execute.
     struct ScratchMemoryPool {
         MemoryEntry result;
-        MemoryEntry update;
-        MemoryEntry build;
     };
 
-    class RayTracingAccelerationContainer : public RayTracingAccelerationContainerBase {
+    class RayTracingAccelerationContainer final : public RayTracingAccelerationContainerBase {
       public:
         static ResultOrError<RayTracingAccelerationContainer*> Create(
             Device* device,
@@ -46,16 +46,29 @@ namespace dawn_native { namespace vulkan {
 
         MemoryEntry& GetInstanceMemory();
 
+        // Uploads the dirty blocks of the instance shadow copy before a build or update
+        // command is recorded. Deferring the upload lets scattered per-frame instance
+        // updates of a large instance array pay only for the blocks they touched.
+        void FlushInstanceUpdates();
+
         ScratchMemoryPool& GetScratchMemory();
-        void DestroyScratchBuildMemory();
+
+        uint64_t GetBuildScratchSize() const;
+        uint64_t GetUpdateScratchSize() const;
 
       private:
         using RayTracingAccelerationContainerBase::RayTracingAccelerationContainerBase;
 
         void DestroyImpl() override;
-        MaybeError UpdateInstanceImpl(
-            uint32_t instanceIndex,
-            const RayTracingAccelerationInstanceDescriptor* descriptor) override;
+        MaybeError UpdateInstancesImpl(
+            uint32_t startInstance,
+            uint32_t instanceCount,
+            const RayTracingAccelerationInstanceDescriptor* descriptors) override;
+        MaybeError UpdateInstanceTransformsImpl(uint32_t startInstance,
+                                                uint32_t instanceCount,
+                                                const float* transforms) override;
+        MaybeError NeutralizeInstancesImpl(uint32_t startInstance,
+                                           uint32_t instanceCount) override;
 
         std::vector<VkAccelerationStructureGeometryKHR> mGeometries;
         std::vector<VkAccelerationStructureBuildOffsetInfoKHR> mBuildOffsets;
@@ -67,9 +80,23 @@ namespace dawn_native { namespace vulkan {
         // scratch memory
         ScratchMemoryPool mScratchMemory;
 
+        // scratch requirements, serviced by the device's ScratchBufferPool
+        uint64_t mBuildScratchSize = 0;
+        uint64_t mUpdateScratchSize = 0;
+
         // instance buffer
         MemoryEntry mInstanceMemory;
 
+        // instance updates are written into this shadow copy and the dirty spans tracked
+        // by the base class are uploaded once the next build or update command is recorded
+        std::vector<VkAccelerationStructureInstanceKHR> mInstances;
+
+        // internal buffers holding geometry data that was staged through the dynamic
+        // uploader instead of being provided in an external buffer
+        std::vector<Ref<Buffer>> mStagedBuffers;
+
+        Buffer* StageGeometryData(const uint8_t* data, uint32_t dataSize);
+
         VkMemoryRequirements GetMemoryRequirements(
             VkAccelerationStructureMemoryRequirementsTypeKHR type) const;
         uint64_t GetMemoryRequirementSize(
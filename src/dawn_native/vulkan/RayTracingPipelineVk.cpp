@@ -14,6 +14,7 @@
 
 #include "dawn_native/vulkan/RayTracingPipelineVk.h"
 
+#include "common/HashUtils.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/PipelineLayoutVk.h"
@@ -23,8 +24,81 @@
 #include "dawn_native/vulkan/UtilsVulkan.h"
 #include "dawn_native/vulkan/VulkanError.h"
 
+#include <array>
+#include <vector>
+
 namespace dawn_native { namespace vulkan {
 
+    namespace {
+
+        // Returns the device-cached library pipeline for |group|, compiling it on a cache
+        // miss. The key covers everything that affects the compiled group: its shaders,
+        // the pipeline layout, the recursion depth and the library interface.
+        ResultOrError<VkPipeline> GetOrCreateGroupLibrary(
+            Device* device,
+            const VkPipelineShaderStageCreateInfo* stages,
+            const VkRayTracingShaderGroupCreateInfoKHR& group,
+            VkPipelineLayout layout,
+            uint32_t maxRecursionDepth,
+            const VkRayTracingPipelineInterfaceCreateInfoKHR* interfaceInfo) {
+            // Gather the stages the group references and remap its indices into the
+            // library's local stage array.
+            std::array<VkPipelineShaderStageCreateInfo, 4> localStages;
+            uint32_t localStageCount = 0;
+            VkRayTracingShaderGroupCreateInfoKHR localGroup = group;
+            uint32_t* shaderIndices[4] = {&localGroup.generalShader, &localGroup.closestHitShader,
+                                          &localGroup.anyHitShader,
+                                          &localGroup.intersectionShader};
+
+            size_t key = 0;
+            HashCombine(&key, group.type, layout.GetHandle(), maxRecursionDepth,
+                        interfaceInfo->maxPayloadSize, interfaceInfo->maxAttributeSize);
+            for (uint32_t* shaderIndex : shaderIndices) {
+                if (*shaderIndex == VK_SHADER_UNUSED_KHR) {
+                    // Keep the role of each shader in the hash even when unused.
+                    HashCombine(&key, uint64_t(0));
+                    continue;
+                }
+                const VkPipelineShaderStageCreateInfo& stage = stages[*shaderIndex];
+                HashCombine(&key, stage.module);
+                localStages[localStageCount] = stage;
+                *shaderIndex = localStageCount++;
+            }
+
+            VkPipeline library = device->GetCachedPipelineLibrary(key);
+            if (library != VK_NULL_HANDLE) {
+                return library;
+            }
+
+            VkRayTracingPipelineCreateInfoKHR createInfo;
+            createInfo.sType = VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_CREATE_INFO_KHR;
+            createInfo.pNext = nullptr;
+            createInfo.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+            createInfo.stageCount = localStageCount;
+            createInfo.pStages = localStages.data();
+            createInfo.groupCount = 1;
+            createInfo.pGroups = &localGroup;
+            createInfo.maxRecursionDepth = maxRecursionDepth;
+            createInfo.libraries.sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+            createInfo.libraries.pNext = nullptr;
+            createInfo.libraries.libraryCount = 0;
+            createInfo.libraries.pLibraries = nullptr;
+            createInfo.pLibraryInterface = interfaceInfo;
+            createInfo.layout = layout;
+            createInfo.basePipelineHandle = VK_NULL_HANDLE;
+            createInfo.basePipelineIndex = 0;
+
+            DAWN_TRY(CheckVkSuccess(
+                device->fn.CreateRayTracingPipelinesKHR(device->GetVkDevice(),
+                                                        device->GetPipelineCache(), 1, &createInfo,
+                                                        nullptr, &*library),
+                "vkCreateRayTracingPipelinesKHR"));
+            device->CachePipelineLibrary(key, library);
+            return library;
+        }
+
+    }  // anonymous namespace
+
     // static
     ResultOrError<RayTracingPipeline*> RayTracingPipeline::Create(
         Device* device,
@@ -37,26 +111,26 @@ namespace dawn_native { namespace vulkan {
 
     MaybeError RayTracingPipeline::Initialize(const RayTracingPipelineDescriptor* descriptor) {
         Device* device = ToBackend(GetDevice());
-        Adapter* adapter = ToBackend(device->GetAdapter());
-
-        VkPhysicalDeviceRayTracingPropertiesKHR rtProperties =
-            GetPhysicalDeviceRayTracingProperties(*adapter);
 
         RayTracingShaderBindingTable* shaderBindingTable =
             ToBackend(descriptor->rayTracingState->shaderBindingTable);
 
-        std::vector<VkPipelineShaderStageCreateInfo> stages = shaderBindingTable->GetStages();
-        std::vector<VkRayTracingShaderGroupCreateInfoKHR> groups = shaderBindingTable->GetGroups();
+        // When VK_KHR_pipeline_library is available, build the pipeline by linking
+        // per-group libraries so that groups shared with previous pipelines are only
+        // compiled once.
+        if (device->GetDeviceInfo().pipelineLibrary) {
+            return InitializeFromLibraries(descriptor, shaderBindingTable);
+        }
 
         {
             VkRayTracingPipelineCreateInfoKHR createInfo;
             createInfo.sType = VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_CREATE_INFO_KHR;
             createInfo.pNext = nullptr;
             createInfo.flags = 0;
-            createInfo.pStages = stages.data();
-            createInfo.stageCount = stages.size();
-            createInfo.pGroups = groups.data();
-            createInfo.groupCount = groups.size();
+            createInfo.pStages = shaderBindingTable->GetStages();
+            createInfo.stageCount = shaderBindingTable->GetStageCount();
+            createInfo.pGroups = shaderBindingTable->GetGroups();
+            createInfo.groupCount = shaderBindingTable->GetGroupCount();
             createInfo.maxRecursionDepth = descriptor->rayTracingState->maxRecursionDepth;
             createInfo.layout = ToBackend(descriptor->layout)->GetHandle();
             createInfo.basePipelineHandle = VK_NULL_HANDLE;
@@ -68,26 +142,73 @@ namespace dawn_native { namespace vulkan {
             createInfo.pLibraryInterface = nullptr;
 
             MaybeError result = CheckVkSuccess(
-                device->fn.CreateRayTracingPipelinesKHR(device->GetVkDevice(), VK_NULL_HANDLE, 1,
-                                                        &createInfo, nullptr, &*mHandle),
+                device->fn.CreateRayTracingPipelinesKHR(device->GetVkDevice(),
+                                                        device->GetPipelineCache(), 1, &createInfo,
+                                                        nullptr, &*mHandle),
                 "vkCreateRayTracingPipelinesKHR");
             if (result.IsError())
                 return result.AcquireError();
         }
 
-        {
-            uint64_t bufferSize = groups.size() * rtProperties.shaderGroupHandleSize;
+        DAWN_TRY(shaderBindingTable->PopulateGroupHandles(mHandle));
 
-            void* sbtData = shaderBindingTable->GetGroupBufferResource().GetMappedPointer();
+        return {};
+    }
 
-            MaybeError result = CheckVkSuccess(
-                device->fn.GetRayTracingShaderGroupHandlesKHR(device->GetVkDevice(), mHandle, 0,
-                                                              groups.size(), bufferSize, sbtData),
-                "vkGetRayTracingShaderGroupHandlesKHR");
-            if (result.IsError())
-                return result.AcquireError();
+    MaybeError RayTracingPipeline::InitializeFromLibraries(
+        const RayTracingPipelineDescriptor* descriptor,
+        RayTracingShaderBindingTable* shaderBindingTable) {
+        Device* device = ToBackend(GetDevice());
+
+        uint32_t maxRecursionDepth = descriptor->rayTracingState->maxRecursionDepth;
+        VkPipelineLayout layout = ToBackend(descriptor->layout)->GetHandle();
+
+        // Every library and the linked pipeline must agree on the interface.
+        VkRayTracingPipelineInterfaceCreateInfoKHR interfaceInfo;
+        interfaceInfo.sType = VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_INTERFACE_CREATE_INFO_KHR;
+        interfaceInfo.pNext = nullptr;
+        interfaceInfo.maxPayloadSize = descriptor->rayTracingState->maxPayloadSize;
+        // Built-in triangle intersection reports two barycentric coordinates.
+        interfaceInfo.maxAttributeSize = 2 * sizeof(float);
+        interfaceInfo.maxCallableSize = 0;
+
+        // Libraries are linked in group order so that group handle indices in the
+        // linked pipeline match the shader binding table's group indices.
+        uint32_t groupCount = shaderBindingTable->GetGroupCount();
+        std::vector<VkPipeline> libraries(groupCount);
+        for (uint32_t ii = 0; ii < groupCount; ++ii) {
+            DAWN_TRY_ASSIGN(libraries[ii], GetOrCreateGroupLibrary(
+                                               device, shaderBindingTable->GetStages(),
+                                               shaderBindingTable->GetGroups()[ii], layout,
+                                               maxRecursionDepth, &interfaceInfo));
         }
 
+        VkRayTracingPipelineCreateInfoKHR createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_CREATE_INFO_KHR;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.stageCount = 0;
+        createInfo.pStages = nullptr;
+        createInfo.groupCount = 0;
+        createInfo.pGroups = nullptr;
+        createInfo.maxRecursionDepth = maxRecursionDepth;
+        createInfo.libraries.sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+        createInfo.libraries.pNext = nullptr;
+        createInfo.libraries.libraryCount = groupCount;
+        createInfo.libraries.pLibraries = AsVkArray(libraries.data());
+        createInfo.pLibraryInterface = &interfaceInfo;
+        createInfo.layout = layout;
+        createInfo.basePipelineHandle = VK_NULL_HANDLE;
+        createInfo.basePipelineIndex = 0;
+
+        DAWN_TRY(CheckVkSuccess(
+            device->fn.CreateRayTracingPipelinesKHR(device->GetVkDevice(),
+                                                    device->GetPipelineCache(), 1, &createInfo,
+                                                    nullptr, &*mHandle),
+            "vkCreateRayTracingPipelinesKHR"));
+
+        DAWN_TRY(shaderBindingTable->PopulateGroupHandles(mHandle));
+
         return {};
     }
 
@@ -27,8 +27,9 @@
 namespace dawn_native { namespace vulkan {
 
     class Device;
+    class RayTracingShaderBindingTable;
 
-    class RayTracingPipeline : public RayTracingPipelineBase {
+    class RayTracingPipeline final : public RayTracingPipelineBase {
       public:
         static ResultOrError<RayTracingPipeline*> Create(
             Device* device,
@@ -40,6 +41,11 @@ namespace dawn_native { namespace vulkan {
       private:
         using RayTracingPipelineBase::RayTracingPipelineBase;
         MaybeError Initialize(const RayTracingPipelineDescriptor* descriptor);
+        // Compiles each shader group into a device-cached pipeline library and links the
+        // libraries, so pipelines that share groups with earlier ones only compile the
+        // new groups. Used when VK_KHR_pipeline_library is available.
+        MaybeError InitializeFromLibraries(const RayTracingPipelineDescriptor* descriptor,
+                                           RayTracingShaderBindingTable* shaderBindingTable);
 
         VkPipeline mHandle = VK_NULL_HANDLE;
     };
@@ -14,6 +14,8 @@
 
 #include "dawn_native/vulkan/RayTracingShaderBindingTableVk.h"
 
+#include <cstring>
+
 #include "dawn_native/vulkan/AdapterVk.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
@@ -57,7 +59,24 @@ namespace dawn_native { namespace vulkan {
 
         mShaderGroupHandleSize = rtProperties.shaderGroupHandleSize;
 
-        mStages.reserve(descriptor->stageCount);
+        // Pre-pass: size one allocation for everything captured from the descriptor. The
+        // section sizes are all multiples of 8 bytes except the trailing handle bytes, so
+        // laying them out in this order keeps every section naturally aligned.
+        mStageCount = descriptor->stageCount;
+        const uint32_t groupCount = descriptor->groupCount;
+        const size_t stagesSize = mStageCount * sizeof(VkPipelineShaderStageCreateInfo);
+        const size_t groupsSize = groupCount * sizeof(VkRayTracingShaderGroupCreateInfoKHR);
+        const size_t recordsSize = groupCount * sizeof(uint32_t);
+        const size_t handlesSize = groupCount * mShaderGroupHandleSize;
+        mCaptureData =
+            std::make_unique<uint8_t[]>(stagesSize + groupsSize + recordsSize + handlesSize);
+        mStages = reinterpret_cast<VkPipelineShaderStageCreateInfo*>(mCaptureData.get());
+        mGroups =
+            reinterpret_cast<VkRayTracingShaderGroupCreateInfoKHR*>(mCaptureData.get() + stagesSize);
+        mRecordGroupIndices =
+            reinterpret_cast<uint32_t*>(mCaptureData.get() + stagesSize + groupsSize);
+        mGroupHandles = mCaptureData.get() + stagesSize + groupsSize + recordsSize;
+
         for (unsigned int ii = 0; ii < descriptor->stageCount; ++ii) {
             const RayTracingShaderBindingTableStageDescriptor& stage = descriptor->stages[ii];
             VkPipelineShaderStageCreateInfo stageInfo;
@@ -68,11 +87,18 @@ namespace dawn_native { namespace vulkan {
                 static_cast<VkShaderStageFlagBits>(ToVulkanShaderStageFlags(stage.stage));
             stageInfo.module = ToBackend(stage.module)->GetHandle();
             stageInfo.pName = "main";
+            // Specialization storage is captured alongside the stage infos; the pipeline
+            // libraries built from this table read it at creation time. unique_ptr keeps
+            // the referenced storage at a stable address as stages are added.
             stageInfo.pSpecializationInfo = nullptr;
-            mStages.push_back(stageInfo);
+            if (stage.constantCount > 0) {
+                mSpecializations.push_back(std::make_unique<SpecializationInfoStorage>());
+                stageInfo.pSpecializationInfo = BuildSpecializationInfo(
+                    stage.constantCount, stage.constants, mSpecializations.back().get());
+            }
+            mStages[ii] = stageInfo;
         }
 
-        mGroups.reserve(descriptor->groupCount);
         for (unsigned int ii = 0; ii < descriptor->groupCount; ++ii) {
             const RayTracingShaderBindingTableGroupDescriptor& group = descriptor->groups[ii];
             VkRayTracingShaderGroupCreateInfoKHR groupInfo;
@@ -96,10 +122,15 @@ namespace dawn_native { namespace vulkan {
             if (group.intersectionIndex != -1) {
                 groupInfo.intersectionShader = group.intersectionIndex;
             }
-            mGroups.push_back(groupInfo);
+            mGroups[ii] = groupInfo;
         }
 
-        uint64_t bufferSize = mGroups.size() * rtProperties.shaderGroupHandleSize;
+        // Each record initially points at the group with the same index.
+        for (uint32_t ii = 0; ii < groupCount; ++ii) {
+            mRecordGroupIndices[ii] = ii;
+        }
+
+        uint64_t bufferSize = uint64_t(groupCount) * rtProperties.shaderGroupHandleSize;
 
         VkBufferCreateInfo createInfo;
         createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -118,7 +149,8 @@ namespace dawn_native { namespace vulkan {
         VkMemoryRequirements requirements;
         device->fn.GetBufferMemoryRequirements(device->GetVkDevice(), mGroupBuffer, &requirements);
 
-        DAWN_TRY_ASSIGN(mGroupBufferResource, device->AllocateMemory(requirements, true));
+        DAWN_TRY_ASSIGN(mGroupBufferResource,
+                        device->AllocateMemory(requirements, true, AllocationClass::Buffer));
 
         DAWN_TRY(CheckVkSuccess(device->fn.BindBufferMemory(
                                     device->GetVkDevice(), mGroupBuffer,
@@ -133,14 +165,55 @@ namespace dawn_native { namespace vulkan {
         DestroyInternal();
     }
 
-    std::vector<VkRayTracingShaderGroupCreateInfoKHR>& RayTracingShaderBindingTable::GetGroups() {
+    MaybeError RayTracingShaderBindingTable::PopulateGroupHandles(VkPipeline pipeline) {
+        Device* device = ToBackend(GetDevice());
+
+        const uint32_t groupCount = GetGroupCount();
+        DAWN_TRY(CheckVkSuccess(
+            device->fn.GetRayTracingShaderGroupHandlesKHR(
+                device->GetVkDevice(), pipeline, 0, groupCount,
+                groupCount * mShaderGroupHandleSize, mGroupHandles),
+            "vkGetRayTracingShaderGroupHandlesKHR"));
+        mGroupHandlesPopulated = true;
+
+        for (uint32_t ii = 0; ii < groupCount; ++ii) {
+            WriteRecord(ii, mRecordGroupIndices[ii]);
+        }
+        return {};
+    }
+
+    void RayTracingShaderBindingTable::WriteRecord(uint32_t recordIndex, uint32_t groupIndex) {
+        uint8_t* records = static_cast<uint8_t*>(mGroupBufferResource.GetMappedPointer());
+        memcpy(records + recordIndex * mShaderGroupHandleSize,
+               mGroupHandles + groupIndex * mShaderGroupHandleSize, mShaderGroupHandleSize);
+    }
+
+    MaybeError RayTracingShaderBindingTable::UpdateGroupsImpl(uint32_t startGroup,
+                                                              uint32_t groupCount,
+                                                              const uint32_t* sourceGroupIndices) {
+        for (uint32_t ii = 0; ii < groupCount; ++ii) {
+            mRecordGroupIndices[startGroup + ii] = sourceGroupIndices[ii];
+            // Before the first pipeline is created against this table there are no handles
+            // yet; the records are written by PopulateGroupHandles instead.
+            if (mGroupHandlesPopulated) {
+                WriteRecord(startGroup + ii, sourceGroupIndices[ii]);
+            }
+        }
+        return {};
+    }
+
+    const VkRayTracingShaderGroupCreateInfoKHR* RayTracingShaderBindingTable::GetGroups() const {
         return mGroups;
     }
 
-    std::vector<VkPipelineShaderStageCreateInfo>& RayTracingShaderBindingTable::GetStages() {
+    const VkPipelineShaderStageCreateInfo* RayTracingShaderBindingTable::GetStages() const {
         return mStages;
     }
 
+    uint32_t RayTracingShaderBindingTable::GetStageCount() const {
+        return mStageCount;
+    }
+
     VkBuffer RayTracingShaderBindingTable::GetGroupBufferHandle() const {
         return mGroupBuffer;
     }
@@ -153,4 +226,9 @@ namespace dawn_native { namespace vulkan {
         return mShaderGroupHandleSize;
     }
 
+    uint32_t RayTracingShaderBindingTable::GetGroupStrideImpl() const {
+        // Records are exactly one driver group handle, written back to back.
+        return mShaderGroupHandleSize;
+    }
+
 }}  // namespace dawn_native::vulkan
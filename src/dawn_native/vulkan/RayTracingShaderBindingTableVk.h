@@ -15,44 +15,73 @@
 #ifndef DAWNNATIVE_VULKAN_RAY_TRACING_SHADER_BINDING_TABLE_H_
 #define DAWNNATIVE_VULKAN_RAY_TRACING_SHADER_BINDING_TABLE_H_
 
+#include <memory>
 #include <vector>
 
 #include "common/vulkan_platform.h"
 #include "dawn_native/RayTracingShaderBindingTable.h"
 #include "dawn_native/ResourceMemoryAllocation.h"
+#include "dawn_native/vulkan/UtilsVulkan.h"
 
 namespace dawn_native { namespace vulkan {
 
     class Device;
 
-    class RayTracingShaderBindingTable : public RayTracingShaderBindingTableBase {
+    class RayTracingShaderBindingTable final : public RayTracingShaderBindingTableBase {
       public:
         static ResultOrError<RayTracingShaderBindingTable*> Create(
             Device* device,
             const RayTracingShaderBindingTableDescriptor* descriptor);
         ~RayTracingShaderBindingTable() override;
 
-        std::vector<VkPipelineShaderStageCreateInfo>& GetStages();
-        std::vector<VkRayTracingShaderGroupCreateInfoKHR>& GetGroups();
+        const VkPipelineShaderStageCreateInfo* GetStages() const;
+        uint32_t GetStageCount() const;
+        const VkRayTracingShaderGroupCreateInfoKHR* GetGroups() const;
 
         uint32_t GetShaderGroupHandleSize() const;
 
         VkBuffer GetGroupBufferHandle() const;
         ResourceMemoryAllocation GetGroupBufferResource() const;
 
+        // Queries the group handles from the pipeline and writes every record of the group
+        // buffer. Called by RayTracingPipeline when it is created against this table.
+        MaybeError PopulateGroupHandles(VkPipeline pipeline);
+
       private:
         using RayTracingShaderBindingTableBase::RayTracingShaderBindingTableBase;
 
         void DestroyImpl() override;
-
-        std::vector<VkPipelineShaderStageCreateInfo> mStages;
-        std::vector<VkRayTracingShaderGroupCreateInfoKHR> mGroups;
+        MaybeError UpdateGroupsImpl(uint32_t startGroup,
+                                    uint32_t groupCount,
+                                    const uint32_t* sourceGroupIndices) override;
+        uint32_t GetGroupStrideImpl() const override;
+
+        void WriteRecord(uint32_t recordIndex, uint32_t groupIndex);
+
+        // All descriptor capture lives in a single allocation sized by a pre-pass in
+        // Initialize: the stage infos, the group infos, which group each record of the
+        // group buffer points at, and a CPU copy of the queried group handles so single
+        // records can be rewritten without touching the pipeline again. The sections are
+        // ordered by decreasing alignment so no padding is needed between them.
+        std::unique_ptr<uint8_t[]> mCaptureData;
+        VkPipelineShaderStageCreateInfo* mStages = nullptr;
+        uint32_t mStageCount = 0;
+        VkRayTracingShaderGroupCreateInfoKHR* mGroups = nullptr;
+        uint32_t* mRecordGroupIndices = nullptr;
+        uint8_t* mGroupHandles = nullptr;
+        // The handles section is only valid once the first pipeline created against this
+        // table has been queried in PopulateGroupHandles.
+        bool mGroupHandlesPopulated = false;
+
+        // Specialization constant storage referenced by the captured stage infos; kept
+        // behind unique_ptrs so the addresses stay stable for the table's lifetime.
+        std::vector<std::unique_ptr<SpecializationInfoStorage>> mSpecializations;
 
         // group handle buffer
         VkBuffer mGroupBuffer = VK_NULL_HANDLE;
         ResourceMemoryAllocation mGroupBufferResource;
 
-        uint32_t mShaderGroupHandleSize;
+        uint32_t mShaderGroupHandleSize = 0;
 
         MaybeError Initialize(const RayTracingShaderBindingTableDescriptor* descriptor);
     };
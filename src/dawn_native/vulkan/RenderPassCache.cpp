@@ -66,6 +66,8 @@ namespace dawn_native { namespace vulkan {
     }
 
     RenderPassCache::~RenderPassCache() {
+        // The compatibility cache only aliases render passes owned by mCache.
+        mCompatibilityCache.clear();
         for (auto it : mCache) {
             mDevice->fn.DestroyRenderPass(mDevice->GetVkDevice(), it.second, nullptr);
         }
@@ -81,9 +83,23 @@ namespace dawn_native { namespace vulkan {
         VkRenderPass renderPass;
         DAWN_TRY_ASSIGN(renderPass, CreateRenderPassForQuery(query));
         mCache.emplace(query, renderPass);
+
+        // The first load-op variant created for an attachment combination becomes the
+        // representative compatible render pass for it.
+        mCompatibilityCache.emplace(query, renderPass);
         return renderPass;
     }
 
+    ResultOrError<VkRenderPass> RenderPassCache::GetCompatibleRenderPass(
+        const RenderPassCacheQuery& query) {
+        auto it = mCompatibilityCache.find(query);
+        if (it != mCompatibilityCache.end()) {
+            return VkRenderPass(it->second);
+        }
+
+        return GetRenderPass(query);
+    }
+
     ResultOrError<VkRenderPass> RenderPassCache::CreateRenderPassForQuery(
         const RenderPassCacheQuery& query) const {
         // The Vulkan subpasses want to know the layout of the attachments with VkAttachmentRef.
@@ -252,4 +268,58 @@ namespace dawn_native { namespace vulkan {
 
         return true;
     }
+
+    size_t RenderPassCache::CompatibilityCacheFuncs::operator()(
+        const RenderPassCacheQuery& query) const {
+        size_t hash = Hash(query.colorMask);
+
+        HashCombine(&hash, Hash(query.resolveTargetMask));
+
+        for (uint32_t i : IterateBitSet(query.colorMask)) {
+            HashCombine(&hash, query.colorFormats[i]);
+        }
+
+        HashCombine(&hash, query.hasDepthStencil);
+        if (query.hasDepthStencil) {
+            HashCombine(&hash, query.depthStencilFormat);
+        }
+
+        HashCombine(&hash, query.sampleCount);
+
+        return hash;
+    }
+
+    bool RenderPassCache::CompatibilityCacheFuncs::operator()(
+        const RenderPassCacheQuery& a,
+        const RenderPassCacheQuery& b) const {
+        if (a.colorMask != b.colorMask) {
+            return false;
+        }
+
+        if (a.resolveTargetMask != b.resolveTargetMask) {
+            return false;
+        }
+
+        if (a.sampleCount != b.sampleCount) {
+            return false;
+        }
+
+        for (uint32_t i : IterateBitSet(a.colorMask)) {
+            if (a.colorFormats[i] != b.colorFormats[i]) {
+                return false;
+            }
+        }
+
+        if (a.hasDepthStencil != b.hasDepthStencil) {
+            return false;
+        }
+
+        if (a.hasDepthStencil) {
+            if (a.depthStencilFormat != b.depthStencilFormat) {
+                return false;
+            }
+        }
+
+        return true;
+    }
 }}  // namespace dawn_native::vulkan
@@ -68,6 +68,12 @@ namespace dawn_native { namespace vulkan {
 
         ResultOrError<VkRenderPass> GetRenderPass(const RenderPassCacheQuery& query);
 
+        // Returns a VkRenderPass that is compatible with |query| in the sense of the Vulkan
+        // render pass compatibility rules: attachment formats, masks and sample count match but
+        // load ops are ignored. Pipelines only need a compatible render pass so this reuses
+        // whichever load-op variant was cached first instead of creating a new VkRenderPass.
+        ResultOrError<VkRenderPass> GetCompatibleRenderPass(const RenderPassCacheQuery& query);
+
       private:
         // Does the actual VkRenderPass creation on a cache miss.
         ResultOrError<VkRenderPass> CreateRenderPassForQuery(
@@ -82,8 +88,20 @@ namespace dawn_native { namespace vulkan {
         using Cache =
             std::unordered_map<RenderPassCacheQuery, VkRenderPass, CacheFuncs, CacheFuncs>;
 
+        // Same as CacheFuncs but ignores load ops so that all load-op variants of a query map
+        // to the same bucket. Entries alias render passes owned by mCache.
+        struct CompatibilityCacheFuncs {
+            size_t operator()(const RenderPassCacheQuery& query) const;
+            bool operator()(const RenderPassCacheQuery& a, const RenderPassCacheQuery& b) const;
+        };
+        using CompatibilityCache = std::unordered_map<RenderPassCacheQuery,
+                                                      VkRenderPass,
+                                                      CompatibilityCacheFuncs,
+                                                      CompatibilityCacheFuncs>;
+
         Device* mDevice = nullptr;
         Cache mCache;
+        CompatibilityCache mCompatibilityCache;
     };
 
 }}  // namespace dawn_native::vulkan
@@ -336,12 +336,16 @@ namespace dawn_native { namespace vulkan {
         Device* device = ToBackend(GetDevice());
 
         VkPipelineShaderStageCreateInfo shaderStages[2];
+        SpecializationInfoStorage vertexSpecialization;
+        SpecializationInfoStorage fragmentSpecialization;
         {
             shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
             shaderStages[0].pNext = nullptr;
             shaderStages[0].flags = 0;
             shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
-            shaderStages[0].pSpecializationInfo = nullptr;
+            shaderStages[0].pSpecializationInfo =
+                BuildSpecializationInfo(descriptor->vertexStage.constantCount,
+                                        descriptor->vertexStage.constants, &vertexSpecialization);
             shaderStages[0].module = ToBackend(descriptor->vertexStage.module)->GetHandle();
             shaderStages[0].pName = descriptor->vertexStage.entryPoint;
 
@@ -349,7 +353,9 @@ namespace dawn_native { namespace vulkan {
             shaderStages[1].pNext = nullptr;
             shaderStages[1].flags = 0;
             shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-            shaderStages[1].pSpecializationInfo = nullptr;
+            shaderStages[1].pSpecializationInfo = BuildSpecializationInfo(
+                descriptor->fragmentStage->constantCount, descriptor->fragmentStage->constants,
+                &fragmentSpecialization);
             shaderStages[1].module = ToBackend(descriptor->fragmentStage->module)->GetHandle();
             shaderStages[1].pName = descriptor->fragmentStage->entryPoint;
         }
@@ -458,8 +464,9 @@ namespace dawn_native { namespace vulkan {
         dynamic.dynamicStateCount = sizeof(dynamicStates) / sizeof(dynamicStates[0]);
         dynamic.pDynamicStates = dynamicStates;
 
-        // Get a VkRenderPass that matches the attachment formats for this pipeline, load ops don't
-        // matter so set them all to LoadOp::Load
+        // Get a VkRenderPass that matches the attachment formats for this pipeline. Load ops
+        // don't matter for compatibility so ask the cache for any compatible render pass
+        // instead of forcing the creation of a LoadOp::Load variant.
         VkRenderPass renderPass = VK_NULL_HANDLE;
         {
             RenderPassCacheQuery query;
@@ -475,7 +482,8 @@ namespace dawn_native { namespace vulkan {
 
             query.SetSampleCount(GetSampleCount());
 
-            DAWN_TRY_ASSIGN(renderPass, device->GetRenderPassCache()->GetRenderPass(query));
+            DAWN_TRY_ASSIGN(renderPass,
+                            device->GetRenderPassCache()->GetCompatibleRenderPass(query));
         }
 
         // The create info chains in a bunch of things created on the stack here or inside state
@@ -502,7 +510,7 @@ namespace dawn_native { namespace vulkan {
         createInfo.basePipelineIndex = -1;
 
         return CheckVkSuccess(
-            device->fn.CreateGraphicsPipelines(device->GetVkDevice(), VkPipelineCache{}, 1,
+            device->fn.CreateGraphicsPipelines(device->GetVkDevice(), device->GetPipelineCache(), 1,
                                                &createInfo, nullptr, &*mHandle),
             "CreateGraphicsPipeline");
     }
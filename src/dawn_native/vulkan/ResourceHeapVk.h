@@ -21,7 +21,7 @@
 namespace dawn_native { namespace vulkan {
 
     // Wrapper for physical memory used with or without a resource object.
-    class ResourceHeap : public ResourceHeapBase {
+    class ResourceHeap final : public ResourceHeapBase {
       public:
         ResourceHeap(VkDeviceMemory memory, size_t memoryType);
         ~ResourceHeap() = default;
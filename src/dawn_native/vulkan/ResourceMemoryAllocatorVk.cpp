@@ -35,6 +35,10 @@ namespace dawn_native { namespace vulkan {
         // size
         constexpr uint64_t kBuddyHeapsSize = 2 * kMaxSizeForSubAllocation;
 
+        // Above this size drivers commonly prefer dedicated allocations (tiling optimizations,
+        // page table savings), so use them even without an explicit hint.
+        constexpr uint64_t kDedicatedAllocationSizeThreshold = 64ull * 1024ull * 1024ull;  // 64MB
+
     }  // anonymous namespace
 
     // SingleTypeAllocator is a combination of a BuddyMemoryAllocator and its client and can
@@ -54,6 +58,23 @@ namespace dawn_native { namespace vulkan {
             return mBuddySystem.Allocate(requirements.size, requirements.alignment);
         }
 
+        // Allocates memory exclusively for `dedicatedBuffer` or `dedicatedImage` using
+        // VK_KHR_dedicated_allocation so the driver can apply resource-specific optimizations.
+        ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateDedicatedResourceHeap(
+            uint64_t size,
+            VkBuffer dedicatedBuffer,
+            VkImage dedicatedImage) {
+            ASSERT(mDevice->GetDeviceInfo().dedicatedAllocation);
+
+            VkMemoryDedicatedAllocateInfo dedicatedInfo;
+            dedicatedInfo.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+            dedicatedInfo.pNext = nullptr;
+            dedicatedInfo.buffer = dedicatedBuffer;
+            dedicatedInfo.image = dedicatedImage;
+
+            return AllocateResourceHeapInternal(size, &dedicatedInfo);
+        }
+
         void DeallocateMemory(const ResourceMemoryAllocation& allocation) {
             mBuddySystem.Deallocate(allocation);
         }
@@ -62,9 +83,20 @@ namespace dawn_native { namespace vulkan {
 
         ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(
             uint64_t size) override {
+            return AllocateResourceHeapInternal(size, nullptr);
+        }
+
+        void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override {
+            mDevice->GetFencedDeleter()->DeleteWhenUnused(ToBackend(allocation.get())->GetMemory());
+        }
+
+      private:
+        ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeapInternal(
+            uint64_t size,
+            VkMemoryDedicatedAllocateInfo* dedicatedInfo) {
             VkMemoryAllocateInfo allocateInfo;
             allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-            allocateInfo.pNext = nullptr;
+            allocateInfo.pNext = dedicatedInfo;
             allocateInfo.allocationSize = size;
             allocateInfo.memoryTypeIndex = mMemoryTypeIndex;
 
@@ -72,7 +104,7 @@ namespace dawn_native { namespace vulkan {
             VkMemoryAllocateFlagsInfo memoryAllocateFlagsInfo;
             if (mDevice->IsExtensionEnabled(Extension::RayTracing)) {
                 memoryAllocateFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
-                memoryAllocateFlagsInfo.pNext = nullptr;
+                memoryAllocateFlagsInfo.pNext = allocateInfo.pNext;
                 memoryAllocateFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
                 memoryAllocateFlagsInfo.deviceMask = 0;
                 allocateInfo.pNext = &memoryAllocateFlagsInfo;
@@ -90,11 +122,6 @@ namespace dawn_native { namespace vulkan {
             return {std::make_unique<ResourceHeap>(allocatedMemory, mMemoryTypeIndex)};
         }
 
-        void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override {
-            mDevice->GetFencedDeleter()->DeleteWhenUnused(ToBackend(allocation.get())->GetMemory());
-        }
-
-      private:
         Device* mDevice;
         size_t mMemoryTypeIndex;
         BuddyMemoryAllocator mBuddySystem;
@@ -116,28 +143,61 @@ namespace dawn_native { namespace vulkan {
     ResultOrError<ResourceMemoryAllocation> ResourceMemoryAllocator::Allocate(
         const VkMemoryRequirements& requirements,
         bool mappable,
-        bool requestDeviceAddress) {
+        AllocationClass allocationClass,
+        bool requestDeviceAddress,
+        bool transient,
+        wgpu::MemoryAllocationHint hint,
+        VkBuffer dedicatedBuffer,
+        VkImage dedicatedImage) {
         // The Vulkan spec guarantees at least on memory type is valid.
-        int memoryType = FindBestTypeIndex(requirements, mappable);
+        int memoryType = FindBestTypeIndex(requirements, mappable, transient, hint);
         ASSERT(memoryType >= 0);
 
         VkDeviceSize size = requirements.size;
 
+        // Use a dedicated allocation when the application asked for one, or for large resources
+        // where drivers commonly prefer them, as long as the extension and a resource handle to
+        // dedicate the memory to are available.
+        bool dedicated = mDevice->GetDeviceInfo().dedicatedAllocation &&
+                         (dedicatedBuffer != VK_NULL_HANDLE || dedicatedImage != VK_NULL_HANDLE) &&
+                         ((hint & wgpu::MemoryAllocationHint::Dedicated) ||
+                          requirements.size >= kDedicatedAllocationSizeThreshold);
+
         // Sub-allocate non-mappable resources because at the moment the mapped pointer
         // is part of the resource and not the heap, which doesn't match the Vulkan model.
         // TODO(cwallez@chromium.org): allow sub-allocating mappable resources, maybe.
-        if (requirements.size < kMaxSizeForSubAllocation && !mappable) {
+        // Transient resources get dedicated allocations so the driver can avoid (or reclaim)
+        // the backing pages of lazily allocated memory as soon as they are freed.
+        if (requirements.size < kMaxSizeForSubAllocation && !mappable && !transient && !dedicated) {
             ResourceMemoryAllocation subAllocation;
             DAWN_TRY_ASSIGN(subAllocation,
                             mAllocatorsPerType[memoryType]->AllocateMemory(requirements));
             if (subAllocation.GetInfo().mMethod != AllocationMethod::kInvalid) {
-                return std::move(subAllocation);
+                // Stamp the size and class on the allocation so Deallocate can update the
+                // device's memory stats.
+                AllocationInfo info = subAllocation.GetInfo();
+                info.mSize = requirements.size;
+                info.mClass = allocationClass;
+                mDevice->TrackMemoryAllocation(allocationClass, info.mSize);
+                // The sub-allocation may have grown its backing heap, so usage can have
+                // approached the adapter budget.
+                mDevice->CheckMemoryBudgetPressure();
+                return ResourceMemoryAllocation(info, subAllocation.GetOffset(),
+                                                subAllocation.GetResourceHeap(),
+                                                subAllocation.GetMappedPointer());
             }
         }
 
         // If sub-allocation failed, allocate memory just for it.
         std::unique_ptr<ResourceHeapBase> resourceHeap;
-        DAWN_TRY_ASSIGN(resourceHeap, mAllocatorsPerType[memoryType]->AllocateResourceHeap(size));
+        if (dedicated) {
+            DAWN_TRY_ASSIGN(resourceHeap,
+                            mAllocatorsPerType[memoryType]->AllocateDedicatedResourceHeap(
+                                size, dedicatedBuffer, dedicatedImage));
+        } else {
+            DAWN_TRY_ASSIGN(resourceHeap,
+                            mAllocatorsPerType[memoryType]->AllocateResourceHeap(size));
+        }
 
         void* mappedPointer = nullptr;
         if (mappable) {
@@ -150,11 +210,20 @@ namespace dawn_native { namespace vulkan {
 
         AllocationInfo info;
         info.mMethod = AllocationMethod::kDirect;
+        info.mSize = size;
+        info.mClass = allocationClass;
+        mDevice->TrackMemoryAllocation(allocationClass, info.mSize);
+        mDevice->CheckMemoryBudgetPressure();
         return ResourceMemoryAllocation(info, /*offset*/ 0, resourceHeap.release(),
                                         static_cast<uint8_t*>(mappedPointer));
     }
 
     void ResourceMemoryAllocator::Deallocate(ResourceMemoryAllocation* allocation) {
+        const AllocationInfo info = allocation->GetInfo();
+        if (info.mMethod != AllocationMethod::kInvalid && info.mSize > 0) {
+            mDevice->TrackMemoryDeallocation(info.mClass, info.mSize);
+        }
+
         switch (allocation->GetInfo().mMethod) {
             // Some memory allocation can never be initialized, for example when wrapping
             // swapchain VkImages with a Texture.
@@ -202,7 +271,9 @@ namespace dawn_native { namespace vulkan {
     }
 
     int ResourceMemoryAllocator::FindBestTypeIndex(VkMemoryRequirements requirements,
-                                                   bool mappable) {
+                                                   bool mappable,
+                                                   bool transient,
+                                                   wgpu::MemoryAllocationHint hint) {
         const VulkanDeviceInfo& info = mDevice->GetDeviceInfo();
 
         // Find a suitable memory type for this allocation
@@ -219,10 +290,16 @@ namespace dawn_native { namespace vulkan {
                 continue;
             }
 
-            // Mappable must also be host coherent.
+            // Mappable must also be host coherent, except that a host cached type may be
+            // non-coherent when the allocation asked for cached memory: the buffer then
+            // flushes and invalidates its mapped ranges explicitly around CPU accesses.
             if (mappable &&
                 (info.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) == 0) {
-                continue;
+                bool candidateCached = (info.memoryTypes[i].propertyFlags &
+                                        VK_MEMORY_PROPERTY_HOST_CACHED_BIT) != 0;
+                if (!candidateCached || !(hint & wgpu::MemoryAllocationHint::HostCached)) {
+                    continue;
+                }
             }
 
             // Found the first candidate memory type
@@ -231,8 +308,40 @@ namespace dawn_native { namespace vulkan {
                 continue;
             }
 
-            // For non-mappable resources, favor device local memory.
-            if (!mappable) {
+            // For transient attachments, strongly prefer lazily allocated memory: the driver
+            // may then never back the attachment with actual pages.
+            if (transient) {
+                bool currentLazy = (info.memoryTypes[bestType].propertyFlags &
+                                    VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) != 0;
+                bool candidateLazy = (info.memoryTypes[i].propertyFlags &
+                                      VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) != 0;
+                if (candidateLazy != currentLazy) {
+                    if (candidateLazy) {
+                        bestType = static_cast<int>(i);
+                    }
+                    continue;
+                }
+            }
+
+            // For mappable resources hinted as host cached, prefer host cached memory: reads
+            // back through the mapped pointer are much faster than from uncached memory.
+            if (mappable && (hint & wgpu::MemoryAllocationHint::HostCached)) {
+                bool currentCached = (info.memoryTypes[bestType].propertyFlags &
+                                      VK_MEMORY_PROPERTY_HOST_CACHED_BIT) != 0;
+                bool candidateCached = (info.memoryTypes[i].propertyFlags &
+                                        VK_MEMORY_PROPERTY_HOST_CACHED_BIT) != 0;
+                if (candidateCached != currentCached) {
+                    if (candidateCached) {
+                        bestType = static_cast<int>(i);
+                    }
+                    continue;
+                }
+            }
+
+            // Favor device local memory for non-mappable resources, and for mappable resources
+            // hinted as preferring device local memory (host visible device local memory when
+            // available).
+            if (!mappable || (hint & wgpu::MemoryAllocationHint::PreferDeviceLocal)) {
                 if ((info.memoryTypes[bestType].propertyFlags &
                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) == 0 &&
                     (info.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) !=
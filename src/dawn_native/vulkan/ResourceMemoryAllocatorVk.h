@@ -22,6 +22,7 @@
 #include "common/vulkan_platform.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/ResourceMemoryAllocation.h"
+#include "dawn_native/dawn_platform.h"
 
 namespace dawn_native { namespace vulkan {
 
@@ -32,15 +33,28 @@ namespace dawn_native { namespace vulkan {
         ResourceMemoryAllocator(Device* device);
         ~ResourceMemoryAllocator();
 
-        ResultOrError<ResourceMemoryAllocation> Allocate(const VkMemoryRequirements& requirements,
-                                                         bool mappable,
-                                                         bool requestDeviceAddress = false);
+        // `transient` requests lazily allocated memory when available so that attachments
+        // consumed within a single render pass may never be backed by actual pages.
+        // `hint` advises memory type selection and, together with `dedicatedBuffer` or
+        // `dedicatedImage`, whether to use a VK_KHR_dedicated_allocation for the resource.
+        ResultOrError<ResourceMemoryAllocation> Allocate(
+            const VkMemoryRequirements& requirements,
+            bool mappable,
+            AllocationClass allocationClass,
+            bool requestDeviceAddress = false,
+            bool transient = false,
+            wgpu::MemoryAllocationHint hint = wgpu::MemoryAllocationHint::None,
+            VkBuffer dedicatedBuffer = VK_NULL_HANDLE,
+            VkImage dedicatedImage = VK_NULL_HANDLE);
 
         void Deallocate(ResourceMemoryAllocation* allocation);
 
         void Tick(Serial completedSerial);
 
-        int FindBestTypeIndex(VkMemoryRequirements requirements, bool mappable);
+        int FindBestTypeIndex(VkMemoryRequirements requirements,
+                              bool mappable,
+                              bool transient = false,
+                              wgpu::MemoryAllocationHint hint = wgpu::MemoryAllocationHint::None);
 
       private:
         Device* mDevice;
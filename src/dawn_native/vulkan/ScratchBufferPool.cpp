@@ -0,0 +1,144 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/vulkan/ScratchBufferPool.h"
+
+#include <algorithm>
+
+#include "common/Math.h"
+#include "dawn_native/vulkan/DeviceVk.h"
+#include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/ResourceHeapVk.h"
+#include "dawn_native/vulkan/VulkanError.h"
+
+namespace dawn_native { namespace vulkan {
+
+    namespace {
+        // Allocating in power-of-two size classes lets subsequent builds with slightly
+        // different scratch requirements reuse the same pooled buffer.
+        constexpr uint64_t kMinScratchBufferSize = 65536;
+    }  // anonymous namespace
+
+    ScratchBufferPool::ScratchBufferPool(Device* device) : mDevice(device) {
+    }
+
+    ScratchBufferPool::~ScratchBufferPool() {
+        ASSERT(mFreeBuffers.empty());
+        ASSERT(mInFlightBuffers.Empty());
+    }
+
+    ResultOrError<ScratchBufferPool::ScratchBuffer*> ScratchBufferPool::Acquire(uint64_t size) {
+        uint64_t allocationSize = std::max(NextPowerOfTwo(size), kMinScratchBufferSize);
+
+        std::unique_ptr<ScratchBuffer> scratchBuffer;
+
+        // Prefer the smallest free buffer that is large enough.
+        size_t bestIndex = mFreeBuffers.size();
+        for (size_t i = 0; i < mFreeBuffers.size(); ++i) {
+            if (mFreeBuffers[i]->size >= size &&
+                (bestIndex == mFreeBuffers.size() ||
+                 mFreeBuffers[i]->size < mFreeBuffers[bestIndex]->size)) {
+                bestIndex = i;
+            }
+        }
+
+        if (bestIndex != mFreeBuffers.size()) {
+            scratchBuffer = std::move(mFreeBuffers[bestIndex]);
+            mFreeBuffers.erase(mFreeBuffers.begin() + bestIndex);
+        } else {
+            DAWN_TRY_ASSIGN(scratchBuffer, CreateScratchBuffer(allocationSize));
+        }
+
+        ScratchBuffer* result = scratchBuffer.get();
+        mInFlightBuffers.Enqueue(std::move(scratchBuffer), mDevice->GetPendingCommandSerial());
+        return result;
+    }
+
+    void ScratchBufferPool::Tick(Serial completedSerial) {
+        for (std::unique_ptr<ScratchBuffer>& scratchBuffer :
+             mInFlightBuffers.IterateUpTo(completedSerial)) {
+            mFreeBuffers.push_back(std::move(scratchBuffer));
+        }
+        mInFlightBuffers.ClearUpTo(completedSerial);
+    }
+
+    void ScratchBufferPool::Destroy() {
+        for (std::unique_ptr<ScratchBuffer>& scratchBuffer : mFreeBuffers) {
+            DestroyScratchBuffer(scratchBuffer.get());
+        }
+        mFreeBuffers.clear();
+        for (std::unique_ptr<ScratchBuffer>& scratchBuffer :
+             mInFlightBuffers.IterateAll()) {
+            DestroyScratchBuffer(scratchBuffer.get());
+        }
+        mInFlightBuffers.Clear();
+    }
+
+    ResultOrError<std::unique_ptr<ScratchBufferPool::ScratchBuffer>>
+    ScratchBufferPool::CreateScratchBuffer(uint64_t size) {
+        std::unique_ptr<ScratchBuffer> scratchBuffer = std::make_unique<ScratchBuffer>();
+        scratchBuffer->size = size;
+
+        VkBufferCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.size = size;
+        createInfo.usage =
+            VK_BUFFER_USAGE_RAY_TRACING_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount = 0;
+        createInfo.pQueueFamilyIndices = 0;
+
+        DAWN_TRY(CheckVkSuccess(mDevice->fn.CreateBuffer(mDevice->GetVkDevice(), &createInfo,
+                                                         nullptr, &*(scratchBuffer->buffer)),
+                                "vkCreateBuffer"));
+
+        VkMemoryRequirements requirements;
+        mDevice->fn.GetBufferMemoryRequirements(mDevice->GetVkDevice(), scratchBuffer->buffer,
+                                                &requirements);
+        requirements.memoryTypeBits = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+        DAWN_TRY_ASSIGN(scratchBuffer->resource,
+                        mDevice->AllocateMemory(
+                            requirements, false, AllocationClass::AccelerationContainerScratch,
+                            true));
+
+        DAWN_TRY(CheckVkSuccess(
+            mDevice->fn.BindBufferMemory(
+                mDevice->GetVkDevice(), scratchBuffer->buffer,
+                ToBackend(scratchBuffer->resource.GetResourceHeap())->GetMemory(),
+                scratchBuffer->resource.GetOffset()),
+            "vkBindBufferMemory"));
+
+        VkBufferDeviceAddressInfoKHR bufferDeviceAddressInfo;
+        bufferDeviceAddressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+        bufferDeviceAddressInfo.pNext = nullptr;
+        bufferDeviceAddressInfo.buffer = scratchBuffer->buffer;
+
+        scratchBuffer->deviceAddress = mDevice->fn.GetBufferDeviceAddressKHR(
+            mDevice->GetVkDevice(), &bufferDeviceAddressInfo);
+
+        return std::move(scratchBuffer);
+    }
+
+    void ScratchBufferPool::DestroyScratchBuffer(ScratchBuffer* scratchBuffer) {
+        if (scratchBuffer->buffer != VK_NULL_HANDLE) {
+            mDevice->DeallocateMemory(&scratchBuffer->resource);
+            mDevice->GetFencedDeleter()->DeleteWhenUnused(scratchBuffer->buffer);
+            scratchBuffer->buffer = VK_NULL_HANDLE;
+        }
+    }
+
+}}  // namespace dawn_native::vulkan
@@ -0,0 +1,65 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_SCRATCHBUFFERPOOL_H_
+#define DAWNNATIVE_VULKAN_SCRATCHBUFFERPOOL_H_
+
+#include <memory>
+#include <vector>
+
+#include "common/SerialQueue.h"
+#include "common/vulkan_platform.h"
+#include "dawn_native/Error.h"
+#include "dawn_native/ResourceMemoryAllocation.h"
+
+namespace dawn_native { namespace vulkan {
+
+    class Device;
+
+    // Device-level pool of scratch buffers used for acceleration container builds and
+    // updates. Scratch memory is only needed while the build command executes on the GPU,
+    // so instead of holding a dedicated allocation per container, buffers are borrowed
+    // from the pool at recording time and recycled once the queue's completed serial
+    // passes their last use, similar to how DynamicUploader recycles staging buffers.
+    class ScratchBufferPool {
+      public:
+        struct ScratchBuffer {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            uint64_t deviceAddress = 0;
+            uint64_t size = 0;
+            ResourceMemoryAllocation resource;
+        };
+
+        ScratchBufferPool(Device* device);
+        ~ScratchBufferPool();
+
+        // Returns a scratch buffer of at least |size| bytes that stays valid until the
+        // pending command serial completes. The returned pointer is owned by the pool.
+        ResultOrError<ScratchBuffer*> Acquire(uint64_t size);
+
+        void Tick(Serial completedSerial);
+        void Destroy();
+
+      private:
+        ResultOrError<std::unique_ptr<ScratchBuffer>> CreateScratchBuffer(uint64_t size);
+        void DestroyScratchBuffer(ScratchBuffer* scratchBuffer);
+
+        Device* mDevice = nullptr;
+        std::vector<std::unique_ptr<ScratchBuffer>> mFreeBuffers;
+        SerialQueue<std::unique_ptr<ScratchBuffer>> mInFlightBuffers;
+    };
+
+}}  // namespace dawn_native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_SCRATCHBUFFERPOOL_H_
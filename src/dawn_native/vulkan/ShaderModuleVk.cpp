@@ -49,11 +49,16 @@ namespace dawn_native { namespace vulkan {
                 mSpvcContext.InitializeForVulkan(spirv.data(), spirv.size(), options),
                 "Unable to initialize instance of spvc"));
 
-            spirv_cross::Compiler* compiler;
-            DAWN_TRY(CheckSpvcSuccess(mSpvcContext.GetCompiler(reinterpret_cast<void**>(&compiler)),
-                                      "Unable to get cross compiler"));
-            DAWN_TRY(ExtractSpirvInfo(*compiler));
-        } else {
+            if (!TryLoadCachedSpirvInfo()) {
+                spirv_cross::Compiler* compiler;
+                DAWN_TRY(
+                    CheckSpvcSuccess(mSpvcContext.GetCompiler(reinterpret_cast<void**>(&compiler)),
+                                     "Unable to get cross compiler"));
+                DAWN_TRY(ExtractSpirvInfo(*compiler));
+            }
+        } else if (!TryLoadCachedSpirvInfo()) {
+            // The spirv_cross::Compiler is only needed for reflection here so a cache hit
+            // skips the whole parse.
             spirv_cross::Compiler compiler(spirv);
             DAWN_TRY(ExtractSpirvInfo(compiler));
         }
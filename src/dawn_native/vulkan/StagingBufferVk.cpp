@@ -20,8 +20,8 @@
 
 namespace dawn_native { namespace vulkan {
 
-    StagingBuffer::StagingBuffer(size_t size, Device* device)
-        : StagingBufferBase(size), mDevice(device) {
+    StagingBuffer::StagingBuffer(size_t size, Device* device, StagingAccess access)
+        : StagingBufferBase(size, access), mDevice(device) {
     }
 
     MaybeError StagingBuffer::Initialize() {
@@ -30,7 +30,8 @@ namespace dawn_native { namespace vulkan {
         createInfo.pNext = nullptr;
         createInfo.flags = 0;
         createInfo.size = GetSize();
-        createInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        createInfo.usage = GetAccess() == StagingAccess::Upload ? VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+                                                                : VK_BUFFER_USAGE_TRANSFER_DST_BIT;
         createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
         createInfo.queueFamilyIndexCount = 0;
         createInfo.pQueueFamilyIndices = 0;
@@ -42,7 +43,8 @@ namespace dawn_native { namespace vulkan {
         VkMemoryRequirements requirements;
         mDevice->fn.GetBufferMemoryRequirements(mDevice->GetVkDevice(), mBuffer, &requirements);
 
-        DAWN_TRY_ASSIGN(mAllocation, mDevice->AllocateMemory(requirements, true));
+        DAWN_TRY_ASSIGN(mAllocation,
+                        mDevice->AllocateMemory(requirements, true, AllocationClass::Staging));
 
         DAWN_TRY(CheckVkSuccess(
             mDevice->fn.BindBufferMemory(mDevice->GetVkDevice(), mBuffer,
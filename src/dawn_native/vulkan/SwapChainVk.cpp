@@ -49,8 +49,30 @@ namespace dawn_native { namespace vulkan {
 
         VkImage nativeTexture =
             VkImage::CreateFromHandle(reinterpret_cast<::VkImage>(next.texture.u64));
-        return Texture::CreateForSwapChain(ToBackend(GetDevice()), descriptor, nativeTexture)
-            .Detach();
+
+        // The implementation rotates through the same few VkImages; hand back the wrapper
+        // texture created the first time each one was acquired. A wrapper the application
+        // destroyed is replaced.
+        for (auto& entry : mTextureCache) {
+            if (entry.first == nativeTexture) {
+                if (entry.second->GetTextureState() == TextureBase::TextureState::Destroyed) {
+                    entry.second =
+                        Texture::CreateForSwapChain(ToBackend(GetDevice()), descriptor,
+                                                    nativeTexture);
+                }
+                Ref<Texture> texture = entry.second;
+                return texture.Detach();
+            }
+        }
+
+        Ref<Texture> texture =
+            Texture::CreateForSwapChain(ToBackend(GetDevice()), descriptor, nativeTexture);
+        mTextureCache.emplace_back(nativeTexture, texture);
+        return texture.Detach();
+    }
+
+    void SwapChain::OnConfigure() {
+        mTextureCache.clear();
     }
 
     MaybeError SwapChain::OnBeforePresent(TextureBase* texture) {
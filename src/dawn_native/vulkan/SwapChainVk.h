@@ -19,9 +19,13 @@
 
 #include "common/vulkan_platform.h"
 
+#include <utility>
+#include <vector>
+
 namespace dawn_native { namespace vulkan {
 
     class Device;
+    class Texture;
 
     class SwapChain final : public OldSwapChainBase {
       public:
@@ -33,9 +37,16 @@ namespace dawn_native { namespace vulkan {
 
         TextureBase* GetNextTextureImpl(const TextureDescriptor* descriptor) override;
         MaybeError OnBeforePresent(TextureBase* texture) override;
+        void OnConfigure() override;
 
       private:
         wgpu::TextureUsage mTextureUsage;
+
+        // The wrapper texture of each native image, so re-acquiring an image the
+        // implementation rotates through doesn't recreate the Dawn texture every frame.
+        // Cleared on configure because the implementation then owns a new set of VkImages
+        // whose handles may alias the old ones.
+        std::vector<std::pair<VkImage, Ref<Texture>>> mTextureCache;
     };
 
 }}  // namespace dawn_native::vulkan
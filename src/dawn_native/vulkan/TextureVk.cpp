@@ -15,6 +15,7 @@
 #include "dawn_native/vulkan/TextureVk.h"
 
 #include "common/Assert.h"
+#include "common/Counters.h"
 #include "common/Math.h"
 #include "dawn_native/DynamicUploader.h"
 #include "dawn_native/Error.h"
@@ -29,6 +30,8 @@
 #include "dawn_native/vulkan/UtilsVulkan.h"
 #include "dawn_native/vulkan/VulkanError.h"
 
+#include <algorithm>
+
 namespace dawn_native { namespace vulkan {
 
     namespace {
@@ -230,8 +233,10 @@ namespace dawn_native { namespace vulkan {
                                                 const VkImage& image,
                                                 wgpu::TextureUsage lastUsage,
                                                 wgpu::TextureUsage usage,
-                                                uint32_t mipLevel,
-                                                uint32_t arrayLayer) {
+                                                uint32_t baseMipLevel,
+                                                uint32_t levelCount,
+                                                uint32_t baseArrayLayer,
+                                                uint32_t layerCount) {
             VkImageMemoryBarrier barrier;
             barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
             barrier.pNext = nullptr;
@@ -241,10 +246,10 @@ namespace dawn_native { namespace vulkan {
             barrier.newLayout = VulkanImageLayout(usage, format);
             barrier.image = image;
             barrier.subresourceRange.aspectMask = VulkanAspectMask(format);
-            barrier.subresourceRange.baseMipLevel = mipLevel;
-            barrier.subresourceRange.levelCount = 1;
-            barrier.subresourceRange.baseArrayLayer = arrayLayer;
-            barrier.subresourceRange.layerCount = 1;
+            barrier.subresourceRange.baseMipLevel = baseMipLevel;
+            barrier.subresourceRange.levelCount = levelCount;
+            barrier.subresourceRange.baseArrayLayer = baseArrayLayer;
+            barrier.subresourceRange.layerCount = layerCount;
 
             barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
             barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
@@ -404,6 +409,9 @@ namespace dawn_native { namespace vulkan {
                 flags |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
             }
         }
+        if (usage & wgpu::TextureUsage::Transient) {
+            flags |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        }
 
         return flags;
     }
@@ -477,6 +485,23 @@ namespace dawn_native { namespace vulkan {
         return texture.Detach();
     }
 
+    // static
+    ResultOrError<Texture*> Texture::CreateExportable(
+        Device* device,
+        const TextureDescriptor* textureDescriptor,
+        external_memory::Service* externalMemoryService,
+        VkSemaphore signalSemaphore,
+        ExternalMemoryHandle* outMemoryHandle,
+        VkDeviceSize* outAllocationSize,
+        uint32_t* outMemoryTypeIndex) {
+        Ref<Texture> texture =
+            AcquireRef(new Texture(device, textureDescriptor, TextureState::OwnedInternal));
+        DAWN_TRY(texture->InitializeAsExportableTexture(externalMemoryService, signalSemaphore,
+                                                        outMemoryHandle, outAllocationSize,
+                                                        outMemoryTypeIndex));
+        return texture.Detach();
+    }
+
     // static
     Ref<Texture> Texture::CreateForSwapChain(Device* device,
                                              const TextureDescriptor* descriptor,
@@ -516,10 +541,17 @@ namespace dawn_native { namespace vulkan {
             createInfo.flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
         }
 
+        const bool transient = (GetUsage() & wgpu::TextureUsage::Transient) != 0;
+
         // We always set VK_IMAGE_USAGE_TRANSFER_DST_BIT unconditionally beause the Vulkan images
         // that are used in vkCmdClearColorImage() must have been created with this flag, which is
-        // also required for the implementation of robust resource initialization.
-        createInfo.usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        // also required for the implementation of robust resource initialization. The exception
+        // is transient attachments: the spec only allows combining transient with attachment
+        // usages, and their only use as an attachment means they are always initialized with a
+        // render pass load op instead of a clear command.
+        if (!transient) {
+            createInfo.usage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        }
 
         DAWN_TRY(CheckVkSuccess(
             device->fn.CreateImage(device->GetVkDevice(), &createInfo, nullptr, &*mHandle),
@@ -529,7 +561,15 @@ namespace dawn_native { namespace vulkan {
         VkMemoryRequirements requirements;
         device->fn.GetImageMemoryRequirements(device->GetVkDevice(), mHandle, &requirements);
 
-        DAWN_TRY_ASSIGN(mMemoryAllocation, device->AllocateMemory(requirements, false));
+        if (GetAliasGroup() != 0) {
+            DAWN_TRY_ASSIGN(mMemoryAllocation, device->AllocateAliasedMemory(
+                                                   GetAliasGroup(), requirements, &mIsAliased));
+        } else {
+            DAWN_TRY_ASSIGN(mMemoryAllocation,
+                            device->AllocateMemory(requirements, false, AllocationClass::Texture,
+                                                   /*requestDeviceAddress*/ false, transient,
+                                                   GetAllocationHint(), VK_NULL_HANDLE, mHandle));
+        }
 
         DAWN_TRY(CheckVkSuccess(
             device->fn.BindImageMemory(device->GetVkDevice(), mHandle,
@@ -537,7 +577,10 @@ namespace dawn_native { namespace vulkan {
                                        mMemoryAllocation.GetOffset()),
             "BindImageMemory"));
 
-        if (device->IsToggleEnabled(Toggle::NonzeroClearResourcesOnCreationForTesting)) {
+        // Transient attachments cannot be cleared with clear commands since they aren't
+        // created with TRANSFER_DST.
+        if (device->IsToggleEnabled(Toggle::NonzeroClearResourcesOnCreationForTesting) &&
+            !transient) {
             DAWN_TRY(ClearTexture(ToBackend(GetDevice())->GetPendingRecordingContext(), 0,
                                   GetNumMipLevels(), 0, GetArrayLayers(),
                                   TextureBase::ClearValue::NonZero));
@@ -579,6 +622,71 @@ namespace dawn_native { namespace vulkan {
         return {};
     }
 
+    // Internally managed, but backed by memory allocated for export to another device
+    MaybeError Texture::InitializeAsExportableTexture(
+        external_memory::Service* externalMemoryService,
+        VkSemaphore signalSemaphore,
+        ExternalMemoryHandle* outMemoryHandle,
+        VkDeviceSize* outAllocationSize,
+        uint32_t* outMemoryTypeIndex) {
+        Device* device = ToBackend(GetDevice());
+
+        VkExternalMemoryImageCreateInfo externalCreateInfo;
+        externalCreateInfo.sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO;
+        externalCreateInfo.pNext = nullptr;
+        externalCreateInfo.handleTypes = externalMemoryService->GetMemoryHandleType();
+
+        // Match the image parameters the importing device uses in
+        // external_memory::Service::CreateImage so both aliases of the memory are compatible.
+        VkImageCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        createInfo.pNext = &externalCreateInfo;
+        createInfo.flags = VK_IMAGE_CREATE_ALIAS_BIT_KHR;
+        createInfo.imageType = VulkanImageType(GetDimension());
+        createInfo.format = VulkanImageFormat(device, GetFormat().format);
+        createInfo.extent = VulkanExtent3D(GetSize());
+        createInfo.mipLevels = GetNumMipLevels();
+        createInfo.arrayLayers = GetArrayLayers();
+        createInfo.samples = VulkanSampleCount(GetSampleCount());
+        createInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        createInfo.usage = VulkanImageUsage(GetUsage(), GetFormat()) |
+                           VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount = 0;
+        createInfo.pQueueFamilyIndices = nullptr;
+        createInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        ASSERT(IsSampleCountSupported(device, createInfo));
+
+        DAWN_TRY(CheckVkSuccess(
+            device->fn.CreateImage(device->GetVkDevice(), &createInfo, nullptr, &*mHandle),
+            "CreateImage"));
+
+        VkMemoryRequirements requirements;
+        device->fn.GetImageMemoryRequirements(device->GetVkDevice(), mHandle, &requirements);
+
+        int memoryType = device->FindBestMemoryTypeIndex(requirements, false);
+        ASSERT(memoryType >= 0);
+
+        DAWN_TRY_ASSIGN(mExternalAllocation,
+                        externalMemoryService->AllocateExportableMemory(
+                            requirements.size, static_cast<uint32_t>(memoryType)));
+
+        DAWN_TRY(CheckVkSuccess(
+            device->fn.BindImageMemory(device->GetVkDevice(), mHandle, mExternalAllocation, 0),
+            "BindImageMemory (external)"));
+
+        DAWN_TRY_ASSIGN(*outMemoryHandle, externalMemoryService->ExportMemory(mExternalAllocation));
+        *outAllocationSize = requirements.size;
+        *outMemoryTypeIndex = static_cast<uint32_t>(memoryType);
+
+        // This device owns the memory first; releasing it to the importing device goes through
+        // the same signal-and-destroy path as imported textures.
+        mExternalState = ExternalState::PendingAcquire;
+        mSignalSemaphore = signalSemaphore;
+        return {};
+    }
+
     void Texture::InitializeForSwapChain(VkImage nativeImage) {
         mHandle = nativeImage;
     }
@@ -645,7 +753,14 @@ namespace dawn_native { namespace vulkan {
 
             // For textures created from a VkImage, the allocation if kInvalid so the Device knows
             // to skip the deallocation of the (absence of) VkDeviceMemory.
-            device->DeallocateMemory(&mMemoryAllocation);
+            if (mIsAliased) {
+                // The allocation is a non-owning copy of the group's shared one, which the
+                // device frees when the last member is destroyed.
+                device->ReleaseAliasedMemory(GetAliasGroup(), this);
+                mMemoryAllocation.Invalidate();
+            } else {
+                device->DeallocateMemory(&mMemoryAllocation);
+            }
 
             if (mHandle != VK_NULL_HANDLE) {
                 device->GetFencedDeleter()->DeleteWhenUnused(mHandle);
@@ -671,7 +786,7 @@ namespace dawn_native { namespace vulkan {
     }
 
     void Texture::TweakTransitionForExternalUsage(CommandRecordingContext* recordingContext,
-                                                  std::vector<VkImageMemoryBarrier>* barriers) {
+                                                  ImageBarrierVector* barriers) {
         ASSERT(GetNumMipLevels() == 1 && GetArrayLayers() == 1);
         ASSERT(barriers->size() <= 1);
 
@@ -679,7 +794,7 @@ namespace dawn_native { namespace vulkan {
             if (!barriers->size()) {
                 barriers->push_back(BuildMemoryBarrier(GetFormat(), mHandle,
                                                        wgpu::TextureUsage::None,
-                                                       wgpu::TextureUsage::None, 0, 0));
+                                                       wgpu::TextureUsage::None, 0, 1, 0, 1));
             }
 
             // Transfer texture from external queue to graphics queue
@@ -692,7 +807,7 @@ namespace dawn_native { namespace vulkan {
             if (!barriers->size()) {
                 barriers->push_back(BuildMemoryBarrier(GetFormat(), mHandle,
                                                        wgpu::TextureUsage::None,
-                                                       wgpu::TextureUsage::None, 0, 0));
+                                                       wgpu::TextureUsage::None, 0, 1, 0, 1));
             }
 
             // Transfer texture from graphics queue to external queue
@@ -714,9 +829,34 @@ namespace dawn_native { namespace vulkan {
         TransitionUsageNow(recordingContext, usage, 0, GetNumMipLevels(), 0, GetArrayLayers());
     }
 
+    void Texture::AcquireAliasedMemoryIfNeeded() {
+        if (!mIsAliased) {
+            return;
+        }
+        if (!ToBackend(GetDevice())->UpdateAliasGroupUsage(GetAliasGroup(), this)) {
+            return;
+        }
+
+        // Another group member used the shared memory since this texture last did: its
+        // contents are garbage now. Drop the initialized state so attachments get a load op
+        // clear, and forget the tracked layouts so the next transition starts from UNDEFINED.
+        SetIsSubresourceContentInitialized(false, 0, GetNumMipLevels(), 0, GetArrayLayers());
+        std::fill(mLastSubresourceUsages.begin(), mLastSubresourceUsages.end(),
+                  wgpu::TextureUsage::None);
+        mSameLastUsagesAcrossSubresources = true;
+        mPendingAliasAcquire = true;
+    }
+
     void Texture::TransitionUsageForPass(CommandRecordingContext* recordingContext,
-                                         const std::vector<wgpu::TextureUsage>& subresourceUsages) {
-        std::vector<VkImageMemoryBarrier> barriers;
+                                         const std::vector<wgpu::TextureUsage>& subresourceUsages,
+                                         ImageBarrierVector* imageBarriers,
+                                         VkPipelineStageFlags* srcStages,
+                                         VkPipelineStageFlags* dstStages) {
+        AcquireAliasedMemoryIfNeeded();
+
+        // TweakTransitionForExternalUsage mutates the texture's own barriers, so they are
+        // collected in a local vector before being appended to the pass' batch.
+        ImageBarrierStackVector barriers;
         const Format& format = GetFormat();
 
         wgpu::TextureUsage allUsages = wgpu::TextureUsage::None;
@@ -726,40 +866,94 @@ namespace dawn_native { namespace vulkan {
         // This transitions assume it is a 2D texture
         ASSERT(GetDimension() == wgpu::TextureDimension::e2D);
 
-        for (uint32_t arrayLayer = 0; arrayLayer < GetArrayLayers(); ++arrayLayer) {
-            for (uint32_t mipLevel = 0; mipLevel < GetNumMipLevels(); ++mipLevel) {
-                uint32_t index = GetSubresourceIndex(mipLevel, arrayLayer);
+        const bool uniformUsages = std::equal(subresourceUsages.begin() + 1,
+                                              subresourceUsages.end(), subresourceUsages.begin());
 
-                // Avoid encoding barriers when it isn't needed.
-                if (subresourceUsages[index] == wgpu::TextureUsage::None) {
-                    continue;
-                }
-                bool lastReadOnly = (mLastSubresourceUsages[index] & kReadOnlyTextureUsages) ==
-                                    mLastSubresourceUsages[index];
-                if (lastReadOnly && mLastSubresourceUsages[index] == subresourceUsages[index] &&
-                    mLastExternalState == mExternalState) {
-                    continue;
-                }
+        if (uniformUsages && subresourceUsages[0] == wgpu::TextureUsage::None) {
+            return;
+        }
+
+        if (mSameLastUsagesAcrossSubresources && uniformUsages) {
+            // Fast whole-resource path: every subresource is in the same state and the pass
+            // uses them all the same way, so a single barrier covering all mips and layers
+            // replaces the per-subresource walk. This keeps barrier generation from scaling
+            // with layer count for textures that stay in a uniform state (the common case).
+            wgpu::TextureUsage usage = subresourceUsages[0];
+            wgpu::TextureUsage lastUsage = mLastSubresourceUsages[0];
+
+            bool lastReadOnly = (lastUsage & kReadOnlyTextureUsages) == lastUsage;
+            if (!(lastReadOnly && lastUsage == usage && mLastExternalState == mExternalState)) {
+                barriers->push_back(BuildMemoryBarrier(format, mHandle, lastUsage, usage, 0,
+                                                       GetNumMipLevels(), 0, GetArrayLayers()));
+
+                allUsages = usage;
+                allLastUsages = lastUsage;
+                std::fill(mLastSubresourceUsages.begin(), mLastSubresourceUsages.end(), usage);
+            }
+        } else {
+            for (uint32_t arrayLayer = 0; arrayLayer < GetArrayLayers(); ++arrayLayer) {
+                for (uint32_t mipLevel = 0; mipLevel < GetNumMipLevels(); ++mipLevel) {
+                    uint32_t index = GetSubresourceIndex(mipLevel, arrayLayer);
+
+                    // Avoid encoding barriers when it isn't needed.
+                    if (subresourceUsages[index] == wgpu::TextureUsage::None) {
+                        continue;
+                    }
+                    bool lastReadOnly = (mLastSubresourceUsages[index] & kReadOnlyTextureUsages) ==
+                                        mLastSubresourceUsages[index];
+                    if (lastReadOnly && mLastSubresourceUsages[index] == subresourceUsages[index] &&
+                        mLastExternalState == mExternalState) {
+                        continue;
+                    }
 
-                barriers.push_back(
-                    BuildMemoryBarrier(format, mHandle, mLastSubresourceUsages[index],
-                                       subresourceUsages[index], mipLevel, arrayLayer));
+                    barriers->push_back(
+                        BuildMemoryBarrier(format, mHandle, mLastSubresourceUsages[index],
+                                           subresourceUsages[index], mipLevel, 1, arrayLayer, 1));
 
-                allUsages |= subresourceUsages[index];
-                allLastUsages |= mLastSubresourceUsages[index];
-                mLastSubresourceUsages[index] = subresourceUsages[index];
+                    allUsages |= subresourceUsages[index];
+                    allLastUsages |= mLastSubresourceUsages[index];
+                    mLastSubresourceUsages[index] = subresourceUsages[index];
+                }
             }
+
+            // A pass that used every subresource the same way leaves the texture uniform
+            // again, re-enabling the fast path above.
+            mSameLastUsagesAcrossSubresources = uniformUsages;
         }
 
         if (mExternalState != ExternalState::InternalOnly) {
-            TweakTransitionForExternalUsage(recordingContext, &barriers);
+            TweakTransitionForExternalUsage(recordingContext, &barriers.container());
         }
 
-        VkPipelineStageFlags srcStages = VulkanPipelineStage(allLastUsages, format);
-        VkPipelineStageFlags dstStages = VulkanPipelineStage(allUsages, format);
-        ToBackend(GetDevice())
-            ->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
-                                    nullptr, 0, nullptr, barriers.size(), barriers.data());
+        if (barriers->empty()) {
+            return;
+        }
+
+        if (mPendingAliasAcquire) {
+            // Aliasing acquire: every prior write to the shared memory must be made
+            // available before it is reused, in addition to the UNDEFINED layout
+            // transition the reset usage tracking already produces.
+            for (VkImageMemoryBarrier& barrier : barriers.container()) {
+                barrier.srcAccessMask |= VK_ACCESS_MEMORY_WRITE_BIT;
+            }
+            *srcStages |= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+            mPendingAliasAcquire = false;
+        }
+
+        *srcStages |= VulkanPipelineStage(allLastUsages, format);
+        *dstStages |= VulkanPipelineStage(allUsages, format);
+        imageBarriers->insert(imageBarriers->end(), barriers->begin(), barriers->end());
+    }
+
+    const std::vector<wgpu::TextureUsage>& Texture::GetLastSubresourceUsages() const {
+        return mLastSubresourceUsages;
+    }
+
+    void Texture::SetLastSubresourceUsages(const std::vector<wgpu::TextureUsage>& usages) {
+        ASSERT(usages.size() == GetSubresourceCount());
+        mLastSubresourceUsages = usages;
+        mSameLastUsagesAcrossSubresources =
+            std::equal(usages.begin() + 1, usages.end(), usages.begin());
     }
 
     void Texture::TransitionUsageNow(CommandRecordingContext* recordingContext,
@@ -768,7 +962,9 @@ namespace dawn_native { namespace vulkan {
                                      uint32_t levelCount,
                                      uint32_t baseArrayLayer,
                                      uint32_t layerCount) {
-        std::vector<VkImageMemoryBarrier> barriers;
+        AcquireAliasedMemoryIfNeeded();
+
+        ImageBarrierStackVector barriers;
         const Format& format = GetFormat();
 
         wgpu::TextureUsage allLastUsages = wgpu::TextureUsage::None;
@@ -776,35 +972,72 @@ namespace dawn_native { namespace vulkan {
         // This transitions assume it is a 2D texture
         ASSERT(GetDimension() == wgpu::TextureDimension::e2D);
 
-        for (uint32_t arrayLayer = 0; arrayLayer < layerCount; ++arrayLayer) {
-            for (uint32_t mipLevel = 0; mipLevel < levelCount; ++mipLevel) {
-                uint32_t index =
-                    GetSubresourceIndex(baseMipLevel + mipLevel, baseArrayLayer + arrayLayer);
-                wgpu::TextureUsage lastUsage = mLastSubresourceUsages[index];
+        const bool coversAllSubresources =
+            levelCount == GetNumMipLevels() && layerCount == GetArrayLayers();
 
-                // Avoid encoding barriers when it isn't needed.
-                bool lastReadOnly = (lastUsage & kReadOnlyTextureUsages) == lastUsage;
-                if (lastReadOnly && lastUsage == usage && mLastExternalState == mExternalState) {
-                    return;
-                }
+        if (mSameLastUsagesAcrossSubresources && coversAllSubresources) {
+            // Fast whole-resource path, see TransitionUsageForPass.
+            wgpu::TextureUsage lastUsage = mLastSubresourceUsages[0];
+
+            // Avoid encoding barriers when it isn't needed.
+            bool lastReadOnly = (lastUsage & kReadOnlyTextureUsages) == lastUsage;
+            if (lastReadOnly && lastUsage == usage && mLastExternalState == mExternalState) {
+                return;
+            }
+
+            barriers->push_back(BuildMemoryBarrier(format, mHandle, lastUsage, usage, 0,
+                                                   GetNumMipLevels(), 0, GetArrayLayers()));
+            allLastUsages = lastUsage;
+            std::fill(mLastSubresourceUsages.begin(), mLastSubresourceUsages.end(), usage);
+        } else {
+            // The per-subresource walk below can return from the middle of a row, so clear
+            // the uniformity flag upfront and only restore it once the full walk completed
+            // over a range covering the whole resource.
+            mSameLastUsagesAcrossSubresources = false;
+
+            for (uint32_t arrayLayer = 0; arrayLayer < layerCount; ++arrayLayer) {
+                for (uint32_t mipLevel = 0; mipLevel < levelCount; ++mipLevel) {
+                    uint32_t index =
+                        GetSubresourceIndex(baseMipLevel + mipLevel, baseArrayLayer + arrayLayer);
+                    wgpu::TextureUsage lastUsage = mLastSubresourceUsages[index];
+
+                    // Avoid encoding barriers when it isn't needed.
+                    bool lastReadOnly = (lastUsage & kReadOnlyTextureUsages) == lastUsage;
+                    if (lastReadOnly && lastUsage == usage &&
+                        mLastExternalState == mExternalState) {
+                        return;
+                    }
 
-                barriers.push_back(BuildMemoryBarrier(format, mHandle, lastUsage, usage,
-                                                      baseMipLevel + mipLevel,
-                                                      baseArrayLayer + arrayLayer));
-                allLastUsages |= lastUsage;
-                mLastSubresourceUsages[index] = usage;
+                    barriers->push_back(BuildMemoryBarrier(format, mHandle, lastUsage, usage,
+                                                           baseMipLevel + mipLevel, 1,
+                                                           baseArrayLayer + arrayLayer, 1));
+                    allLastUsages |= lastUsage;
+                    mLastSubresourceUsages[index] = usage;
+                }
             }
+
+            mSameLastUsagesAcrossSubresources = coversAllSubresources;
         }
 
         if (mExternalState != ExternalState::InternalOnly) {
-            TweakTransitionForExternalUsage(recordingContext, &barriers);
+            TweakTransitionForExternalUsage(recordingContext, &barriers.container());
         }
 
         VkPipelineStageFlags srcStages = VulkanPipelineStage(allLastUsages, format);
         VkPipelineStageFlags dstStages = VulkanPipelineStage(usage, format);
+
+        if (mPendingAliasAcquire && !barriers->empty()) {
+            // Aliasing acquire, see TransitionUsageForPass.
+            for (VkImageMemoryBarrier& barrier : barriers.container()) {
+                barrier.srcAccessMask |= VK_ACCESS_MEMORY_WRITE_BIT;
+            }
+            srcStages |= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+            mPendingAliasAcquire = false;
+        }
+        DAWN_COUNTER_INCREMENT(GetDevice()->GetCounters(), PipelineBarriers);
         ToBackend(GetDevice())
             ->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
-                                    nullptr, 0, nullptr, barriers.size(), barriers.data());
+                                    nullptr, 0, nullptr, barriers->size(), barriers->data());
     }
 
     MaybeError Texture::ClearTexture(CommandRecordingContext* recordingContext,
@@ -821,6 +1054,11 @@ namespace dawn_native { namespace vulkan {
         TransitionUsageNow(recordingContext, wgpu::TextureUsage::CopyDst, baseMipLevel, levelCount,
                            baseArrayLayer, layerCount);
         if (GetFormat().isRenderable) {
+            // Gather all the subresources that need clearing and clear them with a single
+            // command. Workloads that stream in many small render targets trigger a burst of
+            // lazy clears, and one vkCmdClear*Image per subresource adds up quickly.
+            StackVector<VkImageSubresourceRange, 16> ranges;
+
             VkImageSubresourceRange range = {};
             range.aspectMask = GetVkAspectMask();
             range.levelCount = 1;
@@ -836,23 +1074,35 @@ namespace dawn_native { namespace vulkan {
                         continue;
                     }
 
+                    // Extend the previous range when it ends on the preceding layer of the same
+                    // level so runs of uninitialized layers become a single range.
+                    if (!ranges->empty() && ranges->back().baseMipLevel == level &&
+                        ranges->back().baseArrayLayer + ranges->back().layerCount == layer) {
+                        ranges->back().layerCount++;
+                        continue;
+                    }
+
                     range.baseArrayLayer = layer;
+                    ranges->push_back(range);
+                }
+            }
 
-                    if (GetFormat().HasDepthOrStencil()) {
-                        VkClearDepthStencilValue clearDepthStencilValue[1];
-                        clearDepthStencilValue[0].depth = fClearColor;
-                        clearDepthStencilValue[0].stencil = clearColor;
-                        device->fn.CmdClearDepthStencilImage(recordingContext->commandBuffer,
-                                                             GetHandle(),
-                                                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                                             clearDepthStencilValue, 1, &range);
-                    } else {
-                        VkClearColorValue clearColorValue = {
-                            {fClearColor, fClearColor, fClearColor, fClearColor}};
-                        device->fn.CmdClearColorImage(recordingContext->commandBuffer, GetHandle(),
-                                                      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                                      &clearColorValue, 1, &range);
-                    }
+            if (!ranges->empty()) {
+                if (GetFormat().HasDepthOrStencil()) {
+                    VkClearDepthStencilValue clearDepthStencilValue;
+                    clearDepthStencilValue.depth = fClearColor;
+                    clearDepthStencilValue.stencil = clearColor;
+                    device->fn.CmdClearDepthStencilImage(
+                        recordingContext->commandBuffer, GetHandle(),
+                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearDepthStencilValue,
+                        ranges->size(), ranges->data());
+                } else {
+                    VkClearColorValue clearColorValue = {
+                        {fClearColor, fClearColor, fClearColor, fClearColor}};
+                    device->fn.CmdClearColorImage(recordingContext->commandBuffer, GetHandle(),
+                                                  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                  &clearColorValue, ranges->size(),
+                                                  ranges->data());
                 }
             }
         } else {
@@ -878,6 +1128,9 @@ namespace dawn_native { namespace vulkan {
             bufferCopy.offset = uploadHandle.startOffset;
             bufferCopy.bytesPerRow = bytesPerRow;
 
+            // Batch all the regions into a single copy from the clear buffer, like the
+            // renderable path batches its clear ranges.
+            StackVector<VkBufferImageCopy, 16> regions;
             for (uint32_t level = baseMipLevel; level < baseMipLevel + levelCount; ++level) {
                 Extent3D copySize = GetMipLevelVirtualSize(level);
 
@@ -895,16 +1148,18 @@ namespace dawn_native { namespace vulkan {
                     textureCopy.mipLevel = level;
                     textureCopy.arrayLayer = layer;
 
-                    VkBufferImageCopy region =
-                        ComputeBufferImageCopyRegion(bufferCopy, textureCopy, copySize);
-
-                    // copy the clear buffer to the texture image
-                    device->fn.CmdCopyBufferToImage(
-                        recordingContext->commandBuffer,
-                        ToBackend(uploadHandle.stagingBuffer)->GetBufferHandle(), GetHandle(),
-                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+                    regions->push_back(
+                        ComputeBufferImageCopyRegion(bufferCopy, textureCopy, copySize));
                 }
             }
+
+            if (!regions->empty()) {
+                // copy the clear buffer to the texture image
+                device->fn.CmdCopyBufferToImage(
+                    recordingContext->commandBuffer,
+                    ToBackend(uploadHandle.stagingBuffer)->GetBufferHandle(), GetHandle(),
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, regions->size(), regions->data());
+            }
         }
         if (clearValue == TextureBase::ClearValue::Zero) {
             SetIsSubresourceContentInitialized(true, baseMipLevel, levelCount, baseArrayLayer,
@@ -941,7 +1196,8 @@ namespace dawn_native { namespace vulkan {
     // static
     ResultOrError<TextureView*> TextureView::Create(TextureBase* texture,
                                                     const TextureViewDescriptor* descriptor) {
-        Ref<TextureView> view = AcquireRef(new TextureView(texture, descriptor));
+        Device* device = ToBackend(texture->GetDevice());
+        Ref<TextureView> view = AcquireRef(device->AllocateTextureView(texture, descriptor));
         DAWN_TRY(view->Initialize(descriptor));
         return view.Detach();
     }
@@ -978,6 +1234,16 @@ namespace dawn_native { namespace vulkan {
         }
     }
 
+    void TextureView::DeleteThis() {
+        // Keep the texture alive so the device stays alive until after the destructor has
+        // run: the view is slab-allocated inside memory owned by the device and its block
+        // can only be recycled once it is fully destroyed.
+        Ref<TextureBase> texture = GetTexture();
+        Device* device = ToBackend(texture->GetDevice());
+        RefCounted::DeleteThis();
+        device->DeallocateTextureView(this);
+    }
+
     VkImageView TextureView::GetHandle() const {
         return mHandle;
     }
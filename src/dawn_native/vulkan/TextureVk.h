@@ -17,6 +17,8 @@
 
 #include "dawn_native/Texture.h"
 
+#include "common/PlacementAllocated.h"
+#include "common/StackContainer.h"
 #include "common/vulkan_platform.h"
 #include "dawn_native/ResourceMemoryAllocation.h"
 #include "dawn_native/vulkan/ExternalHandle.h"
@@ -27,6 +29,13 @@ namespace dawn_native { namespace vulkan {
     struct CommandRecordingContext;
     class Device;
 
+    // Barrier batches are built per pass, so give them inline storage to avoid a heap
+    // allocation for the common case of a pass that only transitions a few textures.
+    static constexpr size_t kInlineImageBarrierCapacity = 16;
+    using ImageBarrierStackVector =
+        StackVector<VkImageMemoryBarrier, kInlineImageBarrierCapacity>;
+    using ImageBarrierVector = ImageBarrierStackVector::ContainerType;
+
     VkFormat VulkanImageFormat(const Device* device, wgpu::TextureFormat format);
     VkImageUsageFlags VulkanImageUsage(wgpu::TextureUsage usage, const Format& format);
     VkSampleCountFlagBits VulkanSampleCount(uint32_t sampleCount);
@@ -52,6 +61,20 @@ namespace dawn_native { namespace vulkan {
             const TextureDescriptor* textureDescriptor,
             external_memory::Service* externalMemoryService);
 
+        // Creates a texture backed by memory allocated for export so that another device can
+        // import it with WrapVulkanImage. On success `outMemoryHandle` receives the exported
+        // handle and `outAllocationSize`/`outMemoryTypeIndex` the allocation parameters the
+        // importing device must match; the texture takes ownership of `signalSemaphore` for a
+        // later SignalAndDestroy handing the memory over to the importing device.
+        static ResultOrError<Texture*> CreateExportable(
+            Device* device,
+            const TextureDescriptor* textureDescriptor,
+            external_memory::Service* externalMemoryService,
+            VkSemaphore signalSemaphore,
+            ExternalMemoryHandle* outMemoryHandle,
+            VkDeviceSize* outAllocationSize,
+            uint32_t* outMemoryTypeIndex);
+
         // Creates a texture that wraps a swapchain-allocated VkImage.
         static Ref<Texture> CreateForSwapChain(Device* device,
                                                const TextureDescriptor* descriptor,
@@ -72,8 +95,21 @@ namespace dawn_native { namespace vulkan {
                                 uint32_t levelCount,
                                 uint32_t baseArrayLayer,
                                 uint32_t layerCount);
+        // Collects the barriers needed to transition each subresource to its usage for the pass
+        // into `imageBarriers` and merges the required pipeline stages into
+        // `srcStages`/`dstStages`, so all the transitions of a pass can be batched into a single
+        // barrier call.
         void TransitionUsageForPass(CommandRecordingContext* recordingContext,
-                                    const std::vector<wgpu::TextureUsage>& subresourceUsages);
+                                    const std::vector<wgpu::TextureUsage>& subresourceUsages,
+                                    ImageBarrierVector* imageBarriers,
+                                    VkPipelineStageFlags* srcStages,
+                                    VkPipelineStageFlags* dstStages);
+
+        // The usage each subresource was last transitioned to. Used with
+        // SetLastSubresourceUsages when replaying a reusable command buffer: the replayed
+        // recording already contains the barriers so only the tracker needs updating.
+        const std::vector<wgpu::TextureUsage>& GetLastSubresourceUsages() const;
+        void SetLastSubresourceUsages(const std::vector<wgpu::TextureUsage>& usages);
 
         void EnsureSubresourceContentInitialized(CommandRecordingContext* recordingContext,
                                                  uint32_t baseMipLevel,
@@ -96,6 +132,11 @@ namespace dawn_native { namespace vulkan {
         MaybeError InitializeAsInternalTexture();
         MaybeError InitializeFromExternal(const ExternalImageDescriptor* descriptor,
                                           external_memory::Service* externalMemoryService);
+        MaybeError InitializeAsExportableTexture(external_memory::Service* externalMemoryService,
+                                                 VkSemaphore signalSemaphore,
+                                                 ExternalMemoryHandle* outMemoryHandle,
+                                                 VkDeviceSize* outAllocationSize,
+                                                 uint32_t* outMemoryTypeIndex);
         void InitializeForSwapChain(VkImage nativeImage);
 
         void DestroyImpl() override;
@@ -107,7 +148,12 @@ namespace dawn_native { namespace vulkan {
                                 TextureBase::ClearValue);
 
         void TweakTransitionForExternalUsage(CommandRecordingContext* recordingContext,
-                                             std::vector<VkImageMemoryBarrier>* barriers);
+                                             ImageBarrierVector* barriers);
+
+        // If another member of this texture's alias group used the shared memory since this
+        // texture last did, discards the stale contents and layout tracking and arms an
+        // aliasing acquire for the next transition.
+        void AcquireAliasedMemoryIfNeeded();
 
         VkImage mHandle = VK_NULL_HANDLE;
         ResourceMemoryAllocation mMemoryAllocation;
@@ -126,21 +172,37 @@ namespace dawn_native { namespace vulkan {
         VkSemaphore mSignalSemaphore = VK_NULL_HANDLE;
         std::vector<VkSemaphore> mWaitRequirements;
 
+        // True when the memory is shared with the texture's alias group.
+        bool mIsAliased = false;
+        bool mPendingAliasAcquire = false;
+
         // A usage of none will make sure the texture is transitioned before its first use as
         // required by the Vulkan spec.
         std::vector<wgpu::TextureUsage> mLastSubresourceUsages =
             std::vector<wgpu::TextureUsage>(GetSubresourceCount(), wgpu::TextureUsage::None);
+
+        // True while every entry of mLastSubresourceUsages is the same. Transitions covering
+        // the whole resource then emit a single barrier instead of one per mip and layer, so
+        // barrier generation doesn't scale with layer count for textures that stay in a
+        // uniform state (the common case).
+        bool mSameLastUsagesAcrossSubresources = true;
     };
 
-    class TextureView final : public TextureViewBase {
+    // TextureViews are slab-allocated out of memory owned by the Device because they are
+    // created and destroyed frequently (for example while streaming textures in and out)
+    // and shouldn't each pay for a heap allocation.
+    class TextureView final : public TextureViewBase, public PlacementAllocated {
       public:
         static ResultOrError<TextureView*> Create(TextureBase* texture,
                                                   const TextureViewDescriptor* descriptor);
+
+        using TextureViewBase::TextureViewBase;
+
         VkImageView GetHandle() const;
 
       private:
         ~TextureView() override;
-        using TextureViewBase::TextureViewBase;
+        void DeleteThis() override;
         MaybeError Initialize(const TextureViewDescriptor* descriptor);
 
         VkImageView mHandle = VK_NULL_HANDLE;
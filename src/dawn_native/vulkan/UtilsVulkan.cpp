@@ -24,6 +24,31 @@
 
 namespace dawn_native { namespace vulkan {
 
+    const VkSpecializationInfo* BuildSpecializationInfo(uint32_t constantCount,
+                                                        const PipelineConstantEntry* constants,
+                                                        SpecializationInfoStorage* storage) {
+        if (constantCount == 0) {
+            return nullptr;
+        }
+
+        // Each entry carries the raw 32-bit value for one SPIR-V constant id, so the data
+        // block is a flat array of uint32s with one 4-byte map entry per constant.
+        storage->mapEntries.resize(constantCount);
+        storage->data.resize(constantCount);
+        for (uint32_t i = 0; i < constantCount; ++i) {
+            storage->mapEntries[i].constantID = constants[i].constantId;
+            storage->mapEntries[i].offset = static_cast<uint32_t>(i * sizeof(uint32_t));
+            storage->mapEntries[i].size = sizeof(uint32_t);
+            storage->data[i] = constants[i].value;
+        }
+
+        storage->info.mapEntryCount = constantCount;
+        storage->info.pMapEntries = storage->mapEntries.data();
+        storage->info.dataSize = constantCount * sizeof(uint32_t);
+        storage->info.pData = storage->data.data();
+        return &storage->info;
+    }
+
     VkCompareOp ToVulkanCompareOp(wgpu::CompareFunction op) {
         switch (op) {
             case wgpu::CompareFunction::Never:
@@ -152,6 +177,9 @@ namespace dawn_native { namespace vulkan {
         if (buildUsage & wgpu::RayTracingAccelerationContainerUsage::LowMemory) {
             flags |= VK_BUILD_ACCELERATION_STRUCTURE_LOW_MEMORY_BIT_KHR;
         }
+        if (buildUsage & wgpu::RayTracingAccelerationContainerUsage::AllowCompaction) {
+            flags |= VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
+        }
         return static_cast<VkBuildAccelerationStructureFlagsKHR>(flags);
     }
 
@@ -210,16 +238,25 @@ namespace dawn_native { namespace vulkan {
     VkBufferImageCopy ComputeBufferImageCopyRegion(const BufferCopy& bufferCopy,
                                                    const TextureCopy& textureCopy,
                                                    const Extent3D& copySize) {
+        return ComputeBufferImageCopyRegion(bufferCopy.offset, bufferCopy.bytesPerRow,
+                                            bufferCopy.rowsPerImage, textureCopy, copySize);
+    }
+
+    VkBufferImageCopy ComputeBufferImageCopyRegion(uint64_t bufferOffset,
+                                                   uint32_t bytesPerRow,
+                                                   uint32_t rowsPerImage,
+                                                   const TextureCopy& textureCopy,
+                                                   const Extent3D& copySize) {
         const Texture* texture = ToBackend(textureCopy.texture.Get());
 
         VkBufferImageCopy region;
 
-        region.bufferOffset = bufferCopy.offset;
+        region.bufferOffset = bufferOffset;
         // In Vulkan the row length is in texels while it is in bytes for Dawn
         const Format& format = texture->GetFormat();
-        ASSERT(bufferCopy.bytesPerRow % format.blockByteSize == 0);
-        region.bufferRowLength = bufferCopy.bytesPerRow / format.blockByteSize * format.blockWidth;
-        region.bufferImageHeight = bufferCopy.rowsPerImage;
+        ASSERT(bytesPerRow % format.blockByteSize == 0);
+        region.bufferRowLength = bytesPerRow / format.blockByteSize * format.blockWidth;
+        region.bufferImageHeight = rowsPerImage;
 
         region.imageSubresource.aspectMask = texture->GetVkAspectMask();
         region.imageSubresource.mipLevel = textureCopy.mipLevel;
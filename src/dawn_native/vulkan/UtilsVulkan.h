@@ -21,6 +21,8 @@
 #include "dawn_native/vulkan/BufferVk.h"
 #include "dawn_native/vulkan/VulkanError.h"
 
+#include <vector>
+
 namespace dawn_native { namespace vulkan {
 
     VkCompareOp ToVulkanCompareOp(wgpu::CompareFunction op);
@@ -40,10 +42,31 @@ namespace dawn_native { namespace vulkan {
     VkRayTracingShaderGroupTypeKHR ToVulkanShaderBindingTableGroupType(
         wgpu::RayTracingShaderBindingTableGroupType type);
 
+    // Storage referenced by a VkSpecializationInfo built from pipeline constant entries.
+    // It must stay alive for as long as the info may be read, i.e. until the pipeline is
+    // created, or for capturing objects like the shader binding table, as long as the
+    // capture itself.
+    struct SpecializationInfoStorage {
+        std::vector<VkSpecializationMapEntry> mapEntries;
+        std::vector<uint32_t> data;
+        VkSpecializationInfo info;
+    };
+
+    // Fills |storage| from the constant entries of a pipeline stage and returns its
+    // VkSpecializationInfo, or nullptr when the stage has no constants.
+    const VkSpecializationInfo* BuildSpecializationInfo(uint32_t constantCount,
+                                                        const PipelineConstantEntry* constants,
+                                                        SpecializationInfoStorage* storage);
+
     Extent3D ComputeTextureCopyExtent(const TextureCopy& textureCopy, const Extent3D& copySize);
     VkBufferImageCopy ComputeBufferImageCopyRegion(const BufferCopy& bufferCopy,
                                                    const TextureCopy& textureCopy,
                                                    const Extent3D& copySize);
+    VkBufferImageCopy ComputeBufferImageCopyRegion(uint64_t bufferOffset,
+                                                   uint32_t bytesPerRow,
+                                                   uint32_t rowsPerImage,
+                                                   const TextureCopy& textureCopy,
+                                                   const Extent3D& copySize);
 
 }}  // namespace dawn_native::vulkan
 
@@ -21,9 +21,13 @@
 
 #include "dawn_native/VulkanBackend.h"
 
+#include "common/Compiler.h"
+#include "common/Constants.h"
 #include "common/SwapChainUtils.h"
+#include "dawn_native/vulkan/BufferVk.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/NativeSwapChainImplVk.h"
+#include "dawn_native/vulkan/RenderPassCache.h"
 #include "dawn_native/vulkan/TextureVk.h"
 
 namespace dawn_native { namespace vulkan {
@@ -53,12 +57,102 @@ namespace dawn_native { namespace vulkan {
         return impl;
     }
 
+    DawnSwapChainImplementation CreateNativeSwapChainImpl(
+        WGPUDevice device,
+        ::VkSurfaceKHR surfaceNative,
+        const SwapChainLatencyDescriptor* latencyDescriptor) {
+        if (latencyDescriptor == nullptr) {
+            return CreateNativeSwapChainImpl(device, surfaceNative);
+        }
+
+        Device* backendDevice = reinterpret_cast<Device*>(device);
+        VkSurfaceKHR surface = VkSurfaceKHR::CreateFromHandle(surfaceNative);
+
+        DawnSwapChainImplementation impl;
+        impl = CreateSwapChainImplementation(
+            new NativeSwapChainImpl(backendDevice, surface, *latencyDescriptor));
+        impl.textureUsage = WGPUTextureUsage_Present;
+
+        return impl;
+    }
+
     WGPUTextureFormat GetNativeSwapChainPreferredFormat(
         const DawnSwapChainImplementation* swapChain) {
         NativeSwapChainImpl* impl = reinterpret_cast<NativeSwapChainImpl*>(swapChain->userData);
         return static_cast<WGPUTextureFormat>(impl->GetPreferredFormat());
     }
 
+    void FlushPendingPresents(WGPUDevice device) {
+        Device* backendDevice = reinterpret_cast<Device*>(device);
+        backendDevice->FlushPendingPresents();
+    }
+
+    namespace {
+
+        MaybeError PrewarmRenderPass(Device* device,
+                                     const RenderPassPrewarmDescriptor& descriptor) {
+            if (descriptor.colorFormatCount > kMaxColorAttachments) {
+                return DAWN_VALIDATION_ERROR("Too many color formats for render pass pre-warming");
+            }
+
+            // Clear is the typical first use of a new attachment combination. Pipelines reuse
+            // this render pass through the compatibility cache whatever the load ops are, and
+            // other load-op variants are created on demand.
+            RenderPassCacheQuery query;
+            for (uint32_t i = 0; i < descriptor.colorFormatCount; ++i) {
+                query.SetColor(i, static_cast<wgpu::TextureFormat>(descriptor.colorFormats[i]),
+                               wgpu::LoadOp::Clear, descriptor.hasResolveTargets);
+            }
+            if (descriptor.depthStencilFormat != WGPUTextureFormat_Undefined) {
+                query.SetDepthStencil(
+                    static_cast<wgpu::TextureFormat>(descriptor.depthStencilFormat),
+                    wgpu::LoadOp::Clear, wgpu::LoadOp::Clear);
+            }
+            query.SetSampleCount(descriptor.sampleCount);
+
+            VkRenderPass renderPass = VK_NULL_HANDLE;
+            DAWN_TRY_ASSIGN(renderPass, device->GetRenderPassCache()->GetRenderPass(query));
+            DAWN_UNUSED(renderPass);
+            return {};
+        }
+
+    }  // anonymous namespace
+
+    bool PrewarmRenderPassCache(WGPUDevice cDevice,
+                                const RenderPassPrewarmDescriptor* descriptors,
+                                uint32_t count) {
+        Device* device = reinterpret_cast<Device*>(cDevice);
+
+        bool success = true;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (device->ConsumedError(PrewarmRenderPass(device, descriptors[i]))) {
+                success = false;
+            }
+        }
+        return success;
+    }
+
+    uint64_t GetHostPointerImportAlignment(WGPUDevice cDevice) {
+        Device* device = reinterpret_cast<Device*>(cDevice);
+
+        if (!device->GetDeviceInfo().externalMemoryHost) {
+            return 0;
+        }
+        return device->GetDeviceInfo()
+            .externalMemoryHostProperties.minImportedHostPointerAlignment;
+    }
+
+    WGPUBuffer WrapVulkanHostPointer(WGPUDevice cDevice,
+                                     const HostPointerBufferDescriptor* descriptor) {
+        Device* device = reinterpret_cast<Device*>(cDevice);
+        const BufferDescriptor* bufferDescriptor =
+            reinterpret_cast<const BufferDescriptor*>(descriptor->cBufferDescriptor);
+
+        BufferBase* buffer = device->CreateBufferWrappingHostMemory(
+            bufferDescriptor, descriptor->hostPointer, descriptor->allocationSize);
+        return reinterpret_cast<WGPUBuffer>(buffer);
+    }
+
 #ifdef DAWN_PLATFORM_LINUX
     ExternalImageDescriptorFD::ExternalImageDescriptorFD(ExternalImageDescriptorType descType)
         : ExternalImageDescriptor(descType) {
@@ -104,6 +198,83 @@ namespace dawn_native { namespace vulkan {
                 return nullptr;
         }
     }
+
+    WGPUTexture CreateExportableVulkanImage(WGPUDevice cDevice,
+                                            const WGPUTextureDescriptor* descriptor,
+                                            ExternalMemoryExportInfoOpaqueFD* exportInfo) {
+        Device* device = reinterpret_cast<Device*>(cDevice);
+        const TextureDescriptor* textureDescriptor =
+            reinterpret_cast<const TextureDescriptor*>(descriptor);
+
+        ExternalMemoryHandle memoryHandle;
+        TextureBase* texture = device->CreateExportableTexture(
+            textureDescriptor, &memoryHandle, &exportInfo->allocationSize,
+            &exportInfo->memoryTypeIndex);
+        if (texture == nullptr) {
+            return nullptr;
+        }
+
+        exportInfo->memoryFD = memoryHandle;
+        return reinterpret_cast<WGPUTexture>(texture);
+    }
+
+    WGPUBuffer WrapVulkanBuffer(WGPUDevice cDevice,
+                                const ExternalBufferDescriptorOpaqueFD* descriptor) {
+        Device* device = reinterpret_cast<Device*>(cDevice);
+        const BufferDescriptor* bufferDescriptor =
+            reinterpret_cast<const BufferDescriptor*>(descriptor->cBufferDescriptor);
+
+        BufferBase* buffer = device->CreateBufferWrappingVulkanMemory(
+            bufferDescriptor, descriptor->memoryFD, descriptor->allocationSize,
+            descriptor->memoryTypeIndex, descriptor->waitFDs);
+        return reinterpret_cast<WGPUBuffer>(buffer);
+    }
+
+    WGPUBuffer CreateExportableVulkanBuffer(WGPUDevice cDevice,
+                                            const WGPUBufferDescriptor* descriptor,
+                                            ExternalMemoryExportInfoOpaqueFD* exportInfo) {
+        Device* device = reinterpret_cast<Device*>(cDevice);
+        const BufferDescriptor* bufferDescriptor =
+            reinterpret_cast<const BufferDescriptor*>(descriptor);
+
+        ExternalMemoryHandle memoryHandle;
+        BufferBase* buffer = device->CreateExportableBuffer(bufferDescriptor, &memoryHandle,
+                                                            &exportInfo->allocationSize,
+                                                            &exportInfo->memoryTypeIndex);
+        if (buffer == nullptr) {
+            return nullptr;
+        }
+
+        exportInfo->memoryFD = memoryHandle;
+        return reinterpret_cast<WGPUBuffer>(buffer);
+    }
+
+    int ExportSignalSemaphoreOpaqueFD(WGPUDevice cDevice, WGPUBuffer cBuffer) {
+        Device* device = reinterpret_cast<Device*>(cDevice);
+        Buffer* buffer = reinterpret_cast<Buffer*>(cBuffer);
+
+        if (!buffer) {
+            return -1;
+        }
+
+        ExternalSemaphoreHandle outHandle;
+        if (device->ConsumedError(device->SignalAndExportExternalBuffer(buffer, &outHandle))) {
+            return -1;
+        }
+
+        return outHandle;
+    }
+
+    int ExportQueueSignalSemaphoreOpaqueFD(WGPUDevice cDevice) {
+        Device* device = reinterpret_cast<Device*>(cDevice);
+
+        ExternalSemaphoreHandle outHandle;
+        if (device->ConsumedError(device->ExportQueueSignalSemaphore(&outHandle))) {
+            return -1;
+        }
+
+        return outHandle;
+    }
 #endif
 
 }}  // namespace dawn_native::vulkan
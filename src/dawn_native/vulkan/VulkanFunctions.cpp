@@ -296,6 +296,10 @@ namespace dawn_native { namespace vulkan {
             GET_DEVICE_PROC(GetMemoryFdPropertiesKHR);
         }
 
+        if (deviceInfo.externalMemoryHost) {
+            GET_DEVICE_PROC(GetMemoryHostPointerPropertiesEXT);
+        }
+
         if (deviceInfo.externalSemaphoreFD) {
             GET_DEVICE_PROC(ImportSemaphoreFdKHR);
             GET_DEVICE_PROC(GetSemaphoreFdKHR);
@@ -321,14 +325,34 @@ namespace dawn_native { namespace vulkan {
             GET_DEVICE_PROC(QueuePresentKHR);
         }
 
+        if (deviceInfo.descriptorUpdateTemplate) {
+            GET_DEVICE_PROC(CreateDescriptorUpdateTemplateKHR);
+            GET_DEVICE_PROC(DestroyDescriptorUpdateTemplateKHR);
+            GET_DEVICE_PROC(UpdateDescriptorSetWithTemplateKHR);
+        }
+
+        if (deviceInfo.drawIndirectCount) {
+            GET_DEVICE_PROC(CmdDrawIndirectCountKHR);
+            GET_DEVICE_PROC(CmdDrawIndexedIndirectCountKHR);
+        }
+
+        if (deviceInfo.timelineSemaphore) {
+            GET_DEVICE_PROC(GetSemaphoreCounterValueKHR);
+            GET_DEVICE_PROC(WaitSemaphoresKHR);
+        }
+
         if (deviceInfo.rayTracingKHR) {
             GET_DEVICE_PROC(CreateAccelerationStructureKHR);
             GET_DEVICE_PROC(CreateRayTracingPipelinesKHR);
             GET_DEVICE_PROC(CmdBuildAccelerationStructureKHR);
             GET_DEVICE_PROC(CmdCopyAccelerationStructureKHR);
+            GET_DEVICE_PROC(CmdCopyAccelerationStructureToMemoryKHR);
+            GET_DEVICE_PROC(CmdCopyMemoryToAccelerationStructureKHR);
+            GET_DEVICE_PROC(CmdWriteAccelerationStructuresPropertiesKHR);
             GET_DEVICE_PROC(DestroyAccelerationStructureKHR);
             GET_DEVICE_PROC(GetRayTracingShaderGroupHandlesKHR);
             GET_DEVICE_PROC(CmdTraceRaysKHR);
+            GET_DEVICE_PROC(CmdTraceRaysIndirectKHR);
             GET_DEVICE_PROC(BindAccelerationStructureMemoryKHR);
             GET_DEVICE_PROC(CreateAccelerationStructureKHR);
             GET_DEVICE_PROC(GetAccelerationStructureDeviceAddressKHR);
@@ -274,6 +274,9 @@ namespace dawn_native { namespace vulkan {
         PFN_vkGetMemoryFdKHR GetMemoryFdKHR = nullptr;
         PFN_vkGetMemoryFdPropertiesKHR GetMemoryFdPropertiesKHR = nullptr;
 
+        // VK_EXT_external_memory_host
+        PFN_vkGetMemoryHostPointerPropertiesEXT GetMemoryHostPointerPropertiesEXT = nullptr;
+
         // VK_KHR_external_semaphore_fd
         PFN_vkImportSemaphoreFdKHR ImportSemaphoreFdKHR = nullptr;
         PFN_vkGetSemaphoreFdKHR GetSemaphoreFdKHR = nullptr;
@@ -289,14 +292,34 @@ namespace dawn_native { namespace vulkan {
         PFN_vkGetSemaphoreZirconHandleFUCHSIA GetSemaphoreZirconHandleFUCHSIA = nullptr;
 #endif
 
+        // VK_KHR_descriptor_update_template
+        PFN_vkCreateDescriptorUpdateTemplateKHR CreateDescriptorUpdateTemplateKHR = nullptr;
+        PFN_vkDestroyDescriptorUpdateTemplateKHR DestroyDescriptorUpdateTemplateKHR = nullptr;
+        PFN_vkUpdateDescriptorSetWithTemplateKHR UpdateDescriptorSetWithTemplateKHR = nullptr;
+
+        // VK_KHR_draw_indirect_count
+        PFN_vkCmdDrawIndirectCountKHR CmdDrawIndirectCountKHR = nullptr;
+        PFN_vkCmdDrawIndexedIndirectCountKHR CmdDrawIndexedIndirectCountKHR = nullptr;
+
+        // VK_KHR_timeline_semaphore
+        PFN_vkGetSemaphoreCounterValueKHR GetSemaphoreCounterValueKHR = nullptr;
+        PFN_vkWaitSemaphoresKHR WaitSemaphoresKHR = nullptr;
+
         // VK_KHR_ray_tracing
         PFN_vkCreateAccelerationStructureKHR CreateAccelerationStructureKHR = nullptr;
         PFN_vkCreateRayTracingPipelinesKHR CreateRayTracingPipelinesKHR = nullptr;
         PFN_vkCmdBuildAccelerationStructureKHR CmdBuildAccelerationStructureKHR = nullptr;
         PFN_vkCmdCopyAccelerationStructureKHR CmdCopyAccelerationStructureKHR = nullptr;
+        PFN_vkCmdCopyAccelerationStructureToMemoryKHR CmdCopyAccelerationStructureToMemoryKHR =
+            nullptr;
+        PFN_vkCmdCopyMemoryToAccelerationStructureKHR CmdCopyMemoryToAccelerationStructureKHR =
+            nullptr;
+        PFN_vkCmdWriteAccelerationStructuresPropertiesKHR
+            CmdWriteAccelerationStructuresPropertiesKHR = nullptr;
         PFN_vkDestroyAccelerationStructureKHR DestroyAccelerationStructureKHR = nullptr;
         PFN_vkGetRayTracingShaderGroupHandlesKHR GetRayTracingShaderGroupHandlesKHR = nullptr;
         PFN_vkCmdTraceRaysKHR CmdTraceRaysKHR = nullptr;
+        PFN_vkCmdTraceRaysIndirectKHR CmdTraceRaysIndirectKHR = nullptr;
         PFN_vkBindAccelerationStructureMemoryKHR BindAccelerationStructureMemoryKHR = nullptr;
         PFN_vkGetAccelerationStructureDeviceAddressKHR GetAccelerationStructureDeviceAddressKHR =
             nullptr;
@@ -63,6 +63,7 @@ namespace dawn_native { namespace vulkan {
         "VK_KHR_external_memory_capabilities";
     const char kExtensionNameKhrExternalMemoryFD[] = "VK_KHR_external_memory_fd";
     const char kExtensionNameExtExternalMemoryDmaBuf[] = "VK_EXT_external_memory_dma_buf";
+    const char kExtensionNameExtExternalMemoryHost[] = "VK_EXT_external_memory_host";
     const char kExtensionNameExtImageDrmFormatModifier[] = "VK_EXT_image_drm_format_modifier";
     const char kExtensionNameFuchsiaExternalMemory[] = "VK_FUCHSIA_external_memory";
     const char kExtensionNameKhrExternalSemaphore[] = "VK_KHR_external_semaphore";
@@ -80,8 +81,14 @@ namespace dawn_native { namespace vulkan {
     const char kExtensionNameKhrXlibSurface[] = "VK_KHR_xlib_surface";
     const char kExtensionNameFuchsiaImagePipeSurface[] = "VK_FUCHSIA_imagepipe_surface";
     const char kExtensionNameKhrMaintenance1[] = "VK_KHR_maintenance1";
+    const char kExtensionNameKhrDescriptorUpdateTemplate[] =
+        "VK_KHR_descriptor_update_template";
+    const char kExtensionNameKhrDrawIndirectCount[] = "VK_KHR_draw_indirect_count";
+    const char kExtensionNameKhrTimelineSemaphore[] = "VK_KHR_timeline_semaphore";
+    const char kExtensionNameExtMemoryBudget[] = "VK_EXT_memory_budget";
     const char kExtensionNameKhrRayTracing[] = "VK_KHR_ray_tracing";
     const char kExtensionNameKhrGetMemoryRequirements2[] = "VK_KHR_get_memory_requirements2";
+    const char kExtensionNameKhrDedicatedAllocation[] = "VK_KHR_dedicated_allocation";
     const char kExtensionNameExtDescriptorIndexing[] = "VK_EXT_descriptor_indexing";
     const char kExtensionNameKhrDeferredHostOperations[] = "VK_KHR_deferred_host_operations";
     const char kExtensionNameKhrPipelineLibrary[] = "VK_KHR_pipeline_library";
@@ -240,6 +247,18 @@ namespace dawn_native { namespace vulkan {
         vkFunctions.GetPhysicalDeviceProperties(physicalDevice, &info.properties);
         vkFunctions.GetPhysicalDeviceFeatures(physicalDevice, &info.features);
 
+        // Gather the driver and device UUIDs, they identify which device serialized
+        // acceleration container blobs are compatible with.
+        if (globalInfo.getPhysicalDeviceProperties2) {
+            info.idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+            info.idProperties.pNext = nullptr;
+
+            VkPhysicalDeviceProperties2 deviceProperties2 = {};
+            deviceProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            deviceProperties2.pNext = &info.idProperties;
+            vkFunctions.GetPhysicalDeviceProperties2(physicalDevice, &deviceProperties2);
+        }
+
         // Gather info about device memory.
         {
             VkPhysicalDeviceMemoryProperties memory;
@@ -303,6 +322,18 @@ namespace dawn_native { namespace vulkan {
                 if (IsExtensionName(extension, kExtensionNameExtExternalMemoryDmaBuf)) {
                     info.externalMemoryDmaBuf = true;
                 }
+                if (IsExtensionName(extension, kExtensionNameExtExternalMemoryHost) &&
+                    globalInfo.getPhysicalDeviceProperties2) {
+                    info.externalMemoryHost = true;
+                    info.externalMemoryHostProperties.sType =
+                        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT;
+                    info.externalMemoryHostProperties.pNext = nullptr;
+
+                    VkPhysicalDeviceProperties2 deviceProperties2 = {};
+                    deviceProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+                    deviceProperties2.pNext = &info.externalMemoryHostProperties;
+                    vkFunctions.GetPhysicalDeviceProperties2(physicalDevice, &deviceProperties2);
+                }
                 if (IsExtensionName(extension, kExtensionNameExtImageDrmFormatModifier)) {
                     info.imageDrmFormatModifier = true;
                 }
@@ -324,12 +355,40 @@ namespace dawn_native { namespace vulkan {
                 if (IsExtensionName(extension, kExtensionNameKhrMaintenance1)) {
                     info.maintenance1 = true;
                 }
+                if (IsExtensionName(extension, kExtensionNameKhrDescriptorUpdateTemplate)) {
+                    info.descriptorUpdateTemplate = true;
+                }
+                if (IsExtensionName(extension, kExtensionNameKhrDrawIndirectCount)) {
+                    info.drawIndirectCount = true;
+                }
+                if (IsExtensionName(extension, kExtensionNameKhrTimelineSemaphore)) {
+                    info.timelineSemaphore = true;
+                }
+                if (IsExtensionName(extension, kExtensionNameExtMemoryBudget)) {
+                    info.memoryBudget = true;
+                }
                 if (IsExtensionName(extension, kExtensionNameKhrRayTracing)) {
                     info.rayTracingKHR = true;
+
+                    if (globalInfo.getPhysicalDeviceProperties2) {
+                        info.rayTracingFeatures.sType =
+                            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_FEATURES_KHR;
+                        info.rayTracingFeatures.pNext = nullptr;
+
+                        VkPhysicalDeviceFeatures2KHR physicalDeviceFeatures2 = {};
+                        physicalDeviceFeatures2.sType =
+                            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+                        physicalDeviceFeatures2.pNext = &info.rayTracingFeatures;
+                        vkFunctions.GetPhysicalDeviceFeatures2(physicalDevice,
+                                                               &physicalDeviceFeatures2);
+                    }
                 }
                 if (IsExtensionName(extension, kExtensionNameKhrGetMemoryRequirements2)) {
                     info.memoryRequirements2 = true;
                 }
+                if (IsExtensionName(extension, kExtensionNameKhrDedicatedAllocation)) {
+                    info.dedicatedAllocation = true;
+                }
                 if (IsExtensionName(extension, kExtensionNameExtDescriptorIndexing)) {
                     info.descriptorIndexing = true;
                 }
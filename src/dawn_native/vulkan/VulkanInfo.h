@@ -38,6 +38,7 @@ namespace dawn_native { namespace vulkan {
     extern const char kExtensionNameKhrExternalMemoryCapabilities[];
     extern const char kExtensionNameKhrExternalMemoryFD[];
     extern const char kExtensionNameExtExternalMemoryDmaBuf[];
+    extern const char kExtensionNameExtExternalMemoryHost[];
     extern const char kExtensionNameExtImageDrmFormatModifier[];
     extern const char kExtensionNameFuchsiaExternalMemory[];
     extern const char kExtensionNameKhrExternalSemaphore[];
@@ -53,8 +54,13 @@ namespace dawn_native { namespace vulkan {
     extern const char kExtensionNameKhrXlibSurface[];
     extern const char kExtensionNameFuchsiaImagePipeSurface[];
     extern const char kExtensionNameKhrMaintenance1[];
+    extern const char kExtensionNameKhrDescriptorUpdateTemplate[];
+    extern const char kExtensionNameKhrDrawIndirectCount[];
+    extern const char kExtensionNameKhrTimelineSemaphore[];
+    extern const char kExtensionNameExtMemoryBudget[];
     extern const char kExtensionNameKhrRayTracing[];
     extern const char kExtensionNameKhrGetMemoryRequirements2[];
+    extern const char kExtensionNameKhrDedicatedAllocation[];
     extern const char kExtensionNameExtDescriptorIndexing[];
     extern const char kExtensionNameKhrDeferredHostOperations[];
     extern const char kExtensionNameKhrPipelineLibrary[];
@@ -97,12 +103,14 @@ namespace dawn_native { namespace vulkan {
         VkPhysicalDeviceFeatures features;
         VkPhysicalDeviceShaderFloat16Int8FeaturesKHR shaderFloat16Int8Features;
         VkPhysicalDevice16BitStorageFeaturesKHR _16BitStorageFeatures;
+        VkPhysicalDeviceRayTracingFeaturesKHR rayTracingFeatures;
 
         bool debugUtils = false;
         bool debugMarker = false;
         bool externalMemory = false;
         bool externalMemoryFD = false;
         bool externalMemoryDmaBuf = false;
+        bool externalMemoryHost = false;
         bool imageDrmFormatModifier = false;
         bool externalMemoryZirconHandle = false;
         bool externalSemaphore = false;
@@ -110,8 +118,13 @@ namespace dawn_native { namespace vulkan {
         bool externalSemaphoreZirconHandle = false;
         bool swapchain = false;
         bool maintenance1 = false;
+        bool descriptorUpdateTemplate = false;
+        bool drawIndirectCount = false;
+        bool timelineSemaphore = false;
+        bool memoryBudget = false;
         bool rayTracingKHR = false;
         bool memoryRequirements2 = false;
+        bool dedicatedAllocation = false;
         bool descriptorIndexing = false;
         bool deferredHostOperations = false;
         bool pipelineLibrary = false;
@@ -122,6 +135,11 @@ namespace dawn_native { namespace vulkan {
 
     struct VulkanDeviceInfo : VulkanDeviceKnobs {
         VkPhysicalDeviceProperties properties;
+        // Only valid when the instance supports vkGetPhysicalDeviceProperties2; the
+        // UUIDs are all zeros otherwise.
+        VkPhysicalDeviceIDProperties idProperties;
+        // Only valid when externalMemoryHost is true.
+        VkPhysicalDeviceExternalMemoryHostPropertiesEXT externalMemoryHostProperties;
         std::vector<VkQueueFamilyProperties> queueFamilies;
 
         std::vector<VkMemoryType> memoryTypes;
@@ -58,10 +58,32 @@ namespace dawn_native { namespace vulkan { namespace external_memory {
                                                    const MemoryImportParams& importParams,
                                                    VkImage image);
 
+        // Given an external handle pointing to memory, import it into a VkDeviceMemory to be
+        // bound to `buffer`
+        ResultOrError<VkDeviceMemory> ImportBufferMemory(ExternalMemoryHandle handle,
+                                                         const MemoryImportParams& importParams,
+                                                         VkBuffer buffer);
+
         // Create a VkImage for the given handle type
         ResultOrError<VkImage> CreateImage(const ExternalImageDescriptor* descriptor,
                                            const VkImageCreateInfo& baseCreateInfo);
 
+        // The Vulkan external memory handle type this service imports and exports.
+        VkExternalMemoryHandleTypeFlagBits GetMemoryHandleType() const;
+
+        // Allocates memory that can later be exported with ExportMemory.
+        ResultOrError<VkDeviceMemory> AllocateExportableMemory(VkDeviceSize allocationSize,
+                                                               uint32_t memoryTypeIndex);
+
+        // Exports `memory` as an external handle another device can import. Ownership of the
+        // handle is transferred to the caller.
+        ResultOrError<ExternalMemoryHandle> ExportMemory(VkDeviceMemory memory);
+
+        // True if the external memory extensions required by the service are available.
+        bool Supported() const {
+            return mSupported;
+        }
+
       private:
         Device* mDevice = nullptr;
 
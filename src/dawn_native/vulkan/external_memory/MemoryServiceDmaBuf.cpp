@@ -218,6 +218,27 @@ namespace dawn_native { namespace vulkan { namespace external_memory {
         return allocatedMemory;
     }
 
+    ResultOrError<VkDeviceMemory> Service::ImportBufferMemory(ExternalMemoryHandle handle,
+                                                              const MemoryImportParams& importParams,
+                                                              VkBuffer buffer) {
+        return DAWN_VALIDATION_ERROR("Buffer memory import is not supported with dma-buf memory");
+    }
+
+    VkExternalMemoryHandleTypeFlagBits Service::GetMemoryHandleType() const {
+        return VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
+    }
+
+    ResultOrError<VkDeviceMemory> Service::AllocateExportableMemory(VkDeviceSize allocationSize,
+                                                                    uint32_t memoryTypeIndex) {
+        // Exporting as dma-buf would additionally require negotiating a DRM format modifier
+        // with the consumer, which Dawn doesn't implement.
+        return DAWN_VALIDATION_ERROR("Memory export is not supported with dma-buf memory");
+    }
+
+    ResultOrError<ExternalMemoryHandle> Service::ExportMemory(VkDeviceMemory memory) {
+        return DAWN_VALIDATION_ERROR("Memory export is not supported with dma-buf memory");
+    }
+
     ResultOrError<VkImage> Service::CreateImage(const ExternalImageDescriptor* descriptor,
                                                 const VkImageCreateInfo& baseCreateInfo) {
         if (descriptor->type != ExternalImageDescriptorType::DmaBuf) {
@@ -50,9 +50,28 @@ namespace dawn_native { namespace vulkan { namespace external_memory {
         return DAWN_UNIMPLEMENTED_ERROR("Using null memory service to interop inside Vulkan");
     }
 
+    ResultOrError<VkDeviceMemory> Service::ImportBufferMemory(ExternalMemoryHandle handle,
+                                                              const MemoryImportParams& importParams,
+                                                              VkBuffer buffer) {
+        return DAWN_UNIMPLEMENTED_ERROR("Using null memory service to interop inside Vulkan");
+    }
+
     ResultOrError<VkImage> Service::CreateImage(const ExternalImageDescriptor* descriptor,
                                                 const VkImageCreateInfo& baseCreateInfo) {
         return DAWN_UNIMPLEMENTED_ERROR("Using null memory service to interop inside Vulkan");
     }
 
+    VkExternalMemoryHandleTypeFlagBits Service::GetMemoryHandleType() const {
+        return VK_EXTERNAL_MEMORY_HANDLE_TYPE_FLAG_BITS_MAX_ENUM;
+    }
+
+    ResultOrError<VkDeviceMemory> Service::AllocateExportableMemory(VkDeviceSize allocationSize,
+                                                                    uint32_t memoryTypeIndex) {
+        return DAWN_UNIMPLEMENTED_ERROR("Using null memory service to interop inside Vulkan");
+    }
+
+    ResultOrError<ExternalMemoryHandle> Service::ExportMemory(VkDeviceMemory memory) {
+        return DAWN_UNIMPLEMENTED_ERROR("Using null memory service to interop inside Vulkan");
+    }
+
 }}}  // namespace dawn_native::vulkan::external_memory
@@ -133,6 +133,80 @@ namespace dawn_native { namespace vulkan { namespace external_memory {
         return allocatedMemory;
     }
 
+    ResultOrError<VkDeviceMemory> Service::ImportBufferMemory(ExternalMemoryHandle handle,
+                                                              const MemoryImportParams& importParams,
+                                                              VkBuffer buffer) {
+        if (handle < 0) {
+            return DAWN_VALIDATION_ERROR("Trying to import memory with invalid handle");
+        }
+
+        VkMemoryRequirements requirements;
+        mDevice->fn.GetBufferMemoryRequirements(mDevice->GetVkDevice(), buffer, &requirements);
+        if (requirements.size > importParams.allocationSize) {
+            return DAWN_VALIDATION_ERROR("Requested allocation size is too small for buffer");
+        }
+
+        VkImportMemoryFdInfoKHR importMemoryFdInfo;
+        importMemoryFdInfo.sType = VK_STRUCTURE_TYPE_IMPORT_MEMORY_FD_INFO_KHR;
+        importMemoryFdInfo.pNext = nullptr;
+        importMemoryFdInfo.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT_KHR;
+        importMemoryFdInfo.fd = handle;
+
+        VkMemoryAllocateInfo allocateInfo;
+        allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocateInfo.pNext = &importMemoryFdInfo;
+        allocateInfo.allocationSize = importParams.allocationSize;
+        allocateInfo.memoryTypeIndex = importParams.memoryTypeIndex;
+
+        VkDeviceMemory allocatedMemory = VK_NULL_HANDLE;
+        DAWN_TRY(CheckVkSuccess(mDevice->fn.AllocateMemory(mDevice->GetVkDevice(), &allocateInfo,
+                                                           nullptr, &*allocatedMemory),
+                                "vkAllocateMemory"));
+        return allocatedMemory;
+    }
+
+    VkExternalMemoryHandleTypeFlagBits Service::GetMemoryHandleType() const {
+        return VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT_KHR;
+    }
+
+    ResultOrError<VkDeviceMemory> Service::AllocateExportableMemory(VkDeviceSize allocationSize,
+                                                                    uint32_t memoryTypeIndex) {
+        if (!mSupported) {
+            return DAWN_VALIDATION_ERROR("Exporting memory is not supported");
+        }
+
+        VkExportMemoryAllocateInfoKHR exportMemoryAllocateInfo;
+        exportMemoryAllocateInfo.sType = VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO_KHR;
+        exportMemoryAllocateInfo.pNext = nullptr;
+        exportMemoryAllocateInfo.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT_KHR;
+
+        VkMemoryAllocateInfo allocateInfo;
+        allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocateInfo.pNext = &exportMemoryAllocateInfo;
+        allocateInfo.allocationSize = allocationSize;
+        allocateInfo.memoryTypeIndex = memoryTypeIndex;
+
+        VkDeviceMemory allocatedMemory = VK_NULL_HANDLE;
+        DAWN_TRY(CheckVkSuccess(mDevice->fn.AllocateMemory(mDevice->GetVkDevice(), &allocateInfo,
+                                                           nullptr, &*allocatedMemory),
+                                "vkAllocateMemory"));
+        return allocatedMemory;
+    }
+
+    ResultOrError<ExternalMemoryHandle> Service::ExportMemory(VkDeviceMemory memory) {
+        VkMemoryGetFdInfoKHR getFdInfo;
+        getFdInfo.sType = VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR;
+        getFdInfo.pNext = nullptr;
+        getFdInfo.memory = memory;
+        getFdInfo.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT_KHR;
+
+        int fd = -1;
+        DAWN_TRY(CheckVkSuccess(
+            mDevice->fn.GetMemoryFdKHR(mDevice->GetVkDevice(), &getFdInfo, &fd),
+            "vkGetMemoryFdKHR"));
+        return fd;
+    }
+
     ResultOrError<VkImage> Service::CreateImage(const ExternalImageDescriptor* descriptor,
                                                 const VkImageCreateInfo& baseCreateInfo) {
         VkImageCreateInfo createInfo = baseCreateInfo;
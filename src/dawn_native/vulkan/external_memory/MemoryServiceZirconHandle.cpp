@@ -135,6 +135,83 @@ namespace dawn_native { namespace vulkan { namespace external_memory {
         return allocatedMemory;
     }
 
+    ResultOrError<VkDeviceMemory> Service::ImportBufferMemory(ExternalMemoryHandle handle,
+                                                              const MemoryImportParams& importParams,
+                                                              VkBuffer buffer) {
+        if (handle == ZX_HANDLE_INVALID) {
+            return DAWN_VALIDATION_ERROR("Trying to import memory with invalid handle");
+        }
+
+        VkMemoryRequirements requirements;
+        mDevice->fn.GetBufferMemoryRequirements(mDevice->GetVkDevice(), buffer, &requirements);
+        if (requirements.size > importParams.allocationSize) {
+            return DAWN_VALIDATION_ERROR("Requested allocation size is too small for buffer");
+        }
+
+        VkImportMemoryZirconHandleInfoFUCHSIA importMemoryHandleInfo;
+        importMemoryHandleInfo.sType =
+            VK_STRUCTURE_TYPE_TEMP_MEMORY_ZIRCON_HANDLE_PROPERTIES_FUCHSIA;
+        importMemoryHandleInfo.pNext = nullptr;
+        importMemoryHandleInfo.handleType =
+            VK_EXTERNAL_MEMORY_HANDLE_TYPE_TEMP_ZIRCON_VMO_BIT_FUCHSIA;
+        importMemoryHandleInfo.handle = handle;
+
+        VkMemoryAllocateInfo allocateInfo;
+        allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocateInfo.pNext = &importMemoryHandleInfo;
+        allocateInfo.allocationSize = importParams.allocationSize;
+        allocateInfo.memoryTypeIndex = importParams.memoryTypeIndex;
+
+        VkDeviceMemory allocatedMemory = VK_NULL_HANDLE;
+        DAWN_TRY(CheckVkSuccess(mDevice->fn.AllocateMemory(mDevice->GetVkDevice(), &allocateInfo,
+                                                           nullptr, &*allocatedMemory),
+                                "vkAllocateMemory"));
+        return allocatedMemory;
+    }
+
+    VkExternalMemoryHandleTypeFlagBits Service::GetMemoryHandleType() const {
+        return VK_EXTERNAL_MEMORY_HANDLE_TYPE_TEMP_ZIRCON_VMO_BIT_FUCHSIA;
+    }
+
+    ResultOrError<VkDeviceMemory> Service::AllocateExportableMemory(VkDeviceSize allocationSize,
+                                                                    uint32_t memoryTypeIndex) {
+        if (!mSupported) {
+            return DAWN_VALIDATION_ERROR("Exporting memory is not supported");
+        }
+
+        VkExportMemoryAllocateInfoKHR exportMemoryAllocateInfo;
+        exportMemoryAllocateInfo.sType = VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO_KHR;
+        exportMemoryAllocateInfo.pNext = nullptr;
+        exportMemoryAllocateInfo.handleTypes =
+            VK_EXTERNAL_MEMORY_HANDLE_TYPE_TEMP_ZIRCON_VMO_BIT_FUCHSIA;
+
+        VkMemoryAllocateInfo allocateInfo;
+        allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocateInfo.pNext = &exportMemoryAllocateInfo;
+        allocateInfo.allocationSize = allocationSize;
+        allocateInfo.memoryTypeIndex = memoryTypeIndex;
+
+        VkDeviceMemory allocatedMemory = VK_NULL_HANDLE;
+        DAWN_TRY(CheckVkSuccess(mDevice->fn.AllocateMemory(mDevice->GetVkDevice(), &allocateInfo,
+                                                           nullptr, &*allocatedMemory),
+                                "vkAllocateMemory"));
+        return allocatedMemory;
+    }
+
+    ResultOrError<ExternalMemoryHandle> Service::ExportMemory(VkDeviceMemory memory) {
+        VkMemoryGetZirconHandleInfoFUCHSIA memoryGetHandleInfo;
+        memoryGetHandleInfo.sType = VK_STRUCTURE_TYPE_TEMP_MEMORY_GET_ZIRCON_HANDLE_INFO_FUCHSIA;
+        memoryGetHandleInfo.pNext = nullptr;
+        memoryGetHandleInfo.memory = memory;
+        memoryGetHandleInfo.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_TEMP_ZIRCON_VMO_BIT_FUCHSIA;
+
+        zx_handle_t handle = ZX_HANDLE_INVALID;
+        DAWN_TRY(CheckVkSuccess(mDevice->fn.GetMemoryZirconHandleFUCHSIA(
+                                    mDevice->GetVkDevice(), &memoryGetHandleInfo, &handle),
+                                "vkGetMemoryZirconHandleFUCHSIA"));
+        return handle;
+    }
+
     ResultOrError<VkImage> Service::CreateImage(const ExternalImageDescriptor* descriptor,
                                                 const VkImageCreateInfo& baseCreateInfo) {
         VkImageCreateInfo createInfo = baseCreateInfo;
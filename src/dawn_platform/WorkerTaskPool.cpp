@@ -0,0 +1,216 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_platform/DawnPlatform.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace dawn_platform {
+
+    namespace {
+
+        // Iterations are handed out in chunks so the cursor isn't contended on every
+        // index, while chunks stay small enough for uneven iterations to rebalance.
+        constexpr uint32_t kParallelForChunkSize = 16;
+
+        struct ParallelForState {
+            ParallelForCallback callback;
+            void* userdata;
+            uint32_t iterationCount;
+            std::atomic<uint32_t> nextIndex;
+            uint32_t pendingHelpers;
+            std::mutex mutex;
+            std::condition_variable condition;
+        };
+
+        void RunParallelForChunks(ParallelForState* state) {
+            for (;;) {
+                uint32_t start = state->nextIndex.fetch_add(kParallelForChunkSize);
+                if (start >= state->iterationCount) {
+                    return;
+                }
+                uint32_t end = std::min(start + kParallelForChunkSize, state->iterationCount);
+                for (uint32_t i = start; i < end; ++i) {
+                    state->callback(state->userdata, i);
+                }
+            }
+        }
+
+        void RunParallelForHelper(void* userdata) {
+            ParallelForState* state = static_cast<ParallelForState*>(userdata);
+            RunParallelForChunks(state);
+
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->pendingHelpers--;
+            if (state->pendingHelpers == 0) {
+                state->condition.notify_one();
+            }
+        }
+
+        // The process-wide pool handed out when the platform doesn't provide one. Tasks
+        // go through a single shared queue; delayed tasks wait in a min-heap on their
+        // due time and move to the queue when it is reached.
+        class DefaultWorkerTaskPool final : public WorkerTaskPool {
+          public:
+            DefaultWorkerTaskPool() {
+                uint32_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+                for (uint32_t i = 0; i < threadCount; ++i) {
+                    mThreads.emplace_back([this]() { WorkerLoop(); });
+                }
+            }
+
+            ~DefaultWorkerTaskPool() override {
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mShuttingDown = true;
+                }
+                mCondition.notify_all();
+                for (std::thread& thread : mThreads) {
+                    thread.join();
+                }
+            }
+
+            void PostWorkerTask(WorkerTaskCallback callback, void* userdata) override {
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mTasks.push({callback, userdata});
+                }
+                mCondition.notify_one();
+            }
+
+            void PostDelayedWorkerTask(WorkerTaskCallback callback,
+                                       void* userdata,
+                                       uint64_t delayMs) override {
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mDelayedTasks.push(
+                        {std::chrono::steady_clock::now() + std::chrono::milliseconds(delayMs),
+                         {callback, userdata}});
+                }
+                mCondition.notify_one();
+            }
+
+            uint32_t GetMaxConcurrentTasks() override {
+                return static_cast<uint32_t>(mThreads.size());
+            }
+
+          private:
+            struct Task {
+                WorkerTaskCallback callback;
+                void* userdata;
+            };
+
+            struct DelayedTask {
+                std::chrono::steady_clock::time_point dueTime;
+                Task task;
+
+                bool operator>(const DelayedTask& other) const {
+                    return dueTime > other.dueTime;
+                }
+            };
+
+            void WorkerLoop() {
+                std::unique_lock<std::mutex> lock(mMutex);
+                for (;;) {
+                    // Promote delayed tasks whose due time passed.
+                    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                    while (!mDelayedTasks.empty() && mDelayedTasks.top().dueTime <= now) {
+                        mTasks.push(mDelayedTasks.top().task);
+                        mDelayedTasks.pop();
+                    }
+
+                    if (!mTasks.empty()) {
+                        Task task = mTasks.front();
+                        mTasks.pop();
+
+                        lock.unlock();
+                        task.callback(task.userdata);
+                        lock.lock();
+                        continue;
+                    }
+
+                    if (mShuttingDown) {
+                        return;
+                    }
+
+                    if (mDelayedTasks.empty()) {
+                        mCondition.wait(lock);
+                    } else {
+                        mCondition.wait_until(lock, mDelayedTasks.top().dueTime);
+                    }
+                }
+            }
+
+            std::mutex mMutex;
+            std::condition_variable mCondition;
+            std::queue<Task> mTasks;
+            std::priority_queue<DelayedTask, std::vector<DelayedTask>, std::greater<DelayedTask>>
+                mDelayedTasks;
+            std::vector<std::thread> mThreads;
+            bool mShuttingDown = false;
+        };
+
+    }  // anonymous namespace
+
+    WorkerTaskPool::~WorkerTaskPool() = default;
+
+    uint32_t WorkerTaskPool::GetMaxConcurrentTasks() {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    void WorkerTaskPool::ParallelFor(uint32_t iterationCount,
+                                     ParallelForCallback callback,
+                                     void* userdata) {
+        if (iterationCount == 0) {
+            return;
+        }
+
+        ParallelForState state;
+        state.callback = callback;
+        state.userdata = userdata;
+        state.iterationCount = iterationCount;
+        state.nextIndex = 0;
+
+        // One helper per worker beyond the calling thread, but never more helpers than
+        // chunks so none of them is posted just to find the cursor exhausted.
+        uint32_t chunkCount = (iterationCount + kParallelForChunkSize - 1) / kParallelForChunkSize;
+        uint32_t helperCount = std::min(std::max(GetMaxConcurrentTasks(), 1u) - 1, chunkCount - 1);
+        state.pendingHelpers = helperCount;
+
+        for (uint32_t i = 0; i < helperCount; ++i) {
+            PostWorkerTask(RunParallelForHelper, &state);
+        }
+
+        // The calling thread participates instead of blocking idle.
+        RunParallelForChunks(&state);
+
+        // Helpers only exit once the cursor is exhausted, so once the last one is done
+        // every iteration has completed and |state| can leave the stack.
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.condition.wait(lock, [&state]() { return state.pendingHelpers == 0; });
+    }
+
+    WorkerTaskPool* Platform::GetWorkerTaskPool() {
+        static DefaultWorkerTaskPool* pool = new DefaultWorkerTaskPool();
+        return pool;
+    }
+
+}  // namespace dawn_platform
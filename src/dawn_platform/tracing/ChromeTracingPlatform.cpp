@@ -0,0 +1,205 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_platform/tracing/ChromeTracingPlatform.h"
+
+#include "common/Assert.h"
+#include "dawn_platform/tracing/TraceEvent.h"
+
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+namespace dawn_platform { namespace tracing {
+
+    namespace {
+
+        struct TraceCategoryInfo {
+            unsigned char enabled;
+            TraceCategory category;
+        };
+
+        constexpr TraceCategoryInfo gTraceCategories[4] = {
+            {1, TraceCategory::General},
+            {1, TraceCategory::Validation},
+            {1, TraceCategory::Recording},
+            {1, TraceCategory::GPUWork},
+        };
+
+        static_assert(static_cast<uint32_t>(TraceCategory::General) == 0, "");
+        static_assert(static_cast<uint32_t>(TraceCategory::Validation) == 1, "");
+        static_assert(static_cast<uint32_t>(TraceCategory::Recording) == 2, "");
+        static_assert(static_cast<uint32_t>(TraceCategory::GPUWork) == 3, "");
+
+        const char* TraceCategoryName(TraceCategory category) {
+            switch (category) {
+                case TraceCategory::General:
+                    return "general";
+                case TraceCategory::Validation:
+                    return "validation";
+                case TraceCategory::Recording:
+                    return "recording";
+                case TraceCategory::GPUWork:
+                    return "gpu";
+                default:
+                    UNREACHABLE();
+            }
+        }
+
+    }  // anonymous namespace
+
+    ChromeTracingPlatform::ChromeTracingPlatform()
+        : mTimeOrigin(std::chrono::steady_clock::now()) {
+    }
+
+    ChromeTracingPlatform::~ChromeTracingPlatform() = default;
+
+    const unsigned char* ChromeTracingPlatform::GetTraceCategoryEnabledFlag(
+        TraceCategory category) {
+        switch (category) {
+            case TraceCategory::General:
+            case TraceCategory::Validation:
+            case TraceCategory::Recording:
+            case TraceCategory::GPUWork:
+                break;
+            default:
+                UNREACHABLE();
+        }
+        return &gTraceCategories[static_cast<uint32_t>(category)].enabled;
+    }
+
+    double ChromeTracingPlatform::MonotonicallyIncreasingTime() {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - mTimeOrigin;
+        return elapsed.count();
+    }
+
+    uint64_t ChromeTracingPlatform::AddTraceEvent(char phase,
+                                                  const unsigned char* categoryGroupEnabled,
+                                                  const char* name,
+                                                  uint64_t id,
+                                                  double timestamp,
+                                                  int numArgs,
+                                                  const char** argNames,
+                                                  const unsigned char* argTypes,
+                                                  const uint64_t* argValues,
+                                                  unsigned char flags) {
+        // Discover the category based on categoryGroupEnabled. This flag comes from the
+        // first parameter of TraceCategoryInfo, and corresponds to one of the entries in
+        // gTraceCategories.
+        static_assert(offsetof(TraceCategoryInfo, enabled) == 0,
+                      "|enabled| must be the first field of the TraceCategoryInfo class.");
+        const TraceCategoryInfo* info =
+            reinterpret_cast<const TraceCategoryInfo*>(categoryGroupEnabled);
+
+        TraceEvent event;
+        event.phase = phase;
+        event.category = info->category;
+        event.name = name;
+        event.id = id;
+        event.timestamp = timestamp;
+        {
+            std::ostringstream stream;
+            stream << std::this_thread::get_id();
+            event.threadId = stream.str();
+        }
+        for (int i = 0; i < numArgs; ++i) {
+            TraceEventArg arg;
+            arg.name = argNames[i];
+            arg.type = argTypes[i];
+            arg.value = argValues[i];
+            // String arguments are copied immediately; their pointers are not guaranteed
+            // to outlive the call.
+            if (arg.type == TRACE_VALUE_TYPE_STRING || arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
+                arg.stringValue = reinterpret_cast<const char*>(static_cast<uintptr_t>(arg.value));
+            }
+            event.args.push_back(std::move(arg));
+        }
+
+        std::lock_guard<std::mutex> guard(mMutex);
+        mEvents.push_back(std::move(event));
+        return mEvents.size();
+    }
+
+    void ChromeTracingPlatform::WriteTraceFile(std::ostream& out) {
+        std::lock_guard<std::mutex> guard(mMutex);
+
+        out << "{\"traceEvents\":[";
+        bool first = true;
+        for (const TraceEvent& event : mEvents) {
+            if (!first) {
+                out << ",";
+            }
+            first = false;
+
+            uint64_t microseconds = static_cast<uint64_t>(event.timestamp * 1000.0 * 1000.0);
+
+            out << "{ "
+                << "\"name\": \"" << event.name << "\", "
+                << "\"cat\": \"" << TraceCategoryName(event.category) << "\", "
+                << "\"ph\": \"" << event.phase << "\", "
+                << "\"id\": " << event.id << ", ";
+
+            // GPU work shares the timeline but gets its own track, so command buffer
+            // execution can be read against the submits that produced it.
+            if (event.category == TraceCategory::GPUWork) {
+                out << "\"tid\": \"GPU\", ";
+            } else {
+                out << "\"tid\": " << event.threadId << ", ";
+            }
+
+            out << "\"ts\": " << microseconds << ", "
+                << "\"pid\": \"Dawn\"";
+
+            if (!event.args.empty()) {
+                out << ", \"args\": { ";
+                for (size_t i = 0; i < event.args.size(); ++i) {
+                    const TraceEventArg& arg = event.args[i];
+                    if (i != 0) {
+                        out << ", ";
+                    }
+                    out << "\"" << arg.name << "\": ";
+                    switch (arg.type) {
+                        case TRACE_VALUE_TYPE_BOOL:
+                            out << (arg.value != 0 ? "true" : "false");
+                            break;
+                        case TRACE_VALUE_TYPE_INT:
+                            out << static_cast<int64_t>(arg.value);
+                            break;
+                        case TRACE_VALUE_TYPE_DOUBLE: {
+                            double value;
+                            memcpy(&value, &arg.value, sizeof(value));
+                            out << value;
+                            break;
+                        }
+                        case TRACE_VALUE_TYPE_STRING:
+                        case TRACE_VALUE_TYPE_COPY_STRING:
+                            out << "\"" << arg.stringValue << "\"";
+                            break;
+                        default:
+                            out << arg.value;
+                            break;
+                    }
+                }
+                out << " }";
+            }
+
+            out << " }";
+        }
+        out << "]}";
+
+        mEvents.clear();
+    }
+
+}}  // namespace dawn_platform::tracing
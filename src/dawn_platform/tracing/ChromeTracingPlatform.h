@@ -0,0 +1,86 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNPLATFORM_TRACING_CHROMETRACINGPLATFORM_H_
+#define DAWNPLATFORM_TRACING_CHROMETRACINGPLATFORM_H_
+
+#include "dawn_platform/DawnPlatform.h"
+
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace dawn_platform { namespace tracing {
+
+    // A ready-made trace event sink for embedders: it records the events Dawn emits
+    // through the Platform interface and writes them out in Chrome's "Trace Event
+    // Format", so the result can be loaded directly into chrome://tracing or Perfetto.
+    // See https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+    // CPU events keep their originating thread; GPUWork events are placed on a dedicated
+    // "GPU" track so command buffer execution lines up against the submits that produced
+    // it.
+    class DAWN_NATIVE_EXPORT ChromeTracingPlatform : public Platform {
+      public:
+        ChromeTracingPlatform();
+        ~ChromeTracingPlatform() override;
+
+        const unsigned char* GetTraceCategoryEnabledFlag(TraceCategory category) override;
+
+        double MonotonicallyIncreasingTime() override;
+
+        uint64_t AddTraceEvent(char phase,
+                               const unsigned char* categoryGroupEnabled,
+                               const char* name,
+                               uint64_t id,
+                               double timestamp,
+                               int numArgs,
+                               const char** argNames,
+                               const unsigned char* argTypes,
+                               const uint64_t* argValues,
+                               unsigned char flags) override;
+
+        // Writes all recorded events as a complete JSON document and clears the buffer.
+        // Should only be called while Dawn is idle; there must be no other thread
+        // inserting trace events.
+        void WriteTraceFile(std::ostream& out);
+
+      private:
+        struct TraceEventArg {
+            const char* name;
+            unsigned char type;
+            uint64_t value;
+            std::string stringValue;
+        };
+
+        struct TraceEvent {
+            char phase;
+            TraceCategory category;
+            const char* name;
+            uint64_t id;
+            std::string threadId;
+            double timestamp;
+            std::vector<TraceEventArg> args;
+        };
+
+        std::chrono::steady_clock::time_point mTimeOrigin;
+
+        std::mutex mMutex;
+        std::vector<TraceEvent> mEvents;
+    };
+
+}}  // namespace dawn_platform::tracing
+
+#endif  // DAWNPLATFORM_TRACING_CHROMETRACINGPLATFORM_H_
@@ -0,0 +1,34 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNWIRE_SHAREDMEMORYTRANSFERSERVICE_H_
+#define DAWNWIRE_SHAREDMEMORYTRANSFERSERVICE_H_
+
+#include <cstdint>
+
+namespace dawn_wire {
+
+    // Wire format of client::MemoryTransferService::Read/WriteHandle::SerializeCreate for the
+    // shared memory transfer services. The client creates a named shared memory region per
+    // handle and sends its name so the server can map the same physical pages.
+    struct SharedMemoryCreateInfo {
+        uint64_t size;
+        // NUL-terminated shm_open name. POSIX only guarantees portability of names up to
+        // NAME_MAX; the generated names stay well below this.
+        char name[64];
+    };
+
+}  // namespace dawn_wire
+
+#endif  // DAWNWIRE_SHAREDMEMORYTRANSFERSERVICE_H_
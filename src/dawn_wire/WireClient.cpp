@@ -18,7 +18,10 @@
 namespace dawn_wire {
 
     WireClient::WireClient(const WireClientDescriptor& descriptor)
-        : mImpl(new client::Client(descriptor.serializer, descriptor.memoryTransferService)) {
+        : mImpl(new client::Client(descriptor.serializer,
+                                   descriptor.memoryTransferService,
+                                   descriptor.flushPolicy,
+                                   descriptor.reservedObjectCapacity)) {
     }
 
     WireClient::~WireClient() {
@@ -42,6 +45,24 @@ namespace dawn_wire {
         return mImpl->ReserveTexture(device);
     }
 
+    void WireClient::CreateBindGroups(WGPUDevice device,
+                                      uint32_t count,
+                                      const WGPUBindGroupDescriptor* descriptors,
+                                      WGPUBindGroup* bindGroups) {
+        mImpl->CreateBindGroups(device, count, descriptors, bindGroups);
+    }
+
+    void WireClient::CreateRenderPipelines(WGPUDevice device,
+                                           uint32_t count,
+                                           const WGPURenderPipelineDescriptor* descriptors,
+                                           WGPURenderPipeline* renderPipelines) {
+        mImpl->CreateRenderPipelines(device, count, descriptors, renderPipelines);
+    }
+
+    bool WireClient::Flush() {
+        return mImpl->Flush();
+    }
+
     void WireClient::Disconnect() {
         mImpl->Disconnect();
     }
@@ -0,0 +1,216 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_wire/WireCompression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace dawn_wire {
+
+    namespace {
+
+        // Each flushed batch becomes one frame: a header carrying the byte counts
+        // followed by the payload. A frame whose compressed size equals its
+        // uncompressed size carries the batch verbatim.
+        struct FrameHeader {
+            uint64_t uncompressedSize;
+            uint64_t compressedSize;
+        };
+
+        // Token bytes: values below 0x80 are followed by (token + 1) literal bytes,
+        // values from 0x80 up repeat the byte that follows (token - 0x80 +
+        // kMinRunLength) times. Runs shorter than kMinRunLength cost more as a token
+        // than as literals so they stay in the literal stream.
+        constexpr size_t kMaxLiteralLength = 128;
+        constexpr size_t kMinRunLength = 4;
+        constexpr size_t kMaxRunLength = 0x7F + kMinRunLength;
+
+        void Compress(const uint8_t* data, size_t size, std::vector<uint8_t>* out) {
+            size_t literalStart = 0;
+
+            auto FlushLiterals = [&](size_t end) {
+                while (literalStart < end) {
+                    size_t count = std::min(end - literalStart, kMaxLiteralLength);
+                    out->push_back(static_cast<uint8_t>(count - 1));
+                    out->insert(out->end(), data + literalStart, data + literalStart + count);
+                    literalStart += count;
+                }
+            };
+
+            size_t i = 0;
+            while (i < size) {
+                size_t runEnd = i + 1;
+                while (runEnd < size && data[runEnd] == data[i] && runEnd - i < kMaxRunLength) {
+                    runEnd++;
+                }
+
+                size_t runLength = runEnd - i;
+                if (runLength >= kMinRunLength) {
+                    FlushLiterals(i);
+                    out->push_back(static_cast<uint8_t>(0x80 | (runLength - kMinRunLength)));
+                    out->push_back(data[i]);
+                    literalStart = runEnd;
+                }
+                i = runEnd;
+            }
+            FlushLiterals(size);
+        }
+
+        bool Decompress(const uint8_t* data, size_t size, uint8_t* out, size_t outSize) {
+            size_t i = 0;
+            size_t o = 0;
+            while (i < size) {
+                uint8_t token = data[i++];
+                if (token < 0x80) {
+                    size_t count = static_cast<size_t>(token) + 1;
+                    if (count > size - i || count > outSize - o) {
+                        return false;
+                    }
+                    memcpy(out + o, data + i, count);
+                    i += count;
+                    o += count;
+                } else {
+                    size_t count = static_cast<size_t>(token & 0x7F) + kMinRunLength;
+                    if (i >= size || count > outSize - o) {
+                        return false;
+                    }
+                    memset(out + o, data[i], count);
+                    i++;
+                    o += count;
+                }
+            }
+            return o == outSize;
+        }
+
+        class CompressingSerializer final : public CommandSerializer {
+          public:
+            explicit CompressingSerializer(CommandSerializer* serializer)
+                : mSerializer(serializer) {
+            }
+
+            void* GetCmdSpace(size_t size) override {
+                // Commands are written into the returned space before the next
+                // GetCmdSpace call, so growing the buffer can't invalidate bytes that
+                // are still being produced.
+                size_t offset = mBuffer.size();
+                mBuffer.resize(offset + size);
+                return mBuffer.data() + offset;
+            }
+
+            bool Flush() override {
+                if (!mBuffer.empty()) {
+                    mScratch.clear();
+                    Compress(mBuffer.data(), mBuffer.size(), &mScratch);
+
+                    const uint8_t* payload = mScratch.data();
+                    size_t payloadSize = mScratch.size();
+                    if (payloadSize >= mBuffer.size()) {
+                        payload = mBuffer.data();
+                        payloadSize = mBuffer.size();
+                    }
+
+                    FrameHeader header;
+                    header.uncompressedSize = mBuffer.size();
+                    header.compressedSize = payloadSize;
+
+                    char* frame = static_cast<char*>(
+                        mSerializer->GetCmdSpace(sizeof(FrameHeader) + payloadSize));
+                    if (frame == nullptr) {
+                        return false;
+                    }
+                    memcpy(frame, &header, sizeof(FrameHeader));
+                    memcpy(frame + sizeof(FrameHeader), payload, payloadSize);
+
+                    mBuffer.clear();
+                }
+                return mSerializer->Flush();
+            }
+
+          private:
+            CommandSerializer* mSerializer;
+            std::vector<uint8_t> mBuffer;
+            std::vector<uint8_t> mScratch;
+        };
+
+        class DecompressingHandler final : public CommandHandler {
+          public:
+            explicit DecompressingHandler(CommandHandler* handler) : mHandler(handler) {
+            }
+
+            const volatile char* HandleCommands(const volatile char* commands,
+                                                size_t size) override {
+                // A stream transport may deliver partial frames, so bytes accumulate in
+                // mPending until a full frame is available. The volatile data is copied
+                // out before being parsed, like the wire does for commands.
+                size_t offset = mPending.size();
+                mPending.resize(offset + size);
+                for (size_t i = 0; i < size; ++i) {
+                    mPending[offset + i] = static_cast<uint8_t>(commands[i]);
+                }
+
+                size_t consumed = 0;
+                while (mPending.size() - consumed >= sizeof(FrameHeader)) {
+                    FrameHeader header;
+                    memcpy(&header, mPending.data() + consumed, sizeof(FrameHeader));
+                    if (header.compressedSize > header.uncompressedSize) {
+                        return nullptr;
+                    }
+                    size_t compressedSize = static_cast<size_t>(header.compressedSize);
+                    size_t uncompressedSize = static_cast<size_t>(header.uncompressedSize);
+                    if (mPending.size() - consumed - sizeof(FrameHeader) < compressedSize) {
+                        break;
+                    }
+
+                    const uint8_t* payload = mPending.data() + consumed + sizeof(FrameHeader);
+                    const char* commandData = nullptr;
+                    if (compressedSize == uncompressedSize) {
+                        commandData = reinterpret_cast<const char*>(payload);
+                    } else {
+                        mScratch.resize(uncompressedSize);
+                        if (!Decompress(payload, compressedSize, mScratch.data(),
+                                        uncompressedSize)) {
+                            return nullptr;
+                        }
+                        commandData = reinterpret_cast<const char*>(mScratch.data());
+                    }
+
+                    if (mHandler->HandleCommands(commandData, uncompressedSize) == nullptr) {
+                        return nullptr;
+                    }
+                    consumed += sizeof(FrameHeader) + compressedSize;
+                }
+                mPending.erase(mPending.begin(), mPending.begin() + consumed);
+
+                return commands + size;
+            }
+
+          private:
+            CommandHandler* mHandler;
+            std::vector<uint8_t> mPending;
+            std::vector<uint8_t> mScratch;
+        };
+
+    }  // anonymous namespace
+
+    std::unique_ptr<CommandSerializer> CreateCompressingSerializer(CommandSerializer* serializer) {
+        return std::make_unique<CompressingSerializer>(serializer);
+    }
+
+    std::unique_ptr<CommandHandler> CreateDecompressingHandler(CommandHandler* handler) {
+        return std::make_unique<DecompressingHandler>(handler);
+    }
+
+}  // namespace dawn_wire
@@ -22,7 +22,14 @@ namespace dawn_wire {
     }
 
     WireDeserializeAllocator::~WireDeserializeAllocator() {
-        Reset();
+        for (const auto& allocation : mAllocations) {
+            free(allocation.first);
+        }
+        for (const auto& pool : mPools) {
+            for (char* block : pool) {
+                free(block);
+            }
+        }
     }
 
     void* WireDeserializeAllocator::GetSpace(size_t size) {
@@ -31,25 +38,51 @@ namespace dawn_wire {
             char* buffer = mCurrentBuffer;
             mCurrentBuffer += size;
             mRemainingSize -= size;
+            mBytesUsed += size;
             return buffer;
         }
 
-        // Otherwise allocate a new buffer and try again.
-        size_t allocationSize = std::max(size, size_t(2048));
-        char* allocation = static_cast<char*>(malloc(allocationSize));
-        if (allocation == nullptr) {
+        // Otherwise take a block of the right size class, reusing a retained one when
+        // the pool has it.
+        size_t sizeClass = 0;
+        while ((size_t(1) << (kMinBlockSizeShift + sizeClass)) < size) {
+            sizeClass++;
+        }
+        if (sizeClass >= kSizeClassCount) {
             return nullptr;
         }
+        size_t blockSize = size_t(1) << (kMinBlockSizeShift + sizeClass);
 
-        mAllocations.push_back(allocation);
-        mCurrentBuffer = allocation;
-        mRemainingSize = allocationSize;
+        char* block = nullptr;
+        if (!mPools[sizeClass].empty()) {
+            block = mPools[sizeClass].back();
+            mPools[sizeClass].pop_back();
+            mStats.retainedBlocks--;
+            mStats.retainedBytes -= blockSize;
+        } else {
+            block = static_cast<char*>(malloc(blockSize));
+            if (block == nullptr) {
+                return nullptr;
+            }
+            mStats.totalBlockAllocations++;
+        }
+
+        mAllocations.push_back(std::make_pair(block, sizeClass));
+        mCurrentBuffer = block;
+        mRemainingSize = blockSize;
         return GetSpace(size);
     }
 
     void WireDeserializeAllocator::Reset() {
-        for (auto allocation : mAllocations) {
-            free(allocation);
+        mStats.peakBytesUsed = std::max(mStats.peakBytesUsed, mBytesUsed);
+        mBytesUsed = 0;
+
+        // Retain the blocks instead of freeing them: the pools grow to the high-water
+        // mark of a batch and then every later batch is serviced without malloc.
+        for (const auto& allocation : mAllocations) {
+            mPools[allocation.second].push_back(allocation.first);
+            mStats.retainedBlocks++;
+            mStats.retainedBytes += size_t(1) << (kMinBlockSizeShift + allocation.second);
         }
         mAllocations.clear();
 
@@ -57,4 +90,8 @@ namespace dawn_wire {
         mCurrentBuffer = mStaticBuffer;
         mRemainingSize = sizeof(mStaticBuffer);
     }
+
+    const WireDeserializeAllocator::Stats& WireDeserializeAllocator::GetStats() const {
+        return mStats;
+    }
 }  // namespace dawn_wire
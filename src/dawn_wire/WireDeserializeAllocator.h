@@ -17,14 +17,30 @@
 
 #include "dawn_wire/WireCmd_autogen.h"
 
+#include <array>
+#include <utility>
 #include <vector>
 
 namespace dawn_wire {
     // A really really simple implementation of the DeserializeAllocator. It's main feature
     // is that it has some inline storage so as to avoid allocations for the majority of
-    // commands.
+    // commands. Overflow blocks are retained across Reset in power-of-two size-class
+    // pools, so under sustained load the allocator reaches its high-water mark once and
+    // then stops going to malloc.
     class WireDeserializeAllocator : public DeserializeAllocator {
       public:
+        // Counters for capacity planning.
+        struct Stats {
+            // Bytes and blocks currently retained in the size-class pools.
+            size_t retainedBytes = 0;
+            size_t retainedBlocks = 0;
+            // Peak bytes handed out for a single command batch.
+            size_t peakBytesUsed = 0;
+            // Blocks requested from malloc since construction. Stops growing once the
+            // pools cover the working set.
+            size_t totalBlockAllocations = 0;
+        };
+
         WireDeserializeAllocator();
         virtual ~WireDeserializeAllocator();
 
@@ -32,11 +48,23 @@ namespace dawn_wire {
 
         void Reset();
 
+        const Stats& GetStats() const;
+
       private:
+        // Block sizes are segregated in power-of-two classes, from the inline buffer size
+        // up to 1GiB.
+        static constexpr size_t kMinBlockSizeShift = 11;
+        static constexpr size_t kSizeClassCount = 20;
+
         size_t mRemainingSize = 0;
         char* mCurrentBuffer = nullptr;
+        size_t mBytesUsed = 0;
         char mStaticBuffer[2048];
-        std::vector<char*> mAllocations;
+        // In-use overflow blocks with their size class.
+        std::vector<std::pair<char*, size_t>> mAllocations;
+        // Retained blocks, indexed by size class.
+        std::array<std::vector<char*>, kSizeClassCount> mPools;
+        Stats mStats;
     };
 }  // namespace dawn_wire
 
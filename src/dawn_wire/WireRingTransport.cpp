@@ -0,0 +1,226 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_wire/WireRingTransport.h"
+
+#include "common/Assert.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace dawn_wire {
+
+    namespace {
+
+        // Each batch occupies one frame in the ring: a length prefix followed by the
+        // payload, wrapping byte-wise around the end of the storage.
+        using FrameLength = uint32_t;
+
+        size_t RoundUpToPowerOfTwo(size_t value) {
+            size_t result = 1;
+            while (result < value) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        class RingTransportImpl final : public RingTransport {
+          public:
+            RingTransportImpl(size_t capacity, RingWaitMode waitMode)
+                : mStorage(RoundUpToPowerOfTwo(capacity)), mWaitMode(waitMode) {
+            }
+
+            ~RingTransportImpl() override {
+                Close();
+            }
+
+            CommandSerializer* GetSerializer() override {
+                return &mSerializer;
+            }
+
+            bool Forward(CommandHandler* handler) override {
+                size_t read = mRead.load(std::memory_order_relaxed);
+                if (!WaitForData(read)) {
+                    return false;
+                }
+
+                FrameLength length;
+                ReadBytes(read, &length, sizeof(FrameLength));
+                mScratch.resize(length);
+                ReadBytes(read + sizeof(FrameLength), mScratch.data(), length);
+
+                // Publish the consumed space before running the handler so the producer
+                // can refill while the batch executes.
+                mRead.store(read + sizeof(FrameLength) + length, std::memory_order_release);
+                if (mWaitMode == RingWaitMode::WaitNotify) {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mSpaceAvailable.notify_one();
+                }
+
+                return handler->HandleCommands(mScratch.data(), length) != nullptr;
+            }
+
+            void Close() override {
+                mClosed.store(true, std::memory_order_release);
+                if (mWaitMode == RingWaitMode::WaitNotify) {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mDataAvailable.notify_all();
+                    mSpaceAvailable.notify_all();
+                }
+            }
+
+          private:
+            // Buffers commands locally and publishes one frame per Flush.
+            class RingSerializer final : public CommandSerializer {
+              public:
+                explicit RingSerializer(RingTransportImpl* transport) : mTransport(transport) {
+                }
+
+                void* GetCmdSpace(size_t size) override {
+                    // Each command is fully written before the next GetCmdSpace call, so
+                    // growing the staging buffer never invalidates bytes in flight.
+                    size_t offset = mStaging.size();
+                    mStaging.resize(offset + size);
+                    return mStaging.data() + offset;
+                }
+
+                bool Flush() override {
+                    bool success = true;
+                    if (!mStaging.empty()) {
+                        success = mTransport->Publish(mStaging.data(), mStaging.size());
+                        mStaging.clear();
+                    }
+                    return success;
+                }
+
+              private:
+                RingTransportImpl* mTransport;
+                std::vector<char> mStaging;
+            };
+
+            bool Publish(const char* data, size_t size) {
+                size_t frameSize = sizeof(FrameLength) + size;
+                if (size > std::numeric_limits<FrameLength>::max() ||
+                    frameSize > mStorage.size()) {
+                    return false;
+                }
+
+                size_t write = mWrite.load(std::memory_order_relaxed);
+                if (!WaitForSpace(write, frameSize)) {
+                    return false;
+                }
+
+                FrameLength length = static_cast<FrameLength>(size);
+                WriteBytes(write, &length, sizeof(FrameLength));
+                WriteBytes(write + sizeof(FrameLength), data, size);
+
+                mWrite.store(write + frameSize, std::memory_order_release);
+                if (mWaitMode == RingWaitMode::WaitNotify) {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mDataAvailable.notify_one();
+                }
+                return true;
+            }
+
+            // Waits until the ring holds at least a frame header past |read|.
+            bool WaitForData(size_t read) {
+                auto HasData = [&] {
+                    return mWrite.load(std::memory_order_acquire) != read;
+                };
+                auto IsClosed = [&] { return mClosed.load(std::memory_order_acquire); };
+
+                if (mWaitMode == RingWaitMode::BusyPoll) {
+                    while (!HasData()) {
+                        if (IsClosed() && !HasData()) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                std::unique_lock<std::mutex> lock(mMutex);
+                mDataAvailable.wait(lock, [&] { return HasData() || IsClosed(); });
+                return HasData();
+            }
+
+            // Waits until |frameSize| bytes are free past |write|.
+            bool WaitForSpace(size_t write, size_t frameSize) {
+                auto HasSpace = [&] {
+                    return mStorage.size() - (write - mRead.load(std::memory_order_acquire)) >=
+                           frameSize;
+                };
+                auto IsClosed = [&] { return mClosed.load(std::memory_order_acquire); };
+
+                if (mWaitMode == RingWaitMode::BusyPoll) {
+                    while (!HasSpace()) {
+                        if (IsClosed()) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                std::unique_lock<std::mutex> lock(mMutex);
+                mSpaceAvailable.wait(lock, [&] { return HasSpace() || IsClosed(); });
+                return HasSpace();
+            }
+
+            // |position| counts bytes monotonically; the ring offset is its low bits.
+            void WriteBytes(size_t position, const void* data, size_t size) {
+                size_t offset = position & (mStorage.size() - 1);
+                size_t contiguous = std::min(size, mStorage.size() - offset);
+                memcpy(mStorage.data() + offset, data, contiguous);
+                memcpy(mStorage.data(), static_cast<const char*>(data) + contiguous,
+                       size - contiguous);
+            }
+
+            void ReadBytes(size_t position, void* data, size_t size) {
+                size_t offset = position & (mStorage.size() - 1);
+                size_t contiguous = std::min(size, mStorage.size() - offset);
+                memcpy(data, mStorage.data() + offset, contiguous);
+                memcpy(static_cast<char*>(data) + contiguous, mStorage.data(),
+                       size - contiguous);
+            }
+
+            std::vector<char> mStorage;
+            RingWaitMode mWaitMode;
+            RingSerializer mSerializer{this};
+
+            // Monotonically increasing byte positions; only the producer writes mWrite and
+            // only the consumer writes mRead.
+            std::atomic<size_t> mWrite{0};
+            std::atomic<size_t> mRead{0};
+            std::atomic<bool> mClosed{false};
+
+            std::mutex mMutex;
+            std::condition_variable mDataAvailable;
+            std::condition_variable mSpaceAvailable;
+
+            std::vector<char> mScratch;
+        };
+
+    }  // anonymous namespace
+
+    RingTransport::~RingTransport() = default;
+
+    std::unique_ptr<RingTransport> CreateRingTransport(size_t capacity, RingWaitMode waitMode) {
+        return std::make_unique<RingTransportImpl>(capacity, waitMode);
+    }
+
+}  // namespace dawn_wire
@@ -130,6 +130,50 @@ namespace dawn_wire { namespace client {
         return reinterpret_cast<WGPUBuffer>(buffer);
     }
 
+    uint64_t ClientHandwrittenBufferGetSize(WGPUBuffer cSelf) {
+        auto buffer = reinterpret_cast<Buffer*>(cSelf);
+        return buffer->size;
+    }
+
+    WGPUTexture ClientHandwrittenDeviceCreateTexture(WGPUDevice cDevice,
+                                                     const WGPUTextureDescriptor* descriptor) {
+        Device* device = reinterpret_cast<Device*>(cDevice);
+        Client* wireClient = device->GetClient();
+
+        auto* textureObjectAndSerial = wireClient->TextureAllocator().New(device);
+        Texture* texture = textureObjectAndSerial->object.get();
+        // Mirror the dimensions so the getter methods are answered client-side.
+        texture->width = descriptor->size.width;
+        texture->height = descriptor->size.height;
+        texture->depth = descriptor->size.depth;
+
+        DeviceCreateTextureCmd cmd;
+        cmd.self = cDevice;
+        cmd.descriptor = descriptor;
+        cmd.result = ObjectHandle{texture->id, textureObjectAndSerial->generation};
+
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(wireClient->GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer, *wireClient);
+
+        return reinterpret_cast<WGPUTexture>(texture);
+    }
+
+    uint32_t ClientHandwrittenTextureGetWidth(WGPUTexture cSelf) {
+        auto texture = reinterpret_cast<Texture*>(cSelf);
+        return texture->width;
+    }
+
+    uint32_t ClientHandwrittenTextureGetHeight(WGPUTexture cSelf) {
+        auto texture = reinterpret_cast<Texture*>(cSelf);
+        return texture->height;
+    }
+
+    uint32_t ClientHandwrittenTextureGetDepth(WGPUTexture cSelf) {
+        auto texture = reinterpret_cast<Texture*>(cSelf);
+        return texture->depth;
+    }
+
     WGPUCreateBufferMappedResult ClientHandwrittenDeviceCreateBufferMapped(
         WGPUDevice cDevice,
         const WGPUBufferDescriptor* descriptor) {
@@ -366,6 +410,73 @@ namespace dawn_wire { namespace client {
         cmd.Serialize(allocatedBuffer, *fence->device->GetClient());
     }
 
+    void ClientHandwrittenQueueSubmit(WGPUQueue cQueue,
+                                      uint32_t commandCount,
+                                      WGPUCommandBuffer const* commands) {
+        Queue* queue = reinterpret_cast<Queue*>(cQueue);
+        Client* wireClient = queue->device->GetClient();
+
+        QueueSubmitCmd cmd;
+        cmd.self = cQueue;
+        cmd.commandCount = commandCount;
+        cmd.commands = commands;
+
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(wireClient->GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer, *wireClient);
+
+        // A submit ends a batch of work, so it is a natural point for the flush policy to
+        // send the buffered commands.
+        wireClient->OnQueueSubmitRecorded();
+    }
+
+    void ClientHandwrittenQueueWriteBuffer(WGPUQueue cQueue,
+                                           WGPUBuffer cBuffer,
+                                           uint64_t bufferOffset,
+                                           const void* data,
+                                           uint64_t size) {
+        Queue* queue = reinterpret_cast<Queue*>(cQueue);
+        Buffer* buffer = reinterpret_cast<Buffer*>(cBuffer);
+
+        QueueWriteBufferInternalCmd cmd;
+        cmd.queueId = queue->id;
+        cmd.bufferId = buffer->id;
+        cmd.bufferOffset = bufferOffset;
+        cmd.size = size;
+        cmd.data = static_cast<const uint8_t*>(data);
+
+        Client* wireClient = queue->device->GetClient();
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(wireClient->GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer);
+    }
+
+    void ClientHandwrittenQueueWriteTexture(WGPUQueue cQueue,
+                                            const WGPUTextureCopyView* destination,
+                                            const void* data,
+                                            uint64_t dataSize,
+                                            const WGPUTextureDataLayout* dataLayout,
+                                            const WGPUExtent3D* writeSize) {
+        Queue* queue = reinterpret_cast<Queue*>(cQueue);
+        Texture* texture = reinterpret_cast<Texture*>(destination->texture);
+
+        QueueWriteTextureInternalCmd cmd;
+        cmd.queueId = queue->id;
+        cmd.textureId = texture->id;
+        cmd.mipLevel = destination->mipLevel;
+        cmd.arrayLayer = destination->arrayLayer;
+        cmd.origin = &destination->origin;
+        cmd.dataSize = dataSize;
+        cmd.data = static_cast<const uint8_t*>(data);
+        cmd.dataLayout = dataLayout;
+        cmd.writeSize = writeSize;
+
+        Client* wireClient = queue->device->GetClient();
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(wireClient->GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer, *wireClient);
+    }
+
     void ClientDeviceReference(WGPUDevice) {
     }
 
@@ -377,6 +488,28 @@ namespace dawn_wire { namespace client {
         return device->GetDefaultQueue();
     }
 
+    void ClientHandwrittenDeviceCreateReadyRenderPipeline(
+        WGPUDevice cDevice,
+        const WGPURenderPipelineDescriptor* descriptor,
+        WGPUCreateReadyRenderPipelineCallback callback,
+        void* userdata) {
+        // The wire cannot be notified of the server-side compile finishing yet, so the
+        // pipeline is created through the regular command and the callback runs
+        // immediately. Compilation errors surface through the error scope mechanism like
+        // they do for the synchronous entry point.
+        WGPURenderPipeline pipeline = ClientDeviceCreateRenderPipeline(cDevice, descriptor);
+        callback(WGPUCreateReadyPipelineStatus_Success, pipeline, "", userdata);
+    }
+
+    void ClientHandwrittenDeviceCreateReadyRayTracingPipeline(
+        WGPUDevice cDevice,
+        const WGPURayTracingPipelineDescriptor* descriptor,
+        WGPUCreateReadyRayTracingPipelineCallback callback,
+        void* userdata) {
+        WGPURayTracingPipeline pipeline = ClientDeviceCreateRayTracingPipeline(cDevice, descriptor);
+        callback(WGPUCreateReadyPipelineStatus_Success, pipeline, "", userdata);
+    }
+
     void ClientHandwrittenDeviceSetUncapturedErrorCallback(WGPUDevice cSelf,
                                                            WGPUErrorCallback callback,
                                                            void* userdata) {
@@ -17,12 +17,21 @@
 #include "common/Compiler.h"
 #include "dawn_wire/client/Device.h"
 
+#include <vector>
+
 namespace dawn_wire { namespace client {
 
-    Client::Client(CommandSerializer* serializer, MemoryTransferService* memoryTransferService)
+    Client::Client(CommandSerializer* serializer,
+                   MemoryTransferService* memoryTransferService,
+                   const WireClientFlushPolicy& flushPolicy,
+                   size_t reservedObjectCapacity)
         : ClientBase(),
           mSerializer(serializer),
-          mMemoryTransferService(memoryTransferService) {
+          mMemoryTransferService(memoryTransferService),
+          mFlushPolicy(flushPolicy) {
+        if (reservedObjectCapacity > 0) {
+            ReserveAllObjects(reservedObjectCapacity);
+        }
         if (mMemoryTransferService == nullptr) {
             // If a MemoryTransferService is not provided, fall back to inline memory.
             mOwnedMemoryTransferService = CreateInlineMemoryTransferService();
@@ -31,6 +40,9 @@ namespace dawn_wire { namespace client {
     }
 
     Client::~Client() {
+        // Freeing the device serializes the destruction of its default queue, so flush the
+        // batched destructions first to keep the stream ordered.
+        SerializePendingDestroys();
         if (mDevice != nullptr) {
             DeviceAllocator().Free(mDevice);
         }
@@ -54,6 +66,57 @@ namespace dawn_wire { namespace client {
         return result;
     }
 
+    void Client::CreateBindGroups(WGPUDevice cDevice,
+                                  uint32_t count,
+                                  const WGPUBindGroupDescriptor* descriptors,
+                                  WGPUBindGroup* bindGroups) {
+        Device* device = reinterpret_cast<Device*>(cDevice);
+
+        // The IDs are allocated eagerly so the objects are usable as soon as this
+        // call returns; the server creates the backing objects when it handles the
+        // batched command.
+        std::vector<ObjectHandle> results(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            auto* allocation = BindGroupAllocator().New(device);
+            results[i] = ObjectHandle(allocation->object->id, allocation->generation);
+            bindGroups[i] = reinterpret_cast<WGPUBindGroup>(allocation->object.get());
+        }
+
+        DeviceCreateBindGroupsCmd cmd;
+        cmd.device = cDevice;
+        cmd.count = count;
+        cmd.descriptors = descriptors;
+        cmd.results = results.data();
+
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer, *this);
+    }
+
+    void Client::CreateRenderPipelines(WGPUDevice cDevice,
+                                       uint32_t count,
+                                       const WGPURenderPipelineDescriptor* descriptors,
+                                       WGPURenderPipeline* renderPipelines) {
+        Device* device = reinterpret_cast<Device*>(cDevice);
+
+        std::vector<ObjectHandle> results(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            auto* allocation = RenderPipelineAllocator().New(device);
+            results[i] = ObjectHandle(allocation->object->id, allocation->generation);
+            renderPipelines[i] = reinterpret_cast<WGPURenderPipeline>(allocation->object.get());
+        }
+
+        DeviceCreateRenderPipelinesCmd cmd;
+        cmd.device = cDevice;
+        cmd.count = count;
+        cmd.descriptors = descriptors;
+        cmd.results = results.data();
+
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer, *this);
+    }
+
     void* Client::GetCmdSpace(size_t size) {
         if (DAWN_UNLIKELY(mIsDisconnected)) {
             if (size > mDummyCmdSpace.size()) {
@@ -61,9 +124,75 @@ namespace dawn_wire { namespace client {
             }
             return mDummyCmdSpace.data();
         }
+
+        // Batched destructions must enter the stream before any other command: a freed
+        // object ID can be reused by a later creation and must not overtake its own
+        // destruction. The recursive GetCmdSpace call sees an empty pending list.
+        SerializePendingDestroys();
+
+        // Flush triggers run before allocating space for the new command: the caller only
+        // writes the command after this call returns, so flushing here always sends whole
+        // commands.
+        if (mPendingCommandBytes > 0) {
+            bool overSizeThreshold = mFlushPolicy.maxPendingCommandBytes != 0 &&
+                                     mPendingCommandBytes + size >
+                                         mFlushPolicy.maxPendingCommandBytes;
+            bool overTimeThreshold =
+                mFlushPolicy.maxPendingTimeMs != 0 &&
+                std::chrono::steady_clock::now() - mOldestPendingCommandTime >=
+                    std::chrono::milliseconds(mFlushPolicy.maxPendingTimeMs);
+            if (overSizeThreshold || overTimeThreshold) {
+                Flush();
+            }
+        }
+
+        if (mPendingCommandBytes == 0 && mFlushPolicy.maxPendingTimeMs != 0) {
+            mOldestPendingCommandTime = std::chrono::steady_clock::now();
+        }
+        mPendingCommandBytes += size;
+
         return mSerializer->GetCmdSpace(size);
     }
 
+    void Client::DestroyObject(ObjectType objectType, ObjectId objectId) {
+        mPendingDestroyTypes.push_back(objectType);
+        mPendingDestroyIds.push_back(objectId);
+    }
+
+    void Client::SerializePendingDestroys() {
+        if (mPendingDestroyTypes.empty()) {
+            return;
+        }
+
+        // Move the lists out before serializing so the GetCmdSpace call below doesn't
+        // recurse into another serialization of the same batch.
+        std::vector<ObjectType> objectTypes = std::move(mPendingDestroyTypes);
+        std::vector<ObjectId> objectIds = std::move(mPendingDestroyIds);
+        mPendingDestroyTypes.clear();
+        mPendingDestroyIds.clear();
+
+        DestroyObjectsCmd cmd;
+        cmd.count = static_cast<uint32_t>(objectIds.size());
+        cmd.objectTypes = objectTypes.data();
+        cmd.objectIds = objectIds.data();
+
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer);
+    }
+
+    bool Client::Flush() {
+        SerializePendingDestroys();
+        mPendingCommandBytes = 0;
+        return mSerializer->Flush();
+    }
+
+    void Client::OnQueueSubmitRecorded() {
+        if (mFlushPolicy.flushOnQueueSubmit && !mIsDisconnected) {
+            Flush();
+        }
+    }
+
     void Client::Disconnect() {
         if (mIsDisconnected) {
             return;
@@ -23,6 +23,9 @@
 #include "dawn_wire/WireDeserializeAllocator.h"
 #include "dawn_wire/client/ClientBase_autogen.h"
 
+#include <chrono>
+#include <vector>
+
 namespace dawn_wire { namespace client {
 
     class Device;
@@ -30,7 +33,10 @@ namespace dawn_wire { namespace client {
 
     class Client : public ClientBase {
       public:
-        Client(CommandSerializer* serializer, MemoryTransferService* memoryTransferService);
+        Client(CommandSerializer* serializer,
+               MemoryTransferService* memoryTransferService,
+               const WireClientFlushPolicy& flushPolicy,
+               size_t reservedObjectCapacity);
         ~Client();
 
         WGPUDevice GetDevice();
@@ -42,19 +48,51 @@ namespace dawn_wire { namespace client {
         const volatile char* HandleCommands(const volatile char* commands, size_t size);
         ReservedTexture ReserveTexture(WGPUDevice device);
 
+        void CreateBindGroups(WGPUDevice device,
+                              uint32_t count,
+                              const WGPUBindGroupDescriptor* descriptors,
+                              WGPUBindGroup* bindGroups);
+        void CreateRenderPipelines(WGPUDevice device,
+                                   uint32_t count,
+                                   const WGPURenderPipelineDescriptor* descriptors,
+                                   WGPURenderPipeline* renderPipelines);
+
         void* GetCmdSpace(size_t size);
 
+        // Queues the destruction of a server-side object. Destructions are batched into a
+        // single DestroyObjectsCmd that enters the stream before the next regular command
+        // (so a reused object ID cannot overtake its own destruction) or on Flush().
+        void DestroyObject(ObjectType objectType, ObjectId objectId);
+
+        // Flush buffered commands through the serializer and reset the flush policy
+        // accounting.
+        bool Flush();
+
+        // Called by the queue submit proc after the command is recorded so the flush
+        // policy can treat submits as a batch boundary.
+        void OnQueueSubmitRecorded();
+
         void Disconnect();
 
       private:
 #include "dawn_wire/client/ClientPrototypes_autogen.inc"
 
+        void SerializePendingDestroys();
+
         Device* mDevice = nullptr;
         CommandSerializer* mSerializer = nullptr;
         WireDeserializeAllocator mAllocator;
         MemoryTransferService* mMemoryTransferService = nullptr;
         std::unique_ptr<MemoryTransferService> mOwnedMemoryTransferService = nullptr;
 
+        // Parallel arrays so they can back DestroyObjectsCmd without repacking.
+        std::vector<ObjectType> mPendingDestroyTypes;
+        std::vector<ObjectId> mPendingDestroyIds;
+
+        WireClientFlushPolicy mFlushPolicy;
+        size_t mPendingCommandBytes = 0;
+        std::chrono::steady_clock::time_point mOldestPendingCommandTime;
+
         std::vector<char> mDummyCmdSpace;
         bool mIsDisconnected = false;
     };
@@ -0,0 +1,210 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/Assert.h"
+#include "common/Platform.h"
+#include "dawn_wire/WireClient.h"
+
+#if defined(DAWN_PLATFORM_POSIX)
+
+#    include "dawn_wire/SharedMemoryTransferService.h"
+
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <unistd.h>
+
+#    include <atomic>
+#    include <cstdio>
+#    include <cstring>
+#    include <utility>
+
+namespace dawn_wire { namespace client {
+
+    namespace {
+
+        std::atomic<uint32_t> sNextRegionId{0};
+
+        // Creates a fresh shared memory region and maps it. The region stays linked under
+        // |info->name| so the server can open it; see the ownership comment on
+        // SharedMemoryHandleState.
+        bool CreateRegion(size_t size, SharedMemoryCreateInfo* info, void** mapping) {
+            snprintf(info->name, sizeof(info->name), "/dawn_wire_%d_%u",
+                     static_cast<int>(getpid()), sNextRegionId.fetch_add(1u));
+            info->size = size;
+
+            int fd = shm_open(info->name, O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0) {
+                return false;
+            }
+
+            // mmap rejects zero-length mappings but zero-sized buffers may still be mapped.
+            size_t mappingSize = size > 0 ? size : 1;
+            if (ftruncate(fd, mappingSize) < 0) {
+                close(fd);
+                shm_unlink(info->name);
+                return false;
+            }
+
+            *mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (*mapping == MAP_FAILED) {
+                shm_unlink(info->name);
+                return false;
+            }
+            return true;
+        }
+
+    }  // anonymous namespace
+
+    class SharedMemoryTransferService : public MemoryTransferService {
+        // State common to both handle types. Ownership of the region name transfers to the
+        // server when the handle is serialized: the server unlinks the name right after
+        // opening it. The client only unlinks if the handle dies before SerializeCreate,
+        // which is the one case where the server will never see the name.
+        struct SharedMemoryHandleState {
+            SharedMemoryHandleState() = default;
+
+            SharedMemoryHandleState(SharedMemoryHandleState&& other)
+                : mInfo(other.mInfo), mMapping(other.mMapping), mSerialized(other.mSerialized) {
+                other.mMapping = nullptr;
+                // The moved-from state no longer owns the region name either.
+                other.mSerialized = true;
+            }
+
+            ~SharedMemoryHandleState() {
+                if (mMapping != nullptr) {
+                    munmap(mMapping, mInfo.size > 0 ? mInfo.size : 1);
+                }
+                if (!mSerialized) {
+                    shm_unlink(mInfo.name);
+                }
+            }
+
+            SharedMemoryCreateInfo mInfo = {};
+            void* mMapping = nullptr;
+            bool mSerialized = false;
+        };
+
+        class ReadHandleImpl : public ReadHandle {
+          public:
+            ReadHandleImpl(SharedMemoryHandleState state) : mState(std::move(state)) {
+            }
+
+            ~ReadHandleImpl() override = default;
+
+            size_t SerializeCreateSize() override {
+                return sizeof(SharedMemoryCreateInfo);
+            }
+
+            void SerializeCreate(void* serializePointer) override {
+                ASSERT(serializePointer != nullptr);
+                memcpy(serializePointer, &mState.mInfo, sizeof(SharedMemoryCreateInfo));
+                mState.mSerialized = true;
+            }
+
+            bool DeserializeInitialData(const void* deserializePointer,
+                                        size_t deserializeSize,
+                                        const void** data,
+                                        size_t* dataLength) override {
+                // The server writes the buffer contents directly into the shared region, so
+                // there is nothing to deserialize.
+                if (deserializeSize != 0) {
+                    return false;
+                }
+
+                ASSERT(data != nullptr);
+                ASSERT(dataLength != nullptr);
+                *data = mState.mMapping;
+                *dataLength = mState.mInfo.size;
+
+                return true;
+            }
+
+          private:
+            SharedMemoryHandleState mState;
+        };
+
+        class WriteHandleImpl : public WriteHandle {
+          public:
+            WriteHandleImpl(SharedMemoryHandleState state) : mState(std::move(state)) {
+            }
+
+            ~WriteHandleImpl() override = default;
+
+            size_t SerializeCreateSize() override {
+                return sizeof(SharedMemoryCreateInfo);
+            }
+
+            void SerializeCreate(void* serializePointer) override {
+                ASSERT(serializePointer != nullptr);
+                memcpy(serializePointer, &mState.mInfo, sizeof(SharedMemoryCreateInfo));
+                mState.mSerialized = true;
+            }
+
+            std::pair<void*, size_t> Open() override {
+                // Fresh shared memory regions are zero-filled by the kernel.
+                return std::make_pair(mState.mMapping, static_cast<size_t>(mState.mInfo.size));
+            }
+
+            size_t SerializeFlushSize() override {
+                // The data is already visible to the server through the shared mapping.
+                return 0;
+            }
+
+            void SerializeFlush(void*) override {
+            }
+
+          private:
+            SharedMemoryHandleState mState;
+        };
+
+      public:
+        SharedMemoryTransferService() {
+        }
+        ~SharedMemoryTransferService() override = default;
+
+        ReadHandle* CreateReadHandle(size_t size) override {
+            SharedMemoryHandleState state;
+            if (!CreateRegion(size, &state.mInfo, &state.mMapping)) {
+                return nullptr;
+            }
+            return new ReadHandleImpl(std::move(state));
+        }
+
+        WriteHandle* CreateWriteHandle(size_t size) override {
+            SharedMemoryHandleState state;
+            if (!CreateRegion(size, &state.mInfo, &state.mMapping)) {
+                return nullptr;
+            }
+            return new WriteHandleImpl(std::move(state));
+        }
+    };
+
+    std::unique_ptr<MemoryTransferService> CreateSharedMemoryTransferService() {
+        return std::make_unique<SharedMemoryTransferService>();
+    }
+
+}}  //  namespace dawn_wire::client
+
+#else  // defined(DAWN_PLATFORM_POSIX)
+
+namespace dawn_wire { namespace client {
+
+    std::unique_ptr<MemoryTransferService> CreateSharedMemoryTransferService() {
+        return nullptr;
+    }
+
+}}  //  namespace dawn_wire::client
+
+#endif  // defined(DAWN_PLATFORM_POSIX)
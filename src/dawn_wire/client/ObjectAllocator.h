@@ -46,6 +46,12 @@ namespace dawn_wire { namespace client {
             mObjects.emplace_back(nullptr, 0);
         }
 
+        // Pre-sizes the object table so that the first |capacity| IDs can be allocated
+        // without reallocating it.
+        void Reserve(size_t capacity) {
+            mObjects.reserve(capacity);
+        }
+
         ObjectAndSerial* New(ObjectOwner* owner) {
             uint32_t id = GetNewId();
             auto object = std::make_unique<T>(owner, 1, id);
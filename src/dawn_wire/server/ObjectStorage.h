@@ -20,6 +20,8 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
+#include <vector>
 
 namespace dawn_wire { namespace server {
 
@@ -31,7 +33,7 @@ namespace dawn_wire { namespace server {
 
         // Whether this object has been allocated, used by the KnownObjects queries
         // TODO(cwallez@chromium.org): make this an internal bit vector in KnownObjects.
-        bool allocated;
+        bool allocated = false;
     };
 
     // Stores what the backend knows about the type.
@@ -49,6 +51,8 @@ namespace dawn_wire { namespace server {
     };
 
     // Keeps track of the mapping between client IDs and backend objects.
+    // The table is stored in fixed-size chunks: IDs are dense so lookup stays O(1), and
+    // growing never moves existing entries or pauses on a large reallocation.
     template <typename T>
     class KnownObjects {
       public:
@@ -58,20 +62,24 @@ namespace dawn_wire { namespace server {
             // Reserve ID 0 so that it can be used to represent nullptr for optional object values
             // in the wire format. However don't tag it as allocated so that it is an error to ask
             // KnownObjects for ID 0.
-            Data reservation;
-            reservation.handle = nullptr;
-            reservation.allocated = false;
-            mKnown.push_back(std::move(reservation));
+            EnsureCapacity(1);
+            mSize = 1;
+        }
+
+        // Pre-sizes the table so that the first |capacity| IDs can be allocated without
+        // growing it.
+        void Reserve(size_t capacity) {
+            EnsureCapacity(capacity);
         }
 
         // Get a backend objects for a given client ID.
         // Returns nullptr if the ID hasn't previously been allocated.
         const Data* Get(uint32_t id) const {
-            if (id >= mKnown.size()) {
+            if (id >= mSize) {
                 return nullptr;
             }
 
-            const Data* data = &mKnown[id];
+            const Data* data = DataFor(id);
 
             if (!data->allocated) {
                 return nullptr;
@@ -80,11 +88,11 @@ namespace dawn_wire { namespace server {
             return data;
         }
         Data* Get(uint32_t id) {
-            if (id >= mKnown.size()) {
+            if (id >= mSize) {
                 return nullptr;
             }
 
-            Data* data = &mKnown[id];
+            Data* data = DataFor(id);
 
             if (!data->allocated) {
                 return nullptr;
@@ -95,42 +103,40 @@ namespace dawn_wire { namespace server {
 
         // Allocates the data for a given ID and returns it.
         // Returns nullptr if the ID is already allocated, or too far ahead, or if ID is 0 (ID 0 is
-        // reserved for nullptr). Invalidates all the Data*
+        // reserved for nullptr). The returned Data* stays valid as the table grows.
         Data* Allocate(uint32_t id) {
-            if (id == 0 || id > mKnown.size()) {
+            if (id == 0 || id > mSize) {
                 return nullptr;
             }
 
-            Data data;
-            data.allocated = true;
-            data.handle = nullptr;
-
-            if (id >= mKnown.size()) {
-                mKnown.push_back(std::move(data));
-                return &mKnown.back();
-            }
-
-            if (mKnown[id].allocated) {
+            if (id == mSize) {
+                EnsureCapacity(mSize + 1);
+                mSize++;
+            } else if (DataFor(id)->allocated) {
                 return nullptr;
             }
 
-            mKnown[id] = std::move(data);
-            return &mKnown[id];
+            Data* data = DataFor(id);
+            *data = Data();
+            data->allocated = true;
+            data->handle = nullptr;
+            return data;
         }
 
         // Marks an ID as deallocated
         void Free(uint32_t id) {
-            ASSERT(id < mKnown.size());
-            mKnown[id].allocated = false;
+            ASSERT(id < mSize);
+            DataFor(id)->allocated = false;
         }
 
         std::vector<T> AcquireAllHandles() {
             std::vector<T> objects;
-            for (Data& data : mKnown) {
-                if (data.allocated && data.handle != nullptr) {
-                    objects.push_back(data.handle);
-                    data.allocated = false;
-                    data.handle = nullptr;
+            for (uint32_t id = 0; id < mSize; ++id) {
+                Data* data = DataFor(id);
+                if (data->allocated && data->handle != nullptr) {
+                    objects.push_back(data->handle);
+                    data->allocated = false;
+                    data->handle = nullptr;
                 }
             }
 
@@ -138,7 +144,23 @@ namespace dawn_wire { namespace server {
         }
 
       private:
-        std::vector<Data> mKnown;
+        static constexpr size_t kChunkSize = 1024;
+
+        Data* DataFor(uint32_t id) {
+            return &mChunks[id / kChunkSize][id % kChunkSize];
+        }
+        const Data* DataFor(uint32_t id) const {
+            return &mChunks[id / kChunkSize][id % kChunkSize];
+        }
+
+        void EnsureCapacity(size_t capacity) {
+            while (mChunks.size() * kChunkSize < capacity) {
+                mChunks.push_back(std::unique_ptr<Data[]>(new Data[kChunkSize]));
+            }
+        }
+
+        std::vector<std::unique_ptr<Data[]>> mChunks;
+        size_t mSize = 0;
     };
 
     // ObjectIds are lost in deserialization. Store the ids of deserialized
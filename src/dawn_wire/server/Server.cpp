@@ -20,8 +20,12 @@ namespace dawn_wire { namespace server {
     Server::Server(WGPUDevice device,
                    const DawnProcTable& procs,
                    CommandSerializer* serializer,
-                   MemoryTransferService* memoryTransferService)
+                   MemoryTransferService* memoryTransferService,
+                   size_t reservedObjectCapacity)
         : mSerializer(serializer), mProcs(procs), mMemoryTransferService(memoryTransferService) {
+        if (reservedObjectCapacity > 0) {
+            ReserveAllObjects(reservedObjectCapacity);
+        }
         if (mMemoryTransferService == nullptr) {
             // If a MemoryTransferService is not provided, fallback to inline memory.
             mOwnedMemoryTransferService = CreateInlineMemoryTransferService();
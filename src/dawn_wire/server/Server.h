@@ -45,12 +45,21 @@ namespace dawn_wire { namespace server {
         uint64_t value;
     };
 
+    // A fence completion waiting to be sent back to the client. Completions are not
+    // serialized from the callback; they are piggybacked on the next return flush so
+    // the client wakes once per batch instead of once per signal.
+    struct DeferredFenceUpdate {
+        ObjectHandle fence;
+        uint64_t value;
+    };
+
     class Server : public ServerBase {
       public:
         Server(WGPUDevice device,
                const DawnProcTable& procs,
                CommandSerializer* serializer,
-               MemoryTransferService* memoryTransferService);
+               MemoryTransferService* memoryTransferService,
+               size_t reservedObjectCapacity);
         ~Server();
 
         const volatile char* HandleCommands(const volatile char* commands, size_t size);
@@ -91,10 +100,16 @@ namespace dawn_wire { namespace server {
         void OnFenceCompletedValueUpdated(WGPUFenceCompletionStatus status,
                                           FenceCompletionUserdata* userdata);
 
+        // Serializes all deferred fence completions. Called at the end of
+        // HandleCommands so the updates share a return flush with any map
+        // acknowledgements produced by the same batch.
+        void SerializeDeferredFenceUpdates();
+
 #include "dawn_wire/server/ServerPrototypes_autogen.inc"
 
         CommandSerializer* mSerializer = nullptr;
         WireDeserializeAllocator mAllocator;
+        std::vector<DeferredFenceUpdate> mDeferredFenceUpdates;
         DawnProcTable mProcs;
         std::unique_ptr<MemoryTransferService> mOwnedMemoryTransferService = nullptr;
         MemoryTransferService* mMemoryTransferService = nullptr;
@@ -45,6 +45,39 @@ namespace dawn_wire { namespace server {
         cmd.Serialize(allocatedBuffer);
     }
 
+    bool Server::DoDeviceCreateBindGroups(WGPUDevice device,
+                                          uint32_t count,
+                                          const WGPUBindGroupDescriptor* descriptors,
+                                          const ObjectHandle* results) {
+        // The whole batch was deserialized up front, so the creation loop runs back to
+        // back without interleaved command dispatch. It stays serial because the native
+        // procs are not thread-safe; this is the place to fan out once they are.
+        for (uint32_t i = 0; i < count; ++i) {
+            auto* data = BindGroupObjects().Allocate(results[i].id);
+            if (data == nullptr) {
+                return false;
+            }
+            data->generation = results[i].generation;
+            data->handle = mProcs.deviceCreateBindGroup(device, &descriptors[i]);
+        }
+        return true;
+    }
+
+    bool Server::DoDeviceCreateRenderPipelines(WGPUDevice device,
+                                               uint32_t count,
+                                               const WGPURenderPipelineDescriptor* descriptors,
+                                               const ObjectHandle* results) {
+        for (uint32_t i = 0; i < count; ++i) {
+            auto* data = RenderPipelineObjects().Allocate(results[i].id);
+            if (data == nullptr) {
+                return false;
+            }
+            data->generation = results[i].generation;
+            data->handle = mProcs.deviceCreateRenderPipeline(device, &descriptors[i]);
+        }
+        return true;
+    }
+
     bool Server::DoDevicePopErrorScope(WGPUDevice cDevice, uint64_t requestSerial) {
         ErrorScopeUserdata* userdata = new ErrorScopeUserdata;
         userdata->server = this;
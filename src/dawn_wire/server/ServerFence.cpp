@@ -31,13 +31,23 @@ namespace dawn_wire { namespace server {
             return;
         }
 
-        ReturnFenceUpdateCompletedValueCmd cmd;
-        cmd.fence = data->fence;
-        cmd.value = data->value;
+        // Don't serialize the update here: completions fire from deviceTick, which can
+        // signal several fences in a row. They are batched and sent at the end of
+        // HandleCommands so the client sees one wakeup for the whole batch.
+        mDeferredFenceUpdates.push_back({data->fence, data->value});
+    }
+
+    void Server::SerializeDeferredFenceUpdates() {
+        for (const DeferredFenceUpdate& update : mDeferredFenceUpdates) {
+            ReturnFenceUpdateCompletedValueCmd cmd;
+            cmd.fence = update.fence;
+            cmd.value = update.value;
 
-        size_t requiredSize = cmd.GetRequiredSize();
-        char* allocatedBuffer = static_cast<char*>(GetCmdSpace(requiredSize));
-        cmd.Serialize(allocatedBuffer);
+            size_t requiredSize = cmd.GetRequiredSize();
+            char* allocatedBuffer = static_cast<char*>(GetCmdSpace(requiredSize));
+            cmd.Serialize(allocatedBuffer);
+        }
+        mDeferredFenceUpdates.clear();
     }
 
 }}  // namespace dawn_wire::server
@@ -38,4 +38,55 @@ namespace dawn_wire { namespace server {
         return true;
     }
 
+    bool Server::DoQueueWriteBufferInternal(ObjectId queueId,
+                                            ObjectId bufferId,
+                                            uint64_t bufferOffset,
+                                            uint64_t size,
+                                            const uint8_t* data) {
+        // The null object isn't valid as `self` or `buffer`
+        if (queueId == 0 || bufferId == 0) {
+            return false;
+        }
+
+        auto* queue = QueueObjects().Get(queueId);
+        auto* buffer = BufferObjects().Get(bufferId);
+        if (queue == nullptr || buffer == nullptr) {
+            return false;
+        }
+
+        mProcs.queueWriteBuffer(queue->handle, buffer->handle, bufferOffset, data, size);
+        return true;
+    }
+
+    bool Server::DoQueueWriteTextureInternal(ObjectId queueId,
+                                             ObjectId textureId,
+                                             uint32_t mipLevel,
+                                             uint32_t arrayLayer,
+                                             const WGPUOrigin3D* origin,
+                                             uint64_t dataSize,
+                                             const uint8_t* data,
+                                             const WGPUTextureDataLayout* dataLayout,
+                                             const WGPUExtent3D* writeSize) {
+        // The null object isn't valid as `self` or `destination`
+        if (queueId == 0 || textureId == 0) {
+            return false;
+        }
+
+        auto* queue = QueueObjects().Get(queueId);
+        auto* texture = TextureObjects().Get(textureId);
+        if (queue == nullptr || texture == nullptr) {
+            return false;
+        }
+
+        WGPUTextureCopyView destination = {};
+        destination.texture = texture->handle;
+        destination.mipLevel = mipLevel;
+        destination.arrayLayer = arrayLayer;
+        destination.origin = *origin;
+
+        mProcs.queueWriteTexture(queue->handle, &destination, data, dataSize, dataLayout,
+                                 writeSize);
+        return true;
+    }
+
 }}  // namespace dawn_wire::server
@@ -0,0 +1,170 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/Assert.h"
+#include "common/Platform.h"
+#include "dawn_wire/WireServer.h"
+
+#if defined(DAWN_PLATFORM_POSIX)
+
+#    include "dawn_wire/SharedMemoryTransferService.h"
+
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <unistd.h>
+
+#    include <cstring>
+#    include <limits>
+
+namespace dawn_wire { namespace server {
+
+    namespace {
+
+        // Opens the client's region and unlinks its name: the name only exists to hand the
+        // region across process boundaries and the mapping keeps the pages alive.
+        bool OpenRegion(const void* deserializePointer,
+                        size_t deserializeSize,
+                        SharedMemoryCreateInfo* info,
+                        void** mapping) {
+            if (deserializePointer == nullptr ||
+                deserializeSize != sizeof(SharedMemoryCreateInfo)) {
+                return false;
+            }
+            memcpy(info, deserializePointer, sizeof(SharedMemoryCreateInfo));
+            if (memchr(info->name, '\0', sizeof(info->name)) == nullptr ||
+                info->size > std::numeric_limits<size_t>::max()) {
+                return false;
+            }
+
+            int fd = shm_open(info->name, O_RDWR, 0);
+            if (fd < 0) {
+                return false;
+            }
+            shm_unlink(info->name);
+
+            size_t mappingSize = info->size > 0 ? static_cast<size_t>(info->size) : 1;
+            *mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            return *mapping != MAP_FAILED;
+        }
+
+    }  // anonymous namespace
+
+    class SharedMemoryTransferService : public MemoryTransferService {
+      public:
+        class ReadHandleImpl : public ReadHandle {
+          public:
+            ReadHandleImpl(const SharedMemoryCreateInfo& info, void* mapping)
+                : mInfo(info), mMapping(mapping) {
+            }
+
+            ~ReadHandleImpl() override {
+                munmap(mMapping, mInfo.size > 0 ? static_cast<size_t>(mInfo.size) : 1);
+            }
+
+            size_t SerializeInitialDataSize(const void* data, size_t dataLength) override {
+                // The data is written straight into the shared region; nothing travels on
+                // the command stream.
+                return 0;
+            }
+
+            void SerializeInitialData(const void* data, size_t dataLength, void*) override {
+                ASSERT(dataLength == mInfo.size);
+                if (dataLength > 0) {
+                    ASSERT(data != nullptr);
+                    memcpy(mMapping, data, dataLength);
+                }
+            }
+
+          private:
+            SharedMemoryCreateInfo mInfo;
+            void* mMapping;
+        };
+
+        class WriteHandleImpl : public WriteHandle {
+          public:
+            WriteHandleImpl(const SharedMemoryCreateInfo& info, void* mapping)
+                : mInfo(info), mMapping(mapping) {
+            }
+
+            ~WriteHandleImpl() override {
+                munmap(mMapping, mInfo.size > 0 ? static_cast<size_t>(mInfo.size) : 1);
+            }
+
+            bool DeserializeFlush(const void* deserializePointer, size_t deserializeSize) override {
+                // The client's writes are already visible through the shared mapping; the
+                // flush itself carries no payload.
+                if (deserializeSize != 0 || mTargetData == nullptr ||
+                    mDataLength != mInfo.size) {
+                    return false;
+                }
+                memcpy(mTargetData, mMapping, mDataLength);
+                return true;
+            }
+
+          private:
+            SharedMemoryCreateInfo mInfo;
+            void* mMapping;
+        };
+
+        SharedMemoryTransferService() {
+        }
+        ~SharedMemoryTransferService() override = default;
+
+        bool DeserializeReadHandle(const void* deserializePointer,
+                                   size_t deserializeSize,
+                                   ReadHandle** readHandle) override {
+            SharedMemoryCreateInfo info;
+            void* mapping = nullptr;
+            if (!OpenRegion(deserializePointer, deserializeSize, &info, &mapping)) {
+                return false;
+            }
+
+            ASSERT(readHandle != nullptr);
+            *readHandle = new ReadHandleImpl(info, mapping);
+            return true;
+        }
+
+        bool DeserializeWriteHandle(const void* deserializePointer,
+                                    size_t deserializeSize,
+                                    WriteHandle** writeHandle) override {
+            SharedMemoryCreateInfo info;
+            void* mapping = nullptr;
+            if (!OpenRegion(deserializePointer, deserializeSize, &info, &mapping)) {
+                return false;
+            }
+
+            ASSERT(writeHandle != nullptr);
+            *writeHandle = new WriteHandleImpl(info, mapping);
+            return true;
+        }
+    };
+
+    std::unique_ptr<MemoryTransferService> CreateSharedMemoryTransferService() {
+        return std::make_unique<SharedMemoryTransferService>();
+    }
+
+}}  //  namespace dawn_wire::server
+
+#else  // defined(DAWN_PLATFORM_POSIX)
+
+namespace dawn_wire { namespace server {
+
+    std::unique_ptr<MemoryTransferService> CreateSharedMemoryTransferService() {
+        return nullptr;
+    }
+
+}}  //  namespace dawn_wire::server
+
+#endif  // defined(DAWN_PLATFORM_POSIX)
@@ -0,0 +1,146 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "DawnWireServerFuzzer.h"
+
+#include "common/Assert.h"
+#include "dawn_native/DawnNative.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Replays recorded wire corpora through the wire server and the null-backend
+// frontend with timing, reusing the fuzzer deserialization path. Corpora recorded
+// from real applications make this a reproducible CPU benchmark of command
+// deserialization and frontend validation on real traffic, unlike the synthetic
+// workloads in dawn_perf_tests.
+
+namespace {
+
+    constexpr uint32_t kDefaultIterations = 16;
+
+    // The same device setup the wire server frontend fuzzer uses, so the benchmark
+    // and the fuzzer exercise identical code.
+    wgpu::Device MakeNullDevice(dawn_native::Instance* instance) {
+        std::vector<dawn_native::Adapter> adapters = instance->GetAdapters();
+
+        wgpu::Device nullDevice;
+        for (dawn_native::Adapter adapter : adapters) {
+            wgpu::AdapterProperties properties;
+            adapter.GetProperties(&properties);
+
+            if (properties.backendType == wgpu::BackendType::Null) {
+                nullDevice = wgpu::Device::Acquire(adapter.CreateDevice());
+                break;
+            }
+        }
+
+        ASSERT(nullDevice.Get() != nullptr);
+        return nullDevice;
+    }
+
+    bool ReadCorpusFile(const char* filename, std::vector<char>* data) {
+        FILE* file = fopen(filename, "rb");
+        if (!file) {
+            std::cerr << "Failed to open " << filename << std::endl;
+            return false;
+        }
+
+        fseek(file, 0, SEEK_END);
+        long tellFileSize = ftell(file);
+        if (tellFileSize <= 0) {
+            std::cerr << "Corpus file of incorrect size: " << filename << std::endl;
+            fclose(file);
+            return false;
+        }
+        fseek(file, 0, SEEK_SET);
+
+        size_t fileSize = static_cast<size_t>(tellFileSize);
+        data->resize(fileSize);
+
+        size_t bytesRead = fread(data->data(), sizeof(char), fileSize, file);
+        fclose(file);
+        if (bytesRead != fileSize) {
+            std::cerr << "Failed to read " << filename << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    double ReplayOnce(const std::vector<char>& data) {
+        auto start = std::chrono::steady_clock::now();
+        DawnWireServerFuzzer::Run(reinterpret_cast<const uint8_t*>(data.data()), data.size(),
+                                  MakeNullDevice, false /* supportsErrorInjection */);
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count();
+    }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (DawnWireServerFuzzer::Initialize(&argc, &argv)) {
+        std::cerr << "Failed to initialize the wire server" << std::endl;
+        return 1;
+    }
+
+    uint32_t iterations = kDefaultIterations;
+    std::vector<const char*> files;
+
+    for (int i = 1; i < argc; ++i) {
+        constexpr const char kIterationsArg[] = "--iterations=";
+        if (strstr(argv[i], kIterationsArg) == argv[i]) {
+            iterations = static_cast<uint32_t>(atoi(argv[i] + strlen(kIterationsArg)));
+            continue;
+        }
+        files.push_back(argv[i]);
+    }
+
+    if (files.empty() || iterations == 0) {
+        std::cout << "Usage: dawn_wire_trace_bench [--iterations=N] FILE [FILE...]" << std::endl;
+        return 1;
+    }
+
+    for (const char* filename : files) {
+        std::vector<char> data;
+        if (!ReadCorpusFile(filename, &data)) {
+            return 1;
+        }
+
+        // One untimed replay warms caches and one-time lazy initialization so the
+        // timed iterations only measure steady-state replay cost.
+        ReplayOnce(data);
+
+        double totalUs = 0;
+        double minUs = 0;
+        for (uint32_t i = 0; i < iterations; ++i) {
+            double us = ReplayOnce(data);
+            totalUs += us;
+            if (i == 0 || us < minUs) {
+                minUs = us;
+            }
+        }
+
+        // The minimum is the least noisy estimate of the replay cost; the mean shows
+        // how much the run jittered.
+        std::cout << filename << ": " << data.size() << " bytes, " << iterations
+                  << " iterations, min " << minUs << " us, mean " << (totalUs / iterations)
+                  << " us, " << (data.size() / minUs) << " MB/s" << std::endl;
+    }
+
+    return 0;
+}
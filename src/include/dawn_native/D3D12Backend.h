@@ -27,9 +27,26 @@ namespace dawn_native { namespace d3d12 {
     DAWN_NATIVE_EXPORT Microsoft::WRL::ComPtr<ID3D12Device> GetD3D12Device(WGPUDevice device);
     DAWN_NATIVE_EXPORT DawnSwapChainImplementation CreateNativeSwapChainImpl(WGPUDevice device,
                                                                              HWND window);
+
+    // Creates a swapchain with explicit frame pacing. When maximumFrameLatency is non-zero
+    // the swapchain is created with DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT and
+    // DXGI limits the number of queued frames accordingly; the waitable handle is then
+    // available through GetFrameLatencyWaitableObject.
+    DAWN_NATIVE_EXPORT DawnSwapChainImplementation
+    CreateNativeSwapChainImpl(WGPUDevice device,
+                              HWND window,
+                              const SwapChainLatencyDescriptor* latencyDescriptor);
+
     DAWN_NATIVE_EXPORT WGPUTextureFormat
     GetNativeSwapChainPreferredFormat(const DawnSwapChainImplementation* swapChain);
 
+    // The DXGI frame-latency waitable object of the swapchain. The application waits on it
+    // before rendering a frame to pace the CPU maximumFrameLatency frames ahead of
+    // presentation. Returns null when the swapchain was created without a frame latency
+    // limit or has not been configured yet. The handle stays owned by the swapchain.
+    DAWN_NATIVE_EXPORT HANDLE
+    GetFrameLatencyWaitableObject(const DawnSwapChainImplementation* swapChain);
+
     enum MemorySegment {
         Local,
         NonLocal,
@@ -39,6 +56,39 @@ namespace dawn_native { namespace d3d12 {
                                                              uint64_t requestedReservationSize,
                                                              MemorySegment memorySegment);
 
+    // Starts paging in the memory backing |textures| ahead of their first use, so a
+    // streaming system that knows what the next frames need can overlap residency work
+    // with decode instead of stalling the first submit on a synchronous MakeResident.
+    // This is only a scheduling hint: the device's queue waits on the paging operation,
+    // so rendering stays correct whether or not the prefetch finished in time. No-op
+    // when residency management is disabled. Returns false when a device error occurred.
+    DAWN_NATIVE_EXPORT bool MakeResidentAsync(WGPUDevice device,
+                                              WGPUTexture const* textures,
+                                              uint64_t textureCount);
+
+    // Statistics about the shader-visible descriptor heaps, for capacity planning. The
+    // high-water marks are the most descriptors ever used within a single heap lifetime;
+    // any switch after the initial allocation costs a SetDescriptorHeaps flush.
+    struct DAWN_NATIVE_EXPORT ShaderVisibleHeapStatistics {
+        uint64_t viewHeapSize;
+        uint64_t viewDescriptorHighWaterMark;
+        uint64_t viewHeapSwitchCount;
+        uint64_t samplerHeapSize;
+        uint64_t samplerDescriptorHighWaterMark;
+        uint64_t samplerHeapSwitchCount;
+    };
+
+    DAWN_NATIVE_EXPORT ShaderVisibleHeapStatistics
+    GetShaderVisibleHeapStatistics(WGPUDevice device);
+
+    // Sizes the shader-visible descriptor heaps and reallocates them immediately, so an
+    // application that knows its working set can allocate once at startup and never take
+    // a mid-frame heap switch. A count of 0 keeps the default (maximum tier) size for
+    // that heap type. Returns false if a heap could not be allocated.
+    DAWN_NATIVE_EXPORT bool ReserveShaderVisibleDescriptorHeaps(WGPUDevice device,
+                                                                uint32_t viewDescriptorCount,
+                                                                uint32_t samplerDescriptorCount);
+
     struct DAWN_NATIVE_EXPORT ExternalImageDescriptorDXGISharedHandle : ExternalImageDescriptor {
       public:
         ExternalImageDescriptorDXGISharedHandle();
@@ -52,6 +102,15 @@ namespace dawn_native { namespace d3d12 {
     DAWN_NATIVE_EXPORT WGPUTexture
     WrapSharedHandle(WGPUDevice device, const ExternalImageDescriptorDXGISharedHandle* descriptor);
 
+    // Exports the fence the device's queue signals after each submission as a shared handle,
+    // and writes the value the fence reaches once all work submitted so far completes.
+    // Another process opens the handle with ID3D12Device::OpenSharedHandle and waits on
+    // (fence, value) GPU-side with ID3D12CommandQueue::Wait (or on the CPU with
+    // ID3D12Fence::SetEventOnCompletion) instead of a CPU round-trip through this process.
+    // The caller owns the returned handle. Returns null on failure.
+    DAWN_NATIVE_EXPORT HANDLE ExportFenceSharedHandle(WGPUDevice device,
+                                                      uint64_t* outCompletionValue);
+
 }}  // namespace dawn_native::d3d12
 
 #endif  // DAWNNATIVE_D3D12BACKEND_H_
@@ -81,6 +81,16 @@ namespace dawn_native {
     // creation of device.
     using ExtensionInfo = ToggleInfo;
 
+    // One row of the capability matrix returned by Adapter::GetFormatCapabilities.
+    struct DAWN_NATIVE_EXPORT FormatCapabilities {
+        WGPUTextureFormat format;
+        // The usages textures of this format can be created with, 0 when the format is
+        // unsupported.
+        WGPUTextureUsageFlags supportedUsages = 0;
+        // False when the format needs an extension the adapter doesn't support.
+        bool supported = false;
+    };
+
     // An adapter is an object that represent on possibility of creating devices in the system.
     // Most of the time it will represent a combination of a physical GPU and an API. Not that the
     // same GPU can be represented by multiple adapters but on different APIs.
@@ -105,6 +115,21 @@ namespace dawn_native {
         std::vector<const char*> GetSupportedExtensions() const;
         WGPUDeviceProperties GetAdapterProperties() const;
 
+        // The supported-usage matrix for every texture format Dawn knows about, in one
+        // call, so applications can skip probing support with test texture creations at
+        // startup. Creating a texture with a usage listed here never fails format or usage
+        // validation on a device created from this adapter (assuming the extension gating
+        // the format was requested).
+        std::vector<FormatCapabilities> GetFormatCapabilities() const;
+
+        // Returns an opaque identifier that changes whenever serialized ray tracing
+        // acceleration container blobs produced on this adapter stop being
+        // deserializable, typically on a driver or hardware change. Embedders caching
+        // blobs on disk should store the identifier next to them and rebuild when it
+        // differs. An empty identifier means there is no stable identifier and blobs
+        // must always be rebuilt.
+        std::vector<uint8_t> GetAccelerationContainerCompatibilityId() const;
+
         explicit operator bool() const;
 
         // Create a device on this adapter, note that the interface will change to include at least
@@ -142,6 +167,11 @@ namespace dawn_native {
         // adapters will later be returned by GetAdapters.
         void DiscoverDefaultAdapters();
 
+        // Same as DiscoverDefaultAdapters but only initializes |backendType|. The other
+        // compiled backends aren't loaded at all, which makes this much cheaper when the
+        // application already knows which backend it wants.
+        void DiscoverDefaultAdapters(WGPUBackendType backendType);
+
         // Adds adapters that can be discovered with the options provided (like a getProcAddress).
         // The backend is chosen based on the type of the options used. Returns true on success.
         bool DiscoverAdapters(const AdapterDiscoveryOptionsBase* options);
@@ -172,6 +202,130 @@ namespace dawn_native {
     // Query the names of all the toggles that are enabled in device
     DAWN_NATIVE_EXPORT std::vector<const char*> GetTogglesUsed(WGPUDevice device);
 
+    // Persistent pipeline cache. GetPipelineCacheData returns the backend's pipeline cache
+    // blob (empty when the backend has no native cache); the embedder can persist it and
+    // load it into a later device with LoadPipelineCacheData so pipeline creation hits the
+    // driver cache on subsequent launches. Returns false when loading fails, for example
+    // because the blob was produced by a different driver version.
+    DAWN_NATIVE_EXPORT bool LoadPipelineCacheData(WGPUDevice device, const void* data, size_t size);
+    DAWN_NATIVE_EXPORT std::vector<uint8_t> GetPipelineCacheData(WGPUDevice device);
+
+    // Device memory budget, in bytes, for the memory segment textures and buffers are
+    // allocated from. The budget is defined by the operating system or driver and can change
+    // over time; a usage approaching the budget means further allocations risk failing or
+    // causing paging. Both values are zero when the backend cannot query a budget.
+    struct DAWN_NATIVE_EXPORT MemoryBudgetInfo {
+        uint64_t budget = 0;
+        uint64_t usage = 0;
+    };
+    using MemoryBudgetCallback = void (*)(const MemoryBudgetInfo& info, void* userdata);
+
+    // Queries the current memory budget and usage of the device.
+    DAWN_NATIVE_EXPORT MemoryBudgetInfo QueryMemoryBudget(WGPUDevice device);
+
+    // Blocks until GPU work that wgpuDeviceTick has not yet observed completes, so an
+    // application loop can sleep here instead of polling Tick for map/fence/error-scope
+    // callbacks. Returns true when a Tick would now make progress and false on timeout or
+    // when no work is in flight. Backends without a waitable completion primitive return
+    // true immediately, degrading to polling.
+    DAWN_NATIVE_EXPORT bool WaitForCompletedWork(WGPUDevice device, uint64_t timeoutNanoseconds);
+
+    // Sets a callback fired from inside the allocation path when usage crosses 90% of the
+    // budget (and again each time it crosses after having dropped below), so a streaming
+    // system can throttle before allocations start failing. Pass nullptr to unset.
+    DAWN_NATIVE_EXPORT void SetMemoryBudgetCallback(WGPUDevice device,
+                                                    MemoryBudgetCallback callback,
+                                                    void* userdata);
+
+    // Schedules an asynchronous read of |size| bytes at |offset| from |buffer| through a
+    // device-managed ring of persistently mapped readback memory. The callback runs during
+    // a later device Tick, once the GPU copy recorded by this call has completed; |data|
+    // points into the ring and is only valid for the duration of the call. Intended for
+    // small recurring readbacks (query results, statistics) that would otherwise pay for a
+    // MapRead buffer creation, map and destruction each. Returns false when validation
+    // fails, for example when the range is out of bounds or |buffer| lacks CopySrc usage.
+    using ReadbackCallback = void (*)(const void* data, uint64_t size, void* userdata);
+    DAWN_NATIVE_EXPORT bool ReadBufferAsync(WGPUDevice device,
+                                            WGPUBuffer buffer,
+                                            uint64_t offset,
+                                            uint64_t size,
+                                            ReadbackCallback callback,
+                                            void* userdata);
+
+    // Permanently freezes |buffer| into |usage|, a non-empty read-only subset of its
+    // creation usages. The buffer is transitioned to that state once and then dropped from
+    // per-pass usage tracking, removing its barrier and bookkeeping cost from every later
+    // pass. Intended for static resources (vertex/index pools) that are written once and
+    // read forever. Frozen buffers cannot be written, mapped or destroyed anymore; their
+    // memory is reclaimed when the last reference is released. Returns false when
+    // validation fails, for example when |usage| is not read-only or the buffer is mappable.
+    DAWN_NATIVE_EXPORT bool FreezeBufferUsage(WGPUDevice device,
+                                              WGPUBuffer buffer,
+                                              WGPUBufferUsageFlags usage);
+
+    // Sets the per-tick budget for building background priority ray tracing
+    // acceleration containers, expressed in primitives (the quantity build time scales
+    // with). Deferred builds beyond the budget stay queued for later ticks.
+    DAWN_NATIVE_EXPORT void SetAccelerationContainerBuildBudget(WGPUDevice device,
+                                                                uint64_t maxPrimitivesPerTick);
+
+    // Driver-reported memory footprint of a ray tracing acceleration container.
+    // |resultSize| backs the built structure and stays allocated for the container's
+    // lifetime. The scratch sizes are only required while a build or update command
+    // executes; depending on the backend they are serviced from a device pool or
+    // allocated alongside the container. All sizes are zero before the container's
+    // requirements were queried and after it is destroyed.
+    struct DAWN_NATIVE_EXPORT RayTracingMemoryUsage {
+        uint64_t resultSize = 0;
+        uint64_t buildScratchSize = 0;
+        uint64_t updateScratchSize = 0;
+    };
+
+    DAWN_NATIVE_EXPORT RayTracingMemoryUsage
+    GetRayTracingAccelerationContainerMemoryUsage(WGPURayTracingAccelerationContainer container);
+
+    // The same quantities summed over every live container on the device, so a budget
+    // system can decide when to compact or evict without re-deriving driver size
+    // formulas that differ per vendor.
+    DAWN_NATIVE_EXPORT RayTracingMemoryUsage QueryRayTracingMemoryUsage(WGPUDevice device);
+
+    // Introspects the record layout of a ray tracing shader binding table: records are
+    // laid out contiguously, one per group, GetShaderBindingTableGroupStride bytes apart,
+    // and the record of |groupIndex| starts at GetShaderBindingTableGroupOffset. Lets
+    // tooling lay out shader binding table images offline; the driver-owned group handles
+    // themselves stay per-pipeline and are fetched once at pipeline creation.
+    DAWN_NATIVE_EXPORT uint32_t
+    GetShaderBindingTableGroupStride(WGPURayTracingShaderBindingTable shaderBindingTable);
+    DAWN_NATIVE_EXPORT uint64_t
+    GetShaderBindingTableGroupOffset(WGPURayTracingShaderBindingTable shaderBindingTable,
+                                     uint32_t groupIndex);
+
+    // Creates |count| shader modules, spreading validation and compilation over worker
+    // threads. Equivalent to calling wgpuDeviceCreateShaderModule on each descriptor:
+    // failed entries come back as error shader modules and their errors are reported in
+    // index order once all workers finish.
+    DAWN_NATIVE_EXPORT void CreateShaderModules(WGPUDevice device,
+                                                uint32_t count,
+                                                const WGPUShaderModuleDescriptor* const* descriptors,
+                                                WGPUShaderModule* modules);
+
+    // Creates |count| bind groups in one call. Equivalent to calling
+    // wgpuDeviceCreateBindGroup on each descriptor but amortizes the per-call overhead,
+    // which matters for bulk creation at load time. Failed entries come back as error
+    // bind groups and their errors are reported in index order.
+    DAWN_NATIVE_EXPORT void CreateBindGroups(WGPUDevice device,
+                                             uint32_t count,
+                                             const WGPUBindGroupDescriptor* const* descriptors,
+                                             WGPUBindGroup* bindGroups);
+
+    // Returns the uncompressed format the application should transcode |format| to on the CPU
+    // before creating textures when the device doesn't support it natively, for example BC
+    // textures on adapters without the texture-compression-BC extension. Returns |format|
+    // unchanged when it is supported natively and WGPUTextureFormat_Undefined when the format
+    // is unknown or has no fallback.
+    DAWN_NATIVE_EXPORT WGPUTextureFormat GetTextureFormatUploadFallback(WGPUDevice device,
+                                                                        WGPUTextureFormat format);
+
     // Backdoor to get the number of lazy clears for testing
     DAWN_NATIVE_EXPORT size_t GetLazyClearCountForTesting(WGPUDevice device);
 
@@ -213,6 +367,30 @@ namespace dawn_native {
       protected:
         ExternalImageDescriptor(ExternalImageDescriptorType type);
     };
+
+    // How presented frames are paced against the display refresh.
+    enum class PresentMode {
+        // Frames are queued and presented in order at the display rate. Highest latency,
+        // never tears.
+        Fifo,
+        // The newest fully rendered frame replaces any queued one, so rendering is never
+        // throttled by presentation and stale frames are dropped. Does not tear.
+        Mailbox,
+        // Frames are presented as soon as they are rendered, possibly with tearing.
+        Immediate,
+    };
+
+    // Frame pacing controls for native swapchains, passed to the backends'
+    // CreateNativeSwapChainImpl entry points. A backend that cannot honor the requested
+    // present mode falls back to Fifo, which is always available.
+    struct DAWN_NATIVE_EXPORT SwapChainLatencyDescriptor {
+        PresentMode presentMode = PresentMode::Fifo;
+        // The maximum number of fully rendered frames that may be queued for presentation
+        // before rendering the next one. Lower values reduce input-to-display latency at
+        // the cost of less buffering against frame time spikes. 0 keeps the backend
+        // default (3 frames).
+        uint32_t maximumFrameLatency = 0;
+    };
 }  // namespace dawn_native
 
 #endif  // DAWNNATIVE_DAWNNATIVE_H_
@@ -20,6 +20,11 @@
 
 namespace dawn_native { namespace null {
     DAWN_NATIVE_EXPORT DawnSwapChainImplementation CreateNativeSwapChainImpl();
+
+    // Returns the number of commands the device has consumed from submitted command buffers
+    // since creation. Only counts while the null_backend_throughput_mode toggle is enabled;
+    // benchmark harnesses use it to verify how much work a timed run actually recorded.
+    DAWN_NATIVE_EXPORT uint64_t GetCommandsConsumed(WGPUDevice device);
 }}  // namespace dawn_native::null
 
 #endif  // DAWNNATIVE_NULLBACKEND_H_
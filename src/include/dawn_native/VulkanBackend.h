@@ -29,9 +29,66 @@ namespace dawn_native { namespace vulkan {
 
     DAWN_NATIVE_EXPORT DawnSwapChainImplementation
     CreateNativeSwapChainImpl(WGPUDevice device, ::VkSurfaceKHR surface);
+
+    // Creates a swapchain with explicit frame pacing: the present mode maps to the
+    // corresponding VkPresentModeKHR (falling back to FIFO when unsupported by the surface)
+    // and maximumFrameLatency bounds the number of swapchain images requested.
+    DAWN_NATIVE_EXPORT DawnSwapChainImplementation
+    CreateNativeSwapChainImpl(WGPUDevice device,
+                              ::VkSurfaceKHR surface,
+                              const SwapChainLatencyDescriptor* latencyDescriptor);
+
     DAWN_NATIVE_EXPORT WGPUTextureFormat
     GetNativeSwapChainPreferredFormat(const DawnSwapChainImplementation* swapChain);
 
+    // Issues all presents deferred by the batch_swapchain_presents toggle as a single
+    // vkQueuePresentKHR call. Call this after the last SwapChain::Present of a frame;
+    // otherwise pending presents are flushed at the next queue submission. No-op when
+    // nothing is pending.
+    DAWN_NATIVE_EXPORT void FlushPendingPresents(WGPUDevice device);
+
+    // Describes the attachments of render passes that an application will use so the
+    // VkRenderPasses for them can be created at load time instead of causing a hitch on first
+    // use. Load and store ops don't need to be specified: pipelines only require a compatible
+    // render pass so they reuse the pre-warmed one, and additional load-op variants are cheap
+    // to create on demand.
+    struct DAWN_NATIVE_EXPORT RenderPassPrewarmDescriptor {
+        const WGPUTextureFormat* colorFormats = nullptr;
+        uint32_t colorFormatCount = 0;
+        // Whether every color attachment has a multisample resolve target.
+        bool hasResolveTargets = false;
+        // WGPUTextureFormat_Undefined means no depth-stencil attachment.
+        WGPUTextureFormat depthStencilFormat = WGPUTextureFormat_Undefined;
+        uint32_t sampleCount = 1;
+    };
+
+    // Creates the VkRenderPasses for |count| attachment combinations ahead of time. Returns
+    // false if any render pass creation failed.
+    DAWN_NATIVE_EXPORT bool PrewarmRenderPassCache(WGPUDevice device,
+                                                   const RenderPassPrewarmDescriptor* descriptors,
+                                                   uint32_t count);
+
+    // Descriptor for importing host memory as a buffer. The memory must stay valid and at
+    // the same address for the lifetime of the returned buffer.
+    struct DAWN_NATIVE_EXPORT HostPointerBufferDescriptor {
+        const WGPUBufferDescriptor* cBufferDescriptor;
+        void* hostPointer;        // Must be aligned to GetHostPointerImportAlignment
+        uint64_t allocationSize;  // Aligned size covering at least the buffer size
+    };
+
+    // Returns the alignment host pointers and allocation sizes must have for
+    // WrapVulkanHostPointer, or 0 when VK_EXT_external_memory_host is unavailable.
+    DAWN_NATIVE_EXPORT uint64_t GetHostPointerImportAlignment(WGPUDevice device);
+
+    // Imports host memory as a buffer with VK_EXT_external_memory_host, so GPU copies can
+    // source directly from memory the CPU already owns. This lets a wire server make the
+    // shared memory region of its memory transfer service the staging source of buffer
+    // uploads instead of copying it into a separate staging allocation first. The usual
+    // external buffer restrictions apply (no map or ray tracing usages). On failure,
+    // returns a nullptr.
+    DAWN_NATIVE_EXPORT WGPUBuffer
+    WrapVulkanHostPointer(WGPUDevice cDevice, const HostPointerBufferDescriptor* descriptor);
+
 // Can't use DAWN_PLATFORM_LINUX since header included in both dawn and chrome
 #ifdef __linux__
         // Common properties of external images represented by FDs. On successful import the file
@@ -74,6 +131,57 @@ namespace dawn_native { namespace vulkan {
         // On failure, returns a nullptr.
         DAWN_NATIVE_EXPORT WGPUTexture WrapVulkanImage(WGPUDevice cDevice,
                                                        const ExternalImageDescriptor* descriptor);
+
+        // Everything an importing device needs to wrap a resource created with one of the
+        // CreateExportable* functions below. Ownership of memoryFD is transferred to the caller.
+        struct DAWN_NATIVE_EXPORT ExternalMemoryExportInfoOpaqueFD {
+            int memoryFD = -1;  // A file descriptor from an export of the memory of the resource
+            uint64_t allocationSize = 0;
+            uint32_t memoryTypeIndex = 0;
+        };
+
+        // Descriptor for opaque file descriptor buffer import
+        struct DAWN_NATIVE_EXPORT ExternalBufferDescriptorOpaqueFD {
+            const WGPUBufferDescriptor* cBufferDescriptor;
+            int memoryFD;                 // A file descriptor from an export of the buffer memory
+            uint64_t allocationSize;      // Must match the allocation the memory was exported from
+            uint32_t memoryTypeIndex;     // Must match the allocation the memory was exported from
+            std::vector<int> waitFDs;     // File descriptors of semaphores which will be waited on
+        };
+
+        // Creates a texture whose memory can be exported so that another device (typically
+        // another Dawn device on a second GPU) can alias the same allocation with
+        // WrapVulkanImage instead of copying through the CPU. Ownership is handed over by
+        // calling ExportSignalSemaphoreOpaqueFD and passing the returned FD in the importing
+        // descriptor's waitFDs. On failure, returns a nullptr.
+        DAWN_NATIVE_EXPORT WGPUTexture
+        CreateExportableVulkanImage(WGPUDevice cDevice,
+                                    const WGPUTextureDescriptor* descriptor,
+                                    ExternalMemoryExportInfoOpaqueFD* exportInfo);
+
+        // Imports external memory into a Vulkan buffer, with the same semantics as
+        // WrapVulkanImage. External buffers cannot be mapped or used for ray tracing.
+        // On failure, returns a nullptr.
+        DAWN_NATIVE_EXPORT WGPUBuffer
+        WrapVulkanBuffer(WGPUDevice cDevice, const ExternalBufferDescriptorOpaqueFD* descriptor);
+
+        // Buffer equivalent of CreateExportableVulkanImage; the importing device wraps the
+        // exported memory with WrapVulkanBuffer. On failure, returns a nullptr.
+        DAWN_NATIVE_EXPORT WGPUBuffer
+        CreateExportableVulkanBuffer(WGPUDevice cDevice,
+                                     const WGPUBufferDescriptor* descriptor,
+                                     ExternalMemoryExportInfoOpaqueFD* exportInfo);
+
+        // Exports a signal semaphore from a wrapped or exportable buffer and destroys it,
+        // handing the memory over to the importing device. On failure, returns -1
+        DAWN_NATIVE_EXPORT int ExportSignalSemaphoreOpaqueFD(WGPUDevice cDevice,
+                                                             WGPUBuffer cBuffer);
+
+        // Submits all pending commands with an extra semaphore signaled on their completion
+        // and exports it as a file descriptor, so an external process (e.g. a compositor)
+        // can wait on the queue GPU-side instead of through a CPU round-trip. The caller
+        // owns the returned FD. On failure, returns -1
+        DAWN_NATIVE_EXPORT int ExportQueueSignalSemaphoreOpaqueFD(WGPUDevice cDevice);
 #endif  // __linux__
 }}  // namespace dawn_native::vulkan
 
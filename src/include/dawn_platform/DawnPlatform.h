@@ -17,6 +17,7 @@
 
 #include <dawn_native/dawn_native_export.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
 namespace dawn_platform {
@@ -28,6 +29,70 @@ namespace dawn_platform {
         GPUWork,     // Actual GPU work
     };
 
+    enum class MemoryCategory {
+        CommandBlocks,  // Blocks of host memory backing recorded commands
+        General,        // Host allocations without a dedicated category
+    };
+
+    using WorkerTaskCallback = void (*)(void* userdata);
+    using ParallelForCallback = void (*)(void* userdata, uint32_t index);
+
+    // The scheduler Dawn posts its internal work to. Embedders with their own thread
+    // pool should return an adapter to it from Platform::GetWorkerTaskPool so Dawn's
+    // workers and the application's don't oversubscribe the machine.
+    class DAWN_NATIVE_EXPORT WorkerTaskPool {
+      public:
+        virtual ~WorkerTaskPool();
+
+        // Runs |callback| on a worker as soon as one is available. May be called from
+        // any thread, including workers.
+        virtual void PostWorkerTask(WorkerTaskCallback callback, void* userdata) = 0;
+
+        // Runs |callback| on a worker no earlier than |delayMs| milliseconds from now.
+        virtual void PostDelayedWorkerTask(WorkerTaskCallback callback,
+                                           void* userdata,
+                                           uint64_t delayMs) = 0;
+
+        // Number of tasks the pool can usefully run concurrently, used to size the
+        // ParallelFor fan-out. Defaults to the hardware concurrency.
+        virtual uint32_t GetMaxConcurrentTasks();
+
+        // Invokes |callback| for every index in [0, iterationCount) across the pool's
+        // workers and blocks until all iterations completed. The default implementation
+        // has the calling thread and one posted task per worker claim fixed-size index
+        // chunks from a shared cursor, so uneven iteration costs balance out.
+        virtual void ParallelFor(uint32_t iterationCount,
+                                 ParallelForCallback callback,
+                                 void* userdata);
+    };
+
+    // An embedder-provided persistent store for expensive-to-recreate artifacts such as
+    // compiled shader blobs, so warm starts skip the work entirely. Keys are opaque byte
+    // strings that already encode everything the value depends on (content, backend,
+    // compiler identity), so equal keys always denote equal values and the store may
+    // digest them into whatever identifier scheme it uses on disk.
+    class DAWN_NATIVE_EXPORT CachingInterface {
+      public:
+        virtual ~CachingInterface() {
+        }
+
+        // Returns the size of the entry stored under |key|, or 0 when there is none. When
+        // |value| is not null, up to |valueSize| bytes of the entry are copied into it.
+        // Callers query the size with a null |value| first, then load into a buffer of
+        // that size.
+        virtual size_t LoadData(const void* key,
+                                size_t keySize,
+                                void* value,
+                                size_t valueSize) = 0;
+
+        // Stores |value| under |key|, replacing any previous entry. Dawn writes entries
+        // back from worker threads, so implementations must be thread-safe.
+        virtual void StoreData(const void* key,
+                               size_t keySize,
+                               const void* value,
+                               size_t valueSize) = 0;
+    };
+
     class DAWN_NATIVE_EXPORT Platform {
       public:
         virtual ~Platform() {
@@ -46,6 +111,26 @@ namespace dawn_platform {
                                        const unsigned char* argTypes,
                                        const uint64_t* argValues,
                                        unsigned char flags) = 0;
+
+        // Called when Dawn allocates or frees host memory, so embedders can attribute and
+        // cap Dawn's host memory usage. Every OnMemoryAllocated has a matching OnMemoryFreed
+        // with the same category and size. May be called from any thread.
+        virtual void OnMemoryAllocated(MemoryCategory category, size_t size) {
+        }
+        virtual void OnMemoryFreed(MemoryCategory category, size_t size) {
+        }
+
+        // Returns the embedder's persistent cache, or nullptr when nothing should be
+        // cached across runs. The cache is owned by the platform and must stay valid
+        // for the platform's lifetime.
+        virtual CachingInterface* GetCachingInterface() {
+            return nullptr;
+        }
+
+        // Returns the pool all Dawn-internal parallelism is posted through. The pool is
+        // owned by the platform and must stay valid for the platform's lifetime. The
+        // default is a process-wide pool with one thread per core.
+        virtual WorkerTaskPool* GetWorkerTaskPool();
     };
 
 }  // namespace dawn_platform
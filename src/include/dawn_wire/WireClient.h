@@ -34,9 +34,27 @@ namespace dawn_wire {
         uint32_t generation;
     };
 
+    // Controls when the wire client flushes buffered commands to its serializer on its own.
+    // All triggers are optional; with none enabled the application drives flushing entirely,
+    // either through WireClient::Flush or through its serializer.
+    struct DAWN_WIRE_EXPORT WireClientFlushPolicy {
+        // Flush before recording a command that would bring the number of buffered command
+        // bytes above this threshold. 0 disables the trigger.
+        size_t maxPendingCommandBytes = 0;
+        // Flush when the oldest buffered command has been waiting at least this many
+        // milliseconds, checked whenever a new command is recorded. 0 disables the trigger.
+        uint64_t maxPendingTimeMs = 0;
+        // Flush right after a queue submit is recorded.
+        bool flushOnQueueSubmit = false;
+    };
+
     struct DAWN_WIRE_EXPORT WireClientDescriptor {
         CommandSerializer* serializer;
         client::MemoryTransferService* memoryTransferService = nullptr;
+        WireClientFlushPolicy flushPolicy;
+        // Pre-sizes the per-type object ID tables so that allocating this many objects of
+        // a type never grows them. 0 keeps growth fully dynamic.
+        size_t reservedObjectCapacity = 0;
     };
 
     class DAWN_WIRE_EXPORT WireClient : public CommandHandler {
@@ -52,6 +70,25 @@ namespace dawn_wire {
 
         ReservedTexture ReserveTexture(WGPUDevice device);
 
+        // Create |count| objects with a single wire command instead of one command per
+        // object. The client-side objects are written out immediately; the server
+        // performs the creations in one batch when the commands are flushed. Intended
+        // for load-time bursts of pipeline and bind group creation.
+        void CreateBindGroups(WGPUDevice device,
+                              uint32_t count,
+                              const WGPUBindGroupDescriptor* descriptors,
+                              WGPUBindGroup* bindGroups);
+        void CreateRenderPipelines(WGPUDevice device,
+                                   uint32_t count,
+                                   const WGPURenderPipelineDescriptor* descriptors,
+                                   WGPURenderPipeline* renderPipelines);
+
+        // Flushes buffered commands through the serializer and resets the flush policy
+        // accounting. Applications that set a flush policy should flush through this
+        // instead of calling Flush on their serializer directly so the accounting stays
+        // in sync with what was sent.
+        bool Flush();
+
         // Disconnects the client.
         // Commands allocated after this point will not be sent.
         void Disconnect();
@@ -127,6 +164,12 @@ namespace dawn_wire {
             };
         };
 
+        // Create a MemoryTransferService that hands mapped data to the server through shared
+        // memory regions instead of copying it through the command stream. Both ends of the
+        // wire must use the shared memory services and run on the same machine. Returns
+        // nullptr on platforms without shared memory support.
+        DAWN_WIRE_EXPORT std::unique_ptr<MemoryTransferService> CreateSharedMemoryTransferService();
+
         // Backdoor to get the order of the ProcMap for testing
         DAWN_WIRE_EXPORT std::vector<const char*> GetProcMapNamesForTesting();
     }  // namespace client
@@ -0,0 +1,43 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNWIRE_WIRECOMPRESSION_H_
+#define DAWNWIRE_WIRECOMPRESSION_H_
+
+#include <memory>
+
+#include "dawn_wire/Wire.h"
+#include "dawn_wire/dawn_wire_export.h"
+
+namespace dawn_wire {
+
+    // Optional compression stage for transports where wire commands leave the machine.
+    // The returned serializer buffers the commands written to it and, on Flush, frames
+    // and compresses the batch into |serializer|. The peer must unwrap the frames with
+    // a handler created by CreateDecompressingHandler before the commands reach the
+    // WireClient or WireServer; the decompressing handler accepts partial frames so it
+    // can sit directly on a stream transport.
+    //
+    // The codec is a dependency-free byte run-length scheme that mostly captures the
+    // zero padding of vertex and texture payloads. Batches that don't shrink are stored
+    // verbatim, so the overhead on incompressible data is only the frame header.
+    DAWN_WIRE_EXPORT std::unique_ptr<CommandSerializer> CreateCompressingSerializer(
+        CommandSerializer* serializer);
+
+    DAWN_WIRE_EXPORT std::unique_ptr<CommandHandler> CreateDecompressingHandler(
+        CommandHandler* handler);
+
+}  // namespace dawn_wire
+
+#endif  // DAWNWIRE_WIRECOMPRESSION_H_
@@ -0,0 +1,37 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNWIRE_WIREFUNNELEDPROCS_H_
+#define DAWNWIRE_WIREFUNNELEDPROCS_H_
+
+#include "dawn/dawn_proc_table.h"
+#include "dawn_wire/dawn_wire_export.h"
+
+namespace dawn_wire {
+
+    // Returns a proc table whose entries take a process-wide mutex around the wrapped
+    // call. This lets each client process get its own WireServer on its own thread:
+    // command deserialization runs in parallel per server and only the dawn_native calls
+    // are funneled. Pass the returned table as WireServerDescriptor::procs to every
+    // funneled server.
+    //
+    // Like dawn_proc, the wrapped table is stored in process-global state, so all
+    // funneled servers must share the same underlying proc table. Procs looked up
+    // through the returned table's getProcAddress come from the wrapped table and
+    // bypass the funnel.
+    DAWN_WIRE_EXPORT DawnProcTable FunnelProcs(const DawnProcTable& procs);
+
+}  // namespace dawn_wire
+
+#endif  // DAWNWIRE_WIREFUNNELEDPROCS_H_
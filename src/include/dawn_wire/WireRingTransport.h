@@ -0,0 +1,62 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNWIRE_WIRERINGTRANSPORT_H_
+#define DAWNWIRE_WIRERINGTRANSPORT_H_
+
+#include "dawn_wire/Wire.h"
+
+#include <memory>
+
+namespace dawn_wire {
+
+    enum class RingWaitMode {
+        // The waiting side spins until it can make progress. Lowest latency, burns a core.
+        BusyPoll,
+        // The waiting side blocks on a condition variable and is notified by its peer.
+        WaitNotify,
+    };
+
+    // A lock-free single-producer single-consumer ring connecting a wire endpoint to the
+    // thread that processes its commands. The producer records commands through the
+    // transport's CommandSerializer; the consumer thread repeatedly calls Forward to hand
+    // complete batches to a CommandHandler (a WireServer, or a WireClient for return
+    // commands). Use one transport per direction.
+    class DAWN_WIRE_EXPORT RingTransport {
+      public:
+        virtual ~RingTransport();
+
+        // The serializer to record commands into, for example as
+        // WireClientDescriptor::serializer. Each Flush publishes one batch; Flush fails if
+        // a single batch cannot fit in the ring.
+        virtual CommandSerializer* GetSerializer() = 0;
+
+        // Delivers the next batch to |handler|, waiting for one according to the wait
+        // mode. Returns false once the transport is closed and drained, or if |handler|
+        // rejected a batch.
+        virtual bool Forward(CommandHandler* handler) = 0;
+
+        // Wakes both sides; pending Flushes fail and Forward returns false once the
+        // remaining batches are drained.
+        virtual void Close() = 0;
+    };
+
+    // |capacity| is in bytes and rounded up to a power of two; it bounds the batch size
+    // that can be flushed through the transport.
+    DAWN_WIRE_EXPORT std::unique_ptr<RingTransport> CreateRingTransport(size_t capacity,
+                                                                        RingWaitMode waitMode);
+
+}  // namespace dawn_wire
+
+#endif  // DAWNWIRE_WIRERINGTRANSPORT_H_
@@ -33,6 +33,9 @@ namespace dawn_wire {
         const DawnProcTable* procs;
         CommandSerializer* serializer;
         server::MemoryTransferService* memoryTransferService = nullptr;
+        // Pre-sizes the per-type object ID tables so that tracking this many objects of a
+        // type never grows them. 0 keeps growth fully dynamic.
+        size_t reservedObjectCapacity = 0;
     };
 
     class DAWN_WIRE_EXPORT WireServer : public CommandHandler {
@@ -96,6 +99,11 @@ namespace dawn_wire {
                 size_t mDataLength = 0;
             };
         };
+
+        // Create the server half of the shared memory transfer service. It maps the regions
+        // created by client::CreateSharedMemoryTransferService. Returns nullptr on platforms
+        // without shared memory support.
+        DAWN_WIRE_EXPORT std::unique_ptr<MemoryTransferService> CreateSharedMemoryTransferService();
     }  // namespace server
 
 }  // namespace dawn_wire
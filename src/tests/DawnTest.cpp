@@ -967,7 +967,8 @@ void DawnTestBase::WaitABit() {
 
 void DawnTestBase::FlushWire() {
     if (gTestEnv->UsesWire()) {
-        bool C2SFlushed = mC2sBuf->Flush();
+        // Flush through the client so batched destructions are serialized first.
+        bool C2SFlushed = mWireClient->Flush();
         bool S2CFlushed = mS2cBuf->Flush();
         ASSERT(C2SFlushed);
         ASSERT(S2CFlushed);
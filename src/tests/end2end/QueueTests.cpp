@@ -19,6 +19,11 @@
 
 #include "tests/DawnTest.h"
 
+#include <cstring>
+
+#include "common/Constants.h"
+#include "utils/WGPUHelpers.h"
+
 class QueueTests : public DawnTest {};
 
 // Test that GetDefaultQueue always returns the same object.
@@ -34,3 +39,251 @@ DAWN_INSTANTIATE_TEST(QueueTests,
                       NullBackend(),
                       OpenGLBackend(),
                       VulkanBackend());
+
+class QueueWriteTextureTests : public DawnTest {
+  protected:
+    static constexpr uint32_t kBytesPerTexel = 4;
+
+    wgpu::Texture Create2DTexture(uint32_t width, uint32_t height) {
+        wgpu::TextureDescriptor descriptor;
+        descriptor.dimension = wgpu::TextureDimension::e2D;
+        descriptor.size = {width, height, 1};
+        descriptor.arrayLayerCount = 1;
+        descriptor.sampleCount = 1;
+        descriptor.format = wgpu::TextureFormat::RGBA8Unorm;
+        descriptor.mipLevelCount = 1;
+        descriptor.usage = wgpu::TextureUsage::CopyDst | wgpu::TextureUsage::CopySrc;
+        return device.CreateTexture(&descriptor);
+    }
+
+    static wgpu::TextureDataLayout MakeDataLayout(uint64_t offset, uint32_t bytesPerRow) {
+        wgpu::TextureDataLayout dataLayout;
+        dataLayout.offset = offset;
+        dataLayout.bytesPerRow = bytesPerRow;
+        dataLayout.rowsPerImage = 0;
+        return dataLayout;
+    }
+
+    static std::vector<RGBA8> MakeTexelData(uint32_t width, uint32_t height) {
+        std::vector<RGBA8> data(width * height);
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                data[x + y * width] =
+                    RGBA8(static_cast<uint8_t>(x % 256), static_cast<uint8_t>(y % 256),
+                          static_cast<uint8_t>((x + y) % 256), 255);
+            }
+        }
+        return data;
+    }
+};
+
+// Test writing a whole texture with tightly packed rows. The width is chosen so the rows
+// need repacking to the backend row alignment while staging.
+TEST_P(QueueWriteTextureTests, FullTexture) {
+    constexpr uint32_t kWidth = 17;
+    constexpr uint32_t kHeight = 13;
+    wgpu::Texture texture = Create2DTexture(kWidth, kHeight);
+
+    std::vector<RGBA8> data = MakeTexelData(kWidth, kHeight);
+    wgpu::TextureCopyView copyView = utils::CreateTextureCopyView(texture, 0, 0, {0, 0, 0});
+    wgpu::TextureDataLayout dataLayout = MakeDataLayout(0, kWidth * kBytesPerTexel);
+    wgpu::Extent3D writeSize = {kWidth, kHeight, 1};
+    queue.WriteTexture(&copyView, data.data(), data.size() * sizeof(RGBA8), &dataLayout,
+                       &writeSize);
+
+    EXPECT_TEXTURE_RGBA8_EQ(data.data(), texture, 0, 0, kWidth, kHeight, 0, 0);
+}
+
+// Test that bytesPerRow = 0 defaults to tightly packed rows.
+TEST_P(QueueWriteTextureTests, DefaultBytesPerRow) {
+    constexpr uint32_t kWidth = 5;
+    constexpr uint32_t kHeight = 9;
+    wgpu::Texture texture = Create2DTexture(kWidth, kHeight);
+
+    std::vector<RGBA8> data = MakeTexelData(kWidth, kHeight);
+    wgpu::TextureCopyView copyView = utils::CreateTextureCopyView(texture, 0, 0, {0, 0, 0});
+    wgpu::TextureDataLayout dataLayout = MakeDataLayout(0, 0);
+    wgpu::Extent3D writeSize = {kWidth, kHeight, 1};
+    queue.WriteTexture(&copyView, data.data(), data.size() * sizeof(RGBA8), &dataLayout,
+                       &writeSize);
+
+    EXPECT_TEXTURE_RGBA8_EQ(data.data(), texture, 0, 0, kWidth, kHeight, 0, 0);
+}
+
+// Test writing a region at a non-zero origin.
+TEST_P(QueueWriteTextureTests, NonZeroOrigin) {
+    constexpr uint32_t kWidth = 16;
+    constexpr uint32_t kHeight = 16;
+    constexpr uint32_t kWriteWidth = 4;
+    constexpr uint32_t kWriteHeight = 6;
+    wgpu::Texture texture = Create2DTexture(kWidth, kHeight);
+
+    std::vector<RGBA8> data = MakeTexelData(kWriteWidth, kWriteHeight);
+    wgpu::TextureCopyView copyView = utils::CreateTextureCopyView(texture, 0, 0, {5, 7, 0});
+    wgpu::TextureDataLayout dataLayout = MakeDataLayout(0, kWriteWidth * kBytesPerTexel);
+    wgpu::Extent3D writeSize = {kWriteWidth, kWriteHeight, 1};
+    queue.WriteTexture(&copyView, data.data(), data.size() * sizeof(RGBA8), &dataLayout,
+                       &writeSize);
+
+    EXPECT_TEXTURE_RGBA8_EQ(data.data(), texture, 5, 7, kWriteWidth, kWriteHeight, 0, 0);
+}
+
+// Test that rows laid out with a stride larger than the row size are repacked correctly,
+// including strides that aren't a multiple of the texel size.
+TEST_P(QueueWriteTextureTests, BytesPerRowWithPadding) {
+    constexpr uint32_t kWidth = 8;
+    constexpr uint32_t kHeight = 4;
+    constexpr uint32_t kBytesPerRow = kWidth * kBytesPerTexel + 11;
+    wgpu::Texture texture = Create2DTexture(kWidth, kHeight);
+
+    std::vector<RGBA8> expected = MakeTexelData(kWidth, kHeight);
+    std::vector<uint8_t> data(kBytesPerRow * kHeight, 0xAB);
+    for (uint32_t y = 0; y < kHeight; ++y) {
+        memcpy(&data[y * kBytesPerRow], &expected[y * kWidth], kWidth * kBytesPerTexel);
+    }
+
+    wgpu::TextureCopyView copyView = utils::CreateTextureCopyView(texture, 0, 0, {0, 0, 0});
+    wgpu::TextureDataLayout dataLayout = MakeDataLayout(0, kBytesPerRow);
+    wgpu::Extent3D writeSize = {kWidth, kHeight, 1};
+    queue.WriteTexture(&copyView, data.data(), data.size(), &dataLayout, &writeSize);
+
+    EXPECT_TEXTURE_RGBA8_EQ(expected.data(), texture, 0, 0, kWidth, kHeight, 0, 0);
+}
+
+// Test that the write starts reading at the data offset.
+TEST_P(QueueWriteTextureTests, DataOffset) {
+    constexpr uint32_t kWidth = 4;
+    constexpr uint32_t kHeight = 4;
+    constexpr uint64_t kOffset = 128;
+    wgpu::Texture texture = Create2DTexture(kWidth, kHeight);
+
+    std::vector<RGBA8> expected = MakeTexelData(kWidth, kHeight);
+    std::vector<uint8_t> data(kOffset + expected.size() * sizeof(RGBA8), 0xCD);
+    memcpy(&data[kOffset], expected.data(), expected.size() * sizeof(RGBA8));
+
+    wgpu::TextureCopyView copyView = utils::CreateTextureCopyView(texture, 0, 0, {0, 0, 0});
+    wgpu::TextureDataLayout dataLayout = MakeDataLayout(kOffset, kWidth * kBytesPerTexel);
+    wgpu::Extent3D writeSize = {kWidth, kHeight, 1};
+    queue.WriteTexture(&copyView, data.data(), data.size(), &dataLayout, &writeSize);
+
+    EXPECT_TEXTURE_RGBA8_EQ(expected.data(), texture, 0, 0, kWidth, kHeight, 0, 0);
+}
+
+// Test that data too small to hold the write is an error.
+TEST_P(QueueWriteTextureTests, TooSmallDataIsError) {
+    constexpr uint32_t kWidth = 4;
+    constexpr uint32_t kHeight = 4;
+    wgpu::Texture texture = Create2DTexture(kWidth, kHeight);
+
+    std::vector<RGBA8> data = MakeTexelData(kWidth, kHeight);
+    wgpu::TextureCopyView copyView = utils::CreateTextureCopyView(texture, 0, 0, {0, 0, 0});
+    wgpu::TextureDataLayout dataLayout = MakeDataLayout(0, kWidth * kBytesPerTexel);
+    wgpu::Extent3D writeSize = {kWidth, kHeight, 1};
+    ASSERT_DEVICE_ERROR(queue.WriteTexture(&copyView, data.data(),
+                                           data.size() * sizeof(RGBA8) - 1, &dataLayout,
+                                           &writeSize));
+}
+
+DAWN_INSTANTIATE_TEST(QueueWriteTextureTests, D3D12Backend(), MetalBackend(), VulkanBackend());
+
+class QueueWriteTextureCompressedTests : public DawnTest {
+  protected:
+    std::vector<const char*> GetRequiredExtensions() override {
+        mIsBCFormatSupported = SupportsExtensions({"texture_compression_bc"});
+        if (!mIsBCFormatSupported) {
+            return {};
+        }
+
+        return {"texture_compression_bc"};
+    }
+
+    bool IsBCFormatSupported() const {
+        return mIsBCFormatSupported;
+    }
+
+    static constexpr uint32_t kBC1BlockSize = 8;
+
+    wgpu::Texture CreateBC1Texture(uint32_t width, uint32_t height) {
+        wgpu::TextureDescriptor descriptor;
+        descriptor.dimension = wgpu::TextureDimension::e2D;
+        descriptor.size = {width, height, 1};
+        descriptor.arrayLayerCount = 1;
+        descriptor.sampleCount = 1;
+        descriptor.format = wgpu::TextureFormat::BC1RGBAUnorm;
+        descriptor.mipLevelCount = 1;
+        descriptor.usage = wgpu::TextureUsage::CopyDst | wgpu::TextureUsage::CopySrc;
+        return device.CreateTexture(&descriptor);
+    }
+
+  private:
+    bool mIsBCFormatSupported = false;
+};
+
+// Test writing BC1 blocks with tightly packed block rows, reading them back through a
+// texture-to-buffer copy.
+TEST_P(QueueWriteTextureCompressedTests, WriteBC1) {
+    DAWN_SKIP_TEST_IF(!IsBCFormatSupported());
+
+    constexpr uint32_t kWidth = 8;
+    constexpr uint32_t kHeight = 8;
+    constexpr uint32_t kBlocksPerRow = kWidth / 4;
+    constexpr uint32_t kBlockRows = kHeight / 4;
+    wgpu::Texture texture = CreateBC1Texture(kWidth, kHeight);
+
+    std::vector<uint8_t> data(kBlocksPerRow * kBlockRows * kBC1BlockSize);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i % 256);
+    }
+
+    wgpu::TextureCopyView copyView = utils::CreateTextureCopyView(texture, 0, 0, {0, 0, 0});
+    wgpu::TextureDataLayout dataLayout;
+    dataLayout.offset = 0;
+    dataLayout.bytesPerRow = kBlocksPerRow * kBC1BlockSize;
+    dataLayout.rowsPerImage = 0;
+    wgpu::Extent3D writeSize = {kWidth, kHeight, 1};
+    queue.WriteTexture(&copyView, data.data(), data.size(), &dataLayout, &writeSize);
+
+    const uint32_t readBackBytesPerRow = kTextureBytesPerRowAlignment;
+    wgpu::BufferDescriptor bufferDescriptor;
+    bufferDescriptor.size =
+        readBackBytesPerRow * (kBlockRows - 1) + kBlocksPerRow * kBC1BlockSize;
+    bufferDescriptor.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+    wgpu::Buffer readBack = device.CreateBuffer(&bufferDescriptor);
+
+    wgpu::BufferCopyView bufferCopyView =
+        utils::CreateBufferCopyView(readBack, 0, readBackBytesPerRow, 0);
+    wgpu::Extent3D copySize = {kWidth, kHeight, 1};
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyTextureToBuffer(&copyView, &bufferCopyView, &copySize);
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    for (uint32_t blockRow = 0; blockRow < kBlockRows; ++blockRow) {
+        EXPECT_BUFFER_U32_RANGE_EQ(
+            reinterpret_cast<const uint32_t*>(&data[blockRow * kBlocksPerRow * kBC1BlockSize]),
+            readBack, blockRow * readBackBytesPerRow,
+            kBlocksPerRow * kBC1BlockSize / sizeof(uint32_t));
+    }
+}
+
+// Test that writes that aren't a multiple of the block size are errors.
+TEST_P(QueueWriteTextureCompressedTests, NonBlockAlignedWriteIsError) {
+    DAWN_SKIP_TEST_IF(!IsBCFormatSupported());
+
+    wgpu::Texture texture = CreateBC1Texture(8, 8);
+
+    std::vector<uint8_t> data(kBC1BlockSize);
+    wgpu::TextureCopyView copyView = utils::CreateTextureCopyView(texture, 0, 0, {0, 0, 0});
+    wgpu::TextureDataLayout dataLayout;
+    dataLayout.offset = 0;
+    dataLayout.bytesPerRow = 0;
+    dataLayout.rowsPerImage = 0;
+    wgpu::Extent3D writeSize = {2, 2, 1};
+    ASSERT_DEVICE_ERROR(
+        queue.WriteTexture(&copyView, data.data(), data.size(), &dataLayout, &writeSize));
+}
+
+DAWN_INSTANTIATE_TEST(QueueWriteTextureCompressedTests,
+                      D3D12Backend(),
+                      MetalBackend(),
+                      VulkanBackend());
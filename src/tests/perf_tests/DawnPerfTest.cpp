@@ -187,6 +187,10 @@ void DawnPerfTestBase::AbortTest() {
     mRunning = false;
 }
 
+dawn_platform::Platform* DawnPerfTestBase::GetPlatform() const {
+    return gTestEnv->GetPlatform();
+}
+
 void DawnPerfTestBase::RunTest() {
     if (gTestEnv->OverrideStepsToRun() == 0) {
         // Run to compute the approximate number of steps to perform.
@@ -17,6 +17,10 @@
 
 #include "tests/DawnTest.h"
 
+namespace dawn_platform {
+    class Platform;
+}  // namespace dawn_platform
+
 namespace utils {
     class Timer;
 }
@@ -74,6 +78,9 @@ class DawnPerfTestBase {
     // Call if the test step was aborted and the test should stop running.
     void AbortTest();
 
+    // The platform tests should emit their trace events to.
+    dawn_platform::Platform* GetPlatform() const;
+
     void RunTest();
     void PrintPerIterationResultFromSeconds(const std::string& trace,
                                             double valueInSeconds,
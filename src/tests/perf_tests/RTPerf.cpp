@@ -0,0 +1,502 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "tests/ParamGenerator.h"
+#include "utils/WGPUHelpers.h"
+
+#include <array>
+#include <vector>
+
+namespace {
+
+    // Numbers of triangles to build bottom-level containers from. Perf differences show up
+    // between small containers that are dominated by dispatch overhead and large ones that
+    // measure actual build throughput.
+    enum class TriangleCount {
+        Triangles_1k = 1 * 1024,
+        Triangles_16k = 16 * 1024,
+        Triangles_64k = 64 * 1024,
+    };
+
+    // Numbers of instances to refit top-level containers with.
+    enum class InstanceCount {
+        Instances_1 = 1,
+        Instances_64 = 64,
+        Instances_1024 = 1024,
+    };
+
+    // Generates a deterministic triangle soup so successive runs build identical containers.
+    std::vector<float> MakeTriangleVertices(uint32_t triangleCount) {
+        std::vector<float> vertices;
+        vertices.reserve(triangleCount * 9);
+
+        uint32_t seed = 1;
+        auto nextFloat = [&seed]() {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<float>(seed >> 16) / 65536.0f;
+        };
+
+        for (uint32_t i = 0; i < triangleCount; ++i) {
+            float cx = nextFloat() * 100.0f;
+            float cy = nextFloat() * 100.0f;
+            float cz = nextFloat() * 100.0f;
+            vertices.push_back(cx);
+            vertices.push_back(cy + 1.0f);
+            vertices.push_back(cz);
+            vertices.push_back(cx - 1.0f);
+            vertices.push_back(cy - 1.0f);
+            vertices.push_back(cz);
+            vertices.push_back(cx + 1.0f);
+            vertices.push_back(cy - 1.0f);
+            vertices.push_back(cz);
+        }
+        return vertices;
+    }
+
+    wgpu::Buffer MakeVertexBuffer(const wgpu::Device& device, const std::vector<float>& vertices) {
+        wgpu::BufferDescriptor descriptor = {};
+        descriptor.size = vertices.size() * sizeof(float);
+        descriptor.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::RayTracing;
+
+        wgpu::Buffer buffer = device.CreateBuffer(&descriptor);
+        buffer.SetSubData(0, vertices.size() * sizeof(float), vertices.data());
+        return buffer;
+    }
+
+    wgpu::RayTracingAccelerationContainer MakeGeometryContainer(
+        const wgpu::Device& device,
+        const wgpu::Buffer& vertexBuffer,
+        uint32_t vertexCount,
+        wgpu::RayTracingAccelerationContainerUsage usage) {
+        wgpu::RayTracingAccelerationGeometryVertexDescriptor vertexDescriptor = {};
+        vertexDescriptor.offset = 0;
+        vertexDescriptor.buffer = vertexBuffer;
+        vertexDescriptor.format = wgpu::VertexFormat::Float3;
+        vertexDescriptor.stride = 3 * sizeof(float);
+        vertexDescriptor.count = vertexCount;
+
+        wgpu::RayTracingAccelerationGeometryDescriptor geometry = {};
+        geometry.usage = wgpu::RayTracingAccelerationGeometryUsage::Opaque;
+        geometry.type = wgpu::RayTracingAccelerationGeometryType::Triangles;
+        geometry.vertex = &vertexDescriptor;
+
+        wgpu::RayTracingAccelerationContainerDescriptor descriptor = {};
+        descriptor.level = wgpu::RayTracingAccelerationContainerLevel::Bottom;
+        descriptor.usage = usage;
+        descriptor.geometryCount = 1;
+        descriptor.geometries = &geometry;
+
+        return device.CreateRayTracingAccelerationContainer(&descriptor);
+    }
+
+    void BuildContainer(const wgpu::Device& device,
+                        const wgpu::Queue& queue,
+                        const wgpu::RayTracingAccelerationContainer& container) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.BuildRayTracingAccelerationContainer(container);
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    struct BLASBuildParams : AdapterTestParam {
+        BLASBuildParams(const AdapterTestParam& param, TriangleCount triangleCount)
+            : AdapterTestParam(param), triangleCount(triangleCount) {
+        }
+
+        TriangleCount triangleCount;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const BLASBuildParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.triangleCount) {
+            case TriangleCount::Triangles_1k:
+                ostream << "_Triangles_1k";
+                break;
+            case TriangleCount::Triangles_16k:
+                ostream << "_Triangles_16k";
+                break;
+            case TriangleCount::Triangles_64k:
+                ostream << "_Triangles_64k";
+                break;
+        }
+        return ostream;
+    }
+
+    struct TLASUpdateParams : AdapterTestParam {
+        TLASUpdateParams(const AdapterTestParam& param, InstanceCount instanceCount)
+            : AdapterTestParam(param), instanceCount(instanceCount) {
+        }
+
+        InstanceCount instanceCount;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const TLASUpdateParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.instanceCount) {
+            case InstanceCount::Instances_1:
+                ostream << "_Instances_1";
+                break;
+            case InstanceCount::Instances_64:
+                ostream << "_Instances_64";
+                break;
+            case InstanceCount::Instances_1024:
+                ostream << "_Instances_1024";
+                break;
+        }
+        return ostream;
+    }
+
+}  // namespace
+
+// Measures bottom-level container build throughput: |kNumBuildsPerStep| rebuilds of the
+// same triangle soup per step, so triangles/s is triangles * builds / step time.
+class BLASBuildPerf : public DawnPerfTestWithParams<BLASBuildParams> {
+  public:
+    static constexpr unsigned int kNumBuildsPerStep = 10;
+
+    BLASBuildPerf() : DawnPerfTestWithParams(kNumBuildsPerStep, 1) {
+    }
+    ~BLASBuildPerf() override = default;
+
+    void SetUp() override;
+
+  protected:
+    std::vector<const char*> GetRequiredExtensions() override {
+        mIsRayTracingSupported = SupportsExtensions({"ray_tracing"});
+        if (!mIsRayTracingSupported) {
+            return {};
+        }
+        return {"ray_tracing"};
+    }
+
+  private:
+    void Step() override;
+
+    bool mIsRayTracingSupported = false;
+    wgpu::Buffer mVertexBuffer;
+    wgpu::RayTracingAccelerationContainer mContainer;
+};
+
+void BLASBuildPerf::SetUp() {
+    DawnPerfTestWithParams<BLASBuildParams>::SetUp();
+    DAWN_SKIP_TEST_IF(!mIsRayTracingSupported);
+
+    const uint32_t triangleCount = static_cast<uint32_t>(GetParam().triangleCount);
+    std::vector<float> vertices = MakeTriangleVertices(triangleCount);
+    mVertexBuffer = MakeVertexBuffer(device, vertices);
+
+    mContainer =
+        MakeGeometryContainer(device, mVertexBuffer, triangleCount * 3,
+                              wgpu::RayTracingAccelerationContainerUsage::PreferFastBuild);
+}
+
+void BLASBuildPerf::Step() {
+    for (unsigned int i = 0; i < kNumBuildsPerStep; ++i) {
+        BuildContainer(device, queue, mContainer);
+    }
+}
+
+TEST_P(BLASBuildPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(BLASBuildPerf,
+                                   {D3D12Backend(), MetalBackend(), VulkanBackend()},
+                                   {TriangleCount::Triangles_1k, TriangleCount::Triangles_16k,
+                                    TriangleCount::Triangles_64k});
+
+// Measures top-level container refit latency: the instance transforms move a little every
+// step and the container is updated in place rather than rebuilt.
+class TLASUpdatePerf : public DawnPerfTestWithParams<TLASUpdateParams> {
+  public:
+    TLASUpdatePerf() : DawnPerfTestWithParams(1, 1) {
+    }
+    ~TLASUpdatePerf() override = default;
+
+    void SetUp() override;
+
+  protected:
+    std::vector<const char*> GetRequiredExtensions() override {
+        mIsRayTracingSupported = SupportsExtensions({"ray_tracing"});
+        if (!mIsRayTracingSupported) {
+            return {};
+        }
+        return {"ray_tracing"};
+    }
+
+  private:
+    void Step() override;
+
+    bool mIsRayTracingSupported = false;
+    uint32_t mInstanceCount = 0;
+    uint32_t mStepIndex = 0;
+    wgpu::Buffer mVertexBuffer;
+    wgpu::RayTracingAccelerationContainer mGeometryContainer;
+    wgpu::RayTracingAccelerationContainer mInstanceContainer;
+    std::vector<std::array<float, 12>> mTransformMatrices;
+    std::vector<wgpu::RayTracingAccelerationInstanceDescriptor> mInstances;
+};
+
+void TLASUpdatePerf::SetUp() {
+    DawnPerfTestWithParams<TLASUpdateParams>::SetUp();
+    DAWN_SKIP_TEST_IF(!mIsRayTracingSupported);
+
+    constexpr uint32_t kTrianglesPerBLAS = 64;
+    std::vector<float> vertices = MakeTriangleVertices(kTrianglesPerBLAS);
+    mVertexBuffer = MakeVertexBuffer(device, vertices);
+
+    mGeometryContainer =
+        MakeGeometryContainer(device, mVertexBuffer, kTrianglesPerBLAS * 3,
+                              wgpu::RayTracingAccelerationContainerUsage::PreferFastTrace);
+    BuildContainer(device, queue, mGeometryContainer);
+
+    mInstanceCount = static_cast<uint32_t>(GetParam().instanceCount);
+    mTransformMatrices.resize(mInstanceCount);
+    mInstances.resize(mInstanceCount);
+    for (uint32_t i = 0; i < mInstanceCount; ++i) {
+        mTransformMatrices[i] = {1.0f, 0.0f, 0.0f, static_cast<float>(i),  //
+                                 0.0f, 1.0f, 0.0f, 0.0f,                   //
+                                 0.0f, 0.0f, 1.0f, 0.0f};
+
+        wgpu::RayTracingAccelerationInstanceDescriptor& instance = mInstances[i];
+        instance = {};
+        instance.instanceId = i;
+        instance.mask = 0xFF;
+        instance.transformMatrix = mTransformMatrices[i].data();
+        instance.transformMatrixSize = 12;
+        instance.geometryContainer = mGeometryContainer;
+    }
+
+    wgpu::RayTracingAccelerationContainerDescriptor descriptor = {};
+    descriptor.level = wgpu::RayTracingAccelerationContainerLevel::Top;
+    descriptor.usage = wgpu::RayTracingAccelerationContainerUsage::AllowUpdate;
+    descriptor.instanceCount = mInstanceCount;
+    descriptor.instances = mInstances.data();
+
+    mInstanceContainer = device.CreateRayTracingAccelerationContainer(&descriptor);
+    BuildContainer(device, queue, mInstanceContainer);
+}
+
+void TLASUpdatePerf::Step() {
+    // Move every instance a little so the refit isn't a no-op for the driver.
+    mStepIndex++;
+    const float offset = static_cast<float>(mStepIndex % 16);
+    for (uint32_t i = 0; i < mInstanceCount; ++i) {
+        mTransformMatrices[i][7] = offset;
+    }
+    mInstanceContainer.UpdateInstances(0, mInstanceCount, mInstances.data());
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.UpdateRayTracingAccelerationContainer(mInstanceContainer);
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+}
+
+TEST_P(TLASUpdatePerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(TLASUpdatePerf,
+                                   {D3D12Backend(), MetalBackend(), VulkanBackend()},
+                                   {InstanceCount::Instances_1, InstanceCount::Instances_64,
+                                    InstanceCount::Instances_1024});
+
+// Measures TraceRays dispatch overhead: |kNumTraceIterations| small dispatches against a
+// single-triangle scene so the cost measured is the dispatch, not the rays.
+class TraceRaysPerf : public DawnPerfTestWithParams<> {
+  public:
+    static constexpr unsigned int kNumTraceIterations = 50;
+    static constexpr uint32_t kRayDispatchSize = 64;
+
+    TraceRaysPerf() : DawnPerfTestWithParams(kNumTraceIterations, 1) {
+    }
+    ~TraceRaysPerf() override = default;
+
+    void SetUp() override;
+
+  protected:
+    std::vector<const char*> GetRequiredExtensions() override {
+        mIsRayTracingSupported = SupportsExtensions({"ray_tracing"});
+        if (!mIsRayTracingSupported) {
+            return {};
+        }
+        return {"ray_tracing"};
+    }
+
+  private:
+    void Step() override;
+
+    bool mIsRayTracingSupported = false;
+    wgpu::Buffer mVertexBuffer;
+    wgpu::Buffer mPixelBuffer;
+    wgpu::RayTracingAccelerationContainer mGeometryContainer;
+    wgpu::RayTracingAccelerationContainer mInstanceContainer;
+    wgpu::RayTracingPipeline mPipeline;
+    wgpu::BindGroup mBindGroup;
+};
+
+void TraceRaysPerf::SetUp() {
+    DawnPerfTestWithParams<>::SetUp();
+    DAWN_SKIP_TEST_IF(!mIsRayTracingSupported);
+
+    std::vector<float> vertices = MakeTriangleVertices(1);
+    mVertexBuffer = MakeVertexBuffer(device, vertices);
+
+    mGeometryContainer =
+        MakeGeometryContainer(device, mVertexBuffer, 3,
+                              wgpu::RayTracingAccelerationContainerUsage::PreferFastTrace);
+    BuildContainer(device, queue, mGeometryContainer);
+
+    wgpu::RayTracingAccelerationInstanceDescriptor instance = {};
+    instance.mask = 0xFF;
+    instance.geometryContainer = mGeometryContainer;
+
+    wgpu::RayTracingAccelerationContainerDescriptor containerDescriptor = {};
+    containerDescriptor.level = wgpu::RayTracingAccelerationContainerLevel::Top;
+    containerDescriptor.usage = wgpu::RayTracingAccelerationContainerUsage::PreferFastTrace;
+    containerDescriptor.instanceCount = 1;
+    containerDescriptor.instances = &instance;
+
+    mInstanceContainer = device.CreateRayTracingAccelerationContainer(&containerDescriptor);
+    BuildContainer(device, queue, mInstanceContainer);
+
+    wgpu::BufferDescriptor pixelBufferDescriptor = {};
+    pixelBufferDescriptor.size = kRayDispatchSize * kRayDispatchSize * 4 * sizeof(float);
+    pixelBufferDescriptor.usage = wgpu::BufferUsage::Storage;
+    mPixelBuffer = device.CreateBuffer(&pixelBufferDescriptor);
+
+    wgpu::ShaderModule rayGenModule =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::RayGeneration, R"(
+        #version 460
+        #extension GL_EXT_ray_tracing : require
+
+        layout(location = 0) rayPayloadEXT vec3 payload;
+
+        layout(set = 0, binding = 0) uniform accelerationStructureEXT container;
+        layout(set = 0, binding = 1, std140) buffer PixelBuffer {
+            vec4 pixels[];
+        } pixelBuffer;
+
+        void main() {
+            const vec2 uv = (vec2(gl_LaunchIDEXT.xy) + vec2(0.5)) / vec2(gl_LaunchSizeEXT.xy);
+            const vec2 d = uv * 2.0 - 1.0;
+            const vec3 origin = vec3(0, 0, -1.5);
+            const vec3 direction = normalize(vec3(d.x, d.y, 1));
+            payload = vec3(0);
+            traceRayEXT(container, gl_RayFlagsOpaqueEXT, 0xff, 0, 0, 0, origin, 0.001,
+                        direction, 100.0, 0);
+            const uint pixelIndex = gl_LaunchIDEXT.y * gl_LaunchSizeEXT.x + gl_LaunchIDEXT.x;
+            pixelBuffer.pixels[pixelIndex] = vec4(payload, 1.0);
+        }
+    )");
+
+    wgpu::ShaderModule rayCHitModule =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::RayClosestHit, R"(
+        #version 460
+        #extension GL_EXT_ray_tracing : enable
+
+        layout(location = 0) rayPayloadInEXT vec3 payload;
+
+        void main() {
+            payload = vec3(1.0);
+        }
+    )");
+
+    wgpu::ShaderModule rayMissModule =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::RayMiss, R"(
+        #version 460
+        #extension GL_EXT_ray_tracing : enable
+
+        layout(location = 0) rayPayloadInEXT vec3 payload;
+
+        void main() {
+            payload = vec3(0.0);
+        }
+    )");
+
+    std::array<wgpu::RayTracingShaderBindingTableStageDescriptor, 3> stages;
+    stages[0] = {};
+    stages[0].stage = wgpu::ShaderStage::RayGeneration;
+    stages[0].module = rayGenModule;
+    stages[1] = {};
+    stages[1].stage = wgpu::ShaderStage::RayClosestHit;
+    stages[1].module = rayCHitModule;
+    stages[2] = {};
+    stages[2].stage = wgpu::ShaderStage::RayMiss;
+    stages[2].module = rayMissModule;
+
+    std::array<wgpu::RayTracingShaderBindingTableGroupDescriptor, 3> groups;
+    groups[0] = {};
+    groups[0].type = wgpu::RayTracingShaderBindingTableGroupType::General;
+    groups[0].generalIndex = 0;
+    groups[1] = {};
+    groups[1].type = wgpu::RayTracingShaderBindingTableGroupType::TrianglesHitGroup;
+    groups[1].closestHitIndex = 1;
+    groups[2] = {};
+    groups[2].type = wgpu::RayTracingShaderBindingTableGroupType::General;
+    groups[2].generalIndex = 2;
+
+    wgpu::RayTracingShaderBindingTableDescriptor sbtDescriptor = {};
+    sbtDescriptor.stageCount = stages.size();
+    sbtDescriptor.stages = stages.data();
+    sbtDescriptor.groupCount = groups.size();
+    sbtDescriptor.groups = groups.data();
+    wgpu::RayTracingShaderBindingTable sbt =
+        device.CreateRayTracingShaderBindingTable(&sbtDescriptor);
+
+    wgpu::BindGroupLayout bindGroupLayout = utils::MakeBindGroupLayout(
+        device, {
+                    {0, wgpu::ShaderStage::RayGeneration, wgpu::BindingType::AccelerationContainer},
+                    {1, wgpu::ShaderStage::RayGeneration, wgpu::BindingType::StorageBuffer},
+                });
+
+    mBindGroup = utils::MakeBindGroup(device, bindGroupLayout,
+                                      {{0, mInstanceContainer},
+                                       {1, mPixelBuffer, 0, pixelBufferDescriptor.size}});
+
+    wgpu::RayTracingStateDescriptor rayTracingState = {};
+    rayTracingState.maxRecursionDepth = 1;
+    rayTracingState.maxPayloadSize = 3 * sizeof(float);
+    rayTracingState.shaderBindingTable = sbt;
+
+    wgpu::RayTracingPipelineDescriptor pipelineDescriptor = {};
+    pipelineDescriptor.layout = utils::MakeBasicPipelineLayout(device, &bindGroupLayout);
+    pipelineDescriptor.rayTracingState = &rayTracingState;
+    mPipeline = device.CreateRayTracingPipeline(&pipelineDescriptor);
+}
+
+void TraceRaysPerf::Step() {
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RayTracingPassDescriptor passDescriptor = {};
+    wgpu::RayTracingPassEncoder pass = encoder.BeginRayTracingPass(&passDescriptor);
+    pass.SetPipeline(mPipeline);
+    pass.SetBindGroup(0, mBindGroup);
+    for (unsigned int i = 0; i < kNumTraceIterations; ++i) {
+        pass.TraceRays(0, 1, 2, kRayDispatchSize, kRayDispatchSize, 1);
+    }
+    pass.EndPass();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+}
+
+TEST_P(TraceRaysPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(TraceRaysPerf,
+                                   {D3D12Backend(), MetalBackend(), VulkanBackend()});
@@ -0,0 +1,147 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_platform/tracing/TraceEvent.h"
+#include "dawn_wire/WireClient.h"
+#include "dawn_wire/WireServer.h"
+#include "tests/ParamGenerator.h"
+#include "utils/TerribleCommandBuffer.h"
+
+namespace {
+
+    // The workload is object churn: each iteration creates a command encoder, finishes it,
+    // and releases both objects. Natively these are four cheap frontend calls; over the wire
+    // each one is serialized, copied through the loopback buffer, and replayed by the server.
+    constexpr unsigned int kNumCommandsPerStep = 1000;
+
+    enum class Transport {
+        Native,  // Call the dawn_native procs directly.
+        Wire,    // Go through WireClient/WireServer with a loopback serializer.
+    };
+
+    struct WireOverheadParams : AdapterTestParam {
+        WireOverheadParams(const AdapterTestParam& param, Transport transport)
+            : AdapterTestParam(param), transport(transport) {
+        }
+
+        Transport transport;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const WireOverheadParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.transport) {
+            case Transport::Native:
+                ostream << "_Native";
+                break;
+            case Transport::Wire:
+                ostream << "_Wire";
+                break;
+        }
+        return ostream;
+    }
+
+}  // anonymous namespace
+
+// WireOverheadPerf measures the CPU cost dawn_wire adds on top of dawn_native. Both
+// transports issue the exact same workload through explicit proc tables against the same
+// backend device, so the difference between the _Native and _Wire variants is the
+// per-command serialization and replay cost. The wire variant flushes the loopback buffers
+// once per step inside trace events so flush latency shows up in the trace output
+// (see DawnPerfTestPlatform).
+class WireOverheadPerf : public DawnPerfTestWithParams<WireOverheadParams> {
+  public:
+    WireOverheadPerf() : DawnPerfTestWithParams(kNumCommandsPerStep, 1) {
+    }
+    ~WireOverheadPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    // The device and procs the workload is issued against. These are separate from the
+    // |device| the harness created so the test controls its own wire.
+    DawnProcTable mWorkloadProcs = {};
+    WGPUDevice mWorkloadDevice = nullptr;
+
+    std::unique_ptr<utils::TerribleCommandBuffer> mC2sBuf;
+    std::unique_ptr<utils::TerribleCommandBuffer> mS2cBuf;
+    std::unique_ptr<dawn_wire::WireServer> mWireServer;
+    std::unique_ptr<dawn_wire::WireClient> mWireClient;
+};
+
+void WireOverheadPerf::SetUp() {
+    DawnPerfTestWithParams::SetUp();
+
+    switch (GetParam().transport) {
+        case Transport::Native:
+            mWorkloadProcs = backendProcs;
+            mWorkloadDevice = backendDevice;
+            break;
+
+        case Transport::Wire: {
+            mC2sBuf = std::make_unique<utils::TerribleCommandBuffer>();
+            mS2cBuf = std::make_unique<utils::TerribleCommandBuffer>();
+
+            dawn_wire::WireServerDescriptor serverDesc = {};
+            serverDesc.device = backendDevice;
+            serverDesc.procs = &backendProcs;
+            serverDesc.serializer = mS2cBuf.get();
+            mWireServer = std::make_unique<dawn_wire::WireServer>(serverDesc);
+            mC2sBuf->SetHandler(mWireServer.get());
+
+            dawn_wire::WireClientDescriptor clientDesc = {};
+            clientDesc.serializer = mC2sBuf.get();
+            mWireClient = std::make_unique<dawn_wire::WireClient>(clientDesc);
+            mS2cBuf->SetHandler(mWireClient.get());
+
+            mWorkloadProcs = dawn_wire::WireClient::GetProcs();
+            mWorkloadDevice = mWireClient->GetDevice();
+            break;
+        }
+    }
+}
+
+void WireOverheadPerf::Step() {
+    for (unsigned int i = 0; i < kNumCommandsPerStep; ++i) {
+        WGPUCommandEncoder encoder =
+            mWorkloadProcs.deviceCreateCommandEncoder(mWorkloadDevice, nullptr);
+        WGPUCommandBuffer commands = mWorkloadProcs.commandEncoderFinish(encoder, nullptr);
+        mWorkloadProcs.commandEncoderRelease(encoder);
+        mWorkloadProcs.commandBufferRelease(commands);
+    }
+
+    if (GetParam().transport == Transport::Wire) {
+        {
+            TRACE_EVENT0(GetPlatform(), General, "WireOverheadPerf::FlushClient");
+            mC2sBuf->Flush();
+        }
+        {
+            TRACE_EVENT0(GetPlatform(), General, "WireOverheadPerf::FlushServer");
+            mS2cBuf->Flush();
+        }
+    }
+}
+
+TEST_P(WireOverheadPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(WireOverheadPerf,
+                                   {D3D12Backend(), MetalBackend(), OpenGLBackend(),
+                                    VulkanBackend()},
+                                   {Transport::Native, Transport::Wire});
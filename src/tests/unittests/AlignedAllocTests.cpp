@@ -0,0 +1,56 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "common/AlignedAlloc.h"
+#include "common/Math.h"
+
+#include <cstring>
+
+// Tests that allocations are aligned as requested and usable for their full size.
+TEST(AlignedAlloc, Alignment) {
+    for (size_t alignment : {size_t(1), size_t(8), size_t(64), size_t(4096)}) {
+        void* ptr = AlignedAlloc(1024, alignment);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_TRUE(IsPtrAligned(ptr, alignment));
+        memset(ptr, 0xAB, 1024);
+        AlignedFree(ptr);
+    }
+}
+
+// Tests that freeing nullptr is a no-op.
+TEST(AlignedAlloc, FreeNullptr) {
+    AlignedFree(nullptr);
+}
+
+// Tests that a large page request still yields a usable, large-page-aligned block even
+// when the platform cannot provide large pages.
+TEST(AlignedAlloc, LargePages) {
+    void* ptr = AlignedAlloc(kLargePageSize + 1, 64, true);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_TRUE(IsPtrAligned(ptr, kLargePageSize));
+    // The size is rounded up to a whole number of large pages, so the tail past the
+    // requested size must be writable too.
+    memset(ptr, 0xAB, 2 * kLargePageSize);
+    AlignedFree(ptr);
+}
+
+// Tests that a small allocation ignores the large page request.
+TEST(AlignedAlloc, LargePagesSmallAllocation) {
+    void* ptr = AlignedAlloc(64, 64, true);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_TRUE(IsPtrAligned(ptr, 64));
+    AlignedFree(ptr);
+}
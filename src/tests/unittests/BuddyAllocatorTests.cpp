@@ -324,4 +324,44 @@ TEST(BuddyAllocatorTests, VariousSizeSameAlignment) {
     ASSERT_EQ(allocator.Allocate(16, alignment), 16ull);
 
     ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 0u);
-}
\ No newline at end of file
+}
+// Verify the allocator statistics stay consistent through allocation and deallocation.
+TEST(BuddyAllocatorTests, Statistics) {
+    //  After one 8 byte allocation:
+    //
+    //  Level          --------------------------------
+    //      0       32 |               S              |
+    //                 --------------------------------
+    //      1       16 |       S       |       F      |       S - split
+    //                 --------------------------------       F - free
+    //      2       8  |   A   |   F   |              |       A - allocated
+    //                 --------------------------------
+    //
+    constexpr uint64_t maxBlockSize = 32;
+    BuddyAllocator allocator(maxBlockSize);
+
+    // Empty allocator: one free block spanning the whole heap.
+    BuddyAllocator::Statistics statistics = allocator.GetStatistics();
+    ASSERT_EQ(statistics.freeSize, maxBlockSize);
+    ASSERT_EQ(statistics.allocatedSize, 0u);
+    ASSERT_EQ(statistics.freeBlockCount, 1u);
+    ASSERT_EQ(statistics.largestFreeBlockSize, maxBlockSize);
+
+    uint64_t blockOffset = allocator.Allocate(8);
+    ASSERT_EQ(blockOffset, 0u);
+
+    statistics = allocator.GetStatistics();
+    ASSERT_EQ(statistics.freeSize, 24u);
+    ASSERT_EQ(statistics.allocatedSize, 8u);
+    ASSERT_EQ(statistics.freeBlockCount, 2u);
+    ASSERT_EQ(statistics.largestFreeBlockSize, 16u);
+
+    // Deallocating merges everything back into a single free block.
+    allocator.Deallocate(blockOffset);
+
+    statistics = allocator.GetStatistics();
+    ASSERT_EQ(statistics.freeSize, maxBlockSize);
+    ASSERT_EQ(statistics.allocatedSize, 0u);
+    ASSERT_EQ(statistics.freeBlockCount, 1u);
+    ASSERT_EQ(statistics.largestFreeBlockSize, maxBlockSize);
+}
@@ -0,0 +1,157 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "common/ConcurrentSerialQueue.h"
+
+using TestConcurrentSerialQueue = ConcurrentSerialQueue<int>;
+
+// A number of basic tests for ConcurrentSerialQueue that are difficult to split from one another
+TEST(ConcurrentSerialQueue, BasicTest) {
+    TestConcurrentSerialQueue queue;
+
+    // Queue starts empty
+    ASSERT_TRUE(queue.Empty());
+
+    // Iterating on empty queue 1) works 2) doesn't produce any values
+    for (int value : queue.IterateAll()) {
+        DAWN_UNUSED(value);
+        ASSERT_TRUE(false);
+    }
+
+    // Enqueuing values as const ref or rvalue ref
+    queue.Enqueue(1, 0);
+    queue.Enqueue(2, 0);
+    queue.Enqueue(std::move(3), 1);
+
+    // Iterating over a non-empty queue produces the expected result
+    std::vector<int> expectedValues = {1, 2, 3};
+    for (int value : queue.IterateAll()) {
+        EXPECT_EQ(expectedValues.front(), value);
+        ASSERT_FALSE(expectedValues.empty());
+        expectedValues.erase(expectedValues.begin());
+    }
+    ASSERT_TRUE(expectedValues.empty());
+
+    // Clear works and makes the queue empty and iteration does nothing.
+    queue.Clear();
+    ASSERT_TRUE(queue.Empty());
+
+    for (int value : queue.IterateAll()) {
+        DAWN_UNUSED(value);
+        ASSERT_TRUE(false);
+    }
+}
+
+// Test IterateUpTo and ClearUpTo affect values up to and including the given serial
+TEST(ConcurrentSerialQueue, UpTo) {
+    TestConcurrentSerialQueue queue;
+    queue.Enqueue(1, 0);
+    queue.Enqueue(2, 1);
+    queue.Enqueue(3, 2);
+
+    std::vector<int> expectedValues = {1, 2};
+    for (int value : queue.IterateUpTo(1)) {
+        EXPECT_EQ(expectedValues.front(), value);
+        ASSERT_FALSE(expectedValues.empty());
+        expectedValues.erase(expectedValues.begin());
+    }
+    ASSERT_TRUE(expectedValues.empty());
+
+    queue.ClearUpTo(1);
+    ASSERT_FALSE(queue.Empty());
+
+    expectedValues = {3};
+    for (int value : queue.IterateAll()) {
+        EXPECT_EQ(expectedValues.front(), value);
+        ASSERT_FALSE(expectedValues.empty());
+        expectedValues.erase(expectedValues.begin());
+    }
+    ASSERT_TRUE(expectedValues.empty());
+}
+
+// Test values enqueued out of serial order are seen in serial order when iterating
+TEST(ConcurrentSerialQueue, OutOfOrderEnqueue) {
+    TestConcurrentSerialQueue queue;
+
+    queue.Enqueue(3, 2);
+    queue.Enqueue(1, 0);
+    queue.Enqueue(2, 1);
+
+    std::vector<int> expectedValues = {1, 2, 3};
+    for (int value : queue.IterateAll()) {
+        EXPECT_EQ(expectedValues.front(), value);
+        ASSERT_FALSE(expectedValues.empty());
+        expectedValues.erase(expectedValues.begin());
+    }
+    ASSERT_TRUE(expectedValues.empty());
+}
+
+// Test a value that arrives with a serial smaller than already-iterated values is promoted
+// instead of lost
+TEST(ConcurrentSerialQueue, LateEnqueueIsPromoted) {
+    TestConcurrentSerialQueue queue;
+
+    queue.Enqueue(1, 5);
+    for (int value : queue.IterateUpTo(5)) {
+        EXPECT_EQ(1, value);
+    }
+
+    // This value is late: serial 3 was already surfaced by the previous iteration.
+    queue.Enqueue(2, 3);
+    queue.ClearUpTo(5);
+
+    std::vector<int> expectedValues = {2};
+    for (int value : queue.IterateAll()) {
+        EXPECT_EQ(expectedValues.front(), value);
+        ASSERT_FALSE(expectedValues.empty());
+        expectedValues.erase(expectedValues.begin());
+    }
+    ASSERT_TRUE(expectedValues.empty());
+}
+
+// Test enqueuing from many threads concurrently delivers every value exactly once
+TEST(ConcurrentSerialQueue, ConcurrentEnqueue) {
+    static constexpr int kThreads = 4;
+    static constexpr int kValuesPerThread = 1000;
+
+    TestConcurrentSerialQueue queue;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&queue, t] {
+            for (int i = 0; i < kValuesPerThread; ++i) {
+                queue.Enqueue(t * kValuesPerThread + i, i);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<bool> seen(kThreads * kValuesPerThread, false);
+    int count = 0;
+    for (int value : queue.IterateAll()) {
+        ASSERT_FALSE(seen[value]);
+        seen[value] = true;
+        count++;
+    }
+    ASSERT_EQ(kThreads * kValuesPerThread, count);
+
+    queue.Clear();
+    ASSERT_TRUE(queue.Empty());
+}
@@ -14,6 +14,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "dawn_native/Error.h"
 #include "dawn_native/ErrorData.h"
 
@@ -295,4 +297,36 @@ TEST(ErrorTests, TRY_ConversionToErrorOrResultNonPointer) {
     ASSERT_EQ(errorData->GetMessage(), dummyErrorMessage);
 }
 
+// Check an error message built from a std::string is preserved.
+TEST(ErrorTests, Error_StringMessage) {
+    auto ReturnError = []() -> MaybeError {
+        return DAWN_VALIDATION_ERROR(std::string("I am ") + "an error message :3");
+    };
+
+    MaybeError result = ReturnError();
+    ASSERT_TRUE(result.IsError());
+
+    std::unique_ptr<ErrorData> errorData = result.AcquireError();
+    ASSERT_EQ(errorData->GetMessage(), dummyErrorMessage);
+}
+
+// Check that many errors can be live at once; exercises the ErrorData slab and its heap
+// fallback.
+TEST(ErrorTests, Error_ManyLiveErrors) {
+    auto ReturnError = []() -> MaybeError {
+        return DAWN_VALIDATION_ERROR(dummyErrorMessage);
+    };
+
+    std::vector<std::unique_ptr<ErrorData>> errors;
+    for (int i = 0; i < 100; ++i) {
+        MaybeError result = ReturnError();
+        ASSERT_TRUE(result.IsError());
+        errors.push_back(result.AcquireError());
+    }
+
+    for (const std::unique_ptr<ErrorData>& errorData : errors) {
+        ASSERT_EQ(errorData->GetMessage(), dummyErrorMessage);
+    }
+}
+
 }  // anonymous namespace
@@ -144,6 +144,35 @@ TEST(SerialQueue, FirstSerial) {
     EXPECT_EQ(queue.FirstSerial(), 6u);
 }
 
+// Test that enqueuing after a partial clear works: cleared entries are retained
+// internally for reuse and must not be visible.
+TEST(SerialQueue, ClearUpToThenEnqueue) {
+    TestSerialQueue queue;
+
+    queue.Enqueue(1, 0);
+    queue.Enqueue(2, 1);
+    queue.ClearUpTo(0);
+    queue.Enqueue(3, 2);
+
+    EXPECT_EQ(queue.FirstSerial(), 1u);
+    EXPECT_EQ(queue.LastSerial(), 2u);
+
+    std::vector<int> expectedValues = {2, 3};
+    for (int value : queue.IterateAll()) {
+        EXPECT_EQ(expectedValues.front(), value);
+        ASSERT_FALSE(expectedValues.empty());
+        expectedValues.erase(expectedValues.begin());
+    }
+    ASSERT_TRUE(expectedValues.empty());
+
+    queue.ClearUpTo(2);
+    ASSERT_TRUE(queue.Empty());
+
+    queue.Enqueue(4, 3);
+    EXPECT_EQ(queue.FirstSerial(), 3u);
+    EXPECT_EQ(queue.LastSerial(), 3u);
+}
+
 // Test LastSerial
 TEST(SerialQueue, LastSerial) {
     TestSerialQueue queue;
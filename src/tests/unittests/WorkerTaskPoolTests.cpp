@@ -0,0 +1,134 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_platform/DawnPlatform.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+    class TestPlatform : public dawn_platform::Platform {
+      public:
+        const unsigned char* GetTraceCategoryEnabledFlag(
+            dawn_platform::TraceCategory category) override {
+            static unsigned char disabled = 0;
+            return &disabled;
+        }
+
+        double MonotonicallyIncreasingTime() override {
+            return 0.0;
+        }
+
+        uint64_t AddTraceEvent(char phase,
+                               const unsigned char* categoryGroupEnabled,
+                               const char* name,
+                               uint64_t id,
+                               double timestamp,
+                               int numArgs,
+                               const char** argNames,
+                               const unsigned char* argTypes,
+                               const uint64_t* argValues,
+                               unsigned char flags) override {
+            return 0;
+        }
+    };
+
+    // Helper to block until a posted task has run.
+    struct TaskTracker {
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool ran = false;
+
+        static void Run(void* userdata) {
+            TaskTracker* tracker = static_cast<TaskTracker*>(userdata);
+            std::lock_guard<std::mutex> lock(tracker->mutex);
+            tracker->ran = true;
+            tracker->condition.notify_one();
+        }
+
+        void Wait() {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return ran; });
+        }
+    };
+
+}  // anonymous namespace
+
+// Test that a posted task eventually runs.
+TEST(WorkerTaskPoolTests, PostWorkerTask) {
+    TestPlatform platform;
+    dawn_platform::WorkerTaskPool* pool = platform.GetWorkerTaskPool();
+    ASSERT_NE(pool, nullptr);
+
+    TaskTracker tracker;
+    pool->PostWorkerTask(TaskTracker::Run, &tracker);
+    tracker.Wait();
+}
+
+// Test that a delayed task runs, and no earlier than its delay.
+TEST(WorkerTaskPoolTests, PostDelayedWorkerTask) {
+    TestPlatform platform;
+    dawn_platform::WorkerTaskPool* pool = platform.GetWorkerTaskPool();
+
+    constexpr uint64_t kDelayMs = 10;
+    auto postTime = std::chrono::steady_clock::now();
+
+    TaskTracker tracker;
+    pool->PostDelayedWorkerTask(TaskTracker::Run, &tracker, kDelayMs);
+    tracker.Wait();
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - postTime);
+    ASSERT_GE(static_cast<uint64_t>(elapsed.count()), kDelayMs);
+}
+
+// Test that ParallelFor visits every index exactly once.
+TEST(WorkerTaskPoolTests, ParallelForVisitsEveryIndexOnce) {
+    TestPlatform platform;
+    dawn_platform::WorkerTaskPool* pool = platform.GetWorkerTaskPool();
+
+    constexpr uint32_t kIterationCount = 1000;
+    std::vector<std::atomic<uint32_t>> visitCounts(kIterationCount);
+    for (auto& count : visitCounts) {
+        count = 0;
+    }
+
+    pool->ParallelFor(
+        kIterationCount,
+        [](void* userdata, uint32_t index) {
+            auto* counts = static_cast<std::vector<std::atomic<uint32_t>>*>(userdata);
+            (*counts)[index]++;
+        },
+        &visitCounts);
+
+    for (uint32_t i = 0; i < kIterationCount; ++i) {
+        ASSERT_EQ(visitCounts[i], 1u);
+    }
+}
+
+// Test that a ParallelFor over zero iterations returns without calling anything.
+TEST(WorkerTaskPoolTests, ParallelForZeroIterations) {
+    TestPlatform platform;
+    dawn_platform::WorkerTaskPool* pool = platform.GetWorkerTaskPool();
+
+    pool->ParallelFor(
+        0, [](void* userdata, uint32_t index) { FAIL() << "Callback should not be called"; },
+        nullptr);
+}
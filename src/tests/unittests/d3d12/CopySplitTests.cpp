@@ -454,3 +454,63 @@ TEST_F(CopySplitTest, ImageHeight) {
         }
     }
 }
+
+TEST_F(CopySplitTest, MipChain) {
+    struct MipChainSpec {
+        uint32_t width;
+        uint32_t height;
+        uint32_t texelBlockSizeInBytes;
+        uint32_t blockWidth = 1;
+        uint32_t blockHeight = 1;
+    };
+    constexpr MipChainSpec kSpecs[] = {
+        {1, 1, 4},
+        {256, 256, 4},
+        {4096, 4096, 4},
+        {4096, 4096, 16},
+        {257, 31, 4},
+        {1024, 1024, 8, 4, 4},
+        {1024, 1024, 16, 4, 4},
+    };
+
+    for (const MipChainSpec& spec : kSpecs) {
+        uint32_t levelCount = Log2(std::max(spec.width, spec.height)) + 1;
+
+        dawn_native::Format fakeFormat = {};
+        fakeFormat.blockWidth = spec.blockWidth;
+        fakeFormat.blockHeight = spec.blockHeight;
+        fakeFormat.blockByteSize = spec.texelBlockSizeInBytes;
+
+        MipChainCopySplit split =
+            ComputeMipChainCopySplit({spec.width, spec.height, 1}, 0, levelCount, fakeFormat);
+        ASSERT_EQ(split.count, levelCount);
+        ASSERT_EQ(split.levels[0].offset, 0u);
+
+        uint64_t lastEnd = 0;
+        for (uint32_t i = 0; i < split.count; ++i) {
+            const MipChainCopySplit::LevelInfo& info = split.levels[i];
+
+            // Offsets are placement-aligned, contiguous and non-overlapping.
+            ASSERT_EQ(RoundUp(info.offset, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT), info.offset);
+            ASSERT_GE(info.offset, lastEnd);
+
+            // The copy size covers the whole level, rounded up to block multiples.
+            ASSERT_EQ(info.copySize.width,
+                      Align(std::max(spec.width >> i, 1u), spec.blockWidth));
+            ASSERT_EQ(info.copySize.height,
+                      Align(std::max(spec.height >> i, 1u), spec.blockHeight));
+            ASSERT_EQ(info.copySize.depth, 1u);
+
+            // The row pitch is 256-aligned and large enough for a row of blocks.
+            ASSERT_EQ(Align(info.bytesPerRow, kTextureBytesPerRowAlignment), info.bytesPerRow);
+            ASSERT_GE(info.bytesPerRow,
+                      info.copySize.width / spec.blockWidth * spec.texelBlockSizeInBytes);
+
+            lastEnd = info.offset + uint64_t(info.bytesPerRow) *
+                                        (info.copySize.height / spec.blockHeight) *
+                                        info.copySize.depth;
+        }
+
+        ASSERT_GE(split.totalSize, lastEnd);
+    }
+}
@@ -728,6 +728,62 @@ TEST_F(BindGroupLayoutValidationTest, DynamicBufferNumberLimit) {
     }
 }
 
+// Check that static samplers are only allowed on sampler bindings.
+TEST_F(BindGroupLayoutValidationTest, StaticSamplerBindingType) {
+    wgpu::SamplerDescriptor samplerDesc = utils::GetDefaultSamplerDescriptor();
+    wgpu::Sampler sampler = device.CreateSampler(&samplerDesc);
+
+    wgpu::BindGroupLayoutEntry entry = {};
+    entry.binding = 0;
+    entry.visibility = wgpu::ShaderStage::Fragment;
+    entry.staticSampler = sampler;
+
+    // Control cases: both sampler binding types accept a static sampler.
+    entry.type = wgpu::BindingType::Sampler;
+    TestCreateBindGroupLayout(&entry, 1, true);
+    entry.type = wgpu::BindingType::ComparisonSampler;
+    TestCreateBindGroupLayout(&entry, 1, true);
+
+    // Error case: static samplers are not allowed on other binding types.
+    entry.type = wgpu::BindingType::UniformBuffer;
+    TestCreateBindGroupLayout(&entry, 1, false);
+}
+
+// Check that bind groups do not (and may not) provide static sampler bindings.
+TEST_F(BindGroupLayoutValidationTest, StaticSamplerBindGroup) {
+    wgpu::SamplerDescriptor samplerDesc = utils::GetDefaultSamplerDescriptor();
+    wgpu::Sampler sampler = device.CreateSampler(&samplerDesc);
+
+    wgpu::BindGroupLayoutEntry entries[2] = {};
+    entries[0].binding = 0;
+    entries[0].visibility = wgpu::ShaderStage::Fragment;
+    entries[0].type = wgpu::BindingType::Sampler;
+    entries[0].staticSampler = sampler;
+    entries[1].binding = 1;
+    entries[1].visibility = wgpu::ShaderStage::Fragment;
+    entries[1].type = wgpu::BindingType::UniformBuffer;
+
+    wgpu::BindGroupLayoutDescriptor descriptor;
+    descriptor.entryCount = 2;
+    descriptor.entries = entries;
+    wgpu::BindGroupLayout layout = device.CreateBindGroupLayout(&descriptor);
+
+    wgpu::BufferDescriptor bufferDesc;
+    bufferDesc.size = 256;
+    bufferDesc.usage = wgpu::BufferUsage::Uniform;
+    wgpu::Buffer buffer = device.CreateBuffer(&bufferDesc);
+
+    // Control case: only the non-static binding is provided.
+    utils::MakeBindGroup(device, layout, {{1, buffer, 0, 256}});
+
+    // Error case: providing the static sampler binding is invalid.
+    ASSERT_DEVICE_ERROR(
+        utils::MakeBindGroup(device, layout, {{0, sampler}, {1, buffer, 0, 256}}));
+
+    // Error case: providing only the static sampler binding misses the buffer.
+    ASSERT_DEVICE_ERROR(utils::MakeBindGroup(device, layout, {{0, sampler}}));
+}
+
 constexpr uint64_t kBufferSize = 3 * kMinDynamicBufferOffsetAlignment + 8;
 constexpr uint32_t kBindingSize = 9;
 
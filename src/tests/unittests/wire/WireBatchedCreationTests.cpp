@@ -0,0 +1,89 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/wire/WireTest.h"
+
+#include "dawn_wire/WireClient.h"
+
+using namespace testing;
+using namespace dawn_wire;
+
+class WireBatchedCreationTests : public WireTest {
+  public:
+    WireBatchedCreationTests() {
+    }
+    ~WireBatchedCreationTests() override = default;
+};
+
+// Test that a batched bind group creation produces one server-side creation per
+// descriptor and that the returned client objects are usable.
+TEST_F(WireBatchedCreationTests, CreateBindGroups) {
+    WGPUBindGroupLayoutDescriptor bglDescriptor = {};
+    WGPUBindGroupLayout bgl = wgpuDeviceCreateBindGroupLayout(device, &bglDescriptor);
+    WGPUBindGroupLayout apiBgl = api.GetNewBindGroupLayout();
+    EXPECT_CALL(api, DeviceCreateBindGroupLayout(apiDevice, _)).WillOnce(Return(apiBgl));
+
+    constexpr uint32_t kCount = 3;
+    WGPUBindGroupDescriptor descriptors[kCount] = {};
+    for (uint32_t i = 0; i < kCount; ++i) {
+        descriptors[i].layout = bgl;
+        descriptors[i].entryCount = 0;
+        descriptors[i].entries = nullptr;
+    }
+
+    WGPUBindGroup bindGroups[kCount];
+    GetWireClient()->CreateBindGroups(device, kCount, descriptors, bindGroups);
+    for (uint32_t i = 0; i < kCount; ++i) {
+        ASSERT_NE(bindGroups[i], nullptr);
+    }
+
+    WGPUBindGroup apiBindGroup = api.GetNewBindGroup();
+    EXPECT_CALL(api, DeviceCreateBindGroup(
+                         apiDevice, MatchesLambda([apiBgl](const WGPUBindGroupDescriptor* desc) -> bool {
+                             return desc->nextInChain == nullptr && desc->layout == apiBgl &&
+                                    desc->entryCount == 0;
+                         })))
+        .Times(kCount)
+        .WillRepeatedly(Return(apiBindGroup));
+
+    FlushClient();
+}
+
+// Test that the objects returned by a batched creation are live wire objects:
+// releasing one forwards to the corresponding server-side object.
+TEST_F(WireBatchedCreationTests, BatchedObjectsAreUsable) {
+    WGPUBindGroupLayoutDescriptor bglDescriptor = {};
+    WGPUBindGroupLayout bgl = wgpuDeviceCreateBindGroupLayout(device, &bglDescriptor);
+    WGPUBindGroupLayout apiBgl = api.GetNewBindGroupLayout();
+    EXPECT_CALL(api, DeviceCreateBindGroupLayout(apiDevice, _)).WillOnce(Return(apiBgl));
+
+    constexpr uint32_t kCount = 2;
+    WGPUBindGroupDescriptor descriptors[kCount] = {};
+    for (uint32_t i = 0; i < kCount; ++i) {
+        descriptors[i].layout = bgl;
+    }
+
+    WGPUBindGroup bindGroups[kCount];
+    GetWireClient()->CreateBindGroups(device, kCount, descriptors, bindGroups);
+
+    WGPUBindGroup apiBindGroup = api.GetNewBindGroup();
+    EXPECT_CALL(api, DeviceCreateBindGroup(apiDevice, _))
+        .Times(kCount)
+        .WillRepeatedly(Return(apiBindGroup));
+    FlushClient();
+
+    wgpuBindGroupRelease(bindGroups[0]);
+    EXPECT_CALL(api, BindGroupRelease(apiBindGroup));
+    FlushClient();
+}
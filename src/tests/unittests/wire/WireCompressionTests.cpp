@@ -0,0 +1,177 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_wire/WireCompression.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+    // Captures the bytes a compressing serializer hands to its transport.
+    class CapturingSerializer : public dawn_wire::CommandSerializer {
+      public:
+        void* GetCmdSpace(size_t size) override {
+            size_t offset = mBytes.size();
+            mBytes.resize(offset + size);
+            return mBytes.data() + offset;
+        }
+
+        bool Flush() override {
+            mFlushCount++;
+            return true;
+        }
+
+        std::vector<char> mBytes;
+        size_t mFlushCount = 0;
+    };
+
+    // Records the decompressed batches delivered to it.
+    class RecordingHandler : public dawn_wire::CommandHandler {
+      public:
+        const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+            size_t offset = mBytes.size();
+            mBytes.resize(offset + size);
+            for (size_t i = 0; i < size; ++i) {
+                mBytes[offset + i] = commands[i];
+            }
+            mBatchCount++;
+            return commands + size;
+        }
+
+        std::vector<char> mBytes;
+        size_t mBatchCount = 0;
+    };
+
+    // A payload with long zero runs, like padded vertex data.
+    std::vector<char> MakeCompressiblePayload(size_t size) {
+        std::vector<char> payload(size, 0);
+        for (size_t i = 0; i < size; i += 64) {
+            payload[i] = static_cast<char>(i);
+        }
+        return payload;
+    }
+
+    // A payload with no runs at all.
+    std::vector<char> MakeIncompressiblePayload(size_t size) {
+        std::vector<char> payload(size);
+        uint32_t state = 0xDEADBEEF;
+        for (size_t i = 0; i < size; ++i) {
+            state = state * 1664525 + 1013904223;
+            payload[i] = static_cast<char>(state >> 24);
+        }
+        return payload;
+    }
+
+}  // anonymous namespace
+
+class WireCompressionTests : public testing::Test {};
+
+// A compressible batch shrinks on the transport and round-trips byte for byte.
+TEST_F(WireCompressionTests, CompressibleRoundTrip) {
+    CapturingSerializer transport;
+    auto serializer = dawn_wire::CreateCompressingSerializer(&transport);
+
+    std::vector<char> payload = MakeCompressiblePayload(4096);
+    memcpy(serializer->GetCmdSpace(payload.size()), payload.data(), payload.size());
+    ASSERT_TRUE(serializer->Flush());
+    EXPECT_EQ(transport.mFlushCount, 1u);
+    EXPECT_LT(transport.mBytes.size(), payload.size());
+
+    RecordingHandler recorder;
+    auto handler = dawn_wire::CreateDecompressingHandler(&recorder);
+    ASSERT_NE(handler->HandleCommands(transport.mBytes.data(), transport.mBytes.size()), nullptr);
+    EXPECT_EQ(recorder.mBytes, payload);
+}
+
+// An incompressible batch is stored verbatim and still round-trips.
+TEST_F(WireCompressionTests, IncompressibleRoundTrip) {
+    CapturingSerializer transport;
+    auto serializer = dawn_wire::CreateCompressingSerializer(&transport);
+
+    std::vector<char> payload = MakeIncompressiblePayload(1024);
+    memcpy(serializer->GetCmdSpace(payload.size()), payload.data(), payload.size());
+    ASSERT_TRUE(serializer->Flush());
+    // Only the frame header is added on top of the raw bytes.
+    EXPECT_EQ(transport.mBytes.size(), payload.size() + 2 * sizeof(uint64_t));
+
+    RecordingHandler recorder;
+    auto handler = dawn_wire::CreateDecompressingHandler(&recorder);
+    ASSERT_NE(handler->HandleCommands(transport.mBytes.data(), transport.mBytes.size()), nullptr);
+    EXPECT_EQ(recorder.mBytes, payload);
+}
+
+// The decompressing handler reassembles frames delivered byte by byte.
+TEST_F(WireCompressionTests, PartialDelivery) {
+    CapturingSerializer transport;
+    auto serializer = dawn_wire::CreateCompressingSerializer(&transport);
+
+    std::vector<char> payload = MakeCompressiblePayload(512);
+    memcpy(serializer->GetCmdSpace(payload.size()), payload.data(), payload.size());
+    ASSERT_TRUE(serializer->Flush());
+
+    RecordingHandler recorder;
+    auto handler = dawn_wire::CreateDecompressingHandler(&recorder);
+    for (size_t i = 0; i < transport.mBytes.size(); ++i) {
+        ASSERT_NE(handler->HandleCommands(&transport.mBytes[i], 1), nullptr);
+    }
+    EXPECT_EQ(recorder.mBatchCount, 1u);
+    EXPECT_EQ(recorder.mBytes, payload);
+}
+
+// Multiple flushes become independent frames, each delivered as its own batch.
+TEST_F(WireCompressionTests, MultipleBatches) {
+    CapturingSerializer transport;
+    auto serializer = dawn_wire::CreateCompressingSerializer(&transport);
+
+    std::vector<char> first = MakeCompressiblePayload(256);
+    memcpy(serializer->GetCmdSpace(first.size()), first.data(), first.size());
+    ASSERT_TRUE(serializer->Flush());
+
+    std::vector<char> second = MakeIncompressiblePayload(128);
+    memcpy(serializer->GetCmdSpace(second.size()), second.data(), second.size());
+    ASSERT_TRUE(serializer->Flush());
+
+    RecordingHandler recorder;
+    auto handler = dawn_wire::CreateDecompressingHandler(&recorder);
+    ASSERT_NE(handler->HandleCommands(transport.mBytes.data(), transport.mBytes.size()), nullptr);
+    EXPECT_EQ(recorder.mBatchCount, 2u);
+
+    std::vector<char> expected = first;
+    expected.insert(expected.end(), second.begin(), second.end());
+    EXPECT_EQ(recorder.mBytes, expected);
+}
+
+// An empty flush writes no frame but still reaches the transport.
+TEST_F(WireCompressionTests, EmptyFlush) {
+    CapturingSerializer transport;
+    auto serializer = dawn_wire::CreateCompressingSerializer(&transport);
+
+    ASSERT_TRUE(serializer->Flush());
+    EXPECT_EQ(transport.mFlushCount, 1u);
+    EXPECT_TRUE(transport.mBytes.empty());
+}
+
+// A frame that claims to inflate is rejected instead of trusted.
+TEST_F(WireCompressionTests, RejectsCorruptHeader) {
+    uint64_t header[2] = {4, 8};
+    char frame[sizeof(header) + 8] = {};
+    memcpy(frame, header, sizeof(header));
+
+    RecordingHandler recorder;
+    auto handler = dawn_wire::CreateDecompressingHandler(&recorder);
+    EXPECT_EQ(handler->HandleCommands(frame, sizeof(frame)), nullptr);
+}
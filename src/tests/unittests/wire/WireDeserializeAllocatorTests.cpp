@@ -0,0 +1,67 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_wire/WireDeserializeAllocator.h"
+
+#include <gtest/gtest.h>
+
+class WireDeserializeAllocatorTests : public testing::Test {};
+
+// Small allocations are served from the inline buffer without going to malloc.
+TEST_F(WireDeserializeAllocatorTests, InlineStorage) {
+    dawn_wire::WireDeserializeAllocator allocator;
+
+    EXPECT_NE(allocator.GetSpace(128), nullptr);
+    EXPECT_NE(allocator.GetSpace(512), nullptr);
+    EXPECT_EQ(allocator.GetStats().totalBlockAllocations, 0u);
+}
+
+// Overflow blocks are retained across Reset and reused, so a steady workload stops
+// allocating after its first batch.
+TEST_F(WireDeserializeAllocatorTests, ReachesSteadyState) {
+    dawn_wire::WireDeserializeAllocator allocator;
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_NE(allocator.GetSpace(16 * 1024), nullptr);
+    }
+    allocator.Reset();
+    size_t allocationsAfterFirstBatch = allocator.GetStats().totalBlockAllocations;
+    EXPECT_GT(allocationsAfterFirstBatch, 0u);
+    EXPECT_GT(allocator.GetStats().retainedBlocks, 0u);
+
+    for (int batch = 0; batch < 8; ++batch) {
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_NE(allocator.GetSpace(16 * 1024), nullptr);
+        }
+        allocator.Reset();
+    }
+    EXPECT_EQ(allocator.GetStats().totalBlockAllocations, allocationsAfterFirstBatch);
+}
+
+// The peak usage statistic records the largest batch seen.
+TEST_F(WireDeserializeAllocatorTests, TracksPeakUsage) {
+    dawn_wire::WireDeserializeAllocator allocator;
+
+    EXPECT_NE(allocator.GetSpace(1000), nullptr);
+    allocator.Reset();
+    EXPECT_EQ(allocator.GetStats().peakBytesUsed, 1000u);
+
+    EXPECT_NE(allocator.GetSpace(4000), nullptr);
+    allocator.Reset();
+    EXPECT_EQ(allocator.GetStats().peakBytesUsed, 4000u);
+
+    EXPECT_NE(allocator.GetSpace(100), nullptr);
+    allocator.Reset();
+    EXPECT_EQ(allocator.GetStats().peakBytesUsed, 4000u);
+}
@@ -0,0 +1,111 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_wire/WireClient.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+
+    // Counts flushes; the commands themselves never reach a server in these tests.
+    class CountingSerializer : public dawn_wire::CommandSerializer {
+      public:
+        void* GetCmdSpace(size_t size) override {
+            if (size > mBuffer.size()) {
+                mBuffer.resize(size);
+            }
+            return mBuffer.data();
+        }
+
+        bool Flush() override {
+            mFlushCount++;
+            return true;
+        }
+
+        std::vector<char> mBuffer;
+        size_t mFlushCount = 0;
+    };
+
+}  // anonymous namespace
+
+class WireFlushPolicyTests : public testing::Test {
+  protected:
+    std::unique_ptr<dawn_wire::WireClient> CreateClient(
+        const dawn_wire::WireClientFlushPolicy& policy) {
+        dawn_wire::WireClientDescriptor descriptor = {};
+        descriptor.serializer = &mSerializer;
+        descriptor.flushPolicy = policy;
+        return std::make_unique<dawn_wire::WireClient>(descriptor);
+    }
+
+    CountingSerializer mSerializer;
+    DawnProcTable mProcs = dawn_wire::WireClient::GetProcs();
+};
+
+// With no triggers enabled the client never flushes on its own.
+TEST_F(WireFlushPolicyTests, NoTriggersNeverFlushes) {
+    auto client = CreateClient({});
+    WGPUDevice device = client->GetDevice();
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        WGPUCommandEncoder encoder = mProcs.deviceCreateCommandEncoder(device, nullptr);
+        mProcs.commandEncoderRelease(encoder);
+    }
+    EXPECT_EQ(mSerializer.mFlushCount, 0u);
+}
+
+// Buffered commands are flushed before the pending byte count passes the threshold.
+TEST_F(WireFlushPolicyTests, FlushesOnSizeThreshold) {
+    dawn_wire::WireClientFlushPolicy policy;
+    policy.maxPendingCommandBytes = 1;
+    auto client = CreateClient(policy);
+    // Creating the device buffers a command for its default queue.
+    WGPUDevice device = client->GetDevice();
+
+    // Every command is bigger than the threshold, so each one flushes what came before it.
+    WGPUCommandEncoder firstEncoder = mProcs.deviceCreateCommandEncoder(device, nullptr);
+    EXPECT_EQ(mSerializer.mFlushCount, 1u);
+    WGPUCommandEncoder secondEncoder = mProcs.deviceCreateCommandEncoder(device, nullptr);
+    EXPECT_EQ(mSerializer.mFlushCount, 2u);
+
+    mProcs.commandEncoderRelease(firstEncoder);
+    mProcs.commandEncoderRelease(secondEncoder);
+}
+
+// A queue submit flushes the buffered commands when the policy asks for it.
+TEST_F(WireFlushPolicyTests, FlushesOnQueueSubmit) {
+    dawn_wire::WireClientFlushPolicy policy;
+    policy.flushOnQueueSubmit = true;
+    auto client = CreateClient(policy);
+    WGPUDevice device = client->GetDevice();
+
+    WGPUQueue queue = mProcs.deviceGetDefaultQueue(device);
+    EXPECT_EQ(mSerializer.mFlushCount, 0u);
+
+    mProcs.queueSubmit(queue, 0, nullptr);
+    EXPECT_EQ(mSerializer.mFlushCount, 1u);
+
+    mProcs.queueRelease(queue);
+}
+
+// An explicit WireClient::Flush forwards to the serializer.
+TEST_F(WireFlushPolicyTests, ExplicitFlush) {
+    auto client = CreateClient({});
+    client->GetDevice();
+
+    EXPECT_TRUE(client->Flush());
+    EXPECT_EQ(mSerializer.mFlushCount, 1u);
+}
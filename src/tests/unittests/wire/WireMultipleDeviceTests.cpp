@@ -84,7 +84,8 @@ class WireMultipleDeviceTests : public testing::Test {
         }
 
         void FlushClient(bool success = true) {
-            ASSERT_EQ(mC2sBuf->Flush(), success);
+            // Flush through the client so batched destructions are serialized first.
+            ASSERT_EQ(mWireClient->Flush(), success);
         }
 
         void FlushServer(bool success = true) {
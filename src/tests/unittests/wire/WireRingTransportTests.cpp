@@ -0,0 +1,134 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_wire/WireRingTransport.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    // Records the batches delivered through the ring.
+    class RecordingHandler : public dawn_wire::CommandHandler {
+      public:
+        const volatile char* HandleCommands(const volatile char* commands, size_t size) override {
+            std::vector<char> batch(size);
+            for (size_t i = 0; i < size; ++i) {
+                batch[i] = commands[i];
+            }
+            mBatches.push_back(std::move(batch));
+            return commands + size;
+        }
+
+        std::vector<std::vector<char>> mBatches;
+    };
+
+    std::vector<char> MakePayload(size_t size, char seed) {
+        std::vector<char> payload(size);
+        for (size_t i = 0; i < size; ++i) {
+            payload[i] = static_cast<char>(seed + i);
+        }
+        return payload;
+    }
+
+}  // anonymous namespace
+
+class WireRingTransportTests : public testing::Test {};
+
+// A flushed batch comes out of Forward byte for byte.
+TEST_F(WireRingTransportTests, RoundTrip) {
+    auto transport = dawn_wire::CreateRingTransport(1024, dawn_wire::RingWaitMode::BusyPoll);
+
+    std::vector<char> payload = MakePayload(100, 1);
+    memcpy(transport->GetSerializer()->GetCmdSpace(payload.size()), payload.data(),
+           payload.size());
+    ASSERT_TRUE(transport->GetSerializer()->Flush());
+
+    RecordingHandler handler;
+    ASSERT_TRUE(transport->Forward(&handler));
+    ASSERT_EQ(handler.mBatches.size(), 1u);
+    EXPECT_EQ(handler.mBatches[0], payload);
+}
+
+// Batches wrap around the end of the ring storage without corruption.
+TEST_F(WireRingTransportTests, WrapsAround) {
+    auto transport = dawn_wire::CreateRingTransport(256, dawn_wire::RingWaitMode::BusyPoll);
+    RecordingHandler handler;
+
+    // Each batch fills most of the ring, so consecutive batches straddle the end.
+    for (int i = 0; i < 8; ++i) {
+        std::vector<char> payload = MakePayload(150, static_cast<char>(i));
+        memcpy(transport->GetSerializer()->GetCmdSpace(payload.size()), payload.data(),
+               payload.size());
+        ASSERT_TRUE(transport->GetSerializer()->Flush());
+        ASSERT_TRUE(transport->Forward(&handler));
+        EXPECT_EQ(handler.mBatches.back(), payload);
+    }
+    EXPECT_EQ(handler.mBatches.size(), 8u);
+}
+
+// A batch that cannot fit in the ring fails to flush instead of deadlocking.
+TEST_F(WireRingTransportTests, RejectsOversizedBatch) {
+    auto transport = dawn_wire::CreateRingTransport(64, dawn_wire::RingWaitMode::BusyPoll);
+
+    std::vector<char> payload = MakePayload(128, 0);
+    memcpy(transport->GetSerializer()->GetCmdSpace(payload.size()), payload.data(),
+           payload.size());
+    EXPECT_FALSE(transport->GetSerializer()->Flush());
+}
+
+// Forward returns false once the transport is closed and drained.
+TEST_F(WireRingTransportTests, CloseDrains) {
+    auto transport = dawn_wire::CreateRingTransport(1024, dawn_wire::RingWaitMode::BusyPoll);
+
+    std::vector<char> payload = MakePayload(32, 7);
+    memcpy(transport->GetSerializer()->GetCmdSpace(payload.size()), payload.data(),
+           payload.size());
+    ASSERT_TRUE(transport->GetSerializer()->Flush());
+    transport->Close();
+
+    RecordingHandler handler;
+    EXPECT_TRUE(transport->Forward(&handler));
+    EXPECT_FALSE(transport->Forward(&handler));
+    EXPECT_EQ(handler.mBatches.size(), 1u);
+}
+
+// A producer and a blocking consumer hand many batches across threads.
+TEST_F(WireRingTransportTests, WaitNotifyAcrossThreads) {
+    auto transport = dawn_wire::CreateRingTransport(512, dawn_wire::RingWaitMode::WaitNotify);
+    constexpr int kBatchCount = 1000;
+
+    RecordingHandler handler;
+    std::thread consumer([&] {
+        while (transport->Forward(&handler)) {
+        }
+    });
+
+    for (int i = 0; i < kBatchCount; ++i) {
+        std::vector<char> payload = MakePayload(100, static_cast<char>(i));
+        memcpy(transport->GetSerializer()->GetCmdSpace(payload.size()), payload.data(),
+               payload.size());
+        ASSERT_TRUE(transport->GetSerializer()->Flush());
+    }
+    transport->Close();
+    consumer.join();
+
+    ASSERT_EQ(handler.mBatches.size(), static_cast<size_t>(kBatchCount));
+    for (int i = 0; i < kBatchCount; ++i) {
+        EXPECT_EQ(handler.mBatches[i], MakePayload(100, static_cast<char>(i)));
+    }
+}
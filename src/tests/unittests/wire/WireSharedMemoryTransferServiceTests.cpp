@@ -0,0 +1,145 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/Platform.h"
+
+#if defined(DAWN_PLATFORM_POSIX)
+
+#    include "dawn_wire/WireClient.h"
+#    include "dawn_wire/WireServer.h"
+
+#    include <gtest/gtest.h>
+
+#    include <cstring>
+#    include <tuple>
+#    include <vector>
+
+namespace {
+
+    std::vector<char> SerializeCreate(dawn_wire::client::MemoryTransferService::ReadHandle* handle) {
+        std::vector<char> serialized(handle->SerializeCreateSize());
+        handle->SerializeCreate(serialized.data());
+        return serialized;
+    }
+
+    std::vector<char> SerializeCreate(
+        dawn_wire::client::MemoryTransferService::WriteHandle* handle) {
+        std::vector<char> serialized(handle->SerializeCreateSize());
+        handle->SerializeCreate(serialized.data());
+        return serialized;
+    }
+
+}  // anonymous namespace
+
+class WireSharedMemoryTransferServiceTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        mClientService = dawn_wire::client::CreateSharedMemoryTransferService();
+        mServerService = dawn_wire::server::CreateSharedMemoryTransferService();
+        ASSERT_NE(mClientService, nullptr);
+        ASSERT_NE(mServerService, nullptr);
+    }
+
+    std::unique_ptr<dawn_wire::client::MemoryTransferService> mClientService;
+    std::unique_ptr<dawn_wire::server::MemoryTransferService> mServerService;
+};
+
+// Data written through a client WriteHandle reaches the server target after a flush,
+// even though the flush itself carries no payload.
+TEST_F(WireSharedMemoryTransferServiceTests, WriteHandleRoundTrip) {
+    constexpr size_t kSize = 256;
+
+    std::unique_ptr<dawn_wire::client::MemoryTransferService::WriteHandle> clientHandle(
+        mClientService->CreateWriteHandle(kSize));
+    ASSERT_NE(clientHandle, nullptr);
+
+    std::vector<char> serialized = SerializeCreate(clientHandle.get());
+    dawn_wire::server::MemoryTransferService::WriteHandle* serverHandleRaw = nullptr;
+    ASSERT_TRUE(mServerService->DeserializeWriteHandle(serialized.data(), serialized.size(),
+                                                       &serverHandleRaw));
+    std::unique_ptr<dawn_wire::server::MemoryTransferService::WriteHandle> serverHandle(
+        serverHandleRaw);
+
+    void* data = nullptr;
+    size_t dataLength = 0;
+    std::tie(data, dataLength) = clientHandle->Open();
+    ASSERT_NE(data, nullptr);
+    ASSERT_EQ(dataLength, kSize);
+    for (size_t i = 0; i < kSize; ++i) {
+        static_cast<char*>(data)[i] = static_cast<char>(i);
+    }
+
+    EXPECT_EQ(clientHandle->SerializeFlushSize(), 0u);
+    clientHandle->SerializeFlush(nullptr);
+
+    std::vector<char> target(kSize, 0);
+    serverHandle->SetTarget(target.data(), target.size());
+    ASSERT_TRUE(serverHandle->DeserializeFlush(nullptr, 0));
+    EXPECT_EQ(memcmp(target.data(), data, kSize), 0);
+}
+
+// Data the server writes into a ReadHandle is visible to the client without any
+// initial data traveling on the command stream.
+TEST_F(WireSharedMemoryTransferServiceTests, ReadHandleRoundTrip) {
+    constexpr size_t kSize = 256;
+
+    std::unique_ptr<dawn_wire::client::MemoryTransferService::ReadHandle> clientHandle(
+        mClientService->CreateReadHandle(kSize));
+    ASSERT_NE(clientHandle, nullptr);
+
+    std::vector<char> serialized = SerializeCreate(clientHandle.get());
+    dawn_wire::server::MemoryTransferService::ReadHandle* serverHandleRaw = nullptr;
+    ASSERT_TRUE(mServerService->DeserializeReadHandle(serialized.data(), serialized.size(),
+                                                      &serverHandleRaw));
+    std::unique_ptr<dawn_wire::server::MemoryTransferService::ReadHandle> serverHandle(
+        serverHandleRaw);
+
+    std::vector<char> contents(kSize);
+    for (size_t i = 0; i < kSize; ++i) {
+        contents[i] = static_cast<char>(kSize - i);
+    }
+    EXPECT_EQ(serverHandle->SerializeInitialDataSize(contents.data(), contents.size()), 0u);
+    serverHandle->SerializeInitialData(contents.data(), contents.size(), nullptr);
+
+    const void* data = nullptr;
+    size_t dataLength = 0;
+    ASSERT_TRUE(clientHandle->DeserializeInitialData(nullptr, 0, &data, &dataLength));
+    ASSERT_NE(data, nullptr);
+    ASSERT_EQ(dataLength, kSize);
+    EXPECT_EQ(memcmp(data, contents.data(), kSize), 0);
+}
+
+// A truncated or corrupt handle description is rejected instead of trusted.
+TEST_F(WireSharedMemoryTransferServiceTests, RejectsCorruptCreateInfo) {
+    std::unique_ptr<dawn_wire::client::MemoryTransferService::WriteHandle> clientHandle(
+        mClientService->CreateWriteHandle(64));
+    ASSERT_NE(clientHandle, nullptr);
+    std::vector<char> serialized = SerializeCreate(clientHandle.get());
+
+    dawn_wire::server::MemoryTransferService::WriteHandle* serverHandle = nullptr;
+
+    // Truncated description.
+    EXPECT_FALSE(
+        mServerService->DeserializeWriteHandle(serialized.data(), serialized.size() - 1,
+                                               &serverHandle));
+
+    // Region name that was never created.
+    std::vector<char> corrupt = serialized;
+    corrupt[sizeof(uint64_t)] = '/';
+    corrupt[sizeof(uint64_t) + 1] = '\0';
+    EXPECT_FALSE(
+        mServerService->DeserializeWriteHandle(corrupt.data(), corrupt.size(), &serverHandle));
+}
+
+#endif  // defined(DAWN_PLATFORM_POSIX)
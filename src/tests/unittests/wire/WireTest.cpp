@@ -91,7 +91,8 @@ void WireTest::TearDown() {
 }
 
 void WireTest::FlushClient(bool success) {
-    ASSERT_EQ(mC2sBuf->Flush(), success);
+    // Flush through the client so batched destructions are serialized first.
+    ASSERT_EQ(mWireClient->Flush(), success);
 
     Mock::VerifyAndClearExpectations(&api);
     SetupIgnoredCallExpectations();
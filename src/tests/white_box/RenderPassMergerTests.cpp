@@ -0,0 +1,285 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/DawnTest.h"
+
+#include "dawn_native/AttachmentState.h"
+#include "dawn_native/Commands.h"
+#include "dawn_native/Device.h"
+#include "dawn_native/RenderPassMerger.h"
+
+namespace dawn_native {
+
+    // Tests that drive MergeCompatibleRenderPasses over hand-built command tapes, so each
+    // merge condition can be checked without going through a full encoder.
+    class RenderPassMergerTests : public DawnTest {
+      protected:
+        DeviceBase* GetNativeDevice() {
+            return reinterpret_cast<DeviceBase*>(device.Get());
+        }
+
+        TextureViewBase* CreateColorView(wgpu::TextureFormat format) {
+            wgpu::TextureDescriptor descriptor;
+            descriptor.dimension = wgpu::TextureDimension::e2D;
+            descriptor.size = {4, 4, 1};
+            descriptor.arrayLayerCount = 1;
+            descriptor.sampleCount = 1;
+            descriptor.format = format;
+            descriptor.mipLevelCount = 1;
+            descriptor.usage = wgpu::TextureUsage::OutputAttachment;
+            wgpu::Texture texture = device.CreateTexture(&descriptor);
+            mKeepAlive.push_back(texture);
+            wgpu::TextureView view = texture.CreateView();
+            mKeepAliveViews.push_back(view);
+            return reinterpret_cast<TextureViewBase*>(view.Get());
+        }
+
+        Ref<AttachmentState> GetAttachmentState(TextureViewBase* view) {
+            RenderPassColorAttachmentDescriptor colorAttachment = {};
+            colorAttachment.attachment = view;
+            colorAttachment.loadOp = wgpu::LoadOp::Clear;
+            colorAttachment.storeOp = wgpu::StoreOp::Store;
+
+            RenderPassDescriptor descriptor = {};
+            descriptor.colorAttachmentCount = 1;
+            descriptor.colorAttachments = &colorAttachment;
+            return GetNativeDevice()->GetOrCreateAttachmentState(&descriptor);
+        }
+
+        // Appends a single-color-attachment render pass with no commands inside.
+        void AppendPass(CommandAllocator* allocator,
+                        TextureViewBase* view,
+                        wgpu::LoadOp loadOp,
+                        wgpu::StoreOp storeOp) {
+            BeginRenderPassCmd* cmd =
+                allocator->Allocate<BeginRenderPassCmd>(Command::BeginRenderPass);
+            cmd->attachmentState = GetAttachmentState(view);
+            cmd->colorAttachments[0].view = view;
+            cmd->colorAttachments[0].loadOp = loadOp;
+            cmd->colorAttachments[0].storeOp = storeOp;
+            cmd->width = 4;
+            cmd->height = 4;
+            allocator->Allocate<EndRenderPassCmd>(Command::EndRenderPass);
+        }
+
+        static PassResourceUsage MakeBufferUsage(BufferBase* buffer, wgpu::BufferUsage usage) {
+            PassResourceUsage passUsage;
+            passUsage.passType = PassType::Render;
+            if (buffer != nullptr) {
+                passUsage.buffers.push_back(buffer);
+                passUsage.bufferUsages.push_back(usage);
+            }
+            return passUsage;
+        }
+
+        BufferBase* CreateBuffer(wgpu::BufferUsage usage) {
+            wgpu::BufferDescriptor descriptor;
+            descriptor.size = 4;
+            descriptor.usage = usage;
+            wgpu::Buffer buffer = device.CreateBuffer(&descriptor);
+            mKeepAliveBuffers.push_back(buffer);
+            return reinterpret_cast<BufferBase*>(buffer.Get());
+        }
+
+        // Runs the merger and returns the number of BeginRenderPass commands left.
+        uint32_t CountPassesAfterMerge(CommandAllocator* allocator, PerPassUsages* passUsages) {
+            CommandIterator merged = MergeCompatibleRenderPasses(
+                CommandIterator(std::move(*allocator)), GetNativeDevice()->GetCommandBlockPool(),
+                passUsages);
+
+            uint32_t passCount = 0;
+            Command type;
+            while (merged.NextCommandId(&type)) {
+                if (type == Command::BeginRenderPass) {
+                    passCount++;
+                }
+                SkipCommand(&merged, type);
+            }
+            merged.Reset();
+            FreeCommands(&merged);
+            return passCount;
+        }
+
+      private:
+        std::vector<wgpu::Texture> mKeepAlive;
+        std::vector<wgpu::TextureView> mKeepAliveViews;
+        std::vector<wgpu::Buffer> mKeepAliveBuffers;
+    };
+
+    // Two back-to-back passes on the same view where the second loads what the first
+    // stores collapse into one pass, and their usage entries collapse with them.
+    TEST_P(RenderPassMergerTests, MergesCompatibleBoundary) {
+        TextureViewBase* view = CreateColorView(wgpu::TextureFormat::RGBA8Unorm);
+
+        CommandAllocator allocator;
+        AppendPass(&allocator, view, wgpu::LoadOp::Clear, wgpu::StoreOp::Store);
+        AppendPass(&allocator, view, wgpu::LoadOp::Load, wgpu::StoreOp::Store);
+
+        PerPassUsages passUsages(2);
+        passUsages[0].passType = PassType::Render;
+        passUsages[1].passType = PassType::Render;
+
+        EXPECT_EQ(1u, CountPassesAfterMerge(&allocator, &passUsages));
+        EXPECT_EQ(1u, passUsages.size());
+    }
+
+    // A second pass that clears instead of loading must keep its own pass.
+    TEST_P(RenderPassMergerTests, KeepsBoundaryWhenSecondPassClears) {
+        TextureViewBase* view = CreateColorView(wgpu::TextureFormat::RGBA8Unorm);
+
+        CommandAllocator allocator;
+        AppendPass(&allocator, view, wgpu::LoadOp::Clear, wgpu::StoreOp::Store);
+        AppendPass(&allocator, view, wgpu::LoadOp::Clear, wgpu::StoreOp::Store);
+
+        PerPassUsages passUsages(2);
+        EXPECT_EQ(2u, CountPassesAfterMerge(&allocator, &passUsages));
+        EXPECT_EQ(2u, passUsages.size());
+    }
+
+    // A first pass that doesn't store can't feed a loading second pass.
+    TEST_P(RenderPassMergerTests, KeepsBoundaryWhenFirstPassDiscards) {
+        TextureViewBase* view = CreateColorView(wgpu::TextureFormat::RGBA8Unorm);
+
+        CommandAllocator allocator;
+        AppendPass(&allocator, view, wgpu::LoadOp::Clear, wgpu::StoreOp::Clear);
+        AppendPass(&allocator, view, wgpu::LoadOp::Load, wgpu::StoreOp::Store);
+
+        PerPassUsages passUsages(2);
+        EXPECT_EQ(2u, CountPassesAfterMerge(&allocator, &passUsages));
+    }
+
+    // Passes targeting different views of the same format share an AttachmentState but
+    // must not merge.
+    TEST_P(RenderPassMergerTests, KeepsBoundaryOnDifferentViews) {
+        TextureViewBase* viewA = CreateColorView(wgpu::TextureFormat::RGBA8Unorm);
+        TextureViewBase* viewB = CreateColorView(wgpu::TextureFormat::RGBA8Unorm);
+
+        CommandAllocator allocator;
+        AppendPass(&allocator, viewA, wgpu::LoadOp::Clear, wgpu::StoreOp::Store);
+        AppendPass(&allocator, viewB, wgpu::LoadOp::Load, wgpu::StoreOp::Store);
+
+        PerPassUsages passUsages(2);
+        EXPECT_EQ(2u, CountPassesAfterMerge(&allocator, &passUsages));
+    }
+
+    // Passes with different attachment formats have different AttachmentStates and must
+    // not merge.
+    TEST_P(RenderPassMergerTests, KeepsBoundaryOnDifferentAttachmentState) {
+        TextureViewBase* viewA = CreateColorView(wgpu::TextureFormat::RGBA8Unorm);
+        TextureViewBase* viewB = CreateColorView(wgpu::TextureFormat::BGRA8Unorm);
+
+        CommandAllocator allocator;
+        AppendPass(&allocator, viewA, wgpu::LoadOp::Clear, wgpu::StoreOp::Store);
+        AppendPass(&allocator, viewB, wgpu::LoadOp::Load, wgpu::StoreOp::Store);
+
+        PerPassUsages passUsages(2);
+        EXPECT_EQ(2u, CountPassesAfterMerge(&allocator, &passUsages));
+    }
+
+    // A command between the passes keeps the boundary.
+    TEST_P(RenderPassMergerTests, KeepsBoundaryWhenCommandSeparatesPasses) {
+        TextureViewBase* view = CreateColorView(wgpu::TextureFormat::RGBA8Unorm);
+        BufferBase* src = CreateBuffer(wgpu::BufferUsage::CopySrc);
+        BufferBase* dst = CreateBuffer(wgpu::BufferUsage::CopyDst);
+
+        CommandAllocator allocator;
+        AppendPass(&allocator, view, wgpu::LoadOp::Clear, wgpu::StoreOp::Store);
+        CopyBufferToBufferCmd* copy =
+            allocator.Allocate<CopyBufferToBufferCmd>(Command::CopyBufferToBuffer);
+        copy->source = src;
+        copy->sourceOffset = 0;
+        copy->destination = dst;
+        copy->destinationOffset = 0;
+        copy->size = 4;
+        AppendPass(&allocator, view, wgpu::LoadOp::Load, wgpu::StoreOp::Store);
+
+        PerPassUsages passUsages(2);
+        EXPECT_EQ(2u, CountPassesAfterMerge(&allocator, &passUsages));
+    }
+
+    // A pass that set dynamic state may rely on the boundary resetting it, so it keeps
+    // its End.
+    TEST_P(RenderPassMergerTests, KeepsBoundaryWhenDynamicStateWasSet) {
+        TextureViewBase* view = CreateColorView(wgpu::TextureFormat::RGBA8Unorm);
+
+        CommandAllocator allocator;
+        BeginRenderPassCmd* cmd =
+            allocator.Allocate<BeginRenderPassCmd>(Command::BeginRenderPass);
+        cmd->attachmentState = GetAttachmentState(view);
+        cmd->colorAttachments[0].view = view;
+        cmd->colorAttachments[0].loadOp = wgpu::LoadOp::Clear;
+        cmd->colorAttachments[0].storeOp = wgpu::StoreOp::Store;
+        cmd->width = 4;
+        cmd->height = 4;
+        SetViewportCmd* viewport = allocator.Allocate<SetViewportCmd>(Command::SetViewport);
+        viewport->x = 0;
+        viewport->y = 0;
+        viewport->width = 1;
+        viewport->height = 1;
+        viewport->minDepth = 0;
+        viewport->maxDepth = 1;
+        allocator.Allocate<EndRenderPassCmd>(Command::EndRenderPass);
+        AppendPass(&allocator, view, wgpu::LoadOp::Load, wgpu::StoreOp::Store);
+
+        PerPassUsages passUsages(2);
+        EXPECT_EQ(2u, CountPassesAfterMerge(&allocator, &passUsages));
+    }
+
+    // Merging collapses the usage entries: resources used the same way dedupe and the
+    // second pass's new resources are appended.
+    TEST_P(RenderPassMergerTests, CollapsesUsagesOnMerge) {
+        TextureViewBase* view = CreateColorView(wgpu::TextureFormat::RGBA8Unorm);
+        BufferBase* shared = CreateBuffer(wgpu::BufferUsage::Uniform);
+        BufferBase* extra = CreateBuffer(wgpu::BufferUsage::Vertex);
+
+        CommandAllocator allocator;
+        AppendPass(&allocator, view, wgpu::LoadOp::Clear, wgpu::StoreOp::Store);
+        AppendPass(&allocator, view, wgpu::LoadOp::Load, wgpu::StoreOp::Store);
+
+        PerPassUsages passUsages(2);
+        passUsages[0] = MakeBufferUsage(shared, wgpu::BufferUsage::Uniform);
+        passUsages[1] = MakeBufferUsage(shared, wgpu::BufferUsage::Uniform);
+        passUsages[1].buffers.push_back(extra);
+        passUsages[1].bufferUsages.push_back(wgpu::BufferUsage::Vertex);
+
+        EXPECT_EQ(1u, CountPassesAfterMerge(&allocator, &passUsages));
+        ASSERT_EQ(1u, passUsages.size());
+        ASSERT_EQ(2u, passUsages[0].buffers.size());
+        EXPECT_EQ(shared, passUsages[0].buffers[0]);
+        EXPECT_EQ(wgpu::BufferUsage::Uniform, passUsages[0].bufferUsages[0]);
+        EXPECT_EQ(extra, passUsages[0].buffers[1]);
+        EXPECT_EQ(wgpu::BufferUsage::Vertex, passUsages[0].bufferUsages[1]);
+    }
+
+    // A resource used differently by the two passes can't have its usage entries
+    // collapsed, so the boundary stays.
+    TEST_P(RenderPassMergerTests, KeepsBoundaryOnConflictingUsage) {
+        TextureViewBase* view = CreateColorView(wgpu::TextureFormat::RGBA8Unorm);
+        BufferBase* shared = CreateBuffer(wgpu::BufferUsage::Uniform | wgpu::BufferUsage::Storage);
+
+        CommandAllocator allocator;
+        AppendPass(&allocator, view, wgpu::LoadOp::Clear, wgpu::StoreOp::Store);
+        AppendPass(&allocator, view, wgpu::LoadOp::Load, wgpu::StoreOp::Store);
+
+        PerPassUsages passUsages(2);
+        passUsages[0] = MakeBufferUsage(shared, wgpu::BufferUsage::Uniform);
+        passUsages[1] = MakeBufferUsage(shared, wgpu::BufferUsage::Storage);
+
+        EXPECT_EQ(2u, CountPassesAfterMerge(&allocator, &passUsages));
+        EXPECT_EQ(2u, passUsages.size());
+    }
+
+    DAWN_INSTANTIATE_TEST(RenderPassMergerTests, NullBackend());
+
+}  // namespace dawn_native
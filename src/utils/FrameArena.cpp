@@ -0,0 +1,112 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "utils/FrameArena.h"
+
+#include "common/Assert.h"
+#include "common/Constants.h"
+#include "common/Math.h"
+
+#include <algorithm>
+
+namespace utils {
+
+    FrameArena::FrameArena(const wgpu::Device& device,
+                           wgpu::BufferUsage usage,
+                           uint64_t blockSize)
+        : mDevice(device), mUsage(usage | wgpu::BufferUsage::CopyDst), mBlockSize(blockSize) {
+        ASSERT(blockSize > 0);
+    }
+
+    FrameArena::Allocation FrameArena::Allocate(uint64_t size) {
+        RecycleCompletedFrames();
+
+        // Align the cursor so any allocation can be bound at a dynamic offset.
+        uint64_t offset = RoundUp(mCurrentOffset, kMinDynamicBufferOffsetAlignment);
+
+        if (mCurrentBlocks.empty() || offset + size > mCurrentBlocks.back().size) {
+            mCurrentBlocks.push_back(AcquireBlock(size));
+            offset = 0;
+        }
+        mCurrentOffset = offset + size;
+
+        return {mCurrentBlocks.back().buffer, offset};
+    }
+
+    FrameArena::Allocation FrameArena::AllocateData(const void* data, uint64_t size) {
+        Allocation allocation = Allocate(size);
+        allocation.buffer.SetSubData(allocation.offset, size, data);
+        return allocation;
+    }
+
+    void FrameArena::EndFrame(const wgpu::Queue& queue) {
+        if (mFence == nullptr) {
+            mFence = queue.CreateFence();
+        }
+
+        if (!mCurrentBlocks.empty()) {
+            PendingFrame frame;
+            frame.blocks = std::move(mCurrentBlocks);
+            frame.fenceValue = ++mFenceValue;
+            mPendingFrames.push_back(std::move(frame));
+
+            queue.Signal(mFence, mFenceValue);
+        }
+
+        mCurrentBlocks.clear();
+        mCurrentOffset = 0;
+
+        RecycleCompletedFrames();
+    }
+
+    void FrameArena::RecycleCompletedFrames() {
+        if (mFence == nullptr) {
+            return;
+        }
+
+        uint64_t completedValue = mFence.GetCompletedValue();
+        while (!mPendingFrames.empty() && mPendingFrames.front().fenceValue <= completedValue) {
+            for (Block& block : mPendingFrames.front().blocks) {
+                mFreeBlocks.push_back(std::move(block));
+            }
+            mPendingFrames.erase(mPendingFrames.begin());
+        }
+    }
+
+    FrameArena::Block FrameArena::AcquireBlock(uint64_t size) {
+        // Reuse the smallest free block that fits; allocations larger than the block size
+        // get a dedicated block that is recycled like any other.
+        auto it = mFreeBlocks.end();
+        for (auto candidate = mFreeBlocks.begin(); candidate != mFreeBlocks.end(); ++candidate) {
+            if (candidate->size >= size && (it == mFreeBlocks.end() || candidate->size < it->size)) {
+                it = candidate;
+            }
+        }
+        if (it != mFreeBlocks.end()) {
+            Block block = std::move(*it);
+            mFreeBlocks.erase(it);
+            return block;
+        }
+
+        Block block;
+        block.size = std::max(size, mBlockSize);
+
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = block.size;
+        descriptor.usage = mUsage;
+        block.buffer = mDevice.CreateBuffer(&descriptor);
+        return block;
+    }
+
+}  // namespace utils
@@ -0,0 +1,93 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILS_FRAMEARENA_H_
+#define UTILS_FRAMEARENA_H_
+
+#include <dawn/webgpu_cpp.h>
+
+#include <vector>
+
+namespace utils {
+
+    // FrameArena suballocates transient buffer space from large per-frame blocks instead
+    // of creating one buffer per allocation. Blocks used during a frame are retired with
+    // EndFrame(), which inserts a fence on the queue; once the fence completes the blocks
+    // return to a free list and are reused, so steady-state frames allocate no new
+    // buffers at all. This mirrors what dawn_native's DynamicUploader does internally for
+    // SetSubData, but is visible to applications so tools built on the utils helpers can
+    // pool their per-frame vertex/uniform garbage too.
+    //
+    // Allocations are only valid until EndFrame() is called; the application must not
+    // keep the returned buffer range alive across frames. The device must be ticked
+    // regularly (as any frame loop does) for fence completions to be observed.
+    class FrameArena {
+      public:
+        static constexpr uint64_t kDefaultBlockSize = 4 * 1024 * 1024;
+
+        // |usage| is what the suballocations will be bound as (Vertex, Index, Uniform,
+        // ...); CopyDst is added internally so the upload helpers work.
+        FrameArena(const wgpu::Device& device,
+                   wgpu::BufferUsage usage,
+                   uint64_t blockSize = kDefaultBlockSize);
+
+        struct Allocation {
+            wgpu::Buffer buffer;
+            uint64_t offset = 0;
+        };
+
+        // Reserves |size| bytes valid for the current frame. The offset is aligned so
+        // the range can be bound as a dynamic uniform or storage buffer.
+        Allocation Allocate(uint64_t size);
+
+        // Reserves |size| bytes and uploads |data| into them.
+        Allocation AllocateData(const void* data, uint64_t size);
+
+        // Marks the end of the frame. The frame's blocks are recycled once the fence
+        // signaled on |queue| completes.
+        void EndFrame(const wgpu::Queue& queue);
+
+      private:
+        struct Block {
+            wgpu::Buffer buffer;
+            uint64_t size = 0;
+        };
+
+        struct PendingFrame {
+            std::vector<Block> blocks;
+            uint64_t fenceValue = 0;
+        };
+
+        void RecycleCompletedFrames();
+        Block AcquireBlock(uint64_t size);
+
+        wgpu::Device mDevice;
+        wgpu::BufferUsage mUsage;
+        uint64_t mBlockSize;
+
+        // Blocks holding this frame's allocations; the last one is the block the cursor
+        // points into.
+        std::vector<Block> mCurrentBlocks;
+        uint64_t mCurrentOffset = 0;
+
+        std::vector<Block> mFreeBlocks;
+        std::vector<PendingFrame> mPendingFrames;
+
+        wgpu::Fence mFence;
+        uint64_t mFenceValue = 0;
+    };
+
+}  // namespace utils
+
+#endif  // UTILS_FRAMEARENA_H_
@@ -338,6 +338,12 @@ namespace utils {
         return device.CreateBindGroupLayout(&descriptor);
     }
 
+    BindingInitializationHelper::BindingInitializationHelper(
+        uint32_t binding,
+        const wgpu::RayTracingAccelerationContainer& container)
+        : binding(binding), accelerationContainer(container) {
+    }
+
     BindingInitializationHelper::BindingInitializationHelper(uint32_t binding,
                                                              const wgpu::Sampler& sampler)
         : binding(binding), sampler(sampler) {
@@ -359,6 +365,7 @@ namespace utils {
         wgpu::BindGroupEntry result;
 
         result.binding = binding;
+        result.accelerationContainer = accelerationContainer;
         result.sampler = sampler;
         result.textureView = textureView;
         result.buffer = buffer;
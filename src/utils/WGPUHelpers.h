@@ -118,6 +118,8 @@ namespace utils {
     // Structure with one constructor per-type of bindings, so that the initializer_list accepts
     // bindings with the right type and no extra information.
     struct BindingInitializationHelper {
+        BindingInitializationHelper(uint32_t binding,
+                                    const wgpu::RayTracingAccelerationContainer& container);
         BindingInitializationHelper(uint32_t binding, const wgpu::Sampler& sampler);
         BindingInitializationHelper(uint32_t binding, const wgpu::TextureView& textureView);
         BindingInitializationHelper(uint32_t binding,
@@ -128,6 +130,7 @@ namespace utils {
         wgpu::BindGroupEntry GetAsBinding() const;
 
         uint32_t binding;
+        wgpu::RayTracingAccelerationContainer accelerationContainer;
         wgpu::Sampler sampler;
         wgpu::TextureView textureView;
         wgpu::Buffer buffer;
@@ -0,0 +1,60 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "utils/WireTraceRecorder.h"
+
+#include "common/Assert.h"
+
+namespace utils {
+
+    WireTraceRecorder::WireTraceRecorder(const char* filename,
+                                         dawn_wire::CommandSerializer* serializer)
+        : mSerializer(serializer),
+          mFile(filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc) {
+        ASSERT(serializer != nullptr);
+    }
+
+    WireTraceRecorder::~WireTraceRecorder() {
+        CommitPendingCommand();
+    }
+
+    bool WireTraceRecorder::IsRecording() const {
+        return mFile.is_open();
+    }
+
+    void* WireTraceRecorder::GetCmdSpace(size_t size) {
+        CommitPendingCommand();
+
+        void* space = mSerializer->GetCmdSpace(size);
+        if (space != nullptr) {
+            mPendingData = space;
+            mPendingSize = size;
+        }
+        return space;
+    }
+
+    bool WireTraceRecorder::Flush() {
+        CommitPendingCommand();
+        return mSerializer->Flush();
+    }
+
+    void WireTraceRecorder::CommitPendingCommand() {
+        if (mPendingData != nullptr && IsRecording()) {
+            mFile.write(static_cast<const char*>(mPendingData), mPendingSize);
+        }
+        mPendingData = nullptr;
+        mPendingSize = 0;
+    }
+
+}  // namespace utils
@@ -0,0 +1,56 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILS_WIRE_TRACE_RECORDER_H_
+#define UTILS_WIRE_TRACE_RECORDER_H_
+
+#include <cstddef>
+#include <fstream>
+
+#include "dawn_wire/Wire.h"
+
+namespace utils {
+
+    // A CommandSerializer tee: installed between the WireClient and its real
+    // serializer, it writes every serialized command into a trace file while
+    // forwarding it unchanged. The trace is the raw wire encoding, so it can be
+    // replayed offline through any WireServer (see dawn_wire_trace_replay).
+    class WireTraceRecorder : public dawn_wire::CommandSerializer {
+      public:
+        WireTraceRecorder(const char* filename, dawn_wire::CommandSerializer* serializer);
+        ~WireTraceRecorder() override;
+
+        // Whether the trace file could be opened; when false the recorder degrades
+        // to a pass-through.
+        bool IsRecording() const;
+
+        void* GetCmdSpace(size_t size) override;
+        bool Flush() override;
+
+      private:
+        // The client fills the space handed out by GetCmdSpace after the call
+        // returns, so a command is copied into the trace only once the next
+        // GetCmdSpace or Flush shows it is complete.
+        void CommitPendingCommand();
+
+        dawn_wire::CommandSerializer* mSerializer;
+        std::ofstream mFile;
+
+        void* mPendingData = nullptr;
+        size_t mPendingSize = 0;
+    };
+
+}  // namespace utils
+
+#endif  // UTILS_WIRE_TRACE_RECORDER_H_
@@ -0,0 +1,212 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn/dawn_proc.h"
+#include "dawn/webgpu_cpp.h"
+#include "dawn_native/DawnNative.h"
+#include "dawn_wire/WireServer.h"
+#include "utils/SystemUtils.h"
+#include "utils/Timer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Replays wire traces captured with utils::WireTraceRecorder against any backend
+// with timing. Together with the recorder this moves performance investigation of
+// captured application frames from guesswork to offline profiling: the same trace
+// can be replayed repeatedly, across backends, and under a profiler.
+
+namespace {
+
+    class DevNull : public dawn_wire::CommandSerializer {
+      public:
+        void* GetCmdSpace(size_t size) override {
+            if (size > buf.size()) {
+                buf.resize(size);
+            }
+            return buf.data();
+        }
+        bool Flush() override {
+            return true;
+        }
+
+      private:
+        std::vector<char> buf;
+    };
+
+    bool ParseBackendType(const char* name, wgpu::BackendType* type) {
+        if (strcmp(name, "d3d12") == 0) {
+            *type = wgpu::BackendType::D3D12;
+        } else if (strcmp(name, "metal") == 0) {
+            *type = wgpu::BackendType::Metal;
+        } else if (strcmp(name, "null") == 0) {
+            *type = wgpu::BackendType::Null;
+        } else if (strcmp(name, "opengl") == 0) {
+            *type = wgpu::BackendType::OpenGL;
+        } else if (strcmp(name, "vulkan") == 0) {
+            *type = wgpu::BackendType::Vulkan;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    bool ReadTraceFile(const char* filename, std::vector<char>* data) {
+        FILE* file = fopen(filename, "rb");
+        if (!file) {
+            std::cerr << "Failed to open " << filename << std::endl;
+            return false;
+        }
+
+        fseek(file, 0, SEEK_END);
+        long tellFileSize = ftell(file);
+        if (tellFileSize <= 0) {
+            std::cerr << "Trace file of incorrect size: " << filename << std::endl;
+            fclose(file);
+            return false;
+        }
+        fseek(file, 0, SEEK_SET);
+
+        size_t fileSize = static_cast<size_t>(tellFileSize);
+        data->resize(fileSize);
+
+        size_t bytesRead = fread(data->data(), sizeof(char), fileSize, file);
+        fclose(file);
+        if (bytesRead != fileSize) {
+            std::cerr << "Failed to read " << filename << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // Replays the whole trace through a fresh device and wire server, and returns
+    // the elapsed time in seconds including the wait for the GPU to finish.
+    double ReplayTrace(dawn_native::Adapter adapter,
+                       const DawnProcTable& procs,
+                       const std::vector<char>& data) {
+        wgpu::Device device = wgpu::Device::Acquire(adapter.CreateDevice());
+        if (!device) {
+            std::cerr << "Failed to create the replay device" << std::endl;
+            return -1.0;
+        }
+
+        DevNull devNull;
+        dawn_wire::WireServerDescriptor serverDesc = {};
+        serverDesc.device = device.Get();
+        serverDesc.procs = &procs;
+        serverDesc.serializer = &devNull;
+
+        std::unique_ptr<dawn_wire::WireServer> wireServer(new dawn_wire::WireServer(serverDesc));
+
+        std::unique_ptr<utils::Timer> timer(utils::CreateTimer());
+        timer->Start();
+
+        wireServer->HandleCommands(data.data(), data.size());
+
+        // Wait for the replayed commands to finish executing so backend submission
+        // and GPU completion are part of the measurement.
+        {
+            wgpu::Queue queue = device.GetDefaultQueue();
+            wgpu::Fence fence = queue.CreateFence();
+            queue.Signal(fence, 1u);
+            while (fence.GetCompletedValue() != 1u) {
+                device.Tick();
+                utils::USleep(100);
+            }
+        }
+
+        timer->Stop();
+
+        // Destroy the server before the device because it needs to free all objects.
+        wireServer = nullptr;
+
+        return timer->GetElapsedTime();
+    }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    wgpu::BackendType backendType = wgpu::BackendType::Null;
+    uint32_t iterations = 1;
+    std::vector<const char*> files;
+
+    for (int i = 1; i < argc; ++i) {
+        constexpr const char kBackendArg[] = "--backend=";
+        constexpr const char kIterationsArg[] = "--iterations=";
+        if (strstr(argv[i], kBackendArg) == argv[i]) {
+            if (!ParseBackendType(argv[i] + strlen(kBackendArg), &backendType)) {
+                std::cerr << "Unknown backend \"" << argv[i] + strlen(kBackendArg) << "\""
+                          << std::endl;
+                return 1;
+            }
+            continue;
+        }
+        if (strstr(argv[i], kIterationsArg) == argv[i]) {
+            iterations = static_cast<uint32_t>(atoi(argv[i] + strlen(kIterationsArg)));
+            continue;
+        }
+        files.push_back(argv[i]);
+    }
+
+    if (files.empty() || iterations == 0) {
+        std::cout << "Usage: dawn_wire_trace_replay [--backend=d3d12|metal|null|opengl|vulkan] "
+                     "[--iterations=N] FILE [FILE...]"
+                  << std::endl;
+        return 1;
+    }
+
+    dawn_native::Instance instance;
+    instance.DiscoverDefaultAdapters();
+
+    dawn_native::Adapter replayAdapter;
+    for (dawn_native::Adapter adapter : instance.GetAdapters()) {
+        wgpu::AdapterProperties properties;
+        adapter.GetProperties(&properties);
+
+        if (properties.backendType == backendType) {
+            replayAdapter = adapter;
+            break;
+        }
+    }
+
+    if (!replayAdapter) {
+        std::cerr << "No adapter found for the requested backend" << std::endl;
+        return 1;
+    }
+
+    DawnProcTable procs = dawn_native::GetProcs();
+    dawnProcSetProcs(&procs);
+
+    for (const char* filename : files) {
+        std::vector<char> data;
+        if (!ReadTraceFile(filename, &data)) {
+            return 1;
+        }
+
+        for (uint32_t i = 0; i < iterations; ++i) {
+            double seconds = ReplayTrace(replayAdapter, procs, data);
+            if (seconds < 0.0) {
+                return 1;
+            }
+            std::cout << filename << ": replayed " << data.size() << " bytes in "
+                      << seconds * 1000.0 << " ms" << std::endl;
+        }
+    }
+
+    return 0;
+}